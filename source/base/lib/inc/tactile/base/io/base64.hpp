@@ -0,0 +1,414 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <array>        // array
+#include <cstddef>      // size_t
+#include <cstdint>      // uint8_t, uint32_t
+#include <optional>     // optional, nullopt
+#include <span>         // span
+#include <string>       // string
+#include <string_view>  // string_view
+
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/prelude.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+  #define TACTILE_BASE64_SSSE3 1
+  #include <immintrin.h>
+  #if TACTILE_COMPILER_MSVC
+    #include <intrin.h>  // __cpuid
+  #endif
+#else
+  #define TACTILE_BASE64_SSSE3 0
+#endif
+
+#if TACTILE_BASE64_SSSE3 && !TACTILE_COMPILER_MSVC
+  #define TACTILE_BASE64_SSSE3_TARGET __attribute__((target("ssse3")))
+#else
+  #define TACTILE_BASE64_SSSE3_TARGET
+#endif
+
+namespace tactile {
+
+inline constexpr std::string_view kBase64Alphabet =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+namespace detail {
+
+inline constexpr std::uint8_t kBase64Invalid = 0xFF;
+inline constexpr std::uint8_t kBase64Padding = 0xFE;
+inline constexpr std::uint8_t kBase64Space = 0xFD;
+
+// Maps characters to sextets, anything with the high bit set needs special treatment.
+inline constexpr auto kBase64DecodeTable = [] {
+  std::array<std::uint8_t, 256> table {};
+  table.fill(kBase64Invalid);
+
+  for (std::size_t index = 0; index < kBase64Alphabet.size(); ++index) {
+    table[static_cast<std::uint8_t>(kBase64Alphabet[index])] =
+        static_cast<std::uint8_t>(index);
+  }
+
+  table['='] = kBase64Padding;
+  table[' '] = kBase64Space;
+  table['\t'] = kBase64Space;
+  table['\n'] = kBase64Space;
+  table['\r'] = kBase64Space;
+
+  return table;
+}();
+
+}  // namespace detail
+
+/**
+ * Returns the number of characters needed to encode a sequence of bytes as Base64.
+ *
+ * \param byte_count The number of bytes to encode.
+ *
+ * \return
+ * The length of the padded Base64 text.
+ */
+[[nodiscard]]
+constexpr auto get_base64_encoded_size(const std::size_t byte_count) noexcept -> std::size_t
+{
+  return (byte_count + 2) / 3 * 4;
+}
+
+/**
+ * Returns the maximum number of bytes that Base64 text can decode to.
+ *
+ * \param char_count The number of characters in the Base64 text.
+ *
+ * \return
+ * An upper bound of the decoded size.
+ */
+[[nodiscard]]
+constexpr auto get_base64_decoded_size_bound(const std::size_t char_count) noexcept
+    -> std::size_t
+{
+  return (char_count + 3) / 4 * 3;
+}
+
+namespace detail {
+
+[[nodiscard]]
+inline auto has_ssse3() noexcept -> bool
+{
+#if TACTILE_BASE64_SSSE3 && TACTILE_COMPILER_MSVC
+  static const bool has_ssse3 = [] {
+    int cpu_info[4] {};
+    __cpuid(cpu_info, 1);
+    return (cpu_info[2] & (1 << 9)) != 0;
+  }();
+  return has_ssse3;
+#elif TACTILE_BASE64_SSSE3
+  static const bool has_ssse3 = __builtin_cpu_supports("ssse3");
+  return has_ssse3;
+#else
+  return false;
+#endif
+}
+
+#if TACTILE_BASE64_SSSE3
+
+// Encodes 12 bytes into 16 characters, but reads 16 bytes from the input.
+// See "Faster Base64 Encoding and Decoding using AVX2 Instructions" by Muła and Lemire.
+TACTILE_BASE64_SSSE3_TARGET
+inline void base64_encode_block_ssse3(const std::uint8_t* bytes, char* text) noexcept
+{
+  auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+  input = _mm_shuffle_epi8(input,
+                           _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+  // Moves each sextet into its own byte.
+  const auto t0 = _mm_and_si128(input, _mm_set1_epi32(0x0FC0FC00));
+  const auto t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const auto t2 = _mm_and_si128(input, _mm_set1_epi32(0x003F03F0));
+  const auto t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  const auto sextets = _mm_or_si128(t1, t3);
+
+  // Translates sextets to ASCII by adding an offset that depends on the alphabet range.
+  const auto offset_lut =
+      _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+  auto offset_indices = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+  const auto is_lowercase_or_above = _mm_cmpgt_epi8(sextets, _mm_set1_epi8(25));
+  offset_indices = _mm_sub_epi8(offset_indices, is_lowercase_or_above);
+
+  const auto chars = _mm_add_epi8(sextets, _mm_shuffle_epi8(offset_lut, offset_indices));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(text), chars);
+}
+
+// Decodes 16 characters into 12 bytes, but writes 16 bytes to the output. Returns false
+// if the block contains anything other than alphabet characters, e.g., whitespace.
+TACTILE_BASE64_SSSE3_TARGET
+inline auto base64_decode_block_ssse3(const char* text, std::uint8_t* bytes) noexcept
+    -> bool
+{
+  auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text));
+
+  // clang-format off
+  const auto lo_lut = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                    0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const auto hi_lut = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const auto roll_lut = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+                                      0, 0, 0, 0, 0, 0, 0, 0);
+  // clang-format on
+  const auto mask_2f = _mm_set1_epi8(0x2F);
+
+  const auto hi_nibbles = _mm_and_si128(_mm_srli_epi32(input, 4), mask_2f);
+  const auto lo_nibbles = _mm_and_si128(input, mask_2f);
+  const auto lo_class = _mm_shuffle_epi8(lo_lut, lo_nibbles);
+  const auto hi_class = _mm_shuffle_epi8(hi_lut, hi_nibbles);
+
+  const auto is_valid = _mm_cmpeq_epi8(_mm_and_si128(lo_class, hi_class), _mm_setzero_si128());
+  if (_mm_movemask_epi8(is_valid) != 0xFFFF) {
+    return false;
+  }
+
+  const auto is_slash = _mm_cmpeq_epi8(input, mask_2f);
+  const auto roll = _mm_shuffle_epi8(roll_lut, _mm_add_epi8(is_slash, hi_nibbles));
+  input = _mm_add_epi8(input, roll);
+
+  // Packs four sextets into three bytes, in each 32-bit lane.
+  const auto merged_pairs = _mm_maddubs_epi16(input, _mm_set1_epi32(0x01400140));
+  auto output = _mm_madd_epi16(merged_pairs, _mm_set1_epi32(0x00011000));
+  output = _mm_shuffle_epi8(
+      output,
+      _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes), output);
+  return true;
+}
+
+#endif  // TACTILE_BASE64_SSSE3
+
+}  // namespace detail
+
+/**
+ * Encodes a sequence of bytes as Base64, and appends it to a string.
+ *
+ * \details
+ * The standard alphabet is used, and the output is padded. The string is grown once,
+ * and the text is encoded directly into it. SSSE3 is used when the CPU supports it.
+ *
+ * \param bytes The bytes to encode.
+ * \param text  The string to append the Base64 text to.
+ */
+inline void base64_encode(const ByteSpan bytes, std::string& text)
+{
+  const auto old_size = text.size();
+  const auto new_size = old_size + get_base64_encoded_size(bytes.size());
+
+  text.resize_and_overwrite(new_size, [&](char* chars, const std::size_t) {
+    const auto* input = bytes.data();
+    const auto byte_count = bytes.size();
+    auto* output = chars + old_size;
+
+    std::size_t index = 0;
+
+#if TACTILE_BASE64_SSSE3
+    if (detail::has_ssse3()) {
+      for (; index + 16 <= byte_count; index += 12) {
+        detail::base64_encode_block_ssse3(input + index, output);
+        output += 16;
+      }
+    }
+#endif
+
+    for (; index + 3 <= byte_count; index += 3) {
+      const auto triple = static_cast<std::uint32_t>(input[index]) << 16u |
+                          static_cast<std::uint32_t>(input[index + 1]) << 8u |
+                          static_cast<std::uint32_t>(input[index + 2]);
+      output[0] = kBase64Alphabet[(triple >> 18u) & 0x3Fu];
+      output[1] = kBase64Alphabet[(triple >> 12u) & 0x3Fu];
+      output[2] = kBase64Alphabet[(triple >> 6u) & 0x3Fu];
+      output[3] = kBase64Alphabet[triple & 0x3Fu];
+      output += 4;
+    }
+
+    if (const auto remainder = byte_count - index; remainder != 0) {
+      auto triple = static_cast<std::uint32_t>(input[index]) << 16u;
+      if (remainder == 2) {
+        triple |= static_cast<std::uint32_t>(input[index + 1]) << 8u;
+      }
+
+      output[0] = kBase64Alphabet[(triple >> 18u) & 0x3Fu];
+      output[1] = kBase64Alphabet[(triple >> 12u) & 0x3Fu];
+      output[2] = (remainder == 2) ? kBase64Alphabet[(triple >> 6u) & 0x3Fu] : '=';
+      output[3] = '=';
+    }
+
+    return new_size;
+  });
+}
+
+/**
+ * Encodes a sequence of bytes as Base64.
+ *
+ * \param bytes The bytes to encode.
+ *
+ * \return
+ * The Base64 text.
+ */
+[[nodiscard]]
+inline auto base64_encode(const ByteSpan bytes) -> std::string
+{
+  std::string text {};
+  base64_encode(bytes, text);
+  return text;
+}
+
+/**
+ * Decodes Base64 text into a preallocated buffer.
+ *
+ * \details
+ * Whitespace is ignored, which is needed for text embedded in XML documents.
+ * Padding is optional at the end of the text, but may not appear anywhere else.
+ * The buffer should be at least as large as the bound provided by
+ * \c get_base64_decoded_size_bound. SSSE3 is used when the CPU supports it.
+ *
+ * \param text  The Base64 text to decode.
+ * \param bytes The buffer to write the decoded bytes to.
+ *
+ * \return
+ * The number of decoded bytes; an empty optional if the text is invalid or if the
+ * buffer is too small.
+ */
+[[nodiscard]]
+inline auto base64_decode(const std::string_view text, const std::span<std::uint8_t> bytes)
+    -> std::optional<std::size_t>
+{
+  const auto* input = text.data();
+  const auto char_count = text.size();
+  auto* output = bytes.data();
+  const auto byte_count = bytes.size();
+  const auto& decode_table = detail::kBase64DecodeTable;
+
+#if TACTILE_BASE64_SSSE3
+  const auto use_ssse3 = detail::has_ssse3();
+#endif
+
+  std::size_t char_index = 0;
+  std::size_t byte_index = 0;
+
+  while (char_index < char_count) {
+#if TACTILE_BASE64_SSSE3
+    if (use_ssse3 && char_index + 16 <= char_count && byte_index + 16 <= byte_count &&
+        detail::base64_decode_block_ssse3(input + char_index, output + byte_index)) {
+      char_index += 16;
+      byte_index += 12;
+      continue;
+    }
+#endif
+
+    if (char_index + 4 <= char_count) {
+      const auto s0 = decode_table[static_cast<std::uint8_t>(input[char_index])];
+      const auto s1 = decode_table[static_cast<std::uint8_t>(input[char_index + 1])];
+      const auto s2 = decode_table[static_cast<std::uint8_t>(input[char_index + 2])];
+      const auto s3 = decode_table[static_cast<std::uint8_t>(input[char_index + 3])];
+
+      if (((s0 | s1 | s2 | s3) & 0x80u) == 0) {
+        if (byte_index + 3 > byte_count) {
+          return std::nullopt;
+        }
+
+        const auto triple = static_cast<std::uint32_t>(s0) << 18u |
+                            static_cast<std::uint32_t>(s1) << 12u |
+                            static_cast<std::uint32_t>(s2) << 6u |
+                            static_cast<std::uint32_t>(s3);
+        output[byte_index] = static_cast<std::uint8_t>(triple >> 16u);
+        output[byte_index + 1] = static_cast<std::uint8_t>(triple >> 8u);
+        output[byte_index + 2] = static_cast<std::uint8_t>(triple);
+
+        char_index += 4;
+        byte_index += 3;
+        continue;
+      }
+    }
+
+    // Slow path, which gathers a quantum while skipping whitespace.
+    std::uint32_t triple = 0;
+    std::size_t sextet_count = 0;
+    std::size_t padding_count = 0;
+
+    for (; char_index < char_count && sextet_count + padding_count < 4; ++char_index) {
+      const auto sextet = decode_table[static_cast<std::uint8_t>(input[char_index])];
+
+      if (sextet == detail::kBase64Space) {
+        continue;
+      }
+
+      if (sextet == detail::kBase64Invalid) {
+        return std::nullopt;
+      }
+
+      if (sextet == detail::kBase64Padding) {
+        ++padding_count;
+        continue;
+      }
+
+      if (padding_count != 0) {
+        return std::nullopt;
+      }
+
+      triple |= static_cast<std::uint32_t>(sextet) << (18u - 6u * sextet_count);
+      ++sextet_count;
+    }
+
+    if (sextet_count == 0 && padding_count == 0) {
+      break;  // Trailing whitespace.
+    }
+
+    if (sextet_count < 2 || (padding_count != 0 && sextet_count + padding_count != 4)) {
+      return std::nullopt;
+    }
+
+    const auto quantum_byte_count = sextet_count - 1;
+    if (byte_index + quantum_byte_count > byte_count) {
+      return std::nullopt;
+    }
+
+    for (std::size_t index = 0; index < quantum_byte_count; ++index) {
+      output[byte_index++] = static_cast<std::uint8_t>(triple >> (16u - 8u * index));
+    }
+
+    if (sextet_count != 4) {
+      // Only whitespace may follow a partial quantum.
+      for (; char_index < char_count; ++char_index) {
+        const auto sextet = decode_table[static_cast<std::uint8_t>(input[char_index])];
+        if (sextet != detail::kBase64Space) {
+          return std::nullopt;
+        }
+      }
+    }
+  }
+
+  return byte_index;
+}
+
+/**
+ * Decodes Base64 text.
+ *
+ * \param text The Base64 text to decode.
+ *
+ * \return
+ * The decoded bytes; an empty optional if the text is invalid.
+ */
+[[nodiscard]]
+inline auto base64_decode(const std::string_view text) -> std::optional<ByteStream>
+{
+  // The extra space lets the vectorized path write whole blocks until the very end.
+  ByteStream bytes(get_base64_decoded_size_bound(text.size()) + 4);
+
+  const auto byte_count = base64_decode(text, bytes);
+  if (!byte_count.has_value()) {
+    return std::nullopt;
+  }
+
+  bytes.resize(*byte_count);
+  return bytes;
+}
+
+}  // namespace tactile
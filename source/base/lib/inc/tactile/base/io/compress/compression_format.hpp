@@ -2,13 +2,64 @@
 
 #pragma once
 
+#include <cstddef>   // size_t
 #include <expected>  // expected
+#include <optional>  // optional
+#include <span>      // span
 
 #include "tactile/base/debug/error_code.hpp"
 #include "tactile/base/io/byte_stream.hpp"
 
 namespace tactile {
 
+/**
+ * Provides data compression options.
+ */
+struct CompressionOptions final
+{
+  /**
+   * The compression level, the default level of the format is used if absent.
+   *
+   * \details
+   * The range of valid levels depends on the compression format. Levels outside
+   * of that range are clamped.
+   */
+  std::optional<int> level;
+
+  /**
+   * The maximum number of threads that may be used to compress large inputs.
+   *
+   * \details
+   * Formats that don't support multithreaded compression ignore this option.
+   */
+  std::size_t thread_count;
+
+  /**
+   * A dictionary to compress the data with, or an empty span to use no dictionary.
+   *
+   * \details
+   * Dictionaries improve the compression ratio of small inputs that resemble
+   * the data the dictionary was trained on. However, the same dictionary must
+   * then be provided when the data is decompressed. Formats that don't support
+   * dictionaries ignore this option.
+   */
+  ByteSpan dictionary;
+};
+
+/**
+ * Provides data decompression options.
+ */
+struct DecompressionOptions final
+{
+  /**
+   * The dictionary that the data was compressed with, if any.
+   *
+   * \details
+   * This is ignored if the data was compressed without a dictionary.
+   */
+  ByteSpan dictionary;
+};
+
 /**
  * Interface for data compression providers.
  */
@@ -21,23 +72,40 @@ class ICompressionFormat
    * Attempts to compress a byte stream.
    *
    * \param input_data The data that will be compressed.
+   * \param options    The compression options.
    *
    * \return
    * A compressed byte stream if successful; an error code otherwise.
    */
   [[nodiscard]]
-  virtual auto compress(ByteSpan input_data) const -> std::expected<ByteStream, ErrorCode> = 0;
+  virtual auto compress(ByteSpan input_data, const CompressionOptions& options) const
+      -> std::expected<ByteStream, ErrorCode> = 0;
 
   /**
    * Attempts to decompress a compressed byte stream.
    *
    * \param input_data The data that will be decompressed.
+   * \param options    The decompression options.
    *
    * \return
    * An uncompressed byte stream if successful; an error code otherwise.
    */
   [[nodiscard]]
-  virtual auto decompress(ByteSpan input_data) const
+  virtual auto decompress(ByteSpan input_data, const DecompressionOptions& options) const
+      -> std::expected<ByteStream, ErrorCode> = 0;
+
+  /**
+   * Attempts to train a compression dictionary.
+   *
+   * \param samples             Representative samples of the data to compress.
+   * \param max_dictionary_size The maximum size of the dictionary, in bytes.
+   *
+   * \return
+   * The dictionary if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  virtual auto train_dictionary(std::span<const ByteSpan> samples,
+                                std::size_t max_dictionary_size) const
       -> std::expected<ByteStream, ErrorCode> = 0;
 };
 
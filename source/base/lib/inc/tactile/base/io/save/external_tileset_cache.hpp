@@ -0,0 +1,62 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <expected>    // expected
+#include <filesystem>  // path
+#include <functional>  // function
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/prelude.hpp"
+
+namespace tactile {
+
+/**
+ * Interface for caches of parsed external tilesets, shared by all save formats.
+ *
+ * \details
+ * Maps in a project usually reference the same handful of external tilesets,
+ * so caching them avoids parsing each tileset file once per map. Cached tilesets
+ * must not depend on the map that references them, e.g., file paths stored in
+ * cached tilesets shouldn't be resolved against the map directory.
+ */
+class IExternalTilesetCache
+{
+ public:
+  TACTILE_INTERFACE_CLASS(IExternalTilesetCache);
+
+  using parser_type =
+      std::function<std::expected<ir::Tileset, ErrorCode>(const std::filesystem::path&)>;
+
+  /**
+   * Returns the tileset stored in a given file.
+   *
+   * \details
+   * The parser is only invoked if the tileset isn't cached, or if the tileset
+   * file has been modified since it was cached. Parse errors aren't cached.
+   *
+   * \param path   The path to the tileset file.
+   * \param parser The function used to parse the tileset file on cache misses.
+   *
+   * \return
+   * The parsed tileset; an error code otherwise.
+   */
+  [[nodiscard]]
+  virtual auto get_tileset(const std::filesystem::path& path, const parser_type& parser)
+      -> std::expected<ir::Tileset, ErrorCode> = 0;
+
+  /**
+   * Removes a tileset from the cache.
+   *
+   * \param path The path to the tileset file.
+   */
+  virtual void invalidate(const std::filesystem::path& path) = 0;
+
+  /**
+   * Removes all tilesets from the cache.
+   */
+  virtual void clear() = 0;
+};
+
+}  // namespace tactile
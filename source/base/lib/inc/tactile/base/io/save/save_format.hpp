@@ -4,10 +4,12 @@
 
 #include <expected>       // expected
 #include <filesystem>     // path
+#include <optional>       // optional
 #include <string_view>    // string_view
 #include <unordered_map>  // unordered_map
 
 #include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/io/byte_stream.hpp"
 #include "tactile/base/io/save/ir.hpp"
 #include "tactile/base/meta/attribute.hpp"
 #include "tactile/base/prelude.hpp"
@@ -31,6 +33,9 @@ struct SaveFormatReadOptions final
 
   /** Whether strict parsing is to be enforced. */
   bool strict_mode : 1;
+
+  /** The dictionary used to decompress tile data, if any. */
+  ByteSpan compression_dictionary;
 };
 
 /**
@@ -52,6 +57,17 @@ struct SaveFormatWriteOptions final
 
   /** Whether tile rows are aligned by row. */
   bool fold_tile_layer_data : 1;
+
+  /** Overrides the compression level of tile data, if present. */
+  std::optional<int> compression_level;
+
+  /**
+   * The dictionary used to compress tile data, if any.
+   *
+   * \note
+   * Other tools, such as Tiled, can't decompress data compressed with a dictionary.
+   */
+  ByteSpan compression_dictionary;
 };
 
 /**
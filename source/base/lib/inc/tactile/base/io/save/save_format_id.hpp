@@ -27,6 +27,9 @@ enum class SaveFormatId : std::uint8_t
 
   /** The Godot scene (aka TSCN/ESCN) save format. */
   kGodotTscn = 3,
+
+  /** The native chunked binary save format. */
+  kTactileBinary = 4,
 };
 
 }  // namespace tactile
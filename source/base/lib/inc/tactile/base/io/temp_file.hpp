@@ -0,0 +1,132 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <expected>      // expected, unexpected
+#include <filesystem>    // path, rename, remove
+#include <system_error>  // error_code
+#include <utility>       // move, exchange
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/prelude.hpp"
+
+namespace tactile {
+
+/**
+ * Represents a temporary file that replaces a target file once committed.
+ *
+ * \details
+ * The temporary file is located next to the target file, so that the target
+ * file is never modified until the temporary file has been fully written. A
+ * temporary file that is never committed is removed upon destruction.
+ */
+class TempFile final
+{
+ public:
+  TACTILE_DELETE_COPY(TempFile);
+
+  /**
+   * Creates a temporary file handle, the file itself is not created.
+   *
+   * \param target_path The path of the file that the temporary file replaces.
+   */
+  [[nodiscard]]
+  explicit TempFile(std::filesystem::path target_path)
+    : m_target_path {std::move(target_path)},
+      m_path {m_target_path},
+      m_pending {true}
+  {
+    m_path += ".tmp";
+  }
+
+  [[nodiscard]]
+  TempFile(TempFile&& other) noexcept
+    : m_target_path {std::move(other.m_target_path)},
+      m_path {std::move(other.m_path)},
+      m_pending {std::exchange(other.m_pending, false)}
+  {}
+
+  ~TempFile() noexcept
+  {
+    _discard();
+  }
+
+  auto operator=(TempFile&& other) noexcept -> TempFile&
+  {
+    if (this != &other) {
+      _discard();
+
+      m_target_path = std::move(other.m_target_path);
+      m_path = std::move(other.m_path);
+      m_pending = std::exchange(other.m_pending, false);
+    }
+
+    return *this;
+  }
+
+  /**
+   * Replaces the target file with the temporary file.
+   *
+   * \pre Any streams to the temporary file must be closed.
+   *
+   * \return
+   * Nothing if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  auto commit() -> std::expected<void, ErrorCode>
+  {
+    if (!m_pending) {
+      return std::unexpected {ErrorCode::kBadState};
+    }
+
+    std::error_code error_code {};
+    std::filesystem::rename(m_path, m_target_path, error_code);
+
+    if (error_code) {
+      _discard();
+      return std::unexpected {ErrorCode::kWriteError};
+    }
+
+    m_pending = false;
+    return {};
+  }
+
+  /**
+   * Returns the path of the temporary file.
+   *
+   * \return
+   * A file path.
+   */
+  [[nodiscard]]
+  auto path() const noexcept -> const std::filesystem::path&
+  {
+    return m_path;
+  }
+
+  /**
+   * Returns the path of the file that the temporary file replaces.
+   *
+   * \return
+   * A file path.
+   */
+  [[nodiscard]]
+  auto target_path() const noexcept -> const std::filesystem::path&
+  {
+    return m_target_path;
+  }
+
+ private:
+  std::filesystem::path m_target_path;
+  std::filesystem::path m_path;
+  bool m_pending;
+
+  void _discard() noexcept
+  {
+    if (std::exchange(m_pending, false)) {
+      std::error_code error_code {};
+      std::filesystem::remove(m_path, error_code);
+    }
+  }
+};
+
+}  // namespace tactile
@@ -0,0 +1,159 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>   // size_t
+#include <cstdint>   // uint8_t, uint32_t
+#include <cstring>   // memcpy
+#include <optional>  // optional, nullopt
+
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/platform/bits.hpp"
+#include "tactile/base/prelude.hpp"
+
+namespace tactile {
+
+/**
+ * Represents reversible transforms that make tile data easier to compress.
+ *
+ * \details
+ * Tile data is stored as little endian 32-bit tile identifiers, so the most
+ * significant bytes are nearly always zero, and neighboring identifiers tend
+ * to be equal or close to each other. General purpose compressors don't take
+ * advantage of either property, which is what these filters are for.
+ */
+enum class TileFilter : std::uint8_t
+{
+  /** The tile data is stored as is. */
+  kNone,
+
+  /** The bytes of all tile identifiers are grouped by significance. */
+  kShuffle,
+
+  /** Tile identifiers are replaced by the delta to their predecessor, and then shuffled. */
+  kDeltaShuffle,
+};
+
+namespace detail {
+
+// Maps small negative deltas to small unsigned values, e.g., -1 to 1 and 1 to 2, which
+// keeps the most significant byte planes zeroed.
+[[nodiscard]]
+constexpr auto zigzag_encode(const std::uint32_t delta) noexcept -> std::uint32_t
+{
+  return (delta << 1u) ^ (0u - (delta >> 31u));
+}
+
+[[nodiscard]]
+constexpr auto zigzag_decode(const std::uint32_t value) noexcept -> std::uint32_t
+{
+  return (value >> 1u) ^ (0u - (value & 1u));
+}
+
+}  // namespace detail
+
+/**
+ * Applies a filter to raw tile data.
+ *
+ * \details
+ * Shuffling stores the least significant byte of every tile first, followed by
+ * the second byte of every tile, and so on. Delta coding is applied along the
+ * tile sequence, i.e., in row-major order for tile matrices. Deltas use wrapping
+ * arithmetic and are zigzag encoded, so that small negative deltas only occupy
+ * the least significant bytes.
+ *
+ * \param tile_bytes The raw tile data, a sequence of little endian tile identifiers.
+ * \param filter     The filter to apply.
+ *
+ * \return
+ * The filtered tile data; an empty optional if the input isn't valid tile data.
+ */
+[[nodiscard]]
+inline auto apply_tile_filter(const ByteSpan tile_bytes, const TileFilter filter)
+    -> std::optional<ByteStream>
+{
+  if (tile_bytes.size() % sizeof(std::uint32_t) != 0) {
+    return std::nullopt;
+  }
+
+  if (filter == TileFilter::kNone) {
+    return ByteStream {tile_bytes.begin(), tile_bytes.end()};
+  }
+
+  const auto tile_count = tile_bytes.size() / sizeof(std::uint32_t);
+  const auto use_delta = filter == TileFilter::kDeltaShuffle;
+
+  ByteStream filtered_bytes(tile_bytes.size());
+  auto* byte_planes = filtered_bytes.data();
+
+  // The loop body is free of loop-carried dependencies, so it's easily vectorized.
+  for (std::size_t index = 0; index < tile_count; ++index) {
+    std::uint32_t tile_id {};
+    std::memcpy(&tile_id, tile_bytes.data() + index * sizeof tile_id, sizeof tile_id);
+    tile_id = to_little_endian(tile_id);
+
+    if (use_delta && index > 0) {
+      std::uint32_t previous_tile_id {};
+      std::memcpy(&previous_tile_id,
+                  tile_bytes.data() + (index - 1) * sizeof previous_tile_id,
+                  sizeof previous_tile_id);
+      tile_id = detail::zigzag_encode(tile_id - to_little_endian(previous_tile_id));
+    }
+
+    byte_planes[index] = static_cast<std::uint8_t>(tile_id);
+    byte_planes[tile_count + index] = static_cast<std::uint8_t>(tile_id >> 8u);
+    byte_planes[2 * tile_count + index] = static_cast<std::uint8_t>(tile_id >> 16u);
+    byte_planes[3 * tile_count + index] = static_cast<std::uint8_t>(tile_id >> 24u);
+  }
+
+  return filtered_bytes;
+}
+
+/**
+ * Reverts a filter applied to tile data.
+ *
+ * \param filtered_bytes The filtered tile data.
+ * \param filter         The filter that was applied to the tile data.
+ *
+ * \return
+ * The raw tile data; an empty optional if the input isn't valid tile data.
+ */
+[[nodiscard]]
+inline auto revert_tile_filter(const ByteSpan filtered_bytes, const TileFilter filter)
+    -> std::optional<ByteStream>
+{
+  if (filtered_bytes.size() % sizeof(std::uint32_t) != 0) {
+    return std::nullopt;
+  }
+
+  if (filter == TileFilter::kNone) {
+    return ByteStream {filtered_bytes.begin(), filtered_bytes.end()};
+  }
+
+  const auto tile_count = filtered_bytes.size() / sizeof(std::uint32_t);
+  const auto use_delta = filter == TileFilter::kDeltaShuffle;
+
+  ByteStream tile_bytes(filtered_bytes.size());
+  const auto* byte_planes = filtered_bytes.data();
+
+  std::uint32_t previous_tile_id {0};
+  for (std::size_t index = 0; index < tile_count; ++index) {
+    auto tile_id = static_cast<std::uint32_t>(byte_planes[index]) |
+                   static_cast<std::uint32_t>(byte_planes[tile_count + index]) << 8u |
+                   static_cast<std::uint32_t>(byte_planes[2 * tile_count + index]) << 16u |
+                   static_cast<std::uint32_t>(byte_planes[3 * tile_count + index]) << 24u;
+
+    if (use_delta && index > 0) {
+      tile_id = previous_tile_id + detail::zigzag_decode(tile_id);
+    }
+
+    previous_tile_id = tile_id;
+
+    tile_id = to_little_endian(tile_id);
+    std::memcpy(tile_bytes.data() + index * sizeof tile_id, &tile_id, sizeof tile_id);
+  }
+
+  return tile_bytes;
+}
+
+}  // namespace tactile
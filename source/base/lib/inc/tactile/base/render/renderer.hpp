@@ -11,12 +11,15 @@
 #include "tactile/base/render/renderer_options.hpp"
 
 struct ImGuiContext;
+struct ImDrawData;
+struct ImDrawList;
 union SDL_Event;
 
 namespace tactile {
 
 class IWindow;
 class ITexture;
+struct TextureSize;
 
 /**
  * Provides the high level renderer backend API.
@@ -72,6 +75,76 @@ class IRenderer
   [[nodiscard]]
   virtual auto find_texture(TextureID id) const -> const ITexture* = 0;
 
+  /**
+   * Creates an offscreen render target.
+   *
+   * \details
+   * Render targets are textures that can be rendered to using
+   * \c render_to_target. They share identifiers with ordinary textures, so they
+   * can be queried with \c find_texture and must be destroyed with
+   * \c unload_texture.
+   *
+   * \param size The size of the render target, in pixels.
+   *
+   * \return
+   * The identifier assigned to the render target; an error code otherwise.
+   */
+  [[nodiscard]]
+  virtual auto create_render_target(const TextureSize& size)
+      -> std::expected<TextureID, ErrorCode> = 0;
+
+  /**
+   * Renders Dear ImGui draw data to a render target.
+   *
+   * \details
+   * The render target is cleared to transparent black before the draw data is
+   * rendered. The draw data is consumed immediately, so it doesn't need to
+   * outlive the call. Since the draw data is blended with a transparent
+   * target, the resulting colors use premultiplied alpha, see
+   * \c add_premultiplied_alpha_callback.
+   *
+   * \pre The draw data must use the same size as the render target.
+   *
+   * \param target_id The identifier of the target render target.
+   * \param draw_data The draw data to render.
+   *
+   * \return
+   * True if the draw data was rendered; false otherwise.
+   */
+  [[nodiscard]]
+  virtual auto render_to_target(TextureID target_id, const ImDrawData& draw_data) -> bool = 0;
+
+  /**
+   * Indicates whether render target contents are stored upside down.
+   *
+   * \details
+   * Some backends, such as OpenGL, use a bottom-left framebuffer origin, which
+   * means that the texture coordinates of render targets must be flipped
+   * vertically when drawn.
+   *
+   * \return
+   * True if render targets are flipped vertically; false otherwise.
+   */
+  [[nodiscard]]
+  virtual auto is_render_target_flipped() const -> bool = 0;
+
+  /**
+   * Adds a draw callback that enables premultiplied alpha blending.
+   *
+   * \details
+   * Render target contents must be drawn with premultiplied alpha blending,
+   * otherwise translucent pixels are blended twice. The blending mode applies
+   * to subsequent draw commands in the draw list, until a
+   * \c ImDrawCallback_ResetRenderState callback is added.
+   *
+   * \param draw_list The draw list to add the callback to.
+   *
+   * \return
+   * True if the callback was added; false if premultiplied alpha isn't supported.
+   */
+  [[nodiscard]]
+  virtual auto add_premultiplied_alpha_callback(ImDrawList& draw_list) -> bool = 0;
+
   /**
    * Reloads the fonts texture, if possible.
    */
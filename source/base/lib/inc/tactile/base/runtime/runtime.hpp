@@ -15,6 +15,7 @@ class IWindow;
 class IRenderer;
 class ICompressionFormat;
 class ISaveFormat;
+class IExternalTilesetCache;
 struct RendererOptions;
 
 namespace log {
@@ -109,6 +110,15 @@ class IRuntime
   [[nodiscard]]
   virtual auto get_save_format(SaveFormatId id) const -> const ISaveFormat* = 0;
 
+  /**
+   * Returns the external tileset cache shared by all save formats.
+   *
+   * \return
+   * A possibly null pointer to the external tileset cache.
+   */
+  [[nodiscard]]
+  virtual auto get_external_tileset_cache() const -> IExternalTilesetCache* = 0;
+
   /**
    * Returns the allocation functions associated with the Dear ImGui context.
    *
@@ -3,8 +3,10 @@
 #pragma once
 
 #include <cstddef>     // size_t
+#include <cstdint>     // uint32_t
 #include <functional>  // hash
 
+#include "tactile/base/io/byte_stream.hpp"
 #include "tactile/base/prelude.hpp"
 
 namespace tactile {
@@ -42,4 +44,28 @@ auto hash_combine(const auto&... args) noexcept -> std::size_t
   return seed;
 }
 
+/**
+ * Computes the 32-bit FNV-1a hash of a sequence of bytes.
+ *
+ * \details
+ * This is a fast non-cryptographic hash, which is plenty to detect corrupted
+ * data in files.
+ *
+ * \param bytes The bytes to hash.
+ *
+ * \return A hash of the bytes.
+ */
+[[nodiscard]]
+constexpr auto fnv1a_hash(const ByteSpan bytes) noexcept -> std::uint32_t
+{
+  std::uint32_t hash = 2'166'136'261u;
+
+  for (const auto byte : bytes) {
+    hash ^= byte;
+    hash *= 16'777'619u;
+  }
+
+  return hash;
+}
+
 }  // namespace tactile
@@ -0,0 +1,116 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/base/io/base64.hpp"
+
+#include <cstddef>      // size_t
+#include <cstdint>      // uint8_t
+#include <string>       // string
+#include <string_view>  // string_view
+
+#include <gtest/gtest.h>
+
+namespace tactile {
+namespace {
+
+[[nodiscard]]
+auto _to_bytes(const std::string_view text) -> ByteStream
+{
+  return ByteStream {text.begin(), text.end()};
+}
+
+// tactile::base64_encode
+TEST(Base64, Encode)
+{
+  EXPECT_EQ(base64_encode(_to_bytes("")), "");
+  EXPECT_EQ(base64_encode(_to_bytes("f")), "Zg==");
+  EXPECT_EQ(base64_encode(_to_bytes("fo")), "Zm8=");
+  EXPECT_EQ(base64_encode(_to_bytes("foo")), "Zm9v");
+  EXPECT_EQ(base64_encode(_to_bytes("foob")), "Zm9vYg==");
+  EXPECT_EQ(base64_encode(_to_bytes("fooba")), "Zm9vYmE=");
+  EXPECT_EQ(base64_encode(_to_bytes("foobar")), "Zm9vYmFy");
+}
+
+// tactile::base64_encode
+TEST(Base64, EncodeAppendsToString)
+{
+  std::string text {"data:"};
+  base64_encode(_to_bytes("foobar"), text);
+
+  EXPECT_EQ(text, "data:Zm9vYmFy");
+}
+
+// tactile::base64_decode
+TEST(Base64, Decode)
+{
+  EXPECT_EQ(base64_decode(""), ByteStream {});
+  EXPECT_EQ(base64_decode("Zg=="), _to_bytes("f"));
+  EXPECT_EQ(base64_decode("Zm8="), _to_bytes("fo"));
+  EXPECT_EQ(base64_decode("Zm9v"), _to_bytes("foo"));
+  EXPECT_EQ(base64_decode("Zm9vYg=="), _to_bytes("foob"));
+  EXPECT_EQ(base64_decode("Zm9vYmE="), _to_bytes("fooba"));
+  EXPECT_EQ(base64_decode("Zm9vYmFy"), _to_bytes("foobar"));
+  EXPECT_EQ(base64_decode("Zm9vYg"), _to_bytes("foob"));
+}
+
+// tactile::base64_decode
+TEST(Base64, DecodeWithWhitespace)
+{
+  EXPECT_EQ(base64_decode("\n   Zm9v\r\n  YmFy\n"), _to_bytes("foobar"));
+  EXPECT_EQ(base64_decode("Zm 9v Ym E=\t"), _to_bytes("fooba"));
+  EXPECT_EQ(base64_decode(" \n "), ByteStream {});
+}
+
+// tactile::base64_decode
+TEST(Base64, DecodeInvalidText)
+{
+  EXPECT_FALSE(base64_decode("Zm9v!mFy").has_value());
+  EXPECT_FALSE(base64_decode("Z").has_value());
+  EXPECT_FALSE(base64_decode("Zg=").has_value());
+  EXPECT_FALSE(base64_decode("Zg==Zm9v").has_value());
+  EXPECT_FALSE(base64_decode("=Zm9").has_value());
+}
+
+// tactile::base64_decode
+TEST(Base64, DecodeIntoSmallBuffer)
+{
+  ByteStream bytes(5);
+  EXPECT_FALSE(base64_decode("Zm9vYmFy", bytes).has_value());
+
+  bytes.resize(6);
+  EXPECT_EQ(base64_decode("Zm9vYmFy", bytes), 6);
+  EXPECT_EQ(bytes, _to_bytes("foobar"));
+}
+
+// tactile::base64_encode
+// tactile::base64_decode
+TEST(Base64, Roundtrip)
+{
+  // Large enough to exercise the vectorized paths, with all possible remainders.
+  for (std::size_t byte_count = 0; byte_count < 200; ++byte_count) {
+    ByteStream bytes(byte_count);
+    for (std::size_t index = 0; index < byte_count; ++index) {
+      bytes[index] = static_cast<std::uint8_t>(index * 97 + byte_count);
+    }
+
+    const auto text = base64_encode(bytes);
+    ASSERT_EQ(text.size(), get_base64_encoded_size(byte_count));
+
+    EXPECT_EQ(base64_decode(text), bytes);
+  }
+}
+
+// tactile::base64_encode
+// tactile::base64_decode
+TEST(Base64, RoundtripEntireAlphabet)
+{
+  constexpr std::string_view kText =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  const auto bytes = base64_decode(kText);
+  ASSERT_TRUE(bytes.has_value());
+  EXPECT_EQ(bytes->size(), std::size_t {48});
+  EXPECT_EQ(base64_encode(*bytes), kText);
+}
+
+}  // namespace
+}  // namespace tactile
@@ -0,0 +1,112 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/base/io/temp_file.hpp"
+
+#include <expected>    // unexpected
+#include <filesystem>  // path, exists, remove, temp_directory_path
+#include <fstream>     // ofstream
+#include <ios>         // ios
+#include <utility>     // move
+
+#include <gtest/gtest.h>
+
+#include "tactile/base/io/file_io.hpp"
+
+namespace tactile {
+namespace {
+
+class TempFileTest : public testing::Test
+{
+ public:
+  void SetUp() override
+  {
+    mTargetPath = std::filesystem::temp_directory_path() / "tactile_temp_file_test.txt";
+    std::filesystem::remove(mTargetPath);
+  }
+
+  void TearDown() override
+  {
+    std::filesystem::remove(mTargetPath);
+  }
+
+ protected:
+  std::filesystem::path mTargetPath {};
+
+  static void _write(const std::filesystem::path& path, const char* content)
+  {
+    std::ofstream stream {path, std::ios::out | std::ios::trunc};
+    stream << content;
+  }
+};
+
+// tactile::TempFile::TempFile
+TEST_F(TempFileTest, Constructor)
+{
+  const TempFile temp_file {mTargetPath};
+
+  EXPECT_EQ(temp_file.target_path(), mTargetPath);
+  EXPECT_EQ(temp_file.path().parent_path(), mTargetPath.parent_path());
+  EXPECT_NE(temp_file.path(), mTargetPath);
+  EXPECT_FALSE(std::filesystem::exists(temp_file.path()));
+}
+
+// tactile::TempFile::commit
+TEST_F(TempFileTest, Commit)
+{
+  _write(mTargetPath, "old");
+
+  TempFile temp_file {mTargetPath};
+  _write(temp_file.path(), "new");
+
+  EXPECT_EQ(read_binary_file(mTargetPath), "old");
+
+  ASSERT_TRUE(temp_file.commit().has_value());
+  EXPECT_EQ(read_binary_file(mTargetPath), "new");
+  EXPECT_FALSE(std::filesystem::exists(temp_file.path()));
+
+  EXPECT_EQ(temp_file.commit(), std::unexpected {ErrorCode::kBadState});
+}
+
+// tactile::TempFile::commit
+TEST_F(TempFileTest, CommitWithoutFile)
+{
+  _write(mTargetPath, "old");
+
+  TempFile temp_file {mTargetPath};
+
+  EXPECT_EQ(temp_file.commit(), std::unexpected {ErrorCode::kWriteError});
+  EXPECT_EQ(read_binary_file(mTargetPath), "old");
+}
+
+// tactile::TempFile::~TempFile
+TEST_F(TempFileTest, DiscardUncommittedFile)
+{
+  _write(mTargetPath, "old");
+
+  std::filesystem::path temp_path {};
+
+  {
+    const TempFile temp_file {mTargetPath};
+    temp_path = temp_file.path();
+    _write(temp_path, "new");
+  }
+
+  EXPECT_FALSE(std::filesystem::exists(temp_path));
+  EXPECT_EQ(read_binary_file(mTargetPath), "old");
+}
+
+// tactile::TempFile::TempFile
+TEST_F(TempFileTest, MoveConstructor)
+{
+  TempFile temp_file {mTargetPath};
+  _write(temp_file.path(), "new");
+
+  TempFile moved_file {std::move(temp_file)};
+  EXPECT_TRUE(std::filesystem::exists(moved_file.path()));
+
+  ASSERT_TRUE(moved_file.commit().has_value());
+  EXPECT_EQ(read_binary_file(mTargetPath), "new");
+}
+
+}  // namespace
+}  // namespace tactile
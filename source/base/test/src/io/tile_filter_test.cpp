@@ -0,0 +1,95 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/base/io/tile_filter.hpp"
+
+#include <gtest/gtest.h>
+
+#include "tactile/base/io/tile_io.hpp"
+
+namespace tactile {
+namespace {
+
+// tactile::apply_tile_filter
+TEST(TileFilter, ApplyShuffle)
+{
+  const ByteStream tile_bytes {
+    // clang-format off
+    0x01, 0x02, 0x03, 0x04, // Tile 0
+    0x11, 0x12, 0x13, 0x14, // Tile 1
+    0x21, 0x22, 0x23, 0x24, // Tile 2
+    // clang-format on
+  };
+
+  const ByteStream expected_bytes {
+    // clang-format off
+    0x01, 0x11, 0x21, // Byte 0
+    0x02, 0x12, 0x22, // Byte 1
+    0x03, 0x13, 0x23, // Byte 2
+    0x04, 0x14, 0x24, // Byte 3
+    // clang-format on
+  };
+
+  EXPECT_EQ(apply_tile_filter(tile_bytes, TileFilter::kShuffle), expected_bytes);
+}
+
+// tactile::apply_tile_filter
+TEST(TileFilter, ApplyDeltaShuffle)
+{
+  const TileMatrix tiles {
+    {10, 11, 12, 12},
+    {12, 5, 0, 0},
+  };
+
+  const ByteStream expected_bytes {
+    // clang-format off
+    10, 2, 2, 0, 0, 13, 9, 0, // Byte 0
+    0, 0, 0, 0, 0, 0, 0, 0,   // Byte 1
+    0, 0, 0, 0, 0, 0, 0, 0,   // Byte 2
+    0, 0, 0, 0, 0, 0, 0, 0,   // Byte 3
+    // clang-format on
+  };
+
+  EXPECT_EQ(apply_tile_filter(to_byte_stream(tiles), TileFilter::kDeltaShuffle),
+            expected_bytes);
+}
+
+// tactile::apply_tile_filter
+// tactile::revert_tile_filter
+TEST(TileFilter, Roundtrip)
+{
+  TileMatrix tiles {};
+  tiles.resize(37);
+
+  for (std::size_t row = 0; row < tiles.size(); ++row) {
+    tiles[row].resize(23);
+
+    for (std::size_t col = 0; col < tiles[row].size(); ++col) {
+      tiles[row][col] = static_cast<TileID>((row * 31 + col * 7) % 1'000) - 1;
+    }
+  }
+
+  const auto tile_bytes = to_byte_stream(tiles);
+
+  for (const auto filter :
+       {TileFilter::kNone, TileFilter::kShuffle, TileFilter::kDeltaShuffle}) {
+    const auto filtered_bytes = apply_tile_filter(tile_bytes, filter);
+    ASSERT_TRUE(filtered_bytes.has_value());
+    EXPECT_EQ(filtered_bytes->size(), tile_bytes.size());
+
+    EXPECT_EQ(revert_tile_filter(*filtered_bytes, filter), tile_bytes);
+  }
+}
+
+// tactile::apply_tile_filter
+// tactile::revert_tile_filter
+TEST(TileFilter, InvalidTileData)
+{
+  const ByteStream bytes {1, 2, 3, 4, 5};
+
+  EXPECT_FALSE(apply_tile_filter(bytes, TileFilter::kShuffle).has_value());
+  EXPECT_FALSE(revert_tile_filter(bytes, TileFilter::kDeltaShuffle).has_value());
+  EXPECT_EQ(apply_tile_filter(ByteStream {}, TileFilter::kShuffle), ByteStream {});
+}
+
+}  // namespace
+}  // namespace tactile
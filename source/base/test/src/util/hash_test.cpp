@@ -0,0 +1,23 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/base/util/hash.hpp"
+
+#include <string_view>  // string_view
+
+#include <gtest/gtest.h>
+
+namespace tactile {
+namespace {
+
+// tactile::fnv1a_hash
+TEST(Hash, Fnv1aHash)
+{
+  using namespace std::string_view_literals;
+
+  EXPECT_EQ(fnv1a_hash(ByteSpan {}), 0x811C9DC5u);
+  EXPECT_EQ(fnv1a_hash(make_byte_span("a"sv)), 0xE40C292Cu);
+  EXPECT_EQ(fnv1a_hash(make_byte_span("foobar"sv)), 0xBF9CF968u);
+}
+
+}  // namespace
+}  // namespace tactile
@@ -0,0 +1,24 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include "tactile/base/prelude.hpp"
+#include "tactile/base/runtime/runtime.hpp"
+
+namespace tactile::benchmarks {
+
+/**
+ * Returns a runtime with the null renderer and all available save and
+ * compression format plugins installed.
+ *
+ * \details
+ * The runtime is created on first use and lives until the program exits, so
+ * that plugin loading isn't included in any benchmark measurements.
+ *
+ * \return
+ * The shared benchmark runtime.
+ */
+[[nodiscard]]
+auto get_benchmark_runtime() -> IRuntime&;
+
+}  // namespace tactile::benchmarks
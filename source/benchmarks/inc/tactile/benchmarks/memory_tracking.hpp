@@ -0,0 +1,41 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>  // size_t
+
+#include "tactile/base/prelude.hpp"
+
+namespace tactile::benchmarks {
+
+/*
+ * The benchmark executable replaces the global allocation functions in order to
+ * keep track of the amount of memory allocated with operator new. Allocations
+ * made directly with malloc (or with over-aligned operator new) aren't tracked.
+ */
+
+/**
+ * Returns the number of bytes currently allocated with operator new.
+ *
+ * \return
+ * A number of bytes.
+ */
+[[nodiscard]]
+auto get_current_heap_usage() noexcept -> std::size_t;
+
+/**
+ * Returns the largest number of bytes allocated with operator new at any point
+ * since the last call to \c reset_peak_heap_usage.
+ *
+ * \return
+ * A number of bytes.
+ */
+[[nodiscard]]
+auto get_peak_heap_usage() noexcept -> std::size_t;
+
+/**
+ * Resets the peak heap usage to the current heap usage.
+ */
+void reset_peak_heap_usage() noexcept;
+
+}  // namespace tactile::benchmarks
@@ -0,0 +1,92 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <cstdint>  // int64_t
+
+#include <benchmark/benchmark.h>
+
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/numeric/extent_2d.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/base/util/tile_matrix.hpp"
+
+namespace tactile::benchmarks {
+
+/** The smallest map side length used by benchmarks. */
+inline constexpr std::int64_t kMinMapSize = 64;
+
+/** The largest map side length used by benchmarks. */
+inline constexpr std::int64_t kMaxMapSize = 8'192;
+
+/** The largest layer count used by benchmarks. */
+inline constexpr std::int64_t kMaxLayerCount = 100;
+
+/** The largest total number of tiles in maps used by multi-layer benchmarks. */
+inline constexpr std::int64_t kMaxMapTileCount = 1 << 26;
+
+/**
+ * Registers map size and layer count arguments for a benchmark.
+ *
+ * \details
+ * Map sizes range from \c kMinMapSize to \c kMaxMapSize (using the same
+ * sizes as \c RangeMultiplier(4)->Range(kMinMapSize, kMaxMapSize)), and layer
+ * counts are 1, 10, or \c kMaxLayerCount. Combinations that exceed
+ * the specified tile count are skipped, since they would only measure the
+ * memory bandwidth of the machine (or simply run out of memory).
+ *
+ * \param benchmark      The benchmark to configure.
+ * \param max_tile_count The largest allowed total number of tiles.
+ */
+void add_map_args(benchmark::internal::Benchmark* benchmark,
+                  std::int64_t max_tile_count = kMaxMapTileCount);
+
+/**
+ * Creates a square map extent.
+ *
+ * \param size The number of rows and columns.
+ *
+ * \return
+ * A map extent.
+ */
+[[nodiscard]]
+auto make_square_extent(std::int64_t size) -> Extent2D;
+
+/**
+ * Creates a tile matrix with deterministic pseudo-random content.
+ *
+ * \details
+ * The generated tiles mimic typical map content: roughly a quarter of the tiles
+ * are empty, and non-empty tiles are often repeated in short horizontal runs.
+ * This makes the tile data compressible, but not trivially so.
+ *
+ * \param extent The extent of the tile matrix.
+ * \param seed   The seed used by the random number generator.
+ *
+ * \return
+ * A tile matrix.
+ */
+[[nodiscard]]
+auto make_synthetic_tile_matrix(const Extent2D& extent, std::size_t seed = 42) -> TileMatrix;
+
+/**
+ * Creates the intermediate representation of a map with synthetic tile layers.
+ *
+ * \details
+ * The map has no tilesets, since the benchmarks shouldn't depend on images on
+ * disk. The tile identifiers are never validated, so this doesn't matter.
+ *
+ * \param extent      The extent of the map.
+ * \param layer_count The number of tile layers.
+ * \param tile_format The tile format used by the map.
+ *
+ * \return
+ * A map.
+ */
+[[nodiscard]]
+auto make_synthetic_ir_map(const Extent2D& extent,
+                           std::size_t layer_count,
+                           const ir::TileFormat& tile_format) -> ir::Map;
+
+}  // namespace tactile::benchmarks
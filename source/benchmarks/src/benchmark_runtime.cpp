@@ -0,0 +1,136 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/benchmarks/benchmark_runtime.hpp"
+
+#include "tactile/null_renderer/null_renderer_plugin.hpp"
+#include "tactile/runtime/command_line_options.hpp"
+#include "tactile/runtime/runtime_impl.hpp"
+
+#ifdef TACTILE_HAS_TILED_TMX
+  #include "tactile/tiled_tmx/tmx_format_plugin.hpp"
+#endif
+
+#ifdef TACTILE_HAS_TILED_TMJ
+  #include "tactile/tiled_tmj/tmj_format_plugin.hpp"
+#endif
+
+#ifdef TACTILE_HAS_BINARY_FORMAT
+  #include "tactile/binary/binary_format_plugin.hpp"
+#endif
+
+#ifdef TACTILE_HAS_ZLIB
+  #include "tactile/zlib/zlib_compression_plugin.hpp"
+#endif
+
+#ifdef TACTILE_HAS_ZSTD
+  #include "tactile/zstd/zstd_compression_plugin.hpp"
+#endif
+
+namespace tactile::benchmarks {
+namespace {
+
+[[nodiscard]]
+auto _get_command_line_options() -> runtime::CommandLineOptions
+{
+  // Avoid measuring log output.
+  auto options = runtime::get_default_command_line_options();
+  options.log_level = log::LogLevel::kError;
+  return options;
+}
+
+class BenchmarkRuntime final
+{
+ public:
+  TACTILE_DELETE_COPY(BenchmarkRuntime);
+  TACTILE_DELETE_MOVE(BenchmarkRuntime);
+
+  BenchmarkRuntime()
+  {
+    m_null_renderer_plugin.load(&m_runtime);
+
+#ifdef TACTILE_HAS_ZLIB
+    m_zlib_compression_plugin.load(&m_runtime);
+#endif
+
+#ifdef TACTILE_HAS_ZSTD
+    m_zstd_compression_plugin.load(&m_runtime);
+#endif
+
+#ifdef TACTILE_HAS_TILED_TMX
+    m_tmx_format_plugin.load(&m_runtime);
+#endif
+
+#ifdef TACTILE_HAS_TILED_TMJ
+    m_tmj_format_plugin.load(&m_runtime);
+#endif
+
+#ifdef TACTILE_HAS_BINARY_FORMAT
+    m_binary_format_plugin.load(&m_runtime);
+#endif
+  }
+
+  ~BenchmarkRuntime() noexcept
+  {
+#ifdef TACTILE_HAS_BINARY_FORMAT
+    m_binary_format_plugin.unload();
+#endif
+
+#ifdef TACTILE_HAS_TILED_TMJ
+    m_tmj_format_plugin.unload();
+#endif
+
+#ifdef TACTILE_HAS_TILED_TMX
+    m_tmx_format_plugin.unload();
+#endif
+
+#ifdef TACTILE_HAS_ZSTD
+    m_zstd_compression_plugin.unload();
+#endif
+
+#ifdef TACTILE_HAS_ZLIB
+    m_zlib_compression_plugin.unload();
+#endif
+
+    m_null_renderer_plugin.unload();
+  }
+
+  [[nodiscard]]
+  auto get() -> IRuntime&
+  {
+    return m_runtime;
+  }
+
+ private:
+  runtime::RuntimeImpl m_runtime {_get_command_line_options()};
+  NullRendererPlugin m_null_renderer_plugin {};
+
+#ifdef TACTILE_HAS_ZLIB
+  zlib::ZlibCompressionPlugin m_zlib_compression_plugin {};
+#endif
+
+#ifdef TACTILE_HAS_ZSTD
+  zstd::ZstdCompressionPlugin m_zstd_compression_plugin {};
+#endif
+
+#ifdef TACTILE_HAS_TILED_TMX
+  tiled_tmx::TmxFormatPlugin m_tmx_format_plugin {};
+#endif
+
+#ifdef TACTILE_HAS_TILED_TMJ
+  tiled_tmj::TmjFormatPlugin m_tmj_format_plugin {};
+#endif
+
+#ifdef TACTILE_HAS_BINARY_FORMAT
+  binary_format::BinaryFormatPlugin m_binary_format_plugin {};
+#endif
+};
+
+}  // namespace
+
+auto get_benchmark_runtime() -> IRuntime&
+{
+  static BenchmarkRuntime runtime {};
+  return runtime.get();
+}
+
+}  // namespace tactile::benchmarks
@@ -0,0 +1,61 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include <cstddef>  // size_t
+
+#include <benchmark/benchmark.h>
+
+#include "tactile/base/layer/layer_type.hpp"
+#include "tactile/base/layer/tile_orientation.hpp"
+#include "tactile/base/numeric/vec.hpp"
+#include "tactile/benchmarks/synthetic_maps.hpp"
+#include "tactile/core/cmd/command_stack.hpp"
+#include "tactile/core/cmd/layer/create_layer_command.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/map/map_spec.hpp"
+
+namespace tactile::benchmarks {
+namespace {
+
+// Each command creates a layer with the same size as the map, so the map size
+// determines the cost of every undo and redo.
+void BM_UndoRedoCreateLayer(benchmark::State& state)
+{
+  const auto command_count = static_cast<std::size_t>(state.range(1));
+
+  const core::MapSpec map_spec {
+    .orientation = TileOrientation::kOrthogonal,
+    .extent = make_square_extent(state.range(0)),
+    .tile_size = Int2 {32, 32},
+  };
+
+  auto map_document = core::MapDocument::make(map_spec);
+  if (!map_document.has_value()) {
+    state.SkipWithError("Could not create map document");
+    return;
+  }
+
+  core::CommandStack command_stack {command_count};
+  for (std::size_t index = 0; index < command_count; ++index) {
+    command_stack.push<core::CreateLayerCommand>(&*map_document, LayerType::kTileLayer);
+  }
+
+  for (auto _ : state) {
+    while (command_stack.can_undo()) {
+      command_stack.undo();
+    }
+
+    while (command_stack.can_redo()) {
+      command_stack.redo();
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * 2 * state.range(1));
+}
+
+}  // namespace
+
+BENCHMARK(BM_UndoRedoCreateLayer)
+    ->ArgNames({"size", "commands"})
+    ->ArgsProduct({{kMinMapSize, 256, 1'024}, {1, 10, kMaxLayerCount}});
+
+}  // namespace tactile::benchmarks
@@ -0,0 +1,179 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include <cstdint>   // int64_t
+#include <expected>  // expected, unexpected
+#include <optional>  // nullopt
+#include <utility>   // move
+
+#include <benchmark/benchmark.h>
+
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/io/compress/compression_format.hpp"
+#include "tactile/base/io/compress/compression_format_id.hpp"
+#include "tactile/base/io/tile_filter.hpp"
+#include "tactile/base/io/tile_io.hpp"
+#include "tactile/benchmarks/benchmark_runtime.hpp"
+#include "tactile/benchmarks/synthetic_maps.hpp"
+
+namespace tactile::benchmarks {
+namespace {
+
+// Filters are part of the measured work, since they're part of the encoding cost.
+[[nodiscard]]
+auto _compress_tiles(const ICompressionFormat& compression_format,
+                     const ByteSpan tile_bytes,
+                     const TileFilter tile_filter) -> std::expected<ByteStream, ErrorCode>
+{
+  const CompressionOptions compression_options {
+    .level = std::nullopt,
+    .thread_count = 1,
+    .dictionary = ByteSpan {},
+  };
+
+  if (tile_filter == TileFilter::kNone) {
+    return compression_format.compress(tile_bytes, compression_options);
+  }
+
+  const auto filtered_bytes = apply_tile_filter(tile_bytes, tile_filter);
+  if (!filtered_bytes.has_value()) {
+    return std::unexpected {ErrorCode::kBadParam};
+  }
+
+  return compression_format.compress(make_byte_span(*filtered_bytes), compression_options);
+}
+
+[[nodiscard]]
+auto _decompress_tiles(const ICompressionFormat& compression_format,
+                       const ByteSpan compressed_bytes,
+                       const TileFilter tile_filter) -> std::expected<ByteStream, ErrorCode>
+{
+  const DecompressionOptions decompression_options {
+    .dictionary = ByteSpan {},
+  };
+
+  auto filtered_bytes = compression_format.decompress(compressed_bytes, decompression_options);
+  if (!filtered_bytes.has_value() || tile_filter == TileFilter::kNone) {
+    return filtered_bytes;
+  }
+
+  auto tile_bytes = revert_tile_filter(make_byte_span(*filtered_bytes), tile_filter);
+  if (!tile_bytes.has_value()) {
+    return std::unexpected {ErrorCode::kBadParam};
+  }
+
+  return std::move(*tile_bytes);
+}
+
+void BM_Compress(benchmark::State& state,
+                 const CompressionFormatId format_id,
+                 const TileFilter tile_filter)
+{
+  const auto* compression_format = get_benchmark_runtime().get_compression_format(format_id);
+  if (!compression_format) {
+    state.SkipWithError("Compression format is not available");
+    return;
+  }
+
+  const auto extent = make_square_extent(state.range(0));
+  const auto bytes = to_byte_stream(make_synthetic_tile_matrix(extent));
+
+  std::int64_t compressed_byte_count = 0;
+
+  for (auto _ : state) {
+    const auto compressed_bytes =
+        _compress_tiles(*compression_format, make_byte_span(bytes), tile_filter);
+    if (!compressed_bytes.has_value()) {
+      state.SkipWithError("Could not compress data");
+      return;
+    }
+
+    benchmark::DoNotOptimize(compressed_bytes->data());
+    compressed_byte_count = static_cast<std::int64_t>(compressed_bytes->size());
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes.size()));
+  state.counters["ratio"] =
+      static_cast<double>(bytes.size()) / static_cast<double>(compressed_byte_count);
+}
+
+void BM_Decompress(benchmark::State& state,
+                   const CompressionFormatId format_id,
+                   const TileFilter tile_filter)
+{
+  const auto* compression_format = get_benchmark_runtime().get_compression_format(format_id);
+  if (!compression_format) {
+    state.SkipWithError("Compression format is not available");
+    return;
+  }
+
+  const auto extent = make_square_extent(state.range(0));
+  const auto bytes = to_byte_stream(make_synthetic_tile_matrix(extent));
+
+  const auto compressed_bytes =
+      _compress_tiles(*compression_format, make_byte_span(bytes), tile_filter);
+  if (!compressed_bytes.has_value()) {
+    state.SkipWithError("Could not compress data");
+    return;
+  }
+
+  const auto compressed_byte_span = make_byte_span(*compressed_bytes);
+
+  for (auto _ : state) {
+    const auto decompressed_bytes =
+        _decompress_tiles(*compression_format, compressed_byte_span, tile_filter);
+    if (!decompressed_bytes.has_value()) {
+      state.SkipWithError("Could not decompress data");
+      return;
+    }
+
+    benchmark::DoNotOptimize(decompressed_bytes->data());
+  }
+
+  // Throughput is measured in terms of decompressed bytes, for comparability.
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes.size()));
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_Compress, zlib, CompressionFormatId::kZlib, TileFilter::kNone)
+    ->RangeMultiplier(4)
+    ->Range(kMinMapSize, kMaxMapSize);
+
+BENCHMARK_CAPTURE(BM_Compress, zstd, CompressionFormatId::kZstd, TileFilter::kNone)
+    ->RangeMultiplier(4)
+    ->Range(kMinMapSize, kMaxMapSize);
+
+BENCHMARK_CAPTURE(BM_Compress, zstd_shuffle, CompressionFormatId::kZstd, TileFilter::kShuffle)
+    ->RangeMultiplier(4)
+    ->Range(kMinMapSize, kMaxMapSize);
+
+BENCHMARK_CAPTURE(BM_Compress,
+                  zstd_delta_shuffle,
+                  CompressionFormatId::kZstd,
+                  TileFilter::kDeltaShuffle)
+    ->RangeMultiplier(4)
+    ->Range(kMinMapSize, kMaxMapSize);
+
+BENCHMARK_CAPTURE(BM_Decompress, zlib, CompressionFormatId::kZlib, TileFilter::kNone)
+    ->RangeMultiplier(4)
+    ->Range(kMinMapSize, kMaxMapSize);
+
+BENCHMARK_CAPTURE(BM_Decompress, zstd, CompressionFormatId::kZstd, TileFilter::kNone)
+    ->RangeMultiplier(4)
+    ->Range(kMinMapSize, kMaxMapSize);
+
+BENCHMARK_CAPTURE(BM_Decompress,
+                  zstd_shuffle,
+                  CompressionFormatId::kZstd,
+                  TileFilter::kShuffle)
+    ->RangeMultiplier(4)
+    ->Range(kMinMapSize, kMaxMapSize);
+
+BENCHMARK_CAPTURE(BM_Decompress,
+                  zstd_delta_shuffle,
+                  CompressionFormatId::kZstd,
+                  TileFilter::kDeltaShuffle)
+    ->RangeMultiplier(4)
+    ->Range(kMinMapSize, kMaxMapSize);
+
+}  // namespace tactile::benchmarks
@@ -0,0 +1,39 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include <cstdlib>      // EXIT_SUCCESS, EXIT_FAILURE
+#include <string>       // string
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include <benchmark/benchmark.h>
+
+auto main(int argc, char* argv[]) -> int
+{
+  std::vector<char*> args {argv, argv + argc};
+
+  // Results are reported as JSON by default, so that they can be tracked by CI.
+  std::string json_format_arg {"--benchmark_format=json"};
+
+  bool has_format_arg = false;
+  for (const std::string_view arg : args) {
+    if (arg.starts_with("--benchmark_format")) {
+      has_format_arg = true;
+    }
+  }
+
+  if (!has_format_arg) {
+    args.push_back(json_format_arg.data());
+  }
+
+  auto arg_count = static_cast<int>(args.size());
+  benchmark::Initialize(&arg_count, args.data());
+
+  if (benchmark::ReportUnrecognizedArguments(arg_count, args.data())) {
+    return EXIT_FAILURE;
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,102 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include <cstddef>   // size_t
+#include <cstdint>   // int64_t
+#include <optional>  // optional, nullopt
+#include <utility>   // move
+
+#include <benchmark/benchmark.h>
+
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/layer/tile_encoding.hpp"
+#include "tactile/base/render/renderer.hpp"
+#include "tactile/benchmarks/benchmark_runtime.hpp"
+#include "tactile/benchmarks/synthetic_maps.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/map/map.hpp"
+
+namespace tactile::benchmarks {
+namespace {
+
+void _add_map_args(benchmark::internal::Benchmark* benchmark)
+{
+  add_map_args(benchmark);
+}
+
+[[nodiscard]]
+auto _make_ir_map(const benchmark::State& state) -> ir::Map
+{
+  return make_synthetic_ir_map(make_square_extent(state.range(0)),
+                               static_cast<std::size_t>(state.range(1)),
+                               ir::TileFormat {
+                                 .encoding = TileEncoding::kPlainText,
+                                 .compression = std::nullopt,
+                                 .compression_level = std::nullopt,
+                               });
+}
+
+void BM_MakeMap_CopyIR(benchmark::State& state)
+{
+  auto* renderer = get_benchmark_runtime().get_renderer();
+  if (!renderer) {
+    state.SkipWithError("Renderer is not available");
+    return;
+  }
+
+  const auto ir_map = _make_ir_map(state);
+  std::optional<core::Registry> registry {};
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    registry.emplace();
+    state.ResumeTiming();
+
+    const auto map_id = core::make_map(*registry, *renderer, ir_map);
+    benchmark::DoNotOptimize(map_id);
+
+    // Don't measure the time it takes to destroy the map.
+    state.PauseTiming();
+    registry.reset();
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0) *
+                          state.range(1));
+}
+
+void BM_MakeMap_MoveIR(benchmark::State& state)
+{
+  auto* renderer = get_benchmark_runtime().get_renderer();
+  if (!renderer) {
+    state.SkipWithError("Renderer is not available");
+    return;
+  }
+
+  const auto ir_map = _make_ir_map(state);
+  std::optional<core::Registry> registry {};
+
+  for (auto _ : state) {
+    // The IR is consumed by each iteration, so a fresh copy is created untimed.
+    state.PauseTiming();
+    registry.emplace();
+    auto ir_map_copy = ir_map;
+    state.ResumeTiming();
+
+    const auto map_id = core::make_map(*registry, *renderer, std::move(ir_map_copy));
+    benchmark::DoNotOptimize(map_id);
+
+    state.PauseTiming();
+    registry.reset();
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0) *
+                          state.range(1));
+}
+
+}  // namespace
+
+BENCHMARK(BM_MakeMap_CopyIR)->Apply(_add_map_args);
+BENCHMARK(BM_MakeMap_MoveIR)->Apply(_add_map_args);
+
+}  // namespace tactile::benchmarks
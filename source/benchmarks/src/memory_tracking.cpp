@@ -0,0 +1,89 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/benchmarks/memory_tracking.hpp"
+
+#include <atomic>   // atomic, memory_order
+#include <cstddef>  // size_t, byte, max_align_t
+#include <cstdlib>  // malloc, free
+#include <cstring>  // memcpy
+#include <new>      // bad_alloc
+
+namespace tactile::benchmarks {
+namespace {
+
+// Each allocation is prefixed by its size, padded to preserve alignment.
+inline constexpr std::size_t kHeaderSize = alignof(std::max_align_t);
+
+constinit std::atomic_size_t gCurrentHeapUsage {0};
+constinit std::atomic_size_t gPeakHeapUsage {0};
+
+void _on_allocate(const std::size_t size) noexcept
+{
+  const auto usage = gCurrentHeapUsage.fetch_add(size, std::memory_order_relaxed) + size;
+
+  auto peak = gPeakHeapUsage.load(std::memory_order_relaxed);
+  while (usage > peak &&
+         !gPeakHeapUsage.compare_exchange_weak(peak, usage, std::memory_order_relaxed)) {
+  }
+}
+
+void _on_deallocate(const std::size_t size) noexcept
+{
+  gCurrentHeapUsage.fetch_sub(size, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+auto get_current_heap_usage() noexcept -> std::size_t
+{
+  return gCurrentHeapUsage.load(std::memory_order_relaxed);
+}
+
+auto get_peak_heap_usage() noexcept -> std::size_t
+{
+  return gPeakHeapUsage.load(std::memory_order_relaxed);
+}
+
+void reset_peak_heap_usage() noexcept
+{
+  gPeakHeapUsage.store(gCurrentHeapUsage.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+}
+
+}  // namespace tactile::benchmarks
+
+// The remaining standard allocation functions (nothrow and array variants) are
+// implemented in terms of these functions.
+
+auto operator new(const std::size_t size) -> void*
+{
+  auto* block = static_cast<std::byte*>(std::malloc(size + tactile::benchmarks::kHeaderSize));
+  if (!block) {
+    throw std::bad_alloc {};
+  }
+
+  std::memcpy(block, &size, sizeof size);
+  tactile::benchmarks::_on_allocate(size);
+
+  return block + tactile::benchmarks::kHeaderSize;
+}
+
+void operator delete(void* ptr) noexcept
+{
+  if (!ptr) {
+    return;
+  }
+
+  auto* block = static_cast<std::byte*>(ptr) - tactile::benchmarks::kHeaderSize;
+
+  std::size_t size {};
+  std::memcpy(&size, block, sizeof size);
+  tactile::benchmarks::_on_deallocate(size);
+
+  std::free(block);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  operator delete(ptr);
+}
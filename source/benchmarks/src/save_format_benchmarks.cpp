@@ -0,0 +1,249 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include <algorithm>   // max
+#include <cstddef>     // size_t
+#include <cstdint>     // int64_t
+#include <filesystem>  // path, temp_directory_path, create_directories, file_size
+#include <memory>      // unique_ptr
+#include <optional>    // optional, nullopt
+
+#include <benchmark/benchmark.h>
+
+#include "tactile/base/document/document.hpp"
+#include "tactile/base/document/map_view.hpp"
+#include "tactile/base/io/compress/compression_format_id.hpp"
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/io/save/save_format.hpp"
+#include "tactile/base/io/save/save_format_id.hpp"
+#include "tactile/base/layer/tile_encoding.hpp"
+#include "tactile/base/render/renderer.hpp"
+#include "tactile/benchmarks/benchmark_runtime.hpp"
+#include "tactile/benchmarks/memory_tracking.hpp"
+#include "tactile/benchmarks/synthetic_maps.hpp"
+#include "tactile/runtime/document_factory.hpp"
+
+namespace tactile::benchmarks {
+namespace {
+
+// Text based formats are slow and produce large files, so the maps are smaller.
+inline constexpr std::int64_t kMaxSaveFormatTileCount = 1 << 24;
+
+struct SaveFormatBenchmarkConfig final
+{
+  SaveFormatId format_id;
+  const char* map_filename;
+  TileEncoding encoding;
+  std::optional<CompressionFormatId> compression;
+};
+
+void _add_save_format_args(benchmark::internal::Benchmark* benchmark)
+{
+  add_map_args(benchmark, kMaxSaveFormatTileCount);
+}
+
+[[nodiscard]]
+auto _get_map_dir() -> std::filesystem::path
+{
+  auto map_dir = std::filesystem::temp_directory_path() / "tactile-benchmarks";
+  std::filesystem::create_directories(map_dir);
+  return map_dir;
+}
+
+[[nodiscard]]
+auto _make_synthetic_map_document(benchmark::State& state,
+                                  const SaveFormatBenchmarkConfig& config)
+    -> std::unique_ptr<IDocument>
+{
+  auto* renderer = get_benchmark_runtime().get_renderer();
+  if (!renderer) {
+    state.SkipWithError("Renderer is not available");
+    return nullptr;
+  }
+
+  const auto ir_map = make_synthetic_ir_map(make_square_extent(state.range(0)),
+                                            static_cast<std::size_t>(state.range(1)),
+                                            ir::TileFormat {
+                                              .encoding = config.encoding,
+                                              .compression = config.compression,
+                                              .compression_level = std::nullopt,
+                                            });
+
+  auto map_document = runtime::make_map_document(*renderer, ir_map);
+  if (!map_document) {
+    state.SkipWithError("Could not create map document");
+    return nullptr;
+  }
+
+  map_document->set_path(_get_map_dir() / config.map_filename);
+
+  return map_document;
+}
+
+[[nodiscard]]
+auto _get_write_options() -> SaveFormatWriteOptions
+{
+  return SaveFormatWriteOptions {
+    .base_dir = _get_map_dir(),
+    .use_external_tilesets = false,
+    .use_indentation = false,
+    .fold_tile_layer_data = false,
+    .compression_level = std::nullopt,
+    .compression_dictionary = ByteSpan {},
+  };
+}
+
+[[nodiscard]]
+auto _make_byte_counter(const std::size_t byte_count) -> benchmark::Counter
+{
+  return benchmark::Counter {static_cast<double>(byte_count),
+                             benchmark::Counter::kDefaults,
+                             benchmark::Counter::kIs1024};
+}
+
+// The peak heap growth shows how much memory the emitters need on top of the map itself.
+void BM_SaveMap(benchmark::State& state, const SaveFormatBenchmarkConfig& config)
+{
+  const auto* save_format = get_benchmark_runtime().get_save_format(config.format_id);
+  if (!save_format) {
+    state.SkipWithError("Save format is not available");
+    return;
+  }
+
+  const auto map_document = _make_synthetic_map_document(state, config);
+  if (!map_document) {
+    return;
+  }
+
+  const auto map_view = runtime::make_map_view(*map_document);
+  const auto write_options = _get_write_options();
+
+  std::size_t peak_heap_growth = 0;
+
+  for (auto _ : state) {
+    const auto base_heap_usage = get_current_heap_usage();
+    reset_peak_heap_usage();
+
+    if (!save_format->save_map(*map_view, write_options).has_value()) {
+      state.SkipWithError("Could not save map");
+      return;
+    }
+
+    peak_heap_growth = std::max(peak_heap_growth, get_peak_heap_usage() - base_heap_usage);
+  }
+
+  const auto file_size = std::filesystem::file_size(*map_document->get_path());
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(file_size));
+  state.counters["file_size"] = _make_byte_counter(file_size);
+  state.counters["peak_heap_growth"] = _make_byte_counter(peak_heap_growth);
+}
+
+void BM_LoadMap(benchmark::State& state, const SaveFormatBenchmarkConfig& config)
+{
+  const auto* save_format = get_benchmark_runtime().get_save_format(config.format_id);
+  if (!save_format) {
+    state.SkipWithError("Save format is not available");
+    return;
+  }
+
+  const auto map_document = _make_synthetic_map_document(state, config);
+  if (!map_document) {
+    return;
+  }
+
+  // The map file is written by a single untimed save operation.
+  const auto map_view = runtime::make_map_view(*map_document);
+  if (!save_format->save_map(*map_view, _get_write_options()).has_value()) {
+    state.SkipWithError("Could not save map");
+    return;
+  }
+
+  const auto& map_path = *map_document->get_path();
+
+  const SaveFormatReadOptions read_options {
+    .base_dir = _get_map_dir(),
+    .strict_mode = false,
+    .compression_dictionary = ByteSpan {},
+  };
+
+  for (auto _ : state) {
+    auto ir_map = save_format->load_map(map_path, read_options);
+    if (!ir_map.has_value()) {
+      state.SkipWithError("Could not load map");
+      return;
+    }
+
+    benchmark::DoNotOptimize(ir_map);
+  }
+
+  const auto file_size = std::filesystem::file_size(map_path);
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(file_size));
+}
+
+inline constexpr SaveFormatBenchmarkConfig kTmjPlainText {
+  .format_id = SaveFormatId::kTiledTmj,
+  .map_filename = "plain_text.tmj",
+  .encoding = TileEncoding::kPlainText,
+  .compression = std::nullopt,
+};
+
+inline constexpr SaveFormatBenchmarkConfig kTmjBase64Zlib {
+  .format_id = SaveFormatId::kTiledTmj,
+  .map_filename = "base64_zlib.tmj",
+  .encoding = TileEncoding::kBase64,
+  .compression = CompressionFormatId::kZlib,
+};
+
+inline constexpr SaveFormatBenchmarkConfig kTmjBase64Zstd {
+  .format_id = SaveFormatId::kTiledTmj,
+  .map_filename = "base64_zstd.tmj",
+  .encoding = TileEncoding::kBase64,
+  .compression = CompressionFormatId::kZstd,
+};
+
+inline constexpr SaveFormatBenchmarkConfig kTmxPlainText {
+  .format_id = SaveFormatId::kTiledTmx,
+  .map_filename = "plain_text.tmx",
+  .encoding = TileEncoding::kPlainText,
+  .compression = std::nullopt,
+};
+
+inline constexpr SaveFormatBenchmarkConfig kTmxBase64Zlib {
+  .format_id = SaveFormatId::kTiledTmx,
+  .map_filename = "base64_zlib.tmx",
+  .encoding = TileEncoding::kBase64,
+  .compression = CompressionFormatId::kZlib,
+};
+
+inline constexpr SaveFormatBenchmarkConfig kTmxBase64Zstd {
+  .format_id = SaveFormatId::kTiledTmx,
+  .map_filename = "base64_zstd.tmx",
+  .encoding = TileEncoding::kBase64,
+  .compression = CompressionFormatId::kZstd,
+};
+
+inline constexpr SaveFormatBenchmarkConfig kBinary {
+  .format_id = SaveFormatId::kTactileBinary,
+  .map_filename = "map.tactile",
+  .encoding = TileEncoding::kPlainText,
+  .compression = std::nullopt,
+};
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_SaveMap, tmj_plain_text, kTmjPlainText)->Apply(_add_save_format_args);
+BENCHMARK_CAPTURE(BM_SaveMap, tmj_base64_zlib, kTmjBase64Zlib)->Apply(_add_save_format_args);
+BENCHMARK_CAPTURE(BM_SaveMap, tmj_base64_zstd, kTmjBase64Zstd)->Apply(_add_save_format_args);
+BENCHMARK_CAPTURE(BM_SaveMap, tmx_plain_text, kTmxPlainText)->Apply(_add_save_format_args);
+BENCHMARK_CAPTURE(BM_SaveMap, tmx_base64_zlib, kTmxBase64Zlib)->Apply(_add_save_format_args);
+BENCHMARK_CAPTURE(BM_SaveMap, tmx_base64_zstd, kTmxBase64Zstd)->Apply(_add_save_format_args);
+BENCHMARK_CAPTURE(BM_SaveMap, binary, kBinary)->Apply(_add_save_format_args);
+
+BENCHMARK_CAPTURE(BM_LoadMap, tmj_plain_text, kTmjPlainText)->Apply(_add_save_format_args);
+BENCHMARK_CAPTURE(BM_LoadMap, tmj_base64_zlib, kTmjBase64Zlib)->Apply(_add_save_format_args);
+BENCHMARK_CAPTURE(BM_LoadMap, tmj_base64_zstd, kTmjBase64Zstd)->Apply(_add_save_format_args);
+BENCHMARK_CAPTURE(BM_LoadMap, tmx_plain_text, kTmxPlainText)->Apply(_add_save_format_args);
+BENCHMARK_CAPTURE(BM_LoadMap, tmx_base64_zlib, kTmxBase64Zlib)->Apply(_add_save_format_args);
+BENCHMARK_CAPTURE(BM_LoadMap, tmx_base64_zstd, kTmxBase64Zstd)->Apply(_add_save_format_args);
+BENCHMARK_CAPTURE(BM_LoadMap, binary, kBinary)->Apply(_add_save_format_args);
+
+}  // namespace tactile::benchmarks
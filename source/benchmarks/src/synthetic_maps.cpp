@@ -0,0 +1,114 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/benchmarks/synthetic_maps.hpp"
+
+#include <format>   // format
+#include <random>   // minstd_rand, uniform_int_distribution
+#include <vector>   // vector
+
+#include "tactile/base/numeric/saturate_cast.hpp"
+
+namespace tactile::benchmarks {
+namespace {
+
+inline constexpr TileID kMaxSyntheticTileId = 256;
+inline constexpr int kMaxTileRunLength = 8;
+
+}  // namespace
+
+void add_map_args(benchmark::internal::Benchmark* benchmark,
+                  const std::int64_t max_tile_count)
+{
+  benchmark->ArgNames({"size", "layers"});
+
+  std::vector<std::int64_t> sizes {};
+  for (auto size = kMinMapSize; size < kMaxMapSize; size *= 4) {
+    sizes.push_back(size);
+  }
+  sizes.push_back(kMaxMapSize);
+
+  for (const auto size : sizes) {
+    for (const auto layer_count : {std::int64_t {1}, std::int64_t {10}, kMaxLayerCount}) {
+      if (size * size * layer_count <= max_tile_count) {
+        benchmark->Args({size, layer_count});
+      }
+    }
+  }
+}
+
+auto make_square_extent(const std::int64_t size) -> Extent2D
+{
+  const auto side = saturate_cast<Extent2D::value_type>(size);
+  return Extent2D {.rows = side, .cols = side};
+}
+
+auto make_synthetic_tile_matrix(const Extent2D& extent, const std::size_t seed) -> TileMatrix
+{
+  std::minstd_rand engine {static_cast<std::minstd_rand::result_type>(seed)};
+  std::uniform_int_distribution<TileID> tile_id_dist {0, kMaxSyntheticTileId};
+  std::uniform_int_distribution<int> run_length_dist {1, kMaxTileRunLength};
+
+  auto tile_matrix = make_tile_matrix(extent);
+
+  for (auto& tile_row : tile_matrix) {
+    TileID tile_id = kEmptyTile;
+    int remaining_run_length = 0;
+
+    for (auto& tile : tile_row) {
+      if (remaining_run_length == 0) {
+        // Roughly a quarter of all runs are empty.
+        tile_id = tile_id_dist(engine) % 4 == 0 ? kEmptyTile : tile_id_dist(engine) + 1;
+        remaining_run_length = run_length_dist(engine);
+      }
+
+      tile = tile_id;
+      --remaining_run_length;
+    }
+  }
+
+  return tile_matrix;
+}
+
+auto make_synthetic_ir_map(const Extent2D& extent,
+                           const std::size_t layer_count,
+                           const ir::TileFormat& tile_format) -> ir::Map
+{
+  ir::Map ir_map {
+    .meta = ir::Metadata {.name = "Map", .properties = {}, .components = {}},
+    .extent = extent,
+    .tile_size = Int2 {32, 32},
+    .next_layer_id = 1,
+    .next_object_id = 1,
+    .tile_format = tile_format,
+    .components = {},
+    .tilesets = {},
+    .layers = {},
+  };
+
+  ir_map.layers.reserve(layer_count);
+
+  for (std::size_t layer_index = 0; layer_index < layer_count; ++layer_index) {
+    const auto layer_id = ir_map.next_layer_id++;
+
+    ir_map.layers.push_back(ir::Layer {
+      .meta =
+          ir::Metadata {
+            .name = std::format("Layer {}", layer_id),
+            .properties = {},
+            .components = {},
+          },
+      .id = layer_id,
+      .type = LayerType::kTileLayer,
+      .opacity = 1.0f,
+      .extent = extent,
+      .tiles = make_synthetic_tile_matrix(extent, layer_index),
+      .objects = {},
+      .layers = {},
+      .visible = true,
+    });
+  }
+
+  return ir_map;
+}
+
+}  // namespace tactile::benchmarks
@@ -0,0 +1,55 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include <cstdint>  // int64_t
+
+#include <benchmark/benchmark.h>
+
+#include "tactile/base/io/tile_io.hpp"
+#include "tactile/benchmarks/synthetic_maps.hpp"
+
+namespace tactile::benchmarks {
+namespace {
+
+void BM_ToByteStream(benchmark::State& state)
+{
+  const auto extent = make_square_extent(state.range(0));
+  const auto tile_matrix = make_synthetic_tile_matrix(extent);
+
+  std::int64_t byte_count = 0;
+
+  for (auto _ : state) {
+    const auto bytes = to_byte_stream(tile_matrix);
+    benchmark::DoNotOptimize(bytes.data());
+
+    byte_count += static_cast<std::int64_t>(bytes.size());
+  }
+
+  state.SetBytesProcessed(byte_count);
+}
+
+void BM_ParseRawTileMatrix(benchmark::State& state, const TileIdFormat tile_id_format)
+{
+  const auto extent = make_square_extent(state.range(0));
+  const auto bytes = to_byte_stream(make_synthetic_tile_matrix(extent));
+
+  for (auto _ : state) {
+    auto tile_matrix = parse_raw_tile_matrix(bytes, extent, tile_id_format);
+    benchmark::DoNotOptimize(tile_matrix);
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes.size()));
+}
+
+}  // namespace
+
+BENCHMARK(BM_ToByteStream)->RangeMultiplier(4)->Range(kMinMapSize, kMaxMapSize);
+
+BENCHMARK_CAPTURE(BM_ParseRawTileMatrix, tactile, TileIdFormat::kTactile)
+    ->RangeMultiplier(4)
+    ->Range(kMinMapSize, kMaxMapSize);
+
+BENCHMARK_CAPTURE(BM_ParseRawTileMatrix, tiled, TileIdFormat::kTiled)
+    ->RangeMultiplier(4)
+    ->Range(kMinMapSize, kMaxMapSize);
+
+}  // namespace tactile::benchmarks
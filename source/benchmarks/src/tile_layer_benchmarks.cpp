@@ -0,0 +1,82 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include <cstdint>  // int64_t, uint64_t
+
+#include <benchmark/benchmark.h>
+
+#include "tactile/base/numeric/index_2d.hpp"
+#include "tactile/benchmarks/synthetic_maps.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
+
+namespace tactile::benchmarks {
+namespace {
+
+// Sparse tile layers use a hash map, so very large sparse layers are skipped.
+inline constexpr std::int64_t kMaxSparseMapSize = 1'024;
+
+void _each_layer_tile(benchmark::State& state, const bool sparse)
+{
+  const auto extent = make_square_extent(state.range(0));
+
+  core::Registry registry {};
+  const auto layer_id =
+      core::make_tile_layer(registry, extent, make_synthetic_tile_matrix(extent));
+
+  if (sparse) {
+    core::convert_to_sparse_tile_layer(registry, layer_id);
+  }
+  else {
+    core::convert_to_dense_tile_layer(registry, layer_id);
+  }
+
+  for (auto _ : state) {
+    std::uint64_t tile_id_sum = 0;
+
+    core::each_layer_tile(registry, layer_id, [&](const Index2D&, const TileID tile_id) {
+      tile_id_sum += static_cast<std::uint64_t>(tile_id);
+    });
+
+    benchmark::DoNotOptimize(tile_id_sum);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+
+void BM_EachLayerTile_Dense(benchmark::State& state)
+{
+  _each_layer_tile(state, false);
+}
+
+void BM_EachLayerTile_Sparse(benchmark::State& state)
+{
+  _each_layer_tile(state, true);
+}
+
+void BM_SerializeTileLayer(benchmark::State& state)
+{
+  const auto extent = make_square_extent(state.range(0));
+
+  core::Registry registry {};
+  const auto layer_id =
+      core::make_tile_layer(registry, extent, make_synthetic_tile_matrix(extent));
+
+  std::int64_t byte_count = 0;
+
+  for (auto _ : state) {
+    const auto bytes = core::serialize_tile_layer(registry, layer_id);
+    benchmark::DoNotOptimize(bytes.data());
+
+    byte_count += static_cast<std::int64_t>(bytes.size());
+  }
+
+  state.SetBytesProcessed(byte_count);
+}
+
+}  // namespace
+
+BENCHMARK(BM_EachLayerTile_Dense)->RangeMultiplier(4)->Range(kMinMapSize, kMaxMapSize);
+BENCHMARK(BM_EachLayerTile_Sparse)->RangeMultiplier(4)->Range(kMinMapSize, kMaxSparseMapSize);
+BENCHMARK(BM_SerializeTileLayer)->RangeMultiplier(4)->Range(kMinMapSize, kMaxMapSize);
+
+}  // namespace tactile::benchmarks
@@ -0,0 +1,186 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include <algorithm>   // max
+#include <cstddef>     // size_t
+#include <cstdint>     // int64_t
+#include <filesystem>  // path, temp_directory_path, create_directories, file_size
+#include <optional>    // optional, nullopt
+
+#include <benchmark/benchmark.h>
+
+#include "tactile/base/document/document.hpp"
+#include "tactile/base/document/map_view.hpp"
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/io/save/save_format.hpp"
+#include "tactile/base/io/save/save_format_id.hpp"
+#include "tactile/base/layer/tile_encoding.hpp"
+#include "tactile/benchmarks/benchmark_runtime.hpp"
+#include "tactile/benchmarks/memory_tracking.hpp"
+#include "tactile/benchmarks/synthetic_maps.hpp"
+#include "tactile/runtime/document_factory.hpp"
+
+#ifdef TACTILE_HAS_TILED_TMJ
+  #include "tactile/tiled_tmj/tmj_common.hpp"
+  #include "tactile/tiled_tmj/tmj_format_parser.hpp"
+#endif
+
+namespace tactile::benchmarks {
+namespace {
+
+#ifdef TACTILE_HAS_TILED_TMJ
+
+// Produces a plain text TMJ file of roughly 200 MB.
+inline constexpr std::int64_t kLargeTmjMapSize = 4'096;
+inline constexpr std::size_t kLargeTmjMapLayerCount = 4;
+
+[[nodiscard]]
+auto _get_large_tmj_map_path() -> std::filesystem::path
+{
+  const auto map_dir = std::filesystem::temp_directory_path() / "tactile-benchmarks";
+  std::filesystem::create_directories(map_dir);
+  return map_dir / "large_plain_text.tmj";
+}
+
+[[nodiscard]]
+auto _save_large_tmj_map(const std::filesystem::path& map_path) -> bool
+{
+  auto& benchmark_runtime = get_benchmark_runtime();
+
+  const auto* save_format = benchmark_runtime.get_save_format(SaveFormatId::kTiledTmj);
+  auto* renderer = benchmark_runtime.get_renderer();
+  if (!save_format || !renderer) {
+    return false;
+  }
+
+  const auto ir_map = make_synthetic_ir_map(make_square_extent(kLargeTmjMapSize),
+                                            kLargeTmjMapLayerCount,
+                                            ir::TileFormat {
+                                              .encoding = TileEncoding::kPlainText,
+                                              .compression = std::nullopt,
+                                              .compression_level = std::nullopt,
+                                            });
+
+  const auto map_document = runtime::make_map_document(*renderer, ir_map);
+  if (!map_document) {
+    return false;
+  }
+
+  map_document->set_path(map_path);
+
+  const SaveFormatWriteOptions write_options {
+    .base_dir = map_path.parent_path(),
+    .use_external_tilesets = false,
+    .use_indentation = false,
+    .fold_tile_layer_data = false,
+    .compression_level = std::nullopt,
+    .compression_dictionary = ByteSpan {},
+  };
+
+  const auto map_view = runtime::make_map_view(*map_document);
+  return save_format->save_map(*map_view, write_options).has_value();
+}
+
+// The map is only written once per process, since it takes a while to generate.
+[[nodiscard]]
+auto _prepare_large_tmj_map(benchmark::State& state) -> std::optional<std::filesystem::path>
+{
+  static const auto map_path = []() -> std::optional<std::filesystem::path> {
+    auto path = _get_large_tmj_map_path();
+    if (!_save_large_tmj_map(path)) {
+      return std::nullopt;
+    }
+
+    return path;
+  }();
+
+  if (!map_path.has_value()) {
+    state.SkipWithError("Could not save large TMJ map");
+  }
+
+  return map_path;
+}
+
+[[nodiscard]]
+auto _make_byte_counter(const std::size_t byte_count) -> benchmark::Counter
+{
+  return benchmark::Counter {static_cast<double>(byte_count),
+                             benchmark::Counter::kDefaults,
+                             benchmark::Counter::kIs1024};
+}
+
+template <typename Loader>
+void _run_large_tmj_map_benchmark(benchmark::State& state, const Loader& load_map)
+{
+  const auto map_path = _prepare_large_tmj_map(state);
+  if (!map_path.has_value()) {
+    return;
+  }
+
+  const SaveFormatReadOptions read_options {
+    .base_dir = map_path->parent_path(),
+    .strict_mode = false,
+    .compression_dictionary = ByteSpan {},
+  };
+
+  std::size_t peak_heap_growth = 0;
+
+  for (auto _ : state) {
+    const auto base_heap_usage = get_current_heap_usage();
+    reset_peak_heap_usage();
+
+    auto ir_map = load_map(*map_path, read_options);
+    if (!ir_map.has_value()) {
+      state.SkipWithError("Could not load map");
+      return;
+    }
+
+    benchmark::DoNotOptimize(ir_map);
+
+    peak_heap_growth = std::max(peak_heap_growth, get_peak_heap_usage() - base_heap_usage);
+  }
+
+  const auto file_size = std::filesystem::file_size(*map_path);
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(file_size));
+
+  state.counters["file_size"] = _make_byte_counter(file_size);
+  state.counters["peak_heap_growth"] = _make_byte_counter(peak_heap_growth);
+}
+
+void BM_LoadLargeTmjMap(benchmark::State& state)
+{
+  const auto* save_format = get_benchmark_runtime().get_save_format(SaveFormatId::kTiledTmj);
+  if (!save_format) {
+    state.SkipWithError("Save format is not available");
+    return;
+  }
+
+  _run_large_tmj_map_benchmark(state, [&](const auto& map_path, const auto& read_options) {
+    return save_format->load_map(map_path, read_options);
+  });
+}
+
+// Parses the map via a complete JSON document, for comparison.
+void BM_LoadLargeTmjMapFromJsonDocument(benchmark::State& state)
+{
+  const auto& runtime = get_benchmark_runtime();
+
+  _run_large_tmj_map_benchmark(state, [&](const auto& map_path, const auto& read_options) {
+    return tiled_tmj::read_json_document(map_path).and_then(
+        [&](const tiled_tmj::JSON& map_json) {
+          return tiled_tmj::parse_tmj_map(runtime, map_json, read_options);
+        });
+  });
+}
+
+#endif
+
+}  // namespace
+
+#ifdef TACTILE_HAS_TILED_TMJ
+
+BENCHMARK(BM_LoadLargeTmjMap)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK(BM_LoadLargeTmjMapFromJsonDocument)->Unit(benchmark::kMillisecond)->Iterations(3);
+
+#endif
+
+}  // namespace tactile::benchmarks
@@ -57,6 +57,22 @@ class ICommand
   {
     return false;
   }
+
+  /**
+   * Indicates whether the command only modifies the tiles of existing tile layers.
+   *
+   * \details
+   * The autosave service stores the effects of such commands as compact tile row deltas,
+   * whereas any other command requires the entire document to be saved.
+   *
+   * \return
+   * True if the command only modifies tiles; false otherwise.
+   */
+  [[nodiscard]]
+  virtual auto modifies_only_tiles() const -> bool
+  {
+    return false;
+  }
 };
 
 }  // namespace tactile::core
@@ -3,7 +3,7 @@
 #pragma once
 
 #include <concepts>  // derived_from
-#include <cstdint>   // size_t
+#include <cstdint>   // size_t, uint64_t
 #include <deque>     // deque
 #include <memory>    // unique_ptr, make_unique
 #include <optional>  // optional
@@ -70,6 +70,16 @@ class CommandStack final
    */
   void reset_clean_index();
 
+  /**
+   * Marks the command stack as "dirty", regardless of the stored commands.
+   *
+   * \details
+   * This is useful for documents that don't match their files to begin with,
+   * such as documents restored from autosave data. The command stack remains
+   * dirty until the next call to \c mark_as_clean.
+   */
+  void mark_as_dirty();
+
   /**
    * Reverts the most recent command.
    */
@@ -96,7 +106,7 @@ class CommandStack final
   template <std::derived_from<ICommand> T, typename... Args>
   void store(Args&&... args)
   {
-    _store(make_unique<T>(std::forward<Args>(args)...));
+    _store(std::make_unique<T>(std::forward<Args>(args)...));
   }
 
   /**
@@ -122,6 +132,8 @@ class CommandStack final
     T cmd {std::forward<Args>(args)...};
     cmd.redo();
 
+    _increase_revision(cmd);
+
     // If the stack is empty, we simply push the command on the stack. However,
     // if there are commands on the stack, we try to merge the command into the
     // top of the stack. If that succeeds, we discard the temporary command.
@@ -188,11 +200,34 @@ class CommandStack final
   [[nodiscard]]
   auto clean_index() const -> std::optional<std::size_t>;
 
+  /**
+   * Returns a counter that changes whenever a command is executed or reverted.
+   *
+   * \details
+   * Unlike the current index, this value changes even when the stack is full
+   * or when a command is merged into a previous one, so it can be used to
+   * reliably detect document changes.
+   */
+  [[nodiscard]]
+  auto revision() const -> std::uint64_t;
+
+  /**
+   * Returns a counter that changes whenever a command that doesn't only modify
+   * tiles is executed or reverted.
+   *
+   * \see ICommand::modifies_only_tiles
+   */
+  [[nodiscard]]
+  auto structure_revision() const -> std::uint64_t;
+
  private:
   std::deque<std::unique_ptr<ICommand>> m_commands {};
   std::optional<std::size_t> m_current_index {};
   std::optional<std::size_t> m_clean_index {};
   std::size_t m_capacity {};
+  std::uint64_t m_revision {};
+  std::uint64_t m_structure_revision {};
+  bool m_is_dirty {false};
 
   // Pushes a command onto the stack, but does not execute it.
   void _store(std::unique_ptr<ICommand> cmd);
@@ -211,6 +246,9 @@ class CommandStack final
   // Shifts the current index to the right (to a newer command).
   void _increase_current_index();
 
+  // Updates the revision counters after a command has been executed or reverted.
+  void _increase_revision(const ICommand& cmd);
+
   [[nodiscard]]
   auto _get_next_command_index() const -> std::size_t;
 };
@@ -0,0 +1,49 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/cmd/command.hpp"
+#include "tactile/core/entity/entity.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+
+namespace tactile::core {
+
+class MapDocument;
+
+/**
+ * A command for changing tiles in a tile layer, intended for tile editing tools.
+ *
+ * \details
+ * Tools should create a single command for each stroke, so that strokes can be
+ * reverted individually.
+ */
+class SetLayerTilesCommand final : public ICommand
+{
+ public:
+  /**
+   * Creates a command.
+   *
+   * \pre The layer identifier must refer to a tile layer.
+   *
+   * \param document The host document, cannot be null.
+   * \param layer_id The target tile layer identifier.
+   * \param tiles    The new tiles, mapped to their positions.
+   */
+  SetLayerTilesCommand(MapDocument* document, EntityID layer_id, SparseTileMatrix tiles);
+
+  void undo() override;
+
+  void redo() override;
+
+  [[nodiscard]]
+  auto modifies_only_tiles() const -> bool override;
+
+ private:
+  MapDocument* m_document;
+  EntityID m_layer_id;
+  SparseTileMatrix m_new_tiles;
+  SparseTileMatrix m_old_tiles;
+};
+
+}  // namespace tactile::core
@@ -0,0 +1,210 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>     // size_t
+#include <cstdint>     // int64_t, uint32_t, uint64_t
+#include <expected>    // expected
+#include <filesystem>  // path
+#include <ostream>     // ostream
+#include <span>        // span
+#include <vector>      // vector
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/prelude.hpp"
+
+#define TACTILE_PROFILE_SCOPE_NAME_IMPL(Line) tactile_profile_scope_##Line
+#define TACTILE_PROFILE_SCOPE_NAME(Line)      TACTILE_PROFILE_SCOPE_NAME_IMPL(Line)
+
+/**
+ * Records a named profiler zone that covers the rest of the enclosing scope.
+ *
+ * \details
+ * The name must be a string literal, or otherwise outlive the profiler.
+ * Profiler zones are always compiled in, but are effectively no-ops unless the
+ * profiler is enabled.
+ */
+#define TACTILE_PROFILE_SCOPE(Name) \
+  const ::tactile::core::ProfileScope TACTILE_PROFILE_SCOPE_NAME(__LINE__) { (Name) }
+
+namespace tactile::core {
+
+/**
+ * Represents a single recorded profiler zone.
+ */
+struct ProfileZone final
+{
+  /** The zone name, which must outlive the profiler. */
+  const char* name;
+
+  /** The start time of the zone, in nanoseconds since an unspecified epoch. */
+  std::int64_t begin_ns;
+
+  /** The end time of the zone, in nanoseconds since the same epoch. */
+  std::int64_t end_ns;
+
+  /** An index that identifies the thread that recorded the zone. */
+  std::uint32_t thread_index;
+
+  /** The number of zones that enclosed the zone on the recording thread. */
+  std::uint32_t depth;
+};
+
+/**
+ * Represents the zones recorded during a single frame.
+ */
+struct ProfileFrame final
+{
+  /** The frame number, counted from when the profiler was first used. */
+  std::uint64_t index;
+
+  /** The start time of the frame, using the same epoch as the zones. */
+  std::int64_t begin_ns;
+
+  /** The end time of the frame, using the same epoch as the zones. */
+  std::int64_t end_ns;
+
+  /** The index of the thread that ran the frame. */
+  std::uint32_t thread_index;
+
+  /** The zones that were collected at the end of the frame, in completion order. */
+  std::vector<ProfileZone> zones;
+
+  /** The number of zones that didn't fit in the thread-local zone buffers. */
+  std::size_t dropped_zone_count;
+};
+
+/**
+ * Provides aggregated statistics about zones with the same name.
+ */
+struct ProfileZoneStats final
+{
+  /** The associated zone name. */
+  const char* name;
+
+  /** The number of zones with the name. */
+  std::size_t call_count;
+
+  /** The total duration of all zones with the name, in nanoseconds. */
+  std::int64_t total_ns;
+
+  /** The longest duration of a single zone with the name, in nanoseconds. */
+  std::int64_t max_ns;
+};
+
+/**
+ * RAII type that records a profiler zone.
+ *
+ * \details
+ * Zones are stored in lock-free thread-local ring buffers, which are drained
+ * at the end of each frame. Nothing is recorded if the profiler is disabled
+ * when the scope is entered. Prefer the \c TACTILE_PROFILE_SCOPE macro over
+ * using this class directly.
+ */
+class ProfileScope final
+{
+ public:
+  TACTILE_DELETE_COPY(ProfileScope);
+  TACTILE_DELETE_MOVE(ProfileScope);
+
+  /**
+   * Begins a profiler zone.
+   *
+   * \param name The zone name, must outlive the profiler.
+   */
+  [[nodiscard]]
+  explicit ProfileScope(const char* name) noexcept;
+
+  /**
+   * Ends the profiler zone.
+   */
+  ~ProfileScope() noexcept;
+
+ private:
+  const char* m_name;
+  std::int64_t m_begin_ns;
+};
+
+/**
+ * Enables or disables the profiler.
+ *
+ * \param enabled True if zones should be recorded; false otherwise.
+ */
+void set_profiler_enabled(bool enabled) noexcept;
+
+/**
+ * Indicates whether the profiler is enabled.
+ *
+ * \return
+ * True if the profiler is enabled; false otherwise.
+ */
+[[nodiscard]]
+auto is_profiler_enabled() noexcept -> bool;
+
+/**
+ * Marks the beginning of a frame.
+ *
+ * \details
+ * This function should be called once per frame, by the main thread.
+ */
+void begin_profiler_frame();
+
+/**
+ * Marks the end of a frame, collecting all zones recorded since the last frame.
+ *
+ * \details
+ * This function should be called once per frame, by the main thread. The
+ * profiler only keeps a limited number of frames, older frames are discarded.
+ */
+void end_profiler_frame();
+
+/**
+ * Removes all stored profiler frames.
+ */
+void clear_profiler_frames();
+
+/**
+ * Returns a copy of the stored profiler frames.
+ *
+ * \return
+ * The stored frames, ordered from oldest to newest.
+ */
+[[nodiscard]]
+auto get_profiler_frames() -> std::vector<ProfileFrame>;
+
+/**
+ * Computes aggregated statistics for a set of zones.
+ *
+ * \param zones The zones to aggregate.
+ *
+ * \return
+ * The statistics for each distinct zone name, sorted by descending total duration.
+ */
+[[nodiscard]]
+auto aggregate_profile_zones(std::span<const ProfileZone> zones)
+    -> std::vector<ProfileZoneStats>;
+
+/**
+ * Writes profiler frames using the Chrome trace event JSON format.
+ *
+ * \details
+ * The output can be inspected using tools such as Perfetto or about:tracing.
+ * Each zone is emitted as a complete ("X") event, and each frame is emitted
+ * as an additional event that encloses the zones on the thread that ran it.
+ *
+ * \param frames The frames to write.
+ * \param stream The output stream.
+ */
+void write_chrome_trace(std::span<const ProfileFrame> frames, std::ostream& stream);
+
+/**
+ * Writes the stored profiler frames to a Chrome trace event JSON file.
+ *
+ * \param path The output file path.
+ *
+ * \return
+ * Nothing if successful; an error code otherwise.
+ */
+auto save_chrome_trace(const std::filesystem::path& path) -> std::expected<void, ErrorCode>;
+
+}  // namespace tactile::core
@@ -48,13 +48,13 @@ class DocumentManager final
    * This function behaves just like \c create_and_open_map(const MapSpec&).
    *
    * \param renderer The renderer to use for loading textures.
-   * \param ir_map   The intermediate map representation.
+   * \param ir_map   The intermediate map representation, its data is moved into the document.
    *
    * \return
    * The UUID of the map document if successful; an error code otherwise.
    */
   [[nodiscard]]
-  auto create_and_open_map(IRenderer& renderer, const ir::Map& ir_map)
+  auto create_and_open_map(IRenderer& renderer, ir::Map&& ir_map)
       -> std::expected<UUID, ErrorCode>;
 
   /**
@@ -39,13 +39,13 @@ class MapDocument final : public IDocument
    * Creates a map document from an intermediate representation.
    *
    * \param renderer The renderer used to load textures.
-   * \param ir_map   The intermediate map representation.
+   * \param ir_map   The intermediate map representation, its data is moved into the document.
    *
    * \return
    * A map document if successful; an error code otherwise.
    */
   [[nodiscard]]
-  static auto make(IRenderer& renderer, const ir::Map& ir_map)
+  static auto make(IRenderer& renderer, ir::Map&& ir_map)
       -> std::expected<MapDocument, ErrorCode>;
 
   ~MapDocument() noexcept override;
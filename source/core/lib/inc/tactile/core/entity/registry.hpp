@@ -115,6 +115,23 @@ class Registry final
     return std::nullopt;
   }
 
+  /**
+   * Reserves storage for a number of components of a given type.
+   *
+   * \details
+   * This function is useful when creating many entities at once, e.g., when
+   * loading maps, to avoid repeated reallocations of the component storage.
+   *
+   * \tparam T A component type.
+   *
+   * \param count The total number of expected components.
+   */
+  template <typename T>
+  void reserve(const std::size_t count)
+  {
+    mRegistry.storage<T>().reserve(count);
+  }
+
   /**
    * Returns a component attached to registry, aka a "context" component.
    *
@@ -2,22 +2,46 @@
 
 #pragma once
 
+#include <array>    // array
+#include <atomic>   // atomic, memory_order
+#include <cstddef>  // size_t
 #include <utility>  // forward
+#include <vector>   // vector
 
 #include <entt/signal/dispatcher.hpp>
 
 #include "tactile/base/prelude.hpp"
+#include "tactile/core/event/event_queue.hpp"
 
 namespace tactile::core {
 
+/** The maximum number of event types that can be pushed to a dispatcher. */
+inline constexpr std::size_t kMaxEventTypeCount = 256;
+
 /**
  * Provides the event handling API.
+ *
+ * \details
+ * Pushed events are stored in lock-free queues, one per event type, so events
+ * may be pushed from any thread. All other functions, including \c update,
+ * must only be called from the thread that owns the dispatcher.
  */
 class EventDispatcher final
 {
  public:
+  TACTILE_DELETE_COPY(EventDispatcher);
+  TACTILE_DELETE_MOVE(EventDispatcher);
+
+  EventDispatcher() = default;
+
+  ~EventDispatcher() noexcept;
+
   /**
    * Flushes all pending events.
+   *
+   * \details
+   * Events pushed by event handlers during the update are flushed in the next
+   * update, unless the event type hadn't been processed yet.
    */
   void update();
 
@@ -25,7 +49,13 @@ class EventDispatcher final
    * Pushes an event to the event queue.
    *
    * \details
-   * Use the \c update function to issue enqueued events.
+   * Use the \c update function to issue enqueued events. At most
+   * \c kMaxEventTypeCount event types are supported, events of any additional
+   * types are dropped. An error is logged when such event types are first
+   * used, see \c make_event_type_index.
+   *
+   * \note
+   * This function is thread-safe.
    *
    * \tparam Event The event type.
    * \tparam Args  The event argument types.
@@ -35,8 +65,8 @@ class EventDispatcher final
   template <typename Event, typename... Args>
   void push(Args&&... args)
   {
-    if (!mDispatcher.sink<Event>().empty()) {
-      mDispatcher.enqueue<Event>(std::forward<Args>(args)...);
+    if (auto* queue = _get_queue<Event>()) {
+      queue->push(std::forward<Args>(args)...);
     }
   }
 
@@ -71,8 +101,47 @@ class EventDispatcher final
     mDispatcher.sink<Event>().template connect<Slot>(std::forward<Args>(args)...);
   }
 
+  /**
+   * Returns statistics about all event types that have been pushed.
+   *
+   * \return
+   * The event statistics, one entry per event type.
+   */
+  [[nodiscard]]
+  auto get_stats() const -> std::vector<EventStats>;
+
  private:
   entt::dispatcher mDispatcher {};
+  std::array<std::atomic<IEventQueue*>, kMaxEventTypeCount> m_queues {};
+
+  template <typename Event>
+  [[nodiscard]] auto _get_queue() -> EventQueue<Event>*
+  {
+    const auto type_index = get_event_type_index<Event>();
+    if (type_index >= m_queues.size()) [[unlikely]] {
+      return nullptr;
+    }
+
+    auto& queue_slot = m_queues[type_index];
+
+    auto* queue = queue_slot.load(std::memory_order_acquire);
+    if (queue == nullptr) {
+      // Another thread might install a queue at the same time, in which case ours is
+      // discarded.
+      auto* new_queue = new EventQueue<Event> {};
+      if (queue_slot.compare_exchange_strong(queue,
+                                             new_queue,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+        queue = new_queue;
+      }
+      else {
+        delete new_queue;
+      }
+    }
+
+    return static_cast<EventQueue<Event>*>(queue);
+  }
 };
 
 }  // namespace tactile::core
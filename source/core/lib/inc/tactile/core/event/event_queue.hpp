@@ -0,0 +1,270 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <algorithm>    // max
+#include <atomic>       // atomic, memory_order
+#include <chrono>       // steady_clock, duration_cast, nanoseconds
+#include <concepts>     // same_as
+#include <cstddef>      // size_t
+#include <cstdint>      // int64_t, uint64_t
+#include <string_view>  // string_view
+#include <utility>      // forward, move
+
+#include <entt/core/type_info.hpp>
+#include <entt/signal/dispatcher.hpp>
+
+#include "tactile/base/prelude.hpp"
+
+namespace tactile::core {
+
+/**
+ * Provides statistics about the events of a single type.
+ */
+struct EventStats final
+{
+  /** The name of the event type. */
+  std::string_view name;
+
+  /** The number of events that have been pushed. */
+  std::uint64_t pushed_count;
+
+  /** The number of events that have been dispatched to handlers. */
+  std::uint64_t dispatched_count;
+
+  /** The number of events that were merged into preceding events. */
+  std::uint64_t merged_count;
+
+  /** The total time spent in handlers, in nanoseconds. */
+  std::int64_t total_handler_ns;
+
+  /** The longest time spent handling a single event, in nanoseconds. */
+  std::int64_t max_handler_ns;
+};
+
+/**
+ * Satisfied by event types that may be merged with subsequent events.
+ *
+ * \details
+ * High-frequency events, such as viewport offsets, opt into batching by
+ * providing a \c try_merge_events overload that can be found using ADL. The
+ * function should update the first event and return true if the second event
+ * can be discarded.
+ */
+template <typename Event>
+concept MergeableEvent = requires(Event& event, const Event& next_event) {
+  { try_merge_events(event, next_event) } -> std::same_as<bool>;
+};
+
+/**
+ * Interface for type-erased event queues.
+ */
+class IEventQueue
+{
+ public:
+  TACTILE_INTERFACE_CLASS(IEventQueue);
+
+  /**
+   * Dispatches all events pushed before the call to their handlers.
+   *
+   * \details
+   * This function must only be called from the thread that owns the dispatcher.
+   * Events pushed by the handlers are dispatched by the next call.
+   *
+   * \param dispatcher The dispatcher used to trigger the event handlers.
+   */
+  virtual void dispatch(entt::dispatcher& dispatcher) = 0;
+
+  /**
+   * Returns statistics about the events in the queue.
+   *
+   * \return
+   * The event statistics.
+   */
+  [[nodiscard]]
+  virtual auto get_stats() const -> EventStats = 0;
+};
+
+/**
+ * A lock-free multi-producer single-consumer queue for events of a single type.
+ *
+ * \details
+ * Producers push nodes onto an intrusive stack using a CAS loop. The consumer
+ * detaches the whole stack with a single exchange and reverses it, so events
+ * are dispatched in the order they were pushed by each thread.
+ *
+ * \tparam Event The event type.
+ */
+template <typename Event>
+class EventQueue final : public IEventQueue
+{
+ public:
+  TACTILE_DELETE_COPY(EventQueue);
+  TACTILE_DELETE_MOVE(EventQueue);
+
+  EventQueue() = default;
+
+  ~EventQueue() noexcept override
+  {
+    _delete_nodes(m_head.exchange(nullptr, std::memory_order_acquire));
+  }
+
+  /**
+   * Pushes an event to the queue.
+   *
+   * \note
+   * This function is thread-safe.
+   *
+   * \tparam Args The event argument types.
+   *
+   * \param args The arguments used to construct the event.
+   */
+  template <typename... Args>
+  void push(Args&&... args)
+  {
+    auto* node = new Node {Event {std::forward<Args>(args)...}, nullptr};
+
+    node->next = m_head.load(std::memory_order_relaxed);
+    while (!m_head.compare_exchange_weak(node->next,
+                                         node,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+    }
+
+    m_pushed_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void dispatch(entt::dispatcher& dispatcher) override
+  {
+    auto* node = _reverse(m_head.exchange(nullptr, std::memory_order_acquire));
+
+    // Frees the remaining nodes if a handler throws.
+    struct NodeGuard final
+    {
+      Node*& node;
+
+      ~NodeGuard() noexcept
+      {
+        _delete_nodes(node);
+      }
+    } const node_guard {node};
+
+    while (node != nullptr) {
+      if constexpr (MergeableEvent<Event>) {
+        while (node->next != nullptr && try_merge_events(node->event, node->next->event)) {
+          auto* merged_node = node->next;
+          node->next = merged_node->next;
+          delete merged_node;
+          ++m_merged_count;
+        }
+      }
+
+      const auto handler_start = std::chrono::steady_clock::now();
+      dispatcher.trigger(std::move(node->event));
+      const auto handler_end = std::chrono::steady_clock::now();
+
+      const auto handler_ns =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(handler_end - handler_start)
+              .count();
+      m_total_handler_ns += handler_ns;
+      m_max_handler_ns = std::max(m_max_handler_ns, static_cast<std::int64_t>(handler_ns));
+      ++m_dispatched_count;
+
+      auto* next_node = node->next;
+      delete node;
+      node = next_node;
+    }
+  }
+
+  [[nodiscard]]
+  auto get_stats() const -> EventStats override
+  {
+    return EventStats {
+      .name = entt::type_name<Event>::value(),
+      .pushed_count = m_pushed_count.load(std::memory_order_relaxed),
+      .dispatched_count = m_dispatched_count,
+      .merged_count = m_merged_count,
+      .total_handler_ns = m_total_handler_ns,
+      .max_handler_ns = m_max_handler_ns,
+    };
+  }
+
+ private:
+  struct Node final
+  {
+    Event event;
+    Node* next;
+  };
+
+  std::atomic<Node*> m_head {nullptr};
+  std::atomic<std::uint64_t> m_pushed_count {0};
+  std::uint64_t m_dispatched_count {0};
+  std::uint64_t m_merged_count {0};
+  std::int64_t m_total_handler_ns {0};
+  std::int64_t m_max_handler_ns {0};
+
+  [[nodiscard]]
+  static auto _reverse(Node* node) noexcept -> Node*
+  {
+    Node* reversed = nullptr;
+
+    while (node != nullptr) {
+      auto* next_node = node->next;
+      node->next = reversed;
+      reversed = node;
+      node = next_node;
+    }
+
+    return reversed;
+  }
+
+  static void _delete_nodes(Node* node) noexcept
+  {
+    while (node != nullptr) {
+      auto* next_node = node->next;
+      delete node;
+      node = next_node;
+    }
+  }
+};
+
+/**
+ * Returns a new unique event type index.
+ *
+ * \note
+ * This function is thread-safe.
+ *
+ * \return
+ * An event type index.
+ */
+[[nodiscard]]
+auto make_event_type_index() noexcept -> std::size_t;
+
+/**
+ * Returns the number of event type indices that have been created.
+ *
+ * \return
+ * An event type count.
+ */
+[[nodiscard]]
+auto get_event_type_count() noexcept -> std::size_t;
+
+/**
+ * Returns the dense index associated with an event type.
+ *
+ * \note
+ * This function is thread-safe.
+ *
+ * \tparam Event The event type.
+ *
+ * \return
+ * An event type index.
+ */
+template <typename Event>
+[[nodiscard]] auto get_event_type_index() noexcept -> std::size_t
+{
+  static const auto index = make_event_type_index();
+  return index;
+}
+
+}  // namespace tactile::core
@@ -520,6 +520,12 @@ struct RemoveColumnToMapEvent final
 struct FixMapTilesEvent final
 {};
 
+/**
+ * Event for training a tile dictionary on the tile layers in the active map.
+ */
+struct TrainTileDictionaryEvent final
+{};
+
 /**
  * Event for opening the dialog for exporting the active map as a Godot scene.
  */
@@ -568,6 +574,27 @@ struct OffsetViewportEvent final
   Float2 delta;
 };
 
+/**
+ * Merges consecutive offsets of the same viewport into a single event.
+ *
+ * \param[in,out] event      The earlier event.
+ * \param         next_event The later event.
+ *
+ * \return
+ * True if the later event was merged into the earlier one; false otherwise.
+ */
+[[nodiscard]]
+constexpr auto try_merge_events(OffsetViewportEvent& event,
+                                const OffsetViewportEvent& next_event) noexcept -> bool
+{
+  if (event.viewport_entity != next_event.viewport_entity) {
+    return false;
+  }
+
+  event.delta += next_event.delta;
+  return true;
+}
+
 /**
  * Event for changing the size a viewport in the current document.
  */
@@ -23,6 +23,7 @@ struct ShowOpenMapDialogEvent;
 struct ShowGodotExportDialogEvent;
 struct CreateMapEvent;
 struct ExportAsGodotSceneEvent;
+struct TrainTileDictionaryEvent;
 
 /**
  * Handles events related to maps.
@@ -71,6 +72,17 @@ class MapEventHandler final
 
   void on_export_as_godot_scene(const ExportAsGodotSceneEvent& event) const;
 
+  /**
+   * Trains a tile dictionary for the active map.
+   *
+   * \details
+   * The dictionary is stored next to the map, and a map property that opts the
+   * map into using the dictionary is added as an undoable command.
+   *
+   * \param event The associated event.
+   */
+  void on_train_tile_dictionary(const TrainTileDictionaryEvent& event);
+
  private:
   Model* mModel;
   ui::WidgetManager* mWidgetManager;
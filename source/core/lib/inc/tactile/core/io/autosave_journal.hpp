@@ -0,0 +1,107 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>     // size_t
+#include <cstdint>     // int32_t
+#include <expected>    // expected
+#include <filesystem>  // path
+#include <span>        // span
+#include <vector>      // vector
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/id.hpp"
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/base/util/tile_matrix.hpp"
+
+namespace tactile::core {
+
+/**
+ * Represents the new content of a single tile layer row in an autosave journal.
+ */
+struct JournalTileRow final
+{
+  /** The persistent identifier of the associated tile layer. */
+  std::int32_t layer_id;
+
+  /** The index of the row in the tile layer. */
+  std::int32_t row;
+
+  /** The tiles in the row. */
+  TileRow tiles;
+
+  [[nodiscard]]
+  auto operator==(const JournalTileRow&) const -> bool = default;
+};
+
+/**
+ * Encodes tile rows as a single journal record.
+ *
+ * \details
+ * Records are prefixed with their size and a checksum of their content, so
+ * that records that were only partially written before a crash can be detected
+ * and ignored when the journal is read. The record is appended to the provided
+ * byte stream. Journals are machine-local, so native byte order is used.
+ *
+ * \param      rows  The tile rows to encode.
+ * \param[out] bytes The byte stream that the record is appended to.
+ */
+void encode_journal_record(std::span<const JournalTileRow> rows, ByteStream& bytes);
+
+/**
+ * Returns the header written at the start of each journal file.
+ *
+ * \return
+ * A byte stream.
+ */
+[[nodiscard]]
+auto make_journal_header() -> ByteStream;
+
+/**
+ * Decodes the tile rows stored in a journal.
+ *
+ * \details
+ * Decoding stops at the first incomplete or corrupt record, since any such
+ * record must have been the last one written before a crash.
+ *
+ * \param bytes The journal content, including the header.
+ *
+ * \return
+ * The tile rows in journal order if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto decode_journal(ByteSpan bytes) -> std::expected<std::vector<JournalTileRow>, ErrorCode>;
+
+/**
+ * Reads and decodes a journal file.
+ *
+ * \param path The path to the journal file.
+ *
+ * \return
+ * The tile rows in journal order if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto read_journal(const std::filesystem::path& path)
+    -> std::expected<std::vector<JournalTileRow>, ErrorCode>;
+
+/**
+ * Applies journaled tile rows to an intermediate map representation.
+ *
+ * \details
+ * Rows are applied in order, so later rows take precedence. Rows that refer to
+ * unknown layers or out-of-bounds rows indicate that the journal doesn't
+ * belong to the map, which is reported as an error.
+ *
+ * \param      rows   The journaled tile rows.
+ * \param[out] ir_map The map that is updated.
+ *
+ * \return
+ * Nothing if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto apply_journal(std::span<const JournalTileRow> rows, ir::Map& ir_map)
+    -> std::expected<void, ErrorCode>;
+
+}  // namespace tactile::core
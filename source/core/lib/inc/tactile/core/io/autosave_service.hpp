@@ -0,0 +1,217 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <chrono>      // seconds, steady_clock
+#include <cstddef>     // size_t
+#include <cstdint>     // int32_t, uint64_t
+#include <expected>    // expected
+#include <filesystem>  // path
+#include <map>         // map
+#include <optional>    // optional
+#include <vector>      // vector
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/numeric/extent_2d.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/entity/entity.hpp"
+#include "tactile/core/io/background_file_writer.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/util/uuid.hpp"
+
+namespace tactile {
+class IRuntime;
+}  // namespace tactile
+
+namespace tactile::core {
+
+class DocumentManager;
+class MapDocument;
+class CommandStack;
+
+/**
+ * Periodically saves modified map documents to enable crash recovery.
+ *
+ * \details
+ * Each document is represented by a checkpoint, which is a full save of the
+ * map, and a journal of tile row deltas that are to be applied on top of the
+ * checkpoint. Edits that only modify tiles are appended to the journal, which
+ * means that the amount of data written is proportional to the size of the
+ * edit rather than the size of the map. Any other kind of change causes a new
+ * checkpoint, as does a journal that grows too large.
+ *
+ * \details
+ * Journal and manifest writes are performed on a background thread. The
+ * checkpoints are written by the save format plugins on the calling thread,
+ * but these are rare in comparison.
+ *
+ * \see recover_autosaved_maps
+ */
+class AutosaveService final
+{
+ public:
+  TACTILE_DELETE_COPY(AutosaveService);
+  TACTILE_DELETE_MOVE(AutosaveService);
+
+  /**
+   * Creates an autosave service.
+   *
+   * \details
+   * Any files already in the autosave directory are removed once the service
+   * writes its first manifest, so recovery must be performed before any
+   * documents are autosaved.
+   *
+   * \param runtime      The associated runtime, used to access save formats.
+   * \param autosave_dir The directory used to store autosave data.
+   */
+  AutosaveService(IRuntime* runtime, std::filesystem::path autosave_dir);
+
+  /**
+   * Waits for all pending writes to finish.
+   */
+  ~AutosaveService() noexcept;
+
+  /**
+   * Saves all open map documents if the autosave interval has passed.
+   *
+   * \param document_manager The document manager.
+   * \param interval         The time between autosaves, zero disables autosaving.
+   */
+  void update(const DocumentManager& document_manager, std::chrono::seconds interval);
+
+  /**
+   * Immediately saves any changes to open map documents.
+   *
+   * \param document_manager The document manager.
+   */
+  void save(const DocumentManager& document_manager);
+
+  /**
+   * Forces a checkpoint of a document the next time it is saved.
+   *
+   * \details
+   * This is useful for documents that were recovered from autosave data, since
+   * their state isn't reflected by any file on disk.
+   *
+   * \param document_uuid The UUID of the target document.
+   */
+  void request_checkpoint(const UUID& document_uuid);
+
+  /**
+   * Finalizes the autosave data, intended to be called at clean shutdowns.
+   *
+   * \details
+   * Documents with unsaved changes are saved one last time and their autosave
+   * data is kept, so that they can be restored in the next session. All other
+   * autosave data is removed.
+   *
+   * \param document_manager The document manager.
+   */
+  void finish(const DocumentManager& document_manager);
+
+  /**
+   * Removes all autosave data.
+   */
+  void clear();
+
+  /**
+   * Returns the directory used to store autosave data.
+   *
+   * \return
+   * A directory path.
+   */
+  [[nodiscard]]
+  auto get_directory() const -> const std::filesystem::path&;
+
+ private:
+  struct TileLayerSnapshot final
+  {
+    EntityID entity;
+    std::int32_t persistent_id;
+    Extent2D extent;
+    std::uint64_t revision;
+    bool is_dense;
+    std::optional<CowTileMatrix> dense_tiles;
+    std::optional<SparseTileMatrix> sparse_tiles;
+  };
+
+  struct DocumentState final
+  {
+    std::uint64_t revision {};
+    std::uint64_t structure_revision {};
+    std::vector<TileLayerSnapshot> tile_layers {};
+    std::uint64_t generation {};
+    std::size_t journal_size {};
+    bool has_checkpoint {false};
+    bool needs_checkpoint {false};
+    bool reported_missing_layer_ids {false};
+  };
+
+  IRuntime* m_runtime;
+  std::filesystem::path m_autosave_dir;
+  std::map<UUID, DocumentState> m_documents {};
+  std::vector<std::filesystem::path> m_stale_files {};
+  std::chrono::steady_clock::time_point m_next_save_time {};
+
+  // Declared last, so that pending writes finish before the other members are destroyed.
+  BackgroundFileWriter m_writer {};
+
+  [[nodiscard]]
+  auto _save_document(const MapDocument& document, const CommandStack& history) -> bool;
+
+  [[nodiscard]]
+  auto _checkpoint(const MapDocument& document, DocumentState& state) -> bool;
+
+  [[nodiscard]]
+  auto _forget_closed_documents(const DocumentManager& document_manager) -> bool;
+
+  void _retire_files(const UUID& document_uuid, std::uint64_t generation);
+
+  void _write_manifest(const DocumentManager& document_manager);
+
+  [[nodiscard]]
+  auto _get_checkpoint_path(const UUID& document_uuid, std::uint64_t generation) const
+      -> std::filesystem::path;
+
+  [[nodiscard]]
+  auto _get_journal_path(const UUID& document_uuid, std::uint64_t generation) const
+      -> std::filesystem::path;
+
+  void _report_write_failures();
+};
+
+/**
+ * Returns the default directory used to store autosave data.
+ *
+ * \details
+ * The directory is created if it doesn't exist.
+ *
+ * \return
+ * A directory path if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto get_autosave_directory() -> std::expected<std::filesystem::path, ErrorCode>;
+
+/**
+ * Restores the map documents stored in an autosave directory.
+ *
+ * \details
+ * The journal of each map is replayed on top of its checkpoint. Maps that
+ * can't be restored are skipped. Restored documents are marked as modified,
+ * since they don't match their files. The autosave data is left untouched, use
+ * \c AutosaveService::request_checkpoint with the restored documents to
+ * replace it.
+ *
+ * \param runtime          The associated runtime.
+ * \param autosave_dir     The autosave directory.
+ * \param document_manager The document manager that restored maps are added to.
+ *
+ * \return
+ * The UUIDs of the restored map documents.
+ */
+[[nodiscard]]
+auto recover_autosaved_maps(IRuntime& runtime,
+                            const std::filesystem::path& autosave_dir,
+                            DocumentManager& document_manager) -> std::vector<UUID>;
+
+}  // namespace tactile::core
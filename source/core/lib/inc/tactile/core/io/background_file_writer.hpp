@@ -0,0 +1,117 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <atomic>              // atomic
+#include <condition_variable>  // condition_variable, condition_variable_any
+#include <cstddef>             // size_t
+#include <cstdint>             // uint8_t
+#include <deque>               // deque
+#include <filesystem>          // path
+#include <mutex>               // mutex
+#include <stop_token>          // stop_token
+#include <thread>              // jthread
+
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/prelude.hpp"
+
+namespace tactile::core {
+
+/**
+ * Performs file writes on a dedicated background thread.
+ *
+ * \details
+ * Jobs are executed in the order they were submitted, so later jobs can rely
+ * on the effects of earlier jobs, e.g., a file may be removed right after a
+ * file that replaces it has been written. Pending jobs are finished before the
+ * writer is destroyed.
+ *
+ * \note
+ * The logger isn't thread-safe, so failures are only counted on the background
+ * thread. Use \c take_failure_count to report them from the main thread.
+ */
+class BackgroundFileWriter final
+{
+ public:
+  TACTILE_DELETE_COPY(BackgroundFileWriter);
+  TACTILE_DELETE_MOVE(BackgroundFileWriter);
+
+  BackgroundFileWriter();
+
+  ~BackgroundFileWriter() noexcept;
+
+  /**
+   * Replaces the content of a file.
+   *
+   * \details
+   * The content is written to a temporary file that is then renamed, so the
+   * file either has the old or the new content should the application crash.
+   *
+   * \param path  The path to the file.
+   * \param bytes The new file content.
+   */
+  void write(std::filesystem::path path, ByteStream bytes);
+
+  /**
+   * Appends bytes to a file, creating it if it doesn't exist.
+   *
+   * \param path  The path to the file.
+   * \param bytes The bytes to append.
+   */
+  void append(std::filesystem::path path, ByteStream bytes);
+
+  /**
+   * Removes a file, if it exists.
+   *
+   * \param path The path to the file.
+   */
+  void remove(std::filesystem::path path);
+
+  /**
+   * Blocks until all submitted jobs have been executed.
+   */
+  void wait();
+
+  /**
+   * Returns the number of jobs that have failed since the last call.
+   *
+   * \return
+   * A job count.
+   */
+  [[nodiscard]]
+  auto take_failure_count() noexcept -> std::size_t;
+
+ private:
+  enum class JobType : std::uint8_t
+  {
+    kWrite,
+    kAppend,
+    kRemove,
+  };
+
+  struct Job final
+  {
+    JobType type;
+    std::filesystem::path path;
+    ByteStream bytes;
+  };
+
+  std::mutex m_mutex {};
+  std::condition_variable_any m_job_cond {};
+  std::condition_variable m_idle_cond {};
+  std::deque<Job> m_jobs {};
+  bool m_busy {false};
+  std::atomic<std::size_t> m_failure_count {0};
+
+  // Declared last, so that the thread is joined before the other members are destroyed.
+  std::jthread m_thread;
+
+  void _submit(Job job);
+
+  void _run(const std::stop_token& stop_token);
+
+  [[nodiscard]]
+  static auto _execute(const Job& job) -> bool;
+};
+
+}  // namespace tactile::core
@@ -0,0 +1,169 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>      // size_t
+#include <expected>     // expected
+#include <filesystem>   // path
+#include <string_view>  // string_view
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/prelude.hpp"
+
+namespace tactile {
+class ICompressionFormat;
+class IMapView;
+class IMetaView;
+}  // namespace tactile
+
+namespace tactile::ir {
+struct Map;
+struct Metadata;
+}  // namespace tactile::ir
+
+namespace tactile::core {
+
+/**
+ * The name of the map property that opts a map into tile dictionary compression.
+ *
+ * \details
+ * The property is a boolean. Maps that enable it use the dictionary associated
+ * with their file, see \c get_tile_dictionary_path. Other maps never use a
+ * dictionary, even if there is a dictionary file next to them.
+ */
+inline constexpr std::string_view kTileDictionaryProperty = "tile_dictionary";
+
+/** The maximum size of trained tile dictionaries. */
+inline constexpr std::size_t kMaxTileDictionarySize = std::size_t {32} << 10U;
+
+/**
+ * Returns the path of the tile dictionary associated with a map.
+ *
+ * \details
+ * Each map has its own dictionary, named after the map file. For example, the
+ * dictionary of "maps/forest.tmj" is "maps/forest.tmj.dict".
+ *
+ * \param map_path The path of the map file.
+ *
+ * \return
+ * A tile dictionary file path.
+ */
+[[nodiscard]]
+auto get_tile_dictionary_path(const std::filesystem::path& map_path) -> std::filesystem::path;
+
+/**
+ * Indicates whether a map has opted into tile dictionary compression.
+ *
+ * \param map_meta The metadata of the map.
+ *
+ * \return
+ * True if the map uses a tile dictionary; false otherwise.
+ */
+[[nodiscard]]
+auto uses_tile_dictionary(const IMetaView& map_meta) -> bool;
+
+/**
+ * \copydoc uses_tile_dictionary(const IMetaView&)
+ */
+[[nodiscard]]
+auto uses_tile_dictionary(const ir::Metadata& map_meta) -> bool;
+
+/**
+ * Loads a tile dictionary file.
+ *
+ * \param dictionary_path The path of the tile dictionary.
+ *
+ * \return
+ * The tile dictionary if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto load_tile_dictionary(const std::filesystem::path& dictionary_path)
+    -> std::expected<ByteStream, ErrorCode>;
+
+/**
+ * Loads the tile dictionary that should be used to read a map file.
+ *
+ * \details
+ * The properties of a map aren't known until it has been loaded, so this
+ * function looks for the dictionary associated with the map file. Use
+ * \c validate_tile_dictionary once the map is loaded.
+ *
+ * \param map_path The path of the map file.
+ *
+ * \return
+ * The tile dictionary, or an empty byte stream if there is no dictionary.
+ */
+[[nodiscard]]
+auto load_tile_dictionary_for_reading(const std::filesystem::path& map_path) -> ByteStream;
+
+/**
+ * Checks that the tile dictionary referenced by a loaded map is available.
+ *
+ * \param map_path The path of the map file.
+ * \param ir_map   The loaded map.
+ *
+ * \return
+ * Nothing if the map doesn't use a dictionary or if its dictionary is
+ * available; an error code otherwise.
+ */
+[[nodiscard]]
+auto validate_tile_dictionary(const std::filesystem::path& map_path, const ir::Map& ir_map)
+    -> std::expected<void, ErrorCode>;
+
+/**
+ * Loads the tile dictionary that should be used to save a map.
+ *
+ * \param map_path The path of the map file.
+ * \param map      The map that will be saved.
+ *
+ * \return
+ * The tile dictionary, or an empty byte stream if the map doesn't use a
+ * dictionary; an error code if the map uses a dictionary that can't be read.
+ */
+[[nodiscard]]
+auto load_tile_dictionary_for_writing(const std::filesystem::path& map_path,
+                                      const IMapView& map)
+    -> std::expected<ByteStream, ErrorCode>;
+
+/**
+ * Copies the tile dictionary of a map, for use by a copy of the map file.
+ *
+ * \details
+ * This should be used when a map that uses a tile dictionary is saved to a new
+ * file, since dictionaries are tied to map files. Dictionaries of existing maps
+ * at the target path are replaced, just like the maps themselves.
+ *
+ * \param old_map_path The current path of the map file.
+ * \param new_map_path The new path of the map file.
+ *
+ * \return
+ * Nothing if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto copy_tile_dictionary(const std::filesystem::path& old_map_path,
+                          const std::filesystem::path& new_map_path)
+    -> std::expected<void, ErrorCode>;
+
+/**
+ * Trains a tile dictionary on the tile layers in a map and stores it next to the map.
+ *
+ * \details
+ * Existing dictionaries are never replaced, since maps that were compressed
+ * with them would no longer be readable. The map only starts using the
+ * dictionary once the \c kTileDictionaryProperty property is enabled.
+ *
+ * \param compression_format The compression format to train the dictionary for.
+ * \param map                The map whose tile layers are used as training data.
+ * \param map_path           The path of the map file.
+ *
+ * \return
+ * Nothing if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto train_tile_dictionary(const ICompressionFormat& compression_format,
+                           const IMapView& map,
+                           const std::filesystem::path& map_path)
+    -> std::expected<void, ErrorCode>;
+
+}  // namespace tactile::core
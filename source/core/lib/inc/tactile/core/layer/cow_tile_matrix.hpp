@@ -0,0 +1,161 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <memory>   // shared_ptr
+#include <vector>   // vector
+
+#include "tactile/base/id.hpp"
+#include "tactile/base/numeric/extent_2d.hpp"
+#include "tactile/base/numeric/index_2d.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/base/util/tile_matrix.hpp"
+
+namespace tactile::core {
+
+/**
+ * A dense tile matrix that uses copy-on-write semantics for its rows.
+ *
+ * \details
+ * Each row is stored in a reference counted buffer, which is shared between
+ * copies of the matrix until one of the copies modifies it. As a consequence,
+ * copying a matrix only copies one pointer per row, which makes it cheap to
+ * keep duplicated layers around, e.g., in the command history. Rows that have
+ * never been modified additionally share a single buffer of empty tiles.
+ *
+ * \note
+ * This class is not thread-safe, a matrix and its copies must only be modified
+ * by a single thread.
+ */
+class CowTileMatrix final
+{
+ public:
+  TACTILE_DEFAULT_COPY(CowTileMatrix);
+  TACTILE_DEFAULT_MOVE(CowTileMatrix);
+
+  /**
+   * Creates an empty matrix.
+   */
+  CowTileMatrix() = default;
+
+  /**
+   * Creates a matrix of empty tiles.
+   *
+   * \param extent The matrix extent.
+   */
+  explicit CowTileMatrix(const Extent2D& extent);
+
+  /**
+   * Creates a matrix from an existing tile matrix.
+   *
+   * \pre All rows in the tile matrix must have the same length.
+   *
+   * \param matrix The source tile matrix, its rows are moved into the new matrix.
+   */
+  explicit CowTileMatrix(TileMatrix matrix);
+
+  ~CowTileMatrix() noexcept = default;
+
+  /**
+   * Changes the extent of the matrix.
+   *
+   * \details
+   * Existing tiles within the new extent are preserved, and new tiles are empty.
+   * Changing the number of columns detaches all rows from other copies.
+   *
+   * \param extent The new matrix extent.
+   */
+  void resize(const Extent2D& extent);
+
+  /**
+   * Updates the tile at a given position.
+   *
+   * \details
+   * The associated row is detached from other copies before it is modified.
+   *
+   * \pre The index must be within the matrix.
+   *
+   * \param index   The target tile position.
+   * \param tile_id The new tile identifier.
+   */
+  void set(const Index2D& index, TileID tile_id);
+
+  /**
+   * Returns the tile at a given position.
+   *
+   * \pre The index must be within the matrix.
+   *
+   * \param index The target tile position.
+   *
+   * \return
+   * A tile identifier.
+   */
+  [[nodiscard]]
+  auto get(const Index2D& index) const -> TileID;
+
+  /**
+   * Returns a mutable row, detaching it from other copies if necessary.
+   *
+   * \pre The row index must be within the matrix.
+   *
+   * \param row The row index.
+   *
+   * \return
+   * A row that is exclusively owned by this matrix.
+   */
+  [[nodiscard]]
+  auto mutable_row(std::size_t row) -> TileRow&;
+
+  /**
+   * Returns a read-only row.
+   *
+   * \pre The row index must be within the matrix.
+   *
+   * \param row The row index.
+   *
+   * \return
+   * A row that might be shared with other matrices.
+   */
+  [[nodiscard]]
+  auto operator[](std::size_t row) const -> const TileRow&;
+
+  /**
+   * Creates a plain tile matrix with the same tiles.
+   *
+   * \return
+   * A tile matrix.
+   */
+  [[nodiscard]]
+  auto to_tile_matrix() const -> TileMatrix;
+
+  /**
+   * Indicates whether a row is shared with another matrix.
+   *
+   * \note
+   * This function is mainly intended for testing purposes.
+   *
+   * \param other The other matrix.
+   * \param row   The row index, must be valid in both matrices.
+   *
+   * \return
+   * True if the matrices use the same storage for the row; false otherwise.
+   */
+  [[nodiscard]]
+  auto shares_row(const CowTileMatrix& other, std::size_t row) const -> bool;
+
+  /**
+   * Returns the extent of the matrix.
+   *
+   * \return
+   * The matrix extent.
+   */
+  [[nodiscard]]
+  auto get_extent() const noexcept -> Extent2D;
+
+ private:
+  std::vector<std::shared_ptr<TileRow>> m_rows {};
+  Extent2D::value_type m_col_count {0};
+};
+
+}  // namespace tactile::core
@@ -23,6 +23,23 @@ class Registry;
 [[nodiscard]]
 auto make_layer(Registry& registry, const ir::Layer& ir_layer) -> EntityID;
 
+/**
+ * Creates a layer from an intermediate representation, moving its data.
+ *
+ * \details
+ * This is the preferred way to create layers when loading maps, since tile
+ * data, objects, and nested layers are moved into the registry instead of being
+ * copied one element at a time.
+ *
+ * \param registry The associated registry.
+ * \param ir_layer The intermediate layer representation.
+ *
+ * \return
+ * A layer entity.
+ */
+[[nodiscard]]
+auto make_layer(Registry& registry, ir::Layer&& ir_layer) -> EntityID;
+
 /**
  * Destroys a layer entity.
  *
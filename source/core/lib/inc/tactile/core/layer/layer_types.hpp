@@ -2,7 +2,7 @@
 
 #pragma once
 
-#include <cstdint>     // int32_t
+#include <cstdint>     // int32_t, uint64_t
 #include <functional>  // less
 #include <map>         // map
 #include <optional>    // optional
@@ -13,7 +13,7 @@
 #include "tactile/base/layer/object_type.hpp"
 #include "tactile/base/numeric/extent_2d.hpp"
 #include "tactile/base/numeric/vec.hpp"
-#include "tactile/base/util/tile_matrix.hpp"
+#include "tactile/core/layer/cow_tile_matrix.hpp"
 
 namespace tactile::core {
 
@@ -48,16 +48,24 @@ using SparseTileMatrix = std::map<Index2D, TileID, std::less<>>;
  */
 struct CTileLayer final
 {
+  /** The extent of the layer. */
   Extent2D extent;
+
+  /** Incremented whenever the layer tiles are modified, used to detect stale caches. */
+  std::uint64_t revision {0};
 };
 
 /**
  * Component for densely populated tile layers.
+ *
+ * \details
+ * The tile data uses copy-on-write storage, so copies of this component share
+ * their rows until modified.
  */
 struct CDenseTileLayer final
 {
   /** The associated tile data. */
-  TileMatrix tiles;
+  CowTileMatrix tiles;
 };
 
 /**
@@ -57,6 +57,18 @@ auto make_object(Registry& registry, ObjectID id, ObjectType type) -> EntityID;
 [[nodiscard]]
 auto make_object(Registry& registry, const ir::Object& ir_object) -> EntityID;
 
+/**
+ * Creates an object from an intermediate representation, moving its data.
+ *
+ * \param registry  The associated registry.
+ * \param ir_object The intermediate object representation.
+ *
+ * \return
+ * An object entity.
+ */
+[[nodiscard]]
+auto make_object(Registry& registry, ir::Object&& ir_object) -> EntityID;
+
 /**
  * Destroys an object entity.
  *
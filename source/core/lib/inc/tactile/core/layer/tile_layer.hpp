@@ -9,6 +9,7 @@
 #include "tactile/base/io/byte_stream.hpp"
 #include "tactile/base/numeric/extent_2d.hpp"
 #include "tactile/base/numeric/index_2d.hpp"
+#include "tactile/base/util/tile_matrix.hpp"
 #include "tactile/core/debug/assert.hpp"
 #include "tactile/core/entity/entity.hpp"
 #include "tactile/core/entity/registry.hpp"
@@ -47,6 +48,27 @@ auto is_tile_layer(const Registry& registry, EntityID entity) -> bool;
 [[nodiscard]]
 auto make_tile_layer(Registry& registry, const Extent2D& extent) -> EntityID;
 
+/**
+ * Creates a tile layer from existing tile data.
+ *
+ * \details
+ * The tile representation is selected based on the number of non-empty tiles,
+ * which is determined in a single pass over the tiles. Mostly empty layers use
+ * a sparse representation, other layers take ownership of the provided rows
+ * without copying them. Missing tiles are treated as empty, and tiles outside
+ * of the extent are discarded.
+ *
+ * \param registry The associated registry.
+ * \param extent   The layer extent.
+ * \param tiles    The tile data, in row-major order.
+ *
+ * \return
+ * A tile layer entity.
+ */
+[[nodiscard]]
+auto make_tile_layer(Registry& registry, const Extent2D& extent, TileMatrix tiles)
+    -> EntityID;
+
 /**
  * Destroys a tile layer.
  *
@@ -176,9 +198,10 @@ constexpr void each_layer_tile(const Registry& registry,
 
   if (const auto* dense = registry.find<CDenseTileLayer>(layer_entity)) {
     for (auto row = begin.y; row < end.y; ++row) {
+      const auto& tile_row = dense->tiles[row];
       for (auto col = begin.x; col < end.x; ++col) {
         const Index2D index {.x = col, .y = row};
-        callable(index, dense->tiles[row][col]);
+        callable(index, tile_row[col]);
       }
     }
   }
@@ -73,7 +73,7 @@ struct CTileFormat final
  */
 struct CMapIdCache final
 {
-  /** The next available global tile ID. */
+  /** The global tile ID after the last reserved tile range, see \c TileRangeIndex. */
   TileID next_tile_id;
 
   /** The next available object identifier. */
@@ -134,6 +134,8 @@ auto make_map(Registry& registry, const MapSpec& spec) -> EntityID;
 /**
  * Creates a map based on an intermediate representation.
  *
+ * \pre The registry must feature a \c CTileCache context component.
+ *
  * \param registry The associated registry.
  * \param renderer The renderer used to load textures.
  * \param ir_map   The intermediate map representation.
@@ -145,6 +147,27 @@ auto make_map(Registry& registry, const MapSpec& spec) -> EntityID;
 auto make_map(Registry& registry, IRenderer& renderer, const ir::Map& ir_map)
     -> std::expected<EntityID, ErrorCode>;
 
+/**
+ * Creates a map based on an intermediate representation, moving its data.
+ *
+ * \details
+ * This is the preferred way to load maps. Component storage is reserved up
+ * front based on the number of layers, objects, and tiles in the map, and
+ * layer data is moved into the registry instead of being copied.
+ *
+ * \pre The registry must feature a \c CTileCache context component.
+ *
+ * \param registry The associated registry.
+ * \param renderer The renderer used to load textures.
+ * \param ir_map   The intermediate map representation.
+ *
+ * \return
+ * A map entity identifier if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto make_map(Registry& registry, IRenderer& renderer, ir::Map&& ir_map)
+    -> std::expected<EntityID, ErrorCode>;
+
 /**
  * Destroys a map.
  *
@@ -161,9 +184,11 @@ void destroy_map(Registry& registry, EntityID map_entity);
  * \details
  * This function will create a tileset instance and update the map's identifier
  * state cache. The newly created tileset will also automatically be made the
- * active tileset in the map.
+ * active tileset in the map. The tile identifiers of the tileset are taken
+ * from the smallest gap between reserved tile ranges that fits all tiles.
  *
  * \pre The specified entity must be a map.
+ * \pre The registry must feature a \c CTileCache context component.
  *
  * \param registry     The associated registry.
  * \param map_id       The map that will host the tileset.
@@ -199,7 +224,8 @@ void remove_tileset_from_map(Registry& registry, EntityID map_id, EntityID tiles
  * \pre The map identifier must be valid.
  *
  * \details
- * This function automatically makes the new layer the active layer in the map.
+ * This function automatically makes the new layer the active layer in the map. The
+ * layer is assigned the next available persistent layer identifier.
  *
  * \param registry The associated registry.
  * \param map_id   The target map identifier.
@@ -65,4 +65,19 @@ void convert_ir_metadata(Registry& registry,
                          EntityID meta_id,
                          const ir::Metadata& ir_metadata);
 
+/**
+ * Moves IR metadata into the internal representation of a context.
+ *
+ * \details
+ * This overload avoids copying names and attribute values, which is useful when
+ * loading large maps.
+ *
+ * \pre The entity identifier must reference a meta context.
+ *
+ * \param registry    The associated registry.
+ * \param meta_id     The meta context entity identifier.
+ * \param ir_metadata The source metadata representation, left in a valid but unspecified state.
+ */
+void convert_ir_metadata(Registry& registry, EntityID meta_id, ir::Metadata&& ir_metadata);
+
 }  // namespace tactile::core
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <chrono>   // seconds
 #include <cstddef>  // size_t
 #include <cstdint>  // uint8_t
 
@@ -25,6 +26,9 @@ struct Settings final
   /** The maximum number of changes to track in a document. */
   std::size_t command_capacity;
 
+  /** The time between autosaves of modified documents, zero disables autosaving. */
+  std::chrono::seconds autosave_interval;
+
   /** The font used in the UI. */
   ui::FontID font;
 
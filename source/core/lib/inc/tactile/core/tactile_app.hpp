@@ -20,6 +20,7 @@
 #include "tactile/core/event/tileset_event_handler.hpp"
 #include "tactile/core/event/view_event_handler.hpp"
 #include "tactile/core/event/viewport_event_handler.hpp"
+#include "tactile/core/io/autosave_service.hpp"
 #include "tactile/core/model/model.hpp"
 #include "tactile/core/model/settings.hpp"
 #include "tactile/core/ui/i18n/language.hpp"
@@ -99,6 +100,11 @@ class TactileApp final : public IEngineApp
 
   /** Delegate for viewport events. */
   std::optional<ViewportEventHandler> m_viewport_event_handler;
+
+  /** Periodically saves modified documents, absent if there's no autosave directory. */
+  std::optional<AutosaveService> m_autosave_service;
+
+  void _init_autosave();
 };
 
 }  // namespace tactile::core
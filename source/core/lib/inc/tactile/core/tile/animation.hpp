@@ -16,6 +16,10 @@ class Registry;
 /**
  * Updates the state of all animations in a registry.
  *
+ * \details
+ * The animation revision of the \c CTileCache context component, if present,
+ * is incremented if any animated tile changes its appearance.
+ *
  * \param registry The associated registry.
  */
 void update_animations(Registry& registry);
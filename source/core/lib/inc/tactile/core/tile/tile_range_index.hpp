@@ -0,0 +1,175 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <cstdint>  // int32_t
+#include <span>     // span
+#include <vector>   // vector
+
+#include "tactile/base/id.hpp"
+
+namespace tactile::core {
+
+/**
+ * Represents an sequence of tile identifiers.
+ */
+struct TileRange final
+{
+  /** The first associated tile identifier. */
+  TileID first_id;
+
+  /** The number of tile identifiers (starting at \c first_id). */
+  std::int32_t count;
+
+  constexpr auto operator==(const TileRange&) const noexcept -> bool = default;
+};
+
+/**
+ * Describes how a tile range is renumbered by \c TileRangeIndex::compact.
+ */
+struct TileRangeMove final
+{
+  /** The original tile range. */
+  TileRange old_range;
+
+  /** The new first tile identifier of the range. */
+  TileID new_first_id;
+};
+
+/**
+ * Keeps track of reserved global tile identifier ranges.
+ *
+ * \details
+ * The reserved ranges are stored in a flat vector, sorted by their first tile
+ * identifiers. Since reserved ranges never overlap, it's enough to inspect the
+ * closest neighbors of a range to determine whether it's available, which can
+ * be done with a binary search. Reserving ranges in ascending order, which is
+ * the common case when loading maps, only ever appends to the vector.
+ *
+ * The index also serves as an allocator of global tile identifiers, reusing
+ * gaps left behind by released ranges instead of always growing the range of
+ * used identifiers.
+ */
+class TileRangeIndex final
+{
+ public:
+  /**
+   * Reserves memory for a number of tile ranges.
+   *
+   * \param range_count The expected number of tile ranges.
+   */
+  void reserve(std::size_t range_count);
+
+  /**
+   * Reserves a tile range.
+   *
+   * \param range The tile range to reserve.
+   *
+   * \return
+   * True if the range was reserved; false if it's invalid or unavailable.
+   *
+   * \complexity O(log n) to find the range, O(n) to insert it.
+   */
+  [[nodiscard]]
+  auto insert(const TileRange& range) -> bool;
+
+  /**
+   * Releases a previously reserved tile range.
+   *
+   * \param range The tile range to release, must match a reserved range exactly.
+   *
+   * \return
+   * True if the range was released; false otherwise.
+   *
+   * \complexity O(log n) to find the range, O(n) to erase it.
+   */
+  auto erase(const TileRange& range) -> bool;
+
+  /**
+   * Removes all reserved tile ranges.
+   */
+  void clear() noexcept;
+
+  /**
+   * Indicates whether an entire tile range is available for use.
+   *
+   * \param range The tile range to check.
+   *
+   * \return
+   * True if the range is valid and doesn't overlap any reserved range; false otherwise.
+   *
+   * \complexity O(log n)
+   */
+  [[nodiscard]]
+  auto is_available(const TileRange& range) const -> bool;
+
+  /**
+   * Returns the first tile identifier of the best available range of a given size.
+   *
+   * \details
+   * The smallest gap between reserved ranges that fits the requested number of
+   * tiles is used, to keep large gaps available for large tilesets. If there is
+   * no such gap, the range is placed after the last reserved range.
+   *
+   * \note
+   * This function doesn't reserve the returned range.
+   *
+   * \param count The number of tile identifiers in the requested range.
+   *
+   * \return
+   * A tile identifier.
+   *
+   * \complexity O(n)
+   */
+  [[nodiscard]]
+  auto find_best_fit(std::int32_t count) const -> TileID;
+
+  /**
+   * Renumbers all reserved ranges so that there are no gaps between them.
+   *
+   * \details
+   * The relative order of the ranges is preserved, and the first range will
+   * start at the first valid tile identifier. It's up to the caller to update
+   * any tile identifiers that refer to the moved ranges.
+   *
+   * \return
+   * The ranges that were moved, in ascending order.
+   *
+   * \complexity O(n)
+   */
+  [[nodiscard]]
+  auto compact() -> std::vector<TileRangeMove>;
+
+  /**
+   * Returns the tile identifier after the last reserved range.
+   *
+   * \return
+   * A tile identifier.
+   */
+  [[nodiscard]]
+  auto get_end_id() const -> TileID;
+
+  /**
+   * Returns all reserved ranges, sorted by their first tile identifiers.
+   *
+   * \return
+   * A view of the reserved ranges.
+   */
+  [[nodiscard]]
+  auto get_ranges() const noexcept -> std::span<const TileRange>;
+
+  /**
+   * Returns the number of reserved ranges.
+   *
+   * \return
+   * A range count.
+   */
+  [[nodiscard]]
+  auto size() const noexcept -> std::size_t;
+
+ private:
+  std::vector<TileRange> m_ranges {};
+};
+
+}  // namespace tactile::core
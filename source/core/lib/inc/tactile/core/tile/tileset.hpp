@@ -103,7 +103,8 @@ auto make_tileset(Registry& registry,
  *
  * \details
  * All tiles associated with the tileset will be registered in the \c CTileCache
- * context component of the provided registry.
+ * context component of the provided registry, and the tile range is reserved
+ * in its tile range index.
  *
  * \note
  * The designated tile range must be unique to the tileset.
@@ -144,7 +145,7 @@ auto make_tileset_instance(Registry& registry, const TilesetSpec& spec, TileID f
  * \details
  * If the specified tileset features a \c CTilesetInstance component, then all
  * associated tiles will be unregistered from the \c CTileCache context
- * component in the provided registry.
+ * component in the provided registry, and the tile range is released.
  *
  * \param registry       The associated registry.
  * \param tileset_entity The tileset to destroy.
@@ -226,6 +227,10 @@ auto get_tile_index(const Registry& registry, TileID tile_id) -> std::optional<T
 /**
  * Indicates whether the tiles in a tile range are available for use.
  *
+ * \pre The registry must feature a \c CTileCache context component.
+ *
+ * \complexity O(log n), where n is the number of tileset instances.
+ *
  * \param registry The associated registry.
  * \param range    The tile range to check.
  *
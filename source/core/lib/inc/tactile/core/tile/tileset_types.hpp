@@ -2,7 +2,7 @@
 
 #pragma once
 
-#include <cstdint>        // int32_t
+#include <cstdint>        // uint64_t
 #include <unordered_map>  // unordered_map
 #include <vector>  // vector
 
@@ -11,21 +11,10 @@
 #include "tactile/base/numeric/extent_2d.hpp"
 #include "tactile/core/entity/entity.hpp"
 #include "tactile/core/io/texture.hpp"
+#include "tactile/core/tile/tile_range_index.hpp"
 
 namespace tactile::core {
 
-/**
- * Represents an sequence of tile identifiers.
- */
-struct TileRange final
-{
-  /** The first associated tile identifier. */
-  TileID first_id;
-
-  /** The number of tile identifiers (starting at \c first_id). */
-  std::int32_t count;
-};
-
 /**
  * Represents the information needed to construct a tileset.
  */
@@ -45,6 +34,15 @@ struct CTileCache final
 {
   /** Maps tile identifiers to the associated tilesets. */
   std::unordered_map<TileID, EntityID> tileset_mapping;
+
+  /** The tile ranges reserved by tileset instances. */
+  TileRangeIndex tile_ranges;
+
+  /** Incremented whenever the tileset mapping changes, used to detect stale caches. */
+  std::uint64_t revision {0};
+
+  /** Incremented whenever the appearance of an animated tile changes. */
+  std::uint64_t animation_revision {0};
 };
 
 /**
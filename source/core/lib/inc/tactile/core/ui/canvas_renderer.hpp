@@ -96,10 +96,38 @@ class CanvasRenderer final
   /**
    * Renders an orthogonal grid over the canvas.
    *
+   * \details
+   * The grid is submitted as a single batch of lines, and is gradually faded
+   * out when the lines get too dense, see \c get_grid_opacity.
+   *
    * \param color The line color.
    */
   void draw_orthogonal_grid(const UColor& color) const;
 
+  /**
+   * Renders an orthogonal grid over the content tiles within the render bounds.
+   *
+   * \details
+   * Unlike \c draw_orthogonal_grid, this function only emits lines for tiles
+   * that are both visible and part of the content.
+   *
+   * \param color The line color.
+   */
+  void draw_content_grid(const UColor& color) const;
+
+  /**
+   * Renders the visible part of a texture that covers the content tiles.
+   *
+   * \details
+   * The texture is assumed to be laid out as a grid of tiles that matches the
+   * content extent. Only the texture region that corresponds to the current
+   * render bounds is submitted, so the cost is independent of the texture size.
+   *
+   * \param texture_handle The raw handle of the texture.
+   * \param uv_tile_size   The size of a tile in texture coordinates.
+   */
+  void draw_visible_texture(void* texture_handle, const Float2& uv_tile_size) const;
+
   /**
    * Renders an outline around the tile at the specified position.
    *
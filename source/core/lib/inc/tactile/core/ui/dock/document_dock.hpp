@@ -2,7 +2,12 @@
 
 #pragma once
 
+#include <unordered_map>  // unordered_map
+
 #include "tactile/base/prelude.hpp"
+#include "tactile/base/render/renderer.hpp"
+#include "tactile/core/ui/render/layer_render_cache.hpp"
+#include "tactile/core/util/uuid.hpp"
 
 namespace tactile::core {
 
@@ -21,9 +26,13 @@ class DocumentDock final
    * Pushes the document dock to the widget stack.
    *
    * \param model      The associated model.
+   * \param renderer   The renderer used to cache document renders.
    * \param dispatcher The event dispatcher to use.
    */
-  void push(const Model& model, EventDispatcher& dispatcher);
+  void push(const Model& model, IRenderer& renderer, EventDispatcher& dispatcher);
+
+ private:
+  std::unordered_map<UUID, LayerRenderCache> m_layer_caches {};
 };
 
 }  // namespace ui
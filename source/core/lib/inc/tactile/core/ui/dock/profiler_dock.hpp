@@ -0,0 +1,63 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <vector>   // vector
+
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/debug/profiler.hpp"
+
+namespace tactile::core {
+
+class EventDispatcher;
+
+namespace ui {
+
+class Language;
+
+/**
+ * Represents the dock widget that visualizes recorded profiler frames.
+ *
+ * \details
+ * The dock shows a graph of recent frame times, a timeline of the zones in the
+ * selected frame with nested zones stacked below their parents, and aggregated
+ * zone statistics. Captured frames can also be exported as a Chrome trace. The
+ * dock also shows statistics about the memory used by Dear ImGui, and about
+ * the events handled by the event dispatcher.
+ */
+class ProfilerDock final
+{
+ public:
+  /**
+   * Pushes the profiler dock to the widget stack.
+   *
+   * \param      language   The current language.
+   * \param      dispatcher The event dispatcher to show statistics for.
+   * \param[out] is_open    Set to false if the dock was closed.
+   */
+  void push(const Language& language, const EventDispatcher& dispatcher, bool* is_open);
+
+ private:
+  std::vector<ProfileFrame> m_frames {};
+  std::vector<float> m_frame_times_ms {};
+  int m_selected_frame {0};
+  bool m_paused {false};
+
+  void _update_frames();
+
+  void _push_controls();
+
+  void _push_imgui_memory_stats();
+
+  static void _push_event_stats(const EventDispatcher& dispatcher);
+
+  void _push_frame_graph();
+
+  void _push_timeline(const ProfileFrame& frame);
+
+  void _push_zone_table(const ProfileFrame& frame);
+};
+
+}  // namespace ui
+}  // namespace tactile::core
@@ -67,6 +67,7 @@ enum class NounLabel : std::size_t
   kAnimationDock,
   kLogDock,
   kStyleEditorWidget,
+  kProfilerDock,
   kGodotExportDialog,
 
   // Menu names.
@@ -156,6 +157,7 @@ enum class ActionLabel : std::size_t
   kRemoveColumn,
   kResize,
   kFixInvalidTiles,
+  kTrainTileDictionary,
   kCreateProperty,
   kRemoveProperty,
   kRenameProperty,
@@ -167,6 +169,7 @@ enum class ActionLabel : std::size_t
   kOpenCredits,
   kOpenDebugger,
   kOpenStyleEditor,
+  kOpenProfiler,
   kOpenDemoWindow,
   kOpenStorageDir,
   kTileLayerItem,
@@ -0,0 +1,81 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>  // size_t
+
+#include "tactile/base/prelude.hpp"
+
+namespace tactile::core::ui {
+
+/**
+ * Provides statistics about the memory used by Dear ImGui.
+ */
+struct ImGuiAllocatorStats final
+{
+  /** The number of allocations made during the previous frame. */
+  std::size_t frame_allocation_count;
+
+  /** The number of bytes requested during the previous frame. */
+  std::size_t frame_allocated_bytes;
+
+  /** The number of allocations that have yet to be freed. */
+  std::size_t live_allocation_count;
+
+  /** The number of requested bytes that have yet to be freed. */
+  std::size_t live_bytes;
+
+  /** The highest observed number of live bytes. */
+  std::size_t peak_live_bytes;
+
+  /** The number of bytes reserved for pooled allocations. */
+  std::size_t reserved_bytes;
+
+  /** The total number of allocations that were too large to be pooled. */
+  std::size_t large_allocation_count;
+};
+
+/**
+ * Allocates memory for Dear ImGui.
+ *
+ * \details
+ * Small allocations are served from per-size-class free lists backed by large
+ * slabs, which avoids going through the general-purpose heap for the many short
+ * lived allocations made by Dear ImGui each frame. Larger allocations fall back
+ * to \c std::malloc. All returned memory is suitably aligned for any scalar type.
+ *
+ * \param size      The number of bytes to allocate.
+ * \param user_data Ignored.
+ *
+ * \return
+ * A pointer to the allocated memory; a null pointer on failure.
+ */
+[[nodiscard]]
+auto imgui_malloc(std::size_t size, void* user_data) -> void*;
+
+/**
+ * Frees memory allocated by \c imgui_malloc.
+ *
+ * \param memory    The memory to free, may be null.
+ * \param user_data Ignored.
+ */
+void imgui_free(void* memory, void* user_data);
+
+/**
+ * Marks the beginning of a frame, for the purpose of per-frame statistics.
+ *
+ * \details
+ * This function should be called once per frame, by the main thread.
+ */
+void begin_imgui_allocator_frame();
+
+/**
+ * Returns statistics about the memory allocated by \c imgui_malloc.
+ *
+ * \return
+ * The current allocator statistics.
+ */
+[[nodiscard]]
+auto get_imgui_allocator_stats() -> ImGuiAllocatorStats;
+
+}  // namespace tactile::core::ui
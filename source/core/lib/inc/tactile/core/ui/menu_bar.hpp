@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "tactile/core/ui/dock/profiler_dock.hpp"
+
 namespace tactile::core {
 
 class Model;
@@ -27,8 +29,10 @@ class MenuBar final
   bool m_show_debugger {};
   bool m_show_demo {};
   bool m_show_style_editor {};
+  bool m_show_profiler {};
+  ProfilerDock m_profiler_dock {};
 
-  void _push_debug_menu(const Model& model);
+  void _push_debug_menu(const Model& model, const EventDispatcher& dispatcher);
 };
 
 }  // namespace ui
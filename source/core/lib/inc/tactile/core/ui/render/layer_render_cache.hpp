@@ -0,0 +1,135 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>   // size_t
+#include <cstdint>   // uint64_t
+#include <optional>  // optional
+#include <span>      // span
+#include <vector>    // vector
+
+#include "tactile/base/id.hpp"
+#include "tactile/base/numeric/index_2d.hpp"
+#include "tactile/base/numeric/vec.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/base/render/renderer.hpp"
+#include "tactile/base/render/texture.hpp"
+#include "tactile/core/entity/entity.hpp"
+
+namespace tactile::core {
+
+class Registry;
+
+namespace ui {
+
+class CanvasRenderer;
+
+/**
+ * Describes the state of a tile layer in a cached layer group.
+ */
+struct CachedLayer final
+{
+  /** The tile layer entity. */
+  EntityID id;
+
+  /** The revision of the tile layer, see \c CTileLayer. */
+  std::uint64_t revision;
+
+  [[nodiscard]]
+  auto operator==(const CachedLayer&) const -> bool = default;
+};
+
+/**
+ * Caches renders of groups of tile layers in offscreen render targets.
+ *
+ * \details
+ * Rendering a map with many stacked layers involves emitting every visible
+ * tile of every layer, every frame. This class instead renders consecutive
+ * layers that aren't being edited to a render target once, which is then drawn
+ * as a single image. A group is only rendered again when one of its layers is
+ * modified, the zoom changes, or the viewport is moved outside of the region
+ * covered by the render target. The covered region includes a margin around the
+ * visible tiles, so that small viewport movements don't require new renders.
+ * Groups are also rendered again when an animated tile changes its appearance.
+ *
+ * The layers in a group share the same effective opacity. Groups are rendered
+ * at full opacity, which yields premultiplied colors, and are then drawn using
+ * premultiplied alpha blending with the group opacity applied. This way,
+ * translucent tiles are only blended once, just like when rendered directly.
+ */
+class LayerRenderCache final
+{
+ public:
+  TACTILE_DELETE_COPY(LayerRenderCache);
+  TACTILE_DELETE_MOVE(LayerRenderCache);
+
+  /**
+   * Creates an empty layer cache.
+   *
+   * \param renderer The renderer used to manage render targets.
+   */
+  explicit LayerRenderCache(IRenderer* renderer);
+
+  ~LayerRenderCache() noexcept;
+
+  /**
+   * Draws a group of tile layers to the current window.
+   *
+   * \details
+   * The group render is updated first if it's stale.
+   *
+   * \param group_index     The index of the group in the current frame.
+   * \param layers          The layers in the group, in rendering order.
+   * \param opacity         The effective opacity of the layers in the group.
+   * \param canvas_renderer The canvas renderer to use.
+   * \param registry        The registry that contains the layers.
+   *
+   * \return
+   * True if the group was drawn; false if it must be rendered directly.
+   */
+  [[nodiscard]]
+  auto draw_group(std::size_t group_index,
+                  std::span<const CachedLayer> layers,
+                  float opacity,
+                  const CanvasRenderer& canvas_renderer,
+                  const Registry& registry) -> bool;
+
+  /**
+   * Releases the render targets of groups that weren't drawn since the last call.
+   */
+  void release_unused_groups();
+
+  /**
+   * Releases all render targets.
+   */
+  void clear();
+
+ private:
+  struct LayerGroup final
+  {
+    std::optional<TextureID> texture_id;
+    TextureSize texture_size;
+    Index2D begin;
+    Index2D end;
+    Float2 tile_size;
+    std::uint64_t tile_cache_revision;
+    std::uint64_t animation_revision;
+    std::vector<CachedLayer> layers;
+    bool is_used;
+  };
+
+  IRenderer* m_renderer;
+  std::vector<LayerGroup> m_groups;
+  bool m_is_supported;
+
+  [[nodiscard]]
+  auto _update_group(LayerGroup& group,
+                     std::span<const CachedLayer> layers,
+                     const CanvasRenderer& canvas_renderer,
+                     const Registry& registry) -> bool;
+
+  void _release_group(LayerGroup& group);
+};
+
+}  // namespace ui
+}  // namespace tactile::core
@@ -0,0 +1,135 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t
+
+#include "tactile/base/numeric/vec.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/ui/render/hexagon_info.hpp"
+
+struct ImDrawList;
+
+namespace tactile::core::ui {
+
+/**
+ * Emits line segments directly into reserved draw list primitives.
+ *
+ * \details
+ * Submitting lines one at a time with \c ImDrawList::AddLine involves path
+ * construction, clipping, and a separate vertex reservation for each line. This
+ * class instead reserves the vertices and indices for many lines at once and
+ * writes each line as a single quad. Reservations are made in chunks that fit
+ * within 16-bit draw list indices, so there's no upper limit on the number of
+ * lines in a batch.
+ *
+ * \note
+ * Unused reserved primitives are released when the batch is destroyed.
+ */
+class LineBatch final
+{
+ public:
+  TACTILE_DELETE_COPY(LineBatch);
+  TACTILE_DELETE_MOVE(LineBatch);
+
+  /**
+   * Creates a line batch.
+   *
+   * \param draw_list  The target draw list.
+   * \param line_count The expected number of lines, used to size reservations.
+   * \param color      The line color, encoded as ABGR.
+   * \param thickness  The line thickness, in pixels.
+   */
+  LineBatch(ImDrawList& draw_list,
+            std::size_t line_count,
+            std::uint32_t color,
+            float thickness = 1.0f);
+
+  ~LineBatch() noexcept;
+
+  /**
+   * Adds a horizontal line.
+   *
+   * \param x0 The x-coordinate of the left end point.
+   * \param x1 The x-coordinate of the right end point.
+   * \param y  The y-coordinate of the line.
+   */
+  void add_horizontal_line(float x0, float x1, float y);
+
+  /**
+   * Adds a vertical line.
+   *
+   * \param x  The x-coordinate of the line.
+   * \param y0 The y-coordinate of the top end point.
+   * \param y1 The y-coordinate of the bottom end point.
+   */
+  void add_vertical_line(float x, float y0, float y1);
+
+  /**
+   * Adds an arbitrary line.
+   *
+   * \param from The first end point.
+   * \param to   The second end point.
+   */
+  void add_line(const Float2& from, const Float2& to);
+
+  /**
+   * Adds the outline of a rectangle, as four lines.
+   *
+   * \param pos  The top-left corner position.
+   * \param size The rectangle size.
+   */
+  void add_rect(const Float2& pos, const Float2& size);
+
+  /**
+   * Adds the outline of a hexagon, as six lines.
+   *
+   * \note
+   * This function assumes that the hexagon is rotated by half Pi, see
+   * \c get_hexagon_vertices.
+   *
+   * \param center_pos   The center position of the hexagon.
+   * \param hexagon_info The hexagon information.
+   */
+  void add_hexagon(const Float2& center_pos, const HexagonInfo& hexagon_info);
+
+  /**
+   * Returns the number of lines added to the batch.
+   *
+   * \return
+   * A line count.
+   */
+  [[nodiscard]]
+  auto size() const noexcept -> std::size_t;
+
+ private:
+  ImDrawList* m_draw_list;
+  std::size_t m_remaining_line_count;
+  std::size_t m_reserved_line_count;
+  std::size_t m_line_count;
+  std::uint32_t m_color;
+  float m_thickness;
+
+  void _reserve_chunk();
+
+  void _add_quad(const Float2& a, const Float2& b, const Float2& c, const Float2& d);
+};
+
+/**
+ * Returns the opacity factor for grid lines with a given spacing.
+ *
+ * \details
+ * Grid lines are gradually faded out as they get closer to each other, and
+ * aren't rendered at all when they are so dense that they would just cover
+ * the content underneath.
+ *
+ * \param line_spacing The screen-space distance between adjacent lines.
+ *
+ * \return
+ * An opacity factor in the interval [0, 1].
+ */
+[[nodiscard]]
+auto get_grid_opacity(float line_spacing) noexcept -> float;
+
+}  // namespace tactile::core::ui
@@ -2,10 +2,14 @@
 
 #pragma once
 
+#include "tactile/base/numeric/index_2d.hpp"
+#include "tactile/base/numeric/vec.hpp"
 #include "tactile/base/prelude.hpp"
 #include "tactile/core/entity/entity.hpp"
 #include "tactile/core/ui/canvas_renderer.hpp"
 
+struct ImDrawList;
+
 namespace tactile::core {
 
 class Registry;
@@ -13,10 +17,57 @@ class Registry;
 namespace ui {
 
 class CanvasRenderer;
+class LayerRenderCache;
+
+/**
+ * Describes a region of tiles to render, and where to render them.
+ */
+struct TileRenderRegion final
+{
+  /** The first tile in the region. */
+  Index2D begin;
+
+  /** The tile after the last tile in the region. */
+  Index2D end;
+
+  /** The target position of the top-left corner of the map. */
+  Float2 origin;
+
+  /** The target size of each tile. */
+  Float2 tile_size;
+};
+
+/**
+ * Renders a region of an orthogonal tile layer.
+ *
+ * \param draw_list The target draw list.
+ * \param registry  The registry that contains the layer.
+ * \param layer_id  The tile layer to render.
+ * \param region    The region of the layer to render.
+ * \param opacity   The opacity of the rendered tiles.
+ */
+void render_orthogonal_tile_layer(ImDrawList& draw_list,
+                                  const Registry& registry,
+                                  EntityID layer_id,
+                                  const TileRenderRegion& region,
+                                  float opacity);
 
+/**
+ * Renders an orthogonal map.
+ *
+ * \details
+ * Consecutive tile layers that aren't active are rendered as groups via the
+ * layer cache, if one is provided. Other layers are always rendered directly.
+ *
+ * \param canvas_renderer The canvas renderer to use.
+ * \param registry        The registry that contains the map.
+ * \param map_id          The map to render.
+ * \param layer_cache     The layer cache to use, may be null.
+ */
 void render_orthogonal_map(const CanvasRenderer& canvas_renderer,
                            const Registry& registry,
-                           EntityID map_id);
+                           EntityID map_id,
+                           LayerRenderCache* layer_cache);
 
 }  // namespace ui
 }  // namespace tactile::core
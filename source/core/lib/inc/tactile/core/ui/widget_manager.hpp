@@ -3,6 +3,7 @@
 #pragma once
 
 #include "tactile/base/prelude.hpp"
+#include "tactile/base/render/renderer.hpp"
 #include "tactile/core/ui/dialog/godot_export_dialog.hpp"
 #include "tactile/core/ui/dialog/new_map_dialog.hpp"
 #include "tactile/core/ui/dialog/new_property_dialog.hpp"
@@ -34,9 +35,10 @@ class WidgetManager final
    * Pushes the active widgets to the widget stack.
    *
    * \param model      The associated model.
+   * \param renderer   The associated renderer.
    * \param dispatcher The associated event dispatcher.
    */
-  void push(const Model& model, EventDispatcher& dispatcher);
+  void push(const Model& model, IRenderer& renderer, EventDispatcher& dispatcher);
 
   /**
    * Returns the dock space manager.
@@ -13,6 +13,7 @@ CommandStack::CommandStack(const std::size_t capacity)
 void CommandStack::mark_as_clean()
 {
   m_clean_index = m_current_index;
+  m_is_dirty = false;
 }
 
 void CommandStack::reset_clean_index()
@@ -20,20 +21,31 @@ void CommandStack::reset_clean_index()
   m_clean_index.reset();
 }
 
+void CommandStack::mark_as_dirty()
+{
+  m_is_dirty = true;
+}
+
 void CommandStack::undo()
 {
   TACTILE_ASSERT(can_undo());
 
-  m_commands.at(m_current_index.value())->undo();
+  auto& cmd = *m_commands.at(m_current_index.value());
+  cmd.undo();
+
   _reset_or_decrease_current_index();
+  _increase_revision(cmd);
 }
 
 void CommandStack::redo()
 {
   TACTILE_ASSERT(can_redo());
 
-  m_commands.at(_get_next_command_index())->redo();
+  auto& cmd = *m_commands.at(_get_next_command_index());
+  cmd.redo();
+
   _increase_current_index();
+  _increase_revision(cmd);
 }
 
 void CommandStack::_store(std::unique_ptr<ICommand> cmd)
@@ -45,6 +57,7 @@ void CommandStack::_store(std::unique_ptr<ICommand> cmd)
   _remove_commands_after_current_index();
   _increase_current_index();
 
+  _increase_revision(*cmd);
   m_commands.push_back(std::move(cmd));
 }
 
@@ -63,6 +76,10 @@ void CommandStack::set_capacity(const std::size_t capacity)
 
 auto CommandStack::is_clean() const -> bool
 {
+  if (m_is_dirty) {
+    return false;
+  }
+
   return m_commands.empty() || (m_clean_index == m_current_index);
 }
 
@@ -97,6 +114,16 @@ auto CommandStack::clean_index() const -> std::optional<std::size_t>
   return m_clean_index;
 }
 
+auto CommandStack::revision() const -> std::uint64_t
+{
+  return m_revision;
+}
+
+auto CommandStack::structure_revision() const -> std::uint64_t
+{
+  return m_structure_revision;
+}
+
 void CommandStack::_remove_oldest_command()
 {
   TACTILE_ASSERT(!m_commands.empty());
@@ -153,6 +180,15 @@ void CommandStack::_increase_current_index()
   m_current_index = _get_next_command_index();
 }
 
+void CommandStack::_increase_revision(const ICommand& cmd)
+{
+  ++m_revision;
+
+  if (!cmd.modifies_only_tiles()) {
+    ++m_structure_revision;
+  }
+}
+
 auto CommandStack::_get_next_command_index() const -> std::size_t
 {
   return m_current_index.has_value() ? *m_current_index + 1 : 0;
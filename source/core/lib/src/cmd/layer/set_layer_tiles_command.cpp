@@ -0,0 +1,59 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/cmd/layer/set_layer_tiles_command.hpp"
+
+#include <utility>  // move
+
+#include "tactile/base/debug/validation.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
+#include "tactile/core/logging.hpp"
+
+namespace tactile::core {
+
+SetLayerTilesCommand::SetLayerTilesCommand(MapDocument* document,
+                                           const EntityID layer_id,
+                                           SparseTileMatrix tiles)
+  : m_document {require_not_null(document, "null document")},
+    m_layer_id {layer_id},
+    m_new_tiles {std::move(tiles)},
+    m_old_tiles {}
+{}
+
+void SetLayerTilesCommand::undo()
+{
+  TACTILE_CORE_TRACE("Restoring {} tile(s) in layer {}",
+                     m_old_tiles.size(),
+                     entity_to_string(m_layer_id));
+  auto& registry = m_document->get_registry();
+
+  for (const auto& [index, tile_id] : m_old_tiles) {
+    set_layer_tile(registry, m_layer_id, index, tile_id);
+  }
+}
+
+void SetLayerTilesCommand::redo()
+{
+  TACTILE_CORE_TRACE("Setting {} tile(s) in layer {}",
+                     m_new_tiles.size(),
+                     entity_to_string(m_layer_id));
+  auto& registry = m_document->get_registry();
+
+  m_old_tiles.clear();
+
+  for (const auto& [index, tile_id] : m_new_tiles) {
+    // Positions outside of the layer are ignored, and have nothing to restore.
+    if (const auto old_tile_id = get_layer_tile(registry, m_layer_id, index)) {
+      m_old_tiles.insert_or_assign(index, *old_tile_id);
+      set_layer_tile(registry, m_layer_id, index, tile_id);
+    }
+  }
+}
+
+auto SetLayerTilesCommand::modifies_only_tiles() const -> bool
+{
+  return true;
+}
+
+}  // namespace tactile::core
@@ -0,0 +1,378 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/debug/profiler.hpp"
+
+#include <algorithm>      // sort, min
+#include <array>          // array
+#include <atomic>         // atomic, memory_order_*
+#include <chrono>         // steady_clock, duration_cast, nanoseconds
+#include <deque>          // deque
+#include <format>         // format_to
+#include <fstream>        // ofstream
+#include <ios>            // ios
+#include <iterator>       // ostreambuf_iterator
+#include <memory>         // shared_ptr, make_shared
+#include <mutex>          // mutex, scoped_lock
+#include <string_view>    // string_view
+#include <unordered_map>  // unordered_map
+#include <utility>        // move
+
+#include "tactile/core/logging.hpp"
+
+namespace tactile::core {
+namespace {
+
+// The number of zones that each thread can record between two frames.
+inline constexpr std::size_t kZoneBufferCapacity = 4'096;
+static_assert((kZoneBufferCapacity & (kZoneBufferCapacity - 1)) == 0);
+
+// The number of frames kept by the profiler.
+inline constexpr std::size_t kMaxFrameCount = 300;
+
+// A single-producer single-consumer ring buffer of zones. The owning thread
+// pushes zones, and the thread that ends frames drains them. Zones are dropped
+// rather than overwritten when the buffer is full, so that the reader never
+// observes partially written zones.
+struct ZoneBuffer final
+{
+  std::array<ProfileZone, kZoneBufferCapacity> zones;
+  std::atomic<std::uint64_t> write_count {0};
+  std::atomic<std::uint64_t> read_count {0};
+  std::atomic<std::size_t> dropped_count {0};
+  std::uint32_t thread_index {0};
+  std::uint32_t depth {0};  // Only accessed by the owning thread.
+};
+
+struct ProfilerState final
+{
+  std::mutex mutex {};
+  std::vector<std::shared_ptr<ZoneBuffer>> buffers {};
+  std::deque<ProfileFrame> frames {};
+  std::uint64_t next_frame_index {0};
+  std::int64_t frame_begin_ns {-1};
+  std::uint32_t frame_thread_index {0};
+};
+
+constinit std::atomic<bool> gProfilerEnabled {false};
+
+[[nodiscard]]
+auto _get_profiler_state() -> ProfilerState&
+{
+  static ProfilerState state {};
+  return state;
+}
+
+[[nodiscard]]
+auto _get_time_ns() noexcept -> std::int64_t
+{
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+// Returns the zone buffer of the calling thread, registering it on first use.
+// The registry keeps the buffer alive after the thread exits, so that any
+// remaining zones can still be collected.
+[[nodiscard]]
+auto _get_thread_zone_buffer() -> ZoneBuffer&
+{
+  thread_local const auto thread_buffer = [] {
+    auto buffer = std::make_shared<ZoneBuffer>();
+
+    auto& state = _get_profiler_state();
+    const std::scoped_lock lock {state.mutex};
+
+    buffer->thread_index = static_cast<std::uint32_t>(state.buffers.size());
+    state.buffers.push_back(buffer);
+
+    return buffer;
+  }();
+
+  return *thread_buffer;
+}
+
+void _push_zone(ZoneBuffer& buffer, const ProfileZone& zone) noexcept
+{
+  const auto write_count = buffer.write_count.load(std::memory_order_relaxed);
+  const auto read_count = buffer.read_count.load(std::memory_order_acquire);
+
+  if (write_count - read_count >= kZoneBufferCapacity) {
+    buffer.dropped_count.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  buffer.zones[write_count & (kZoneBufferCapacity - 1)] = zone;
+  buffer.write_count.store(write_count + 1, std::memory_order_release);
+}
+
+void _drain_zones(ZoneBuffer& buffer, ProfileFrame* frame)
+{
+  const auto read_count = buffer.read_count.load(std::memory_order_relaxed);
+  const auto write_count = buffer.write_count.load(std::memory_order_acquire);
+
+  if (frame != nullptr) {
+    for (auto index = read_count; index < write_count; ++index) {
+      frame->zones.push_back(buffer.zones[index & (kZoneBufferCapacity - 1)]);
+    }
+
+    frame->dropped_zone_count += buffer.dropped_count.exchange(0, std::memory_order_relaxed);
+  }
+  else {
+    buffer.dropped_count.store(0, std::memory_order_relaxed);
+  }
+
+  buffer.read_count.store(write_count, std::memory_order_release);
+}
+
+void _write_json_string(const std::string_view str, std::ostream& stream)
+{
+  stream.put('"');
+
+  for (const auto ch : str) {
+    switch (ch) {
+      case '"':  stream << R"(\")"; break;
+      case '\\': stream << R"(\\)"; break;
+      case '\n': stream << R"(\n)"; break;
+      case '\t': stream << R"(\t)"; break;
+      default:
+        if (static_cast<unsigned char>(ch) < 0x20) {
+          std::format_to(std::ostreambuf_iterator<char> {stream},
+                         "\\u{:04x}",
+                         static_cast<unsigned>(ch));
+        }
+        else {
+          stream.put(ch);
+        }
+    }
+  }
+
+  stream.put('"');
+}
+
+// Emits a complete event, with timestamps in microseconds as mandated by the format.
+void _write_complete_event(const std::string_view name,
+                           const std::string_view category,
+                           const std::int64_t begin_ns,
+                           const std::int64_t end_ns,
+                           const std::uint32_t thread_index,
+                           std::ostream& stream)
+{
+  stream << R"({"name":)";
+  _write_json_string(name, stream);
+  std::format_to(std::ostreambuf_iterator<char> {stream},
+                 R"(,"cat":"{}","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":0,"tid":{}}})",
+                 category,
+                 static_cast<double>(begin_ns) / 1'000.0,
+                 static_cast<double>(end_ns - begin_ns) / 1'000.0,
+                 thread_index);
+}
+
+}  // namespace
+
+ProfileScope::ProfileScope(const char* name) noexcept
+  : m_name {name},
+    m_begin_ns {-1}
+{
+  if (gProfilerEnabled.load(std::memory_order_relaxed)) {
+    ++_get_thread_zone_buffer().depth;
+    m_begin_ns = _get_time_ns();
+  }
+}
+
+ProfileScope::~ProfileScope() noexcept
+{
+  // The state at construction is used, since the profiler may have been toggled.
+  if (m_begin_ns < 0) {
+    return;
+  }
+
+  const auto end_ns = _get_time_ns();
+
+  auto& buffer = _get_thread_zone_buffer();
+  --buffer.depth;
+
+  _push_zone(buffer,
+             ProfileZone {
+               .name = m_name,
+               .begin_ns = m_begin_ns,
+               .end_ns = end_ns,
+               .thread_index = buffer.thread_index,
+               .depth = buffer.depth,
+             });
+}
+
+void set_profiler_enabled(const bool enabled) noexcept
+{
+  gProfilerEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+auto is_profiler_enabled() noexcept -> bool
+{
+  return gProfilerEnabled.load(std::memory_order_relaxed);
+}
+
+void begin_profiler_frame()
+{
+  if (!is_profiler_enabled()) {
+    return;
+  }
+
+  const auto thread_index = _get_thread_zone_buffer().thread_index;
+
+  auto& state = _get_profiler_state();
+  const std::scoped_lock lock {state.mutex};
+
+  state.frame_begin_ns = _get_time_ns();
+  state.frame_thread_index = thread_index;
+}
+
+void end_profiler_frame()
+{
+  auto& state = _get_profiler_state();
+  const std::scoped_lock lock {state.mutex};
+
+  // Zones recorded outside of profiled frames are discarded.
+  if (!is_profiler_enabled() || state.frame_begin_ns < 0) {
+    for (const auto& buffer : state.buffers) {
+      _drain_zones(*buffer, nullptr);
+    }
+
+    state.frame_begin_ns = -1;
+    return;
+  }
+
+  ProfileFrame frame {
+    .index = state.next_frame_index++,
+    .begin_ns = state.frame_begin_ns,
+    .end_ns = _get_time_ns(),
+    .thread_index = state.frame_thread_index,
+    .zones = {},
+    .dropped_zone_count = 0,
+  };
+
+  for (const auto& buffer : state.buffers) {
+    _drain_zones(*buffer, &frame);
+  }
+
+  if (frame.dropped_zone_count > 0) {
+    TACTILE_CORE_WARN("Profiler dropped {} zones in frame {}",
+                      frame.dropped_zone_count,
+                      frame.index);
+  }
+
+  if (state.frames.size() >= kMaxFrameCount) {
+    state.frames.pop_front();
+  }
+
+  state.frames.push_back(std::move(frame));
+  state.frame_begin_ns = -1;
+}
+
+void clear_profiler_frames()
+{
+  auto& state = _get_profiler_state();
+  const std::scoped_lock lock {state.mutex};
+
+  state.frames.clear();
+}
+
+auto get_profiler_frames() -> std::vector<ProfileFrame>
+{
+  auto& state = _get_profiler_state();
+  const std::scoped_lock lock {state.mutex};
+
+  return {state.frames.begin(), state.frames.end()};
+}
+
+auto aggregate_profile_zones(const std::span<const ProfileZone> zones)
+    -> std::vector<ProfileZoneStats>
+{
+  std::vector<ProfileZoneStats> stats {};
+  std::unordered_map<std::string_view, std::size_t> stat_indices {};
+
+  for (const auto& zone : zones) {
+    const auto [iter, inserted] = stat_indices.try_emplace(zone.name, stats.size());
+    if (inserted) {
+      stats.push_back(ProfileZoneStats {
+        .name = zone.name,
+        .call_count = 0,
+        .total_ns = 0,
+        .max_ns = 0,
+      });
+    }
+
+    const auto duration_ns = zone.end_ns - zone.begin_ns;
+
+    auto& zone_stats = stats[iter->second];
+    ++zone_stats.call_count;
+    zone_stats.total_ns += duration_ns;
+    zone_stats.max_ns = std::max(zone_stats.max_ns, duration_ns);
+  }
+
+  std::sort(stats.begin(), stats.end(), [](const auto& a, const auto& b) {
+    return a.total_ns > b.total_ns;
+  });
+
+  return stats;
+}
+
+void write_chrome_trace(const std::span<const ProfileFrame> frames, std::ostream& stream)
+{
+  // Timestamps are relative to the first frame, to keep the numbers readable.
+  const auto epoch_ns = !frames.empty() ? frames.front().begin_ns : 0;
+
+  stream << R"({"displayTimeUnit":"ms","traceEvents":[)";
+
+  bool is_first_event = true;
+  const auto write_separator = [&] {
+    if (!is_first_event) {
+      stream.put(',');
+    }
+
+    stream.put('\n');
+    is_first_event = false;
+  };
+
+  for (const auto& frame : frames) {
+    write_separator();
+    _write_complete_event("Frame",
+                          "frame",
+                          frame.begin_ns - epoch_ns,
+                          frame.end_ns - epoch_ns,
+                          frame.thread_index,
+                          stream);
+
+    for (const auto& zone : frame.zones) {
+      write_separator();
+      _write_complete_event(zone.name,
+                            "zone",
+                            zone.begin_ns - epoch_ns,
+                            zone.end_ns - epoch_ns,
+                            zone.thread_index,
+                            stream);
+    }
+  }
+
+  stream << "\n]}\n";
+}
+
+auto save_chrome_trace(const std::filesystem::path& path) -> std::expected<void, ErrorCode>
+{
+  std::ofstream stream {path, std::ios::out | std::ios::trunc};
+  if (!stream.good()) {
+    TACTILE_CORE_ERROR("Could not open trace file {}", path.string());
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  const auto frames = get_profiler_frames();
+  write_chrome_trace(frames, stream);
+
+  if (!stream.good()) {
+    TACTILE_CORE_ERROR("Could not write trace file {}", path.string());
+    return std::unexpected {ErrorCode::kWriteError};
+  }
+
+  TACTILE_CORE_INFO("Saved {} profiler frames to {}", frames.size(), path.string());
+  return {};
+}
+
+}  // namespace tactile::core
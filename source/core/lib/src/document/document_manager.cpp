@@ -42,10 +42,10 @@ auto DocumentManager::create_and_open_map(const MapSpec& spec)
   return document_uuid;
 }
 
-auto DocumentManager::create_and_open_map(IRenderer& renderer, const ir::Map& ir_map)
+auto DocumentManager::create_and_open_map(IRenderer& renderer, ir::Map&& ir_map)
     -> std::expected<UUID, ErrorCode>
 {
-  auto document = MapDocument::make(renderer, ir_map);
+  auto document = MapDocument::make(renderer, std::move(ir_map));
   if (!document.has_value()) {
     return std::unexpected {document.error()};
   }
@@ -63,13 +63,13 @@ auto MapDocument::make(const MapSpec& spec) -> std::expected<MapDocument, ErrorC
   return document;
 }
 
-auto MapDocument::make(IRenderer& renderer, const ir::Map& ir_map)
+auto MapDocument::make(IRenderer& renderer, ir::Map&& ir_map)
     -> std::expected<MapDocument, ErrorCode>
 {
   MapDocument document {};
   auto& registry = document.mData->registry;
 
-  const auto map_id = make_map(registry, renderer, ir_map);
+  const auto map_id = make_map(registry, renderer, std::move(ir_map));
   if (!map_id.has_value()) {
     TACTILE_CORE_ERROR("Could not create map document: {}", to_string(map_id.error()));
     return std::unexpected {map_id.error()};
@@ -8,7 +8,9 @@
 #include "tactile/base/engine/engine_app.hpp"
 #include "tactile/base/render/renderer.hpp"
 #include "tactile/base/debug/validation.hpp"
+#include "tactile/core/debug/profiler.hpp"
 #include "tactile/core/logging.hpp"
+#include "tactile/core/ui/imgui_allocator.hpp"
 
 namespace tactile::core {
 
@@ -23,6 +25,9 @@ void Engine::run()
 
   bool running = true;
   while (running) {
+    begin_profiler_frame();
+    ui::begin_imgui_allocator_frame();
+
     running = _poll_events();
 
     _check_framebuffer_scale();
@@ -31,8 +36,12 @@ void Engine::run()
 
     if (mRenderer->begin_frame()) {
       mApp->on_render();
+
+      TACTILE_PROFILE_SCOPE("IRenderer::end_frame");
       mRenderer->end_frame();
     }
+
+    end_profiler_frame();
   }
 
   mApp->on_shutdown();
@@ -40,6 +49,8 @@ void Engine::run()
 
 auto Engine::_poll_events() -> bool
 {
+  TACTILE_PROFILE_SCOPE("Engine::poll_events");
+
   auto keep_running = true;
 
   SDL_Event event {};
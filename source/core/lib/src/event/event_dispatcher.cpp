@@ -2,11 +2,64 @@
 
 #include "tactile/core/event/event_dispatcher.hpp"
 
+#include <algorithm>  // min
+
+#include "tactile/core/debug/profiler.hpp"
+#include "tactile/core/logging.hpp"
+
 namespace tactile::core {
+namespace {
+
+constinit std::atomic<std::size_t> g_next_event_type_index {0};
+
+}  // namespace
+
+auto make_event_type_index() noexcept -> std::size_t
+{
+  const auto index = g_next_event_type_index.fetch_add(1, std::memory_order_relaxed);
+
+  if (index >= kMaxEventTypeCount) [[unlikely]] {
+    TACTILE_CORE_ERROR("Too many event types, events of type #{} will be dropped", index);
+  }
+
+  return index;
+}
+
+auto get_event_type_count() noexcept -> std::size_t
+{
+  return g_next_event_type_index.load(std::memory_order_relaxed);
+}
+
+EventDispatcher::~EventDispatcher() noexcept
+{
+  for (auto& queue_slot : m_queues) {
+    delete queue_slot.exchange(nullptr, std::memory_order_acquire);
+  }
+}
 
 void EventDispatcher::update()
 {
-  mDispatcher.update();
+  TACTILE_PROFILE_SCOPE("EventDispatcher::update");
+
+  const auto type_count = std::min(get_event_type_count(), m_queues.size());
+  for (std::size_t type_index = 0; type_index < type_count; ++type_index) {
+    if (auto* queue = m_queues[type_index].load(std::memory_order_acquire)) {
+      queue->dispatch(mDispatcher);
+    }
+  }
+}
+
+auto EventDispatcher::get_stats() const -> std::vector<EventStats>
+{
+  std::vector<EventStats> stats {};
+
+  for (const auto& queue_slot : m_queues) {
+    if (const auto* queue = queue_slot.load(std::memory_order_acquire)) {
+      stats.push_back(queue->get_stats());
+    }
+  }
+
+  return stats;
 }
 
 }  // namespace tactile::core
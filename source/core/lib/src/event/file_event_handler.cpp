@@ -2,12 +2,17 @@
 
 #include "tactile/core/event/file_event_handler.hpp"
 
+#include <optional>  // nullopt
+
 #include "tactile/base/io/save/save_format.hpp"
 #include "tactile/base/runtime/runtime.hpp"
 #include "tactile/base/debug/validation.hpp"
+#include "tactile/core/cmd/command_stack.hpp"
+#include "tactile/core/debug/profiler.hpp"
 #include "tactile/core/document/map_view_impl.hpp"
 #include "tactile/core/event/event_dispatcher.hpp"
 #include "tactile/core/event/events.hpp"
+#include "tactile/core/io/tile_dictionary.hpp"
 #include "tactile/core/logging.hpp"
 #include "tactile/core/model/model.hpp"
 
@@ -35,6 +40,7 @@ void FileEventHandler::install(EventDispatcher& dispatcher)
 void FileEventHandler::on_save(const SaveEvent& event)
 {
   TACTILE_CORE_TRACE("SaveEvent");
+  TACTILE_PROFILE_SCOPE("FileEventHandler::on_save");
 
   const auto* document = dynamic_cast<const MapDocument*>(mModel->get_current_document());
   if (!document) {
@@ -55,6 +61,11 @@ void FileEventHandler::on_save(const SaveEvent& event)
   }
 
   const MapViewImpl map_view {document};
+  const auto tile_dictionary = load_tile_dictionary_for_writing(*document_path, map_view);
+  if (!tile_dictionary.has_value()) {
+    TACTILE_CORE_ERROR("Could not save map: {}", to_string(tile_dictionary.error()));
+    return;
+  }
 
   // TODO
   const SaveFormatWriteOptions options {
@@ -62,12 +73,18 @@ void FileEventHandler::on_save(const SaveEvent& event)
     .use_external_tilesets = false,
     .use_indentation = true,
     .fold_tile_layer_data = false,
+    .compression_level = std::nullopt,
+    .compression_dictionary = *tile_dictionary,
   };
 
   const auto save_result = save_format->save_map(map_view, options);
   if (!save_result.has_value()) {
     TACTILE_CORE_ERROR("Could not save map: {}", to_string(save_result.error()));
+    return;
   }
+
+  auto& document_manager = mModel->get_document_manager();
+  document_manager.get_history(document->get_uuid()).mark_as_clean();
 }
 
 void FileEventHandler::on_save_as(const SaveAsEvent& event)
@@ -80,6 +97,18 @@ void FileEventHandler::on_save_as(const SaveAsEvent& event)
     return;
   }
 
+  // Tile dictionaries are tied to map files, so the new file needs its own copy.
+  const MapViewImpl map_view {document};
+  const auto* old_path = document->get_path();
+
+  if (old_path && uses_tile_dictionary(map_view.get_meta())) {
+    if (const auto copy_result = copy_tile_dictionary(*old_path, event.path);
+        !copy_result.has_value()) {
+      TACTILE_CORE_ERROR("Could not save map: {}", to_string(copy_result.error()));
+      return;
+    }
+  }
+
   document->set_path(event.path);
   on_save(SaveEvent {});
 }
@@ -2,17 +2,26 @@
 
 #include "tactile/core/event/map_event_handler.hpp"
 
-#include <utility>  // move
+#include <optional>  // nullopt
+#include <string>    // string
+#include <utility>   // move
 
 #include <magic_enum.hpp>
 
+#include "tactile/base/io/compress/compression_format_id.hpp"
 #include "tactile/base/io/save/save_format.hpp"
 #include "tactile/base/numeric/vec_format.hpp"
 #include "tactile/base/runtime/runtime.hpp"
 #include "tactile/base/debug/validation.hpp"
+#include "tactile/core/cmd/meta/create_property_command.hpp"
+#include "tactile/core/debug/profiler.hpp"
+#include "tactile/core/document/document_info.hpp"
+#include "tactile/core/document/map_document.hpp"
 #include "tactile/core/document/map_view_impl.hpp"
+#include "tactile/core/entity/registry.hpp"
 #include "tactile/core/event/event_dispatcher.hpp"
 #include "tactile/core/event/events.hpp"
+#include "tactile/core/io/tile_dictionary.hpp"
 #include "tactile/core/logging.hpp"
 #include "tactile/core/model/model.hpp"
 #include "tactile/core/platform/file_dialog.hpp"
@@ -38,6 +47,7 @@ void MapEventHandler::install(EventDispatcher& dispatcher)
   dispatcher.bind<ShowGodotExportDialogEvent, &Self::on_show_godot_export_dialog>(this);
   dispatcher.bind<CreateMapEvent, &Self::on_create_map>(this);
   dispatcher.bind<ExportAsGodotSceneEvent, &Self::on_export_as_godot_scene>(this);
+  dispatcher.bind<TrainTileDictionaryEvent, &Self::on_train_tile_dictionary>(this);
   // TODO ResizeMapEvent
   // TODO FixTilesInMapEvent
   // TODO InspectMapEvent? (or InspectContextEvent?)
@@ -61,6 +71,7 @@ void MapEventHandler::on_show_open_map_dialog(const ShowOpenMapDialogEvent&)
     return;
   }
 
+  TACTILE_PROFILE_SCOPE("MapEventHandler::load_map");
   TACTILE_CORE_TRACE("Trying to load map {}", map_path->string());
   const auto format_id = _guess_save_format(*map_path);
   if (!format_id.has_value()) {
@@ -75,22 +86,31 @@ void MapEventHandler::on_show_open_map_dialog(const ShowOpenMapDialogEvent&)
     return;
   }
 
+  const auto tile_dictionary = load_tile_dictionary_for_reading(*map_path);
+
   // TODO
   const SaveFormatReadOptions read_options {
     .base_dir = map_path->parent_path(),
     .strict_mode = false,
+    .compression_dictionary = tile_dictionary,
   };
 
-  const auto ir_map = save_format->load_map(*map_path, read_options);
+  auto ir_map = save_format->load_map(*map_path, read_options);
   if (!ir_map.has_value()) {
     TACTILE_CORE_ERROR("Could not load map: {}", to_string(ir_map.error()));
     return;
   }
 
+  if (const auto dictionary_result = validate_tile_dictionary(*map_path, *ir_map);
+      !dictionary_result.has_value()) {
+    TACTILE_CORE_ERROR("Could not load map: {}", to_string(dictionary_result.error()));
+    return;
+  }
+
   auto& document_manager = mModel->get_document_manager();
 
   const auto document_uuid =
-      document_manager.create_and_open_map(*mRuntime->get_renderer(), *ir_map);
+      document_manager.create_and_open_map(*mRuntime->get_renderer(), std::move(*ir_map));
   if (!document_uuid.has_value()) {
     TACTILE_CORE_ERROR("Could not create map document: {}", to_string(document_uuid.error()));
     return;
@@ -123,6 +143,7 @@ void MapEventHandler::on_create_map(const CreateMapEvent& event)
 void MapEventHandler::on_export_as_godot_scene(const ExportAsGodotSceneEvent& event) const
 {
   TACTILE_CORE_TRACE("ExportMapEvent");
+  TACTILE_PROFILE_SCOPE("MapEventHandler::on_export_as_godot_scene");
 
   const auto* save_format = mRuntime->get_save_format(SaveFormatId::kGodotTscn);
   if (!save_format) {
@@ -146,6 +167,8 @@ void MapEventHandler::on_export_as_godot_scene(const ExportAsGodotSceneEvent& ev
     .use_external_tilesets = false,
     .use_indentation = false,
     .fold_tile_layer_data = false,
+    .compression_level = std::nullopt,
+    .compression_dictionary = ByteSpan {},
   };
 
   const MapViewImpl map_view {document};
@@ -156,6 +179,47 @@ void MapEventHandler::on_export_as_godot_scene(const ExportAsGodotSceneEvent& ev
   }
 }
 
+void MapEventHandler::on_train_tile_dictionary(const TrainTileDictionaryEvent&)
+{
+  TACTILE_CORE_TRACE("TrainTileDictionaryEvent");
+  TACTILE_PROFILE_SCOPE("MapEventHandler::on_train_tile_dictionary");
+
+  const auto* compression_format =
+      mRuntime->get_compression_format(CompressionFormatId::kZstd);
+  if (!compression_format) {
+    TACTILE_CORE_ERROR("Zstd plugin is not enabled");
+    return;
+  }
+
+  const auto* document = dynamic_cast<const MapDocument*>(mModel->get_current_document());
+  if (!document) {
+    TACTILE_CORE_ERROR("No current document");
+    return;
+  }
+
+  const auto* document_path = document->get_path();
+  if (!document_path) {
+    TACTILE_CORE_ERROR("Document has no associated path");
+    return;
+  }
+
+  const MapViewImpl map_view {document};
+  const auto train_result =
+      train_tile_dictionary(*compression_format, map_view, *document_path);
+
+  if (!train_result.has_value()) {
+    TACTILE_CORE_ERROR("Could not train tile dictionary: {}", to_string(train_result.error()));
+    return;
+  }
+
+  // The property is what makes the map use the dictionary, and it is stored in
+  // the map so that missing dictionaries are detected when the map is loaded.
+  const auto map_id = document->get_registry().get<CDocumentInfo>().root;
+  mModel->push_command<CreatePropertyCommand>(map_id,
+                                              std::string {kTileDictionaryProperty},
+                                              Attribute {true});
+}
+
 auto MapEventHandler::_guess_save_format(const std::filesystem::path& path)
     -> std::optional<SaveFormatId>
 {
@@ -173,6 +237,10 @@ auto MapEventHandler::_guess_save_format(const std::filesystem::path& path)
     return SaveFormatId::kTiledTmx;
   }
 
+  if (extension == ".tactile") {
+    return SaveFormatId::kTactileBinary;
+  }
+
   return std::nullopt;
 }
 
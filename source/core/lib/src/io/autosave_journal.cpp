@@ -0,0 +1,214 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/autosave_journal.hpp"
+
+#include <algorithm>  // equal
+#include <array>      // array
+#include <cstring>    // memcpy
+#include <utility>    // move
+
+#include "tactile/base/io/file_io.hpp"
+#include "tactile/base/util/hash.hpp"
+#include "tactile/core/debug/profiler.hpp"
+#include "tactile/core/logging.hpp"
+
+namespace tactile::core {
+namespace {
+
+inline constexpr std::array<std::uint8_t, 8> kJournalMagic {
+  'T', 'A', 'C', 'T', 'J', 'R', 'N', 'L',
+};
+inline constexpr std::uint32_t kJournalVersion = 1;
+
+// Each record starts with the payload size and the payload checksum.
+inline constexpr std::size_t kRecordHeaderSize = 2 * sizeof(std::uint32_t);
+
+template <typename T>
+void _write(ByteStream& bytes, const T value)
+{
+  const auto offset = bytes.size();
+  bytes.resize(offset + sizeof(T));
+  std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+[[nodiscard]] auto _read(ByteSpan& bytes, T& value) -> bool
+{
+  if (bytes.size() < sizeof(T)) {
+    return false;
+  }
+
+  std::memcpy(&value, bytes.data(), sizeof(T));
+  bytes = bytes.subspan(sizeof(T));
+
+  return true;
+}
+
+[[nodiscard]]
+auto _decode_record_payload(ByteSpan payload, std::vector<JournalTileRow>& rows) -> bool
+{
+  std::uint32_t row_count {};
+  if (!_read(payload, row_count)) {
+    return false;
+  }
+
+  for (std::uint32_t row_index = 0; row_index < row_count; ++row_index) {
+    JournalTileRow row {};
+    std::uint32_t tile_count {};
+
+    if (!_read(payload, row.layer_id) || !_read(payload, row.row) ||
+        !_read(payload, tile_count)) {
+      return false;
+    }
+
+    if (payload.size() / sizeof(TileID) < tile_count) {
+      return false;
+    }
+
+    row.tiles.resize(tile_count);
+    std::memcpy(row.tiles.data(), payload.data(), tile_count * sizeof(TileID));
+    payload = payload.subspan(tile_count * sizeof(TileID));
+
+    rows.push_back(std::move(row));
+  }
+
+  return payload.empty();
+}
+
+[[nodiscard]]
+auto _find_layer(std::vector<ir::Layer>& layers, const std::int32_t layer_id) -> ir::Layer*
+{
+  for (auto& layer : layers) {
+    if (layer.id == layer_id) {
+      return &layer;
+    }
+
+    if (auto* nested_layer = _find_layer(layer.layers, layer_id)) {
+      return nested_layer;
+    }
+  }
+
+  return nullptr;
+}
+
+}  // namespace
+
+void encode_journal_record(const std::span<const JournalTileRow> rows, ByteStream& bytes)
+{
+  const auto record_offset = bytes.size();
+
+  // The header is filled in once the payload has been written.
+  bytes.resize(record_offset + kRecordHeaderSize);
+
+  _write(bytes, static_cast<std::uint32_t>(rows.size()));
+
+  for (const auto& row : rows) {
+    _write(bytes, row.layer_id);
+    _write(bytes, row.row);
+    _write(bytes, static_cast<std::uint32_t>(row.tiles.size()));
+
+    const auto tiles_offset = bytes.size();
+    const auto tiles_size = row.tiles.size() * sizeof(TileID);
+    bytes.resize(tiles_offset + tiles_size);
+    std::memcpy(bytes.data() + tiles_offset, row.tiles.data(), tiles_size);
+  }
+
+  const auto payload_offset = record_offset + kRecordHeaderSize;
+  const auto payload = ByteSpan {bytes}.subspan(payload_offset);
+
+  const auto payload_size = static_cast<std::uint32_t>(payload.size());
+  const auto payload_checksum = fnv1a_hash(payload);
+
+  std::memcpy(bytes.data() + record_offset, &payload_size, sizeof payload_size);
+  std::memcpy(bytes.data() + record_offset + sizeof payload_size,
+              &payload_checksum,
+              sizeof payload_checksum);
+}
+
+auto make_journal_header() -> ByteStream
+{
+  ByteStream bytes {kJournalMagic.begin(), kJournalMagic.end()};
+  _write(bytes, kJournalVersion);
+  return bytes;
+}
+
+auto decode_journal(ByteSpan bytes) -> std::expected<std::vector<JournalTileRow>, ErrorCode>
+{
+  if (bytes.size() < kJournalMagic.size() ||
+      !std::equal(kJournalMagic.begin(), kJournalMagic.end(), bytes.begin())) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  bytes = bytes.subspan(kJournalMagic.size());
+
+  std::uint32_t version {};
+  if (!_read(bytes, version) || version != kJournalVersion) {
+    return std::unexpected {ErrorCode::kNotSupported};
+  }
+
+  std::vector<JournalTileRow> rows {};
+
+  while (!bytes.empty()) {
+    std::uint32_t payload_size {};
+    std::uint32_t payload_checksum {};
+
+    if (!_read(bytes, payload_size) || !_read(bytes, payload_checksum) ||
+        bytes.size() < payload_size) {
+      TACTILE_CORE_WARN("Ignoring incomplete autosave journal record");
+      break;
+    }
+
+    const auto payload = bytes.first(payload_size);
+    bytes = bytes.subspan(payload_size);
+
+    const auto row_count = rows.size();
+    if (fnv1a_hash(payload) != payload_checksum || !_decode_record_payload(payload, rows)) {
+      TACTILE_CORE_WARN("Ignoring corrupt autosave journal record");
+      rows.resize(row_count);
+      break;
+    }
+  }
+
+  return rows;
+}
+
+auto read_journal(const std::filesystem::path& path)
+    -> std::expected<std::vector<JournalTileRow>, ErrorCode>
+{
+  TACTILE_PROFILE_SCOPE("read_journal");
+
+  const auto journal_content = read_binary_file(path);
+  if (!journal_content.has_value()) {
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  const ByteSpan journal_bytes {reinterpret_cast<const std::uint8_t*>(journal_content->data()),
+                                journal_content->size()};
+  return decode_journal(journal_bytes);
+}
+
+auto apply_journal(const std::span<const JournalTileRow> rows, ir::Map& ir_map)
+    -> std::expected<void, ErrorCode>
+{
+  for (const auto& row : rows) {
+    auto* layer = _find_layer(ir_map.layers, row.layer_id);
+    if (layer == nullptr || layer->type != LayerType::kTileLayer) {
+      TACTILE_CORE_ERROR("Autosave journal refers to unknown tile layer {}", row.layer_id);
+      return std::unexpected {ErrorCode::kBadState};
+    }
+
+    if (row.row < 0 || static_cast<std::size_t>(row.row) >= layer->tiles.size() ||
+        row.tiles.size() != layer->tiles[static_cast<std::size_t>(row.row)].size()) {
+      TACTILE_CORE_ERROR("Autosave journal row {} doesn't fit in layer {}",
+                         row.row,
+                         row.layer_id);
+      return std::unexpected {ErrorCode::kBadState};
+    }
+
+    layer->tiles[static_cast<std::size_t>(row.row)] = row.tiles;
+  }
+
+  return {};
+}
+
+}  // namespace tactile::core
@@ -0,0 +1,756 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/autosave_service.hpp"
+
+#include <algorithm>     // find, find_if
+#include <format>        // format
+#include <map>           // map, erase_if
+#include <system_error>  // error_code
+#include <utility>       // move, to_underlying
+
+#include "session.pb.h"
+#include "tactile/base/debug/validation.hpp"
+#include "tactile/base/document/map_view.hpp"
+#include "tactile/base/id.hpp"
+#include "tactile/base/io/file_io.hpp"
+#include "tactile/base/io/save/save_format.hpp"
+#include "tactile/base/io/save/save_format_id.hpp"
+#include "tactile/base/runtime/runtime.hpp"
+#include "tactile/core/cmd/command_stack.hpp"
+#include "tactile/core/debug/profiler.hpp"
+#include "tactile/core/document/document_info.hpp"
+#include "tactile/core/document/document_manager.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/document/map_view_impl.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/io/autosave_journal.hpp"
+#include "tactile/core/logging.hpp"
+#include "tactile/core/map/map.hpp"
+#include "tactile/core/platform/filesystem.hpp"
+
+namespace tactile::core {
+namespace {
+
+inline constexpr auto kManifestFileName = "autosave.bin";
+
+// Journals that grow larger than this are replaced by a new checkpoint, to limit the
+// time it takes to recover a document.
+inline constexpr std::size_t kMaxJournalSize = std::size_t {64} << 20U;
+
+// Checkpoints favor speed over size, since they are written frequently. This is the fastest
+// regular level for both Zlib and Zstd.
+inline constexpr int kCheckpointCompressionLevel = 1;
+
+/**
+ * A map view that redirects the map file path to an autosave checkpoint.
+ */
+class CheckpointMapView final : public IMapView
+{
+ public:
+  CheckpointMapView(const IMapView& map_view, std::filesystem::path checkpoint_path)
+    : m_map_view {map_view},
+      m_checkpoint_path {std::move(checkpoint_path)}
+  {}
+
+  [[nodiscard]]
+  auto accept(IDocumentVisitor& visitor) const -> std::expected<void, ErrorCode> override
+  {
+    return m_map_view.accept(visitor);
+  }
+
+  [[nodiscard]]
+  auto get_path() const -> const std::filesystem::path* override
+  {
+    return &m_checkpoint_path;
+  }
+
+  [[nodiscard]]
+  auto get_tile_size() const -> Int2 override
+  {
+    return m_map_view.get_tile_size();
+  }
+
+  [[nodiscard]]
+  auto get_extent() const -> Extent2D override
+  {
+    return m_map_view.get_extent();
+  }
+
+  [[nodiscard]]
+  auto get_next_layer_id() const -> LayerID override
+  {
+    return m_map_view.get_next_layer_id();
+  }
+
+  [[nodiscard]]
+  auto get_next_object_id() const -> ObjectID override
+  {
+    return m_map_view.get_next_object_id();
+  }
+
+  [[nodiscard]]
+  auto get_tile_encoding() const -> TileEncoding override
+  {
+    return m_map_view.get_tile_encoding();
+  }
+
+  [[nodiscard]]
+  auto get_tile_compression() const -> std::optional<CompressionFormatId> override
+  {
+    return m_map_view.get_tile_compression();
+  }
+
+  [[nodiscard]]
+  auto get_compression_level() const -> std::optional<int> override
+  {
+    return m_map_view.get_compression_level();
+  }
+
+  [[nodiscard]]
+  auto layer_count() const -> std::size_t override
+  {
+    return m_map_view.layer_count();
+  }
+
+  [[nodiscard]]
+  auto tileset_count() const -> std::size_t override
+  {
+    return m_map_view.tileset_count();
+  }
+
+  [[nodiscard]]
+  auto component_count() const -> std::size_t override
+  {
+    return m_map_view.component_count();
+  }
+
+  [[nodiscard]]
+  auto get_meta() const -> const IMetaView& override
+  {
+    return m_map_view.get_meta();
+  }
+
+ private:
+  const IMapView& m_map_view;
+  std::filesystem::path m_checkpoint_path;
+};
+
+template <typename Snapshot>
+[[nodiscard]] auto _collect_tile_layers(const Registry& registry,
+                                        const EntityID group_layer_entity,
+                                        std::vector<Snapshot>& tile_layers) -> bool
+{
+  for (const auto layer_entity : registry.get<CGroupLayer>(group_layer_entity).layers) {
+    const auto& layer = registry.get<CLayer>(layer_entity);
+    if (!layer.persistent_id.has_value()) {
+      return false;
+    }
+
+    if (registry.has<CGroupLayer>(layer_entity)) {
+      if (!_collect_tile_layers(registry, layer_entity, tile_layers)) {
+        return false;
+      }
+
+      continue;
+    }
+
+    const auto* tile_layer = registry.find<CTileLayer>(layer_entity);
+    if (!tile_layer) {
+      continue;
+    }
+
+    tile_layers.push_back(Snapshot {
+      .entity = layer_entity,
+      .persistent_id = *layer.persistent_id,
+      .extent = tile_layer->extent,
+      .revision = tile_layer->revision,
+      .is_dense = registry.has<CDenseTileLayer>(layer_entity),
+      .dense_tiles = std::nullopt,
+      .sparse_tiles = std::nullopt,
+    });
+  }
+
+  return true;
+}
+
+// Populates the tiles of new snapshots. Only the tiles of layers that were modified since the
+// old snapshots are copied, the tiles of other layers are moved from the old snapshots.
+template <typename Snapshot>
+void _fill_tile_layers(const Registry& registry,
+                       std::vector<Snapshot>& old_layers,
+                       std::vector<Snapshot>& new_layers)
+{
+  for (auto& new_layer : new_layers) {
+    const auto old_layer = std::ranges::find_if(old_layers, [&](const Snapshot& layer) {
+      return layer.entity == new_layer.entity;
+    });
+
+    if (old_layer != old_layers.end() && old_layer->revision == new_layer.revision &&
+        old_layer->is_dense == new_layer.is_dense && old_layer->extent == new_layer.extent) {
+      new_layer.dense_tiles = std::move(old_layer->dense_tiles);
+      new_layer.sparse_tiles = std::move(old_layer->sparse_tiles);
+      continue;
+    }
+
+    // Dense layers use copy-on-write rows, so this is a cheap copy.
+    if (new_layer.is_dense) {
+      new_layer.dense_tiles = registry.get<CDenseTileLayer>(new_layer.entity).tiles;
+    }
+    else {
+      new_layer.sparse_tiles = registry.get<CSparseTileLayer>(new_layer.entity).tiles;
+    }
+  }
+}
+
+template <typename Snapshot>
+[[nodiscard]] auto _has_same_layout(const std::vector<Snapshot>& old_layers,
+                                    const std::vector<Snapshot>& new_layers) -> bool
+{
+  if (old_layers.size() != new_layers.size()) {
+    return false;
+  }
+
+  for (std::size_t index = 0; index < old_layers.size(); ++index) {
+    const auto& old_layer = old_layers[index];
+    const auto& new_layer = new_layers[index];
+
+    if (old_layer.entity != new_layer.entity ||
+        old_layer.persistent_id != new_layer.persistent_id ||
+        old_layer.extent != new_layer.extent ||
+        old_layer.is_dense != new_layer.is_dense) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void _diff_dense_tile_layer(const CowTileMatrix& old_tiles,
+                            const CowTileMatrix& new_tiles,
+                            const std::int32_t layer_id,
+                            std::vector<JournalTileRow>& rows)
+{
+  const auto row_count = new_tiles.get_extent().rows;
+
+  for (std::size_t row = 0; row < row_count; ++row) {
+    // Rows that are still shared can't have been modified.
+    if (new_tiles.shares_row(old_tiles, row) || new_tiles[row] == old_tiles[row]) {
+      continue;
+    }
+
+    rows.push_back(JournalTileRow {
+      .layer_id = layer_id,
+      .row = static_cast<std::int32_t>(row),
+      .tiles = new_tiles[row],
+    });
+  }
+}
+
+void _diff_sparse_tile_layer(const SparseTileMatrix& old_tiles,
+                             const SparseTileMatrix& new_tiles,
+                             const Extent2D& extent,
+                             const std::int32_t layer_id,
+                             std::vector<JournalTileRow>& rows)
+{
+  std::vector<bool> changed_rows(extent.rows, false);
+
+  for (const auto& [index, tile_id] : old_tiles) {
+    const auto iter = new_tiles.find(index);
+    if (iter == new_tiles.end() || iter->second != tile_id) {
+      changed_rows[index.y] = true;
+    }
+  }
+
+  for (const auto& [index, tile_id] : new_tiles) {
+    if (!old_tiles.contains(index)) {
+      changed_rows[index.y] = true;
+    }
+  }
+
+  std::map<std::size_t, TileRow> changed_tile_rows {};
+  for (std::size_t row = 0; row < extent.rows; ++row) {
+    if (changed_rows[row]) {
+      changed_tile_rows.try_emplace(row, TileRow(extent.cols, kEmptyTile));
+    }
+  }
+
+  for (const auto& [index, tile_id] : new_tiles) {
+    if (const auto iter = changed_tile_rows.find(index.y); iter != changed_tile_rows.end()) {
+      iter->second[index.x] = tile_id;
+    }
+  }
+
+  for (auto& [row, tiles] : changed_tile_rows) {
+    rows.push_back(JournalTileRow {
+      .layer_id = layer_id,
+      .row = static_cast<std::int32_t>(row),
+      .tiles = std::move(tiles),
+    });
+  }
+}
+
+}  // namespace
+
+AutosaveService::AutosaveService(IRuntime* runtime, std::filesystem::path autosave_dir)
+  : m_runtime {require_not_null(runtime, "null runtime")},
+    m_autosave_dir {std::move(autosave_dir)}
+{
+  std::error_code error_code {};
+  for (const auto& entry : std::filesystem::directory_iterator {m_autosave_dir, error_code}) {
+    if (entry.is_regular_file(error_code)) {
+      m_stale_files.push_back(entry.path());
+    }
+  }
+}
+
+AutosaveService::~AutosaveService() noexcept = default;
+
+void AutosaveService::update(const DocumentManager& document_manager,
+                             const std::chrono::seconds interval)
+{
+  if (interval <= std::chrono::seconds::zero()) {
+    return;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  if (now < m_next_save_time) {
+    return;
+  }
+
+  m_next_save_time = now + interval;
+  save(document_manager);
+}
+
+void AutosaveService::save(const DocumentManager& document_manager)
+{
+  TACTILE_PROFILE_SCOPE("AutosaveService::save");
+
+  _report_write_failures();
+
+  auto should_write_manifest = _forget_closed_documents(document_manager);
+
+  for (const auto& document_uuid : document_manager.get_open_documents()) {
+    const auto* map_document =
+        dynamic_cast<const MapDocument*>(&document_manager.get_document(document_uuid));
+    if (!map_document) {
+      continue;
+    }
+
+    const auto& history = document_manager.get_history(document_uuid);
+    if (_save_document(*map_document, history)) {
+      should_write_manifest = true;
+    }
+  }
+
+  if (should_write_manifest) {
+    _write_manifest(document_manager);
+  }
+}
+
+void AutosaveService::request_checkpoint(const UUID& document_uuid)
+{
+  m_documents[document_uuid].needs_checkpoint = true;
+}
+
+void AutosaveService::finish(const DocumentManager& document_manager)
+{
+  TACTILE_PROFILE_SCOPE("AutosaveService::finish");
+
+  save(document_manager);
+
+  // Saved documents no longer need their autosave data, but the rest are kept until the user
+  // either saves or closes them.
+  auto should_write_manifest = false;
+  std::erase_if(m_documents, [&](const auto& uuid_and_state) {
+    const auto& [document_uuid, state] = uuid_and_state;
+
+    if (!document_manager.get_history(document_uuid).is_clean()) {
+      return false;
+    }
+
+    if (state.has_checkpoint) {
+      _retire_files(document_uuid, state.generation);
+      should_write_manifest = true;
+    }
+
+    return true;
+  });
+
+  if (m_documents.empty()) {
+    clear();
+    return;
+  }
+
+  TACTILE_CORE_INFO("Keeping autosave data of {} modified map(s)", m_documents.size());
+
+  if (should_write_manifest) {
+    _write_manifest(document_manager);
+  }
+
+  m_writer.wait();
+  _report_write_failures();
+}
+
+void AutosaveService::clear()
+{
+  TACTILE_CORE_DEBUG("Removing autosave data");
+
+  for (const auto& [document_uuid, state] : m_documents) {
+    if (state.has_checkpoint) {
+      _retire_files(document_uuid, state.generation);
+    }
+  }
+
+  for (auto& stale_file : m_stale_files) {
+    m_writer.remove(std::move(stale_file));
+  }
+
+  m_writer.remove(m_autosave_dir / kManifestFileName);
+
+  m_documents.clear();
+  m_stale_files.clear();
+
+  m_writer.wait();
+  _report_write_failures();
+}
+
+auto AutosaveService::get_directory() const -> const std::filesystem::path&
+{
+  return m_autosave_dir;
+}
+
+auto AutosaveService::_save_document(const MapDocument& document, const CommandStack& history)
+    -> bool
+{
+  auto& state = m_documents[document.get_uuid()];
+
+  // Documents start out matching their files, so there's nothing to save until they're edited.
+  if (!state.needs_checkpoint && state.revision == history.revision()) {
+    return false;
+  }
+
+  const auto& registry = document.get_registry();
+  const auto& document_info = registry.get<CDocumentInfo>();
+  const auto& map = registry.get<CMap>(document_info.root);
+
+  std::vector<TileLayerSnapshot> tile_layers {};
+  if (!_collect_tile_layers(registry, map.root_layer, tile_layers)) {
+    // Save formats can't write layers without persistent identifiers, so checkpoints of such
+    // maps would always fail.
+    if (!state.reported_missing_layer_ids) {
+      TACTILE_CORE_WARN("Skipping autosave of map {} with unidentified layers",
+                        document.get_uuid());
+      state.reported_missing_layer_ids = true;
+    }
+
+    return false;
+  }
+
+  state.revision = history.revision();
+  state.reported_missing_layer_ids = false;
+
+  _fill_tile_layers(registry, state.tile_layers, tile_layers);
+
+  const auto needs_checkpoint =
+      state.needs_checkpoint || !state.has_checkpoint ||
+      state.structure_revision != history.structure_revision() ||
+      state.journal_size > kMaxJournalSize ||
+      !_has_same_layout(state.tile_layers, tile_layers);
+
+  state.structure_revision = history.structure_revision();
+
+  if (needs_checkpoint) {
+    state.tile_layers = std::move(tile_layers);
+    return _checkpoint(document, state);
+  }
+
+  std::vector<JournalTileRow> changed_rows {};
+
+  for (std::size_t index = 0; index < tile_layers.size(); ++index) {
+    const auto& old_layer = state.tile_layers[index];
+    const auto& new_layer = tile_layers[index];
+
+    if (old_layer.revision == new_layer.revision) {
+      continue;
+    }
+
+    if (new_layer.is_dense) {
+      _diff_dense_tile_layer(*old_layer.dense_tiles,
+                             *new_layer.dense_tiles,
+                             new_layer.persistent_id,
+                             changed_rows);
+    }
+    else {
+      _diff_sparse_tile_layer(*old_layer.sparse_tiles,
+                              *new_layer.sparse_tiles,
+                              new_layer.extent,
+                              new_layer.persistent_id,
+                              changed_rows);
+    }
+  }
+
+  state.tile_layers = std::move(tile_layers);
+
+  if (!changed_rows.empty()) {
+    ByteStream record {};
+    encode_journal_record(changed_rows, record);
+
+    TACTILE_CORE_TRACE("Journaling {} tile row(s) ({} bytes) of map {}",
+                       changed_rows.size(),
+                       record.size(),
+                       document.get_uuid());
+
+    state.journal_size += record.size();
+    m_writer.append(_get_journal_path(document.get_uuid(), state.generation),
+                    std::move(record));
+  }
+
+  return false;
+}
+
+auto AutosaveService::_checkpoint(const MapDocument& document, DocumentState& state) -> bool
+{
+  TACTILE_PROFILE_SCOPE("AutosaveService::_checkpoint");
+
+  const auto& document_uuid = document.get_uuid();
+
+  const auto* save_format = m_runtime->get_save_format(document.get_format());
+  if (!save_format) {
+    TACTILE_CORE_ERROR("Could not find save format for autosave of map {}", document_uuid);
+    state.needs_checkpoint = true;
+    return false;
+  }
+
+  const auto generation = state.has_checkpoint ? state.generation + 1 : state.generation;
+
+  const MapViewImpl map_view {&document};
+  const CheckpointMapView checkpoint_view {map_view,
+                                           _get_checkpoint_path(document_uuid, generation)};
+
+  const SaveFormatWriteOptions options {
+    .base_dir = m_autosave_dir,
+    .use_external_tilesets = false,
+    .use_indentation = false,
+    .fold_tile_layer_data = false,
+    .compression_level = kCheckpointCompressionLevel,
+    .compression_dictionary = ByteSpan {},
+  };
+
+  TACTILE_CORE_DEBUG("Writing autosave checkpoint {} of map {}", generation, document_uuid);
+
+  if (const auto save_result = save_format->save_map(checkpoint_view, options);
+      !save_result.has_value()) {
+    TACTILE_CORE_ERROR("Could not write autosave checkpoint: {}",
+                       to_string(save_result.error()));
+    state.needs_checkpoint = true;
+    return false;
+  }
+
+  m_writer.write(_get_journal_path(document_uuid, generation), make_journal_header());
+
+  if (state.has_checkpoint) {
+    _retire_files(document_uuid, state.generation);
+  }
+
+  state.generation = generation;
+  state.journal_size = 0;
+  state.has_checkpoint = true;
+  state.needs_checkpoint = false;
+
+  return true;
+}
+
+auto AutosaveService::_forget_closed_documents(const DocumentManager& document_manager)
+    -> bool
+{
+  const auto& open_documents = document_manager.get_open_documents();
+
+  auto did_forget_checkpoint = false;
+  std::erase_if(m_documents, [&](const auto& uuid_and_state) {
+    const auto& [document_uuid, state] = uuid_and_state;
+
+    if (std::ranges::find(open_documents, document_uuid) != open_documents.end()) {
+      return false;
+    }
+
+    if (state.has_checkpoint) {
+      _retire_files(document_uuid, state.generation);
+      did_forget_checkpoint = true;
+    }
+
+    return true;
+  });
+
+  return did_forget_checkpoint;
+}
+
+void AutosaveService::_retire_files(const UUID& document_uuid, const std::uint64_t generation)
+{
+  m_stale_files.push_back(_get_checkpoint_path(document_uuid, generation));
+  m_stale_files.push_back(_get_journal_path(document_uuid, generation));
+}
+
+void AutosaveService::_write_manifest(const DocumentManager& document_manager)
+{
+  proto::Session manifest {};
+
+  for (const auto& [document_uuid, state] : m_documents) {
+    if (!state.has_checkpoint) {
+      continue;
+    }
+
+    const auto& document = document_manager.get_document(document_uuid);
+
+    auto* entry = manifest.add_autosaves();
+    entry->set_checkpoint_file(_get_checkpoint_path(document_uuid, state.generation)
+                                   .filename()
+                                   .string());
+    entry->set_journal_file(_get_journal_path(document_uuid, state.generation)
+                                .filename()
+                                .string());
+    entry->set_save_format(static_cast<std::uint32_t>(document.get_format()));
+
+    if (const auto* document_path = document.get_path()) {
+      entry->set_document_path(normalize_path(std::filesystem::absolute(*document_path)));
+    }
+  }
+
+  const auto manifest_data = manifest.SerializeAsString();
+  m_writer.write(m_autosave_dir / kManifestFileName,
+                 ByteStream {manifest_data.begin(), manifest_data.end()});
+
+  // Old files are only removed once the new manifest replaces the old one, so that the
+  // autosave data on disk is consistent at all times. This also covers files left behind by
+  // previous sessions, so a crash right after a recovery doesn't lose any data.
+  for (auto& stale_file : m_stale_files) {
+    if (stale_file.filename() != kManifestFileName) {
+      m_writer.remove(std::move(stale_file));
+    }
+  }
+
+  m_stale_files.clear();
+}
+
+auto AutosaveService::_get_checkpoint_path(const UUID& document_uuid,
+                                           const std::uint64_t generation) const
+    -> std::filesystem::path
+{
+  const auto file_name =
+      std::format("{}.{}.checkpoint", to_string(document_uuid), generation);
+  return m_autosave_dir / file_name;
+}
+
+auto AutosaveService::_get_journal_path(const UUID& document_uuid,
+                                        const std::uint64_t generation) const
+    -> std::filesystem::path
+{
+  return m_autosave_dir / std::format("{}.{}.journal", to_string(document_uuid), generation);
+}
+
+void AutosaveService::_report_write_failures()
+{
+  if (const auto failure_count = m_writer.take_failure_count(); failure_count > 0) {
+    TACTILE_CORE_ERROR("{} autosave write(s) failed", failure_count);
+  }
+}
+
+auto get_autosave_directory() -> std::expected<std::filesystem::path, ErrorCode>
+{
+  return get_persistent_storage_directory().and_then(
+      [](const std::filesystem::path& storage_dir)
+          -> std::expected<std::filesystem::path, ErrorCode> {
+        auto autosave_dir = storage_dir / "autosave";
+
+        std::error_code error_code {};
+        std::filesystem::create_directories(autosave_dir, error_code);
+
+        if (error_code) {
+          TACTILE_CORE_ERROR("Could not create autosave directory: {}", error_code.message());
+          return std::unexpected {ErrorCode::kBadFileStream};
+        }
+
+        return autosave_dir;
+      });
+}
+
+auto recover_autosaved_maps(IRuntime& runtime,
+                            const std::filesystem::path& autosave_dir,
+                            DocumentManager& document_manager) -> std::vector<UUID>
+{
+  TACTILE_PROFILE_SCOPE("recover_autosaved_maps");
+
+  std::vector<UUID> recovered_documents {};
+
+  const auto manifest_data = read_binary_file(autosave_dir / kManifestFileName);
+  if (!manifest_data.has_value()) {
+    return recovered_documents;
+  }
+
+  proto::Session manifest {};
+  if (!manifest.ParseFromString(*manifest_data)) {
+    TACTILE_CORE_ERROR("Could not parse autosave manifest");
+    return recovered_documents;
+  }
+
+  for (const auto& entry : manifest.autosaves()) {
+    if (entry.save_format() > std::to_underlying(SaveFormatId::kTactileBinary)) {
+      TACTILE_CORE_ERROR("Invalid save format in autosave manifest: {}", entry.save_format());
+      continue;
+    }
+
+    const auto save_format_id = static_cast<SaveFormatId>(entry.save_format());
+
+    const auto* save_format = runtime.get_save_format(save_format_id);
+    if (!save_format) {
+      TACTILE_CORE_ERROR("Could not find save format for autosaved map");
+      continue;
+    }
+
+    TACTILE_CORE_INFO("Recovering autosaved map from {}", entry.checkpoint_file());
+
+    const SaveFormatReadOptions read_options {
+      .base_dir = autosave_dir,
+      .strict_mode = false,
+      .compression_dictionary = ByteSpan {},
+    };
+
+    auto ir_map = save_format->load_map(autosave_dir / entry.checkpoint_file(), read_options);
+    if (!ir_map.has_value()) {
+      TACTILE_CORE_ERROR("Could not load autosave checkpoint: {}", to_string(ir_map.error()));
+      continue;
+    }
+
+    // A missing journal just means that no edits were made after the checkpoint.
+    if (const auto journal = read_journal(autosave_dir / entry.journal_file());
+        journal.has_value()) {
+      if (const auto apply_result = apply_journal(*journal, *ir_map);
+          !apply_result.has_value()) {
+        TACTILE_CORE_WARN("Autosave journal doesn't match checkpoint, some edits may be lost");
+      }
+    }
+
+    const auto document_uuid =
+        document_manager.create_and_open_map(*runtime.get_renderer(), std::move(*ir_map));
+    if (!document_uuid.has_value()) {
+      TACTILE_CORE_ERROR("Could not restore autosaved map: {}",
+                         to_string(document_uuid.error()));
+      continue;
+    }
+
+    auto& document = document_manager.get_document(*document_uuid);
+    document.set_format(save_format_id);
+
+    // The restored edits are only stored in the autosave data until the map is saved.
+    document_manager.get_history(*document_uuid).mark_as_dirty();
+
+    if (!entry.document_path().empty()) {
+      document.set_path(entry.document_path());
+    }
+
+    recovered_documents.push_back(*document_uuid);
+  }
+
+  return recovered_documents;
+}
+
+}  // namespace tactile::core
@@ -0,0 +1,133 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/background_file_writer.hpp"
+
+#include <fstream>       // ofstream
+#include <ios>           // ios
+#include <system_error>  // error_code
+#include <utility>       // move
+
+namespace tactile::core {
+namespace {
+
+[[nodiscard]]
+auto _write_bytes(const std::filesystem::path& path,
+                  const ByteStream& bytes,
+                  const std::ios::openmode mode) -> bool
+{
+  std::ofstream stream {path, std::ios::out | std::ios::binary | mode};
+  if (!stream.good()) {
+    return false;
+  }
+
+  stream.write(reinterpret_cast<const char*>(bytes.data()),
+               static_cast<std::streamsize>(bytes.size()));
+  stream.flush();
+
+  return stream.good();
+}
+
+}  // namespace
+
+BackgroundFileWriter::BackgroundFileWriter()
+  : m_thread {[this](const std::stop_token& stop_token) { _run(stop_token); }}
+{}
+
+BackgroundFileWriter::~BackgroundFileWriter() noexcept = default;
+
+void BackgroundFileWriter::write(std::filesystem::path path, ByteStream bytes)
+{
+  _submit(Job {.type = JobType::kWrite, .path = std::move(path), .bytes = std::move(bytes)});
+}
+
+void BackgroundFileWriter::append(std::filesystem::path path, ByteStream bytes)
+{
+  _submit(Job {.type = JobType::kAppend, .path = std::move(path), .bytes = std::move(bytes)});
+}
+
+void BackgroundFileWriter::remove(std::filesystem::path path)
+{
+  _submit(Job {.type = JobType::kRemove, .path = std::move(path), .bytes = {}});
+}
+
+void BackgroundFileWriter::wait()
+{
+  std::unique_lock lock {m_mutex};
+  m_idle_cond.wait(lock, [this] { return m_jobs.empty() && !m_busy; });
+}
+
+auto BackgroundFileWriter::take_failure_count() noexcept -> std::size_t
+{
+  return m_failure_count.exchange(0, std::memory_order_relaxed);
+}
+
+void BackgroundFileWriter::_submit(Job job)
+{
+  {
+    const std::scoped_lock lock {m_mutex};
+    m_jobs.push_back(std::move(job));
+  }
+
+  m_job_cond.notify_one();
+}
+
+void BackgroundFileWriter::_run(const std::stop_token& stop_token)
+{
+  while (true) {
+    Job job {};
+
+    {
+      std::unique_lock lock {m_mutex};
+
+      // Remaining jobs are still executed after a stop has been requested.
+      if (!m_job_cond.wait(lock, stop_token, [this] { return !m_jobs.empty(); })) {
+        return;
+      }
+
+      job = std::move(m_jobs.front());
+      m_jobs.pop_front();
+      m_busy = true;
+    }
+
+    if (!_execute(job)) {
+      m_failure_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+      const std::scoped_lock lock {m_mutex};
+      m_busy = false;
+    }
+
+    m_idle_cond.notify_all();
+  }
+}
+
+auto BackgroundFileWriter::_execute(const Job& job) -> bool
+{
+  std::error_code error_code {};
+
+  switch (job.type) {
+    case JobType::kWrite: {
+      auto tmp_path = job.path;
+      tmp_path += ".tmp";
+
+      if (!_write_bytes(tmp_path, job.bytes, std::ios::trunc)) {
+        return false;
+      }
+
+      std::filesystem::rename(tmp_path, job.path, error_code);
+      return !error_code;
+    }
+    case JobType::kAppend: {
+      return _write_bytes(job.path, job.bytes, std::ios::app);
+    }
+    case JobType::kRemove: {
+      std::filesystem::remove(job.path, error_code);
+      return !error_code;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace tactile::core
@@ -0,0 +1,277 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/tile_dictionary.hpp"
+
+#include <algorithm>     // min
+#include <cstddef>       // size_t
+#include <fstream>       // ofstream
+#include <ios>           // ios, streamsize
+#include <optional>      // optional, nullopt
+#include <string_view>   // string_view
+#include <system_error>  // error_code
+#include <vector>        // vector
+
+#include "tactile/base/document/document_visitor.hpp"
+#include "tactile/base/document/layer_view.hpp"
+#include "tactile/base/document/map_view.hpp"
+#include "tactile/base/document/meta_view.hpp"
+#include "tactile/base/io/compress/compression_format.hpp"
+#include "tactile/base/io/file_io.hpp"
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/meta/attribute.hpp"
+#include "tactile/core/logging.hpp"
+
+namespace tactile::core {
+namespace {
+
+// Tile layers are split into smaller samples, since dictionary trainers need
+// many samples and maps usually only contain a handful of layers.
+inline constexpr std::size_t kTileDictionarySampleSize = std::size_t {4} << 10U;
+
+/**
+ * Collects the tile data of all tile layers in a map.
+ */
+class TileSampleCollector final : public IDocumentVisitor
+{
+ public:
+  auto visit(const IComponentView&) -> std::expected<void, ErrorCode> override
+  {
+    return {};
+  }
+
+  auto visit(const IMapView&) -> std::expected<void, ErrorCode> override
+  {
+    return {};
+  }
+
+  auto visit(const ILayerView& layer) -> std::expected<void, ErrorCode> override
+  {
+    if (layer.get_type() == LayerType::kTileLayer) {
+      m_tile_bytes.clear();
+      layer.write_tile_bytes(m_tile_bytes);
+      m_tile_data.insert(m_tile_data.end(), m_tile_bytes.begin(), m_tile_bytes.end());
+    }
+
+    return {};
+  }
+
+  auto visit(const IObjectView&) -> std::expected<void, ErrorCode> override
+  {
+    return {};
+  }
+
+  auto visit(const ITilesetView&) -> std::expected<void, ErrorCode> override
+  {
+    return {};
+  }
+
+  auto visit(const ITileView&) -> std::expected<void, ErrorCode> override
+  {
+    return {};
+  }
+
+  [[nodiscard]]
+  auto get_samples() const -> std::vector<ByteSpan>
+  {
+    std::vector<ByteSpan> samples {};
+    samples.reserve(m_tile_data.size() / kTileDictionarySampleSize + 1);
+
+    const ByteSpan tile_data {m_tile_data};
+    std::size_t offset = 0;
+
+    while (offset < tile_data.size()) {
+      const auto sample_size = std::min(kTileDictionarySampleSize, tile_data.size() - offset);
+      samples.push_back(tile_data.subspan(offset, sample_size));
+      offset += sample_size;
+    }
+
+    return samples;
+  }
+
+ private:
+  ByteStream m_tile_data {};
+  ByteStream m_tile_bytes {};
+};
+
+[[nodiscard]]
+auto _is_tile_dictionary_enabled(const std::string_view name, const Attribute& value)
+    -> std::optional<bool>
+{
+  if (name != kTileDictionaryProperty) {
+    return std::nullopt;
+  }
+
+  if (value.get_type() != AttributeType::kBool) {
+    TACTILE_CORE_WARN("Ignoring invalid '{}' map property", kTileDictionaryProperty);
+    return false;
+  }
+
+  return value.as_bool();
+}
+
+}  // namespace
+
+auto get_tile_dictionary_path(const std::filesystem::path& map_path) -> std::filesystem::path
+{
+  auto dictionary_path = map_path;
+  dictionary_path += ".dict";
+  return dictionary_path;
+}
+
+auto uses_tile_dictionary(const IMetaView& map_meta) -> bool
+{
+  const auto property_count = map_meta.property_count();
+
+  for (std::size_t index = 0; index < property_count; ++index) {
+    const auto& [name, value] = map_meta.get_property(index);
+    if (const auto is_enabled = _is_tile_dictionary_enabled(name, value)) {
+      return *is_enabled;
+    }
+  }
+
+  return false;
+}
+
+auto uses_tile_dictionary(const ir::Metadata& map_meta) -> bool
+{
+  for (const auto& property : map_meta.properties) {
+    if (const auto is_enabled = _is_tile_dictionary_enabled(property.name, property.value)) {
+      return *is_enabled;
+    }
+  }
+
+  return false;
+}
+
+auto load_tile_dictionary(const std::filesystem::path& dictionary_path)
+    -> std::expected<ByteStream, ErrorCode>
+{
+  const auto dictionary = read_binary_file(dictionary_path);
+  if (!dictionary.has_value()) {
+    TACTILE_CORE_ERROR("Could not read tile dictionary {}", dictionary_path.string());
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  TACTILE_CORE_DEBUG("Loaded tile dictionary {}", dictionary_path.string());
+  return ByteStream {dictionary->begin(), dictionary->end()};
+}
+
+auto load_tile_dictionary_for_reading(const std::filesystem::path& map_path) -> ByteStream
+{
+  const auto dictionary_path = get_tile_dictionary_path(map_path);
+
+  std::error_code error_code {};
+  if (!std::filesystem::exists(dictionary_path, error_code)) {
+    return ByteStream {};
+  }
+
+  // Compressed tile data records the ID of the dictionary it requires, so
+  // passing a dictionary that isn't needed is harmless.
+  return load_tile_dictionary(dictionary_path).value_or(ByteStream {});
+}
+
+auto validate_tile_dictionary(const std::filesystem::path& map_path, const ir::Map& ir_map)
+    -> std::expected<void, ErrorCode>
+{
+  if (!uses_tile_dictionary(ir_map.meta)) {
+    return {};
+  }
+
+  const auto dictionary_path = get_tile_dictionary_path(map_path);
+
+  std::error_code error_code {};
+  if (!std::filesystem::exists(dictionary_path, error_code)) {
+    TACTILE_CORE_ERROR("Map {} requires tile dictionary {}, which could not be found",
+                       map_path.string(),
+                       dictionary_path.string());
+    return std::unexpected {ErrorCode::kNoSuchFile};
+  }
+
+  return {};
+}
+
+auto load_tile_dictionary_for_writing(const std::filesystem::path& map_path,
+                                      const IMapView& map)
+    -> std::expected<ByteStream, ErrorCode>
+{
+  if (!uses_tile_dictionary(map.get_meta())) {
+    return ByteStream {};
+  }
+
+  return load_tile_dictionary(get_tile_dictionary_path(map_path));
+}
+
+auto copy_tile_dictionary(const std::filesystem::path& old_map_path,
+                          const std::filesystem::path& new_map_path)
+    -> std::expected<void, ErrorCode>
+{
+  const auto old_dictionary_path = get_tile_dictionary_path(old_map_path);
+  const auto new_dictionary_path = get_tile_dictionary_path(new_map_path);
+
+  std::error_code error_code {};
+  if (std::filesystem::equivalent(old_dictionary_path, new_dictionary_path, error_code)) {
+    return {};
+  }
+
+  error_code.clear();
+  std::filesystem::copy_file(old_dictionary_path,
+                             new_dictionary_path,
+                             std::filesystem::copy_options::overwrite_existing,
+                             error_code);
+
+  if (error_code) {
+    TACTILE_CORE_ERROR("Could not copy tile dictionary {} to {}: {}",
+                       old_dictionary_path.string(),
+                       new_dictionary_path.string(),
+                       error_code.message());
+    return std::unexpected {ErrorCode::kBadFileCopy};
+  }
+
+  return {};
+}
+
+auto train_tile_dictionary(const ICompressionFormat& compression_format,
+                           const IMapView& map,
+                           const std::filesystem::path& map_path)
+    -> std::expected<void, ErrorCode>
+{
+  if (uses_tile_dictionary(map.get_meta())) {
+    TACTILE_CORE_ERROR("Map {} already uses a tile dictionary", map_path.string());
+    return std::unexpected {ErrorCode::kBadOperation};
+  }
+
+  const auto dictionary_path = get_tile_dictionary_path(map_path);
+
+  std::error_code error_code {};
+  if (std::filesystem::exists(dictionary_path, error_code)) {
+    TACTILE_CORE_ERROR("Tile dictionary {} already exists", dictionary_path.string());
+    return std::unexpected {ErrorCode::kBadOperation};
+  }
+
+  TileSampleCollector collector {};
+  if (const auto accept_result = map.accept(collector); !accept_result.has_value()) {
+    return std::unexpected {accept_result.error()};
+  }
+
+  const auto samples = collector.get_samples();
+  const auto dictionary = compression_format.train_dictionary(samples, kMaxTileDictionarySize);
+  if (!dictionary.has_value()) {
+    return std::unexpected {dictionary.error()};
+  }
+
+  std::ofstream stream {dictionary_path, std::ios::out | std::ios::binary | std::ios::trunc};
+  stream.write(reinterpret_cast<const char*>(dictionary->data()),
+               static_cast<std::streamsize>(dictionary->size()));
+
+  if (!stream.good()) {
+    TACTILE_CORE_ERROR("Could not write tile dictionary {}", dictionary_path.string());
+    return std::unexpected {ErrorCode::kWriteError};
+  }
+
+  TACTILE_CORE_INFO("Saved tile dictionary {} ({} bytes)",
+                    dictionary_path.string(),
+                    dictionary->size());
+  return {};
+}
+
+}  // namespace tactile::core
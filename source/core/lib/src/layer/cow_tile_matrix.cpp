@@ -0,0 +1,122 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/layer/cow_tile_matrix.hpp"
+
+#include <utility>  // move
+
+#include "tactile/core/debug/assert.hpp"
+
+namespace tactile::core {
+namespace {
+
+void _append_empty_rows(std::vector<std::shared_ptr<TileRow>>& rows,
+                        const std::size_t row_count,
+                        const Extent2D::value_type col_count)
+{
+  if (row_count == 0) {
+    return;
+  }
+
+  // All new rows share a single buffer of empty tiles until they are modified.
+  const auto empty_row = std::make_shared<TileRow>(col_count, kEmptyTile);
+
+  rows.reserve(rows.size() + row_count);
+  for (std::size_t index = 0; index < row_count; ++index) {
+    rows.push_back(empty_row);
+  }
+}
+
+}  // namespace
+
+CowTileMatrix::CowTileMatrix(const Extent2D& extent)
+  : m_col_count {extent.cols}
+{
+  _append_empty_rows(m_rows, extent.rows, extent.cols);
+}
+
+CowTileMatrix::CowTileMatrix(TileMatrix matrix)
+  : m_col_count {matrix.empty() ? Extent2D::value_type {0} : matrix.front().size()}
+{
+  m_rows.reserve(matrix.size());
+
+  for (auto& row : matrix) {
+    TACTILE_ASSERT(row.size() == m_col_count);
+    m_rows.push_back(std::make_shared<TileRow>(std::move(row)));
+  }
+}
+
+void CowTileMatrix::resize(const Extent2D& extent)
+{
+  if (extent.rows < m_rows.size()) {
+    m_rows.resize(extent.rows);
+  }
+
+  if (extent.cols != m_col_count) {
+    for (std::size_t row = 0, row_count = m_rows.size(); row < row_count; ++row) {
+      mutable_row(row).resize(extent.cols, kEmptyTile);
+    }
+
+    m_col_count = extent.cols;
+  }
+
+  if (extent.rows > m_rows.size()) {
+    _append_empty_rows(m_rows, extent.rows - m_rows.size(), m_col_count);
+  }
+}
+
+void CowTileMatrix::set(const Index2D& index, const TileID tile_id)
+{
+  TACTILE_ASSERT(index.x < m_col_count);
+
+  auto& row = mutable_row(index.y);
+  row[index.x] = tile_id;
+}
+
+auto CowTileMatrix::get(const Index2D& index) const -> TileID
+{
+  TACTILE_ASSERT(index.x < m_col_count);
+  return (*this)[index.y][index.x];
+}
+
+auto CowTileMatrix::mutable_row(const std::size_t row) -> TileRow&
+{
+  TACTILE_ASSERT(row < m_rows.size());
+  auto& row_ptr = m_rows[row];
+
+  if (row_ptr.use_count() > 1) {
+    row_ptr = std::make_shared<TileRow>(*row_ptr);
+  }
+
+  return *row_ptr;
+}
+
+auto CowTileMatrix::operator[](const std::size_t row) const -> const TileRow&
+{
+  TACTILE_ASSERT(row < m_rows.size());
+  return *m_rows[row];
+}
+
+auto CowTileMatrix::to_tile_matrix() const -> TileMatrix
+{
+  TileMatrix matrix {};
+  matrix.reserve(m_rows.size());
+
+  for (const auto& row_ptr : m_rows) {
+    matrix.push_back(*row_ptr);
+  }
+
+  return matrix;
+}
+
+auto CowTileMatrix::shares_row(const CowTileMatrix& other, const std::size_t row) const
+    -> bool
+{
+  return m_rows.at(row) == other.m_rows.at(row);
+}
+
+auto CowTileMatrix::get_extent() const noexcept -> Extent2D
+{
+  return Extent2D {.rows = m_rows.size(), .cols = m_col_count};
+}
+
+}  // namespace tactile::core
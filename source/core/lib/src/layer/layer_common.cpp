@@ -3,6 +3,8 @@
 #include "tactile/core/layer/layer_common.hpp"
 
 #include <stdexcept>  // runtime_error, invalid_argument
+#include <utility>    // move
+#include <vector>     // vector
 
 #include "tactile/base/io/save/ir.hpp"
 #include "tactile/core/debug/assert.hpp"
@@ -17,44 +19,45 @@
 namespace tactile::core {
 
 auto make_layer(Registry& registry, const ir::Layer& ir_layer) -> EntityID
+{
+  return make_layer(registry, ir::Layer {ir_layer});
+}
+
+auto make_layer(Registry& registry, ir::Layer&& ir_layer) -> EntityID
 {
   EntityID layer_id {kInvalidEntity};
 
   switch (ir_layer.type) {
     case LayerType::kTileLayer: {
-      layer_id = make_tile_layer(registry, ir_layer.extent);
-
-      for (Extent2D::value_type row = 0; row < ir_layer.extent.rows; ++row) {
-        for (Extent2D::value_type col = 0; col < ir_layer.extent.cols; ++col) {
-          const auto tile_id = ir_layer.tiles[row][col];
-          set_layer_tile(registry, layer_id, Index2D {.x = col, .y = row}, tile_id);
-        }
-      }
-
+      layer_id = make_tile_layer(registry, ir_layer.extent, std::move(ir_layer.tiles));
       break;
     }
     case LayerType::kObjectLayer: {
       layer_id = make_object_layer(registry);
 
-      auto& object_layer = registry.get<CObjectLayer>(layer_id);
-      object_layer.objects.reserve(ir_layer.objects.size());
+      // Note, the object vector reference must be obtained after the objects are created,
+      // since creating entities might invalidate component references.
+      std::vector<EntityID> objects {};
+      objects.reserve(ir_layer.objects.size());
 
-      for (const auto& ir_object : ir_layer.objects) {
-        object_layer.objects.push_back(make_object(registry, ir_object));
+      for (auto& ir_object : ir_layer.objects) {
+        objects.push_back(make_object(registry, std::move(ir_object)));
       }
 
+      registry.get<CObjectLayer>(layer_id).objects = std::move(objects);
       break;
     }
     case LayerType::kGroupLayer: {
       layer_id = make_group_layer(registry);
 
-      auto& group_layer = registry.get<CGroupLayer>(layer_id);
-      group_layer.layers.reserve(ir_layer.layers.size());
+      std::vector<EntityID> sublayers {};
+      sublayers.reserve(ir_layer.layers.size());
 
-      for (const auto& ir_sublayer : ir_layer.layers) {
-        group_layer.layers.push_back(make_layer(registry, ir_sublayer));
+      for (auto& ir_sublayer : ir_layer.layers) {
+        sublayers.push_back(make_layer(registry, std::move(ir_sublayer)));
       }
 
+      registry.get<CGroupLayer>(layer_id).layers = std::move(sublayers);
       break;
     }
     default: throw std::runtime_error {"invalid layer type"};
@@ -65,7 +68,7 @@ auto make_layer(Registry& registry, const ir::Layer& ir_layer) -> EntityID
   layer.opacity = ir_layer.opacity;
   layer.visible = ir_layer.visible;
 
-  convert_ir_metadata(registry, layer_id, ir_layer.meta);
+  convert_ir_metadata(registry, layer_id, std::move(ir_layer.meta));
 
   TACTILE_ASSERT(is_layer(registry, layer_id));
   return layer_id;
@@ -2,6 +2,8 @@
 
 #include "tactile/core/layer/object.hpp"
 
+#include <utility>  // move
+
 #include "tactile/base/io/save/ir.hpp"
 #include "tactile/core/debug/assert.hpp"
 #include "tactile/core/entity/registry.hpp"
@@ -33,16 +35,21 @@ auto make_object(Registry& registry, const ObjectID id, const ObjectType type) -
 }
 
 auto make_object(Registry& registry, const ir::Object& ir_object) -> EntityID
+{
+  return make_object(registry, ir::Object {ir_object});
+}
+
+auto make_object(Registry& registry, ir::Object&& ir_object) -> EntityID
 {
   const auto object_entity = make_object(registry, ir_object.id, ir_object.type);
 
   auto& object = registry.get<CObject>(object_entity);
   object.position = ir_object.position;
   object.size = ir_object.size;
-  object.tag = ir_object.tag;
+  object.tag = std::move(ir_object.tag);
   object.is_visible = ir_object.visible;
 
-  convert_ir_metadata(registry, object_entity, ir_object.meta);
+  convert_ir_metadata(registry, object_entity, std::move(ir_object.meta));
 
   TACTILE_ASSERT(is_object(registry, object_entity));
   return object_entity;
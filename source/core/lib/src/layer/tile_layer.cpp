@@ -2,121 +2,101 @@
 
 #include "tactile/core/layer/tile_layer.hpp"
 
-#include <stdexcept>  // runtime_error
-#include <utility>    // move
+#include <algorithm>   // count, sort
+#include <functional>  // less
+#include <stdexcept>   // runtime_error
+#include <utility>     // move, pair
+#include <vector>      // vector
 
 #include "tactile/base/io/tile_io.hpp"
 #include "tactile/base/numeric/saturate_cast.hpp"
 #include "tactile/base/platform/bits.hpp"
-#include "tactile/base/util/tile_matrix.hpp"
 #include "tactile/core/layer/layer.hpp"
 #include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/logging.hpp"
 #include "tactile/core/meta/meta.hpp"
 
 namespace tactile::core {
 namespace {
 
-void _add_n_rows(TileMatrix& matrix,
-                 const std::size_t n,
-                 const Extent2D::value_type column_count)
+void _resize(SparseTileMatrix& matrix, const Extent2D& extent)
 {
-  matrix.reserve(matrix.size() + n);
-
-  for (std::size_t i = 0; i < n; ++i) {
-    matrix.emplace_back(column_count, kEmptyTile);
-  }
+  std::erase_if(matrix, [&](const auto& position_and_tile) {
+    return !extent.contains(position_and_tile.first);
+  });
 }
 
-void _remove_n_rows(TileMatrix& matrix, const std::size_t n)
+void _set_tile_unchecked(SparseTileMatrix& matrix, const Index2D& index, const TileID tile_id)
 {
-  for (std::size_t i = 0; i < n; ++i) {
-    TACTILE_ASSERT(!matrix.empty());
-    matrix.pop_back();
+  if (tile_id == kEmptyTile) {
+    matrix.erase(index);
+  }
+  else {
+    matrix.insert_or_assign(index, tile_id);
   }
 }
 
-void _add_n_columns(TileMatrix& matrix, const std::size_t n)
+[[nodiscard]]
+auto _get_tile_unchecked(const SparseTileMatrix& matrix, const Index2D& index) -> TileID
 {
-  for (auto& row : matrix) {
-    row.reserve(row.size() + n);
-
-    for (std::size_t i = 0; i < n; ++i) {
-      row.push_back(kEmptyTile);
-    }
-  }
+  const auto iter = matrix.find(index);
+  return iter != matrix.end() ? iter->second : kEmptyTile;
 }
 
-void _remove_n_columns(TileMatrix& matrix, const std::size_t n)
+// Layers with fewer non-empty tiles than this fraction of the extent are stored as sparse
+// layers. Sparse tiles use several times more memory each, but empty tiles are free.
+inline constexpr std::size_t kSparseOccupancyDivisor = 16;
+
+void _fit_tile_matrix(TileMatrix& matrix, const Extent2D& extent)
 {
+  if (matrix.size() != extent.rows) {
+    TACTILE_CORE_WARN("Tile matrix has {} rows, expected {}", matrix.size(), extent.rows);
+    matrix.resize(extent.rows);
+  }
+
   for (auto& row : matrix) {
-    for (std::size_t i = 0; i < n; ++i) {
-      TACTILE_ASSERT(!row.empty());
-      row.pop_back();
+    if (row.size() != extent.cols) {
+      row.resize(extent.cols, kEmptyTile);
     }
   }
 }
 
-void _resize(TileMatrix& matrix, const Extent2D& extent)
+[[nodiscard]]
+auto _count_non_empty_tiles(const TileMatrix& matrix) -> std::size_t
 {
-  const auto old_height = matrix.size();
-  const auto old_width = old_height > 0 ? matrix.at(0).size() : std::size_t {0};
-
-  if (old_width != extent.cols) {
-    if (old_width > extent.cols) {
-      _remove_n_columns(matrix, old_width - extent.cols);
-    }
-    else {
-      _add_n_columns(matrix, extent.cols - old_width);
-    }
-  }
+  std::size_t count = 0;
 
-  if (old_height != extent.rows) {
-    if (old_height > extent.rows) {
-      _remove_n_rows(matrix, old_height - extent.rows);
-    }
-    else {
-      _add_n_rows(matrix, extent.rows - old_height, extent.cols);
-    }
+  for (const auto& row : matrix) {
+    count += row.size() - static_cast<std::size_t>(std::ranges::count(row, kEmptyTile));
   }
-}
 
-void _resize(SparseTileMatrix& matrix, const Extent2D& extent)
-{
-  std::erase_if(matrix, [&](const auto& position_and_tile) {
-    return !extent.contains(position_and_tile.first);
-  });
+  return count;
 }
 
-void _set_tile_unchecked(TileMatrix& matrix, const Index2D& index, const TileID tile_id)
+[[nodiscard]]
+auto _make_sparse_tile_matrix(const TileMatrix& matrix, const std::size_t tile_count)
+    -> SparseTileMatrix
 {
-  TACTILE_ASSERT(index.y < matrix.size());
-  TACTILE_ASSERT(index.x < matrix.at(0).size());
-  matrix[index.y][index.x] = tile_id;
-}
+  std::vector<std::pair<Index2D, TileID>> tiles {};
+  tiles.reserve(tile_count);
 
-void _set_tile_unchecked(SparseTileMatrix& matrix, const Index2D& index, const TileID tile_id)
-{
-  if (tile_id == kEmptyTile) {
-    matrix.erase(index);
-  }
-  else {
-    matrix.insert_or_assign(index, tile_id);
+  for (std::size_t row = 0, row_count = matrix.size(); row < row_count; ++row) {
+    for (std::size_t col = 0, col_count = matrix[row].size(); col < col_count; ++col) {
+      if (const auto tile_id = matrix[row][col]; tile_id != kEmptyTile) {
+        tiles.emplace_back(Index2D {.x = col, .y = row}, tile_id);
+      }
+    }
   }
-}
 
-[[nodiscard]]
-auto _get_tile_unchecked(const TileMatrix& matrix, const Index2D& index) noexcept -> TileID
-{
-  TACTILE_ASSERT(index.y < matrix.size());
-  TACTILE_ASSERT(index.x < matrix.at(0).size());
-  return matrix[index.y][index.x];
-}
+  // Inserting sorted elements at the end of the map takes amortized constant time.
+  std::ranges::sort(tiles, std::less {}, &std::pair<Index2D, TileID>::first);
 
-[[nodiscard]]
-auto _get_tile_unchecked(const SparseTileMatrix& matrix, const Index2D& index) -> TileID
-{
-  const auto iter = matrix.find(index);
-  return iter != matrix.end() ? iter->second : kEmptyTile;
+  SparseTileMatrix sparse_matrix {};
+  for (const auto& [index, tile_id] : tiles) {
+    sparse_matrix.emplace_hint(sparse_matrix.end(), index, tile_id);
+  }
+
+  return sparse_matrix;
 }
 
 }  // namespace
@@ -136,7 +116,31 @@ auto make_tile_layer(Registry& registry, const Extent2D& extent) -> EntityID
   registry.add<CTileLayer>(layer_entity, extent);
 
   auto& dense = registry.add<CDenseTileLayer>(layer_entity);
-  dense.tiles = make_tile_matrix(extent);
+  dense.tiles = CowTileMatrix {extent};
+
+  TACTILE_ASSERT(is_tile_layer(registry, layer_entity));
+  return layer_entity;
+}
+
+auto make_tile_layer(Registry& registry, const Extent2D& extent, TileMatrix tiles)
+    -> EntityID
+{
+  _fit_tile_matrix(tiles, extent);
+
+  const auto tile_count = _count_non_empty_tiles(tiles);
+  const auto cell_count = extent.rows * extent.cols;
+
+  const auto layer_entity = make_unspecialized_layer(registry);
+  registry.add<CTileLayer>(layer_entity, extent);
+
+  if (tile_count * kSparseOccupancyDivisor < cell_count) {
+    auto& sparse = registry.add<CSparseTileLayer>(layer_entity);
+    sparse.tiles = _make_sparse_tile_matrix(tiles, tile_count);
+  }
+  else {
+    auto& dense = registry.add<CDenseTileLayer>(layer_entity);
+    dense.tiles = CowTileMatrix {std::move(tiles)};
+  }
 
   TACTILE_ASSERT(is_tile_layer(registry, layer_entity));
   return layer_entity;
@@ -153,12 +157,12 @@ void convert_to_dense_tile_layer(Registry& registry, const EntityID layer_entity
   TACTILE_ASSERT(is_tile_layer(registry, layer_entity));
   const auto& tile_layer = registry.get<CTileLayer>(layer_entity);
 
-  if (registry.has<CSparseTileLayer>(layer_entity)) {
-    auto tile_matrix = make_tile_matrix(tile_layer.extent);
+  if (const auto* sparse = registry.find<CSparseTileLayer>(layer_entity)) {
+    CowTileMatrix tile_matrix {tile_layer.extent};
 
-    each_layer_tile(registry, layer_entity, [&](const Index2D& index, const TileID tile_id) {
-      tile_matrix[index.y][index.x] = tile_id;
-    });
+    for (const auto& [index, tile_id] : sparse->tiles) {
+      tile_matrix.set(index, tile_id);
+    }
 
     auto& dense = registry.add<CDenseTileLayer>(layer_entity);
     dense.tiles = std::move(tile_matrix);
@@ -194,9 +198,10 @@ void resize_tile_layer(Registry& registry, const EntityID layer_entity, const Ex
 
   auto& tile_layer = registry.get<CTileLayer>(layer_entity);
   tile_layer.extent = extent;
+  ++tile_layer.revision;
 
   if (auto* dense = registry.find<CDenseTileLayer>(layer_entity)) {
-    _resize(dense->tiles, extent);
+    dense->tiles.resize(extent);
   }
   else if (auto* sparse = registry.find<CSparseTileLayer>(layer_entity)) {
     _resize(sparse->tiles, extent);
@@ -229,13 +234,15 @@ void set_layer_tile(Registry& registry,
 {
   TACTILE_ASSERT(is_tile_layer(registry, layer_entity));
 
-  if (const auto& tile_layer = registry.get<CTileLayer>(layer_entity);
-      !tile_layer.extent.contains(index)) {
+  auto& tile_layer = registry.get<CTileLayer>(layer_entity);
+  if (!tile_layer.extent.contains(index)) {
     return;
   }
 
+  ++tile_layer.revision;
+
   if (auto* dense = registry.find<CDenseTileLayer>(layer_entity)) {
-    _set_tile_unchecked(dense->tiles, index, tile_id);
+    dense->tiles.set(index, tile_id);
   }
   else if (auto* sparse = registry.find<CSparseTileLayer>(layer_entity)) {
     _set_tile_unchecked(sparse->tiles, index, tile_id);
@@ -257,7 +264,7 @@ auto get_layer_tile(const Registry& registry,
   }
 
   if (const auto* dense = registry.find<CDenseTileLayer>(layer_entity)) {
-    return _get_tile_unchecked(dense->tiles, index);
+    return dense->tiles.get(index);
   }
 
   if (const auto* sparse = registry.find<CSparseTileLayer>(layer_entity)) {
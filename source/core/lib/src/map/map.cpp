@@ -2,23 +2,81 @@
 
 #include "tactile/core/map/map.hpp"
 
+#include <cstddef>  // size_t
+#include <utility>  // move
+#include <vector>   // vector
+
 #include "tactile/base/io/save/ir.hpp"
 #include "tactile/base/numeric/saturate_cast.hpp"
 #include "tactile/core/debug/assert.hpp"
+#include "tactile/core/debug/profiler.hpp"
 #include "tactile/core/entity/registry.hpp"
 #include "tactile/core/layer/group_layer.hpp"
 #include "tactile/core/layer/layer.hpp"
 #include "tactile/core/layer/layer_common.hpp"
+#include "tactile/core/layer/layer_types.hpp"
 #include "tactile/core/layer/object_layer.hpp"
 #include "tactile/core/layer/tile_layer.hpp"
 #include "tactile/core/logging.hpp"
 #include "tactile/core/map/map_spec.hpp"
 #include "tactile/core/meta/meta.hpp"
+#include "tactile/core/tile/tile_types.hpp"
 #include "tactile/core/tile/tileset.hpp"
 #include "tactile/core/tile/tileset_types.hpp"
 #include "tactile/core/ui/viewport.hpp"
 
 namespace tactile::core {
+namespace {
+
+struct IrEntityCounts final
+{
+  std::size_t tile_layers;
+  std::size_t object_layers;
+  std::size_t group_layers;
+  std::size_t objects;
+  std::size_t tiles;
+};
+
+void _count_ir_layer_entities(const std::vector<ir::Layer>& ir_layers, IrEntityCounts& counts)
+{
+  for (const auto& ir_layer : ir_layers) {
+    switch (ir_layer.type) {
+      case LayerType::kTileLayer:   ++counts.tile_layers; break;
+      case LayerType::kObjectLayer: ++counts.object_layers; break;
+      case LayerType::kGroupLayer:  ++counts.group_layers; break;
+    }
+
+    counts.objects += ir_layer.objects.size();
+    _count_ir_layer_entities(ir_layer.layers, counts);
+  }
+}
+
+// Reserves component storage for all entities that will be created from the IR map, so that
+// loading maps with many layers and objects doesn't repeatedly grow the storage.
+void _reserve_component_storage(Registry& registry, const ir::Map& ir_map)
+{
+  IrEntityCounts counts {};
+  counts.group_layers = 1;  // The root layer.
+
+  _count_ir_layer_entities(ir_map.layers, counts);
+
+  for (const auto& ir_tileset_ref : ir_map.tilesets) {
+    counts.tiles += saturate_cast<std::size_t>(ir_tileset_ref.tileset.tile_count);
+  }
+
+  const auto layer_count = counts.tile_layers + counts.object_layers + counts.group_layers;
+  const auto meta_count = layer_count + counts.objects + counts.tiles;
+
+  registry.reserve<CMeta>(registry.count<CMeta>() + meta_count);
+  registry.reserve<CLayer>(registry.count<CLayer>() + layer_count);
+  registry.reserve<CTileLayer>(registry.count<CTileLayer>() + counts.tile_layers);
+  registry.reserve<CObjectLayer>(registry.count<CObjectLayer>() + counts.object_layers);
+  registry.reserve<CGroupLayer>(registry.count<CGroupLayer>() + counts.group_layers);
+  registry.reserve<CObject>(registry.count<CObject>() + counts.objects);
+  registry.reserve<CTile>(registry.count<CTile>() + counts.tiles);
+}
+
+}  // namespace
 
 auto is_map(const Registry& registry, const EntityID entity) -> bool
 {
@@ -76,10 +134,20 @@ auto make_map(Registry& registry, const MapSpec& spec) -> EntityID
 auto make_map(Registry& registry, IRenderer& renderer, const ir::Map& ir_map)
     -> std::expected<EntityID, ErrorCode>
 {
+  return make_map(registry, renderer, ir::Map {ir_map});
+}
+
+auto make_map(Registry& registry, IRenderer& renderer, ir::Map&& ir_map)
+    -> std::expected<EntityID, ErrorCode>
+{
+  TACTILE_PROFILE_SCOPE("make_map");
+
+  _reserve_component_storage(registry, ir_map);
+
   const auto map_id = registry.make_entity();
 
   registry.add<CMeta>(map_id);
-  convert_ir_metadata(registry, map_id, ir_map.meta);
+  convert_ir_metadata(registry, map_id, std::move(ir_map.meta));
 
   auto& map = registry.add<CMap>(map_id);
   map.orientation = TileOrientation::kOrthogonal;  // TODO
@@ -95,7 +163,7 @@ auto make_map(Registry& registry, IRenderer& renderer, const ir::Map& ir_map)
   format.comp_level = ir_map.tile_format.compression_level;
 
   auto& id_cache = registry.add<CMapIdCache>(map_id);
-  id_cache.next_tile_id = TileID {1};  // TODO
+  id_cache.next_tile_id = TileID {1};
   id_cache.next_object_id = ir_map.next_object_id;
   id_cache.next_layer_id = ir_map.next_layer_id;
 
@@ -111,6 +179,9 @@ auto make_map(Registry& registry, IRenderer& renderer, const ir::Map& ir_map)
 
   // TODO components
 
+  auto& tile_cache = registry.get<CTileCache>();
+  tile_cache.tile_ranges.reserve(tile_cache.tile_ranges.size() + ir_map.tilesets.size());
+
   map.attached_tilesets.reserve(ir_map.tilesets.size());
   for (const auto& ir_tileset_ref : ir_map.tilesets) {
     const auto tileset_id = make_tileset(registry, renderer, ir_tileset_ref);
@@ -122,13 +193,18 @@ auto make_map(Registry& registry, IRenderer& renderer, const ir::Map& ir_map)
     map.attached_tilesets.push_back(*tileset_id);
   }
 
-  auto& root_layer = registry.get<CGroupLayer>(map.root_layer);
-  root_layer.layers.reserve(ir_map.layers.size());
+  id_cache.next_tile_id = tile_cache.tile_ranges.get_end_id();
 
-  for (const auto& ir_layer : ir_map.layers) {
-    root_layer.layers.push_back(make_layer(registry, ir_layer));
+  std::vector<EntityID> root_layers {};
+  root_layers.reserve(ir_map.layers.size());
+
+  for (auto& ir_layer : ir_map.layers) {
+    root_layers.push_back(make_layer(registry, std::move(ir_layer)));
   }
 
+  auto& root_layer = registry.get<CGroupLayer>(map.root_layer);
+  root_layer.layers = std::move(root_layers);
+
   TACTILE_ASSERT(is_map(registry, map_id));
   return map_id;
 }
@@ -164,20 +240,32 @@ auto add_tileset_to_map(Registry& registry,
 
   auto& map = registry.get<CMap>(map_id);
   auto& id_cache = registry.get<CMapIdCache>(map_id);
+  const auto& tile_cache = registry.get<CTileCache>();
 
-  const auto tileset_id = make_tileset_instance(registry, tileset_spec, id_cache.next_tile_id);
-  if (!tileset_id.has_value()) {
-    return std::unexpected {tileset_id.error()};
+  const auto tileset_id = make_tileset(registry, tileset_spec);
+  if (tileset_id == kInvalidEntity) {
+    TACTILE_CORE_ERROR("Could not create tileset");
+    return std::unexpected {ErrorCode::kBadInit};
   }
 
-  const auto& tileset = registry.get<CTileset>(*tileset_id);
-  id_cache.next_tile_id += saturate_cast<TileID>(tileset.tiles.size());
+  // Reuse the smallest gap left behind by destroyed tilesets that fits the new tileset.
+  const auto& tileset = registry.get<CTileset>(tileset_id);
+  const auto tile_count = saturate_cast<std::int32_t>(tileset.tiles.size());
+  const auto first_tile_id = tile_cache.tile_ranges.find_best_fit(tile_count);
+
+  const auto init_instance_result = init_tileset_instance(registry, tileset_id, first_tile_id);
+  if (!init_instance_result.has_value()) {
+    destroy_tileset(registry, tileset_id);
+    return std::unexpected {init_instance_result.error()};
+  }
 
-  map.attached_tilesets.push_back(*tileset_id);
-  map.active_tileset = *tileset_id;
+  id_cache.next_tile_id = tile_cache.tile_ranges.get_end_id();
+
+  map.attached_tilesets.push_back(tileset_id);
+  map.active_tileset = tileset_id;
 
   TACTILE_CORE_DEBUG("Added tileset {} to map {}",
-                    entity_to_string(*tileset_id),
+                    entity_to_string(tileset_id),
                     entity_to_string(map_id));
   return tileset_id;
 }
@@ -193,8 +281,9 @@ void remove_tileset_from_map(Registry& registry,
                     entity_to_string(tileset_id),
                     entity_to_string(map_id));
 
-  // Note, the tile range used by the tileset is intentionally not returned to keep the logic
-  // as simple as possible. It also makes implementing tileset commands easier.
+  // Note, the tile range used by the tileset stays reserved until the tileset is destroyed,
+  // since the tileset might be added back to the map, e.g., when a command is undone. Once
+  // the tileset is destroyed, add_tileset_to_map is free to reuse the range.
 
   auto& map = registry.get<CMap>(map_id);
   std::erase(map.attached_tilesets, tileset_id);
@@ -219,6 +308,9 @@ auto add_layer_to_map(Registry& registry, const EntityID map_id, const LayerType
     default:                      return std::unexpected {ErrorCode::kBadParam};
   }
 
+  auto& id_cache = registry.get<CMapIdCache>(map_id);
+  registry.get<CLayer>(layer_entity).persistent_id = id_cache.next_layer_id++;
+
   append_layer_to_map(registry, map_id, layer_entity);
 
   return layer_entity;
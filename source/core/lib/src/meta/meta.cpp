@@ -2,6 +2,8 @@
 
 #include "tactile/core/meta/meta.hpp"
 
+#include <utility>  // move
+
 #include "tactile/base/io/save/ir.hpp"
 #include "tactile/core/debug/assert.hpp"
 #include "tactile/core/entity/registry.hpp"
@@ -16,14 +18,19 @@ auto is_meta(const Registry& registry, const EntityID id) -> bool
 void convert_ir_metadata(Registry& registry,
                          const EntityID meta_id,
                          const ir::Metadata& ir_metadata)
+{
+  convert_ir_metadata(registry, meta_id, ir::Metadata {ir_metadata});
+}
+
+void convert_ir_metadata(Registry& registry, const EntityID meta_id, ir::Metadata&& ir_metadata)
 {
   TACTILE_ASSERT(is_meta(registry, meta_id));
 
   auto& meta = registry.get<CMeta>(meta_id);
-  meta.name = ir_metadata.name;
+  meta.name = std::move(ir_metadata.name);
 
-  for (const auto& [prop_name, prop_value] : ir_metadata.properties) {
-    meta.properties.insert_or_assign(prop_name, prop_value);
+  for (auto& [prop_name, prop_value] : ir_metadata.properties) {
+    meta.properties.insert_or_assign(std::move(prop_name), std::move(prop_value));
   }
 
   for (const auto& [comp_name, comp_attributes] : ir_metadata.components) {
@@ -9,6 +9,7 @@ namespace {
 
 inline constexpr auto kLanguageDefault = ui::LanguageID::kAmericanEnglish;
 inline constexpr auto kCommandCapacityDefault = std::size_t {100};
+inline constexpr auto kAutosaveIntervalDefault = std::chrono::seconds {30};
 inline constexpr auto kFontDefault = ui::FontID::kDefault;
 inline constexpr auto kFontSizeDefault = 13.0f;
 inline constexpr auto kLogVerboseEventsDefault = false;
@@ -20,6 +21,7 @@ auto get_default_settings() -> Settings
   return Settings {
     .language = kLanguageDefault,
     .command_capacity = kCommandCapacityDefault,
+    .autosave_interval = kAutosaveIntervalDefault,
     .font = kFontDefault,
     .font_size = kFontSizeDefault,
     .log_verbose_events = kLogVerboseEventsDefault,
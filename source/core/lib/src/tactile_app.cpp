@@ -36,7 +36,8 @@ TactileApp::TactileApp(IRuntime* runtime)
     m_object_event_handler {},
     m_component_event_handler {},
     m_property_event_handler {},
-    m_viewport_event_handler {}
+    m_viewport_event_handler {},
+    m_autosave_service {}
 {}
 
 TactileApp::~TactileApp() noexcept = default;
@@ -88,21 +89,31 @@ void TactileApp::on_startup()
   component_event_handler.install(m_event_dispatcher);
   property_event_handler.install(m_event_dispatcher);
   viewport_event_handler.install(m_event_dispatcher);
+
+  _init_autosave();
 }
 
 void TactileApp::on_shutdown()
 {
   m_window->hide();
+
+  if (m_autosave_service.has_value()) {
+    m_autosave_service->finish(m_model->get_document_manager());
+  }
 }
 
 void TactileApp::on_update()
 {
   m_event_dispatcher.update();
+
+  if (m_autosave_service.has_value()) {
+    m_autosave_service->update(m_model->get_document_manager(), m_settings.autosave_interval);
+  }
 }
 
 void TactileApp::on_render()
 {
-  m_widget_manager.push(*m_model, m_event_dispatcher);
+  m_widget_manager.push(*m_model, *m_renderer, m_event_dispatcher);
 }
 
 void TactileApp::on_framebuffer_scale_changed(const float framebuffer_scale)
@@ -110,4 +121,29 @@ void TactileApp::on_framebuffer_scale_changed(const float framebuffer_scale)
   m_event_dispatcher.push<ReloadFontsEvent>(framebuffer_scale);
 }
 
+void TactileApp::_init_autosave()
+{
+  auto autosave_dir = get_autosave_directory();
+  if (!autosave_dir.has_value()) {
+    TACTILE_CORE_ERROR("Autosave is unavailable: {}", to_string(autosave_dir.error()));
+    return;
+  }
+
+  // Autosave data is only left behind by crashes and by maps that weren't saved before the
+  // previous session ended.
+  auto& document_manager = m_model->get_document_manager();
+  const auto recovered_documents =
+      recover_autosaved_maps(*m_runtime, *autosave_dir, document_manager);
+
+  auto& autosave_service = m_autosave_service.emplace(m_runtime, std::move(*autosave_dir));
+
+  for (const auto& document_uuid : recovered_documents) {
+    autosave_service.request_checkpoint(document_uuid);
+  }
+
+  if (!recovered_documents.empty()) {
+    TACTILE_CORE_INFO("Recovered {} map(s) from autosave data", recovered_documents.size());
+  }
+}
+
 }  // namespace tactile::core
@@ -7,6 +7,7 @@
 #include "tactile/core/entity/registry.hpp"
 #include "tactile/core/tile/animation_types.hpp"
 #include "tactile/core/tile/tile.hpp"
+#include "tactile/core/tile/tileset_types.hpp"
 
 namespace tactile::core {
 namespace {
@@ -17,11 +18,19 @@ void _reset_animation(CAnimation& animation)
   animation.frame_index = 0;
 }
 
+void _mark_animations_changed(Registry& registry)
+{
+  if (auto* tile_cache = registry.find<CTileCache>()) {
+    ++tile_cache->animation_revision;
+  }
+}
+
 }  // namespace
 
 void update_animations(Registry& registry)
 {
   const auto now = std::chrono::steady_clock::now();
+  auto changed_appearance = false;
 
   for (auto [entity, animation] : registry.each<CAnimation>()) {
     const auto& current_frame = animation.frames.at(animation.frame_index);
@@ -29,10 +38,16 @@ void update_animations(Registry& registry)
     if ((now - animation.last_update) >= current_frame.duration) {
       const auto next_index = (animation.frame_index + 1) % animation.frames.size();
 
+      changed_appearance = changed_appearance || next_index != animation.frame_index;
+
       animation.last_update = now;
       animation.frame_index = next_index;
     }
   }
+
+  if (changed_appearance) {
+    _mark_animations_changed(registry);
+  }
 }
 
 auto add_animation_frame(Registry& registry,
@@ -66,6 +81,7 @@ auto add_animation_frame(Registry& registry,
   }
 
   _reset_animation(animation);
+  _mark_animations_changed(registry);
 
   return {};
 }
@@ -93,6 +109,8 @@ auto remove_animation_frame(Registry& registry,
     _reset_animation(animation);
   }
 
+  _mark_animations_changed(registry);
+
   return {};
 }
 
@@ -0,0 +1,164 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/tile/tile_range_index.hpp"
+
+#include <algorithm>  // lower_bound
+#include <iterator>   // prev
+#include <limits>     // numeric_limits
+
+#include "tactile/base/numeric/saturate_cast.hpp"
+
+namespace tactile::core {
+namespace {
+
+inline constexpr TileID kFirstValidTileId = 1;
+
+// Tile range ends are computed with a wider type to avoid overflow.
+[[nodiscard]]
+constexpr auto _get_range_end(const TileRange& range) noexcept -> std::int64_t
+{
+  return static_cast<std::int64_t>(range.first_id) + range.count;
+}
+
+[[nodiscard]]
+auto _is_valid_range(const TileRange& range) noexcept -> bool
+{
+  return range.first_id >= kFirstValidTileId && range.count > 0 &&
+         _get_range_end(range) <= std::numeric_limits<TileID>::max();
+}
+
+// Returns the first reserved range that doesn't start before the given tile identifier.
+template <typename Iterator>
+[[nodiscard]]
+auto _find_first_not_before(Iterator begin, Iterator end, const TileID tile_id) -> Iterator
+{
+  return std::lower_bound(begin, end, tile_id, [](const TileRange& range, const TileID id) {
+    return range.first_id < id;
+  });
+}
+
+}  // namespace
+
+void TileRangeIndex::reserve(const std::size_t range_count)
+{
+  m_ranges.reserve(range_count);
+}
+
+auto TileRangeIndex::insert(const TileRange& range) -> bool
+{
+  if (!is_available(range)) {
+    return false;
+  }
+
+  // Ranges are usually reserved in ascending order, so check the end first.
+  if (m_ranges.empty() || m_ranges.back().first_id < range.first_id) {
+    m_ranges.push_back(range);
+  }
+  else {
+    const auto iter = _find_first_not_before(m_ranges.begin(), m_ranges.end(), range.first_id);
+    m_ranges.insert(iter, range);
+  }
+
+  return true;
+}
+
+auto TileRangeIndex::erase(const TileRange& range) -> bool
+{
+  const auto iter = _find_first_not_before(m_ranges.begin(), m_ranges.end(), range.first_id);
+
+  if (iter == m_ranges.end() || *iter != range) {
+    return false;
+  }
+
+  m_ranges.erase(iter);
+  return true;
+}
+
+void TileRangeIndex::clear() noexcept
+{
+  m_ranges.clear();
+}
+
+auto TileRangeIndex::is_available(const TileRange& range) const -> bool
+{
+  if (!_is_valid_range(range)) {
+    return false;
+  }
+
+  const auto next = _find_first_not_before(m_ranges.begin(), m_ranges.end(), range.first_id);
+
+  // The closest range that starts at or after the requested range must start after it ends.
+  if (next != m_ranges.end() && next->first_id < _get_range_end(range)) {
+    return false;
+  }
+
+  // The closest range that starts before the requested range must end before it starts.
+  if (next != m_ranges.begin() && _get_range_end(*std::prev(next)) > range.first_id) {
+    return false;
+  }
+
+  return true;
+}
+
+auto TileRangeIndex::find_best_fit(const std::int32_t count) const -> TileID
+{
+  std::int64_t best_first_id = -1;
+  std::int64_t best_gap_size = std::numeric_limits<std::int64_t>::max();
+
+  std::int64_t gap_begin = kFirstValidTileId;
+  for (const auto& range : m_ranges) {
+    const auto gap_size = range.first_id - gap_begin;
+
+    if (gap_size >= count && gap_size < best_gap_size) {
+      best_first_id = gap_begin;
+      best_gap_size = gap_size;
+
+      if (gap_size == count) {
+        break;
+      }
+    }
+
+    gap_begin = _get_range_end(range);
+  }
+
+  if (best_first_id == -1) {
+    best_first_id = gap_begin;
+  }
+
+  return saturate_cast<TileID>(best_first_id);
+}
+
+auto TileRangeIndex::compact() -> std::vector<TileRangeMove>
+{
+  std::vector<TileRangeMove> moves {};
+
+  TileID next_first_id = kFirstValidTileId;
+  for (auto& range : m_ranges) {
+    if (range.first_id != next_first_id) {
+      moves.push_back(TileRangeMove {.old_range = range, .new_first_id = next_first_id});
+      range.first_id = next_first_id;
+    }
+
+    next_first_id += range.count;
+  }
+
+  return moves;
+}
+
+auto TileRangeIndex::get_end_id() const -> TileID
+{
+  return !m_ranges.empty() ? saturate_cast<TileID>(_get_range_end(m_ranges.back()))
+                           : kFirstValidTileId;
+}
+
+auto TileRangeIndex::get_ranges() const noexcept -> std::span<const TileRange>
+{
+  return m_ranges;
+}
+
+auto TileRangeIndex::size() const noexcept -> std::size_t
+{
+  return m_ranges.size();
+}
+
+}  // namespace tactile::core
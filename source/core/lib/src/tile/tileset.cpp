@@ -214,7 +214,9 @@ auto init_tileset_instance(Registry& registry,
     .count = saturate_cast<std::int32_t>(tileset.tiles.size()),
   };
 
-  if (!is_tile_range_available(registry, tile_range)) {
+  auto& tile_cache = registry.get<CTileCache>();
+
+  if (!tile_cache.tile_ranges.insert(tile_range)) {
     TACTILE_CORE_ERROR("Requested tile range is unavailable: [{}, {})",
                        tile_range.first_id,
                        tile_range.first_id + tile_range.count);
@@ -225,7 +227,6 @@ auto init_tileset_instance(Registry& registry,
   instance.tile_range = tile_range;
   instance.is_embedded = false;  // TODO
 
-  auto& tile_cache = registry.get<CTileCache>();
   tile_cache.tileset_mapping.reserve(tile_cache.tileset_mapping.size() + tileset.tiles.size());
 
   for (std::int32_t index = 0; index < tile_range.count; ++index) {
@@ -233,6 +234,8 @@ auto init_tileset_instance(Registry& registry,
     tile_cache.tileset_mapping.insert_or_assign(tile_id, tileset_entity);
   }
 
+  ++tile_cache.revision;
+
   TACTILE_CORE_DEBUG("Initialized tileset instance with tile range [{}, {})",
                      tile_range.first_id,
                      tile_range.first_id + tile_range.count);
@@ -275,6 +278,9 @@ void destroy_tileset(Registry& registry, const EntityID tileset_entity)
       const TileID tile_id {instance->tile_range.first_id + index};
       tile_cache.tileset_mapping.erase(tile_id);
     }
+
+    tile_cache.tile_ranges.erase(instance->tile_range);
+    ++tile_cache.revision;
   }
 
   registry.destroy(tileset_entity);
@@ -351,21 +357,10 @@ auto get_tile_index(const Registry& registry, const TileID tile_id) -> std::opti
 
 auto is_tile_range_available(const Registry& registry, const TileRange& range) -> bool
 {
-  const auto first_tile = range.first_id;
-  const auto last_tile = range.first_id + range.count - 1;
-
-  if (first_tile < TileID {1}) {
-    return false;
-  }
-
-  for (const auto& [tileset_entity, instance] : registry.each<CTilesetInstance>()) {
-    if (has_tile(instance.tile_range, first_tile) ||
-        has_tile(instance.tile_range, last_tile)) {
-      return false;
-    }
-  }
+  TACTILE_ASSERT(registry.has<CTileCache>());
+  const auto& tile_cache = registry.get<CTileCache>();
 
-  return true;
+  return tile_cache.tile_ranges.is_available(range);
 }
 
 auto has_tile(const TileRange& tile_range, const TileID tile_id) -> bool
@@ -2,14 +2,17 @@
 
 #include "tactile/core/ui/canvas_renderer.hpp"
 
-#include <algorithm>  // clamp
+#include <algorithm>  // clamp, min
 #include <cmath>      // fmod
+#include <cstdint>    // uint32_t
+#include <optional>   // optional, nullopt
 
 #include <imgui.h>
 
 #include "tactile/base/numeric/vec_common.hpp"
 #include "tactile/core/debug/assert.hpp"
 #include "tactile/core/ui/imgui_compat.hpp"
+#include "tactile/core/ui/render/line_batch.hpp"
 #include "tactile/core/ui/render/primitives.hpp"
 #include "tactile/core/ui/viewport.hpp"
 
@@ -70,6 +73,20 @@ auto _get_render_bounds(const VisibleTileRegion& tiles, const Extent2D& extent)
   return bounds;
 }
 
+[[nodiscard]]
+auto _get_grid_line_color(const UColor& color, const Float2& cell_size)
+    -> std::optional<std::uint32_t>
+{
+  const auto opacity = get_grid_opacity(std::min(cell_size.x(), cell_size.y()));
+  const auto alpha = static_cast<UColor::value_type>(static_cast<float>(color.alpha) * opacity);
+
+  if (alpha == 0) {
+    return std::nullopt;
+  }
+
+  return to_uint32_abgr(UColor {color.red, color.green, color.blue, alpha});
+}
+
 }  // namespace
 
 CanvasRenderer::CanvasRenderer(const Float2& canvas_tl,
@@ -104,6 +121,14 @@ void CanvasRenderer::clear_canvas(const UColor& color) const
 
 void CanvasRenderer::draw_orthogonal_grid(const UColor& color) const
 {
+  const auto line_color = _get_grid_line_color(color, mCanvasTileSize);
+  if (!line_color.has_value()) {
+    return;
+  }
+
+  const auto tile_width = mCanvasTileSize.x();
+  const auto tile_height = mCanvasTileSize.y();
+
   const auto row_count =
       saturate_cast<Index2D::value_type>(mVisibleTiles.end.y - mVisibleTiles.begin.y);
   const auto col_count =
@@ -125,25 +150,74 @@ void CanvasRenderer::draw_orthogonal_grid(const UColor& color) const
   const auto grid_offset_x = grid_offset.x();
   const auto grid_offset_y = grid_offset.y();
 
-  const auto tile_width = mCanvasTileSize.x();
-  const auto tile_height = mCanvasTileSize.y();
-
-  const auto line_color = to_uint32_abgr(color);
-  auto& draw_list = get_draw_list();
+  LineBatch lines {get_draw_list(), row_count + col_count, *line_color};
 
   // Draw horizontal lines.
   for (Index2D::value_type r = 0; r < row_count; ++r) {
     const auto row_offset = static_cast<float>(r) * tile_height;
-    const auto line_y = begin_y + grid_offset_y + row_offset;
-    draw_list.AddLine(ImVec2 {begin_x, line_y}, ImVec2 {end_x, line_y}, line_color);
+    lines.add_horizontal_line(begin_x, end_x, begin_y + grid_offset_y + row_offset);
   }
 
   // Draw vertical lines.
   for (Index2D::value_type c = 0; c < col_count; ++c) {
     const auto column_offset = static_cast<float>(c) * tile_width;
-    const auto line_x = begin_x + grid_offset_x + column_offset;
-    draw_list.AddLine(ImVec2 {line_x, begin_y}, ImVec2 {line_x, end_y}, line_color);
+    lines.add_vertical_line(begin_x + grid_offset_x + column_offset, begin_y, end_y);
+  }
+}
+
+void CanvasRenderer::draw_content_grid(const UColor& color) const
+{
+  if (mRenderBounds.begin.x == mRenderBounds.end.x ||
+      mRenderBounds.begin.y == mRenderBounds.end.y) {
+    return;
   }
+
+  const auto line_color = _get_grid_line_color(color, mCanvasTileSize);
+  if (!line_color.has_value()) {
+    return;
+  }
+
+  const auto begin_pos = to_screen_pos(mRenderBounds.begin);
+  const auto end_pos = to_screen_pos(mRenderBounds.end);
+
+  const auto tile_width = mCanvasTileSize.x();
+  const auto tile_height = mCanvasTileSize.y();
+
+  const auto row_count = mRenderBounds.end.y - mRenderBounds.begin.y;
+  const auto col_count = mRenderBounds.end.x - mRenderBounds.begin.x;
+
+  LineBatch lines {get_draw_list(), row_count + col_count + 2, *line_color};
+
+  // Draw horizontal lines, including the bottom edge of the last row.
+  for (Index2D::value_type r = 0; r <= row_count; ++r) {
+    const auto line_y = begin_pos.y() + static_cast<float>(r) * tile_height;
+    lines.add_horizontal_line(begin_pos.x(), end_pos.x(), line_y);
+  }
+
+  // Draw vertical lines, including the right edge of the last column.
+  for (Index2D::value_type c = 0; c <= col_count; ++c) {
+    const auto line_x = begin_pos.x() + static_cast<float>(c) * tile_width;
+    lines.add_vertical_line(line_x, begin_pos.y(), end_pos.y());
+  }
+}
+
+void CanvasRenderer::draw_visible_texture(void* texture_handle,
+                                          const Float2& uv_tile_size) const
+{
+  if (mRenderBounds.begin.x == mRenderBounds.end.x ||
+      mRenderBounds.begin.y == mRenderBounds.end.y) {
+    return;
+  }
+
+  const auto uv_begin = to_float2(mRenderBounds.begin) * uv_tile_size;
+  const auto uv_end = to_float2(mRenderBounds.end) * uv_tile_size;
+
+  auto& draw_list = get_draw_list();
+  draw_list.AddImage(texture_handle,
+                     to_imvec2(to_screen_pos(mRenderBounds.begin)),
+                     to_imvec2(to_screen_pos(mRenderBounds.end)),
+                     to_imvec2(uv_begin),
+                     to_imvec2(uv_end));
 }
 
 void CanvasRenderer::draw_tile_outline(const Float2& world_pos, const UColor& color) const
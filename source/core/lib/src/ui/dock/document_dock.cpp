@@ -2,9 +2,12 @@
 
 #include "tactile/core/ui/dock/document_dock.hpp"
 
+#include <algorithm>  // ranges::find
+
 #include <imgui.h>
 #include <imgui_internal.h>
 
+#include "tactile/core/debug/profiler.hpp"
 #include "tactile/core/document/document_info.hpp"
 #include "tactile/core/entity/registry.hpp"
 #include "tactile/core/event/event_dispatcher.hpp"
@@ -38,7 +41,9 @@ void _push_map_document_overlay(const Registry& registry,
   }
 }
 
-void _push_document_tab(const IDocument& document, EventDispatcher& dispatcher)
+void _push_document_tab(const IDocument& document,
+                        LayerRenderCache& layer_cache,
+                        EventDispatcher& dispatcher)
 {
   const auto& registry = document.get_registry();
   const auto& document_info = registry.get<CDocumentInfo>();
@@ -65,7 +70,7 @@ void _push_document_tab(const IDocument& document, EventDispatcher& dispatcher)
                                           viewport};
 
     if (is_map(registry, document_info.root)) {
-      render_orthogonal_map(canvas_renderer, registry, document_info.root);
+      render_orthogonal_map(canvas_renderer, registry, document_info.root, &layer_cache);
       _push_map_document_overlay(registry, document_info.root, canvas_renderer);
     }
     else {
@@ -120,15 +125,24 @@ void _push_document_tab(const IDocument& document, EventDispatcher& dispatcher)
   }
 }
 
-void _push_document_tabs(const Model& model, EventDispatcher& dispatcher)
+void _push_document_tabs(const Model& model,
+                         IRenderer& renderer,
+                         std::unordered_map<UUID, LayerRenderCache>& layer_caches,
+                         EventDispatcher& dispatcher)
 {
-  if (const TabBarScope tabs {"##TabBar"}; tabs.is_open()) {
-    const auto& document_manager = model.get_document_manager();
-    const auto& open_documents = document_manager.get_open_documents();
+  const auto& document_manager = model.get_document_manager();
+  const auto& open_documents = document_manager.get_open_documents();
 
+  // Release the render targets associated with closed documents.
+  std::erase_if(layer_caches, [&](const auto& uuid_and_cache) {
+    return std::ranges::find(open_documents, uuid_and_cache.first) == open_documents.end();
+  });
+
+  if (const TabBarScope tabs {"##TabBar"}; tabs.is_open()) {
     for (const auto& document_uuid : open_documents) {
       const auto& document = document_manager.get_document(document_uuid);
-      _push_document_tab(document, dispatcher);
+      auto& layer_cache = layer_caches.try_emplace(document_uuid, &renderer).first->second;
+      _push_document_tab(document, layer_cache, dispatcher);
     }
   }
 }
@@ -150,8 +164,10 @@ void _push_empty_view(const Language& language, EventDispatcher& dispatcher)
 
 }  // namespace
 
-void DocumentDock::push(const Model& model, EventDispatcher& dispatcher)
+void DocumentDock::push(const Model& model, IRenderer& renderer, EventDispatcher& dispatcher)
 {
+  TACTILE_PROFILE_SCOPE("DocumentDock::push");
+
   ImGuiWindowClass window_class {};
   window_class.DockNodeFlagsOverrideSet =
       ImGuiDockNodeFlags_NoUndocking | ImGuiDockNodeFlags_NoDockingSplit |
@@ -168,10 +184,11 @@ void DocumentDock::push(const Model& model, EventDispatcher& dispatcher)
     const auto& open_documents = document_manager.get_open_documents();
 
     if (open_documents.empty()) {
+      m_layer_caches.clear();
       _push_empty_view(language, dispatcher);
     }
     else {
-      _push_document_tabs(model, dispatcher);
+      _push_document_tabs(model, renderer, m_layer_caches, dispatcher);
     }
   }
 }
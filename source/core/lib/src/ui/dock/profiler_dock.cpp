@@ -0,0 +1,338 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/ui/dock/profiler_dock.hpp"
+
+#include <algorithm>    // max, sort
+#include <cfloat>       // FLT_MAX, FLT_MIN
+#include <cstddef>      // size_t
+#include <cstdint>      // int64_t, uint32_t
+#include <functional>   // hash
+#include <map>          // map
+#include <string_view>  // string_view
+#include <utility>      // ignore
+
+#include <imgui.h>
+
+#include "tactile/core/event/event_dispatcher.hpp"
+#include "tactile/core/platform/filesystem.hpp"
+#include "tactile/core/ui/common/buttons.hpp"
+#include "tactile/core/ui/common/widgets.hpp"
+#include "tactile/core/ui/common/window.hpp"
+#include "tactile/core/ui/i18n/language.hpp"
+#include "tactile/core/ui/imgui_allocator.hpp"
+
+namespace tactile::core::ui {
+namespace {
+
+inline constexpr float kTimelineRowHeight = 20.0f;
+
+// Zones narrower than this (in pixels) are rendered without labels.
+inline constexpr float kTimelineMinLabelWidth = 24.0f;
+
+[[nodiscard]]
+constexpr auto _to_ms(const std::int64_t duration_ns) noexcept -> float
+{
+  return static_cast<float>(static_cast<double>(duration_ns) / 1'000'000.0);
+}
+
+[[nodiscard]]
+constexpr auto _to_kib(const std::size_t bytes) noexcept -> double
+{
+  return static_cast<double>(bytes) / 1'024.0;
+}
+
+// Zones with the same name are always given the same color.
+[[nodiscard]]
+auto _get_zone_color(const char* name) -> ImU32
+{
+  const auto hash = std::hash<std::string_view> {}(name);
+  const auto hue = static_cast<float>(hash % 360) / 360.0f;
+  return ImColor::HSV(hue, 0.45f, 0.70f);
+}
+
+}  // namespace
+
+void ProfilerDock::push(const Language& language,
+                        const EventDispatcher& dispatcher,
+                        bool* is_open)
+{
+  const Window dock_window {language.get(NounLabel::kProfilerDock),
+                            ImGuiWindowFlags_None,
+                            is_open};
+  if (!dock_window.is_open()) {
+    return;
+  }
+
+  if (!m_paused) {
+    _update_frames();
+  }
+
+  _push_controls();
+  _push_imgui_memory_stats();
+  _push_event_stats(dispatcher);
+
+  if (m_frames.empty()) {
+    ImGui::TextDisabled("No profiler frames have been recorded.");
+    return;
+  }
+
+  _push_frame_graph();
+
+  const auto& frame = m_frames.at(static_cast<std::size_t>(m_selected_frame));
+  _push_timeline(frame);
+  _push_zone_table(frame);
+}
+
+void ProfilerDock::_update_frames()
+{
+  m_frames = get_profiler_frames();
+
+  m_frame_times_ms.clear();
+  m_frame_times_ms.reserve(m_frames.size());
+
+  for (const auto& frame : m_frames) {
+    m_frame_times_ms.push_back(_to_ms(frame.end_ns - frame.begin_ns));
+  }
+
+  m_selected_frame = std::max(static_cast<int>(m_frames.size()) - 1, 0);
+}
+
+void ProfilerDock::_push_controls()
+{
+  auto is_enabled = is_profiler_enabled();
+  if (ImGui::Checkbox("Enabled", &is_enabled)) {
+    set_profiler_enabled(is_enabled);
+  }
+
+  ImGui::SameLine();
+  ImGui::Checkbox("Paused", &m_paused);
+
+  ImGui::SameLine();
+  if (push_button("Clear")) {
+    clear_profiler_frames();
+    m_frames.clear();
+    m_frame_times_ms.clear();
+    m_selected_frame = 0;
+  }
+
+  ImGui::SameLine();
+  if (push_button("Export Trace", "Save the stored frames as a Chrome trace file")) {
+    if (const auto storage_dir = get_persistent_storage_directory()) {
+      std::ignore = save_chrome_trace(*storage_dir / "trace.json");
+    }
+  }
+}
+
+void ProfilerDock::_push_imgui_memory_stats()
+{
+  if (!ImGui::CollapsingHeader("ImGui Memory")) {
+    return;
+  }
+
+  const auto stats = get_imgui_allocator_stats();
+
+  ImGui::Text("Allocations per frame: %zu (%.1f KiB)",
+              stats.frame_allocation_count,
+              _to_kib(stats.frame_allocated_bytes));
+  ImGui::Text("Live allocations: %zu (%.1f KiB)",
+              stats.live_allocation_count,
+              _to_kib(stats.live_bytes));
+  ImGui::Text("Peak usage: %.1f KiB", _to_kib(stats.peak_live_bytes));
+  ImGui::Text("Pool reserved: %.1f KiB", _to_kib(stats.reserved_bytes));
+  ImGui::Text("Large allocations: %zu", stats.large_allocation_count);
+}
+
+void ProfilerDock::_push_event_stats(const EventDispatcher& dispatcher)
+{
+  if (!ImGui::CollapsingHeader("Events")) {
+    return;
+  }
+
+  auto stats = dispatcher.get_stats();
+  std::ranges::sort(stats, [](const EventStats& lhs, const EventStats& rhs) {
+    return lhs.total_handler_ns > rhs.total_handler_ns;
+  });
+
+  const auto table_flags =
+      ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_BordersInner;
+  if (const TableScope table {"##EventStats", 6, table_flags}; table.is_open()) {
+    ImGui::TableSetupColumn("Event");
+    ImGui::TableSetupColumn("Pushed");
+    ImGui::TableSetupColumn("Handled");
+    ImGui::TableSetupColumn("Merged");
+    ImGui::TableSetupColumn("Total (ms)");
+    ImGui::TableSetupColumn("Max (ms)");
+    ImGui::TableHeadersRow();
+
+    for (const auto& event_stats : stats) {
+      ImGui::TableNextRow();
+
+      if (ImGui::TableNextColumn()) {
+        ImGui::TextUnformatted(event_stats.name.data(),
+                               event_stats.name.data() + event_stats.name.size());
+      }
+
+      if (ImGui::TableNextColumn()) {
+        ImGui::Text("%llu", static_cast<unsigned long long>(event_stats.pushed_count));
+      }
+
+      if (ImGui::TableNextColumn()) {
+        ImGui::Text("%llu", static_cast<unsigned long long>(event_stats.dispatched_count));
+      }
+
+      if (ImGui::TableNextColumn()) {
+        ImGui::Text("%llu", static_cast<unsigned long long>(event_stats.merged_count));
+      }
+
+      if (ImGui::TableNextColumn()) {
+        ImGui::Text("%.3f", _to_ms(event_stats.total_handler_ns));
+      }
+
+      if (ImGui::TableNextColumn()) {
+        ImGui::Text("%.3f", _to_ms(event_stats.max_handler_ns));
+      }
+    }
+  }
+}
+
+void ProfilerDock::_push_frame_graph()
+{
+  const auto frame_count = static_cast<int>(m_frame_times_ms.size());
+
+  ImGui::PlotHistogram("##FrameTimes",
+                       m_frame_times_ms.data(),
+                       frame_count,
+                       0,
+                       nullptr,
+                       0.0f,
+                       FLT_MAX,
+                       ImVec2 {ImGui::GetContentRegionAvail().x, 60.0f});
+
+  // Selecting a frame implicitly pauses the capture, to keep the selection stable.
+  ImGui::SetNextItemWidth(-FLT_MIN);
+  if (ImGui::SliderInt("##SelectedFrame", &m_selected_frame, 0, frame_count - 1)) {
+    m_paused = true;
+  }
+
+  const auto& frame = m_frames.at(static_cast<std::size_t>(m_selected_frame));
+  ImGui::Text("Frame %llu: %.3f ms, %zu zones",
+              static_cast<unsigned long long>(frame.index),
+              _to_ms(frame.end_ns - frame.begin_ns),
+              frame.zones.size());
+
+  if (frame.dropped_zone_count > 0) {
+    ImGui::SameLine();
+    ImGui::TextDisabled("(%zu dropped)", frame.dropped_zone_count);
+  }
+}
+
+void ProfilerDock::_push_timeline(const ProfileFrame& frame)
+{
+  // Each thread gets its own set of rows, one row per nesting level.
+  std::map<std::uint32_t, std::uint32_t> thread_depths {};
+  for (const auto& zone : frame.zones) {
+    auto& depth = thread_depths[zone.thread_index];
+    depth = std::max(depth, zone.depth + 1);
+  }
+
+  std::map<std::uint32_t, std::uint32_t> thread_first_rows {};
+  std::uint32_t row_count = 0;
+  for (const auto& [thread_index, depth] : thread_depths) {
+    thread_first_rows[thread_index] = row_count;
+    row_count += depth;
+  }
+
+  const auto origin = ImGui::GetCursorScreenPos();
+  const auto width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+  const auto height = static_cast<float>(std::max(row_count, 1u)) * kTimelineRowHeight;
+
+  ImGui::Dummy(ImVec2 {width, height});
+
+  const auto frame_duration_ns = std::max(frame.end_ns - frame.begin_ns, std::int64_t {1});
+  const auto ns_to_px = width / static_cast<float>(frame_duration_ns);
+
+  auto* draw_list = ImGui::GetWindowDrawList();
+  draw_list->PushClipRect(origin, ImVec2 {origin.x + width, origin.y + height}, true);
+
+  const auto mouse_pos = ImGui::GetMousePos();
+  const ProfileZone* hovered_zone = nullptr;
+
+  for (const auto& zone : frame.zones) {
+    const auto row = thread_first_rows[zone.thread_index] + zone.depth;
+
+    const auto x0 = origin.x + static_cast<float>(zone.begin_ns - frame.begin_ns) * ns_to_px;
+    const auto x1 = origin.x + static_cast<float>(zone.end_ns - frame.begin_ns) * ns_to_px;
+    const auto y0 = origin.y + static_cast<float>(row) * kTimelineRowHeight;
+    const auto y1 = y0 + kTimelineRowHeight - 1.0f;
+
+    const ImVec2 zone_min {x0, y0};
+    const ImVec2 zone_max {std::max(x1, x0 + 1.0f), y1};
+
+    draw_list->AddRectFilled(zone_min, zone_max, _get_zone_color(zone.name));
+
+    if (zone_max.x - zone_min.x >= kTimelineMinLabelWidth) {
+      const ImVec4 label_clip_rect {zone_min.x, zone_min.y, zone_max.x - 2.0f, zone_max.y};
+      draw_list->AddText(nullptr,
+                         0.0f,
+                         ImVec2 {x0 + 2.0f, y0 + 2.0f},
+                         IM_COL32_WHITE,
+                         zone.name,
+                         nullptr,
+                         0.0f,
+                         &label_clip_rect);
+    }
+
+    if (ImGui::IsItemHovered() && mouse_pos.x >= zone_min.x && mouse_pos.x < zone_max.x &&
+        mouse_pos.y >= zone_min.y && mouse_pos.y < zone_max.y) {
+      hovered_zone = &zone;
+    }
+  }
+
+  draw_list->PopClipRect();
+
+  if (hovered_zone != nullptr) {
+    const TooltipScope tooltip {};
+    ImGui::Text("%s: %.3f ms (thread %u)",
+                hovered_zone->name,
+                _to_ms(hovered_zone->end_ns - hovered_zone->begin_ns),
+                hovered_zone->thread_index);
+  }
+}
+
+void ProfilerDock::_push_zone_table(const ProfileFrame& frame)
+{
+  const auto stats = aggregate_profile_zones(frame.zones);
+
+  const auto table_flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable |
+                           ImGuiTableFlags_ScrollY | ImGuiTableFlags_BordersInner;
+  if (const TableScope table {"##ZoneStats", 4, table_flags}; table.is_open()) {
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Zone");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableSetupColumn("Total (ms)");
+    ImGui::TableSetupColumn("Max (ms)");
+    ImGui::TableHeadersRow();
+
+    for (const auto& zone_stats : stats) {
+      ImGui::TableNextRow();
+
+      if (ImGui::TableNextColumn()) {
+        ImGui::TextUnformatted(zone_stats.name);
+      }
+
+      if (ImGui::TableNextColumn()) {
+        ImGui::Text("%zu", zone_stats.call_count);
+      }
+
+      if (ImGui::TableNextColumn()) {
+        ImGui::Text("%.3f", _to_ms(zone_stats.total_ns));
+      }
+
+      if (ImGui::TableNextColumn()) {
+        ImGui::Text("%.3f", _to_ms(zone_stats.max_ns));
+      }
+    }
+  }
+}
+
+}  // namespace tactile::core::ui
@@ -82,15 +82,10 @@ void _push_tileset_tab(const Registry& registry,
     constexpr UColor bg_color {50, 50, 50, 255};
     canvas_renderer.clear_canvas(bg_color);
 
-    const auto texture_pos = canvas_renderer.to_screen_pos(Float2 {0, 0});
-    const auto texture_size = vec_cast<Float2>(texture.size);
-
-    auto* draw_list = ImGui::GetWindowDrawList();
-    draw_list->AddImage(texture.raw_handle,
-                        to_imvec2(texture_pos),
-                        to_imvec2(texture_pos + texture_size));
-
-    canvas_renderer.draw_orthogonal_grid(kColorBlack);
+    // Only the visible part of the tileset is submitted, since tileset textures may
+    // be much larger than the dock.
+    canvas_renderer.draw_visible_texture(texture.raw_handle, tileset.uv_tile_size);
+    canvas_renderer.draw_content_grid(kColorBlack);
 
     _push_tileset_overlay(registry, tileset_id, canvas_renderer);
 
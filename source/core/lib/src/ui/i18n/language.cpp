@@ -81,6 +81,7 @@ void Language::add_icons()
   // Debug
   inject_icon(ActionLabel::kOpenDebugger, to_prefix_string(Icon::kDebug));
   inject_icon(ActionLabel::kOpenStyleEditor, to_prefix_string(Icon::kBrush));
+  inject_icon(ActionLabel::kOpenProfiler, to_prefix_string(Icon::kPerformance));
   inject_icon(ActionLabel::kOpenDemoWindow, to_prefix_string(Icon::kToolbox));
   inject_icon(ActionLabel::kOpenStorageDir, to_prefix_string(Icon::kOpen));
 
@@ -6,7 +6,7 @@
 #include <vector>   // vector
 
 #include "tactile/base/container/lookup.hpp"
-#include "tactile/core/debug/performance.hpp"
+#include "tactile/core/debug/profiler.hpp"
 #include "tactile/core/io/ini.hpp"
 #include "tactile/core/logging.hpp"
 
@@ -89,6 +89,7 @@ auto _get_noun_names() -> std::unordered_map<std::string_view, NounLabel>
     {"animation_dock", NounLabel::kAnimationDock},
     {"log_dock", NounLabel::kLogDock},
     {"style_editor", NounLabel::kStyleEditorWidget},
+    {"profiler_dock", NounLabel::kProfilerDock},
     {"godot_export_dialog", NounLabel::kGodotExportDialog},
   };
 }
@@ -151,12 +152,14 @@ auto _get_action_names() -> std::unordered_map<std::string_view, ActionLabel>
     {"change_property_type", ActionLabel::kChangePropertyType},
     {"select_image", ActionLabel::kSelectImage},
     {"fix_invalid_tiles", ActionLabel::kFixInvalidTiles},
+    {"train_tile_dictionary", ActionLabel::kTrainTileDictionary},
     {"show_metadata", ActionLabel::kShowMetadata},
     {"report_bug", ActionLabel::kReportBug},
     {"about_tactile", ActionLabel::kAboutTactile},
     {"open_credits", ActionLabel::kOpenCredits},
     {"open_debugger", ActionLabel::kOpenDebugger},
     {"open_style_editor", ActionLabel::kOpenStyleEditor},
+    {"open_profiler", ActionLabel::kOpenProfiler},
     {"open_demo_window", ActionLabel::kOpenDemoWindow},
     {"open_storage_dir", ActionLabel::kOpenStorageDir},
     {"tile_layer_item", ActionLabel::kTileLayerItem},
@@ -223,7 +226,7 @@ LanguageParser::LanguageParser()
 auto LanguageParser::parse(const LanguageID id, const std::filesystem::path& path) const
     -> std::expected<Language, ErrorCode>
 {
-  const ScopeProfiler profiler {"LanguageParser::parse"};
+  TACTILE_PROFILE_SCOPE("LanguageParser::parse");
 
   return parse_ini(path)
       .transform([this](const IniData& ini) {
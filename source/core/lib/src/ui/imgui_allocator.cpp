@@ -0,0 +1,213 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/ui/imgui_allocator.hpp"
+
+#include <algorithm>  // max, lower_bound
+#include <array>      // array, to_array
+#include <cstddef>    // byte, max_align_t
+#include <cstdint>    // uint32_t
+#include <cstdlib>    // malloc, free
+#include <iterator>   // distance
+#include <mutex>      // mutex, scoped_lock
+#include <vector>     // vector
+
+namespace tactile::core::ui {
+namespace {
+
+// Every block starts with a header, which keeps track of the block size class
+// and the requested size (for statistics). The header size is a multiple of the
+// fundamental alignment, so that the memory after it remains suitably aligned.
+struct alignas(std::max_align_t) BlockHeader final
+{
+  std::size_t size;
+  std::uint32_t size_class;
+};
+
+// The block sizes (including headers) of each size class. The classes are
+// spaced more densely for small sizes, which is where most allocations are.
+inline constexpr std::array kBlockSizes = std::to_array<std::size_t>({
+  32,  48,  64,  80,  96,  112, 128, 144,  160,  176,  192,  208,
+  224, 240, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096,
+});
+
+inline constexpr std::size_t kMaxBlockSize = kBlockSizes.back();
+inline constexpr std::size_t kSlabSize = 64 * 1024;
+inline constexpr auto kLargeSizeClass = static_cast<std::uint32_t>(kBlockSizes.size());
+
+static_assert(sizeof(BlockHeader) % alignof(std::max_align_t) == 0);
+static_assert(kBlockSizes.front() >= sizeof(BlockHeader) + sizeof(void*));
+static_assert(kSlabSize % kMaxBlockSize == 0);
+
+// A free block, which reuses the block memory to link to the next free block.
+struct FreeBlock final
+{
+  FreeBlock* next;
+};
+
+struct SizeClass final
+{
+  FreeBlock* free_list {nullptr};
+  std::byte* slab_cursor {nullptr};
+  std::byte* slab_end {nullptr};
+};
+
+struct AllocatorState final
+{
+  std::mutex mutex {};
+  std::array<SizeClass, kBlockSizes.size()> size_classes {};
+  std::vector<void*> slabs {};
+  ImGuiAllocatorStats stats {};
+  std::size_t frame_allocation_count {0};
+  std::size_t frame_allocated_bytes {0};
+
+  AllocatorState() = default;
+
+  ~AllocatorState() noexcept
+  {
+    // Slabs are only released if nothing refers to them anymore, which should
+    // be the case unless a Dear ImGui context outlives the allocator.
+    if (stats.live_allocation_count == 0) {
+      for (auto* slab : slabs) {
+        std::free(slab);
+      }
+    }
+  }
+
+  TACTILE_DELETE_COPY(AllocatorState);
+  TACTILE_DELETE_MOVE(AllocatorState);
+};
+
+[[nodiscard]]
+auto _get_allocator_state() -> AllocatorState&
+{
+  static AllocatorState state {};
+  return state;
+}
+
+[[nodiscard]]
+auto _get_size_class(const std::size_t block_size) -> std::uint32_t
+{
+  const auto iter = std::lower_bound(kBlockSizes.begin(), kBlockSizes.end(), block_size);
+  return static_cast<std::uint32_t>(std::distance(kBlockSizes.begin(), iter));
+}
+
+[[nodiscard]]
+auto _allocate_pooled_block(AllocatorState& state, const std::uint32_t size_class) -> void*
+{
+  auto& pool = state.size_classes[size_class];
+
+  if (pool.free_list != nullptr) {
+    auto* block = pool.free_list;
+    pool.free_list = block->next;
+    return block;
+  }
+
+  const auto block_size = kBlockSizes[size_class];
+
+  // Any remaining memory at the end of the current slab is simply left unused,
+  // which is at most one block.
+  if (pool.slab_cursor == nullptr ||
+      static_cast<std::size_t>(pool.slab_end - pool.slab_cursor) < block_size) {
+    auto* slab = static_cast<std::byte*>(std::malloc(kSlabSize));
+    if (slab == nullptr) {
+      return nullptr;
+    }
+
+    state.slabs.push_back(slab);
+    state.stats.reserved_bytes += kSlabSize;
+
+    pool.slab_cursor = slab;
+    pool.slab_end = slab + kSlabSize;
+  }
+
+  auto* block = pool.slab_cursor;
+  pool.slab_cursor += block_size;
+
+  return block;
+}
+
+}  // namespace
+
+auto imgui_malloc(const std::size_t size, void*) -> void*
+{
+  auto& state = _get_allocator_state();
+  const auto block_size = size + sizeof(BlockHeader);
+
+  const std::scoped_lock lock {state.mutex};
+
+  void* block = nullptr;
+  std::uint32_t size_class = kLargeSizeClass;
+
+  if (block_size <= kMaxBlockSize) {
+    size_class = _get_size_class(block_size);
+    block = _allocate_pooled_block(state, size_class);
+  }
+  else {
+    block = std::malloc(block_size);
+    ++state.stats.large_allocation_count;
+  }
+
+  if (block == nullptr) {
+    return nullptr;
+  }
+
+  auto* header = static_cast<BlockHeader*>(block);
+  header->size = size;
+  header->size_class = size_class;
+
+  ++state.frame_allocation_count;
+  state.frame_allocated_bytes += size;
+
+  ++state.stats.live_allocation_count;
+  state.stats.live_bytes += size;
+  state.stats.peak_live_bytes = std::max(state.stats.peak_live_bytes, state.stats.live_bytes);
+
+  return header + 1;
+}
+
+void imgui_free(void* memory, void*)
+{
+  if (memory == nullptr) {
+    return;
+  }
+
+  auto& state = _get_allocator_state();
+  auto* header = static_cast<BlockHeader*>(memory) - 1;
+
+  const std::scoped_lock lock {state.mutex};
+
+  --state.stats.live_allocation_count;
+  state.stats.live_bytes -= header->size;
+
+  if (header->size_class == kLargeSizeClass) {
+    std::free(header);
+    return;
+  }
+
+  auto& pool = state.size_classes[header->size_class];
+
+  auto* block = reinterpret_cast<FreeBlock*>(header);
+  block->next = pool.free_list;
+  pool.free_list = block;
+}
+
+void begin_imgui_allocator_frame()
+{
+  auto& state = _get_allocator_state();
+  const std::scoped_lock lock {state.mutex};
+
+  state.stats.frame_allocation_count = state.frame_allocation_count;
+  state.stats.frame_allocated_bytes = state.frame_allocated_bytes;
+
+  state.frame_allocation_count = 0;
+  state.frame_allocated_bytes = 0;
+}
+
+auto get_imgui_allocator_stats() -> ImGuiAllocatorStats
+{
+  auto& state = _get_allocator_state();
+  const std::scoped_lock lock {state.mutex};
+  return state.stats;
+}
+
+}  // namespace tactile::core::ui
@@ -420,6 +420,10 @@ void _push_map_menu(const Model& model, EventDispatcher& dispatcher)
       dispatcher.push<FixMapTilesEvent>();
     }
 
+    if (ImGui::MenuItem(language.get(ActionLabel::kTrainTileDictionary))) {
+      dispatcher.push<TrainTileDictionaryEvent>();
+    }
+
     ImGui::Separator();
 
     _push_export_as_menu(language, dispatcher);
@@ -471,13 +475,13 @@ void MenuBar::push(const Model& model, EventDispatcher& dispatcher)
     _push_map_menu(model, dispatcher);
     _push_tileset_menu(model, dispatcher);
     _push_help_menu(model, dispatcher);
-    _push_debug_menu(model);
+    _push_debug_menu(model, dispatcher);
 
     ImGui::EndMainMenuBar();
   }
 }
 
-void MenuBar::_push_debug_menu(const Model& model)
+void MenuBar::_push_debug_menu(const Model& model, const EventDispatcher& dispatcher)
 {
   const auto& language = model.get_language();
 
@@ -497,6 +501,12 @@ void MenuBar::_push_debug_menu(const Model& model)
 
     ImGui::Separator();
 
+    if (ImGui::MenuItem(language.get(ActionLabel::kOpenProfiler), nullptr, m_show_profiler)) {
+      m_show_profiler = !m_show_profiler;
+    }
+
+    ImGui::Separator();
+
     if (ImGui::MenuItem(language.get(ActionLabel::kOpenDemoWindow), nullptr, m_show_demo)) {
       m_show_demo = !m_show_demo;
     }
@@ -526,6 +536,10 @@ void MenuBar::_push_debug_menu(const Model& model)
       ImGui::ShowStyleEditor();
     }
   }
+
+  if (m_show_profiler) {
+    m_profiler_dock.push(language, dispatcher, &m_show_profiler);
+  }
 }
 
 }  // namespace tactile::core::ui
@@ -0,0 +1,295 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/ui/render/layer_render_cache.hpp"
+
+#include <algorithm>  // min, ranges::equal
+#include <cmath>      // ceil
+#include <optional>   // optional, nullopt
+#include <utility>    // pair
+
+#include <imgui.h>
+
+#include "tactile/base/debug/validation.hpp"
+#include "tactile/base/meta/color.hpp"
+#include "tactile/base/numeric/extent_2d.hpp"
+#include "tactile/core/debug/assert.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/logging.hpp"
+#include "tactile/core/tile/tileset_types.hpp"
+#include "tactile/core/ui/canvas_renderer.hpp"
+#include "tactile/core/ui/imgui_compat.hpp"
+#include "tactile/core/ui/render/orthogonal_renderer.hpp"
+
+namespace tactile::core::ui {
+namespace {
+
+// Render targets larger than this (in pixels) aren't used, to limit memory usage.
+inline constexpr int kMaxRenderTargetSize = 4096;
+
+// The fraction of the visible tiles that is added as a margin around cached regions.
+inline constexpr Index2D::value_type kRegionMarginDivisor = 4;
+
+[[nodiscard]]
+auto _get_region_size(const Index2D& begin, const Index2D& end, const Float2& tile_size)
+    -> TextureSize
+{
+  return TextureSize {
+    .width = static_cast<int>(std::ceil(static_cast<float>(end.x - begin.x) * tile_size.x())),
+    .height = static_cast<int>(std::ceil(static_cast<float>(end.y - begin.y) * tile_size.y())),
+  };
+}
+
+[[nodiscard]]
+auto _fits_in_render_target(const TextureSize& size) -> bool
+{
+  return size.width > 0 && size.height > 0 &&  //
+         size.width <= kMaxRenderTargetSize && size.height <= kMaxRenderTargetSize;
+}
+
+[[nodiscard]]
+auto _get_cached_region(const CanvasRenderer::RenderBounds& bounds,
+                        const Extent2D& extent,
+                        const Float2& tile_size) -> std::optional<std::pair<Index2D, Index2D>>
+{
+  const auto margin_x = (bounds.end.x - bounds.begin.x) / kRegionMarginDivisor + 1;
+  const auto margin_y = (bounds.end.y - bounds.begin.y) / kRegionMarginDivisor + 1;
+
+  const Index2D begin {
+    .x = bounds.begin.x - std::min(bounds.begin.x, margin_x),
+    .y = bounds.begin.y - std::min(bounds.begin.y, margin_y),
+  };
+
+  const Index2D end {
+    .x = std::min(bounds.end.x + margin_x, extent.cols),
+    .y = std::min(bounds.end.y + margin_y, extent.rows),
+  };
+
+  if (_fits_in_render_target(_get_region_size(begin, end, tile_size))) {
+    return std::pair {begin, end};
+  }
+
+  // Fall back to only covering the visible tiles if the margin makes the region too large.
+  if (_fits_in_render_target(_get_region_size(bounds.begin, bounds.end, tile_size))) {
+    return std::pair {bounds.begin, bounds.end};
+  }
+
+  return std::nullopt;
+}
+
+[[nodiscard]]
+auto _contains(const Index2D& begin,
+               const Index2D& end,
+               const CanvasRenderer::RenderBounds& bounds) -> bool
+{
+  return begin.x <= bounds.begin.x && begin.y <= bounds.begin.y &&  //
+         bounds.end.x <= end.x && bounds.end.y <= end.y;
+}
+
+}  // namespace
+
+LayerRenderCache::LayerRenderCache(IRenderer* renderer)
+  : m_renderer {require_not_null(renderer, "null renderer")},
+    m_groups {},
+    m_is_supported {true}
+{}
+
+LayerRenderCache::~LayerRenderCache() noexcept
+{
+  clear();
+}
+
+auto LayerRenderCache::draw_group(const std::size_t group_index,
+                                  const std::span<const CachedLayer> layers,
+                                  const float opacity,
+                                  const CanvasRenderer& canvas_renderer,
+                                  const Registry& registry) -> bool
+{
+  TACTILE_ASSERT(!layers.empty());
+
+  if (!m_is_supported) {
+    return false;
+  }
+
+  const auto& render_bounds = canvas_renderer.get_render_bounds();
+  if (render_bounds.begin.x == render_bounds.end.x ||
+      render_bounds.begin.y == render_bounds.end.y) {
+    return true;
+  }
+
+  if (group_index >= m_groups.size()) {
+    m_groups.resize(group_index + 1);
+  }
+
+  auto& group = m_groups[group_index];
+  group.is_used = true;
+
+  const auto& tile_cache = registry.get<CTileCache>();
+
+  const auto is_stale = !group.texture_id.has_value() ||
+                        group.tile_size != canvas_renderer.get_canvas_tile_size() ||
+                        group.tile_cache_revision != tile_cache.revision ||
+                        group.animation_revision != tile_cache.animation_revision ||
+                        !std::ranges::equal(group.layers, layers) ||
+                        !_contains(group.begin, group.end, render_bounds);
+
+  if (is_stale && !_update_group(group, layers, canvas_renderer, registry)) {
+    return false;
+  }
+
+  const auto* texture = m_renderer->find_texture(*group.texture_id);
+  if (texture == nullptr) {
+    _release_group(group);
+    return false;
+  }
+
+  const auto flipped = m_renderer->is_render_target_flipped();
+  const ImVec2 uv_min {0.0f, flipped ? 1.0f : 0.0f};
+  const ImVec2 uv_max {1.0f, flipped ? 0.0f : 1.0f};
+
+  const auto screen_pos = canvas_renderer.to_screen_pos(group.begin);
+  const Float2 size {static_cast<float>(group.texture_size.width),
+                     static_cast<float>(group.texture_size.height)};
+
+  auto& draw_list = CanvasRenderer::get_draw_list();
+  if (!m_renderer->add_premultiplied_alpha_callback(draw_list)) {
+    TACTILE_CORE_DEBUG("Layer caching is not supported by the renderer");
+    m_is_supported = false;
+    clear();
+    return false;
+  }
+
+  // The render target stores premultiplied colors, so the opacity must affect all channels.
+  const auto tint = to_uint32_abgr(to_ucolor(FColor {opacity, opacity, opacity, opacity}));
+
+  draw_list.AddImage(texture->get_handle(),
+                     to_imvec2(screen_pos),
+                     to_imvec2(screen_pos + size),
+                     uv_min,
+                     uv_max,
+                     tint);
+  draw_list.AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+
+  return true;
+}
+
+void LayerRenderCache::release_unused_groups()
+{
+  for (auto& group : m_groups) {
+    if (!group.is_used) {
+      _release_group(group);
+    }
+
+    group.is_used = false;
+  }
+}
+
+void LayerRenderCache::clear()
+{
+  for (auto& group : m_groups) {
+    _release_group(group);
+  }
+
+  m_groups.clear();
+}
+
+auto LayerRenderCache::_update_group(LayerGroup& group,
+                                     const std::span<const CachedLayer> layers,
+                                     const CanvasRenderer& canvas_renderer,
+                                     const Registry& registry) -> bool
+{
+  const auto& extent = registry.get<CTileLayer>(layers.front().id).extent;
+  const auto tile_size = canvas_renderer.get_canvas_tile_size();
+
+  const auto region =
+      _get_cached_region(canvas_renderer.get_render_bounds(), extent, tile_size);
+  if (!region.has_value()) {
+    _release_group(group);
+    return false;
+  }
+
+  const auto& [begin, end] = *region;
+  const auto texture_size = _get_region_size(begin, end, tile_size);
+
+  if (group.texture_id.has_value() && (group.texture_size.width != texture_size.width ||
+                                       group.texture_size.height != texture_size.height)) {
+    _release_group(group);
+  }
+
+  if (!group.texture_id.has_value()) {
+    const auto texture_id = m_renderer->create_render_target(texture_size);
+
+    if (!texture_id.has_value()) {
+      if (texture_id.error() == ErrorCode::kNotSupported) {
+        TACTILE_CORE_DEBUG("Layer caching is not supported by the renderer");
+        m_is_supported = false;
+      }
+      else {
+        TACTILE_CORE_WARN("Could not create layer render target: {}",
+                          to_string(texture_id.error()));
+      }
+
+      return false;
+    }
+
+    group.texture_id = *texture_id;
+    group.texture_size = texture_size;
+  }
+
+  const auto display_size = to_imvec2(Float2 {static_cast<float>(texture_size.width),
+                                              static_cast<float>(texture_size.height)});
+
+  ImDrawList draw_list {ImGui::GetDrawListSharedData()};
+  draw_list._ResetForNewFrame();
+  draw_list.PushClipRect(ImVec2 {0.0f, 0.0f}, display_size);
+
+  if (ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset) {
+    draw_list.Flags |= ImDrawListFlags_AllowVtxOffset;
+  }
+
+  const TileRenderRegion render_region {
+    .begin = begin,
+    .end = end,
+    .origin = -(to_float2(begin) * tile_size),
+    .tile_size = tile_size,
+  };
+
+  // The group opacity is applied when the render target is drawn, see draw_group.
+  for (const auto& layer : layers) {
+    render_orthogonal_tile_layer(draw_list, registry, layer.id, render_region, 1.0f);
+  }
+
+  ImDrawData draw_data {};
+  draw_data.Valid = true;
+  draw_data.DisplayPos = ImVec2 {0.0f, 0.0f};
+  draw_data.DisplaySize = display_size;
+  draw_data.FramebufferScale = ImVec2 {1.0f, 1.0f};
+  draw_data.AddDrawList(&draw_list);
+
+  if (!m_renderer->render_to_target(*group.texture_id, draw_data)) {
+    TACTILE_CORE_WARN("Could not render layer group");
+    _release_group(group);
+    return false;
+  }
+
+  group.begin = begin;
+  group.end = end;
+  group.tile_size = tile_size;
+  group.tile_cache_revision = registry.get<CTileCache>().revision;
+  group.animation_revision = registry.get<CTileCache>().animation_revision;
+  group.layers.assign(layers.begin(), layers.end());
+
+  return true;
+}
+
+void LayerRenderCache::_release_group(LayerGroup& group)
+{
+  if (group.texture_id.has_value()) {
+    m_renderer->unload_texture(*group.texture_id);
+    group.texture_id.reset();
+  }
+
+  group.layers.clear();
+}
+
+}  // namespace tactile::core::ui
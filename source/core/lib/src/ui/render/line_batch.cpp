@@ -0,0 +1,155 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/ui/render/line_batch.hpp"
+
+#include <algorithm>  // clamp, min
+#include <array>      // array
+#include <cmath>      // hypot
+
+#include <imgui.h>
+
+#include "tactile/core/debug/assert.hpp"
+#include "tactile/core/ui/imgui_compat.hpp"
+
+namespace tactile::core::ui {
+namespace {
+
+inline constexpr std::size_t kVerticesPerLine = 4;
+inline constexpr std::size_t kIndicesPerLine = 6;
+
+// Keeps each reservation within the range of 16-bit draw list indices.
+inline constexpr std::size_t kMaxLinesPerChunk = 0x3FFF / kVerticesPerLine;
+
+// Grid lines closer than this (in pixels) are gradually faded out.
+inline constexpr float kGridFadeSpacing = 12.0f;
+
+// Grid lines closer than this (in pixels) are not rendered at all.
+inline constexpr float kGridMinSpacing = 4.0f;
+
+}  // namespace
+
+LineBatch::LineBatch(ImDrawList& draw_list,
+                     const std::size_t line_count,
+                     const std::uint32_t color,
+                     const float thickness)
+  : m_draw_list {&draw_list},
+    m_remaining_line_count {line_count},
+    m_reserved_line_count {0},
+    m_line_count {0},
+    m_color {color},
+    m_thickness {thickness}
+{}
+
+LineBatch::~LineBatch() noexcept
+{
+  if (m_reserved_line_count > 0) {
+    m_draw_list->PrimUnreserve(static_cast<int>(m_reserved_line_count * kIndicesPerLine),
+                               static_cast<int>(m_reserved_line_count * kVerticesPerLine));
+  }
+}
+
+void LineBatch::add_horizontal_line(const float x0, const float x1, const float y)
+{
+  const Float2 tl {x0, y};
+  const Float2 br {x1, y + m_thickness};
+  _add_quad(tl, Float2 {br.x(), tl.y()}, br, Float2 {tl.x(), br.y()});
+}
+
+void LineBatch::add_vertical_line(const float x, const float y0, const float y1)
+{
+  const Float2 tl {x, y0};
+  const Float2 br {x + m_thickness, y1};
+  _add_quad(tl, Float2 {br.x(), tl.y()}, br, Float2 {tl.x(), br.y()});
+}
+
+void LineBatch::add_line(const Float2& from, const Float2& to)
+{
+  const auto dx = to.x() - from.x();
+  const auto dy = to.y() - from.y();
+
+  const auto length = std::hypot(dx, dy);
+  if (length <= 0.0f) {
+    return;
+  }
+
+  // Same pixel center offset as ImDrawList::AddLine.
+  const Float2 half_pixel {0.5f, 0.5f};
+  const auto half_thickness = m_thickness * 0.5f;
+  const Float2 normal {-dy / length * half_thickness, dx / length * half_thickness};
+
+  const auto a = from + half_pixel;
+  const auto b = to + half_pixel;
+  _add_quad(a + normal, b + normal, b - normal, a - normal);
+}
+
+void LineBatch::add_rect(const Float2& pos, const Float2& size)
+{
+  const auto x0 = pos.x();
+  const auto y0 = pos.y();
+  const auto x1 = pos.x() + size.x();
+  const auto y1 = pos.y() + size.y();
+
+  add_horizontal_line(x0, x1, y0);
+  add_horizontal_line(x0, x1, y1 - m_thickness);
+  add_vertical_line(x0, y0, y1);
+  add_vertical_line(x1 - m_thickness, y0, y1);
+}
+
+void LineBatch::add_hexagon(const Float2& center_pos, const HexagonInfo& hexagon_info)
+{
+  std::array<Float2, 6> vertices {};
+  get_hexagon_vertices(center_pos, hexagon_info, vertices);
+
+  for (std::size_t index = 0; index < vertices.size(); ++index) {
+    add_line(vertices[index], vertices[(index + 1) % vertices.size()]);
+  }
+}
+
+auto LineBatch::size() const noexcept -> std::size_t
+{
+  return m_line_count;
+}
+
+void LineBatch::_reserve_chunk()
+{
+  TACTILE_ASSERT(m_reserved_line_count == 0);
+
+  const auto chunk_size =
+      std::clamp(m_remaining_line_count, std::size_t {1}, kMaxLinesPerChunk);
+
+  m_draw_list->PrimReserve(static_cast<int>(chunk_size * kIndicesPerLine),
+                           static_cast<int>(chunk_size * kVerticesPerLine));
+
+  m_reserved_line_count = chunk_size;
+  m_remaining_line_count -= std::min(m_remaining_line_count, chunk_size);
+}
+
+void LineBatch::_add_quad(const Float2& a, const Float2& b, const Float2& c, const Float2& d)
+{
+  if (m_reserved_line_count == 0) {
+    _reserve_chunk();
+  }
+
+  const auto uv = ImGui::GetFontTexUvWhitePixel();
+  m_draw_list->PrimQuadUV(to_imvec2(a),
+                          to_imvec2(b),
+                          to_imvec2(c),
+                          to_imvec2(d),
+                          uv,
+                          uv,
+                          uv,
+                          uv,
+                          m_color);
+
+  --m_reserved_line_count;
+  ++m_line_count;
+}
+
+auto get_grid_opacity(const float line_spacing) noexcept -> float
+{
+  return std::clamp((line_spacing - kGridMinSpacing) / (kGridFadeSpacing - kGridMinSpacing),
+                    0.0f,
+                    1.0f);
+}
+
+}  // namespace tactile::core::ui
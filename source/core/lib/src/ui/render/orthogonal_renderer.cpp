@@ -3,6 +3,11 @@
 #include "tactile/core/ui/render/orthogonal_renderer.hpp"
 
 #include <algorithm>  // min
+#include <cstddef>    // size_t
+#include <cstdint>    // uint32_t
+#include <vector>     // vector
+
+#include <imgui.h>
 
 #include "tactile/base/container/lookup.hpp"
 #include "tactile/base/meta/color.hpp"
@@ -20,66 +25,41 @@
 #include "tactile/core/ui/canvas_renderer.hpp"
 #include "tactile/core/ui/common/window.hpp"
 #include "tactile/core/ui/imgui_compat.hpp"
+#include "tactile/core/ui/render/layer_render_cache.hpp"
 #include "tactile/core/ui/render/primitives.hpp"
 
 namespace tactile::core::ui {
 namespace {
 
-void _render_tile(const CanvasRenderer& canvas_renderer,
-                  const Index2D& position_in_world,
+// Tracks the tile layers that are eligible for caching during a map render.
+struct MapRenderState final
+{
+  const CanvasRenderer* canvas_renderer;
+  const Registry* registry;
+  LayerRenderCache* layer_cache;
+  EntityID active_layer;
+  TileRenderRegion visible_region;
+  std::vector<CachedLayer> pending_group;
+  float pending_opacity;
+  std::size_t group_count;
+};
+
+void _render_tile(ImDrawList& draw_list,
+                  const Float2& screen_pos,
+                  const Float2& screen_size,
                   const Index2D& position_in_tileset,
                   void* texture_handle,
-                  const Float2& uv_tile_size)
+                  const Float2& uv_tile_size,
+                  const std::uint32_t tint)
 {
   const auto position_in_texture = to_float2(position_in_tileset) * uv_tile_size;
 
-  const auto world_pos = canvas_renderer.to_screen_pos(position_in_world);
-  const auto world_size = canvas_renderer.get_canvas_tile_size();
-
-  auto* draw_list = ImGui::GetWindowDrawList();
-  draw_list->AddImage(texture_handle,
-                      to_imvec2(world_pos),
-                      to_imvec2(world_pos + world_size),
-                      to_imvec2(position_in_texture),
-                      to_imvec2(position_in_texture + uv_tile_size));
-}
-
-void _render_tile_layer(const CanvasRenderer& canvas_renderer,
-                        const Registry& registry,
-                        const EntityID layer_id)
-{
-  const auto& render_bounds = canvas_renderer.get_render_bounds();
-  const auto& tile_cache = registry.get<CTileCache>();
-
-  each_layer_tile(
-      registry,
-      layer_id,
-      render_bounds.begin,
-      render_bounds.end,
-      [&](const Index2D& position_in_world, const TileID tile_id) {
-        if (tile_id == kEmptyTile) {
-          return;
-        }
-
-        const auto tileset_id = lookup_in(tile_cache.tileset_mapping, tile_id);
-
-        const auto& texture = registry.get<CTexture>(tileset_id);
-        const auto& tileset = registry.get<CTileset>(tileset_id);
-        const auto& tileset_instance = registry.get<CTilesetInstance>(tileset_id);
-
-        const TileIndex tile_index {tile_id - tileset_instance.tile_range.first_id};
-        const auto apparent_tile_index = get_tile_appearance(registry, tileset_id, tile_index);
-
-        const auto position_in_tileset =
-            Index2D::from_1d(static_cast<Extent2D::value_type>(apparent_tile_index),
-                             tileset.extent.cols);
-
-        _render_tile(canvas_renderer,
-                     position_in_world,
-                     position_in_tileset,
-                     texture.raw_handle,
-                     tileset.uv_tile_size);
-      });
+  draw_list.AddImage(texture_handle,
+                     to_imvec2(screen_pos),
+                     to_imvec2(screen_pos + screen_size),
+                     to_imvec2(position_in_texture),
+                     to_imvec2(position_in_texture + uv_tile_size),
+                     tint);
 }
 
 void _render_object(const CanvasRenderer& canvas_renderer,
@@ -130,33 +110,132 @@ void _render_object_layer(const CanvasRenderer& canvas_renderer,
   }
 }
 
-void _render_layer(const CanvasRenderer& canvas_renderer,
-                   const Registry& registry,
-                   const EntityID layer_id)
+void _flush_layer_group(MapRenderState& state)
+{
+  if (state.pending_group.empty()) {
+    return;
+  }
+
+  const auto group_index = state.group_count;
+  ++state.group_count;
+
+  if (state.layer_cache != nullptr &&
+      state.layer_cache->draw_group(group_index,
+                                    state.pending_group,
+                                    state.pending_opacity,
+                                    *state.canvas_renderer,
+                                    *state.registry)) {
+    state.pending_group.clear();
+    return;
+  }
+
+  auto& draw_list = CanvasRenderer::get_draw_list();
+  for (const auto& layer : state.pending_group) {
+    render_orthogonal_tile_layer(draw_list,
+                                 *state.registry,
+                                 layer.id,
+                                 state.visible_region,
+                                 state.pending_opacity);
+  }
+
+  state.pending_group.clear();
+}
+
+void _render_layer(MapRenderState& state, const EntityID layer_id, const float parent_opacity)
 {
-  if (const auto& layer = registry.get<CLayer>(layer_id); !layer.visible) {
+  const auto& registry = *state.registry;
+
+  const auto& layer = registry.get<CLayer>(layer_id);
+  if (!layer.visible) {
     return;
   }
 
+  const auto opacity = parent_opacity * layer.opacity;
+
   if (is_tile_layer(registry, layer_id)) {
-    _render_tile_layer(canvas_renderer, registry, layer_id);
+    // The active layer is likely to change frequently, so it's always rendered directly.
+    if (layer_id == state.active_layer) {
+      _flush_layer_group(state);
+      render_orthogonal_tile_layer(CanvasRenderer::get_draw_list(),
+                                   registry,
+                                   layer_id,
+                                   state.visible_region,
+                                   opacity);
+    }
+    else {
+      // Cached groups are drawn with a single opacity, see LayerRenderCache.
+      if (opacity != state.pending_opacity) {
+        _flush_layer_group(state);
+      }
+
+      const auto& tile_layer = registry.get<CTileLayer>(layer_id);
+      state.pending_group.push_back(CachedLayer {
+        .id = layer_id,
+        .revision = tile_layer.revision,
+      });
+      state.pending_opacity = opacity;
+    }
   }
   else if (is_object_layer(registry, layer_id)) {
-    _render_object_layer(canvas_renderer, registry, layer_id);
+    _flush_layer_group(state);
+    _render_object_layer(*state.canvas_renderer, registry, layer_id);
   }
   else if (is_group_layer(registry, layer_id)) {
     const auto& group_layer = registry.get<CGroupLayer>(layer_id);
     for (const auto sublayer_id : group_layer.layers) {
-      _render_layer(canvas_renderer, registry, sublayer_id);
+      _render_layer(state, sublayer_id, opacity);
     }
   }
 }
 
 }  // namespace
 
+void render_orthogonal_tile_layer(ImDrawList& draw_list,
+                                  const Registry& registry,
+                                  const EntityID layer_id,
+                                  const TileRenderRegion& region,
+                                  const float opacity)
+{
+  const auto& tile_cache = registry.get<CTileCache>();
+  const auto tint = to_uint32_abgr(to_ucolor(FColor {1.0f, 1.0f, 1.0f, opacity}));
+
+  each_layer_tile(
+      registry,
+      layer_id,
+      region.begin,
+      region.end,
+      [&](const Index2D& position_in_world, const TileID tile_id) {
+        if (tile_id == kEmptyTile) {
+          return;
+        }
+
+        const auto tileset_id = lookup_in(tile_cache.tileset_mapping, tile_id);
+
+        const auto& texture = registry.get<CTexture>(tileset_id);
+        const auto& tileset = registry.get<CTileset>(tileset_id);
+        const auto& tileset_instance = registry.get<CTilesetInstance>(tileset_id);
+
+        const TileIndex tile_index {tile_id - tileset_instance.tile_range.first_id};
+        const auto apparent_tile_index = get_tile_appearance(registry, tileset_id, tile_index);
+
+        const auto position_in_tileset =
+            Index2D::from_1d(static_cast<Extent2D::value_type>(apparent_tile_index),
+                             tileset.extent.cols);
+
+        _render_tile(draw_list,
+                     region.origin + to_float2(position_in_world) * region.tile_size,
+                     region.tile_size,
+                     position_in_tileset,
+                     texture.raw_handle,
+                     tileset.uv_tile_size,
+                     tint);
+      });
+}
+
 void render_orthogonal_map(const CanvasRenderer& canvas_renderer,
                            const Registry& registry,
-                           const EntityID map_id)
+                           const EntityID map_id,
+                           LayerRenderCache* layer_cache)
 {
   TACTILE_ASSERT(is_map(registry, map_id));
 
@@ -169,8 +248,33 @@ void render_orthogonal_map(const CanvasRenderer& canvas_renderer,
   const auto& map = registry.get<CMap>(map_id);
   const auto& root_layer = registry.get<CGroupLayer>(map.root_layer);
 
+  const auto& render_bounds = canvas_renderer.get_render_bounds();
+
+  MapRenderState state {
+    .canvas_renderer = &canvas_renderer,
+    .registry = &registry,
+    .layer_cache = layer_cache,
+    .active_layer = map.active_layer,
+    .visible_region =
+        TileRenderRegion {
+          .begin = render_bounds.begin,
+          .end = render_bounds.end,
+          .origin = canvas_renderer.to_screen_pos(Float2 {0, 0}),
+          .tile_size = canvas_renderer.get_canvas_tile_size(),
+        },
+    .pending_group = {},
+    .pending_opacity = 1.0f,
+    .group_count = 0,
+  };
+
   for (const auto layer_id : root_layer.layers) {
-    _render_layer(canvas_renderer, registry, layer_id);
+    _render_layer(state, layer_id, 1.0f);
+  }
+
+  _flush_layer_group(state);
+
+  if (layer_cache != nullptr) {
+    layer_cache->release_unused_groups();
   }
 
   canvas_renderer.draw_orthogonal_grid(grid_color);
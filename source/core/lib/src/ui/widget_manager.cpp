@@ -2,21 +2,24 @@
 
 #include "tactile/core/ui/widget_manager.hpp"
 
+#include "tactile/core/debug/profiler.hpp"
 #include "tactile/core/document/map_document.hpp"
 #include "tactile/core/model/model.hpp"
 #include "tactile/core/ui/shortcuts.hpp"
 
 namespace tactile::core::ui {
 
-void WidgetManager::push(const Model& model, EventDispatcher& dispatcher)
+void WidgetManager::push(const Model& model, IRenderer& renderer, EventDispatcher& dispatcher)
 {
+  TACTILE_PROFILE_SCOPE("WidgetManager::push");
+
   const auto& language = model.get_language();
   const auto* current_doc = model.get_current_document();
   const auto* current_map_doc = dynamic_cast<const MapDocument*>(current_doc);
 
   mMenuBar.push(model, dispatcher);
   mDockSpace.update(language);
-  mDocumentDock.push(model, dispatcher);
+  mDocumentDock.push(model, renderer, dispatcher);
 
   if (current_map_doc != nullptr) {
     mTilesetDock.push(language, *current_map_doc, dispatcher);
@@ -25,6 +25,21 @@ struct C2 final : ICommand
   {}
 };
 
+struct TileCommand final : ICommand
+{
+  void undo() override
+  {}
+
+  void redo() override
+  {}
+
+  [[nodiscard]]
+  auto modifies_only_tiles() const -> bool override
+  {
+    return true;
+  }
+};
+
 // tactile::core::CommandStack::CommandStack
 TEST(CommandStack, Constructor)
 {
@@ -202,6 +217,29 @@ TEST(CommandStack, CleanIndexManagement)
   EXPECT_FALSE(stack.is_clean());
 }
 
+// tactile::core::CommandStack::mark_as_dirty
+TEST(CommandStack, MarkAsDirty)
+{
+  CommandStack stack {8};
+
+  stack.mark_as_dirty();
+  EXPECT_FALSE(stack.is_clean());
+
+  // Reverting all commands doesn't restore the original state of the document.
+  stack.push<C1>();
+  stack.undo();
+  EXPECT_FALSE(stack.is_clean());
+
+  stack.mark_as_clean();
+  EXPECT_TRUE(stack.is_clean());
+
+  stack.redo();
+  EXPECT_FALSE(stack.is_clean());
+
+  stack.undo();
+  EXPECT_TRUE(stack.is_clean());
+}
+
 // tactile::core::CommandStack::push
 TEST(CommandStack, CommandOverflowWithDefinedCleanIndex)
 {
@@ -276,5 +314,46 @@ TEST(CommandStack, DynamicCapacityChange)
   EXPECT_EQ(stack.capacity(), 25);
 }
 
+// tactile::core::CommandStack::revision
+TEST(CommandStack, Revision)
+{
+  CommandStack stack {1};
+  EXPECT_EQ(stack.revision(), 0);
+
+  stack.push<C1>();
+  EXPECT_EQ(stack.revision(), 1);
+
+  // The stack is full, so the index is unaffected by this command.
+  stack.push<C1>();
+  EXPECT_EQ(stack.index(), 0);
+  EXPECT_EQ(stack.revision(), 2);
+
+  stack.undo();
+  EXPECT_EQ(stack.revision(), 3);
+
+  stack.redo();
+  EXPECT_EQ(stack.revision(), 4);
+}
+
+// tactile::core::CommandStack::structure_revision
+TEST(CommandStack, StructureRevision)
+{
+  CommandStack stack {10};
+
+  stack.push<TileCommand>();
+  stack.store<TileCommand>();
+  EXPECT_EQ(stack.revision(), 2);
+  EXPECT_EQ(stack.structure_revision(), 0);
+
+  stack.push<C1>();
+  EXPECT_EQ(stack.revision(), 3);
+  EXPECT_EQ(stack.structure_revision(), 1);
+
+  stack.undo();
+  stack.undo();
+  EXPECT_EQ(stack.revision(), 5);
+  EXPECT_EQ(stack.structure_revision(), 2);
+}
+
 }  // namespace
 }  // namespace tactile::core
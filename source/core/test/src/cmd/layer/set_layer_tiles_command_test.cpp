@@ -0,0 +1,120 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/cmd/layer/set_layer_tiles_command.hpp"
+
+#include <optional>  // optional
+#include <utility>   // move
+
+#include <gtest/gtest.h>
+
+#include "tactile/core/cmd/command_stack.hpp"
+#include "tactile/core/cmd/layer/create_layer_command.hpp"
+#include "tactile/core/document/document_info.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
+#include "tactile/core/map/map.hpp"
+#include "test/document_testing.hpp"
+
+namespace tactile::core {
+namespace {
+
+class SetLayerTilesCommandTest : public testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    {
+      auto document = MapDocument::make(kOrthogonalMapSpec);
+      ASSERT_TRUE(document.has_value());
+      mDocument = std::move(document.value());
+    }
+
+    auto& registry = mDocument->get_registry();
+    mMapId = registry.get<CDocumentInfo>().root;
+
+    CreateLayerCommand create_layer {&mDocument.value(), LayerType::kTileLayer};
+    create_layer.redo();
+
+    const auto& map = registry.get<CMap>(mMapId);
+    mLayerId = map.active_layer;
+  }
+
+  [[nodiscard]]
+  auto get_tile(const Index2D& index) const -> std::optional<TileID>
+  {
+    return get_layer_tile(mDocument->get_registry(), mLayerId, index);
+  }
+
+  std::optional<MapDocument> mDocument;
+  EntityID mMapId {kInvalidEntity};
+  EntityID mLayerId {kInvalidEntity};
+};
+
+// tactile::core::SetLayerTilesCommand::redo
+// tactile::core::SetLayerTilesCommand::undo
+TEST_F(SetLayerTilesCommandTest, RedoUndo)
+{
+  auto& registry = mDocument->get_registry();
+  set_layer_tile(registry, mLayerId, Index2D {1, 0}, TileID {7});
+
+  SetLayerTilesCommand set_tiles {
+    &mDocument.value(),
+    mLayerId,
+    SparseTileMatrix {
+      {Index2D {0, 0}, TileID {1}},
+      {Index2D {1, 0}, TileID {2}},
+    },
+  };
+
+  EXPECT_EQ(get_tile(Index2D {0, 0}), kEmptyTile);
+  EXPECT_EQ(get_tile(Index2D {1, 0}), TileID {7});
+
+  set_tiles.redo();
+  EXPECT_EQ(get_tile(Index2D {0, 0}), TileID {1});
+  EXPECT_EQ(get_tile(Index2D {1, 0}), TileID {2});
+
+  set_tiles.undo();
+  EXPECT_EQ(get_tile(Index2D {0, 0}), kEmptyTile);
+  EXPECT_EQ(get_tile(Index2D {1, 0}), TileID {7});
+
+  set_tiles.redo();
+  EXPECT_EQ(get_tile(Index2D {0, 0}), TileID {1});
+  EXPECT_EQ(get_tile(Index2D {1, 0}), TileID {2});
+}
+
+// tactile::core::SetLayerTilesCommand::redo
+TEST_F(SetLayerTilesCommandTest, IgnoreTilesOutsideLayer)
+{
+  const auto& tile_layer = mDocument->get_registry().get<CTileLayer>(mLayerId);
+  const Index2D outside_index {.x = tile_layer.extent.cols, .y = 0};
+
+  SetLayerTilesCommand set_tiles {
+    &mDocument.value(),
+    mLayerId,
+    SparseTileMatrix {{outside_index, TileID {1}}},
+  };
+
+  const auto old_revision = tile_layer.revision;
+
+  set_tiles.redo();
+  set_tiles.undo();
+
+  EXPECT_EQ(tile_layer.revision, old_revision);
+}
+
+// tactile::core::SetLayerTilesCommand::modifies_only_tiles
+TEST_F(SetLayerTilesCommandTest, ModifiesOnlyTiles)
+{
+  CommandStack history {8};
+
+  history.push<SetLayerTilesCommand>(&mDocument.value(),
+                                     mLayerId,
+                                     SparseTileMatrix {{Index2D {0, 0}, TileID {1}}});
+
+  EXPECT_EQ(history.revision(), 1);
+  EXPECT_EQ(history.structure_revision(), 0);
+}
+
+}  // namespace
+}  // namespace tactile::core
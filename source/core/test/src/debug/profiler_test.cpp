@@ -0,0 +1,170 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/debug/profiler.hpp"
+
+#include <sstream>      // stringstream
+#include <string>       // string
+#include <string_view>  // string_view
+#include <thread>       // thread
+#include <vector>       // vector
+
+#include <gtest/gtest.h>
+
+namespace tactile::core {
+namespace {
+
+class ProfilerTest : public testing::Test
+{
+ public:
+  void SetUp() override
+  {
+    set_profiler_enabled(true);
+    end_profiler_frame();
+    clear_profiler_frames();
+  }
+
+  void TearDown() override
+  {
+    set_profiler_enabled(false);
+    clear_profiler_frames();
+  }
+};
+
+// tactile::core::ProfileScope
+// tactile::core::begin_profiler_frame
+// tactile::core::end_profiler_frame
+TEST_F(ProfilerTest, NestedZones)
+{
+  begin_profiler_frame();
+  {
+    TACTILE_PROFILE_SCOPE("outer");
+    TACTILE_PROFILE_SCOPE("middle");
+    {
+      TACTILE_PROFILE_SCOPE("inner");
+    }
+  }
+  end_profiler_frame();
+
+  const auto frames = get_profiler_frames();
+  ASSERT_EQ(frames.size(), 1);
+
+  const auto& frame = frames.front();
+  EXPECT_LE(frame.begin_ns, frame.end_ns);
+  EXPECT_EQ(frame.dropped_zone_count, 0);
+  ASSERT_EQ(frame.zones.size(), 3);
+
+  // Zones are collected in the order that they were completed.
+  const auto& inner = frame.zones[0];
+  const auto& middle = frame.zones[1];
+  const auto& outer = frame.zones[2];
+
+  EXPECT_EQ(std::string_view {inner.name}, "inner");
+  EXPECT_EQ(std::string_view {middle.name}, "middle");
+  EXPECT_EQ(std::string_view {outer.name}, "outer");
+
+  EXPECT_EQ(outer.depth, 0);
+  EXPECT_EQ(middle.depth, 1);
+  EXPECT_EQ(inner.depth, 2);
+
+  EXPECT_LE(outer.begin_ns, middle.begin_ns);
+  EXPECT_LE(middle.begin_ns, inner.begin_ns);
+  EXPECT_LE(inner.end_ns, middle.end_ns);
+  EXPECT_LE(middle.end_ns, outer.end_ns);
+
+  EXPECT_EQ(inner.thread_index, frame.thread_index);
+}
+
+// tactile::core::set_profiler_enabled
+TEST_F(ProfilerTest, DisabledProfiler)
+{
+  set_profiler_enabled(false);
+  EXPECT_FALSE(is_profiler_enabled());
+
+  begin_profiler_frame();
+  {
+    TACTILE_PROFILE_SCOPE("zone");
+  }
+  end_profiler_frame();
+
+  EXPECT_TRUE(get_profiler_frames().empty());
+}
+
+// tactile::core::end_profiler_frame
+TEST_F(ProfilerTest, ZonesFromOtherThreads)
+{
+  begin_profiler_frame();
+
+  std::thread worker {[] { TACTILE_PROFILE_SCOPE("worker"); }};
+  worker.join();
+
+  end_profiler_frame();
+
+  const auto frames = get_profiler_frames();
+  ASSERT_EQ(frames.size(), 1);
+  ASSERT_EQ(frames.front().zones.size(), 1);
+
+  const auto& zone = frames.front().zones.front();
+  EXPECT_EQ(std::string_view {zone.name}, "worker");
+  EXPECT_EQ(zone.depth, 0);
+  EXPECT_NE(zone.thread_index, frames.front().thread_index);
+}
+
+// tactile::core::aggregate_profile_zones
+TEST(Profiler, AggregateProfileZones)
+{
+  const std::vector<ProfileZone> zones {
+    ProfileZone {.name = "a", .begin_ns = 0, .end_ns = 10, .thread_index = 0, .depth = 0},
+    ProfileZone {.name = "b", .begin_ns = 10, .end_ns = 40, .thread_index = 0, .depth = 0},
+    ProfileZone {.name = "a", .begin_ns = 40, .end_ns = 45, .thread_index = 0, .depth = 0},
+  };
+
+  const auto stats = aggregate_profile_zones(zones);
+  ASSERT_EQ(stats.size(), 2);
+
+  EXPECT_EQ(std::string_view {stats[0].name}, "b");
+  EXPECT_EQ(stats[0].call_count, 1);
+  EXPECT_EQ(stats[0].total_ns, 30);
+  EXPECT_EQ(stats[0].max_ns, 30);
+
+  EXPECT_EQ(std::string_view {stats[1].name}, "a");
+  EXPECT_EQ(stats[1].call_count, 2);
+  EXPECT_EQ(stats[1].total_ns, 15);
+  EXPECT_EQ(stats[1].max_ns, 10);
+}
+
+// tactile::core::write_chrome_trace
+TEST(Profiler, WriteChromeTrace)
+{
+  const std::vector<ProfileFrame> frames {
+    ProfileFrame {
+      .index = 0,
+      .begin_ns = 1'000,
+      .end_ns = 3'000,
+      .thread_index = 0,
+      .zones = {ProfileZone {
+        .name = R"(a "quoted" zone)",
+        .begin_ns = 1'500,
+        .end_ns = 2'000,
+        .thread_index = 1,
+        .depth = 0,
+      }},
+      .dropped_zone_count = 0,
+    },
+  };
+
+  std::stringstream stream {};
+  write_chrome_trace(frames, stream);
+
+  const auto json = stream.str();
+  EXPECT_NE(json.find(R"("traceEvents":[)"), std::string::npos);
+  EXPECT_NE(
+      json.find(R"({"name":"Frame","cat":"frame","ph":"X","ts":0.000,"dur":2.000,"pid":0,"tid":0})"),
+      std::string::npos);
+  EXPECT_NE(
+      json.find(
+          R"({"name":"a \"quoted\" zone","cat":"zone","ph":"X","ts":0.500,"dur":0.500,"pid":0,"tid":1})"),
+      std::string::npos);
+}
+
+}  // namespace
+}  // namespace tactile::core
@@ -2,13 +2,36 @@
 
 #include "tactile/core/event/event_dispatcher.hpp"
 
-#include <vector>  // vector
+#include <algorithm>  // find_if
+#include <cstddef>    // size_t
+#include <cstdlib>    // exit, EXIT_SUCCESS, EXIT_FAILURE
+#include <thread>     // jthread
+#include <utility>    // index_sequence, make_index_sequence
+#include <vector>     // vector
 
 #include <gtest/gtest.h>
 
+#include "tactile/core/event/events.hpp"
+
 namespace tactile::core {
 namespace {
 
+template <std::size_t N>
+struct IndexedEvent final
+{};
+
+struct CountEvent final
+{
+  int count;
+};
+
+// Consecutive count events are merged by summing the counts.
+constexpr auto try_merge_events(CountEvent& event, const CountEvent& next_event) -> bool
+{
+  event.count += next_event.count;
+  return true;
+}
+
 class EventDispatcherTest : public testing::Test
 {
  public:
@@ -22,10 +45,16 @@ class EventDispatcherTest : public testing::Test
     mFloats.push_back(value);
   }
 
+  void on_count(const CountEvent& event)
+  {
+    mCounts.push_back(event.count);
+  }
+
  protected:
   EventDispatcher mDispatcher {};
   std::vector<int> mInts {};
   std::vector<float> mFloats {};
+  std::vector<int> mCounts {};
 };
 
 // tactile::core::EventDispatcher::push
@@ -109,5 +138,135 @@ TEST_F(EventDispatcherTest, TriggerUnregisteredEvent)
   EXPECT_EQ(mFloats.size(), 0);
 }
 
+// tactile::core::EventDispatcher::push
+// tactile::core::EventDispatcher::update
+TEST_F(EventDispatcherTest, PushFromMultipleThreads)
+{
+  constexpr int kThreadCount = 4;
+  constexpr int kEventsPerThread = 10'000;
+
+  mDispatcher.bind<int, &EventDispatcherTest::on_int>(this);
+
+  {
+    std::vector<std::jthread> threads {};
+    threads.reserve(kThreadCount);
+
+    for (int thread_index = 0; thread_index < kThreadCount; ++thread_index) {
+      threads.emplace_back([this, thread_index] {
+        for (int event_index = 0; event_index < kEventsPerThread; ++event_index) {
+          mDispatcher.push<int>(thread_index * kEventsPerThread + event_index);
+        }
+      });
+    }
+  }
+
+  mDispatcher.update();
+
+  ASSERT_EQ(mInts.size(), std::size_t {kThreadCount * kEventsPerThread});
+
+  // Events pushed by the same thread are dispatched in order.
+  std::vector<int> last_values(kThreadCount, -1);
+  for (const auto value : mInts) {
+    auto& last_value = last_values.at(static_cast<std::size_t>(value / kEventsPerThread));
+    EXPECT_GT(value, last_value);
+    last_value = value;
+  }
+}
+
+// tactile::core::EventDispatcher::push
+// tactile::core::EventDispatcher::update
+TEST_F(EventDispatcherTest, MergeEvents)
+{
+  mDispatcher.bind<CountEvent, &EventDispatcherTest::on_count>(this);
+
+  mDispatcher.push<CountEvent>(1);
+  mDispatcher.push<CountEvent>(2);
+  mDispatcher.push<CountEvent>(3);
+
+  mDispatcher.update();
+
+  ASSERT_EQ(mCounts.size(), 1);
+  EXPECT_EQ(mCounts.at(0), 6);
+}
+
+// tactile::core::EventDispatcher::get_stats
+TEST_F(EventDispatcherTest, GetStats)
+{
+  mDispatcher.bind<int, &EventDispatcherTest::on_int>(this);
+  mDispatcher.bind<CountEvent, &EventDispatcherTest::on_count>(this);
+
+  EXPECT_TRUE(mDispatcher.get_stats().empty());
+
+  mDispatcher.push<int>(1);
+  mDispatcher.push<int>(2);
+  mDispatcher.push<CountEvent>(1);
+  mDispatcher.push<CountEvent>(1);
+  mDispatcher.push<CountEvent>(1);
+
+  const auto stats_before_update = mDispatcher.get_stats();
+  ASSERT_EQ(stats_before_update.size(), 2);
+
+  mDispatcher.update();
+
+  const auto stats = mDispatcher.get_stats();
+  ASSERT_EQ(stats.size(), 2);
+
+  const auto find_stats = [&stats](const std::size_t pushed_count) {
+    return std::find_if(stats.begin(), stats.end(), [=](const EventStats& event_stats) {
+      return event_stats.pushed_count == pushed_count;
+    });
+  };
+
+  const auto int_stats = find_stats(2);
+  ASSERT_NE(int_stats, stats.end());
+  EXPECT_EQ(int_stats->dispatched_count, 2);
+  EXPECT_EQ(int_stats->merged_count, 0);
+  EXPECT_GE(int_stats->total_handler_ns, int_stats->max_handler_ns);
+
+  const auto count_stats = find_stats(3);
+  ASSERT_NE(count_stats, stats.end());
+  EXPECT_EQ(count_stats->dispatched_count, 1);
+  EXPECT_EQ(count_stats->merged_count, 2);
+}
+
+// Death tests run in a child process, and gtest runs them before other tests.
+using EventDispatcherDeathTest = EventDispatcherTest;
+
+// tactile::core::EventDispatcher::push
+TEST_F(EventDispatcherDeathTest, PushTooManyEventTypes)
+{
+  // Event type indices are process-wide and can't be reclaimed, so the types are
+  // registered in a child process to avoid exhausting them for other tests.
+  const auto push_all = [this]<std::size_t... kIndices>(std::index_sequence<kIndices...>) {
+    (mDispatcher.push<IndexedEvent<kIndices>>(), ...);
+  };
+
+  EXPECT_EXIT(
+      {
+        push_all(std::make_index_sequence<kMaxEventTypeCount + 8>());
+        mDispatcher.update();
+
+        const auto queue_count = mDispatcher.get_stats().size();
+        std::exit(queue_count <= kMaxEventTypeCount ? EXIT_SUCCESS : EXIT_FAILURE);
+      },
+      testing::ExitedWithCode(EXIT_SUCCESS),
+      "");
+}
+
+// tactile::core::try_merge_events
+TEST(Events, TryMergeOffsetViewportEvents)
+{
+  const auto viewport_a = static_cast<EntityID>(1);
+  const auto viewport_b = static_cast<EntityID>(2);
+
+  OffsetViewportEvent event {viewport_a, Float2 {1.0f, 2.0f}};
+
+  EXPECT_TRUE(try_merge_events(event, OffsetViewportEvent {viewport_a, Float2 {3.0f, 4.0f}}));
+  EXPECT_EQ(event.delta, (Float2 {4.0f, 6.0f}));
+
+  EXPECT_FALSE(try_merge_events(event, OffsetViewportEvent {viewport_b, Float2 {1.0f, 1.0f}}));
+  EXPECT_EQ(event.delta, (Float2 {4.0f, 6.0f}));
+}
+
 }  // namespace
 }  // namespace tactile::core
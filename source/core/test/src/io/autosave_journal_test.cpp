@@ -0,0 +1,160 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/autosave_journal.hpp"
+
+#include <vector>  // vector
+
+#include <gtest/gtest.h>
+
+#include "tactile/test_util/ir.hpp"
+
+namespace tactile::core {
+namespace {
+
+[[nodiscard]]
+auto _make_journal(const std::vector<std::vector<JournalTileRow>>& records) -> ByteStream
+{
+  auto journal = make_journal_header();
+
+  for (const auto& rows : records) {
+    encode_journal_record(rows, journal);
+  }
+
+  return journal;
+}
+
+// tactile::core::encode_journal_record
+// tactile::core::decode_journal
+TEST(AutosaveJournal, EncodeAndDecode)
+{
+  const std::vector<JournalTileRow> record1 {
+    JournalTileRow {.layer_id = 1, .row = 0, .tiles = {1, 2, 3}},
+    JournalTileRow {.layer_id = 2, .row = 4, .tiles = {0, 0, 7}},
+  };
+  const std::vector<JournalTileRow> record2 {
+    JournalTileRow {.layer_id = 1, .row = 0, .tiles = {4, 5, 6}},
+  };
+
+  const auto journal = _make_journal({record1, record2});
+  const auto rows = decode_journal(journal);
+  ASSERT_TRUE(rows.has_value());
+
+  ASSERT_EQ(rows->size(), 3);
+  EXPECT_EQ(rows->at(0), record1.at(0));
+  EXPECT_EQ(rows->at(1), record1.at(1));
+  EXPECT_EQ(rows->at(2), record2.at(0));
+}
+
+// tactile::core::decode_journal
+TEST(AutosaveJournal, DecodeEmptyJournal)
+{
+  const auto journal = make_journal_header();
+  const auto rows = decode_journal(journal);
+
+  ASSERT_TRUE(rows.has_value());
+  EXPECT_TRUE(rows->empty());
+}
+
+// tactile::core::decode_journal
+TEST(AutosaveJournal, DecodeInvalidHeader)
+{
+  auto journal = make_journal_header();
+  journal.front() = 'X';
+
+  EXPECT_EQ(decode_journal(journal), std::unexpected {ErrorCode::kParseError});
+  EXPECT_EQ(decode_journal(ByteStream {}), std::unexpected {ErrorCode::kParseError});
+}
+
+// tactile::core::decode_journal
+TEST(AutosaveJournal, DecodeTruncatedRecord)
+{
+  const std::vector<JournalTileRow> record1 {
+    JournalTileRow {.layer_id = 1, .row = 2, .tiles = {1, 2, 3}},
+  };
+  const std::vector<JournalTileRow> record2 {
+    JournalTileRow {.layer_id = 1, .row = 3, .tiles = {4, 5, 6}},
+  };
+
+  auto journal = _make_journal({record1, record2});
+  journal.resize(journal.size() - 1);
+
+  const auto rows = decode_journal(journal);
+  ASSERT_TRUE(rows.has_value());
+
+  ASSERT_EQ(rows->size(), 1);
+  EXPECT_EQ(rows->front(), record1.front());
+}
+
+// tactile::core::decode_journal
+TEST(AutosaveJournal, DecodeCorruptRecord)
+{
+  const std::vector<JournalTileRow> record1 {
+    JournalTileRow {.layer_id = 1, .row = 2, .tiles = {1, 2, 3}},
+  };
+  const std::vector<JournalTileRow> record2 {
+    JournalTileRow {.layer_id = 1, .row = 3, .tiles = {4, 5, 6}},
+  };
+
+  auto journal = _make_journal({record1, record2});
+  journal.back() ^= 0xFF;
+
+  const auto rows = decode_journal(journal);
+  ASSERT_TRUE(rows.has_value());
+
+  ASSERT_EQ(rows->size(), 1);
+  EXPECT_EQ(rows->front(), record1.front());
+}
+
+// tactile::core::apply_journal
+TEST(AutosaveJournal, ApplyJournal)
+{
+  const Extent2D extent {3, 2};
+
+  auto ir_map = test::make_ir_map(extent);
+  ir_map.layers.push_back(test::make_ir_tile_layer(1, extent));
+  ir_map.layers.push_back(
+      test::make_ir_group_layer(2, {test::make_ir_tile_layer(3, extent)}));
+
+  const std::vector<JournalTileRow> rows {
+    JournalTileRow {.layer_id = 1, .row = 0, .tiles = {1, 2}},
+    JournalTileRow {.layer_id = 3, .row = 2, .tiles = {3, 4}},
+    JournalTileRow {.layer_id = 1, .row = 0, .tiles = {5, 6}},
+  };
+
+  ASSERT_TRUE(apply_journal(rows, ir_map).has_value());
+
+  EXPECT_EQ(ir_map.layers.at(0).tiles.at(0), (TileRow {5, 6}));
+  EXPECT_EQ(ir_map.layers.at(0).tiles.at(1), (TileRow {0, 0}));
+  EXPECT_EQ(ir_map.layers.at(1).layers.at(0).tiles.at(2), (TileRow {3, 4}));
+}
+
+// tactile::core::apply_journal
+TEST(AutosaveJournal, ApplyInvalidJournal)
+{
+  const Extent2D extent {3, 2};
+
+  auto ir_map = test::make_ir_map(extent);
+  ir_map.layers.push_back(test::make_ir_tile_layer(1, extent));
+  ir_map.layers.push_back(test::make_ir_group_layer(2, {}));
+
+  const std::vector<JournalTileRow> unknown_layer {
+    JournalTileRow {.layer_id = 9, .row = 0, .tiles = {1, 2}},
+  };
+  const std::vector<JournalTileRow> group_layer {
+    JournalTileRow {.layer_id = 2, .row = 0, .tiles = {1, 2}},
+  };
+  const std::vector<JournalTileRow> bad_row {
+    JournalTileRow {.layer_id = 1, .row = 3, .tiles = {1, 2}},
+  };
+  const std::vector<JournalTileRow> bad_row_size {
+    JournalTileRow {.layer_id = 1, .row = 0, .tiles = {1, 2, 3}},
+  };
+
+  EXPECT_EQ(apply_journal(unknown_layer, ir_map), std::unexpected {ErrorCode::kBadState});
+  EXPECT_EQ(apply_journal(group_layer, ir_map), std::unexpected {ErrorCode::kBadState});
+  EXPECT_EQ(apply_journal(bad_row, ir_map), std::unexpected {ErrorCode::kBadState});
+  EXPECT_EQ(apply_journal(bad_row_size, ir_map), std::unexpected {ErrorCode::kBadState});
+}
+
+}  // namespace
+}  // namespace tactile::core
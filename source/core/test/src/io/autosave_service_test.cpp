@@ -0,0 +1,430 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/autosave_service.hpp"
+
+#include <cstddef>     // size_t
+#include <cstdint>     // uint32_t
+#include <filesystem>  // path, temp_directory_path, create_directories, remove_all
+#include <fstream>     // ofstream
+#include <optional>    // optional
+#include <utility>     // move
+
+#include <gtest/gtest.h>
+
+#include "tactile/base/io/save/save_format.hpp"
+#include "tactile/base/render/renderer_options.hpp"
+#include "tactile/base/runtime/runtime.hpp"
+#include "tactile/core/cmd/command_stack.hpp"
+#include "tactile/core/cmd/layer/create_layer_command.hpp"
+#include "tactile/core/cmd/layer/set_layer_opacity_command.hpp"
+#include "tactile/core/cmd/layer/set_layer_tiles_command.hpp"
+#include "tactile/core/document/document_info.hpp"
+#include "tactile/core/document/document_manager.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/io/autosave_journal.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
+#include "tactile/core/map/map.hpp"
+#include "tactile/null_renderer/null_renderer.hpp"
+#include "tactile/test_util/ir.hpp"
+
+namespace tactile::core {
+namespace {
+
+/**
+ * A save format that writes placeholder checkpoints and loads a fixed map.
+ */
+class AutosaveTestSaveFormat final : public ISaveFormat
+{
+ public:
+  explicit AutosaveTestSaveFormat(ir::Map ir_map)
+    : m_ir_map {std::move(ir_map)}
+  {}
+
+  [[nodiscard]]
+  auto load_map(const std::filesystem::path& map_path,
+                const SaveFormatReadOptions&) const
+      -> std::expected<ir::Map, ErrorCode> override
+  {
+    if (!std::filesystem::exists(map_path)) {
+      return std::unexpected {ErrorCode::kBadFileStream};
+    }
+
+    return m_ir_map;
+  }
+
+  [[nodiscard]]
+  auto save_map(const IMapView& map, const SaveFormatWriteOptions&) const
+      -> std::expected<void, ErrorCode> override
+  {
+    std::ofstream stream {*map.get_path(), std::ios::out | std::ios::trunc};
+    stream << "checkpoint";
+
+    ++m_save_count;
+    return {};
+  }
+
+  [[nodiscard]]
+  auto save_count() const -> std::size_t
+  {
+    return m_save_count;
+  }
+
+ private:
+  ir::Map m_ir_map;
+  mutable std::size_t m_save_count {0};
+};
+
+/**
+ * A runtime that only provides a save format and a renderer.
+ */
+class AutosaveTestRuntime final : public IRuntime
+{
+ public:
+  AutosaveTestRuntime(ISaveFormat* save_format, IRenderer* renderer)
+    : m_save_format {save_format},
+      m_renderer {renderer}
+  {}
+
+  void init_window(std::uint32_t) override
+  {}
+
+  void set_renderer(IRenderer*) override
+  {}
+
+  void set_compression_format(CompressionFormatId, ICompressionFormat*) override
+  {}
+
+  void set_save_format(SaveFormatId, ISaveFormat*) override
+  {}
+
+  [[nodiscard]]
+  auto get_window() -> IWindow* override
+  {
+    return nullptr;
+  }
+
+  [[nodiscard]]
+  auto get_renderer() -> IRenderer* override
+  {
+    return m_renderer;
+  }
+
+  [[nodiscard]]
+  auto get_compression_format(CompressionFormatId) const -> const ICompressionFormat* override
+  {
+    return nullptr;
+  }
+
+  [[nodiscard]]
+  auto get_save_format(SaveFormatId) const -> const ISaveFormat* override
+  {
+    return m_save_format;
+  }
+
+  [[nodiscard]]
+  auto get_external_tileset_cache() const -> IExternalTilesetCache* override
+  {
+    return nullptr;
+  }
+
+  void get_imgui_allocator_functions(imgui_malloc_fn**, imgui_free_fn**, void**) override
+  {}
+
+  [[nodiscard]]
+  auto get_renderer_options() const -> const RendererOptions& override
+  {
+    return m_renderer_options;
+  }
+
+  [[nodiscard]]
+  auto get_logger() const -> log::Logger* override
+  {
+    return nullptr;
+  }
+
+ private:
+  ISaveFormat* m_save_format;
+  IRenderer* m_renderer;
+  RendererOptions m_renderer_options {};
+};
+
+[[nodiscard]]
+auto _make_test_ir_map() -> ir::Map
+{
+  auto ir_map = test::make_ir_map(Extent2D {4, 4});
+  ir_map.layers.push_back(test::make_ir_tile_layer(LayerID {1}, ir_map.extent));
+  ir_map.next_layer_id = 2;
+  return ir_map;
+}
+
+class AutosaveServiceTest : public testing::Test
+{
+ public:
+  void SetUp() override
+  {
+    std::filesystem::remove_all(mDir);
+    std::filesystem::create_directories(mDir);
+
+    const auto document_uuid = mDocuments.create_and_open_map(mRenderer, _make_test_ir_map());
+    ASSERT_TRUE(document_uuid.has_value());
+    mDocumentUuid = *document_uuid;
+  }
+
+  void TearDown() override
+  {
+    std::filesystem::remove_all(mDir);
+  }
+
+ protected:
+  std::filesystem::path mDir {std::filesystem::temp_directory_path() /
+                              "tactile-autosave-service-test"};
+  NullRenderer mRenderer {nullptr};
+  AutosaveTestSaveFormat mSaveFormat {_make_test_ir_map()};
+  AutosaveTestRuntime mRuntime {&mSaveFormat, &mRenderer};
+  DocumentManager mDocuments {};
+  UUID mDocumentUuid {};
+
+  [[nodiscard]]
+  auto get_document(DocumentManager& documents, const UUID& uuid) -> MapDocument&
+  {
+    return dynamic_cast<MapDocument&>(documents.get_document(uuid));
+  }
+
+  [[nodiscard]]
+  auto get_tile_layer(DocumentManager& documents, const UUID& uuid) -> EntityID
+  {
+    const auto& registry = get_document(documents, uuid).get_registry();
+    const auto& map = registry.get<CMap>(registry.get<CDocumentInfo>().root);
+    return registry.get<CGroupLayer>(map.root_layer).layers.front();
+  }
+
+  void set_tile(const Index2D& index, const TileID tile_id)
+  {
+    mDocuments.get_history(mDocumentUuid)
+        .push<SetLayerTilesCommand>(&get_document(mDocuments, mDocumentUuid),
+                                    get_tile_layer(mDocuments, mDocumentUuid),
+                                    SparseTileMatrix {{index, tile_id}});
+  }
+
+  void set_opacity(const float opacity)
+  {
+    mDocuments.get_history(mDocumentUuid)
+        .push<SetLayerOpacityCommand>(&get_document(mDocuments, mDocumentUuid),
+                                      get_tile_layer(mDocuments, mDocumentUuid),
+                                      opacity);
+  }
+
+  [[nodiscard]]
+  auto count_files() const -> std::size_t
+  {
+    std::size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator {mDir}) {
+      if (entry.is_regular_file()) {
+        ++count;
+      }
+    }
+
+    return count;
+  }
+
+  [[nodiscard]]
+  auto count_journaled_rows() const -> std::size_t
+  {
+    std::size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator {mDir}) {
+      if (entry.path().extension() == ".journal") {
+        const auto rows = read_journal(entry.path());
+        count += rows.has_value() ? rows->size() : 0;
+      }
+    }
+
+    return count;
+  }
+};
+
+// tactile::core::AutosaveService::save
+TEST_F(AutosaveServiceTest, SaveUnmodifiedDocument)
+{
+  {
+    AutosaveService autosave_service {&mRuntime, mDir};
+    autosave_service.save(mDocuments);
+    autosave_service.save(mDocuments);
+    autosave_service.save(mDocuments);
+  }
+
+  EXPECT_EQ(mSaveFormat.save_count(), 0);
+  EXPECT_EQ(count_files(), 0);
+}
+
+// tactile::core::AutosaveService::save
+TEST_F(AutosaveServiceTest, JournalTileEdits)
+{
+  {
+    AutosaveService autosave_service {&mRuntime, mDir};
+
+    // The first change always results in a checkpoint.
+    set_tile(Index2D {.x = 0, .y = 0}, TileID {1});
+    autosave_service.save(mDocuments);
+    EXPECT_EQ(mSaveFormat.save_count(), 1);
+
+    set_tile(Index2D {.x = 1, .y = 2}, TileID {2});
+    autosave_service.save(mDocuments);
+
+    set_tile(Index2D {.x = 2, .y = 2}, TileID {3});
+    autosave_service.save(mDocuments);
+
+    EXPECT_EQ(mSaveFormat.save_count(), 1);
+  }
+
+  // The checkpoint, the journal and the manifest.
+  EXPECT_EQ(count_files(), 3);
+  EXPECT_EQ(count_journaled_rows(), 2);
+}
+
+// tactile::core::AutosaveService::save
+TEST_F(AutosaveServiceTest, SaveWithoutNewEdits)
+{
+  AutosaveService autosave_service {&mRuntime, mDir};
+
+  set_tile(Index2D {.x = 0, .y = 0}, TileID {1});
+  autosave_service.save(mDocuments);
+  autosave_service.save(mDocuments);
+  autosave_service.save(mDocuments);
+
+  EXPECT_EQ(mSaveFormat.save_count(), 1);
+  EXPECT_EQ(count_journaled_rows(), 0);
+}
+
+// tactile::core::AutosaveService::save
+TEST_F(AutosaveServiceTest, SaveDocumentWithCreatedLayer)
+{
+  AutosaveService autosave_service {&mRuntime, mDir};
+
+  mDocuments.get_history(mDocumentUuid)
+      .push<CreateLayerCommand>(&get_document(mDocuments, mDocumentUuid),
+                                LayerType::kTileLayer);
+
+  autosave_service.save(mDocuments);
+  autosave_service.save(mDocuments);
+  EXPECT_EQ(mSaveFormat.save_count(), 1);
+
+  set_tile(Index2D {.x = 0, .y = 0}, TileID {1});
+  autosave_service.save(mDocuments);
+  EXPECT_EQ(mSaveFormat.save_count(), 1);
+}
+
+// tactile::core::AutosaveService::save
+TEST_F(AutosaveServiceTest, CheckpointStructuralChanges)
+{
+  {
+    AutosaveService autosave_service {&mRuntime, mDir};
+
+    set_tile(Index2D {.x = 0, .y = 0}, TileID {1});
+    autosave_service.save(mDocuments);
+    EXPECT_EQ(mSaveFormat.save_count(), 1);
+
+    set_opacity(0.5f);
+    autosave_service.save(mDocuments);
+    EXPECT_EQ(mSaveFormat.save_count(), 2);
+
+    // Undoing a structural change is a structural change as well.
+    mDocuments.get_history(mDocumentUuid).undo();
+    autosave_service.save(mDocuments);
+    EXPECT_EQ(mSaveFormat.save_count(), 3);
+  }
+
+  // Files of previous checkpoints are removed.
+  EXPECT_EQ(count_files(), 3);
+  EXPECT_EQ(count_journaled_rows(), 0);
+}
+
+// tactile::core::AutosaveService::request_checkpoint
+TEST_F(AutosaveServiceTest, RequestCheckpoint)
+{
+  AutosaveService autosave_service {&mRuntime, mDir};
+  autosave_service.request_checkpoint(mDocumentUuid);
+
+  autosave_service.save(mDocuments);
+  EXPECT_EQ(mSaveFormat.save_count(), 1);
+
+  autosave_service.save(mDocuments);
+  EXPECT_EQ(mSaveFormat.save_count(), 1);
+}
+
+// tactile::core::recover_autosaved_maps
+TEST_F(AutosaveServiceTest, RecoverAutosavedMaps)
+{
+  {
+    AutosaveService autosave_service {&mRuntime, mDir};
+
+    set_opacity(0.5f);
+    autosave_service.save(mDocuments);
+
+    set_tile(Index2D {.x = 3, .y = 1}, TileID {42});
+    autosave_service.save(mDocuments);
+  }
+
+  DocumentManager recovered_documents {};
+  const auto recovered_uuids = recover_autosaved_maps(mRuntime, mDir, recovered_documents);
+  ASSERT_EQ(recovered_uuids.size(), 1);
+
+  const auto& recovered_uuid = recovered_uuids.front();
+  EXPECT_FALSE(recovered_documents.get_history(recovered_uuid).is_clean());
+
+  const auto& registry = get_document(recovered_documents, recovered_uuid).get_registry();
+  const auto layer_entity = get_tile_layer(recovered_documents, recovered_uuid);
+  EXPECT_EQ(get_layer_tile(registry, layer_entity, Index2D {.x = 3, .y = 1}), TileID {42});
+  EXPECT_EQ(get_layer_tile(registry, layer_entity, Index2D {.x = 0, .y = 0}), kEmptyTile);
+}
+
+// tactile::core::recover_autosaved_maps
+TEST_F(AutosaveServiceTest, RecoverWithoutAutosaveData)
+{
+  DocumentManager recovered_documents {};
+  EXPECT_TRUE(recover_autosaved_maps(mRuntime, mDir, recovered_documents).empty());
+}
+
+// tactile::core::AutosaveService::clear
+TEST_F(AutosaveServiceTest, Clear)
+{
+  AutosaveService autosave_service {&mRuntime, mDir};
+
+  set_tile(Index2D {.x = 0, .y = 0}, TileID {1});
+  autosave_service.save(mDocuments);
+
+  autosave_service.clear();
+  EXPECT_EQ(count_files(), 0);
+}
+
+// tactile::core::AutosaveService::finish
+TEST_F(AutosaveServiceTest, FinishWithModifiedDocument)
+{
+  {
+    AutosaveService autosave_service {&mRuntime, mDir};
+
+    set_tile(Index2D {.x = 0, .y = 0}, TileID {1});
+    autosave_service.finish(mDocuments);
+  }
+
+  DocumentManager recovered_documents {};
+  EXPECT_EQ(recover_autosaved_maps(mRuntime, mDir, recovered_documents).size(), 1);
+}
+
+// tactile::core::AutosaveService::finish
+TEST_F(AutosaveServiceTest, FinishWithSavedDocument)
+{
+  AutosaveService autosave_service {&mRuntime, mDir};
+
+  set_tile(Index2D {.x = 0, .y = 0}, TileID {1});
+  autosave_service.save(mDocuments);
+
+  mDocuments.get_history(mDocumentUuid).mark_as_clean();
+
+  autosave_service.finish(mDocuments);
+  EXPECT_EQ(count_files(), 0);
+}
+
+}  // namespace
+}  // namespace tactile::core
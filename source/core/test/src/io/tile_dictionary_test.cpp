@@ -0,0 +1,282 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/tile_dictionary.hpp"
+
+#include <cstddef>     // size_t
+#include <expected>    // expected, unexpected
+#include <filesystem>  // path, temp_directory_path, create_directories, remove_all, exists
+#include <fstream>     // ofstream
+#include <ios>         // ios, streamsize
+#include <span>        // span
+#include <string>      // string
+
+#include <gtest/gtest.h>
+
+#include "tactile/base/io/compress/compression_format.hpp"
+#include "tactile/test_util/document_view_mocks.hpp"
+#include "tactile/test_util/ir.hpp"
+
+namespace tactile::core {
+namespace {
+
+/**
+ * A compression format that records the samples it's trained on.
+ */
+class CompressionFormatStub final : public ICompressionFormat
+{
+ public:
+  inline static const ByteStream kDictionary {1, 2, 3, 4};
+
+  auto compress(ByteSpan, const CompressionOptions&) const
+      -> std::expected<ByteStream, ErrorCode> override
+  {
+    return std::unexpected {ErrorCode::kNotSupported};
+  }
+
+  auto decompress(ByteSpan, const DecompressionOptions&) const
+      -> std::expected<ByteStream, ErrorCode> override
+  {
+    return std::unexpected {ErrorCode::kNotSupported};
+  }
+
+  auto train_dictionary(const std::span<const ByteSpan> samples,
+                        const std::size_t max_dictionary_size) const
+      -> std::expected<ByteStream, ErrorCode> override
+  {
+    sample_count = samples.size();
+    sample_byte_count = 0;
+
+    for (const auto& sample : samples) {
+      sample_byte_count += sample.size();
+    }
+
+    EXPECT_EQ(max_dictionary_size, kMaxTileDictionarySize);
+    return kDictionary;
+  }
+
+  mutable std::size_t sample_count {0};
+  mutable std::size_t sample_byte_count {0};
+};
+
+class TileDictionaryTest : public testing::Test
+{
+ public:
+  void SetUp() override
+  {
+    std::filesystem::remove_all(mMapDir);
+    std::filesystem::create_directories(mMapDir);
+  }
+
+  void TearDown() override
+  {
+    std::filesystem::remove_all(mMapDir);
+  }
+
+ protected:
+  std::filesystem::path mMapDir {std::filesystem::temp_directory_path() /
+                                 "tactile-tile-dictionary-test"};
+  std::filesystem::path mMapPath {mMapDir / "map.tmj"};
+};
+
+[[nodiscard]]
+auto _make_map() -> ir::Map
+{
+  auto map = test::make_ir_map(Extent2D {.rows = 100, .cols = 100});
+  map.layers.push_back(test::make_ir_tile_layer(1, map.extent));
+  map.layers.push_back(test::make_ir_object_layer(2));
+  map.layers.push_back(test::make_ir_tile_layer(3, map.extent));
+  return map;
+}
+
+[[nodiscard]]
+auto _make_map_with_dictionary() -> ir::Map
+{
+  auto map = _make_map();
+  map.meta.properties.push_back(ir::NamedAttribute {
+    .name = std::string {kTileDictionaryProperty},
+    .value = Attribute {true},
+  });
+  return map;
+}
+
+void _write_dictionary(const std::filesystem::path& path)
+{
+  std::ofstream stream {path, std::ios::out | std::ios::binary | std::ios::trunc};
+  stream.write(reinterpret_cast<const char*>(CompressionFormatStub::kDictionary.data()),
+               static_cast<std::streamsize>(CompressionFormatStub::kDictionary.size()));
+}
+
+// tactile::core::get_tile_dictionary_path
+TEST_F(TileDictionaryTest, GetTileDictionaryPath)
+{
+  EXPECT_EQ(get_tile_dictionary_path(mMapPath), mMapDir / "map.tmj.dict");
+}
+
+// tactile::core::uses_tile_dictionary
+TEST_F(TileDictionaryTest, UsesTileDictionary)
+{
+  ir::Metadata meta {};
+  EXPECT_FALSE(uses_tile_dictionary(meta));
+
+  meta.properties.push_back(ir::NamedAttribute {
+    .name = std::string {kTileDictionaryProperty},
+    .value = Attribute {"foo.dict"},
+  });
+  EXPECT_FALSE(uses_tile_dictionary(meta));
+
+  meta.properties.front().value = Attribute {false};
+  EXPECT_FALSE(uses_tile_dictionary(meta));
+
+  meta.properties.front().value = Attribute {true};
+  EXPECT_TRUE(uses_tile_dictionary(meta));
+
+  const testing::NiceMock<test::MetaViewMock> meta_view {meta};
+  EXPECT_TRUE(uses_tile_dictionary(meta_view));
+}
+
+// tactile::core::load_tile_dictionary
+// tactile::core::load_tile_dictionary_for_reading
+TEST_F(TileDictionaryTest, LoadMissingDictionary)
+{
+  EXPECT_EQ(load_tile_dictionary(get_tile_dictionary_path(mMapPath)),
+            std::unexpected {ErrorCode::kBadFileStream});
+  EXPECT_TRUE(load_tile_dictionary_for_reading(mMapPath).empty());
+}
+
+// tactile::core::train_tile_dictionary
+// tactile::core::load_tile_dictionary_for_reading
+TEST_F(TileDictionaryTest, TrainAndLoadDictionary)
+{
+  const CompressionFormatStub compression_format {};
+  const testing::NiceMock<test::MapViewMock> map_view {_make_map()};
+
+  ASSERT_TRUE(train_tile_dictionary(compression_format, map_view, mMapPath).has_value());
+
+  // Two tile layers with 100x100 tiles, each of which is stored as 4 bytes.
+  EXPECT_EQ(compression_format.sample_byte_count, std::size_t {2 * 100 * 100 * 4});
+  EXPECT_GT(compression_format.sample_count, 2);
+
+  EXPECT_TRUE(std::filesystem::exists(get_tile_dictionary_path(mMapPath)));
+  EXPECT_EQ(load_tile_dictionary_for_reading(mMapPath), CompressionFormatStub::kDictionary);
+}
+
+// tactile::core::train_tile_dictionary
+TEST_F(TileDictionaryTest, TrainWithExistingDictionary)
+{
+  const CompressionFormatStub compression_format {};
+  const testing::NiceMock<test::MapViewMock> map_view {_make_map()};
+
+  ASSERT_TRUE(train_tile_dictionary(compression_format, map_view, mMapPath).has_value());
+  EXPECT_EQ(train_tile_dictionary(compression_format, map_view, mMapPath),
+            std::unexpected {ErrorCode::kBadOperation});
+
+  EXPECT_EQ(load_tile_dictionary_for_reading(mMapPath), CompressionFormatStub::kDictionary);
+}
+
+// tactile::core::train_tile_dictionary
+TEST_F(TileDictionaryTest, TrainForMapThatUsesDictionary)
+{
+  const CompressionFormatStub compression_format {};
+  const testing::NiceMock<test::MapViewMock> map_view {_make_map_with_dictionary()};
+
+  EXPECT_EQ(train_tile_dictionary(compression_format, map_view, mMapPath),
+            std::unexpected {ErrorCode::kBadOperation});
+  EXPECT_FALSE(std::filesystem::exists(get_tile_dictionary_path(mMapPath)));
+}
+
+// tactile::core::load_tile_dictionary_for_writing
+TEST_F(TileDictionaryTest, LoadForWritingWithoutOptIn)
+{
+  _write_dictionary(get_tile_dictionary_path(mMapPath));
+
+  const testing::NiceMock<test::MapViewMock> map_view {_make_map()};
+  const auto dictionary = load_tile_dictionary_for_writing(mMapPath, map_view);
+
+  ASSERT_TRUE(dictionary.has_value());
+  EXPECT_TRUE(dictionary->empty());
+}
+
+// tactile::core::load_tile_dictionary_for_writing
+TEST_F(TileDictionaryTest, LoadForWritingWithOptIn)
+{
+  _write_dictionary(get_tile_dictionary_path(mMapPath));
+
+  const testing::NiceMock<test::MapViewMock> map_view {_make_map_with_dictionary()};
+  EXPECT_EQ(load_tile_dictionary_for_writing(mMapPath, map_view),
+            CompressionFormatStub::kDictionary);
+}
+
+// tactile::core::load_tile_dictionary_for_writing
+TEST_F(TileDictionaryTest, LoadForWritingWithMissingDictionary)
+{
+  const testing::NiceMock<test::MapViewMock> map_view {_make_map_with_dictionary()};
+  EXPECT_EQ(load_tile_dictionary_for_writing(mMapPath, map_view),
+            std::unexpected {ErrorCode::kBadFileStream});
+}
+
+// tactile::core::validate_tile_dictionary
+TEST_F(TileDictionaryTest, ValidateTileDictionary)
+{
+  EXPECT_TRUE(validate_tile_dictionary(mMapPath, _make_map()).has_value());
+
+  const auto map = _make_map_with_dictionary();
+  EXPECT_EQ(validate_tile_dictionary(mMapPath, map),
+            std::unexpected {ErrorCode::kNoSuchFile});
+
+  // Only the dictionary associated with the map file is used.
+  _write_dictionary(mMapDir / "a.dict");
+  EXPECT_EQ(validate_tile_dictionary(mMapPath, map),
+            std::unexpected {ErrorCode::kNoSuchFile});
+
+  _write_dictionary(get_tile_dictionary_path(mMapPath));
+  EXPECT_TRUE(validate_tile_dictionary(mMapPath, map).has_value());
+}
+
+// tactile::core::copy_tile_dictionary
+TEST_F(TileDictionaryTest, CopyTileDictionary)
+{
+  const auto new_map_path = mMapDir / "copy.tmj";
+
+  EXPECT_EQ(copy_tile_dictionary(mMapPath, new_map_path),
+            std::unexpected {ErrorCode::kBadFileCopy});
+
+  _write_dictionary(get_tile_dictionary_path(mMapPath));
+  EXPECT_TRUE(copy_tile_dictionary(mMapPath, mMapPath).has_value());
+  EXPECT_TRUE(copy_tile_dictionary(mMapPath, new_map_path).has_value());
+
+  EXPECT_EQ(load_tile_dictionary(get_tile_dictionary_path(new_map_path)),
+            CompressionFormatStub::kDictionary);
+}
+
+// tactile::core::train_tile_dictionary
+// tactile::core::copy_tile_dictionary
+// tactile::core::load_tile_dictionary_for_writing
+// tactile::core::load_tile_dictionary_for_reading
+TEST_F(TileDictionaryTest, SaveAsRoundtrip)
+{
+  const CompressionFormatStub compression_format {};
+  const auto new_map_path = mMapDir / "copy.tmj";
+
+  const testing::NiceMock<test::MapViewMock> training_map_view {_make_map()};
+  ASSERT_TRUE(
+      train_tile_dictionary(compression_format, training_map_view, mMapPath).has_value());
+
+  const auto map = _make_map_with_dictionary();
+  const testing::NiceMock<test::MapViewMock> map_view {map};
+
+  // Saving to the new path must not silently use another dictionary.
+  EXPECT_EQ(load_tile_dictionary_for_writing(new_map_path, map_view),
+            std::unexpected {ErrorCode::kBadFileStream});
+
+  ASSERT_TRUE(copy_tile_dictionary(mMapPath, new_map_path).has_value());
+
+  // The map is read back with the same dictionary that it was written with.
+  const auto write_dictionary = load_tile_dictionary_for_writing(new_map_path, map_view);
+  ASSERT_TRUE(write_dictionary.has_value());
+  EXPECT_EQ(*write_dictionary, CompressionFormatStub::kDictionary);
+  EXPECT_EQ(load_tile_dictionary_for_reading(new_map_path), *write_dictionary);
+  EXPECT_TRUE(validate_tile_dictionary(new_map_path, map).has_value());
+}
+
+}  // namespace
+}  // namespace tactile::core
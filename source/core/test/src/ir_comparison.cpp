@@ -2,7 +2,7 @@
 
 #include "tactile/core/test/ir_comparison.hpp"
 
-#include <algorithm>  // find_if
+#include <algorithm>  // find_if, max
 
 #include <gtest/gtest.h>
 
@@ -264,7 +264,14 @@ void compare_map(const Registry& registry, const EntityID map_id, const ir::Map&
   ASSERT_EQ(map.attached_tilesets.size(), ir_map.tilesets.size());
   ASSERT_TRUE(is_group_layer(registry, map.root_layer));
 
-  // TODO next_tile_id
+  TileID expected_next_tile_id {1};
+  for (const auto& ir_tileset_ref : ir_map.tilesets) {
+    const auto tileset_end_id = ir_tileset_ref.first_tile_id +
+                                saturate_cast<TileID>(ir_tileset_ref.tileset.tile_count);
+    expected_next_tile_id = std::max(expected_next_tile_id, tileset_end_id);
+  }
+
+  EXPECT_EQ(id_cache.next_tile_id, expected_next_tile_id);
   EXPECT_EQ(id_cache.next_layer_id, ir_map.next_layer_id);
   EXPECT_EQ(id_cache.next_object_id, ir_map.next_object_id);
 
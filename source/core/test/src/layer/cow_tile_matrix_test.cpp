@@ -0,0 +1,100 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/layer/cow_tile_matrix.hpp"
+
+#include <gtest/gtest.h>
+
+namespace tactile::core {
+namespace {
+
+// tactile::core::CowTileMatrix::CowTileMatrix [const Extent2D&]
+TEST(CowTileMatrix, ExtentConstructor)
+{
+  constexpr Extent2D extent {3, 4};
+  const CowTileMatrix matrix {extent};
+
+  EXPECT_EQ(matrix.get_extent(), extent);
+
+  for (Extent2D::value_type row = 0; row < extent.rows; ++row) {
+    for (Extent2D::value_type col = 0; col < extent.cols; ++col) {
+      EXPECT_EQ(matrix.get(Index2D {.x = col, .y = row}), kEmptyTile);
+    }
+  }
+}
+
+// tactile::core::CowTileMatrix::CowTileMatrix [TileMatrix]
+TEST(CowTileMatrix, TileMatrixConstructor)
+{
+  TileMatrix source {
+    TileRow {1, 2, 3},
+    TileRow {4, 5, 6},
+  };
+
+  const CowTileMatrix matrix {source};
+
+  EXPECT_EQ(matrix.get_extent(), (Extent2D {2, 3}));
+  EXPECT_EQ(matrix.to_tile_matrix(), source);
+}
+
+// tactile::core::CowTileMatrix::set
+// tactile::core::CowTileMatrix::shares_row
+TEST(CowTileMatrix, CopyOnWrite)
+{
+  CowTileMatrix original {Extent2D {4, 4}};
+  original.set(Index2D {.x = 1, .y = 2}, TileID {7});
+
+  auto copy = original;
+  for (std::size_t row = 0; row < 4; ++row) {
+    EXPECT_TRUE(copy.shares_row(original, row));
+  }
+
+  copy.set(Index2D {.x = 3, .y = 2}, TileID {9});
+
+  EXPECT_TRUE(copy.shares_row(original, 0));
+  EXPECT_TRUE(copy.shares_row(original, 1));
+  EXPECT_FALSE(copy.shares_row(original, 2));
+  EXPECT_TRUE(copy.shares_row(original, 3));
+
+  EXPECT_EQ(original.get(Index2D {.x = 1, .y = 2}), TileID {7});
+  EXPECT_EQ(original.get(Index2D {.x = 3, .y = 2}), kEmptyTile);
+
+  EXPECT_EQ(copy.get(Index2D {.x = 1, .y = 2}), TileID {7});
+  EXPECT_EQ(copy.get(Index2D {.x = 3, .y = 2}), TileID {9});
+}
+
+// tactile::core::CowTileMatrix::set
+TEST(CowTileMatrix, SetDoesNotAffectOtherEmptyRows)
+{
+  CowTileMatrix matrix {Extent2D {3, 3}};
+  matrix.set(Index2D {.x = 0, .y = 1}, TileID {1});
+
+  EXPECT_EQ(matrix.get(Index2D {.x = 0, .y = 0}), kEmptyTile);
+  EXPECT_EQ(matrix.get(Index2D {.x = 0, .y = 1}), TileID {1});
+  EXPECT_EQ(matrix.get(Index2D {.x = 0, .y = 2}), kEmptyTile);
+}
+
+// tactile::core::CowTileMatrix::resize
+TEST(CowTileMatrix, Resize)
+{
+  CowTileMatrix matrix {Extent2D {2, 2}};
+  matrix.set(Index2D {.x = 0, .y = 0}, TileID {1});
+  matrix.set(Index2D {.x = 1, .y = 1}, TileID {2});
+
+  const auto copy = matrix;
+
+  matrix.resize(Extent2D {3, 4});
+  EXPECT_EQ(matrix.get_extent(), (Extent2D {3, 4}));
+  EXPECT_EQ(matrix.get(Index2D {.x = 0, .y = 0}), TileID {1});
+  EXPECT_EQ(matrix.get(Index2D {.x = 1, .y = 1}), TileID {2});
+  EXPECT_EQ(matrix.get(Index2D {.x = 3, .y = 2}), kEmptyTile);
+
+  matrix.resize(Extent2D {1, 1});
+  EXPECT_EQ(matrix.get_extent(), (Extent2D {1, 1}));
+  EXPECT_EQ(matrix.get(Index2D {.x = 0, .y = 0}), TileID {1});
+
+  EXPECT_EQ(copy.get_extent(), (Extent2D {2, 2}));
+  EXPECT_EQ(copy.get(Index2D {.x = 1, .y = 1}), TileID {2});
+}
+
+}  // namespace
+}  // namespace tactile::core
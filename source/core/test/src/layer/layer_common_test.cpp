@@ -2,6 +2,8 @@
 
 #include "tactile/core/layer/layer_common.hpp"
 
+#include <utility>  // move
+
 #include <gtest/gtest.h>
 
 #include "tactile/core/entity/registry.hpp"
@@ -56,5 +58,45 @@ TEST(LayerCommon, MakeLayerWithGroupLayerIR)
   compare_layer(registry, layer_id, ir_layer);
 }
 
+// tactile::core::make_layer [Registry&, ir::Layer&&]
+TEST(LayerCommon, MakeLayerFromMovedGroupLayerIR)
+{
+  Registry registry {};
+
+  LayerID next_layer_id {7};
+  ObjectID next_object_id {12};
+  const auto ir_layer = test::make_complex_ir_group_layer(next_layer_id, next_object_id);
+
+  auto ir_layer_copy = ir_layer;
+  const auto layer_id = make_layer(registry, std::move(ir_layer_copy));
+  ASSERT_TRUE(is_group_layer(registry, layer_id));
+
+  compare_layer(registry, layer_id, ir_layer);
+}
+
+// tactile::core::copy_layer
+TEST(LayerCommon, CopyDenseTileLayerSharesTiles)
+{
+  Registry registry {};
+
+  const auto source_layer_id = make_tile_layer(registry, Extent2D {4, 4});
+  set_layer_tile(registry, source_layer_id, Index2D {.x = 1, .y = 1}, TileID {42});
+
+  LayerID next_layer_id {1};
+  const auto copy_layer_id = copy_layer(registry, source_layer_id, next_layer_id);
+
+  const auto& source_tiles = registry.get<CDenseTileLayer>(source_layer_id).tiles;
+  const auto& copy_tiles = registry.get<CDenseTileLayer>(copy_layer_id).tiles;
+
+  EXPECT_TRUE(copy_tiles.shares_row(source_tiles, 1));
+
+  set_layer_tile(registry, copy_layer_id, Index2D {.x = 2, .y = 1}, TileID {7});
+
+  EXPECT_FALSE(copy_tiles.shares_row(source_tiles, 1));
+  EXPECT_TRUE(copy_tiles.shares_row(source_tiles, 2));
+  EXPECT_EQ(get_layer_tile(registry, source_layer_id, Index2D {.x = 2, .y = 1}), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(registry, copy_layer_id, Index2D {.x = 1, .y = 1}), TileID {42});
+}
+
 }  // namespace
 }  // namespace tactile::core
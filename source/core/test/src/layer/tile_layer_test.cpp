@@ -2,6 +2,8 @@
 
 #include "tactile/core/layer/tile_layer.hpp"
 
+#include <utility>  // move
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -159,10 +161,10 @@ TEST_P(TileLayerTest, DenseSparseConversion)
 
   {
     auto& dense = mRegistry.get<CDenseTileLayer>(layer_id);
-    dense.tiles.at(0).at(0) = TileID {42};
-    dense.tiles.at(0).at(1) = TileID {73};
-    dense.tiles.at(3).at(2) = TileID {99};
-    dense.tiles.at(5).at(3) = TileID {36};
+    dense.tiles.set(Index2D {0, 0}, TileID {42});
+    dense.tiles.set(Index2D {1, 0}, TileID {73});
+    dense.tiles.set(Index2D {2, 3}, TileID {99});
+    dense.tiles.set(Index2D {3, 5}, TileID {36});
   }
 
   convert_to_sparse_tile_layer(mRegistry, layer_id);
@@ -186,10 +188,10 @@ TEST_P(TileLayerTest, DenseSparseConversion)
 
   {
     const auto& dense = mRegistry.get<CDenseTileLayer>(layer_id);
-    EXPECT_EQ(dense.tiles.at(0).at(0), TileID {42});
-    EXPECT_EQ(dense.tiles.at(0).at(1), TileID {73});
-    EXPECT_EQ(dense.tiles.at(3).at(2), TileID {99});
-    EXPECT_EQ(dense.tiles.at(5).at(3), TileID {36});
+    EXPECT_EQ(dense.tiles.get(Index2D {0, 0}), TileID {42});
+    EXPECT_EQ(dense.tiles.get(Index2D {1, 0}), TileID {73});
+    EXPECT_EQ(dense.tiles.get(Index2D {2, 3}), TileID {99});
+    EXPECT_EQ(dense.tiles.get(Index2D {3, 5}), TileID {36});
   }
 }
 
@@ -211,15 +213,15 @@ TEST_P(TileLayerTest, SerializeTileLayer)
 
   {
     auto& dense = mRegistry.get<CDenseTileLayer>(layer_id);
-    dense.tiles[0][0] = TileID {11};
-    dense.tiles[0][1] = TileID {12};
-    dense.tiles[0][2] = TileID {13};
-    dense.tiles[1][0] = TileID {21};
-    dense.tiles[1][1] = TileID {22};
-    dense.tiles[1][2] = TileID {23};
-    dense.tiles[2][0] = TileID {31};
-    dense.tiles[2][1] = TileID {32};
-    dense.tiles[2][2] = TileID {33};
+    dense.tiles.set(Index2D {0, 0}, TileID {11});
+    dense.tiles.set(Index2D {1, 0}, TileID {12});
+    dense.tiles.set(Index2D {2, 0}, TileID {13});
+    dense.tiles.set(Index2D {0, 1}, TileID {21});
+    dense.tiles.set(Index2D {1, 1}, TileID {22});
+    dense.tiles.set(Index2D {2, 1}, TileID {23});
+    dense.tiles.set(Index2D {0, 2}, TileID {31});
+    dense.tiles.set(Index2D {1, 2}, TileID {32});
+    dense.tiles.set(Index2D {2, 2}, TileID {33});
   }
 
   if (!mTestingDenseLayer) {
@@ -235,7 +237,7 @@ TEST_P(TileLayerTest, SerializeTileLayer)
   convert_to_dense_tile_layer(mRegistry, layer_id);
 
   const auto& dense = mRegistry.get<CDenseTileLayer>(layer_id);
-  EXPECT_THAT(dense.tiles, testing::ContainerEq(*deserialized_tiles));
+  EXPECT_THAT(dense.tiles.to_tile_matrix(), testing::ContainerEq(*deserialized_tiles));
 }
 
 // tactile::core::set_layer_tile
@@ -262,5 +264,88 @@ TEST_P(TileLayerTest, SetLayerTile)
   set_and_verify(Index2D {4, 9}, TileID {865});
 }
 
+// tactile::core::set_layer_tile
+// tactile::core::resize_tile_layer
+TEST_P(TileLayerTest, ModificationsIncreaseRevision)
+{
+  constexpr Extent2D extent {4, 4};
+  const auto layer_id = make_test_layer(extent);
+
+  const auto& tile_layer = mRegistry.get<CTileLayer>(layer_id);
+  const auto initial_revision = tile_layer.revision;
+
+  set_layer_tile(mRegistry, layer_id, Index2D {extent.cols, 0}, TileID {1});
+  EXPECT_EQ(tile_layer.revision, initial_revision);
+
+  set_layer_tile(mRegistry, layer_id, Index2D {1, 2}, TileID {1});
+  EXPECT_GT(tile_layer.revision, initial_revision);
+
+  const auto revision_after_set = tile_layer.revision;
+
+  resize_tile_layer(mRegistry, layer_id, Extent2D {5, 5});
+  EXPECT_GT(tile_layer.revision, revision_after_set);
+}
+
+// tactile::core::make_tile_layer [Registry&, const Extent2D&, TileMatrix]
+TEST(TileLayer, MakeTileLayerFromDenseTileMatrix)
+{
+  Registry registry {};
+
+  const TileMatrix tiles {
+    TileRow {1, 2, 3},
+    TileRow {4, 0, 6},
+  };
+
+  const auto layer_id = make_tile_layer(registry, Extent2D {2, 3}, tiles);
+  ASSERT_TRUE(is_tile_layer(registry, layer_id));
+  ASSERT_TRUE(registry.has<CDenseTileLayer>(layer_id));
+
+  EXPECT_EQ(registry.get<CTileLayer>(layer_id).extent, (Extent2D {2, 3}));
+  EXPECT_EQ(registry.get<CDenseTileLayer>(layer_id).tiles.to_tile_matrix(), tiles);
+}
+
+// tactile::core::make_tile_layer [Registry&, const Extent2D&, TileMatrix]
+TEST(TileLayer, MakeTileLayerFromSparseTileMatrix)
+{
+  Registry registry {};
+
+  constexpr Extent2D extent {20, 20};
+  TileMatrix tiles(extent.rows, TileRow(extent.cols, kEmptyTile));
+  tiles[3][17] = TileID {1};
+  tiles[9][2] = TileID {2};
+  tiles[19][19] = TileID {3};
+
+  const auto layer_id = make_tile_layer(registry, extent, tiles);
+  ASSERT_TRUE(is_tile_layer(registry, layer_id));
+  ASSERT_TRUE(registry.has<CSparseTileLayer>(layer_id));
+
+  EXPECT_EQ(registry.get<CSparseTileLayer>(layer_id).tiles.size(), 3);
+  EXPECT_EQ(get_layer_tile(registry, layer_id, Index2D {.x = 17, .y = 3}), TileID {1});
+  EXPECT_EQ(get_layer_tile(registry, layer_id, Index2D {.x = 2, .y = 9}), TileID {2});
+  EXPECT_EQ(get_layer_tile(registry, layer_id, Index2D {.x = 19, .y = 19}), TileID {3});
+  EXPECT_EQ(get_layer_tile(registry, layer_id, Index2D {.x = 0, .y = 0}), kEmptyTile);
+}
+
+// tactile::core::make_tile_layer [Registry&, const Extent2D&, TileMatrix]
+TEST(TileLayer, MakeTileLayerFromMismatchedTileMatrix)
+{
+  Registry registry {};
+
+  TileMatrix tiles {
+    TileRow {1, 2, 3, 4},
+    TileRow {5},
+  };
+
+  const auto layer_id = make_tile_layer(registry, Extent2D {3, 2}, std::move(tiles));
+  ASSERT_TRUE(is_tile_layer(registry, layer_id));
+
+  EXPECT_EQ(get_layer_tile(registry, layer_id, Index2D {.x = 0, .y = 0}), TileID {1});
+  EXPECT_EQ(get_layer_tile(registry, layer_id, Index2D {.x = 1, .y = 0}), TileID {2});
+  EXPECT_EQ(get_layer_tile(registry, layer_id, Index2D {.x = 0, .y = 1}), TileID {5});
+  EXPECT_EQ(get_layer_tile(registry, layer_id, Index2D {.x = 1, .y = 1}), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(registry, layer_id, Index2D {.x = 0, .y = 2}), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(registry, layer_id, Index2D {.x = 2, .y = 0}), std::nullopt);
+}
+
 }  // namespace
 }  // namespace tactile::core
@@ -213,5 +213,72 @@ TEST_F(MapTest, AddTilesetToMap)
   EXPECT_EQ(mRegistry.count<CTilesetInstance>(), 1);
 }
 
+// tactile::core::add_tileset_to_map
+TEST_F(MapTest, AddTilesetToMapReusesReleasedTileRanges)
+{
+  constexpr MapSpec spec {
+    .orientation = TileOrientation::kOrthogonal,
+    .extent = Extent2D {10, 10},
+    .tile_size = Int2 {32, 32},
+  };
+
+  const auto map_id = make_map(mRegistry, spec);
+  const auto& id_cache = mRegistry.get<CMapIdCache>(map_id);
+
+  const TilesetSpec tileset_spec {
+    .tile_size = Int2 {50, 50},
+    .texture =
+        CTexture {
+          .raw_handle = nullptr,
+          .id = TextureID {42},
+          .size = Int2 {500, 500},
+          .path = "foo/bar.png",
+        },
+  };
+
+  const auto tileset1_id = add_tileset_to_map(mRegistry, map_id, tileset_spec);
+  const auto tileset2_id = add_tileset_to_map(mRegistry, map_id, tileset_spec);
+  ASSERT_TRUE(tileset1_id.has_value());
+  ASSERT_TRUE(tileset2_id.has_value());
+  EXPECT_EQ(id_cache.next_tile_id, TileID {201});
+
+  // The tile range stays reserved until the tileset is destroyed.
+  remove_tileset_from_map(mRegistry, map_id, *tileset1_id);
+  EXPECT_FALSE(is_tile_range_available(mRegistry, TileRange {TileID {1}, 100}));
+
+  destroy_tileset(mRegistry, *tileset1_id);
+  EXPECT_TRUE(is_tile_range_available(mRegistry, TileRange {TileID {1}, 100}));
+
+  const auto tileset3_id = add_tileset_to_map(mRegistry, map_id, tileset_spec);
+  ASSERT_TRUE(tileset3_id.has_value());
+
+  const auto& instance = mRegistry.get<CTilesetInstance>(*tileset3_id);
+  EXPECT_EQ(instance.tile_range.first_id, TileID {1});
+  EXPECT_EQ(instance.tile_range.count, 100);
+  EXPECT_EQ(id_cache.next_tile_id, TileID {201});
+}
+
+// tactile::core::add_layer_to_map
+TEST_F(MapTest, AddLayerToMapAssignsPersistentIds)
+{
+  constexpr MapSpec spec {
+    .orientation = TileOrientation::kOrthogonal,
+    .extent = Extent2D {10, 10},
+    .tile_size = Int2 {32, 32},
+  };
+
+  const auto map_id = make_map(mRegistry, spec);
+  const auto& id_cache = mRegistry.get<CMapIdCache>(map_id);
+
+  const auto tile_layer_id = add_layer_to_map(mRegistry, map_id, LayerType::kTileLayer);
+  const auto object_layer_id = add_layer_to_map(mRegistry, map_id, LayerType::kObjectLayer);
+  ASSERT_TRUE(tile_layer_id.has_value());
+  ASSERT_TRUE(object_layer_id.has_value());
+
+  EXPECT_EQ(mRegistry.get<CLayer>(*tile_layer_id).persistent_id, LayerID {1});
+  EXPECT_EQ(mRegistry.get<CLayer>(*object_layer_id).persistent_id, LayerID {2});
+  EXPECT_EQ(id_cache.next_layer_id, 3);
+}
+
 }  // namespace
 }  // namespace tactile::core
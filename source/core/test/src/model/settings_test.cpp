@@ -14,6 +14,7 @@ TEST(Settings, GetDefaultSettings)
 {
   const auto settings = get_default_settings();
   EXPECT_EQ(settings.language, ui::LanguageID::kAmericanEnglish);
+  EXPECT_EQ(settings.autosave_interval, std::chrono::seconds {30});
   EXPECT_EQ(settings.font_size, 13.0f);
   EXPECT_EQ(settings.log_verbose_events, false);
 }
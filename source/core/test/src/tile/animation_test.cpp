@@ -7,6 +7,7 @@
 #include "tactile/core/entity/registry.hpp"
 #include "tactile/core/tile/animation_types.hpp"
 #include "tactile/core/tile/tile.hpp"
+#include "tactile/core/tile/tileset_types.hpp"
 
 namespace tactile::core {
 namespace {
@@ -57,6 +58,45 @@ TEST(Animation, UpdateAnimations)
   EXPECT_EQ(registry.get<CAnimation>(tile3_entity).frame_index, 0);
 }
 
+// tactile::core::update_animations
+TEST(Animation, UpdateAnimationsAnimationRevision)
+{
+  Registry registry {};
+  const auto& tile_cache = registry.add<CTileCache>();
+
+  const auto tile1_entity = make_tile(registry, TileIndex {1});
+  const auto tile2_entity = make_tile(registry, TileIndex {2});
+
+  constexpr AnimationFrame frame1 {TileIndex {10}, std::chrono::milliseconds::zero()};
+  constexpr AnimationFrame frame2 {TileIndex {20}, std::chrono::milliseconds::zero()};
+  constexpr AnimationFrame frame3 {TileIndex {30}, std::chrono::milliseconds {10'000}};
+
+  ASSERT_TRUE(add_animation_frame(registry, tile1_entity, 0, frame1).has_value());
+  EXPECT_EQ(tile_cache.animation_revision, 1);
+
+  // Single frame animations never change appearance.
+  update_animations(registry);
+  EXPECT_EQ(tile_cache.animation_revision, 1);
+
+  ASSERT_TRUE(add_animation_frame(registry, tile1_entity, 1, frame2).has_value());
+  EXPECT_EQ(tile_cache.animation_revision, 2);
+
+  update_animations(registry);
+  EXPECT_EQ(tile_cache.animation_revision, 3);
+
+  ASSERT_TRUE(remove_animation_frame(registry, tile1_entity, 1).has_value());
+  EXPECT_EQ(tile_cache.animation_revision, 4);
+
+  // The first frame of this animation doesn't finish during the test.
+  ASSERT_TRUE(remove_animation_frame(registry, tile1_entity, 0).has_value());
+  ASSERT_TRUE(add_animation_frame(registry, tile2_entity, 0, frame3).has_value());
+  ASSERT_TRUE(add_animation_frame(registry, tile2_entity, 1, frame1).has_value());
+  EXPECT_EQ(tile_cache.animation_revision, 7);
+
+  update_animations(registry);
+  EXPECT_EQ(tile_cache.animation_revision, 7);
+}
+
 // tactile::core::add_animation_frame
 TEST(Animation, AddAnimationFrame)
 {
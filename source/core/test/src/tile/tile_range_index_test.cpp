@@ -0,0 +1,120 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/tile/tile_range_index.hpp"
+
+#include <gtest/gtest.h>
+
+namespace tactile::core {
+namespace {
+
+// tactile::core::TileRangeIndex::insert
+// tactile::core::TileRangeIndex::get_ranges
+TEST(TileRangeIndex, Insert)
+{
+  TileRangeIndex index {};
+
+  EXPECT_TRUE(index.insert(TileRange {TileID {50}, 10}));
+  EXPECT_TRUE(index.insert(TileRange {TileID {1}, 10}));
+  EXPECT_TRUE(index.insert(TileRange {TileID {100}, 1}));
+  EXPECT_TRUE(index.insert(TileRange {TileID {11}, 39}));
+
+  EXPECT_FALSE(index.insert(TileRange {TileID {0}, 1}));
+  EXPECT_FALSE(index.insert(TileRange {TileID {200}, 0}));
+  EXPECT_FALSE(index.insert(TileRange {TileID {55}, 1}));
+
+  ASSERT_EQ(index.size(), 4);
+
+  const auto ranges = index.get_ranges();
+  EXPECT_EQ(ranges[0], (TileRange {TileID {1}, 10}));
+  EXPECT_EQ(ranges[1], (TileRange {TileID {11}, 39}));
+  EXPECT_EQ(ranges[2], (TileRange {TileID {50}, 10}));
+  EXPECT_EQ(ranges[3], (TileRange {TileID {100}, 1}));
+}
+
+// tactile::core::TileRangeIndex::erase
+TEST(TileRangeIndex, Erase)
+{
+  TileRangeIndex index {};
+  ASSERT_TRUE(index.insert(TileRange {TileID {1}, 10}));
+  ASSERT_TRUE(index.insert(TileRange {TileID {20}, 10}));
+
+  EXPECT_FALSE(index.erase(TileRange {TileID {1}, 5}));
+  EXPECT_FALSE(index.erase(TileRange {TileID {11}, 9}));
+  EXPECT_EQ(index.size(), 2);
+
+  EXPECT_TRUE(index.erase(TileRange {TileID {1}, 10}));
+  EXPECT_EQ(index.size(), 1);
+  EXPECT_TRUE(index.is_available(TileRange {TileID {1}, 19}));
+}
+
+// tactile::core::TileRangeIndex::is_available
+TEST(TileRangeIndex, IsAvailable)
+{
+  TileRangeIndex index {};
+  EXPECT_FALSE(index.is_available(TileRange {TileID {-1}, 10}));
+  EXPECT_FALSE(index.is_available(TileRange {TileID {1}, 0}));
+  EXPECT_TRUE(index.is_available(TileRange {TileID {1}, 10}));
+
+  // [10, 20) and [30, 40)
+  ASSERT_TRUE(index.insert(TileRange {TileID {10}, 10}));
+  ASSERT_TRUE(index.insert(TileRange {TileID {30}, 10}));
+
+  EXPECT_TRUE(index.is_available(TileRange {TileID {1}, 9}));
+  EXPECT_TRUE(index.is_available(TileRange {TileID {20}, 10}));
+  EXPECT_TRUE(index.is_available(TileRange {TileID {40}, 100}));
+
+  EXPECT_FALSE(index.is_available(TileRange {TileID {1}, 10}));
+  EXPECT_FALSE(index.is_available(TileRange {TileID {19}, 2}));
+  EXPECT_FALSE(index.is_available(TileRange {TileID {20}, 11}));
+  EXPECT_FALSE(index.is_available(TileRange {TileID {12}, 2}));
+
+  // Ranges that contain entire reserved ranges
+  EXPECT_FALSE(index.is_available(TileRange {TileID {5}, 20}));
+  EXPECT_FALSE(index.is_available(TileRange {TileID {1}, 100}));
+}
+
+// tactile::core::TileRangeIndex::find_best_fit
+TEST(TileRangeIndex, FindBestFit)
+{
+  TileRangeIndex index {};
+  EXPECT_EQ(index.find_best_fit(100), TileID {1});
+
+  // [1, 11), [31, 41), [46, 56)
+  ASSERT_TRUE(index.insert(TileRange {TileID {1}, 10}));
+  ASSERT_TRUE(index.insert(TileRange {TileID {31}, 10}));
+  ASSERT_TRUE(index.insert(TileRange {TileID {46}, 10}));
+
+  EXPECT_EQ(index.find_best_fit(1), TileID {41});
+  EXPECT_EQ(index.find_best_fit(5), TileID {41});
+  EXPECT_EQ(index.find_best_fit(6), TileID {11});
+  EXPECT_EQ(index.find_best_fit(20), TileID {11});
+  EXPECT_EQ(index.find_best_fit(21), TileID {56});
+}
+
+// tactile::core::TileRangeIndex::compact
+// tactile::core::TileRangeIndex::get_end_id
+TEST(TileRangeIndex, Compact)
+{
+  TileRangeIndex index {};
+  EXPECT_EQ(index.get_end_id(), TileID {1});
+
+  ASSERT_TRUE(index.insert(TileRange {TileID {1}, 10}));
+  ASSERT_TRUE(index.insert(TileRange {TileID {31}, 10}));
+  ASSERT_TRUE(index.insert(TileRange {TileID {46}, 5}));
+  EXPECT_EQ(index.get_end_id(), TileID {51});
+
+  const auto moves = index.compact();
+  ASSERT_EQ(moves.size(), 2);
+
+  EXPECT_EQ(moves[0].old_range, (TileRange {TileID {31}, 10}));
+  EXPECT_EQ(moves[0].new_first_id, TileID {11});
+
+  EXPECT_EQ(moves[1].old_range, (TileRange {TileID {46}, 5}));
+  EXPECT_EQ(moves[1].new_first_id, TileID {21});
+
+  EXPECT_EQ(index.get_end_id(), TileID {26});
+  EXPECT_TRUE(index.compact().empty());
+}
+
+}  // namespace
+}  // namespace tactile::core
@@ -379,6 +379,9 @@ TEST_F(TilesetTest, IsTileRangeAvailable)
   // Large overlap
   EXPECT_FALSE(is_tile_range_available(mRegistry, {TileID {1}, 20}));
   EXPECT_FALSE(is_tile_range_available(mRegistry, {TileID {40}, 100}));
+
+  // Contains the entire occupied range
+  EXPECT_FALSE(is_tile_range_available(mRegistry, {TileID {1}, 200}));
 }
 
 // tactile::core::has_tile
@@ -0,0 +1,86 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/ui/imgui_allocator.hpp"
+
+#include <cstddef>  // max_align_t
+#include <cstdint>  // uintptr_t
+#include <cstring>  // memset
+
+#include <gtest/gtest.h>
+
+namespace tactile::core::ui {
+
+// tactile::core::ui::imgui_malloc
+// tactile::core::ui::imgui_free
+TEST(ImGuiAllocator, AllocateAndFree)
+{
+  const auto stats_before = get_imgui_allocator_stats();
+
+  auto* small = imgui_malloc(24, nullptr);
+  auto* large = imgui_malloc(100'000, nullptr);
+  ASSERT_NE(small, nullptr);
+  ASSERT_NE(large, nullptr);
+
+  std::memset(small, 0xAB, 24);
+  std::memset(large, 0xCD, 100'000);
+
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(small) % alignof(std::max_align_t), 0);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % alignof(std::max_align_t), 0);
+
+  const auto stats = get_imgui_allocator_stats();
+  EXPECT_EQ(stats.live_allocation_count, stats_before.live_allocation_count + 2);
+  EXPECT_EQ(stats.live_bytes, stats_before.live_bytes + 100'024);
+  EXPECT_GE(stats.peak_live_bytes, stats.live_bytes);
+  EXPECT_EQ(stats.large_allocation_count, stats_before.large_allocation_count + 1);
+  EXPECT_GT(stats.reserved_bytes, 0);
+
+  imgui_free(small, nullptr);
+  imgui_free(large, nullptr);
+  imgui_free(nullptr, nullptr);
+
+  const auto stats_after = get_imgui_allocator_stats();
+  EXPECT_EQ(stats_after.live_allocation_count, stats_before.live_allocation_count);
+  EXPECT_EQ(stats_after.live_bytes, stats_before.live_bytes);
+}
+
+// tactile::core::ui::imgui_malloc
+TEST(ImGuiAllocator, ReuseFreedBlocks)
+{
+  auto* first = imgui_malloc(40, nullptr);
+  ASSERT_NE(first, nullptr);
+  imgui_free(first, nullptr);
+
+  const auto reserved_bytes = get_imgui_allocator_stats().reserved_bytes;
+
+  // Allocations in the same size class should reuse the freed block.
+  auto* second = imgui_malloc(36, nullptr);
+  EXPECT_EQ(second, first);
+  EXPECT_EQ(get_imgui_allocator_stats().reserved_bytes, reserved_bytes);
+
+  imgui_free(second, nullptr);
+}
+
+// tactile::core::ui::begin_imgui_allocator_frame
+TEST(ImGuiAllocator, FrameStatistics)
+{
+  begin_imgui_allocator_frame();
+
+  auto* a = imgui_malloc(10, nullptr);
+  auto* b = imgui_malloc(20, nullptr);
+  auto* c = imgui_malloc(5'000, nullptr);
+
+  imgui_free(a, nullptr);
+  imgui_free(b, nullptr);
+  imgui_free(c, nullptr);
+
+  begin_imgui_allocator_frame();
+
+  const auto stats = get_imgui_allocator_stats();
+  EXPECT_EQ(stats.frame_allocation_count, 3);
+  EXPECT_EQ(stats.frame_allocated_bytes, 5'030);
+
+  begin_imgui_allocator_frame();
+  EXPECT_EQ(get_imgui_allocator_stats().frame_allocation_count, 0);
+}
+
+}  // namespace tactile::core::ui
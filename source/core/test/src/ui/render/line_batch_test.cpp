@@ -0,0 +1,213 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/ui/render/line_batch.hpp"
+
+#include <cstdint>  // uint32_t
+#include <memory>   // unique_ptr, make_unique
+
+#include <gtest/gtest.h>
+#include <imgui.h>
+
+namespace tactile::core::ui {
+namespace {
+
+inline constexpr std::uint32_t kLineColor = 0xFF00FF00;
+
+class LineBatchTest : public testing::Test
+{
+ public:
+  void SetUp() override
+  {
+    mContext = ImGui::CreateContext();
+
+    mDrawList = std::make_unique<ImDrawList>(ImGui::GetDrawListSharedData());
+    mDrawList->_ResetForNewFrame();
+  }
+
+  void TearDown() override
+  {
+    mDrawList.reset();
+    ImGui::DestroyContext(mContext);
+  }
+
+ protected:
+  ImGuiContext* mContext {};
+  std::unique_ptr<ImDrawList> mDrawList {};
+
+  void expect_vertex(const int index, const float x, const float y) const
+  {
+    const auto& vertex = mDrawList->VtxBuffer[index];
+    EXPECT_EQ(vertex.pos.x, x);
+    EXPECT_EQ(vertex.pos.y, y);
+    EXPECT_EQ(vertex.col, kLineColor);
+  }
+};
+
+// tactile::core::ui::LineBatch::add_horizontal_line
+TEST_F(LineBatchTest, AddHorizontalLine)
+{
+  {
+    LineBatch lines {*mDrawList, 1, kLineColor, 2.0f};
+    lines.add_horizontal_line(10.0f, 30.0f, 5.0f);
+    EXPECT_EQ(lines.size(), 1);
+  }
+
+  ASSERT_EQ(mDrawList->VtxBuffer.Size, 4);
+  ASSERT_EQ(mDrawList->IdxBuffer.Size, 6);
+
+  expect_vertex(0, 10.0f, 5.0f);
+  expect_vertex(1, 30.0f, 5.0f);
+  expect_vertex(2, 30.0f, 7.0f);
+  expect_vertex(3, 10.0f, 7.0f);
+
+  EXPECT_EQ(mDrawList->IdxBuffer[0], 0);
+  EXPECT_EQ(mDrawList->IdxBuffer[1], 1);
+  EXPECT_EQ(mDrawList->IdxBuffer[2], 2);
+  EXPECT_EQ(mDrawList->IdxBuffer[3], 0);
+  EXPECT_EQ(mDrawList->IdxBuffer[4], 2);
+  EXPECT_EQ(mDrawList->IdxBuffer[5], 3);
+}
+
+// tactile::core::ui::LineBatch::add_vertical_line
+TEST_F(LineBatchTest, AddVerticalLine)
+{
+  {
+    LineBatch lines {*mDrawList, 1, kLineColor};
+    lines.add_vertical_line(8.0f, 2.0f, 42.0f);
+    EXPECT_EQ(lines.size(), 1);
+  }
+
+  ASSERT_EQ(mDrawList->VtxBuffer.Size, 4);
+
+  expect_vertex(0, 8.0f, 2.0f);
+  expect_vertex(1, 9.0f, 2.0f);
+  expect_vertex(2, 9.0f, 42.0f);
+  expect_vertex(3, 8.0f, 42.0f);
+}
+
+// tactile::core::ui::LineBatch::add_line
+TEST_F(LineBatchTest, AddLine)
+{
+  {
+    LineBatch lines {*mDrawList, 2, kLineColor};
+    lines.add_line(Float2 {0.0f, 0.0f}, Float2 {10.0f, 0.0f});
+    lines.add_line(Float2 {5.0f, 5.0f}, Float2 {5.0f, 5.0f});
+    EXPECT_EQ(lines.size(), 1);
+  }
+
+  ASSERT_EQ(mDrawList->VtxBuffer.Size, 4);
+
+  // The line is centered on the pixel centers, like ImDrawList::AddLine.
+  expect_vertex(0, 0.5f, 1.0f);
+  expect_vertex(1, 10.5f, 1.0f);
+  expect_vertex(2, 10.5f, 0.0f);
+  expect_vertex(3, 0.5f, 0.0f);
+}
+
+// tactile::core::ui::LineBatch::add_rect
+// tactile::core::ui::LineBatch::add_hexagon
+TEST_F(LineBatchTest, AddShapes)
+{
+  {
+    LineBatch lines {*mDrawList, 10, kLineColor};
+
+    lines.add_rect(Float2 {0.0f, 0.0f}, Float2 {32.0f, 32.0f});
+    EXPECT_EQ(lines.size(), 4);
+
+    lines.add_hexagon(Float2 {100.0f, 100.0f}, get_hexagon_info(16.0f));
+    EXPECT_EQ(lines.size(), 10);
+  }
+
+  EXPECT_EQ(mDrawList->VtxBuffer.Size, 40);
+  EXPECT_EQ(mDrawList->IdxBuffer.Size, 60);
+}
+
+// tactile::core::ui::LineBatch::~LineBatch
+TEST_F(LineBatchTest, UnusedReservationIsReleased)
+{
+  {
+    LineBatch lines {*mDrawList, 10, kLineColor};
+    lines.add_horizontal_line(0.0f, 10.0f, 0.0f);
+    lines.add_horizontal_line(0.0f, 10.0f, 1.0f);
+    lines.add_horizontal_line(0.0f, 10.0f, 2.0f);
+  }
+
+  EXPECT_EQ(mDrawList->VtxBuffer.Size, 12);
+  EXPECT_EQ(mDrawList->IdxBuffer.Size, 18);
+  EXPECT_EQ(mDrawList->CmdBuffer.back().ElemCount, 18);
+}
+
+// tactile::core::ui::LineBatch::LineBatch
+TEST_F(LineBatchTest, EmptyBatchReservesNothing)
+{
+  {
+    const LineBatch lines {*mDrawList, 100, kLineColor};
+    EXPECT_EQ(lines.size(), 0);
+  }
+
+  EXPECT_EQ(mDrawList->VtxBuffer.Size, 0);
+  EXPECT_EQ(mDrawList->IdxBuffer.Size, 0);
+}
+
+// tactile::core::ui::LineBatch::add_horizontal_line
+TEST_F(LineBatchTest, ReserveInChunks)
+{
+  constexpr int kLineCount = 10'000;
+
+  {
+    LineBatch lines {*mDrawList, kLineCount, kLineColor};
+    for (int index = 0; index < kLineCount; ++index) {
+      lines.add_horizontal_line(0.0f, 10.0f, static_cast<float>(index));
+    }
+
+    EXPECT_EQ(lines.size(), kLineCount);
+  }
+
+  ASSERT_EQ(mDrawList->VtxBuffer.Size, kLineCount * 4);
+  ASSERT_EQ(mDrawList->IdxBuffer.Size, kLineCount * 6);
+
+  // Every quad must reference its own four vertices.
+  for (int index = 0; index < kLineCount; ++index) {
+    const auto first_vertex = static_cast<ImDrawIdx>(index * 4);
+    EXPECT_EQ(mDrawList->IdxBuffer[index * 6], first_vertex);
+    EXPECT_EQ(mDrawList->IdxBuffer[index * 6 + 5], first_vertex + 3);
+  }
+
+  unsigned element_count = 0;
+  for (const auto& cmd : mDrawList->CmdBuffer) {
+    element_count += cmd.ElemCount;
+  }
+
+  EXPECT_EQ(element_count, static_cast<unsigned>(mDrawList->IdxBuffer.Size));
+}
+
+// tactile::core::ui::LineBatch::add_horizontal_line
+TEST_F(LineBatchTest, UnderestimatedLineCount)
+{
+  {
+    LineBatch lines {*mDrawList, 1, kLineColor};
+    for (int index = 0; index < 5; ++index) {
+      lines.add_vertical_line(static_cast<float>(index), 0.0f, 10.0f);
+    }
+
+    EXPECT_EQ(lines.size(), 5);
+  }
+
+  EXPECT_EQ(mDrawList->VtxBuffer.Size, 20);
+  EXPECT_EQ(mDrawList->IdxBuffer.Size, 30);
+}
+
+// tactile::core::ui::get_grid_opacity
+TEST(GridOpacity, GetGridOpacity)
+{
+  EXPECT_EQ(get_grid_opacity(-1.0f), 0.0f);
+  EXPECT_EQ(get_grid_opacity(0.0f), 0.0f);
+  EXPECT_EQ(get_grid_opacity(4.0f), 0.0f);
+  EXPECT_FLOAT_EQ(get_grid_opacity(6.0f), 0.25f);
+  EXPECT_FLOAT_EQ(get_grid_opacity(8.0f), 0.5f);
+  EXPECT_EQ(get_grid_opacity(12.0f), 1.0f);
+  EXPECT_EQ(get_grid_opacity(100.0f), 1.0f);
+}
+
+}  // namespace
+}  // namespace tactile::core::ui
@@ -15,14 +15,20 @@ struct Gd3Map;
 /**
  * Saves a Godot 3 scene.
  *
- * \param map     The Godot 3 map to save.
- * \param options The save options to use.
+ * \details
+ * The map view is traversed again when the layer nodes are emitted, so that tile
+ * data can be streamed directly from the source layers.
+ *
+ * \param map_view The source map view, which the Godot 3 map was created from.
+ * \param map      The Godot 3 map to save.
+ * \param options  The save options to use.
  *
  * \return
  * Nothing if successful; an error code otherwise.
  */
 [[nodiscard]]
-TACTILE_GODOT_API auto save_godot3_scene(const Gd3Map& map,
+TACTILE_GODOT_API auto save_godot3_scene(const IMapView& map_view,
+                                         const Gd3Map& map,
                                          const SaveFormatWriteOptions& options)
     -> std::expected<void, ErrorCode>;
 
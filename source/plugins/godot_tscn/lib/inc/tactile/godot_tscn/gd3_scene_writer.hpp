@@ -2,12 +2,15 @@
 
 #pragma once
 
-#include <concepts>     // invocable
+#include <charconv>     // to_chars, chars_format
+#include <concepts>     // invocable, integral, floating_point, same_as
 #include <cstddef>      // size_t
+#include <expected>     // expected
 #include <ostream>      // ostream
 #include <string>       // string
 #include <string_view>  // string_view
 
+#include "tactile/base/debug/error_code.hpp"
 #include "tactile/base/meta/color.hpp"
 #include "tactile/base/numeric/vec.hpp"
 #include "tactile/base/prelude.hpp"
@@ -16,12 +19,60 @@
 
 namespace tactile::godot_tscn {
 
+/**
+ * Appends a number to a string, formatted like numbers in Godot 3 scene files.
+ *
+ * \details
+ * Floating-point numbers are emitted with three decimals.
+ *
+ * \param buffer The string to append to.
+ * \param number The number to append.
+ */
+template <typename T>
+  requires(std::integral<T> || std::floating_point<T>) && (!std::same_as<T, bool>)
+void append_number(std::string& buffer, const T number)
+{
+  char chars[64];  // NOLINT(*-avoid-c-arrays)
+
+  if constexpr (std::floating_point<T>) {
+    const auto [end, error] =
+        std::to_chars(chars, chars + sizeof chars, number, std::chars_format::fixed, 3);
+    buffer.append(chars, end);
+  }
+  else {
+    const auto [end, error] = std::to_chars(chars, chars + sizeof chars, number);
+    buffer.append(chars, end);
+  }
+}
+
+/**
+ * Appends a quoted string to a string.
+ *
+ * \details
+ * Quotes and backslashes in the string are escaped with backslashes.
+ *
+ * \param buffer The string to append to.
+ * \param str    The string to quote.
+ */
+TACTILE_GODOT_API void append_quoted(std::string& buffer, std::string_view str);
+
 /**
  * Utility for emitting Godot 3 scene files.
+ *
+ * \details
+ * Output is accumulated in a small buffer that is written to the underlying
+ * stream in chunks, so large variables such as tile data don't have to be
+ * materialized before they are written.
  */
 class TACTILE_GODOT_API Gd3SceneWriter final
 {
  public:
+  TACTILE_DELETE_COPY(Gd3SceneWriter);
+  TACTILE_DEFAULT_MOVE(Gd3SceneWriter);
+
+  /** The buffer size that triggers a write to the underlying stream. */
+  static constexpr std::size_t kFlushThreshold = 65'536;
+
   /**
    * Creates a scene writer.
    *
@@ -29,6 +80,8 @@ class TACTILE_GODOT_API Gd3SceneWriter final
    */
   explicit Gd3SceneWriter(std::ostream& stream);
 
+  ~Gd3SceneWriter() noexcept = default;
+
   /**
    * Outputs a line break.
    *
@@ -208,6 +261,53 @@ class TACTILE_GODOT_API Gd3SceneWriter final
    */
   auto color_variable(std::string_view key, const FColor& color) -> Gd3SceneWriter&;
 
+  /**
+   * Starts a variable with a sequence of elements, e.g., a "PoolIntArray".
+   *
+   * \details
+   * The variable must be ended with \c end_sequence_variable, and may only be
+   * given elements in between.
+   *
+   * \param key  The variable name.
+   * \param type The variable type.
+   *
+   * \return
+   * The writer itself.
+   */
+  auto begin_sequence_variable(std::string_view key, std::string_view type)
+      -> Gd3SceneWriter&;
+
+  /**
+   * Outputs an element in the current sequence variable.
+   *
+   * \param number The element value.
+   *
+   * \return
+   * The writer itself.
+   */
+  template <typename T>
+    requires(std::integral<T> || std::floating_point<T>) && (!std::same_as<T, bool>)
+  auto sequence_element(const T number) -> Gd3SceneWriter&
+  {
+    if (m_sequence_size != 0) {
+      m_buffer += ", ";
+    }
+
+    append_number(m_buffer, number);
+    ++m_sequence_size;
+
+    _flush_if_needed();
+    return *this;
+  }
+
+  /**
+   * Ends the current sequence variable.
+   *
+   * \return
+   * The writer itself.
+   */
+  auto end_sequence_variable() -> Gd3SceneWriter&;
+
   /**
    * Outputs a variable with elements from a given range.
    *
@@ -217,38 +317,30 @@ class TACTILE_GODOT_API Gd3SceneWriter final
    * \param key     The variable name.
    * \param type    The variable type.
    * \param range   The range of elements to include.
-   * \param emitter The function object used to output the range elements.
+   * \param emitter The function object used to output the range elements, using
+   *                \c sequence_element.
    *
    * \return
    * The writer itself.
    */
-  template <typename T, std::invocable<std::ostream&, const typename T::value_type&> Emitter>
+  template <typename T,
+            std::invocable<Gd3SceneWriter&, const typename T::value_type&> Emitter>
   auto sequence_variable(const std::string_view key,
                          const std::string_view type,
                          const T& range,
                          const Emitter& emitter) -> Gd3SceneWriter&
   {
-    _emit_key_prefix();
-    *m_stream << key << " = " << type << "( ";
+    begin_sequence_variable(key, type);
 
-    std::size_t index {0};
     for (const auto& elem : range) {
-      if (index != 0) {
-        *m_stream << ", ";
-      }
-
-      emitter(*m_stream, elem);
-
-      ++index;
+      emitter(*this, elem);
     }
 
-    *m_stream << " )\n";
-
-    return *this;
+    return end_sequence_variable();
   }
 
   /**
-   * Outputs a variable with elements from a given range, using operator<< to output elements.
+   * Outputs a variable with numeric elements from a given range.
    *
    * \tparam T The type of the range.
    *
@@ -264,11 +356,11 @@ class TACTILE_GODOT_API Gd3SceneWriter final
                          const std::string_view type,
                          const T& range) -> Gd3SceneWriter&
   {
-    const auto streamer = [](std::ostream& stream, const typename T::value_type& elem) {
-      stream << elem;
+    const auto emitter = [](Gd3SceneWriter& writer, const typename T::value_type& elem) {
+      writer.sequence_element(elem);
     };
 
-    return sequence_variable(key, type, range, streamer);
+    return sequence_variable(key, type, range, emitter);
   }
 
   /**
@@ -278,11 +370,26 @@ class TACTILE_GODOT_API Gd3SceneWriter final
    */
   void set_key_prefix(std::string prefix);
 
+  /**
+   * Writes all buffered output to the underlying stream.
+   *
+   * \return
+   * Nothing if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  auto flush() -> std::expected<void, ErrorCode>;
+
  private:
   std::ostream* m_stream;
   std::string m_key_prefix;
+  std::string m_buffer {};
+  std::size_t m_sequence_size {};
+
+  void _begin_variable(std::string_view key);
+
+  void _end_line();
 
-  void _emit_key_prefix() const;
+  void _flush_if_needed();
 };
 
 }  // namespace tactile::godot_tscn
@@ -107,7 +107,6 @@ struct Gd3EncodedTile final
 
 struct Gd3TileAnimation final
 {
-  std::string parent;
   Index2D position;
   TileID tile_id;
 };
@@ -119,11 +118,12 @@ struct Gd3GroupLayer final
   std::vector<Gd3Layer> layers;
 };
 
+/**
+ * Tile layer data, the tiles themselves are streamed from the source layer when exported.
+ */
 struct Gd3TileLayer final
 {
   Int2 cell_size;
-  std::vector<Gd3EncodedTile> tiles;
-  std::vector<Gd3TileAnimation> animations;
 };
 
 struct Gd3Layer final
@@ -136,6 +136,7 @@ struct Gd3Layer final
   std::string parent;
   std::variant<Gd3TileLayer, Gd3ObjectLayer, Gd3GroupLayer> value;
   Gd3Metadata meta;
+  std::size_t global_index;
   float opacity;
   bool visible;
 };
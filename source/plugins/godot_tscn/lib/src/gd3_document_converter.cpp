@@ -8,7 +8,6 @@
 #include <filesystem>  // path
 #include <format>      // format
 #include <numbers>     // pi_v
-#include <stdexcept>   // runtime_error
 #include <string>      // string
 #include <utility>     // move
 
@@ -38,21 +37,19 @@ auto _escape_name(const std::string_view str) -> std::string
   return copy;
 }
 
+// Layers are identified by the global index of their source layer, which doesn't depend
+// on how much of the layer hierarchy has been converted.
 [[nodiscard]]
-auto _find_layer_at_global_index(std::vector<Gd3Layer>& layers,
-                                 const std::size_t target_index,
-                                 std::size_t index = 0) -> Gd3Layer*
+auto _find_layer_at_global_index(std::vector<Gd3Layer>& layers, const std::size_t global_index)
+    -> Gd3Layer*
 {
   for (auto& layer : layers) {
-    if (index == target_index) {
+    if (layer.global_index == global_index) {
       return &layer;
     }
 
-    ++index;
-
     if (auto* group = std::get_if<Gd3GroupLayer>(&layer.value)) {
-      if (auto* found_layer =
-              _find_layer_at_global_index(group->layers, target_index, index)) {
+      if (auto* found_layer = _find_layer_at_global_index(group->layers, global_index)) {
         return found_layer;
       }
     }
@@ -102,43 +99,14 @@ void _convert_common_layer_data(const ILayerView& layer,
   gd_layer.name = _escape_name(layer.get_meta().get_name());
   gd_layer.meta = _convert_meta(layer.get_meta());
   gd_layer.parent = std::move(parent_path);
+  gd_layer.global_index = layer.get_global_index();
   gd_layer.opacity = layer.get_opacity();
   gd_layer.visible = layer.is_visible();
 }
 
-[[nodiscard]]
-auto _convert_tile(const ILayerView& layer,
-                   const Gd3Tileset& gd_tileset,
-                   const Index2D& tile_pos,
-                   const TileID tile_id) -> Gd3EncodedTile
-{
-  const auto& [gd_tile_atlas_index, gd_tile_atlas] = find_tile_atlas(gd_tileset, tile_id);
-  if (!gd_tile_atlas) {
-    throw std::runtime_error {"could not find tile atlas"};
-  }
-
-  constexpr std::int32_t tile_offset = 65'536;
-
-  Gd3EncodedTile gd_tile {};
-  gd_tile.tile_index = tile_id - gd_tile_atlas->first_tile_id;
-
-  if (gd_tile.tile_index >= gd_tile_atlas->column_count) {
-    const auto position_in_tileset = layer.get_tile_position_in_tileset(tile_id).value();
-    gd_tile.tile_index = saturate_cast<std::int32_t>(position_in_tileset.x) +
-                         saturate_cast<std::int32_t>(position_in_tileset.y) * tile_offset;
-  }
-
-  gd_tile.position = saturate_cast<std::int32_t>(tile_pos.x) +
-                     saturate_cast<std::int32_t>(tile_pos.y) * tile_offset;
-  gd_tile.tile_atlas = gd_tile_atlas_index;
-
-  return gd_tile;
-}
-
 [[nodiscard]]
 auto _convert_tile_layer(const ILayerView& layer,
                          const Int2 tile_size,
-                         const Gd3Tileset& gd_tileset,
                          std::string parent_path) -> Gd3Layer
 {
   Gd3Layer gd_layer {};
@@ -147,28 +115,6 @@ auto _convert_tile_layer(const ILayerView& layer,
   auto& gd_tile_layer = gd_layer.value.emplace<Gd3TileLayer>();
   gd_tile_layer.cell_size = tile_size;
 
-  const auto extent = layer.get_extent().value();
-  for (Extent2D::value_type row = 0; row < extent.rows; ++row) {
-    for (Extent2D::value_type col = 0; col < extent.cols; ++col) {
-      const Index2D tile_pos {.x = col, .y = row};
-
-      const auto tile_id = layer.get_tile(tile_pos).value();
-      if (tile_id == kEmptyTile) {
-        continue;
-      }
-
-      const auto gd_encoded_tile = _convert_tile(layer, gd_tileset, tile_pos, tile_id);
-      gd_tile_layer.tiles.push_back(gd_encoded_tile);
-
-      if (layer.is_tile_animated(tile_pos)) {
-        auto& gd_tile_animation = gd_tile_layer.animations.emplace_back();
-        gd_tile_animation.position = tile_pos;
-        gd_tile_animation.tile_id = tile_id;
-        gd_tile_animation.parent = std::format("{}/{}", gd_layer.parent, gd_layer.name);
-      }
-    }
-  }
-
   return gd_layer;
 }
 
@@ -294,7 +240,7 @@ auto Gd3DocumentConverter::visit(const ILayerView& layer) -> std::expected<void,
   Gd3Layer gd_layer {};
   switch (layer.get_type()) {
     case LayerType::kTileLayer: {
-      gd_layer = _convert_tile_layer(layer, m_map.tile_size, m_map.tileset, parent_path);
+      gd_layer = _convert_tile_layer(layer, m_map.tile_size, parent_path);
       break;
     }
 
@@ -2,14 +2,19 @@
 
 #include "tactile/godot_tscn/gd3_exporter.hpp"
 
-#include <cstddef>  // size_t
-#include <format>   // format
-#include <fstream>  // ofstream
-#include <iomanip>  // quoted, setprecision
-#include <ios>      // boolalpha, fixed
-#include <ostream>  // ostream
-#include <sstream>  // stringstream
-
+#include <cstddef>        // size_t
+#include <cstdint>        // int32_t
+#include <format>         // format
+#include <fstream>        // ofstream
+#include <stdexcept>      // runtime_error
+#include <string>         // string
+#include <string_view>    // string_view
+#include <unordered_map>  // unordered_map
+#include <vector>         // vector
+
+#include "tactile/base/document/document_visitor.hpp"
+#include "tactile/base/document/layer_view.hpp"
+#include "tactile/base/document/map_view.hpp"
 #include "tactile/base/numeric/saturate_cast.hpp"
 #include "tactile/godot_tscn/gd3_scene_writer.hpp"
 #include "tactile/godot_tscn/gd3_types.hpp"
@@ -18,62 +23,86 @@
 namespace tactile::godot_tscn {
 namespace {
 
-void _emit_attribute(std::ostream& stream, const std::string_view name, const Attribute& value)
+template <typename... Ts>
+void _append_numbers(std::string& buffer,
+                     const std::string_view prefix,
+                     const std::string_view suffix,
+                     const Ts... numbers)
 {
-  stream << std::quoted(name) << ": ";
+  buffer += prefix;
+
+  std::size_t index = 0;
+  const auto append_element = [&](const auto number) {
+    if (index != 0) {
+      buffer += ", ";
+    }
+
+    append_number(buffer, number);
+    ++index;
+  };
+
+  (append_element(numbers), ...);
+
+  buffer += suffix;
+}
+
+void _append_attribute(std::string& buffer,
+                       const std::string_view name,
+                       const Attribute& value)
+{
+  append_quoted(buffer, name);
+  buffer += ": ";
 
   switch (value.get_type()) {
     case AttributeType::kStr: {
-      stream << std::quoted(value.as_string());
+      append_quoted(buffer, value.as_string());
       break;
     }
     case AttributeType::kInt: {
-      stream << value.as_int();
+      append_number(buffer, value.as_int());
       break;
     }
     case AttributeType::kInt2: {
       const auto& vec = value.as_int2();
-      stream << "Vector2( " << vec.x() << ", " << vec.y() << " )";
+      _append_numbers(buffer, "Vector2( ", " )", vec.x(), vec.y());
       break;
     }
     case AttributeType::kInt3: {
       const auto& vec = value.as_int3();
-      stream << "Vector3( " << vec.x() << ", " << vec.y() << ", " << vec.z() << " )";
+      _append_numbers(buffer, "Vector3( ", " )", vec.x(), vec.y(), vec.z());
       break;
     }
     case AttributeType::kInt4: {
       const auto& vec = value.as_int4();
-      stream << "[ " << vec.x() << ", " << vec.y() << ", " << vec.z() << ", " << vec.w()
-             << " ]";
+      _append_numbers(buffer, "[ ", " ]", vec.x(), vec.y(), vec.z(), vec.w());
       break;
     }
     case AttributeType::kFloat: {
-      stream << value.as_float();
+      append_number(buffer, value.as_float());
       break;
     }
     case AttributeType::kFloat2: {
       const auto& vec = value.as_float2();
-      stream << "Vector2( " << vec.x() << ", " << vec.y() << " )";
+      _append_numbers(buffer, "Vector2( ", " )", vec.x(), vec.y());
       break;
     }
     case AttributeType::kFloat3: {
       const auto& vec = value.as_float3();
-      stream << "Vector3( " << vec.x() << ", " << vec.y() << ", " << vec.z() << " )";
+      _append_numbers(buffer, "Vector3( ", " )", vec.x(), vec.y(), vec.z());
       break;
     }
     case AttributeType::kFloat4: {
       const auto& vec = value.as_float4();
-      stream << "[ " << vec.x() << ", " << vec.y() << ", " << vec.z() << ", " << vec.w()
-             << " ]";
+      _append_numbers(buffer, "[ ", " ]", vec.x(), vec.y(), vec.z(), vec.w());
       break;
     }
     case AttributeType::kBool: {
-      stream << value.as_bool();
+      buffer += value.as_bool() ? "true" : "false";
       break;
     }
     case AttributeType::kPath: {
       const auto& path_string = value.as_path().string();
-      stream << std::quoted(path_string);
+      append_quoted(buffer, path_string);
       break;
     }
     case AttributeType::kColor: {
@@ -85,41 +114,43 @@ void _emit_attribute(std::ostream& stream, const std::string_view name, const At
       const auto b = static_cast<float>(color.blue) / 255.0f;
       const auto a = static_cast<float>(color.alpha) / 255.0f;
 
-      stream << "Color( " << r << ", " << g << ", " << b << ", " << a << " )";
+      _append_numbers(buffer, "Color( ", " )", r, g, b, a);
       break;
     }
     case AttributeType::kObject: {
-      stream << value.as_object().value;
+      append_number(buffer, value.as_object().value);
       break;
     }
     default: throw std::runtime_error {"bad attribute"};
   }
 }
 
-void _emit_attributes(std::ostream& stream, const StringMap<Attribute>& attributes)
+void _append_attributes(std::string& buffer, const StringMap<Attribute>& attributes)
 {
   std::size_t index = 0;
   for (const auto& [name, value] : attributes) {
     if (index != 0) {
-      stream << ',';
+      buffer += ',';
     }
 
-    _emit_attribute(stream, name, value);
+    _append_attribute(buffer, name, value);
     ++index;
   }
 }
 
-void _emit_components(std::ostream& stream, const StringMap<StringMap<Attribute>>& components)
+void _append_components(std::string& buffer,
+                        const StringMap<StringMap<Attribute>>& components)
 {
   std::size_t component_index = 0;
   for (const auto& [comp_name, comp_attributes] : components) {
     if (component_index != 0) {
-      stream << ", ";
+      buffer += ", ";
     }
 
-    stream << std::quoted(comp_name) << ": {";
-    _emit_attributes(stream, comp_attributes);
-    stream << '}';
+    append_quoted(buffer, comp_name);
+    buffer += ": {";
+    _append_attributes(buffer, comp_attributes);
+    buffer += '}';
 
     ++component_index;
   }
@@ -134,26 +165,23 @@ void _emit_metadata(Gd3SceneWriter& writer, const Gd3Metadata& meta)
     return;
   }
 
-  std::stringstream meta_stream {};
-  meta_stream << std::setprecision(3) << std::fixed << std::boolalpha;
-
-  meta_stream << '{';
+  std::string meta_string {};
+  meta_string += '{';
 
   if (has_props) {
-    meta_stream << "\"properties\": {";
-    _emit_attributes(meta_stream, meta.props);
-    meta_stream << '}';
+    meta_string += "\"properties\": {";
+    _append_attributes(meta_string, meta.props);
+    meta_string += '}';
   }
 
   if (has_comps) {
-    meta_stream << "\"components\": {";
-    _emit_components(meta_stream, meta.comps);
-    meta_stream << '}';
+    meta_string += "\"components\": {";
+    _append_components(meta_string, meta.comps);
+    meta_string += '}';
   }
 
-  meta_stream << '}';
+  meta_string += '}';
 
-  const auto meta_string = meta_stream.str();
   writer.variable("__meta__", meta_string);
 }
 
@@ -210,50 +238,87 @@ void _emit_sprite_frames(Gd3SceneWriter& writer, const Gd3SpriteFrames& sprite_f
 
   writer.newline().sub_resource_header("SpriteFrames", sprite_frames.id);
 
-  std::stringstream animations_stream {};
-  animations_stream << std::setprecision(3) << std::fixed;
-  animations_stream << '[';
+  std::string animations_string {};
+  animations_string += '[';
 
   for (std::size_t anim_index = 0; const auto& animation : sprite_frames.animations) {
     if (anim_index != 0) {
-      animations_stream << ", ";
+      animations_string += ", ";
     }
-    animations_stream << '{';
+    animations_string += '{';
 
-    animations_stream << "\"loop\": true";
-    animations_stream << ", \"name\": \"" << animation.name << "\"";
-    animations_stream << ", \"speed\": \"" << animation.speed << "\"";
-    animations_stream << ", \"frames\": [";
+    animations_string += "\"loop\": true";
+    animations_string += ", \"name\": \"";
+    animations_string += animation.name;
+    animations_string += "\", \"speed\": \"";
+    append_number(animations_string, animation.speed);
+    animations_string += "\", \"frames\": [";
 
     for (std::size_t frame_index = 0; const auto atlas_texture_id : animation.frames) {
       if (frame_index != 0) {
-        animations_stream << ", ";
+        animations_string += ", ";
       }
-      animations_stream << "SubResource( " << atlas_texture_id << " )";
+      _append_numbers(animations_string, "SubResource( ", " )", atlas_texture_id);
       ++frame_index;
     }
 
-    animations_stream << "]}";
+    animations_string += "]}";
     ++anim_index;
   }
 
-  animations_stream << ']';
+  animations_string += ']';
 
-  const auto animations_string = animations_stream.str();
   writer.variable("animations", animations_string);
 }
 
+[[nodiscard]]
+auto _encode_tile(const ILayerView& layer,
+                  const Gd3Tileset& gd_tileset,
+                  const Index2D& tile_pos,
+                  const TileID tile_id) -> Gd3EncodedTile
+{
+  const auto& [gd_tile_atlas_index, gd_tile_atlas] = find_tile_atlas(gd_tileset, tile_id);
+  if (!gd_tile_atlas) {
+    throw std::runtime_error {"could not find tile atlas"};
+  }
+
+  constexpr std::int32_t tile_offset = 65'536;
+
+  Gd3EncodedTile gd_tile {};
+  gd_tile.tile_index = tile_id - gd_tile_atlas->first_tile_id;
+
+  if (gd_tile.tile_index >= gd_tile_atlas->column_count) {
+    const auto position_in_tileset = layer.get_tile_position_in_tileset(tile_id).value();
+    gd_tile.tile_index = saturate_cast<std::int32_t>(position_in_tileset.x) +
+                         saturate_cast<std::int32_t>(position_in_tileset.y) * tile_offset;
+  }
+
+  gd_tile.position = saturate_cast<std::int32_t>(tile_pos.x) +
+                     saturate_cast<std::int32_t>(tile_pos.y) * tile_offset;
+  gd_tile.tile_atlas = gd_tile_atlas_index;
+
+  return gd_tile;
+}
+
 void _emit_tile_layer_animation_nodes(Gd3SceneWriter& writer,
-                                      const Gd3TileLayer& tile_layer,
+                                      const Gd3Layer& gd_layer,
+                                      const std::vector<Gd3TileAnimation>& animations,
                                       const SubResourceId sprite_frames_id)
 {
-  for (const auto& animation : tile_layer.animations) {
+  if (animations.empty()) {
+    return;
+  }
+
+  const auto& gd_tile_layer = std::get<Gd3TileLayer>(gd_layer.value);
+  const auto parent = std::format("{}/{}", gd_layer.parent, gd_layer.name);
+
+  for (const auto& animation : animations) {
     const auto name = std::format("Tile {}", animation.position);
     const auto animation_name = std::format("Tile {}", animation.tile_id);
 
     writer.newline()
-        .node_header(name, "AnimatedSprite", animation.parent)
-        .vector2_variable("position", to_int2(animation.position) * tile_layer.cell_size)
+        .node_header(name, "AnimatedSprite", parent)
+        .vector2_variable("position", to_int2(animation.position) * gd_tile_layer.cell_size)
         .sub_resource_variable("frames", sprite_frames_id)
         .variable("speed_scale", "1.0")
         .variable_quoted("animation", animation_name)
@@ -263,30 +328,50 @@ void _emit_tile_layer_animation_nodes(Gd3SceneWriter& writer,
 }
 
 void _emit_tile_layer(Gd3SceneWriter& writer,
-                      const Gd3Layer& layer,
-                      const SubResourceId tileset_id,
-                      const SubResourceId sprite_frames_id)
+                      const ILayerView& layer,
+                      const Gd3Layer& gd_layer,
+                      const Gd3Map& gd_map)
 {
-  const auto& tile_layer = std::get<Gd3TileLayer>(layer.value);
+  const auto& gd_tile_layer = std::get<Gd3TileLayer>(gd_layer.value);
 
   writer.newline()
-      .node_header(layer.name, "TileMap", layer.parent)
-      .sub_resource_variable("tile_set", tileset_id)
-      .variable("visible", layer.visible)
-      .vector2_variable("cell_size", tile_layer.cell_size)
-      .color_variable("modulate", FColor {1, 1, 1, layer.opacity})
+      .node_header(gd_layer.name, "TileMap", gd_layer.parent)
+      .sub_resource_variable("tile_set", gd_map.tileset.id)
+      .variable("visible", gd_layer.visible)
+      .vector2_variable("cell_size", gd_tile_layer.cell_size)
+      .color_variable("modulate", FColor {1, 1, 1, gd_layer.opacity})
       .variable("format", "1")
-      .sequence_variable("tile_data",
-                         "PoolIntArray",
-                         tile_layer.tiles,
-                         [](std::ostream& stream, const Gd3EncodedTile& tile) {
-                           stream << tile.position << ", " << tile.tile_atlas << ", "
-                                  << tile.tile_index;
-                         });
+      .begin_sequence_variable("tile_data", "PoolIntArray");
 
-  _emit_metadata(writer, layer.meta);
+  // Animated tiles are rare, so they are collected while the tile data is emitted.
+  std::vector<Gd3TileAnimation> animations {};
+
+  const auto extent = layer.get_extent().value();
+  for (Extent2D::value_type row = 0; row < extent.rows; ++row) {
+    for (Extent2D::value_type col = 0; col < extent.cols; ++col) {
+      const Index2D tile_pos {.x = col, .y = row};
+
+      const auto tile_id = layer.get_tile(tile_pos).value();
+      if (tile_id == kEmptyTile) {
+        continue;
+      }
+
+      const auto gd_tile = _encode_tile(layer, gd_map.tileset, tile_pos, tile_id);
+      writer.sequence_element(gd_tile.position)
+          .sequence_element(gd_tile.tile_atlas)
+          .sequence_element(gd_tile.tile_index);
+
+      if (layer.is_tile_animated(tile_pos)) {
+        animations.push_back(Gd3TileAnimation {.position = tile_pos, .tile_id = tile_id});
+      }
+    }
+  }
+
+  writer.end_sequence_variable();
+
+  _emit_metadata(writer, gd_layer.meta);
 
-  _emit_tile_layer_animation_nodes(writer, tile_layer, sprite_frames_id);
+  _emit_tile_layer_animation_nodes(writer, gd_layer, animations, gd_map.sprite_frames.id);
 }
 
 void _emit_rect_object(Gd3SceneWriter& writer, const Gd3Object& object)
@@ -324,8 +409,9 @@ void _emit_polygon_object(Gd3SceneWriter& writer, const Gd3Object& object)
       .sequence_variable("polygon",
                          "PoolVector2Array",
                          polygon.points,
-                         [](std::ostream& stream, const Float2& point) {
-                           stream << point.x() << ", " << point.y();
+                         [](Gd3SceneWriter& polygon_writer, const Float2& point) {
+                           polygon_writer.sequence_element(point.x())
+                               .sequence_element(point.y());
                          });
 }
 
@@ -365,51 +451,111 @@ void _emit_object_layer(Gd3SceneWriter& writer, const Gd3Layer& layer)
   }
 }
 
-void _emit_layer(Gd3SceneWriter& writer,
-                 const Gd3Layer& layer,
-                 SubResourceId tileset_id,
-                 SubResourceId sprite_frames_id);
-
-void _emit_group_layer(Gd3SceneWriter& writer,
-                       const Gd3Layer& layer,
-                       const SubResourceId tileset_id,
-                       const SubResourceId sprite_frames_id)
+void _emit_group_layer(Gd3SceneWriter& writer, const Gd3Layer& layer)
 {
-  const auto& group_layer = std::get<Gd3GroupLayer>(layer.value);
-
   writer.newline()
       .node_header(layer.name, "Node2D", layer.parent)  //
       .color_variable("modulate", FColor {1, 1, 1, layer.opacity})
       .variable("visible", layer.visible);
 
   _emit_metadata(writer, layer.meta);
+}
+
+void _collect_layers(const std::vector<Gd3Layer>& layers,
+                     std::unordered_map<std::size_t, const Gd3Layer*>& layer_map)
+{
+  for (const auto& layer : layers) {
+    layer_map.insert_or_assign(layer.global_index, &layer);
 
-  for (const auto& sublayer : group_layer.layers) {
-    _emit_layer(writer, sublayer, tileset_id, sprite_frames_id);
+    if (const auto* group = std::get_if<Gd3GroupLayer>(&layer.value)) {
+      _collect_layers(group->layers, layer_map);
+    }
   }
 }
 
-void _emit_layer(Gd3SceneWriter& writer,
-                 const Gd3Layer& layer,
-                 const SubResourceId tileset_id,
-                 const SubResourceId sprite_frames_id)
+/**
+ * A document visitor that emits the layer nodes of a Godot 3 scene.
+ *
+ * \details
+ * Layers are visited in the same depth-first order as when the intermediate map was
+ * created, which is also the order in which the layer nodes are emitted. Intermediate
+ * layers are looked up by the global index of the source layer. Tile data is
+ * read directly from the layer views, so it's never stored in the intermediate map.
+ */
+class Gd3LayerNodeEmitter final : public IDocumentVisitor
 {
-  switch (layer.value.index()) {
-    case Gd3Layer::kTileLayerTypeIndex: {
-      _emit_tile_layer(writer, layer, tileset_id, sprite_frames_id);
-      break;
-    }
-    case Gd3Layer::kObjectLayerTypeIndex: {
-      _emit_object_layer(writer, layer);
-      break;
+ public:
+  Gd3LayerNodeEmitter(Gd3SceneWriter& writer, const Gd3Map& gd_map)
+    : m_writer {&writer},
+      m_map {&gd_map}
+  {
+    _collect_layers(m_map->layers, m_layers);
+  }
+
+  [[nodiscard]]
+  auto visit(const IComponentView&) -> std::expected<void, ErrorCode> override
+  {
+    return {};
+  }
+
+  [[nodiscard]]
+  auto visit(const IMapView&) -> std::expected<void, ErrorCode> override
+  {
+    return {};
+  }
+
+  [[nodiscard]]
+  auto visit(const ILayerView& layer) -> std::expected<void, ErrorCode> override
+  {
+    const auto layer_iter = m_layers.find(layer.get_global_index());
+    if (layer_iter == m_layers.end()) {
+      return std::unexpected {ErrorCode::kBadState};
     }
-    case Gd3Layer::kGroupLayerTypeIndex: {
-      _emit_group_layer(writer, layer, tileset_id, sprite_frames_id);
-      break;
+
+    const auto& gd_layer = *layer_iter->second;
+
+    switch (gd_layer.value.index()) {
+      case Gd3Layer::kTileLayerTypeIndex: {
+        _emit_tile_layer(*m_writer, layer, gd_layer, *m_map);
+        break;
+      }
+      case Gd3Layer::kObjectLayerTypeIndex: {
+        _emit_object_layer(*m_writer, gd_layer);
+        break;
+      }
+      case Gd3Layer::kGroupLayerTypeIndex: {
+        _emit_group_layer(*m_writer, gd_layer);
+        break;
+      }
+      default: return std::unexpected {ErrorCode::kBadState};
     }
-    default: throw std::runtime_error {"bad layer"};
+
+    return {};
   }
-}
+
+  [[nodiscard]]
+  auto visit(const IObjectView&) -> std::expected<void, ErrorCode> override
+  {
+    return {};
+  }
+
+  [[nodiscard]]
+  auto visit(const ITilesetView&) -> std::expected<void, ErrorCode> override
+  {
+    return {};
+  }
+
+  [[nodiscard]]
+  auto visit(const ITileView&) -> std::expected<void, ErrorCode> override
+  {
+    return {};
+  }
+
+ private:
+  Gd3SceneWriter* m_writer;
+  const Gd3Map* m_map;
+  std::unordered_map<std::size_t, const Gd3Layer*> m_layers {};
+};
 
 void _emit_tileset(Gd3SceneWriter& writer, const Gd3Tileset& tileset)
 {
@@ -432,8 +578,9 @@ void _emit_resources(Gd3SceneWriter& writer, const Gd3Resources& resources)
 }
 
 [[nodiscard]]
-auto _emit_map_file(const Gd3Map& map, const SaveFormatWriteOptions& options)
-    -> std::expected<void, ErrorCode>
+auto _emit_map_file(const IMapView& map_view,
+                    const Gd3Map& map,
+                    const SaveFormatWriteOptions& options) -> std::expected<void, ErrorCode>
 {
   const auto path = options.base_dir / "map.tscn";
   TACTILE_GODOT_TSCN_DEBUG("Generating map scene '{}'", path.string());
@@ -467,11 +614,8 @@ auto _emit_map_file(const Gd3Map& map, const SaveFormatWriteOptions& options)
   writer.newline().node_header("Root", "Node2D");
   _emit_metadata(writer, map.meta);
 
-  for (const auto& layer : map.layers) {
-    _emit_layer(writer, layer, map.tileset.id, map.sprite_frames.id);
-  }
-
-  return {};
+  Gd3LayerNodeEmitter layer_node_emitter {writer, map};
+  return map_view.accept(layer_node_emitter).and_then([&] { return writer.flush(); });
 }
 
 [[nodiscard]]
@@ -501,11 +645,12 @@ auto _save_tileset_images(const Gd3Tileset& tileset, const SaveFormatWriteOption
 
 }  // namespace
 
-auto save_godot3_scene(const Gd3Map& map, const SaveFormatWriteOptions& options)
-    -> std::expected<void, ErrorCode>
+auto save_godot3_scene(const IMapView& map_view,
+                       const Gd3Map& map,
+                       const SaveFormatWriteOptions& options) -> std::expected<void, ErrorCode>
 {
   return _save_tileset_images(map.tileset, options).and_then([&] {
-    return _emit_map_file(map, options);
+    return _emit_map_file(map_view, map, options);
   });
 }
 
@@ -2,43 +2,69 @@
 
 #include "tactile/godot_tscn/gd3_scene_writer.hpp"
 
-#include <iomanip>  // quoted, setprecision
-#include <ios>      // boolalpha, fixed
+#include <ios>      // streamsize
 #include <utility>  // move
 
 namespace tactile::godot_tscn {
 
+void append_quoted(std::string& buffer, const std::string_view str)
+{
+  buffer += '"';
+
+  for (const auto ch : str) {
+    if (ch == '"' || ch == '\\') {
+      buffer += '\\';
+    }
+
+    buffer += ch;
+  }
+
+  buffer += '"';
+}
+
 Gd3SceneWriter::Gd3SceneWriter(std::ostream& stream)
   : m_stream {&stream},
     m_key_prefix {}
 {
-  *m_stream << std::setprecision(3) << std::fixed;
+  m_buffer.reserve(kFlushThreshold);
 }
 
 auto Gd3SceneWriter::newline() -> Gd3SceneWriter&
 {
-  *m_stream << '\n';
+  _end_line();
   return *this;
 }
 
 auto Gd3SceneWriter::gd_scene_header(const std::size_t load_steps) -> Gd3SceneWriter&
 {
-  *m_stream << "[gd_scene load_steps=" << load_steps << " format=2]\n";
+  m_buffer += "[gd_scene load_steps=";
+  append_number(m_buffer, load_steps);
+  m_buffer += " format=2]";
+  _end_line();
   return *this;
 }
 
 auto Gd3SceneWriter::gd_resource_header(const std::string_view type,
                                         const std::size_t load_steps) -> Gd3SceneWriter&
 {
-  *m_stream << "[gd_resource type=" << std::quoted(type) << " load_steps=" << load_steps
-            << " format=2]\n";
+  m_buffer += "[gd_resource type=";
+  append_quoted(m_buffer, type);
+  m_buffer += " load_steps=";
+  append_number(m_buffer, load_steps);
+  m_buffer += " format=2]";
+  _end_line();
   return *this;
 }
 
 auto Gd3SceneWriter::node_header(const std::string_view name, const std::string_view type)
     -> Gd3SceneWriter&
 {
-  *m_stream << "[node name=" << std::quoted(name) << " type=" << std::quoted(type) << "]\n";
+  m_buffer += "[node name=";
+  append_quoted(m_buffer, name);
+  m_buffer += " type=";
+  append_quoted(m_buffer, type);
+  m_buffer += ']';
+  _end_line();
   return *this;
 }
 
@@ -46,107 +72,146 @@ auto Gd3SceneWriter::node_header(const std::string_view name,
                                  const std::string_view type,
                                  const std::string_view parent) -> Gd3SceneWriter&
 {
-  *m_stream << "[node name=" << std::quoted(name)  //
-            << " type=" << std::quoted(type)       //
-            << " parent=" << std::quoted(parent) << "]\n";
+  m_buffer += "[node name=";
+  append_quoted(m_buffer, name);
+  m_buffer += " type=";
+  append_quoted(m_buffer, type);
+  m_buffer += " parent=";
+  append_quoted(m_buffer, parent);
+  m_buffer += ']';
+  _end_line();
   return *this;
 }
 
 auto Gd3SceneWriter::resource_header() -> Gd3SceneWriter&
 {
-  *m_stream << "[resource]\n";
+  m_buffer += "[resource]";
+  _end_line();
   return *this;
 }
 
 auto Gd3SceneWriter::ext_resource_header(const ExtResourceId id,
                                          const Gd3ExtResource& resource) -> Gd3SceneWriter&
 {
-  *m_stream << "[ext_resource path=" << std::quoted(resource.path)  //
-            << " type=" << std::quoted(resource.type)               //
-            << " id=" << id << "]\n";
+  m_buffer += "[ext_resource path=";
+  append_quoted(m_buffer, resource.path);
+  m_buffer += " type=";
+  append_quoted(m_buffer, resource.type);
+  m_buffer += " id=";
+  append_number(m_buffer, id);
+  m_buffer += ']';
+  _end_line();
   return *this;
 }
 
 auto Gd3SceneWriter::sub_resource_header(const std::string_view type, const SubResourceId id)
     -> Gd3SceneWriter&
 {
-  *m_stream << "[sub_resource type=" << std::quoted(type) << " id=" << id << "]\n";
+  m_buffer += "[sub_resource type=";
+  append_quoted(m_buffer, type);
+  m_buffer += " id=";
+  append_number(m_buffer, id);
+  m_buffer += ']';
+  _end_line();
   return *this;
 }
 
 auto Gd3SceneWriter::variable(const std::string_view key, const std::string_view value)
     -> Gd3SceneWriter&
 {
-  _emit_key_prefix();
-  *m_stream << key << " = " << value << '\n';
+  _begin_variable(key);
+  m_buffer += value;
+  _end_line();
   return *this;
 }
 
 auto Gd3SceneWriter::variable(const std::string_view key, const bool value) -> Gd3SceneWriter&
 {
-  _emit_key_prefix();
-  *m_stream << key << " = " << std::boolalpha << value << '\n';
+  _begin_variable(key);
+  m_buffer += value ? "true" : "false";
+  _end_line();
   return *this;
 }
 
 auto Gd3SceneWriter::variable_quoted(const std::string_view key, const std::string_view value)
     -> Gd3SceneWriter&
 {
-  _emit_key_prefix();
-  *m_stream << key << " = " << std::quoted(value) << '\n';
+  _begin_variable(key);
+  append_quoted(m_buffer, value);
+  _end_line();
   return *this;
 }
 
 auto Gd3SceneWriter::vector2_variable(const std::string_view key, const Int2& vec)
     -> Gd3SceneWriter&
 {
-  _emit_key_prefix();
-  *m_stream << key << " = Vector2( " << vec.x() << ", " << vec.y() << " )\n";
-  return *this;
+  return begin_sequence_variable(key, "Vector2")
+      .sequence_element(vec.x())
+      .sequence_element(vec.y())
+      .end_sequence_variable();
 }
 
 auto Gd3SceneWriter::vector2_variable(const std::string_view key, const Float2& vec)
     -> Gd3SceneWriter&
 {
-  _emit_key_prefix();
-  *m_stream << key << " = Vector2( " << vec.x() << ", " << vec.y() << " )\n";
-  return *this;
+  return begin_sequence_variable(key, "Vector2")
+      .sequence_element(vec.x())
+      .sequence_element(vec.y())
+      .end_sequence_variable();
 }
 
 auto Gd3SceneWriter::rect2_variable(const std::string_view key, const Int4& rect)
     -> Gd3SceneWriter&
 {
-  _emit_key_prefix();
-  *m_stream << key << " = Rect2( "  //
-            << rect.x() << ", "     //
-            << rect.y() << ", "     //
-            << rect.z() << ", "     //
-            << rect.w() << " )\n";
-  return *this;
+  return begin_sequence_variable(key, "Rect2")
+      .sequence_element(rect.x())
+      .sequence_element(rect.y())
+      .sequence_element(rect.z())
+      .sequence_element(rect.w())
+      .end_sequence_variable();
 }
 
 auto Gd3SceneWriter::sub_resource_variable(const std::string_view key, const SubResourceId id)
     -> Gd3SceneWriter&
 {
-  _emit_key_prefix();
-  *m_stream << key << " = SubResource( " << id << " )\n";
-  return *this;
+  return begin_sequence_variable(key, "SubResource")
+      .sequence_element(id)
+      .end_sequence_variable();
 }
 
 auto Gd3SceneWriter::ext_resource_variable(const std::string_view key, const ExtResourceId id)
     -> Gd3SceneWriter&
 {
-  _emit_key_prefix();
-  *m_stream << key << " = ExtResource( " << id << " )\n";
-  return *this;
+  return begin_sequence_variable(key, "ExtResource")
+      .sequence_element(id)
+      .end_sequence_variable();
 }
 
 auto Gd3SceneWriter::color_variable(const std::string_view key, const FColor& color)
     -> Gd3SceneWriter&
 {
-  _emit_key_prefix();
-  *m_stream << key << " = Color( " << color.red << ", " << color.green << ", " << color.blue
-            << ", " << color.alpha << " )\n";
+  return begin_sequence_variable(key, "Color")
+      .sequence_element(color.red)
+      .sequence_element(color.green)
+      .sequence_element(color.blue)
+      .sequence_element(color.alpha)
+      .end_sequence_variable();
+}
+
+auto Gd3SceneWriter::begin_sequence_variable(const std::string_view key,
+                                             const std::string_view type) -> Gd3SceneWriter&
+{
+  _begin_variable(key);
+  m_buffer += type;
+  m_buffer += "( ";
+  m_sequence_size = 0;
+  return *this;
+}
+
+auto Gd3SceneWriter::end_sequence_variable() -> Gd3SceneWriter&
+{
+  m_buffer += " )";
+  _end_line();
   return *this;
 }
 
@@ -155,10 +220,37 @@ void Gd3SceneWriter::set_key_prefix(std::string prefix)
   m_key_prefix = std::move(prefix);
 }
 
-void Gd3SceneWriter::_emit_key_prefix() const
+auto Gd3SceneWriter::flush() -> std::expected<void, ErrorCode>
+{
+  m_stream->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+  m_stream->flush();
+  m_buffer.clear();
+
+  if (!m_stream->good()) {
+    return std::unexpected {ErrorCode::kWriteError};
+  }
+
+  return {};
+}
+
+void Gd3SceneWriter::_begin_variable(const std::string_view key)
+{
+  m_buffer += m_key_prefix;
+  m_buffer += key;
+  m_buffer += " = ";
+}
+
+void Gd3SceneWriter::_end_line()
+{
+  m_buffer += '\n';
+  _flush_if_needed();
+}
+
+void Gd3SceneWriter::_flush_if_needed()
 {
-  if (!m_key_prefix.empty()) {
-    *m_stream << m_key_prefix;
+  if (m_buffer.size() >= kFlushThreshold) {
+    m_stream->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    m_buffer.clear();
   }
 }
 
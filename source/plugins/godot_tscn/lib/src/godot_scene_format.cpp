@@ -68,7 +68,7 @@ auto GodotSceneFormat::save_map(const IMapView& map,
       map.accept(converter);
 
       const auto& gd_map = converter.get_map();
-      return save_godot3_scene(gd_map, options);
+      return save_godot3_scene(map, gd_map, options);
     }
 
     return std::unexpected {ErrorCode::kNotSupported};
@@ -0,0 +1,157 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/godot_tscn/gd3_scene_writer.hpp"
+
+#include <cstddef>   // size_t
+#include <cstdint>   // int32_t, uint64_t
+#include <expected>  // unexpected
+#include <ios>       // ios
+#include <sstream>   // ostringstream
+#include <string>    // string
+#include <vector>    // vector
+
+#include <gtest/gtest.h>
+
+namespace tactile::godot_tscn {
+namespace {
+
+// tactile::godot_tscn::append_number
+TEST(Gd3SceneWriter, AppendNumber)
+{
+  std::string buffer {};
+
+  append_number(buffer, 42);
+  buffer += ' ';
+  append_number(buffer, std::int32_t {-7});
+  buffer += ' ';
+  append_number(buffer, std::uint64_t {18'446'744'073'709'551'615u});
+  buffer += ' ';
+  append_number(buffer, 1.5f);
+  buffer += ' ';
+  append_number(buffer, -0.0625);
+  buffer += ' ';
+  append_number(buffer, 0.0f);
+
+  EXPECT_EQ(buffer, "42 -7 18446744073709551615 1.500 -0.062 0.000");
+}
+
+// tactile::godot_tscn::append_quoted
+TEST(Gd3SceneWriter, AppendQuoted)
+{
+  std::string buffer {"x = "};
+
+  append_quoted(buffer, R"(a"b\c)");
+  buffer += ' ';
+  append_quoted(buffer, "");
+
+  EXPECT_EQ(buffer, R"(x = "a\"b\\c" "")");
+}
+
+// tactile::godot_tscn::Gd3SceneWriter::node_header
+// tactile::godot_tscn::Gd3SceneWriter::variable
+// tactile::godot_tscn::Gd3SceneWriter::variable_quoted
+TEST(Gd3SceneWriter, HeadersAndVariables)
+{
+  std::ostringstream stream {};
+  Gd3SceneWriter writer {stream};
+
+  writer.gd_scene_header(3)
+      .newline()
+      .node_header("Root", "Node2D")
+      .node_header("Layer \"1\"", "TileMap", ".")
+      .variable("cell_quadrant_size", "16")
+      .variable("visible", false)
+      .variable_quoted("name", "a\\b");
+
+  writer.set_key_prefix("0/");
+  writer.variable("z_index", "1");
+
+  ASSERT_TRUE(writer.flush().has_value());
+  EXPECT_EQ(stream.str(),
+            "[gd_scene load_steps=3 format=2]\n"
+            "\n"
+            "[node name=\"Root\" type=\"Node2D\"]\n"
+            "[node name=\"Layer \\\"1\\\"\" type=\"TileMap\" parent=\".\"]\n"
+            "cell_quadrant_size = 16\n"
+            "visible = false\n"
+            "name = \"a\\\\b\"\n"
+            "0/z_index = 1\n");
+}
+
+// tactile::godot_tscn::Gd3SceneWriter::begin_sequence_variable
+// tactile::godot_tscn::Gd3SceneWriter::sequence_element
+// tactile::godot_tscn::Gd3SceneWriter::end_sequence_variable
+TEST(Gd3SceneWriter, SequenceVariables)
+{
+  const std::vector<int> numbers {1, -2, 3};
+
+  std::ostringstream stream {};
+  Gd3SceneWriter writer {stream};
+
+  writer.sequence_variable("tile_data", "PoolIntArray", numbers)
+      .begin_sequence_variable("empty", "PoolIntArray")
+      .end_sequence_variable()
+      .vector2_variable("cell_size", Int2 {16, 32})
+      .vector2_variable("position", Float2 {1.5f, -2.0f})
+      .rect2_variable("region", Int4 {0, 16, 32, 48})
+      .color_variable("modulate", FColor {1.0f, 0.5f, 0.25f, 0.0f})
+      .sub_resource_variable("tile_set", 2)
+      .ext_resource_variable("texture", 3);
+
+  ASSERT_TRUE(writer.flush().has_value());
+  EXPECT_EQ(stream.str(),
+            "tile_data = PoolIntArray( 1, -2, 3 )\n"
+            "empty = PoolIntArray(  )\n"
+            "cell_size = Vector2( 16, 32 )\n"
+            "position = Vector2( 1.500, -2.000 )\n"
+            "region = Rect2( 0, 16, 32, 48 )\n"
+            "modulate = Color( 1.000, 0.500, 0.250, 0.000 )\n"
+            "tile_set = SubResource( 2 )\n"
+            "texture = ExtResource( 3 )\n");
+}
+
+// tactile::godot_tscn::Gd3SceneWriter::sequence_element
+// tactile::godot_tscn::Gd3SceneWriter::flush
+TEST(Gd3SceneWriter, ChunkedFlushing)
+{
+  constexpr std::size_t kElementCount = Gd3SceneWriter::kFlushThreshold;
+
+  std::ostringstream stream {};
+  Gd3SceneWriter writer {stream};
+
+  std::string expected {"tile_data = PoolIntArray( "};
+
+  writer.begin_sequence_variable("tile_data", "PoolIntArray");
+  for (std::size_t index = 0; index < kElementCount; ++index) {
+    writer.sequence_element(index % 10);
+
+    expected += (index != 0) ? ", " : "";
+    expected += static_cast<char>('0' + index % 10);
+  }
+
+  // Large sequences are written in chunks, before the writer is explicitly flushed.
+  const auto flushed_size = stream.str().size();
+  EXPECT_GE(flushed_size, Gd3SceneWriter::kFlushThreshold);
+  EXPECT_LT(flushed_size, expected.size());
+
+  writer.end_sequence_variable();
+  expected += " )\n";
+
+  ASSERT_TRUE(writer.flush().has_value());
+  EXPECT_EQ(stream.str(), expected);
+}
+
+// tactile::godot_tscn::Gd3SceneWriter::flush
+TEST(Gd3SceneWriter, FlushToBadStream)
+{
+  std::ostringstream stream {};
+  stream.setstate(std::ios::badbit);
+
+  Gd3SceneWriter writer {stream};
+  writer.resource_header();
+
+  EXPECT_EQ(writer.flush(), std::unexpected {ErrorCode::kWriteError});
+}
+
+}  // namespace
+}  // namespace tactile::godot_tscn
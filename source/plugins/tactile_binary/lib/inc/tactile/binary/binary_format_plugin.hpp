@@ -0,0 +1,31 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <memory>  // unique_ptr
+
+#include "tactile/base/io/save/save_format.hpp"
+#include "tactile/base/runtime/plugin.hpp"
+#include "tactile/binary/api.hpp"
+
+namespace tactile::binary_format {
+
+class TACTILE_BINARY_FORMAT_API BinaryFormatPlugin final : public IPlugin
+{
+ public:
+  void load(IRuntime* runtime) override;
+
+  void unload() override;
+
+ private:
+  IRuntime* m_runtime {};
+  std::unique_ptr<ISaveFormat> m_format {};
+};
+
+extern "C"
+{
+  TACTILE_BINARY_FORMAT_API auto tactile_make_plugin() -> IPlugin*;
+  TACTILE_BINARY_FORMAT_API void tactile_free_plugin(IPlugin* plugin);
+}
+
+}  // namespace tactile::binary_format
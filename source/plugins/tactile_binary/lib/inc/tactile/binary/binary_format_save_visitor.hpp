@@ -0,0 +1,66 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <vector>  // vector
+
+#include "tactile/base/document/document_visitor.hpp"
+#include "tactile/base/id.hpp"
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/io/save/save_format.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/binary/api.hpp"
+
+namespace tactile::binary_format {
+
+/**
+ * A document visitor that produces intermediate maps for the binary format.
+ */
+class TACTILE_BINARY_FORMAT_API BinaryFormatSaveVisitor final : public IDocumentVisitor
+{
+ public:
+  /**
+   * Creates a visitor.
+   *
+   * \param options The write options to use.
+   */
+  explicit BinaryFormatSaveVisitor(SaveFormatWriteOptions options);
+
+  [[nodiscard]]
+  auto visit(const IMapView& map) -> std::expected<void, ErrorCode> override;
+
+  [[nodiscard]]
+  auto visit(const ITilesetView& tileset) -> std::expected<void, ErrorCode> override;
+
+  [[nodiscard]]
+  auto visit(const ITileView& tile) -> std::expected<void, ErrorCode> override;
+
+  [[nodiscard]]
+  auto visit(const ILayerView& layer) -> std::expected<void, ErrorCode> override;
+
+  [[nodiscard]]
+  auto visit(const IObjectView& object) -> std::expected<void, ErrorCode> override;
+
+  [[nodiscard]]
+  auto visit(const IComponentView& component) -> std::expected<void, ErrorCode> override;
+
+  [[nodiscard]]
+  auto get_map() const -> const ir::Map&;
+
+ private:
+  SaveFormatWriteOptions m_options;
+  ir::Map m_map {};
+  ByteStream m_tile_byte_cache {};
+
+  [[nodiscard]]
+  auto _find_tileset(TileID first_tile_id) -> ir::Tileset*;
+
+  [[nodiscard]]
+  auto _find_tile(const ITileView& tile) -> ir::Tile*;
+
+  [[nodiscard]]
+  static auto _find_layer(std::vector<ir::Layer>& layers, LayerID id) -> ir::Layer*;
+};
+
+}  // namespace tactile::binary_format
@@ -0,0 +1,304 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <array>        // array
+#include <cstddef>      // size_t
+#include <cstdint>      // uint8_t, uint32_t, uint64_t
+#include <expected>     // expected
+#include <optional>     // optional
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/id.hpp"
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/io/tile_filter.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/base/util/tile_matrix.hpp"
+#include "tactile/binary/api.hpp"
+
+namespace tactile::binary_format {
+
+/*
+ * A binary map file consists of a fixed-size header, a table of contents, and
+ * a sequence of sections. All integers are stored using little endian byte
+ * ordering.
+ *
+ *   Header:       magic (8 bytes), version (u32), section count (u32)
+ *   TOC entries:  one fixed-size entry per section, see BinarySectionEntry
+ *   Sections:     payloads at the offsets listed in the table of contents
+ *
+ * The map, tileset, and layer metadata (i.e., everything but the tile data) are
+ * stored in three separate sections. The tile data of each tile layer is split
+ * into square chunks that are stored (and compressed) independently, which
+ * means that readers only need the header and the table of contents to locate
+ * any individual chunk. Chunks that only contain empty tiles are omitted.
+ *
+ * Compressed tile chunks may be filtered before compression, see TileFilter.
+ * The filter is recorded per chunk, so a single file may mix filters, e.g.,
+ * when tile layers select their own filters using the \c kTileFilterProperty
+ * property. Version
+ * 1 files predate tile filters, and are read as if no filters were used.
+ */
+
+inline constexpr std::array<std::uint8_t, 8> kBinaryMapMagic {
+  'T', 'A', 'C', 'T', 'B', 'M', 'A', 'P',
+};
+
+inline constexpr std::uint32_t kBinaryMapVersion = 2;
+
+inline constexpr std::size_t kBinaryMapHeaderSize = 16;
+inline constexpr std::size_t kBinarySectionEntrySize = 40;
+
+/**
+ * The name of the tile layer property that selects the filter used by the layer.
+ *
+ * \details
+ * The property value is a tile filter name, see \c parse_tile_filter. Layers
+ * without a valid value use the filter given by the encoding options.
+ */
+inline constexpr std::string_view kTileFilterProperty = "tile_filter";
+
+/** The width and height of tile chunks, in tiles. */
+inline constexpr std::size_t kTileChunkSize = 64;
+
+/** The maximum number of nested group layers in binary map files. */
+inline constexpr std::size_t kMaxLayerDepth = 64;
+
+/**
+ * Represents the different kinds of sections in binary map files.
+ */
+enum class BinarySectionType : std::uint8_t
+{
+  /** General map information and component definitions. */
+  kMap,
+
+  /** Tileset definitions. */
+  kTilesets,
+
+  /** The layer hierarchy, including objects but excluding tile data. */
+  kLayers,
+
+  /** A rectangular region of tiles in a tile layer. */
+  kTileChunk,
+};
+
+/**
+ * Represents the supported section payload encodings.
+ */
+enum class BinarySectionCodec : std::uint8_t
+{
+  /** The payload is stored verbatim. */
+  kNone,
+
+  /** The payload is a single Zstd frame. */
+  kZstd,
+};
+
+/**
+ * Describes a section in a binary map file.
+ */
+struct BinarySectionEntry final
+{
+  /** The kind of data stored in the section. */
+  BinarySectionType type;
+
+  /** The encoding of the stored payload. */
+  BinarySectionCodec codec;
+
+  /** The filter applied to the payload before it was encoded, only used by tile chunks. */
+  TileFilter filter;
+
+  /** The associated tile layer, only used by tile chunks. */
+  LayerID layer_id;
+
+  /** The chunk row index, only used by tile chunks. */
+  std::uint32_t chunk_row;
+
+  /** The chunk column index, only used by tile chunks. */
+  std::uint32_t chunk_col;
+
+  /** The offset of the payload, from the start of the file. */
+  std::uint64_t offset;
+
+  /** The size of the stored payload, in bytes. */
+  std::uint32_t stored_size;
+
+  /** The size of the decoded payload, in bytes. */
+  std::uint32_t raw_size;
+
+  /** A checksum of the stored payload. */
+  std::uint32_t checksum;
+
+  [[nodiscard]]
+  auto operator==(const BinarySectionEntry&) const -> bool = default;
+};
+
+/**
+ * Provides options for binary map encoding.
+ */
+struct BinaryMapEncodeOptions final
+{
+  /** Whether the section payloads are compressed. */
+  bool use_compression;
+
+  /** The Zstd compression level. */
+  int compression_level;
+
+  /** The maximum number of threads used to compress sections. */
+  std::size_t thread_count;
+
+  /** The filter applied to tile chunks before they are compressed, see kTileFilterProperty. */
+  TileFilter tile_filter;
+};
+
+/**
+ * Returns the tile filter with a given name.
+ *
+ * \details
+ * The valid names are "none", "shuffle", and "delta_shuffle".
+ *
+ * \param name The name of the filter.
+ *
+ * \return
+ * A tile filter; an empty optional if the name is invalid.
+ */
+[[nodiscard]]
+TACTILE_BINARY_FORMAT_API auto parse_tile_filter(std::string_view name)
+    -> std::optional<TileFilter>;
+
+/**
+ * Returns the filter selected by a tile layer.
+ *
+ * \param layer          The tile layer.
+ * \param default_filter The filter used if the layer doesn't select a valid filter.
+ *
+ * \return
+ * A tile filter.
+ */
+[[nodiscard]]
+TACTILE_BINARY_FORMAT_API auto get_layer_tile_filter(const ir::Layer& layer,
+                                                     TileFilter default_filter)
+    -> TileFilter;
+
+/**
+ * Encodes a map using the binary map format.
+ *
+ * \details
+ * Sections are compressed in parallel. Compressed payloads that aren't smaller
+ * than the original data are stored verbatim instead.
+ *
+ * \param map     The map to encode.
+ * \param options The encoding options.
+ *
+ * \return
+ * The encoded map if successful; an error code otherwise.
+ */
+[[nodiscard]]
+TACTILE_BINARY_FORMAT_API auto encode_binary_map(const ir::Map& map,
+                                                 const BinaryMapEncodeOptions& options)
+    -> std::expected<ByteStream, ErrorCode>;
+
+/**
+ * Parses the header and table of contents of an encoded binary map.
+ *
+ * \details
+ * Only the first \c get_binary_map_toc_size() bytes of the file are required,
+ * which makes it possible to locate sections without reading entire files.
+ *
+ * \param bytes The leading bytes of an encoded binary map.
+ *
+ * \return
+ * The section entries if successful; an error code otherwise.
+ */
+[[nodiscard]]
+TACTILE_BINARY_FORMAT_API auto parse_binary_map_toc(ByteSpan bytes)
+    -> std::expected<std::vector<BinarySectionEntry>, ErrorCode>;
+
+/**
+ * Returns the size of the header and table of contents of an encoded binary map.
+ *
+ * \param bytes The leading bytes of an encoded binary map, at least the header.
+ *
+ * \return
+ * A size in bytes if successful; an error code otherwise.
+ */
+[[nodiscard]]
+TACTILE_BINARY_FORMAT_API auto get_binary_map_toc_size(ByteSpan bytes)
+    -> std::expected<std::size_t, ErrorCode>;
+
+/**
+ * Decodes the payload of a section.
+ *
+ * \details
+ * This function is thread-safe.
+ *
+ * \param entry   The section entry.
+ * \param payload The stored section payload.
+ *
+ * \return
+ * The decoded payload if successful; an error code otherwise.
+ */
+[[nodiscard]]
+TACTILE_BINARY_FORMAT_API auto decode_binary_section(const BinarySectionEntry& entry,
+                                                     ByteSpan payload)
+    -> std::expected<ByteStream, ErrorCode>;
+
+/**
+ * Decodes everything but the tile data of an encoded binary map.
+ *
+ * \details
+ * The tiles of tile layers are initialized to empty tiles. Maps with group
+ * layers nested deeper than \c kMaxLayerDepth, duplicate layer identifiers, or
+ * tile layers whose extent differs from the map extent are rejected.
+ *
+ * \param bytes The encoded binary map.
+ * \param toc   The parsed table of contents.
+ *
+ * \return
+ * The decoded map if successful; an error code otherwise.
+ */
+[[nodiscard]]
+TACTILE_BINARY_FORMAT_API auto decode_binary_map_metadata(
+    ByteSpan bytes,
+    const std::vector<BinarySectionEntry>& toc) -> std::expected<ir::Map, ErrorCode>;
+
+/**
+ * Decodes a tile chunk into a tile matrix.
+ *
+ * \details
+ * This function is thread-safe, as long as concurrent calls use distinct
+ * chunks in the tile matrix.
+ *
+ * \param entry   The tile chunk section entry.
+ * \param payload The stored tile chunk payload.
+ * \param tiles   The tile matrix of the associated tile layer.
+ *
+ * \return
+ * Nothing if successful; an error code otherwise.
+ */
+[[nodiscard]]
+TACTILE_BINARY_FORMAT_API auto decode_binary_tile_chunk(const BinarySectionEntry& entry,
+                                                        ByteSpan payload,
+                                                        TileMatrix& tiles)
+    -> std::expected<void, ErrorCode>;
+
+/**
+ * Decodes an entire binary map.
+ *
+ * \details
+ * Tile chunks are decoded in parallel.
+ *
+ * \param bytes        The encoded binary map.
+ * \param thread_count The maximum number of threads used to decode tile chunks.
+ *
+ * \return
+ * The decoded map if successful; an error code otherwise.
+ */
+[[nodiscard]]
+TACTILE_BINARY_FORMAT_API auto decode_binary_map(ByteSpan bytes, std::size_t thread_count)
+    -> std::expected<ir::Map, ErrorCode>;
+
+}  // namespace tactile::binary_format
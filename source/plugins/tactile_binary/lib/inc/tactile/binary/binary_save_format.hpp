@@ -0,0 +1,33 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include "tactile/base/io/save/save_format.hpp"
+#include "tactile/binary/api.hpp"
+
+namespace tactile::binary_format {
+
+/**
+ * Implements the native binary save format.
+ *
+ * \details
+ * Binary maps are intended for fast saving and loading of large maps. The tile
+ * data of each layer is split into chunks that are compressed independently,
+ * using all available hardware threads.
+ *
+ * \see binary_map_codec.hpp
+ */
+class TACTILE_BINARY_FORMAT_API BinarySaveFormat final : public ISaveFormat
+{
+ public:
+  [[nodiscard]]
+  auto load_map(const std::filesystem::path& map_path,
+                const SaveFormatReadOptions& options) const
+      -> std::expected<ir::Map, ErrorCode> override;
+
+  [[nodiscard]]
+  auto save_map(const IMapView& map, const SaveFormatWriteOptions& options) const
+      -> std::expected<void, ErrorCode> override;
+};
+
+}  // namespace tactile::binary_format
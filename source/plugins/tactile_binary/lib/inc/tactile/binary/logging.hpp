@@ -0,0 +1,31 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include "api.hpp"
+#include "tactile/log/logger.hpp"
+#include "tactile/binary/api.hpp"
+
+namespace tactile::binary_format {
+
+TACTILE_BINARY_FORMAT_API void set_logger(log::Logger* logger) noexcept;
+
+[[nodiscard]]
+TACTILE_BINARY_FORMAT_API auto get_logger() noexcept -> log::Logger*;
+
+}  // namespace tactile::binary_format
+
+#define TACTILE_BINARY_FORMAT_TRACE(Fmt, ...) \
+  TACTILE_LOG_TRACE(::tactile::binary_format::get_logger(), Fmt, __VA_ARGS__)
+
+#define TACTILE_BINARY_FORMAT_DEBUG(Fmt, ...) \
+  TACTILE_LOG_DEBUG(::tactile::binary_format::get_logger(), Fmt, __VA_ARGS__)
+
+#define TACTILE_BINARY_FORMAT_INFO(Fmt, ...) \
+  TACTILE_LOG_INFO(::tactile::binary_format::get_logger(), Fmt, __VA_ARGS__)
+
+#define TACTILE_BINARY_FORMAT_WARN(Fmt, ...) \
+  TACTILE_LOG_WARN(::tactile::binary_format::get_logger(), Fmt, __VA_ARGS__)
+
+#define TACTILE_BINARY_FORMAT_ERROR(Fmt, ...) \
+  TACTILE_LOG_ERROR(::tactile::binary_format::get_logger(), Fmt, __VA_ARGS__)
@@ -0,0 +1,41 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/binary/binary_format_plugin.hpp"
+
+#include <new>  // nothrow
+
+#include "tactile/base/runtime/runtime.hpp"
+#include "tactile/binary/binary_save_format.hpp"
+#include "tactile/binary/logging.hpp"
+
+namespace tactile::binary_format {
+
+void BinaryFormatPlugin::load(IRuntime* runtime)
+{
+  m_runtime = runtime;
+  set_logger(m_runtime->get_logger());
+
+  m_format = std::make_unique<BinarySaveFormat>();
+  m_runtime->set_save_format(SaveFormatId::kTactileBinary, m_format.get());
+}
+
+void BinaryFormatPlugin::unload()
+{
+  m_runtime->set_save_format(SaveFormatId::kTactileBinary, nullptr);
+  m_format.reset();
+
+  set_logger(nullptr);
+  m_runtime = nullptr;
+}
+
+auto tactile_make_plugin() -> IPlugin*
+{
+  return new (std::nothrow) BinaryFormatPlugin {};
+}
+
+void tactile_free_plugin(IPlugin* plugin)
+{
+  delete plugin;
+}
+
+}  // namespace tactile::binary_format
@@ -0,0 +1,275 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/binary/binary_format_save_visitor.hpp"
+
+#include <algorithm>   // find
+#include <cstddef>     // size_t, ptrdiff_t
+#include <filesystem>  // relative
+#include <string>      // string
+#include <utility>     // move
+
+#include "tactile/base/document/component_view.hpp"
+#include "tactile/base/document/layer_view.hpp"
+#include "tactile/base/document/map_view.hpp"
+#include "tactile/base/document/meta_view.hpp"
+#include "tactile/base/document/object_view.hpp"
+#include "tactile/base/document/tile_view.hpp"
+#include "tactile/base/document/tileset_view.hpp"
+#include "tactile/base/io/tile_io.hpp"
+#include "tactile/base/numeric/literals.hpp"
+#include "tactile/base/platform/filesystem.hpp"
+#include "tactile/binary/logging.hpp"
+
+namespace tactile::binary_format {
+namespace {
+
+[[nodiscard]]
+auto _convert_metadata(const IMetaView& meta) -> ir::Metadata
+{
+  ir::Metadata ir_meta {};
+  ir_meta.name = meta.get_name();
+
+  const auto property_count = meta.property_count();
+  ir_meta.properties.reserve(property_count);
+
+  for (auto index = 0_uz; index < property_count; ++index) {
+    const auto& [property_name, property_value] = meta.get_property(index);
+    ir_meta.properties.push_back(ir::NamedAttribute {
+      .name = property_name,
+      .value = property_value,
+    });
+  }
+
+  return ir_meta;
+}
+
+[[nodiscard]]
+auto _convert_object(const IObjectView& object) -> ir::Object
+{
+  return ir::Object {
+    .meta = _convert_metadata(object.get_meta()),
+    .id = object.get_id(),
+    .type = object.get_type(),
+    .position = object.get_position(),
+    .size = object.get_size(),
+    .tag = std::string {object.get_tag()},
+    .visible = object.is_visible(),
+  };
+}
+
+}  // namespace
+
+BinaryFormatSaveVisitor::BinaryFormatSaveVisitor(SaveFormatWriteOptions options)
+  : m_options {std::move(options)}
+{}
+
+auto BinaryFormatSaveVisitor::visit(const IMapView& map) -> std::expected<void, ErrorCode>
+{
+  m_map.meta = _convert_metadata(map.get_meta());
+  m_map.extent = map.get_extent();
+  m_map.tile_size = map.get_tile_size();
+  m_map.next_layer_id = map.get_next_layer_id();
+  m_map.next_object_id = map.get_next_object_id();
+  m_map.tile_format = ir::TileFormat {
+    .encoding = map.get_tile_encoding(),
+    .compression = map.get_tile_compression(),
+    .compression_level = map.get_compression_level(),
+  };
+
+  m_map.components.reserve(map.component_count());
+  m_map.tilesets.reserve(map.tileset_count());
+  m_map.layers.reserve(map.layer_count());
+
+  return {};
+}
+
+auto BinaryFormatSaveVisitor::visit(const ITilesetView& tileset)
+    -> std::expected<void, ErrorCode>
+{
+  const auto relative_image_path =
+      std::filesystem::relative(tileset.get_image_path(), m_options.base_dir);
+
+  ir::Tileset ir_tileset {};
+  ir_tileset.meta = _convert_metadata(tileset.get_meta());
+  ir_tileset.tile_size = tileset.get_tile_size();
+  ir_tileset.tile_count = static_cast<std::ptrdiff_t>(tileset.tile_count());
+  ir_tileset.column_count = static_cast<std::ptrdiff_t>(tileset.column_count());
+  ir_tileset.image_size = tileset.get_image_size();
+  ir_tileset.image_path = normalize_path_separators(relative_image_path);
+  ir_tileset.tiles.reserve(tileset.tile_definition_count());
+
+  // Tilesets are always embedded in binary maps, but the preference is kept so
+  // that it survives conversions to other formats.
+  ir_tileset.is_embedded = !m_options.use_external_tilesets;
+
+  m_map.tilesets.push_back(ir::TilesetRef {
+    .tileset = std::move(ir_tileset),
+    .first_tile_id = tileset.get_first_tile_id(),
+  });
+
+  return {};
+}
+
+auto BinaryFormatSaveVisitor::visit(const ITileView& tile) -> std::expected<void, ErrorCode>
+{
+  auto* ir_tileset = _find_tileset(tile.get_parent_tileset().get_first_tile_id());
+  if (!ir_tileset) {
+    TACTILE_BINARY_FORMAT_ERROR("Tile {} has no associated tileset", tile.get_index());
+    return std::unexpected {ErrorCode::kBadState};
+  }
+
+  ir::Tile ir_tile {};
+  ir_tile.meta = _convert_metadata(tile.get_meta());
+  ir_tile.index = tile.get_index();
+  ir_tile.objects.reserve(tile.object_count());
+
+  const auto frame_count = tile.animation_frame_count();
+  ir_tile.animation.reserve(frame_count);
+
+  for (auto frame_index = 0_uz; frame_index < frame_count; ++frame_index) {
+    const auto [frame_tile, frame_duration] = tile.get_animation_frame(frame_index);
+    ir_tile.animation.push_back(ir::AnimationFrame {
+      .tile_index = frame_tile,
+      .duration = frame_duration,
+    });
+  }
+
+  ir_tileset->tiles.push_back(std::move(ir_tile));
+
+  return {};
+}
+
+auto BinaryFormatSaveVisitor::visit(const ILayerView& layer) -> std::expected<void, ErrorCode>
+{
+  ir::Layer ir_layer {};
+  ir_layer.meta = _convert_metadata(layer.get_meta());
+  ir_layer.id = layer.get_id();
+  ir_layer.type = layer.get_type();
+  ir_layer.opacity = layer.get_opacity();
+  ir_layer.extent = layer.get_extent().value_or(Extent2D {0, 0});
+  ir_layer.visible = layer.is_visible();
+  ir_layer.objects.reserve(layer.object_count());
+  ir_layer.layers.reserve(layer.layer_count());
+
+  if (ir_layer.type == LayerType::kTileLayer) {
+    m_tile_byte_cache.clear();
+    layer.write_tile_bytes(m_tile_byte_cache);
+
+    auto tiles =
+        parse_raw_tile_matrix(m_tile_byte_cache, ir_layer.extent, TileIdFormat::kTactile);
+    if (!tiles.has_value()) {
+      TACTILE_BINARY_FORMAT_ERROR("Could not read tiles of layer {}", ir_layer.id);
+      return std::unexpected {ErrorCode::kBadState};
+    }
+
+    ir_layer.tiles = std::move(*tiles);
+  }
+
+  if (const auto* parent_layer = layer.get_parent_layer()) {
+    auto* ir_parent_layer = _find_layer(m_map.layers, parent_layer->get_id());
+    if (!ir_parent_layer) {
+      TACTILE_BINARY_FORMAT_ERROR("Layer {} has no parent layer", ir_layer.id);
+      return std::unexpected {ErrorCode::kBadState};
+    }
+
+    ir_parent_layer->layers.push_back(std::move(ir_layer));
+  }
+  else {
+    m_map.layers.push_back(std::move(ir_layer));
+  }
+
+  return {};
+}
+
+auto BinaryFormatSaveVisitor::visit(const IObjectView& object)
+    -> std::expected<void, ErrorCode>
+{
+  if (const auto* parent_layer = object.get_parent_layer()) {
+    if (auto* ir_layer = _find_layer(m_map.layers, parent_layer->get_id())) {
+      ir_layer->objects.push_back(_convert_object(object));
+      return {};
+    }
+  }
+  else if (const auto* parent_tile = object.get_parent_tile()) {
+    if (auto* ir_tile = _find_tile(*parent_tile)) {
+      ir_tile->objects.push_back(_convert_object(object));
+      return {};
+    }
+  }
+
+  TACTILE_BINARY_FORMAT_ERROR("Object {} has no parent layer or tile", object.get_id());
+  return std::unexpected {ErrorCode::kBadState};
+}
+
+auto BinaryFormatSaveVisitor::visit(const IComponentView& component)
+    -> std::expected<void, ErrorCode>
+{
+  ir::Component ir_component {};
+  ir_component.name = component.get_name();
+
+  const auto attribute_count = component.attribute_count();
+  ir_component.attributes.reserve(attribute_count);
+
+  for (auto index = 0_uz; index < attribute_count; ++index) {
+    const auto& [attribute_name, attribute_value] = component.get_attribute(index);
+    ir_component.attributes.push_back(ir::NamedAttribute {
+      .name = attribute_name,
+      .value = attribute_value,
+    });
+  }
+
+  m_map.components.push_back(std::move(ir_component));
+
+  return {};
+}
+
+auto BinaryFormatSaveVisitor::get_map() const -> const ir::Map&
+{
+  return m_map;
+}
+
+auto BinaryFormatSaveVisitor::_find_tileset(const TileID first_tile_id) -> ir::Tileset*
+{
+  const auto tileset_ref_iter =
+      std::ranges::find(m_map.tilesets, first_tile_id, &ir::TilesetRef::first_tile_id);
+
+  if (tileset_ref_iter != m_map.tilesets.end()) {
+    return &tileset_ref_iter->tileset;
+  }
+
+  return nullptr;
+}
+
+auto BinaryFormatSaveVisitor::_find_tile(const ITileView& tile) -> ir::Tile*
+{
+  auto* ir_tileset = _find_tileset(tile.get_parent_tileset().get_first_tile_id());
+  if (!ir_tileset) {
+    return nullptr;
+  }
+
+  const auto tile_iter =
+      std::ranges::find(ir_tileset->tiles, tile.get_index(), &ir::Tile::index);
+  if (tile_iter != ir_tileset->tiles.end()) {
+    return &*tile_iter;
+  }
+
+  return nullptr;
+}
+
+auto BinaryFormatSaveVisitor::_find_layer(std::vector<ir::Layer>& layers, const LayerID id)
+    -> ir::Layer*
+{
+  for (auto& layer : layers) {
+    if (layer.id == id) {
+      return &layer;
+    }
+
+    if (auto* nested_layer = _find_layer(layer.layers, id)) {
+      return nested_layer;
+    }
+  }
+
+  return nullptr;
+}
+
+}  // namespace tactile::binary_format
@@ -0,0 +1,1232 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/binary/binary_map_codec.hpp"
+
+#include <algorithm>    // min, max, clamp, equal, find, sort, lower_bound, adjacent_find
+#include <atomic>       // atomic, memory_order
+#include <bit>          // bit_cast, endian, byteswap
+#include <chrono>       // milliseconds
+#include <concepts>     // integral, same_as
+#include <cstring>      // memcpy
+#include <filesystem>   // path
+#include <limits>       // numeric_limits
+#include <memory>       // unique_ptr
+#include <new>          // bad_alloc
+#include <optional>     // optional
+#include <string>       // string
+#include <string_view>  // string_view
+#include <thread>       // jthread
+#include <tuple>        // tie, ignore
+#include <type_traits>  // is_enum_v, underlying_type_t
+#include <utility>      // move, pair, to_underlying
+
+#include <zstd.h>
+
+#include "tactile/base/numeric/vec.hpp"
+#include "tactile/base/platform/bits.hpp"
+#include "tactile/base/platform/filesystem.hpp"
+#include "tactile/base/util/hash.hpp"
+
+namespace tactile::binary_format {
+namespace {
+
+// Avoids spawning threads for small maps, where it would only add overhead.
+inline constexpr std::size_t kMinSectionsPerThread = 16;
+
+struct CCtxDeleter final
+{
+  void operator()(ZSTD_CCtx* context) noexcept
+  {
+    ZSTD_freeCCtx(context);
+  }
+};
+
+struct DCtxDeleter final
+{
+  void operator()(ZSTD_DCtx* context) noexcept
+  {
+    ZSTD_freeDCtx(context);
+  }
+};
+
+using UniqueCCtx = std::unique_ptr<ZSTD_CCtx, CCtxDeleter>;
+using UniqueDCtx = std::unique_ptr<ZSTD_DCtx, DCtxDeleter>;
+
+template <typename T>
+concept BinaryScalar = std::integral<T> || std::same_as<T, float>;
+
+/**
+ * Serializes values into a byte stream using little endian byte ordering.
+ */
+class ByteWriter final
+{
+ public:
+  template <BinaryScalar T>
+  void write(const T value)
+  {
+    if constexpr (std::same_as<T, float>) {
+      write(std::bit_cast<std::uint32_t>(value));
+    }
+    else if constexpr (std::same_as<T, bool>) {
+      write(static_cast<std::uint8_t>(value ? 1 : 0));
+    }
+    else {
+      const auto le_value = to_little_endian(value);
+
+      const auto offset = m_bytes.size();
+      m_bytes.resize(offset + sizeof le_value);
+      std::memcpy(m_bytes.data() + offset, &le_value, sizeof le_value);
+    }
+  }
+
+  template <typename T>
+    requires std::is_enum_v<T>
+  void write(const T value)
+  {
+    write(std::to_underlying(value));
+  }
+
+  template <BinaryScalar T, std::size_t N>
+  void write(const Vec<T, N>& vec)
+  {
+    for (std::size_t index = 0; index < N; ++index) {
+      write(vec[index]);
+    }
+  }
+
+  void write(const std::string_view str)
+  {
+    write_count(str.size());
+    m_bytes.insert(m_bytes.end(), str.begin(), str.end());
+  }
+
+  void write_count(const std::size_t count)
+  {
+    write(static_cast<std::uint32_t>(count));
+  }
+
+  [[nodiscard]]
+  auto take_bytes() -> ByteStream
+  {
+    return std::move(m_bytes);
+  }
+
+ private:
+  ByteStream m_bytes {};
+};
+
+/**
+ * Deserializes values written by a byte writer.
+ *
+ * \details
+ * Reads past the end of the data yield default values and mark the reader as
+ * failed, so that the result only has to be checked once at the end.
+ */
+class ByteReader final
+{
+ public:
+  explicit ByteReader(const ByteSpan bytes)
+    : m_bytes {bytes}
+  {}
+
+  template <BinaryScalar T>
+  [[nodiscard]] auto read() -> T
+  {
+    if constexpr (std::same_as<T, float>) {
+      return std::bit_cast<float>(read<std::uint32_t>());
+    }
+    else if constexpr (std::same_as<T, bool>) {
+      return read<std::uint8_t>() != 0;
+    }
+    else {
+      T value {};
+
+      if (m_bytes.size() < sizeof value) {
+        m_failed = true;
+        return value;
+      }
+
+      std::memcpy(&value, m_bytes.data(), sizeof value);
+      m_bytes = m_bytes.subspan(sizeof value);
+
+      return to_little_endian(value);
+    }
+  }
+
+  template <typename T>
+    requires std::is_enum_v<T>
+  [[nodiscard]] auto read_enum(const T max_value) -> T
+  {
+    const auto value = read<std::underlying_type_t<T>>();
+
+    if (value > std::to_underlying(max_value)) {
+      m_failed = true;
+      return T {};
+    }
+
+    return static_cast<T>(value);
+  }
+
+  template <BinaryScalar T, std::size_t N>
+  [[nodiscard]] auto read_vec() -> Vec<T, N>
+  {
+    Vec<T, N> vec {};
+
+    for (std::size_t index = 0; index < N; ++index) {
+      vec[index] = read<T>();
+    }
+
+    return vec;
+  }
+
+  [[nodiscard]]
+  auto read_string() -> std::string
+  {
+    const auto length = read_count();
+
+    std::string str {};
+    str.assign(reinterpret_cast<const char*>(m_bytes.data()), length);
+    m_bytes = m_bytes.subspan(length);
+
+    return str;
+  }
+
+  // Each element occupies at least one byte, which rules out counts that would
+  // otherwise lead to excessive allocations if the data is corrupt.
+  [[nodiscard]]
+  auto read_count() -> std::size_t
+  {
+    const auto count = static_cast<std::size_t>(read<std::uint32_t>());
+
+    if (count > m_bytes.size()) {
+      m_failed = true;
+      return 0;
+    }
+
+    return count;
+  }
+
+  // Used for data that can be read, but is invalid.
+  void fail() noexcept
+  {
+    m_failed = true;
+  }
+
+  [[nodiscard]]
+  auto is_good() const noexcept -> bool
+  {
+    return !m_failed;
+  }
+
+  [[nodiscard]]
+  auto is_done() const noexcept -> bool
+  {
+    return !m_failed && m_bytes.empty();
+  }
+
+ private:
+  ByteSpan m_bytes;
+  bool m_failed {false};
+};
+
+struct EncodedSection final
+{
+  BinarySectionEntry entry;
+  TileFilter filter;
+  ByteStream raw_payload;
+  ByteStream stored_payload;
+};
+
+/**
+ * Invokes a callable for each index in [0, count), using a pool of threads.
+ *
+ * \details
+ * Processing stops at the first failure, whose error code is returned. The
+ * callable must not use the logger, since it isn't thread-safe.
+ */
+template <typename T>
+[[nodiscard]] auto _parallel_for(const std::size_t count,
+                                 const std::size_t thread_count,
+                                 const T& callable) -> std::expected<void, ErrorCode>
+{
+  std::atomic<std::size_t> next_index {0};
+  std::atomic<bool> failed {false};
+  ErrorCode error {ErrorCode::kUnknown};
+
+  const auto fail = [&](const ErrorCode error_code) {
+    if (!failed.exchange(true)) {
+      error = error_code;
+    }
+  };
+
+  const auto worker = [&] {
+    while (!failed.load(std::memory_order_relaxed)) {
+      const auto index = next_index.fetch_add(1, std::memory_order_relaxed);
+      if (index >= count) {
+        return;
+      }
+
+      try {
+        const std::expected<void, ErrorCode> result = callable(index);
+        if (!result.has_value()) {
+          fail(result.error());
+        }
+      }
+      catch (const std::bad_alloc&) {
+        fail(ErrorCode::kOutOfMemory);
+      }
+      catch (...) {
+        fail(ErrorCode::kUnknown);
+      }
+    }
+  };
+
+  const auto worker_count = std::clamp(count / kMinSectionsPerThread,
+                                       std::size_t {1},
+                                       std::max(thread_count, std::size_t {1}));
+
+  {
+    std::vector<std::jthread> threads {};
+    threads.reserve(worker_count - 1);
+
+    for (std::size_t thread_index = 1; thread_index < worker_count; ++thread_index) {
+      threads.emplace_back(worker);
+    }
+
+    worker();
+  }
+
+  if (failed.load()) {
+    return std::unexpected {error};
+  }
+
+  return {};
+}
+
+void _write_attribute(ByteWriter& writer, const Attribute& attribute)
+{
+  writer.write(attribute.get_type());
+
+  switch (attribute.get_type()) {
+    case AttributeType::kStr:    writer.write(attribute.as_string()); break;
+    case AttributeType::kInt:    writer.write(attribute.as_int()); break;
+    case AttributeType::kInt2:   writer.write(attribute.as_int2()); break;
+    case AttributeType::kInt3:   writer.write(attribute.as_int3()); break;
+    case AttributeType::kInt4:   writer.write(attribute.as_int4()); break;
+    case AttributeType::kFloat:  writer.write(attribute.as_float()); break;
+    case AttributeType::kFloat2: writer.write(attribute.as_float2()); break;
+    case AttributeType::kFloat3: writer.write(attribute.as_float3()); break;
+    case AttributeType::kFloat4: writer.write(attribute.as_float4()); break;
+    case AttributeType::kBool:   writer.write(attribute.as_bool()); break;
+    case AttributeType::kPath:   writer.write(attribute.as_path().string()); break;
+    case AttributeType::kColor:  {
+      const auto& color = attribute.as_color();
+      writer.write(color.red);
+      writer.write(color.green);
+      writer.write(color.blue);
+      writer.write(color.alpha);
+      break;
+    }
+    case AttributeType::kObject: writer.write(attribute.as_object().value); break;
+  }
+}
+
+[[nodiscard]]
+auto _read_attribute(ByteReader& reader) -> Attribute
+{
+  const auto type = reader.read_enum(AttributeType::kObject);
+
+  switch (type) {
+    case AttributeType::kStr:    return Attribute {reader.read_string()};
+    case AttributeType::kInt:    return Attribute {reader.read<Attribute::int_type>()};
+    case AttributeType::kInt2:   return Attribute {reader.read_vec<int, 2>()};
+    case AttributeType::kInt3:   return Attribute {reader.read_vec<int, 3>()};
+    case AttributeType::kInt4:   return Attribute {reader.read_vec<int, 4>()};
+    case AttributeType::kFloat:  return Attribute {reader.read<float>()};
+    case AttributeType::kFloat2: return Attribute {reader.read_vec<float, 2>()};
+    case AttributeType::kFloat3: return Attribute {reader.read_vec<float, 3>()};
+    case AttributeType::kFloat4: return Attribute {reader.read_vec<float, 4>()};
+    case AttributeType::kBool:   return Attribute {reader.read<bool>()};
+    case AttributeType::kPath:   {
+      return Attribute {std::filesystem::path {reader.read_string()}};
+    }
+    case AttributeType::kColor:  {
+      UColor color {};
+      color.red = reader.read<std::uint8_t>();
+      color.green = reader.read<std::uint8_t>();
+      color.blue = reader.read<std::uint8_t>();
+      color.alpha = reader.read<std::uint8_t>();
+      return Attribute {color};
+    }
+    case AttributeType::kObject: return Attribute {ObjectRef {reader.read<std::int32_t>()}};
+  }
+
+  return Attribute {};
+}
+
+void _write_named_attributes(ByteWriter& writer,
+                             const std::vector<ir::NamedAttribute>& attributes)
+{
+  writer.write_count(attributes.size());
+
+  for (const auto& [name, value] : attributes) {
+    writer.write(name);
+    _write_attribute(writer, value);
+  }
+}
+
+[[nodiscard]]
+auto _read_named_attributes(ByteReader& reader) -> std::vector<ir::NamedAttribute>
+{
+  std::vector<ir::NamedAttribute> attributes {};
+  attributes.resize(reader.read_count());
+
+  for (auto& [name, value] : attributes) {
+    name = reader.read_string();
+    value = _read_attribute(reader);
+  }
+
+  return attributes;
+}
+
+void _write_metadata(ByteWriter& writer, const ir::Metadata& meta)
+{
+  writer.write(meta.name);
+  _write_named_attributes(writer, meta.properties);
+
+  writer.write_count(meta.components.size());
+  for (const auto& component : meta.components) {
+    writer.write(component.type);
+    _write_named_attributes(writer, component.attributes);
+  }
+}
+
+[[nodiscard]]
+auto _read_metadata(ByteReader& reader) -> ir::Metadata
+{
+  ir::Metadata meta {};
+  meta.name = reader.read_string();
+  meta.properties = _read_named_attributes(reader);
+
+  meta.components.resize(reader.read_count());
+  for (auto& component : meta.components) {
+    component.type = reader.read_string();
+    component.attributes = _read_named_attributes(reader);
+  }
+
+  return meta;
+}
+
+void _write_objects(ByteWriter& writer, const std::vector<ir::Object>& objects)
+{
+  writer.write_count(objects.size());
+
+  for (const auto& object : objects) {
+    _write_metadata(writer, object.meta);
+    writer.write(object.id);
+    writer.write(object.type);
+    writer.write(object.position);
+    writer.write(object.size);
+    writer.write(object.tag);
+    writer.write(object.visible);
+  }
+}
+
+[[nodiscard]]
+auto _read_objects(ByteReader& reader) -> std::vector<ir::Object>
+{
+  std::vector<ir::Object> objects {};
+  objects.resize(reader.read_count());
+
+  for (auto& object : objects) {
+    object.meta = _read_metadata(reader);
+    object.id = reader.read<ObjectID>();
+    object.type = reader.read_enum(ObjectType::kEllipse);
+    object.position = reader.read_vec<float, 2>();
+    object.size = reader.read_vec<float, 2>();
+    object.tag = reader.read_string();
+    object.visible = reader.read<bool>();
+  }
+
+  return objects;
+}
+
+void _write_extent(ByteWriter& writer, const Extent2D& extent)
+{
+  writer.write(static_cast<std::uint64_t>(extent.rows));
+  writer.write(static_cast<std::uint64_t>(extent.cols));
+}
+
+[[nodiscard]]
+auto _read_extent(ByteReader& reader) -> Extent2D
+{
+  Extent2D extent {};
+  extent.rows = static_cast<Extent2D::value_type>(reader.read<std::uint64_t>());
+  extent.cols = static_cast<Extent2D::value_type>(reader.read<std::uint64_t>());
+  return extent;
+}
+
+[[nodiscard]]
+auto _encode_map_section(const ir::Map& map) -> ByteStream
+{
+  ByteWriter writer {};
+
+  _write_metadata(writer, map.meta);
+  _write_extent(writer, map.extent);
+  writer.write(map.tile_size);
+  writer.write(map.next_layer_id);
+  writer.write(map.next_object_id);
+
+  writer.write(map.tile_format.encoding);
+  writer.write(map.tile_format.compression.has_value());
+  writer.write(map.tile_format.compression.value_or(CompressionFormatId {}));
+  writer.write(map.tile_format.compression_level.has_value());
+  writer.write(map.tile_format.compression_level.value_or(0));
+
+  writer.write_count(map.components.size());
+  for (const auto& component : map.components) {
+    writer.write(component.name);
+    _write_named_attributes(writer, component.attributes);
+  }
+
+  return writer.take_bytes();
+}
+
+[[nodiscard]]
+auto _decode_map_section(const ByteSpan bytes, ir::Map& map) -> bool
+{
+  ByteReader reader {bytes};
+
+  map.meta = _read_metadata(reader);
+  map.extent = _read_extent(reader);
+  map.tile_size = reader.read_vec<int, 2>();
+  map.next_layer_id = reader.read<LayerID>();
+  map.next_object_id = reader.read<ObjectID>();
+
+  map.tile_format.encoding = reader.read_enum(TileEncoding::kBase64);
+
+  const auto has_compression = reader.read<bool>();
+  const auto compression = reader.read_enum(CompressionFormatId::kZstd);
+  if (has_compression) {
+    map.tile_format.compression = compression;
+  }
+
+  const auto has_compression_level = reader.read<bool>();
+  const auto compression_level = reader.read<std::int32_t>();
+  if (has_compression_level) {
+    map.tile_format.compression_level = compression_level;
+  }
+
+  map.components.resize(reader.read_count());
+  for (auto& component : map.components) {
+    component.name = reader.read_string();
+    component.attributes = _read_named_attributes(reader);
+  }
+
+  return reader.is_done();
+}
+
+[[nodiscard]]
+auto _encode_tilesets_section(const ir::Map& map) -> ByteStream
+{
+  ByteWriter writer {};
+  writer.write_count(map.tilesets.size());
+
+  for (const auto& [tileset, first_tile_id] : map.tilesets) {
+    writer.write(first_tile_id);
+    _write_metadata(writer, tileset.meta);
+    writer.write(tileset.tile_size);
+    writer.write(static_cast<std::int64_t>(tileset.tile_count));
+    writer.write(static_cast<std::int64_t>(tileset.column_count));
+    writer.write(tileset.image_size);
+    writer.write(normalize_path_separators(tileset.image_path));
+    writer.write(tileset.is_embedded);
+
+    writer.write_count(tileset.tiles.size());
+    for (const auto& tile : tileset.tiles) {
+      _write_metadata(writer, tile.meta);
+      writer.write(tile.index);
+      _write_objects(writer, tile.objects);
+
+      writer.write_count(tile.animation.size());
+      for (const auto& frame : tile.animation) {
+        writer.write(frame.tile_index);
+        writer.write(static_cast<std::int64_t>(frame.duration.count()));
+      }
+    }
+  }
+
+  return writer.take_bytes();
+}
+
+[[nodiscard]]
+auto _decode_tilesets_section(const ByteSpan bytes, ir::Map& map) -> bool
+{
+  ByteReader reader {bytes};
+  map.tilesets.resize(reader.read_count());
+
+  for (auto& [tileset, first_tile_id] : map.tilesets) {
+    first_tile_id = reader.read<TileID>();
+    tileset.meta = _read_metadata(reader);
+    tileset.tile_size = reader.read_vec<int, 2>();
+    tileset.tile_count = static_cast<std::ptrdiff_t>(reader.read<std::int64_t>());
+    tileset.column_count = static_cast<std::ptrdiff_t>(reader.read<std::int64_t>());
+    tileset.image_size = reader.read_vec<int, 2>();
+    tileset.image_path = reader.read_string();
+    tileset.is_embedded = reader.read<bool>();
+
+    tileset.tiles.resize(reader.read_count());
+    for (auto& tile : tileset.tiles) {
+      tile.meta = _read_metadata(reader);
+      tile.index = reader.read<TileIndex>();
+      tile.objects = _read_objects(reader);
+
+      tile.animation.resize(reader.read_count());
+      for (auto& frame : tile.animation) {
+        frame.tile_index = reader.read<TileIndex>();
+        frame.duration = std::chrono::milliseconds {reader.read<std::int64_t>()};
+      }
+    }
+  }
+
+  return reader.is_done();
+}
+
+void _write_layers(ByteWriter& writer, const std::vector<ir::Layer>& layers)
+{
+  writer.write_count(layers.size());
+
+  for (const auto& layer : layers) {
+    _write_metadata(writer, layer.meta);
+    writer.write(layer.id);
+    writer.write(layer.type);
+    writer.write(layer.opacity);
+    _write_extent(writer, layer.extent);
+    writer.write(layer.visible);
+    _write_objects(writer, layer.objects);
+    _write_layers(writer, layer.layers);
+  }
+}
+
+[[nodiscard]]
+auto _read_layers(ByteReader& reader, const std::size_t depth) -> std::vector<ir::Layer>
+{
+  // Bounds the recursion, since the layer hierarchy is read from untrusted data.
+  if (depth > kMaxLayerDepth) {
+    reader.fail();
+    return {};
+  }
+
+  std::vector<ir::Layer> layers {};
+  layers.resize(reader.read_count());
+
+  for (auto& layer : layers) {
+    layer.meta = _read_metadata(reader);
+    layer.id = reader.read<LayerID>();
+    layer.type = reader.read_enum(LayerType::kGroupLayer);
+    layer.opacity = reader.read<float>();
+    layer.extent = _read_extent(reader);
+    layer.visible = reader.read<bool>();
+    layer.objects = _read_objects(reader);
+    layer.layers = _read_layers(reader, depth + 1);
+
+    if (!reader.is_good()) {
+      break;
+    }
+  }
+
+  return layers;
+}
+
+// Validates decoded layers and allocates the tiles of tile layers, which must match the map.
+[[nodiscard]]
+auto _prepare_layers(std::vector<ir::Layer>& layers,
+                     const Extent2D& map_extent,
+                     std::vector<LayerID>& layer_ids) -> bool
+{
+  for (auto& layer : layers) {
+    layer_ids.push_back(layer.id);
+
+    if (layer.type == LayerType::kTileLayer) {
+      if (layer.extent != map_extent) {
+        return false;
+      }
+
+      layer.tiles = make_tile_matrix(layer.extent);
+    }
+
+    if (!_prepare_layers(layer.layers, map_extent, layer_ids)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+[[nodiscard]]
+auto _encode_layers_section(const ir::Map& map) -> ByteStream
+{
+  ByteWriter writer {};
+  _write_layers(writer, map.layers);
+  return writer.take_bytes();
+}
+
+[[nodiscard]]
+auto _decode_layers_section(const ByteSpan bytes, ir::Map& map) -> bool
+{
+  ByteReader reader {bytes};
+  map.layers = _read_layers(reader, 0);
+
+  if (!reader.is_done()) {
+    return false;
+  }
+
+  std::vector<LayerID> layer_ids {};
+  if (!_prepare_layers(map.layers, map.extent, layer_ids)) {
+    return false;
+  }
+
+  std::ranges::sort(layer_ids);
+  return std::ranges::adjacent_find(layer_ids) == layer_ids.end();
+}
+
+void _encode_tile_chunks(const std::vector<ir::Layer>& layers,
+                         const TileFilter default_filter,
+                         std::vector<EncodedSection>& sections)
+{
+  for (const auto& layer : layers) {
+    if (layer.type == LayerType::kTileLayer) {
+      const auto filter = get_layer_tile_filter(layer, default_filter);
+      const auto chunk_row_count = (layer.extent.rows + kTileChunkSize - 1) / kTileChunkSize;
+      const auto chunk_col_count = (layer.extent.cols + kTileChunkSize - 1) / kTileChunkSize;
+
+      for (std::size_t chunk_row = 0; chunk_row < chunk_row_count; ++chunk_row) {
+        for (std::size_t chunk_col = 0; chunk_col < chunk_col_count; ++chunk_col) {
+          const auto first_row = chunk_row * kTileChunkSize;
+          const auto first_col = chunk_col * kTileChunkSize;
+          const auto last_row = std::min(first_row + kTileChunkSize, layer.extent.rows);
+          const auto last_col = std::min(first_col + kTileChunkSize, layer.extent.cols);
+
+          ByteWriter writer {};
+          bool is_empty = true;
+
+          for (auto row = first_row; row < last_row; ++row) {
+            for (auto col = first_col; col < last_col; ++col) {
+              const auto tile_id = layer.tiles[row][col];
+              is_empty = is_empty && tile_id == kEmptyTile;
+              writer.write(tile_id);
+            }
+          }
+
+          if (is_empty) {
+            continue;
+          }
+
+          EncodedSection section {};
+          section.entry.type = BinarySectionType::kTileChunk;
+          section.entry.layer_id = layer.id;
+          section.entry.chunk_row = static_cast<std::uint32_t>(chunk_row);
+          section.entry.chunk_col = static_cast<std::uint32_t>(chunk_col);
+          section.filter = filter;
+          section.raw_payload = writer.take_bytes();
+
+          sections.push_back(std::move(section));
+        }
+      }
+    }
+
+    _encode_tile_chunks(layer.layers, default_filter, sections);
+  }
+}
+
+[[nodiscard]]
+auto _compress_section(EncodedSection& section, const BinaryMapEncodeOptions& options)
+    -> std::expected<void, ErrorCode>
+{
+  auto& entry = section.entry;
+  const auto& raw_payload = section.raw_payload;
+
+  if (raw_payload.size() > std::numeric_limits<std::uint32_t>::max()) {
+    return std::unexpected {ErrorCode::kNotSupported};
+  }
+
+  entry.codec = BinarySectionCodec::kNone;
+  entry.filter = TileFilter::kNone;
+  entry.raw_size = static_cast<std::uint32_t>(raw_payload.size());
+
+  if (options.use_compression && !raw_payload.empty()) {
+    thread_local UniqueCCtx context {ZSTD_createCCtx()};
+    if (!context) {
+      return std::unexpected {ErrorCode::kOutOfMemory};
+    }
+
+    // Filters are only worthwhile in front of compression, so they're tied to it.
+    const auto filter = section.filter;
+
+    std::optional<ByteStream> filtered_payload {};
+    if (filter != TileFilter::kNone) {
+      filtered_payload = apply_tile_filter(raw_payload, filter);
+      if (!filtered_payload.has_value()) {
+        return std::unexpected {ErrorCode::kBadParam};
+      }
+    }
+
+    const ByteSpan compressor_input = filtered_payload.has_value()
+                                          ? ByteSpan {*filtered_payload}
+                                          : ByteSpan {raw_payload};
+
+    auto& compressed_payload = section.stored_payload;
+    compressed_payload.resize(ZSTD_compressBound(compressor_input.size()));
+
+    const auto compressed_size = ZSTD_compressCCtx(context.get(),
+                                                   compressed_payload.data(),
+                                                   compressed_payload.size(),
+                                                   compressor_input.data(),
+                                                   compressor_input.size(),
+                                                   options.compression_level);
+    if (ZSTD_isError(compressed_size)) {
+      return std::unexpected {ErrorCode::kCouldNotCompress};
+    }
+
+    // Incompressible payloads are stored as is, to avoid decompression overhead.
+    if (compressed_size < raw_payload.size()) {
+      compressed_payload.resize(compressed_size);
+      entry.codec = BinarySectionCodec::kZstd;
+      entry.filter = filter;
+    }
+  }
+
+  if (entry.codec == BinarySectionCodec::kNone) {
+    section.stored_payload = raw_payload;
+  }
+
+  entry.stored_size = static_cast<std::uint32_t>(section.stored_payload.size());
+  entry.checksum = fnv1a_hash(section.stored_payload);
+
+  return {};
+}
+
+void _write_section_entry(ByteWriter& writer, const BinarySectionEntry& entry)
+{
+  writer.write(entry.type);
+  writer.write(entry.codec);
+  writer.write(entry.filter);
+  writer.write(std::uint8_t {0});
+  writer.write(entry.layer_id);
+  writer.write(entry.chunk_row);
+  writer.write(entry.chunk_col);
+  writer.write(entry.offset);
+  writer.write(entry.stored_size);
+  writer.write(entry.raw_size);
+  writer.write(entry.checksum);
+  writer.write(std::uint32_t {0});
+}
+
+[[nodiscard]]
+auto _read_section_entry(ByteReader& reader) -> BinarySectionEntry
+{
+  BinarySectionEntry entry {};
+
+  entry.type = reader.read_enum(BinarySectionType::kTileChunk);
+  entry.codec = reader.read_enum(BinarySectionCodec::kZstd);
+  entry.filter = reader.read_enum(TileFilter::kDeltaShuffle);
+  std::ignore = reader.read<std::uint8_t>();
+  entry.layer_id = reader.read<LayerID>();
+  entry.chunk_row = reader.read<std::uint32_t>();
+  entry.chunk_col = reader.read<std::uint32_t>();
+  entry.offset = reader.read<std::uint64_t>();
+  entry.stored_size = reader.read<std::uint32_t>();
+  entry.raw_size = reader.read<std::uint32_t>();
+  entry.checksum = reader.read<std::uint32_t>();
+  std::ignore = reader.read<std::uint32_t>();
+
+  return entry;
+}
+
+[[nodiscard]]
+auto _get_section_payload(const ByteSpan bytes, const BinarySectionEntry& entry)
+    -> std::expected<ByteSpan, ErrorCode>
+{
+  if (entry.offset > bytes.size() || entry.stored_size > bytes.size() - entry.offset) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  return bytes.subspan(static_cast<std::size_t>(entry.offset), entry.stored_size);
+}
+
+[[nodiscard]]
+auto _decode_metadata_section(const ByteSpan bytes,
+                              const std::vector<BinarySectionEntry>& toc,
+                              const BinarySectionType type,
+                              ir::Map& map,
+                              bool (*decode)(ByteSpan, ir::Map&))
+    -> std::expected<void, ErrorCode>
+{
+  const auto entry_iter = std::ranges::find(toc, type, &BinarySectionEntry::type);
+  if (entry_iter == toc.end()) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  return _get_section_payload(bytes, *entry_iter)
+      .and_then([&](const ByteSpan payload) {
+        return decode_binary_section(*entry_iter, payload);
+      })
+      .and_then([&](const ByteStream& section_bytes) -> std::expected<void, ErrorCode> {
+        if (!decode(section_bytes, map)) {
+          return std::unexpected {ErrorCode::kParseError};
+        }
+
+        return {};
+      });
+}
+
+[[nodiscard]]
+auto _decode_section_payload(const BinarySectionEntry& entry, const ByteSpan payload)
+    -> std::expected<ByteStream, ErrorCode>
+{
+  switch (entry.codec) {
+    case BinarySectionCodec::kNone: {
+      if (entry.raw_size != entry.stored_size) {
+        return std::unexpected {ErrorCode::kParseError};
+      }
+
+      return ByteStream {payload.begin(), payload.end()};
+    }
+    case BinarySectionCodec::kZstd: {
+      thread_local UniqueDCtx context {ZSTD_createDCtx()};
+      if (!context) {
+        return std::unexpected {ErrorCode::kOutOfMemory};
+      }
+
+      ByteStream raw_payload {};
+      raw_payload.resize(entry.raw_size);
+
+      const auto decompressed_size = ZSTD_decompressDCtx(context.get(),
+                                                         raw_payload.data(),
+                                                         raw_payload.size(),
+                                                         payload.data(),
+                                                         payload.size());
+
+      if (ZSTD_isError(decompressed_size) || decompressed_size != raw_payload.size()) {
+        return std::unexpected {ErrorCode::kCouldNotDecompress};
+      }
+
+      return raw_payload;
+    }
+  }
+
+  return std::unexpected {ErrorCode::kNotSupported};
+}
+
+void _collect_tile_layers(std::vector<ir::Layer>& layers,
+                          std::vector<std::pair<LayerID, ir::Layer*>>& tile_layers)
+{
+  for (auto& layer : layers) {
+    if (layer.type == LayerType::kTileLayer) {
+      tile_layers.emplace_back(layer.id, &layer);
+    }
+
+    _collect_tile_layers(layer.layers, tile_layers);
+  }
+}
+
+}  // namespace
+
+auto parse_tile_filter(const std::string_view name) -> std::optional<TileFilter>
+{
+  if (name == "none") {
+    return TileFilter::kNone;
+  }
+
+  if (name == "shuffle") {
+    return TileFilter::kShuffle;
+  }
+
+  if (name == "delta_shuffle") {
+    return TileFilter::kDeltaShuffle;
+  }
+
+  return std::nullopt;
+}
+
+auto get_layer_tile_filter(const ir::Layer& layer, const TileFilter default_filter)
+    -> TileFilter
+{
+  for (const auto& [name, value] : layer.meta.properties) {
+    if (name == kTileFilterProperty && value.get_type() == AttributeType::kStr) {
+      return parse_tile_filter(value.as_string()).value_or(default_filter);
+    }
+  }
+
+  return default_filter;
+}
+
+auto encode_binary_map(const ir::Map& map, const BinaryMapEncodeOptions& options)
+    -> std::expected<ByteStream, ErrorCode>
+{
+  std::vector<EncodedSection> sections {};
+
+  const auto add_metadata_section = [&](const BinarySectionType type, ByteStream payload) {
+    EncodedSection section {};
+    section.entry.type = type;
+    section.raw_payload = std::move(payload);
+    sections.push_back(std::move(section));
+  };
+
+  add_metadata_section(BinarySectionType::kMap, _encode_map_section(map));
+  add_metadata_section(BinarySectionType::kTilesets, _encode_tilesets_section(map));
+  add_metadata_section(BinarySectionType::kLayers, _encode_layers_section(map));
+
+  _encode_tile_chunks(map.layers, options.tile_filter, sections);
+
+  const auto compress_result =
+      _parallel_for(sections.size(), options.thread_count, [&](const std::size_t index) {
+        return _compress_section(sections[index], options);
+      });
+
+  if (!compress_result.has_value()) {
+    return std::unexpected {compress_result.error()};
+  }
+
+  auto offset = kBinaryMapHeaderSize + sections.size() * kBinarySectionEntrySize;
+  for (auto& section : sections) {
+    section.entry.offset = offset;
+    offset += section.stored_payload.size();
+  }
+
+  ByteWriter writer {};
+
+  for (const auto byte : kBinaryMapMagic) {
+    writer.write(byte);
+  }
+
+  writer.write(kBinaryMapVersion);
+  writer.write_count(sections.size());
+
+  for (const auto& section : sections) {
+    _write_section_entry(writer, section.entry);
+  }
+
+  auto bytes = writer.take_bytes();
+  bytes.reserve(offset);
+
+  for (const auto& section : sections) {
+    bytes.insert(bytes.end(), section.stored_payload.begin(), section.stored_payload.end());
+  }
+
+  return bytes;
+}
+
+auto get_binary_map_toc_size(const ByteSpan bytes) -> std::expected<std::size_t, ErrorCode>
+{
+  if (bytes.size() < kBinaryMapHeaderSize ||
+      !std::equal(kBinaryMapMagic.begin(), kBinaryMapMagic.end(), bytes.begin())) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  ByteReader reader {bytes.subspan(kBinaryMapMagic.size())};
+
+  // Older versions only differ in reserved bytes that used to be zeroed.
+  const auto version = reader.read<std::uint32_t>();
+  if (version < 1 || version > kBinaryMapVersion) {
+    return std::unexpected {ErrorCode::kNotSupported};
+  }
+
+  const auto section_count = static_cast<std::size_t>(reader.read<std::uint32_t>());
+  return kBinaryMapHeaderSize + section_count * kBinarySectionEntrySize;
+}
+
+auto parse_binary_map_toc(const ByteSpan bytes)
+    -> std::expected<std::vector<BinarySectionEntry>, ErrorCode>
+{
+  const auto toc_size = get_binary_map_toc_size(bytes);
+  if (!toc_size.has_value()) {
+    return std::unexpected {toc_size.error()};
+  }
+
+  if (bytes.size() < *toc_size) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  const auto section_count = (*toc_size - kBinaryMapHeaderSize) / kBinarySectionEntrySize;
+
+  std::vector<BinarySectionEntry> toc {};
+  toc.reserve(section_count);
+
+  ByteReader reader {bytes.subspan(kBinaryMapHeaderSize, *toc_size - kBinaryMapHeaderSize)};
+  for (std::size_t index = 0; index < section_count; ++index) {
+    toc.push_back(_read_section_entry(reader));
+  }
+
+  if (!reader.is_done()) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  return toc;
+}
+
+auto decode_binary_section(const BinarySectionEntry& entry, const ByteSpan payload)
+    -> std::expected<ByteStream, ErrorCode>
+{
+  if (payload.size() != entry.stored_size || fnv1a_hash(payload) != entry.checksum) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  return _decode_section_payload(entry, payload)
+      .and_then([&](ByteStream raw_payload) -> std::expected<ByteStream, ErrorCode> {
+        if (entry.filter == TileFilter::kNone) {
+          return raw_payload;
+        }
+
+        auto unfiltered_payload = revert_tile_filter(raw_payload, entry.filter);
+        if (!unfiltered_payload.has_value()) {
+          return std::unexpected {ErrorCode::kParseError};
+        }
+
+        return std::move(*unfiltered_payload);
+      });
+}
+
+auto decode_binary_map_metadata(const ByteSpan bytes,
+                                const std::vector<BinarySectionEntry>& toc)
+    -> std::expected<ir::Map, ErrorCode>
+{
+  ir::Map map {};
+
+  return _decode_metadata_section(bytes,
+                                  toc,
+                                  BinarySectionType::kMap,
+                                  map,
+                                  &_decode_map_section)
+      .and_then([&] {
+        return _decode_metadata_section(bytes,
+                                        toc,
+                                        BinarySectionType::kTilesets,
+                                        map,
+                                        &_decode_tilesets_section);
+      })
+      .and_then([&] {
+        return _decode_metadata_section(bytes,
+                                        toc,
+                                        BinarySectionType::kLayers,
+                                        map,
+                                        &_decode_layers_section);
+      })
+      .transform([&] { return std::move(map); });
+}
+
+auto decode_binary_tile_chunk(const BinarySectionEntry& entry,
+                              const ByteSpan payload,
+                              TileMatrix& tiles) -> std::expected<void, ErrorCode>
+{
+  const auto row_count = tiles.size();
+  const auto col_count = tiles.empty() ? 0 : tiles.front().size();
+
+  const auto first_row = static_cast<std::size_t>(entry.chunk_row) * kTileChunkSize;
+  const auto first_col = static_cast<std::size_t>(entry.chunk_col) * kTileChunkSize;
+
+  if (entry.type != BinarySectionType::kTileChunk || first_row >= row_count ||
+      first_col >= col_count) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  const auto last_row = std::min(first_row + kTileChunkSize, row_count);
+  const auto last_col = std::min(first_col + kTileChunkSize, col_count);
+  const auto chunk_cols = last_col - first_col;
+
+  return decode_binary_section(entry, payload)
+      .and_then([&](const ByteStream& raw_payload) -> std::expected<void, ErrorCode> {
+        if (raw_payload.size() != (last_row - first_row) * chunk_cols * sizeof(TileID)) {
+          return std::unexpected {ErrorCode::kParseError};
+        }
+
+        const auto* source = raw_payload.data();
+        const auto row_size = chunk_cols * sizeof(TileID);
+
+        for (auto row = first_row; row < last_row; ++row) {
+          auto* target = tiles[row].data() + first_col;
+          std::memcpy(target, source, row_size);
+          source += row_size;
+
+          if constexpr (std::endian::native == std::endian::big) {
+            for (std::size_t col = 0; col < chunk_cols; ++col) {
+              target[col] = std::byteswap(target[col]);
+            }
+          }
+        }
+
+        return {};
+      });
+}
+
+auto decode_binary_map(const ByteSpan bytes, const std::size_t thread_count)
+    -> std::expected<ir::Map, ErrorCode>
+{
+  const auto toc = parse_binary_map_toc(bytes);
+  if (!toc.has_value()) {
+    return std::unexpected {toc.error()};
+  }
+
+  auto map = decode_binary_map_metadata(bytes, *toc);
+  if (!map.has_value()) {
+    return std::unexpected {map.error()};
+  }
+
+  std::vector<std::pair<LayerID, ir::Layer*>> tile_layers {};
+  _collect_tile_layers(map->layers, tile_layers);
+  std::ranges::sort(tile_layers);
+
+  struct ChunkJob final
+  {
+    const BinarySectionEntry* entry;
+    ir::Layer* layer;
+  };
+
+  std::vector<ChunkJob> chunk_jobs {};
+  for (const auto& entry : *toc) {
+    if (entry.type != BinarySectionType::kTileChunk) {
+      continue;
+    }
+
+    const auto layer_iter = std::ranges::lower_bound(tile_layers,
+                                                     entry.layer_id,
+                                                     {},
+                                                     &std::pair<LayerID, ir::Layer*>::first);
+    if (layer_iter == tile_layers.end() || layer_iter->first != entry.layer_id) {
+      return std::unexpected {ErrorCode::kParseError};
+    }
+
+    chunk_jobs.push_back(ChunkJob {.entry = &entry, .layer = layer_iter->second});
+  }
+
+  // Duplicate chunks would otherwise lead to concurrent writes to the same tiles.
+  const auto chunk_key = [](const ChunkJob& job) {
+    return std::tie(job.entry->layer_id, job.entry->chunk_row, job.entry->chunk_col);
+  };
+
+  std::ranges::sort(chunk_jobs, {}, chunk_key);
+  const auto duplicate_iter =
+      std::ranges::adjacent_find(chunk_jobs, {}, [&](const ChunkJob& job) {
+        return chunk_key(job);
+      });
+
+  if (duplicate_iter != chunk_jobs.end()) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  const auto decode_result =
+      _parallel_for(chunk_jobs.size(), thread_count, [&](const std::size_t index) {
+        const auto& [entry, layer] = chunk_jobs[index];
+        return _get_section_payload(bytes, *entry).and_then([&](const ByteSpan payload) {
+          return decode_binary_tile_chunk(*entry, payload, layer->tiles);
+        });
+      });
+
+  if (!decode_result.has_value()) {
+    return std::unexpected {decode_result.error()};
+  }
+
+  return map;
+}
+
+}  // namespace tactile::binary_format
@@ -0,0 +1,178 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/binary/binary_save_format.hpp"
+
+#include <algorithm>  // max
+#include <exception>  // exception
+#include <fstream>    // ofstream
+#include <ios>        // ios, streamsize
+#include <thread>     // thread
+#include <vector>     // vector
+
+#include "tactile/base/document/map_view.hpp"
+#include "tactile/base/io/file_io.hpp"
+#include "tactile/base/io/tile_filter.hpp"
+#include "tactile/base/meta/attribute_type.hpp"
+#include "tactile/binary/binary_format_save_visitor.hpp"
+#include "tactile/binary/binary_map_codec.hpp"
+#include "tactile/binary/logging.hpp"
+
+namespace tactile::binary_format {
+namespace {
+
+// Matches the default Zstd compression level, which is a good trade-off between
+// speed and compression ratio.
+inline constexpr int kDefaultCompressionLevel = 3;
+
+[[nodiscard]]
+auto _get_thread_count() -> std::size_t
+{
+  return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+[[nodiscard]]
+auto _get_compression_level(const ir::TileFormat& tile_format,
+                            const SaveFormatWriteOptions& options) -> int
+{
+  if (options.compression_level.has_value()) {
+    return *options.compression_level;
+  }
+
+  if (tile_format.compression == CompressionFormatId::kZstd) {
+    return tile_format.compression_level.value_or(kDefaultCompressionLevel);
+  }
+
+  return kDefaultCompressionLevel;
+}
+
+// Shuffling is cheap and never noticeably worse than no filter, so it's used unless the
+// "tile_filter" setting says otherwise. Delta coding mostly helps layers with long
+// sequences of consecutive tile identifiers, so it's opt-in. Individual tile layers may
+// select their own filters, see kTileFilterProperty.
+[[nodiscard]]
+auto _deduce_tile_filter(const SaveFormatExtraSettings& settings) -> TileFilter
+{
+  const auto iter = settings.find("tile_filter");
+  if (iter == settings.end() || iter->second.get_type() != AttributeType::kStr) {
+    return TileFilter::kShuffle;
+  }
+
+  const auto& filter_name = iter->second.as_string();
+
+  if (const auto filter = parse_tile_filter(filter_name)) {
+    return *filter;
+  }
+
+  TACTILE_BINARY_FORMAT_ERROR("Ignoring unknown tile filter '{}'", filter_name);
+  return TileFilter::kShuffle;
+}
+
+void _validate_layer_tile_filters(const std::vector<ir::Layer>& layers)
+{
+  for (const auto& layer : layers) {
+    for (const auto& [name, value] : layer.meta.properties) {
+      if (name != kTileFilterProperty) {
+        continue;
+      }
+
+      if (value.get_type() != AttributeType::kStr ||
+          !parse_tile_filter(value.as_string()).has_value()) {
+        TACTILE_BINARY_FORMAT_ERROR("Ignoring invalid tile filter of layer {}", layer.id);
+      }
+    }
+
+    _validate_layer_tile_filters(layer.layers);
+  }
+}
+
+}  // namespace
+
+auto BinarySaveFormat::load_map(const std::filesystem::path& map_path,
+                                const SaveFormatReadOptions& options) const
+    -> std::expected<ir::Map, ErrorCode>
+{
+  try {
+    const auto map_bytes = read_binary_file(map_path);
+    if (!map_bytes.has_value()) {
+      TACTILE_BINARY_FORMAT_ERROR("Could not read binary map file {}", map_path.string());
+      return std::unexpected {ErrorCode::kBadFileStream};
+    }
+
+    auto map = decode_binary_map(make_byte_span(*map_bytes), _get_thread_count());
+    if (!map.has_value()) {
+      TACTILE_BINARY_FORMAT_ERROR("Could not decode binary map: {}", to_string(map.error()));
+      return std::unexpected {map.error()};
+    }
+
+    for (auto& [tileset, first_tile_id] : map->tilesets) {
+      tileset.image_path = options.base_dir / tileset.image_path;
+    }
+
+    return map;
+  }
+  catch (const std::exception& error) {
+    TACTILE_BINARY_FORMAT_ERROR("An unexpected error occurred during binary map parsing: {}",
+                                error.what());
+    return std::unexpected {ErrorCode::kParseError};
+  }
+  catch (...) {
+    TACTILE_BINARY_FORMAT_ERROR("An unknown error occurred during binary map parsing");
+    return std::unexpected {ErrorCode::kUnknown};
+  }
+}
+
+auto BinarySaveFormat::save_map(const IMapView& map,
+                                const SaveFormatWriteOptions& options) const
+    -> std::expected<void, ErrorCode>
+{
+  try {
+    const auto* map_path = map.get_path();
+
+    if (!map_path) {
+      TACTILE_BINARY_FORMAT_ERROR("Map has no associated file path");
+      return std::unexpected {ErrorCode::kBadState};
+    }
+
+    TACTILE_BINARY_FORMAT_DEBUG("Saving binary map to {}", map_path->string());
+
+    BinaryFormatSaveVisitor visitor {options};
+
+    return map.accept(visitor)
+        .and_then([&] {
+          const auto& ir_map = visitor.get_map();
+          _validate_layer_tile_filters(ir_map.layers);
+
+          const BinaryMapEncodeOptions encode_options {
+            .use_compression = true,
+            .compression_level = _get_compression_level(ir_map.tile_format, options),
+            .thread_count = _get_thread_count(),
+            .tile_filter = _deduce_tile_filter(options.extra),
+          };
+
+          return encode_binary_map(ir_map, encode_options);
+        })
+        .and_then([&](const ByteStream& map_bytes) -> std::expected<void, ErrorCode> {
+          std::ofstream stream {*map_path, std::ios::out | std::ios::binary | std::ios::trunc};
+          stream.write(reinterpret_cast<const char*>(map_bytes.data()),
+                       static_cast<std::streamsize>(map_bytes.size()));
+
+          if (!stream.good()) {
+            TACTILE_BINARY_FORMAT_ERROR("Could not write binary map file");
+            return std::unexpected {ErrorCode::kWriteError};
+          }
+
+          return {};
+        });
+  }
+  catch (const std::exception& error) {
+    TACTILE_BINARY_FORMAT_ERROR("An error occurred during binary map emission: {}",
+                                error.what());
+    return std::unexpected {ErrorCode::kWriteError};
+  }
+  catch (...) {
+    TACTILE_BINARY_FORMAT_ERROR("An unknown error occurred during binary map emission");
+    return std::unexpected {ErrorCode::kUnknown};
+  }
+}
+
+}  // namespace tactile::binary_format
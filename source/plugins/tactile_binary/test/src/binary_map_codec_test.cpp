@@ -0,0 +1,339 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/binary/binary_map_codec.hpp"
+
+#include <algorithm>  // count
+#include <cstddef>    // size_t
+#include <optional>   // nullopt
+#include <string>     // string
+#include <utility>    // move
+#include <vector>     // vector
+
+#include <gtest/gtest.h>
+
+#include "tactile/test_util/ir.hpp"
+#include "tactile/test_util/ir_eq.hpp"
+#include "tactile/test_util/ir_presets.hpp"
+
+namespace tactile::binary_format {
+namespace {
+
+inline constexpr BinaryMapEncodeOptions kCompressedOptions {
+  .use_compression = true,
+  .compression_level = 3,
+  .thread_count = 4,
+  .tile_filter = TileFilter::kDeltaShuffle,
+};
+
+inline constexpr BinaryMapEncodeOptions kCompressedUnfilteredOptions {
+  .use_compression = true,
+  .compression_level = 3,
+  .thread_count = 4,
+  .tile_filter = TileFilter::kNone,
+};
+
+inline constexpr BinaryMapEncodeOptions kUncompressedOptions {
+  .use_compression = false,
+  .compression_level = 0,
+  .thread_count = 1,
+  .tile_filter = TileFilter::kDeltaShuffle,
+};
+
+// Spans several chunks in both dimensions, with partial chunks at the edges.
+[[nodiscard]]
+auto _make_large_map() -> ir::Map
+{
+  const Extent2D extent {.rows = 150, .cols = 70};
+
+  auto map = test::make_ir_map(extent);
+  map.layers.push_back(test::make_ir_tile_layer(1, extent));
+  map.layers.push_back(test::make_ir_group_layer(2, {test::make_ir_tile_layer(3, extent)}));
+  map.next_layer_id = 4;
+
+  auto& tiles = map.layers.at(0).tiles;
+  for (std::size_t row = 0; row < extent.rows; ++row) {
+    for (std::size_t col = 0; col < extent.cols; ++col) {
+      tiles[row][col] = static_cast<TileID>((row * extent.cols + col) % 97);
+    }
+  }
+
+  // Only the last chunk of the nested layer contains tiles.
+  map.layers.at(1).layers.at(0).tiles[149][69] = 42;
+
+  return map;
+}
+
+[[nodiscard]]
+auto _count_chunks(const std::vector<BinarySectionEntry>& toc) -> std::ptrdiff_t
+{
+  return std::ranges::count(toc, BinarySectionType::kTileChunk, &BinarySectionEntry::type);
+}
+
+// tactile::binary_format::encode_binary_map
+// tactile::binary_format::decode_binary_map
+TEST(BinaryMapCodec, RoundtripComplexMap)
+{
+  const auto map = test::make_complex_ir_map(test::make_ir_tile_format());
+
+  for (const auto& options :
+       {kCompressedOptions, kCompressedUnfilteredOptions, kUncompressedOptions}) {
+    const auto bytes = encode_binary_map(map, options);
+    ASSERT_TRUE(bytes.has_value());
+
+    const auto decoded_map = decode_binary_map(*bytes, 2);
+    ASSERT_TRUE(decoded_map.has_value());
+
+    test::expect_eq(map, *decoded_map);
+  }
+}
+
+// tactile::binary_format::encode_binary_map
+// tactile::binary_format::decode_binary_map
+TEST(BinaryMapCodec, RoundtripLargeMap)
+{
+  const auto map = _make_large_map();
+
+  const auto bytes = encode_binary_map(map, kCompressedOptions);
+  ASSERT_TRUE(bytes.has_value());
+
+  const auto decoded_map = decode_binary_map(*bytes, 4);
+  ASSERT_TRUE(decoded_map.has_value());
+
+  EXPECT_EQ(map, *decoded_map);
+}
+
+// tactile::binary_format::encode_binary_map
+// tactile::binary_format::parse_binary_map_toc
+TEST(BinaryMapCodec, TileFiltersAreRecordedPerChunk)
+{
+  const auto map = _make_large_map();
+
+  for (const auto& options : {kCompressedOptions, kUncompressedOptions}) {
+    const auto bytes = encode_binary_map(map, options);
+    ASSERT_TRUE(bytes.has_value());
+
+    const auto toc = parse_binary_map_toc(*bytes);
+    ASSERT_TRUE(toc.has_value());
+
+    for (const auto& entry : *toc) {
+      const auto is_filtered = entry.type == BinarySectionType::kTileChunk &&
+                               entry.codec == BinarySectionCodec::kZstd;
+      EXPECT_EQ(entry.filter, is_filtered ? options.tile_filter : TileFilter::kNone);
+    }
+
+    const auto decoded_map = decode_binary_map(*bytes, 4);
+    ASSERT_TRUE(decoded_map.has_value());
+    EXPECT_EQ(map, *decoded_map);
+  }
+}
+
+// tactile::binary_format::encode_binary_map
+// tactile::binary_format::parse_binary_map_toc
+TEST(BinaryMapCodec, TileFiltersCanBeSelectedPerLayer)
+{
+  auto map = _make_large_map();
+  map.layers.at(0).meta.properties.push_back(ir::NamedAttribute {
+    .name = std::string {kTileFilterProperty},
+    .value = Attribute {"none"},
+  });
+
+  const auto bytes = encode_binary_map(map, kCompressedOptions);
+  ASSERT_TRUE(bytes.has_value());
+
+  const auto toc = parse_binary_map_toc(*bytes);
+  ASSERT_TRUE(toc.has_value());
+
+  for (const auto& entry : *toc) {
+    if (entry.type == BinarySectionType::kTileChunk &&
+        entry.codec == BinarySectionCodec::kZstd) {
+      EXPECT_EQ(entry.filter,
+                entry.layer_id == 1 ? TileFilter::kNone : kCompressedOptions.tile_filter);
+    }
+  }
+
+  const auto decoded_map = decode_binary_map(*bytes, 4);
+  ASSERT_TRUE(decoded_map.has_value());
+  EXPECT_EQ(map, *decoded_map);
+}
+
+// tactile::binary_format::parse_tile_filter
+TEST(BinaryMapCodec, ParseTileFilter)
+{
+  EXPECT_EQ(parse_tile_filter("none"), TileFilter::kNone);
+  EXPECT_EQ(parse_tile_filter("shuffle"), TileFilter::kShuffle);
+  EXPECT_EQ(parse_tile_filter("delta_shuffle"), TileFilter::kDeltaShuffle);
+  EXPECT_EQ(parse_tile_filter("delta"), std::nullopt);
+  EXPECT_EQ(parse_tile_filter(""), std::nullopt);
+}
+
+// tactile::binary_format::get_layer_tile_filter
+TEST(BinaryMapCodec, GetLayerTileFilter)
+{
+  auto layer = test::make_ir_tile_layer(1, Extent2D {.rows = 1, .cols = 1});
+  EXPECT_EQ(get_layer_tile_filter(layer, TileFilter::kShuffle), TileFilter::kShuffle);
+
+  layer.meta.properties.push_back(ir::NamedAttribute {
+    .name = std::string {kTileFilterProperty},
+    .value = Attribute {"foo"},
+  });
+  EXPECT_EQ(get_layer_tile_filter(layer, TileFilter::kShuffle), TileFilter::kShuffle);
+
+  layer.meta.properties.back().value = Attribute {"delta_shuffle"};
+  EXPECT_EQ(get_layer_tile_filter(layer, TileFilter::kShuffle), TileFilter::kDeltaShuffle);
+}
+
+// tactile::binary_format::encode_binary_map
+// tactile::binary_format::parse_binary_map_toc
+TEST(BinaryMapCodec, EmptyChunksAreOmitted)
+{
+  const auto bytes = encode_binary_map(_make_large_map(), kCompressedOptions);
+  ASSERT_TRUE(bytes.has_value());
+
+  const auto toc = parse_binary_map_toc(*bytes);
+  ASSERT_TRUE(toc.has_value());
+
+  // 3x2 chunks in the first layer, and a single chunk in the nested layer.
+  EXPECT_EQ(toc->size(), 3 + 6 + 1);
+  EXPECT_EQ(_count_chunks(*toc), 6 + 1);
+}
+
+// tactile::binary_format::get_binary_map_toc_size
+// tactile::binary_format::parse_binary_map_toc
+// tactile::binary_format::decode_binary_map_metadata
+// tactile::binary_format::decode_binary_tile_chunk
+TEST(BinaryMapCodec, PartialDecode)
+{
+  const auto map = _make_large_map();
+
+  const auto bytes = encode_binary_map(map, kCompressedOptions);
+  ASSERT_TRUE(bytes.has_value());
+
+  const auto toc_size = get_binary_map_toc_size(ByteSpan {*bytes}.first(kBinaryMapHeaderSize));
+  ASSERT_TRUE(toc_size.has_value());
+
+  const auto toc = parse_binary_map_toc(ByteSpan {*bytes}.first(*toc_size));
+  ASSERT_TRUE(toc.has_value());
+
+  auto decoded_map = decode_binary_map_metadata(*bytes, *toc);
+  ASSERT_TRUE(decoded_map.has_value());
+
+  auto& nested_layer = decoded_map->layers.at(1).layers.at(0);
+  EXPECT_EQ(nested_layer.tiles, test::make_ir_tile_matrix(nested_layer.extent));
+
+  for (const auto& entry : *toc) {
+    if (entry.type == BinarySectionType::kTileChunk && entry.layer_id == nested_layer.id) {
+      const auto payload = ByteSpan {*bytes}.subspan(entry.offset, entry.stored_size);
+      ASSERT_TRUE(decode_binary_tile_chunk(entry, payload, nested_layer.tiles).has_value());
+    }
+  }
+
+  EXPECT_EQ(nested_layer.tiles, map.layers.at(1).layers.at(0).tiles);
+}
+
+// tactile::binary_format::decode_binary_map
+TEST(BinaryMapCodec, DecodeInvalidHeader)
+{
+  auto bytes = encode_binary_map(_make_large_map(), kCompressedOptions);
+  ASSERT_TRUE(bytes.has_value());
+
+  auto bad_magic = *bytes;
+  bad_magic.front() = 'X';
+
+  auto bad_version = *bytes;
+  bad_version.at(kBinaryMapMagic.size()) = 0xFF;
+
+  auto truncated_toc = *bytes;
+  truncated_toc.resize(kBinaryMapHeaderSize + 1);
+
+  EXPECT_EQ(decode_binary_map(bad_magic, 1), std::unexpected {ErrorCode::kParseError});
+  EXPECT_EQ(decode_binary_map(bad_version, 1), std::unexpected {ErrorCode::kNotSupported});
+  EXPECT_EQ(decode_binary_map(truncated_toc, 1), std::unexpected {ErrorCode::kParseError});
+  EXPECT_EQ(decode_binary_map(ByteStream {}, 1), std::unexpected {ErrorCode::kParseError});
+}
+
+// tactile::binary_format::decode_binary_map
+TEST(BinaryMapCodec, DecodeDeeplyNestedLayers)
+{
+  // Creates a chain of nested group layers.
+  const auto make_nested_map = [](const std::size_t depth) {
+    auto map = test::make_ir_map(Extent2D {4, 4});
+
+    auto layer = test::make_ir_group_layer(1);
+    for (std::size_t index = 1; index < depth; ++index) {
+      std::vector<ir::Layer> nested_layers {};
+      nested_layers.push_back(std::move(layer));
+      layer = test::make_ir_group_layer(static_cast<LayerID>(index + 1),
+                                        std::move(nested_layers));
+    }
+
+    map.layers.push_back(std::move(layer));
+    map.next_layer_id = static_cast<LayerID>(depth + 1);
+
+    return map;
+  };
+
+  const auto valid_bytes =
+      encode_binary_map(make_nested_map(kMaxLayerDepth), kCompressedOptions);
+  ASSERT_TRUE(valid_bytes.has_value());
+  EXPECT_TRUE(decode_binary_map(*valid_bytes, 1).has_value());
+
+  const auto invalid_bytes =
+      encode_binary_map(make_nested_map(kMaxLayerDepth + 1), kCompressedOptions);
+  ASSERT_TRUE(invalid_bytes.has_value());
+  EXPECT_EQ(decode_binary_map(*invalid_bytes, 1), std::unexpected {ErrorCode::kParseError});
+}
+
+// tactile::binary_format::decode_binary_map
+TEST(BinaryMapCodec, DecodeDuplicateLayerIds)
+{
+  const Extent2D extent {.rows = 4, .cols = 4};
+
+  auto map = test::make_ir_map(extent);
+  map.layers.push_back(test::make_ir_tile_layer(1, extent));
+  map.layers.push_back(test::make_ir_group_layer(2, {test::make_ir_tile_layer(1, extent)}));
+  map.layers.front().tiles[0][0] = 7;
+  map.next_layer_id = 3;
+
+  const auto bytes = encode_binary_map(map, kCompressedOptions);
+  ASSERT_TRUE(bytes.has_value());
+
+  const auto toc = parse_binary_map_toc(*bytes);
+  ASSERT_TRUE(toc.has_value());
+
+  EXPECT_EQ(decode_binary_map_metadata(*bytes, *toc),
+            std::unexpected {ErrorCode::kParseError});
+  EXPECT_EQ(decode_binary_map(*bytes, 1), std::unexpected {ErrorCode::kParseError});
+}
+
+// tactile::binary_format::decode_binary_map
+TEST(BinaryMapCodec, DecodeTileLayerWithInvalidExtent)
+{
+  const Extent2D map_extent {.rows = 4, .cols = 4};
+  const Extent2D layer_extent {.rows = 200, .cols = 4};
+
+  auto map = test::make_ir_map(map_extent);
+  map.layers.push_back(test::make_ir_tile_layer(1, layer_extent));
+  map.layers.front().tiles[199][3] = 7;
+  map.next_layer_id = 2;
+
+  const auto bytes = encode_binary_map(map, kCompressedOptions);
+  ASSERT_TRUE(bytes.has_value());
+
+  EXPECT_EQ(decode_binary_map(*bytes, 1), std::unexpected {ErrorCode::kParseError});
+}
+
+// tactile::binary_format::decode_binary_map
+TEST(BinaryMapCodec, DecodeCorruptSection)
+{
+  auto bytes = encode_binary_map(_make_large_map(), kCompressedOptions);
+  ASSERT_TRUE(bytes.has_value());
+
+  bytes->back() ^= 0xFF;
+  EXPECT_EQ(decode_binary_map(*bytes, 4), std::unexpected {ErrorCode::kParseError});
+
+  bytes->pop_back();
+  EXPECT_EQ(decode_binary_map(*bytes, 4), std::unexpected {ErrorCode::kParseError});
+}
+
+}  // namespace
+}  // namespace tactile::binary_format
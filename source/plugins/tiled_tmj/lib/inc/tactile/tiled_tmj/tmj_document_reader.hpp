@@ -0,0 +1,69 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <expected>       // expected
+#include <filesystem>     // path
+#include <istream>        // istream
+#include <unordered_map>  // unordered_map
+#include <vector>         // vector
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/id.hpp"
+#include "tactile/tiled_tmj/api.hpp"
+#include "tactile/tiled_tmj/tmj_common.hpp"
+
+namespace tactile::tiled_tmj {
+
+/** Plain text tile layer data, stored in row-major order and keyed by layer ID. */
+using TmjTileData = std::unordered_map<LayerID, std::vector<TileID>>;
+
+/**
+ * Represents a parsed TMJ map document.
+ *
+ * \details
+ * The plain text tile data arrays are stored separately from the JSON document,
+ * i.e., the "data" attributes of the associated tile layers are omitted.
+ */
+struct TmjDocument final
+{
+  /** The JSON document, excluding plain text tile data. */
+  JSON json;
+
+  /** The extracted plain text tile data. */
+  TmjTileData tile_data;
+};
+
+/**
+ * Parses a TMJ map document from a stream.
+ *
+ * \details
+ * The document is parsed in a single pass, and the plain text tile data of tile
+ * layers is written directly to compact buffers instead of JSON arrays. This
+ * substantially reduces the peak memory usage when reading large maps, since
+ * tile data usually dominates the size of TMJ files.
+ *
+ * \param stream The input stream.
+ *
+ * \return
+ * The parsed document if successful; an error code otherwise.
+ */
+[[nodiscard]]
+TACTILE_TILED_TMJ_API auto read_tmj_document(std::istream& stream)
+    -> std::expected<TmjDocument, ErrorCode>;
+
+/**
+ * Parses a TMJ map document from a file.
+ *
+ * \param path The path to the TMJ file.
+ *
+ * \return
+ * The parsed document if successful; an error code otherwise.
+ *
+ * \see read_tmj_document(std::istream&)
+ */
+[[nodiscard]]
+TACTILE_TILED_TMJ_API auto read_tmj_document(const std::filesystem::path& path)
+    -> std::expected<TmjDocument, ErrorCode>;
+
+}  // namespace tactile::tiled_tmj
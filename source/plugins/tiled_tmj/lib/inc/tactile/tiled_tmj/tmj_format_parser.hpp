@@ -10,6 +10,7 @@
 #include "tactile/base/runtime/runtime.hpp"
 #include "tactile/tiled_tmj/api.hpp"
 #include "tactile/tiled_tmj/tmj_common.hpp"
+#include "tactile/tiled_tmj/tmj_document_reader.hpp"
 
 namespace tactile::tiled_tmj {
 
@@ -19,4 +20,20 @@ TACTILE_TILED_TMJ_API auto parse_tmj_map(const IRuntime& runtime,
                                          const SaveFormatReadOptions& options)
     -> std::expected<ir::Map, ErrorCode>;
 
+/**
+ * Parses a TMJ map from a document produced by \c read_tmj_document.
+ *
+ * \param runtime  The associated runtime.
+ * \param document The parsed TMJ document, which is consumed.
+ * \param options  The read options.
+ *
+ * \return
+ * The parsed map if successful; an error code otherwise.
+ */
+[[nodiscard]]
+TACTILE_TILED_TMJ_API auto parse_tmj_map(const IRuntime& runtime,
+                                         TmjDocument document,
+                                         const SaveFormatReadOptions& options)
+    -> std::expected<ir::Map, ErrorCode>;
+
 }  // namespace tactile::tiled_tmj
@@ -2,34 +2,38 @@
 
 #pragma once
 
-#include <filesystem>     // path
-#include <unordered_map>  // unordered_map
+#include <expected>  // expected
+#include <fstream>   // ofstream
+#include <optional>  // optional
+#include <ostream>   // ostream
+#include <vector>    // vector
 
 #include "tactile/base/document/document_visitor.hpp"
 #include "tactile/base/id.hpp"
 #include "tactile/base/io/byte_stream.hpp"
 #include "tactile/base/io/save/save_format.hpp"
+#include "tactile/base/io/temp_file.hpp"
 #include "tactile/base/prelude.hpp"
 #include "tactile/base/runtime/runtime.hpp"
 #include "tactile/tiled_tmj/api.hpp"
-#include "tactile/tiled_tmj/tmj_common.hpp"
+#include "tactile/tiled_tmj/tmj_json_writer.hpp"
 
 namespace tactile::tiled_tmj {
 
 /**
- * Provides information about an external TMJ tileset.
- */
-struct TmjFormatExternalTilesetData final
-{
-  /** The file path to the external tileset file. */
-  std::filesystem::path path;
-
-  /** The external tileset JSON. */
-  JSON json;
-};
-
-/**
- * A document visitor that produces Tiled TMJ format JSON objects.
+ * A document visitor that emits Tiled TMJ format JSON while visiting a map.
+ *
+ * \details
+ * The JSON is written to the output stream as the map is visited, so no
+ * document tree is ever built in memory. This relies on the documented visit
+ * order, i.e., that children are visited directly after their parents. As a
+ * consequence, the only state kept between visits is the path of currently
+ * open tileset, tile and layer nodes, which is closed as the traversal moves
+ * on to siblings. Visits in any other order are reported as errors.
+ *
+ * External tilesets are written to temporary files in the base directory,
+ * as each tileset is visited. These replace the actual tileset files once the
+ * map has been successfully emitted, and are otherwise removed.
  */
 class TACTILE_TILED_TMJ_API TmjFormatSaveVisitor final : public IDocumentVisitor
 {
@@ -37,10 +41,13 @@ class TACTILE_TILED_TMJ_API TmjFormatSaveVisitor final : public IDocumentVisitor
   /**
    * Creates a visitor.
    *
-   * \param runtime The associated runtime, cannot be null.
-   * \param options The write options to use.
+   * \param runtime    The associated runtime, cannot be null.
+   * \param options    The write options to use.
+   * \param map_stream The output stream for the map JSON, must outlive the visitor.
    */
-  TmjFormatSaveVisitor(IRuntime* runtime, SaveFormatWriteOptions options);
+  TmjFormatSaveVisitor(IRuntime* runtime,
+                       SaveFormatWriteOptions options,
+                       std::ostream& map_stream);
 
   [[nodiscard]]
   auto visit(const IMapView& map) -> std::expected<void, ErrorCode> override;
@@ -60,37 +67,53 @@ class TACTILE_TILED_TMJ_API TmjFormatSaveVisitor final : public IDocumentVisitor
   [[nodiscard]]
   auto visit(const IComponentView& component) -> std::expected<void, ErrorCode> override;
 
+  /**
+   * Closes all open JSON nodes, flushes the output and saves external tilesets.
+   *
+   * \details
+   * This function should be called once, after the map has been visited.
+   *
+   * \return
+   * Nothing if successful; an error code otherwise.
+   */
   [[nodiscard]]
-  auto get_map_json() const -> const JSON&;
-
-  [[nodiscard]]
-  auto get_external_tilesets() const
-      -> const std::unordered_map<TileID, TmjFormatExternalTilesetData>&;
+  auto finish() -> std::expected<void, ErrorCode>;
 
  private:
   IRuntime* m_runtime;
   SaveFormatWriteOptions m_options;
-  JSON m_map_node {};
-  std::unordered_map<TileID, TmjFormatExternalTilesetData> m_external_tileset_nodes {};
+  TmjJsonWriter m_map_writer;
+  std::optional<TempFile> m_tileset_file {};
+  std::optional<std::ofstream> m_tileset_stream {};
+  std::vector<TempFile> m_written_tileset_files {};
+  std::optional<TmjJsonWriter> m_tileset_writer {};
+  std::optional<TileID> m_open_tileset {};
+  std::optional<TileIndex> m_open_tile {};
+  std::vector<LayerID> m_open_layers {};
+  bool m_tileset_has_tiles {false};
+  bool m_in_layer_array {false};
   ByteStream m_tile_byte_cache {};
+  std::vector<TileID> m_tile_row_cache {};
 
   [[nodiscard]]
-  auto _get_tile_json(const ITileView& tile) -> JSON&;
+  auto _get_tileset_writer() -> TmjJsonWriter&;
+
+  void _close_open_tile();
 
   [[nodiscard]]
-  auto _get_tileset_json(const ITilesetView& tileset) -> JSON&;
+  auto _close_open_tileset() -> std::expected<void, ErrorCode>;
 
   [[nodiscard]]
-  auto _get_layer_json(const ILayerView& layer) -> JSON&;
+  auto _commit_tileset_files() -> std::expected<void, ErrorCode>;
 
   [[nodiscard]]
-  static auto _find_layer_json(JSON& root_node, LayerID id) -> JSON*;
+  auto _begin_layer_array() -> std::expected<void, ErrorCode>;
 
   [[nodiscard]]
-  auto _find_tileset_json(TileID first_tile_id) -> JSON*;
+  auto _close_open_layers(const ILayerView* parent_layer) -> std::expected<void, ErrorCode>;
 
   [[nodiscard]]
-  static auto _find_tile_json(JSON& tileset_json, TileIndex tile_index) -> JSON*;
+  auto _emit_tile_layer(const ILayerView& layer) -> std::expected<void, ErrorCode>;
 };
 
 }  // namespace tactile::tiled_tmj
@@ -0,0 +1,197 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <charconv>     // to_chars
+#include <cmath>        // isfinite
+#include <concepts>     // integral, floating_point, same_as
+#include <cstddef>      // size_t
+#include <expected>     // expected
+#include <ostream>      // ostream
+#include <span>         // span
+#include <string>       // string
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/tiled_tmj/api.hpp"
+
+namespace tactile::tiled_tmj {
+
+/**
+ * A streaming JSON writer, used to emit TMJ documents without building a DOM.
+ *
+ * \details
+ * Output is accumulated in a small buffer that is written to the underlying
+ * stream in chunks, so the memory usage of the writer doesn't depend on the
+ * size of the emitted document. Numbers are formatted with \c std::to_chars,
+ * which produces the shortest representation that round-trips.
+ *
+ * \note
+ * The writer doesn't validate the structure of the emitted document, e.g.,
+ * it's up to the caller to provide a key before each value in an object.
+ */
+class TACTILE_TILED_TMJ_API TmjJsonWriter final
+{
+ public:
+  TACTILE_DELETE_COPY(TmjJsonWriter);
+  TACTILE_DEFAULT_MOVE(TmjJsonWriter);
+
+  /** The buffer size that triggers a write to the underlying stream. */
+  static constexpr std::size_t kFlushThreshold = 65'536;
+
+  /**
+   * Creates a JSON writer.
+   *
+   * \param stream      The output stream, must outlive the writer.
+   * \param indentation The number of spaces per indentation level, zero for compact output.
+   */
+  TmjJsonWriter(std::ostream& stream, int indentation);
+
+  ~TmjJsonWriter() noexcept = default;
+
+  void begin_object();
+
+  void end_object();
+
+  void begin_array();
+
+  void end_array();
+
+  /**
+   * Emits an object key, which must be followed by a value.
+   *
+   * \param key The key, which will be escaped.
+   */
+  void key(std::string_view key);
+
+  void value(std::string_view str);
+
+  void value(const char* str);
+
+  void value(bool boolean);
+
+  template <std::integral T>
+    requires(!std::same_as<T, bool>)
+  void value(const T number)
+  {
+    _begin_value();
+    _append_number(number);
+  }
+
+  /**
+   * Emits a floating-point value, non-finite values are emitted as null.
+   *
+   * \param number The value to emit.
+   */
+  template <std::floating_point T>
+  void value(const T number)
+  {
+    _begin_value();
+    _append_number(number);
+  }
+
+  /**
+   * Emits a sequence of integral array elements.
+   *
+   * \details
+   * The elements are written on a single line, even if indentation is enabled.
+   * This is intended for tile data, which is emitted one row at a time.
+   *
+   * \param numbers The numbers to emit, must be inside of an array.
+   */
+  template <std::integral T>
+  void values(const std::span<const T> numbers)
+  {
+    for (std::size_t index = 0; index < numbers.size(); ++index) {
+      if (index == 0) {
+        _begin_value();
+      }
+      else {
+        m_buffer += ',';
+      }
+
+      _append_number(numbers[index]);
+    }
+
+    _flush_if_needed();
+  }
+
+  /**
+   * Emits a Base64 encoded string value.
+   *
+   * \details
+   * The bytes are encoded directly into the output buffer.
+   *
+   * \param bytes The bytes to encode.
+   */
+  void base64_value(ByteSpan bytes);
+
+  /**
+   * Convenience function for emitting a key-value pair.
+   *
+   * \param key   The key of the member.
+   * \param value The value of the member.
+   */
+  template <typename T>
+  void member(const std::string_view key, const T& value)
+  {
+    this->key(key);
+    this->value(value);
+  }
+
+  /**
+   * Writes all buffered output to the underlying stream.
+   *
+   * \return
+   * Nothing if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  auto flush() -> std::expected<void, ErrorCode>;
+
+ private:
+  struct Scope final
+  {
+    bool is_empty;
+  };
+
+  std::ostream* m_stream;
+  int m_indentation;
+  std::string m_buffer {};
+  std::vector<Scope> m_scopes {};
+  bool m_after_key {false};
+
+  void _begin_value();
+
+  void _append_newline();
+
+  void _append_string(std::string_view str);
+
+  template <typename T>
+  void _append_number(const T number)
+  {
+    if constexpr (std::floating_point<T>) {
+      if (!std::isfinite(number)) {
+        m_buffer += "null";
+        return;
+      }
+    }
+
+    char chars[32];  // NOLINT(*-avoid-c-arrays)
+    const auto [end, error] = std::to_chars(chars, chars + sizeof chars, number);
+    m_buffer.append(chars, end);
+
+    // Integral floating-point values keep a fractional part, to be parsed as floats.
+    if constexpr (std::floating_point<T>) {
+      if (std::string_view {chars, end}.find_first_of(".e") == std::string_view::npos) {
+        m_buffer += ".0";
+      }
+    }
+  }
+
+  void _flush_if_needed();
+};
+
+}  // namespace tactile::tiled_tmj
@@ -0,0 +1,281 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/tiled_tmj/tmj_document_reader.hpp"
+
+#include <cstddef>    // size_t
+#include <exception>  // exception
+#include <fstream>    // ifstream
+#include <ios>        // ios, streamsize
+#include <string>     // string
+#include <utility>    // move
+
+#include "tactile/base/numeric/conversion.hpp"
+#include "tactile/tiled_tmj/logging.hpp"
+
+namespace tactile::tiled_tmj {
+namespace {
+
+// Larger than the default file buffers, which noticeably speeds up reading large maps.
+inline constexpr std::size_t kStreamBufferSize = 1 << 16;
+
+/**
+ * A SAX handler that builds a JSON document, except for plain text tile data.
+ *
+ * \details
+ * Tile data arrays are collected in flat tile buffers, which only use a fraction
+ * of the memory of the equivalent JSON arrays. The buffers are associated with
+ * the ID of the enclosing layer once the layer object has been parsed, since
+ * attribute order isn't specified by the TMJ format (Tiled emits the "data"
+ * attribute before the "id" attribute).
+ */
+class TmjSaxHandler final
+{
+ public:
+  auto null() -> bool
+  {
+    return _add_value(JSON(nullptr)) != nullptr;
+  }
+
+  auto boolean(const bool value) -> bool
+  {
+    return _add_value(JSON(value)) != nullptr;
+  }
+
+  auto number_integer(const JSON::number_integer_t value) -> bool
+  {
+    if (m_is_reading_tiles) {
+      m_tile_buffer.push_back(static_cast<TileID>(value));
+      return true;
+    }
+
+    return _add_value(JSON(value)) != nullptr;
+  }
+
+  auto number_unsigned(const JSON::number_unsigned_t value) -> bool
+  {
+    if (m_is_reading_tiles) {
+      // Tiled stores flipping flags in the most significant bits of tile identifiers.
+      m_tile_buffer.push_back(static_cast<TileID>(value));
+      return true;
+    }
+
+    return _add_value(JSON(value)) != nullptr;
+  }
+
+  auto number_float(const JSON::number_float_t value, const JSON::string_t&) -> bool
+  {
+    return _add_value(JSON(value)) != nullptr;
+  }
+
+  auto string(JSON::string_t& value) -> bool
+  {
+    return _add_value(JSON(std::move(value))) != nullptr;
+  }
+
+  auto binary(JSON::binary_t& value) -> bool
+  {
+    return _add_value(JSON::binary(std::move(value))) != nullptr;
+  }
+
+  auto start_object(std::size_t) -> bool
+  {
+    auto* object = _add_value(JSON::object());
+    if (!object) {
+      return false;
+    }
+
+    m_stack.push_back(object);
+    return true;
+  }
+
+  auto key(JSON::string_t& key) -> bool
+  {
+    m_key = std::move(key);
+    return true;
+  }
+
+  auto end_object() -> bool
+  {
+    if (!m_pending_tiles.empty() && m_pending_tiles.back().depth == m_stack.size()) {
+      if (!_store_pending_tiles(*m_stack.back())) {
+        return false;
+      }
+    }
+
+    m_stack.pop_back();
+    return true;
+  }
+
+  auto start_array(std::size_t) -> bool
+  {
+    if (!m_stack.empty() && m_stack.back()->is_object() && m_key == "data") {
+      return _start_reading_tiles();
+    }
+
+    auto* array = _add_value(JSON::array());
+    if (!array) {
+      return false;
+    }
+
+    m_stack.push_back(array);
+    return true;
+  }
+
+  auto end_array() -> bool
+  {
+    if (m_is_reading_tiles) {
+      m_is_reading_tiles = false;
+      m_tile_count_hint = m_tile_buffer.size();
+      m_pending_tiles.push_back(PendingTiles {
+        .depth = m_stack.size(),
+        .tiles = std::move(m_tile_buffer),
+      });
+      m_tile_buffer = std::vector<TileID> {};
+      return true;
+    }
+
+    m_stack.pop_back();
+    return true;
+  }
+
+  auto parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& error)
+      -> bool
+  {
+    TACTILE_TILED_TMJ_ERROR("JSON parse error: {}", error.what());
+    return false;
+  }
+
+  [[nodiscard]]
+  auto take_document() -> TmjDocument
+  {
+    return TmjDocument {
+      .json = std::move(m_root),
+      .tile_data = std::move(m_tile_data),
+    };
+  }
+
+ private:
+  struct PendingTiles final
+  {
+    std::size_t depth;
+    std::vector<TileID> tiles;
+  };
+
+  JSON m_root {};
+  std::vector<JSON*> m_stack {};
+  JSON::string_t m_key {};
+  TmjTileData m_tile_data {};
+  std::vector<PendingTiles> m_pending_tiles {};
+  std::vector<TileID> m_tile_buffer {};
+  std::size_t m_tile_count_hint {0};
+  bool m_is_reading_tiles {false};
+
+  [[nodiscard]]
+  auto _add_value(JSON value) -> JSON*
+  {
+    if (m_is_reading_tiles) {
+      TACTILE_TILED_TMJ_ERROR("Unexpected {} value in tile data", value.type_name());
+      return nullptr;
+    }
+
+    if (m_stack.empty()) {
+      m_root = std::move(value);
+      return &m_root;
+    }
+
+    auto& parent = *m_stack.back();
+
+    if (parent.is_array()) {
+      auto& array = parent.get_ref<JSON::array_t&>();
+      array.push_back(std::move(value));
+      return &array.back();
+    }
+
+    auto& element = parent[std::move(m_key)];
+    element = std::move(value);
+    return &element;
+  }
+
+  [[nodiscard]]
+  auto _start_reading_tiles() -> bool
+  {
+    if (m_is_reading_tiles) {
+      TACTILE_TILED_TMJ_ERROR("Unexpected nested array in tile data");
+      return false;
+    }
+
+    if (!m_pending_tiles.empty() && m_pending_tiles.back().depth == m_stack.size()) {
+      TACTILE_TILED_TMJ_ERROR("Duplicate tile data in layer");
+      return false;
+    }
+
+    // Layers in the same map usually have the same size.
+    m_is_reading_tiles = true;
+    m_tile_buffer.reserve(m_tile_count_hint);
+
+    return true;
+  }
+
+  [[nodiscard]]
+  auto _store_pending_tiles(const JSON& layer_json) -> bool
+  {
+    const auto id_iter = layer_json.find("id");
+    if (id_iter == layer_json.end() || !id_iter->is_number_integer()) {
+      TACTILE_TILED_TMJ_ERROR("Tile data in object without valid layer ID");
+      return false;
+    }
+
+    const auto layer_id = narrow<LayerID>(id_iter->get<JSON::number_integer_t>());
+
+    auto& pending_tiles = m_pending_tiles.back();
+    if (!m_tile_data.try_emplace(layer_id, std::move(pending_tiles.tiles)).second) {
+      TACTILE_TILED_TMJ_ERROR("Duplicate tile layer ID {}", layer_id);
+      return false;
+    }
+
+    m_pending_tiles.pop_back();
+    return true;
+  }
+};
+
+}  // namespace
+
+auto read_tmj_document(std::istream& stream) -> std::expected<TmjDocument, ErrorCode>
+{
+  try {
+    TmjSaxHandler handler {};
+    if (!JSON::sax_parse(stream, &handler)) {
+      return std::unexpected {ErrorCode::kParseError};
+    }
+
+    return handler.take_document();
+  }
+  catch (const std::exception& error) {
+    TACTILE_TILED_TMJ_ERROR("JSON parse error: {}", error.what());
+    return std::unexpected {ErrorCode::kParseError};
+  }
+  catch (...) {
+    TACTILE_TILED_TMJ_ERROR("Unknown JSON parse error");
+    return std::unexpected {ErrorCode::kParseError};
+  }
+}
+
+auto read_tmj_document(const std::filesystem::path& path)
+    -> std::expected<TmjDocument, ErrorCode>
+{
+  // The buffer must be installed before the file is opened.
+  std::vector<char> stream_buffer(kStreamBufferSize);
+  std::ifstream stream {};
+  stream.rdbuf()->pubsetbuf(stream_buffer.data(),
+                            static_cast<std::streamsize>(stream_buffer.size()));
+
+  stream.open(path, std::ios::in | std::ios::binary);
+  if (!stream.good()) {
+    TACTILE_TILED_TMJ_ERROR("Could not open JSON document: {}", path.string());
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  return read_tmj_document(stream);
+}
+
+}  // namespace tactile::tiled_tmj
@@ -2,22 +2,26 @@
 
 #include "tactile/tiled_tmj/tmj_format_parser.hpp"
 
-#include <iterator>   // distance
-#include <optional>   // optional, nullopt
-#include <stdexcept>  // invalid_argument
-#include <string>     // string
-#include <utility>    // move, cmp_not_equal
+#include <cstddef>     // ptrdiff_t
+#include <filesystem>  // path
+#include <iterator>    // distance
+#include <optional>    // optional, nullopt
+#include <stdexcept>   // invalid_argument
+#include <string>      // string
+#include <utility>     // move, cmp_not_equal
 
-#include <cppcodec/base64_default_rfc4648.hpp>
 #include <nlohmann/json.hpp>
 
+#include "tactile/base/io/base64.hpp"
 #include "tactile/base/io/compress/compression_format.hpp"
+#include "tactile/base/io/save/external_tileset_cache.hpp"
 #include "tactile/base/io/tile_io.hpp"
 #include "tactile/base/meta/color.hpp"
 #include "tactile/base/numeric/literals.hpp"
 #include "tactile/base/util/tile_matrix.hpp"
 #include "tactile/tiled_tmj/logging.hpp"
 #include "tactile/tiled_tmj/tmj_common.hpp"
+#include "tactile/tiled_tmj/tmj_document_reader.hpp"
 
 namespace tactile::tiled_tmj {
 namespace {
@@ -28,7 +32,9 @@ auto _read_object_layer(const JSON& layer_json, std::vector<ir::Object>& objects
 
 [[nodiscard]]
 auto _read_layers(const IRuntime& runtime,
+                  const SaveFormatReadOptions& options,
                   const JSON& root_json,
+                  TmjTileData& tile_data,
                   std::vector<ir::Layer>& layers,
                   ir::TileFormat& tile_format) -> std::expected<void, ErrorCode>;
 
@@ -176,7 +182,7 @@ auto _read_tileset_tiles(const JSON& tileset_json, ir::Tileset& tileset)
 
 [[nodiscard]]
 auto _read_common_tileset_attributes(const JSON& tileset_json,
-                                     const SaveFormatReadOptions& options,
+                                     const std::filesystem::path& base_dir,
                                      ir::Tileset& tileset) -> std::expected<void, ErrorCode>
 {
   return _read_metadata(tileset_json, tileset.meta)
@@ -191,7 +197,7 @@ auto _read_common_tileset_attributes(const JSON& tileset_json,
           [&] { return read_attr_to(tileset_json, "imageheight", tileset.image_size[1]); })
       .and_then([&] { return read_attr<std::string>(tileset_json, "image"); })
       .and_then([&](const std::string& image_path) {
-        tileset.image_path = options.base_dir / image_path;
+        tileset.image_path = base_dir / image_path;
         return std::expected<void, ErrorCode> {};
       })
       .and_then([&] { return _read_tileset_tiles(tileset_json, tileset); });
@@ -204,14 +210,14 @@ auto _read_embedded_tileset(const JSON& tileset_json, const SaveFormatReadOption
   ir::Tileset tileset {};
   tileset.is_embedded = true;
 
-  return _read_common_tileset_attributes(tileset_json, options, tileset).transform([&] {
-    return std::move(tileset);
-  });
+  return _read_common_tileset_attributes(tileset_json, options.base_dir, tileset)
+      .transform([&] { return std::move(tileset); });
 }
 
+// Image paths are left unresolved, since cached tilesets may be shared by maps in
+// different directories.
 [[nodiscard]]
-auto _read_external_tileset(const std::filesystem::path& path,
-                            const SaveFormatReadOptions& options)
+auto _parse_external_tileset(const std::filesystem::path& path)
     -> std::expected<ir::Tileset, ErrorCode>
 {
   ir::Tileset tileset {};
@@ -219,21 +225,42 @@ auto _read_external_tileset(const std::filesystem::path& path,
 
   return read_json_document(path)
       .and_then([&](const JSON& tileset_json) {
-        return _read_common_tileset_attributes(tileset_json, options, tileset);
+        return _read_common_tileset_attributes(tileset_json, {}, tileset);
       })
       .transform([&] { return std::move(tileset); });
 }
 
 [[nodiscard]]
-auto _read_tileset_ref(const JSON& tileset_ref_json, const SaveFormatReadOptions& options)
+auto _read_external_tileset(const IRuntime& runtime,
+                            const std::filesystem::path& path,
+                            const SaveFormatReadOptions& options)
+    -> std::expected<ir::Tileset, ErrorCode>
+{
+  auto* tileset_cache = runtime.get_external_tileset_cache();
+
+  auto tileset = tileset_cache != nullptr
+                     ? tileset_cache->get_tileset(path, &_parse_external_tileset)
+                     : _parse_external_tileset(path);
+
+  return std::move(tileset).transform([&](ir::Tileset&& external_tileset) {
+    external_tileset.image_path = options.base_dir / external_tileset.image_path;
+    return std::move(external_tileset);
+  });
+}
+
+[[nodiscard]]
+auto _read_tileset_ref(const IRuntime& runtime,
+                       const JSON& tileset_ref_json,
+                       const SaveFormatReadOptions& options)
     -> std::expected<ir::TilesetRef, ErrorCode>
 {
   ir::TilesetRef tileset_ref {};
   return read_attr_to(tileset_ref_json, "firstgid", tileset_ref.first_tile_id)
       .and_then([&] {
         const auto source = read_attr<std::string>(tileset_ref_json, "source");
-        return source.has_value() ? _read_external_tileset(options.base_dir / *source, options)
-                                  : _read_embedded_tileset(tileset_ref_json, options);
+        return source.has_value()
+                   ? _read_external_tileset(runtime, options.base_dir / *source, options)
+                   : _read_embedded_tileset(tileset_ref_json, options);
       })
       .transform([&](ir::Tileset&& tileset) {
         tileset_ref.tileset = std::move(tileset);
@@ -242,11 +269,13 @@ auto _read_tileset_ref(const JSON& tileset_ref_json, const SaveFormatReadOptions
 }
 
 [[nodiscard]]
-auto _read_tilesets(const JSON& map_json, const SaveFormatReadOptions& options, ir::Map& map)
-    -> std::expected<void, ErrorCode>
+auto _read_tilesets(const IRuntime& runtime,
+                    const JSON& map_json,
+                    const SaveFormatReadOptions& options,
+                    ir::Map& map) -> std::expected<void, ErrorCode>
 {
   const auto tileset_ref_parser = [&](const JSON& tileset_ref_json) {
-    return _read_tileset_ref(tileset_ref_json, options);
+    return _read_tileset_ref(runtime, tileset_ref_json, options);
   };
 
   return read_array<ir::TilesetRef>(map_json, "tilesets", tileset_ref_parser)
@@ -258,13 +287,18 @@ auto _read_tilesets(const JSON& map_json, const SaveFormatReadOptions& options,
 
 [[nodiscard]]
 auto _read_base64_tile_data(const IRuntime& runtime,
+                            const SaveFormatReadOptions& options,
                             const JSON& layer_json,
                             const Extent2D& extent,
                             const ir::TileFormat& tile_format)
     -> std::expected<TileMatrix, ErrorCode>
 {
   const auto& encoded_tile_data = layer_json.at("data").get_ref<const JSON::string_t&>();
-  auto decoded_bytes = base64::decode(encoded_tile_data);
+  auto decoded_bytes = base64_decode(encoded_tile_data);
+  if (!decoded_bytes.has_value()) {
+    TACTILE_TILED_TMJ_ERROR("Could not decode Base64 tile data");
+    return std::unexpected {ErrorCode::kParseError};
+  }
 
   if (tile_format.compression.has_value()) {
     const auto* compression_format = runtime.get_compression_format(*tile_format.compression);
@@ -273,7 +307,12 @@ auto _read_base64_tile_data(const IRuntime& runtime,
       return std::unexpected {ErrorCode::kNotSupported};
     }
 
-    auto decompressed_bytes = compression_format->decompress(decoded_bytes);
+    const DecompressionOptions decompression_options {
+      .dictionary = options.compression_dictionary,
+    };
+
+    auto decompressed_bytes =
+        compression_format->decompress(*decoded_bytes, decompression_options);
     if (!decompressed_bytes.has_value()) {
       return std::unexpected {decompressed_bytes.error()};
     }
@@ -281,7 +320,7 @@ auto _read_base64_tile_data(const IRuntime& runtime,
     decoded_bytes = std::move(*decompressed_bytes);
   }
 
-  auto tile_matrix = parse_raw_tile_matrix(decoded_bytes, extent, TileIdFormat::kTiled);
+  auto tile_matrix = parse_raw_tile_matrix(*decoded_bytes, extent, TileIdFormat::kTiled);
 
   if (!tile_matrix.has_value()) {
     TACTILE_TILED_TMJ_ERROR("Could not parse raw tile matrix");
@@ -320,9 +359,48 @@ auto _read_plain_text_tile_data(const JSON& layer_json, const Extent2D& extent)
   return tile_matrix;
 }
 
+[[nodiscard]]
+auto _read_extracted_tile_data(TmjTileData& tile_data,
+                               const LayerID layer_id,
+                               const Extent2D& extent) -> std::expected<TileMatrix, ErrorCode>
+{
+  const auto tiles_iter = tile_data.find(layer_id);
+  if (tiles_iter == tile_data.end()) {
+    TACTILE_TILED_TMJ_ERROR("Tile layer {} has no tile data", layer_id);
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  // The buffer is released once the tile matrix has been created.
+  const auto tiles = std::move(tiles_iter->second);
+  tile_data.erase(tiles_iter);
+
+  const auto expected_tile_count = extent.rows * extent.cols;
+  if (std::cmp_not_equal(expected_tile_count, tiles.size())) {
+    TACTILE_TILED_TMJ_ERROR("Invalid tile count in layer (expected {} but got {})",
+                            expected_tile_count,
+                            tiles.size());
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  TileMatrix tile_matrix {};
+  tile_matrix.reserve(extent.rows);
+
+  const auto row_size = static_cast<std::ptrdiff_t>(extent.cols);
+  auto row_begin = tiles.begin();
+
+  for (auto row = 0_uz; row < extent.rows; ++row) {
+    tile_matrix.emplace_back(row_begin, row_begin + row_size);
+    row_begin += row_size;
+  }
+
+  return tile_matrix;
+}
+
 [[nodiscard]]
 auto _read_tile_layer(const IRuntime& runtime,
+                      const SaveFormatReadOptions& options,
                       const JSON& layer_json,
+                      TmjTileData& tile_data,
                       ir::Layer& layer,
                       ir::TileFormat& tile_format) -> std::expected<void, ErrorCode>
 {
@@ -342,10 +420,18 @@ auto _read_tile_layer(const IRuntime& runtime,
 
         switch (tile_format.encoding) {
           case TileEncoding::kPlainText: {
+            if (!layer_json.contains("data")) {
+              return _read_extracted_tile_data(tile_data, layer.id, layer.extent);
+            }
+
             return _read_plain_text_tile_data(layer_json, layer.extent);
           }
           case TileEncoding::kBase64: {
-            return _read_base64_tile_data(runtime, layer_json, layer.extent, tile_format);
+            return _read_base64_tile_data(runtime,
+                                          options,
+                                          layer_json,
+                                          layer.extent,
+                                          tile_format);
           }
           default: throw std::invalid_argument {"bad tile encoding"};
         }
@@ -396,16 +482,21 @@ auto _read_object_layer(const JSON& layer_json, std::vector<ir::Object>& objects
 
 [[nodiscard]]
 auto _read_group_layer(const IRuntime& runtime,
+                       const SaveFormatReadOptions& options,
                        const JSON& layer_json,
+                       TmjTileData& tile_data,
                        ir::Layer& layer,
                        ir::TileFormat& tile_format) -> std::expected<void, ErrorCode>
 {
-  return _read_layers(runtime, layer_json, layer.layers, tile_format);
+  return _read_layers(runtime, options, layer_json, tile_data, layer.layers, tile_format);
 }
 
 [[nodiscard]]
-auto _read_layer(const IRuntime& runtime, const JSON& layer_json, ir::TileFormat& tile_format)
-    -> std::expected<ir::Layer, ErrorCode>
+auto _read_layer(const IRuntime& runtime,
+                 const SaveFormatReadOptions& options,
+                 const JSON& layer_json,
+                 TmjTileData& tile_data,
+                 ir::TileFormat& tile_format) -> std::expected<ir::Layer, ErrorCode>
 {
   ir::Layer layer {};
   return read_attr_to(layer_json, "id", layer.id)
@@ -424,13 +515,23 @@ auto _read_layer(const IRuntime& runtime, const JSON& layer_json, ir::TileFormat
         layer.type = type;
         switch (type) {
           case LayerType::kTileLayer: {
-            return _read_tile_layer(runtime, layer_json, layer, tile_format);
+            return _read_tile_layer(runtime,
+                                    options,
+                                    layer_json,
+                                    tile_data,
+                                    layer,
+                                    tile_format);
           }
           case LayerType::kObjectLayer: {
             return _read_object_layer(layer_json, layer.objects);
           }
           case LayerType::kGroupLayer: {
-            return _read_group_layer(runtime, layer_json, layer, tile_format);
+            return _read_group_layer(runtime,
+                                     options,
+                                     layer_json,
+                                     tile_data,
+                                     layer,
+                                     tile_format);
           }
           default: throw std::invalid_argument {"bad layer type"};
         }
@@ -441,12 +542,14 @@ auto _read_layer(const IRuntime& runtime, const JSON& layer_json, ir::TileFormat
 
 [[nodiscard]]
 auto _read_layers(const IRuntime& runtime,
+                  const SaveFormatReadOptions& options,
                   const JSON& root_json,
+                  TmjTileData& tile_data,
                   std::vector<ir::Layer>& layers,
                   ir::TileFormat& tile_format) -> std::expected<void, ErrorCode>
 {
   const auto layer_parser = [&](const JSON& layer_json) {
-    return _read_layer(runtime, layer_json, tile_format);
+    return _read_layer(runtime, options, layer_json, tile_data, tile_format);
   };
 
   return read_array<ir::Layer>(root_json, "layers", layer_parser)
@@ -456,11 +559,11 @@ auto _read_layers(const IRuntime& runtime,
       });
 }
 
-}  // namespace
-
-auto parse_tmj_map(const IRuntime& runtime,
-                   const JSON& map_json,
-                   const SaveFormatReadOptions& options) -> std::expected<ir::Map, ErrorCode>
+[[nodiscard]]
+auto _read_map(const IRuntime& runtime,
+               const JSON& map_json,
+               TmjTileData& tile_data,
+               const SaveFormatReadOptions& options) -> std::expected<ir::Map, ErrorCode>
 {
   ir::Map map {};
 
@@ -476,9 +579,33 @@ auto parse_tmj_map(const IRuntime& runtime,
       .and_then([&] { return read_attr_to(map_json, "nextlayerid", map.next_layer_id); })
       .and_then([&] { return read_attr_to(map_json, "nextobjectid", map.next_object_id); })
       .and_then([&] { return _read_metadata(map_json, map.meta); })
-      .and_then([&] { return _read_tilesets(map_json, options, map); })
-      .and_then([&] { return _read_layers(runtime, map_json, map.layers, map.tile_format); })
+      .and_then([&] { return _read_tilesets(runtime, map_json, options, map); })
+      .and_then([&] {
+        return _read_layers(runtime,
+                            options,
+                            map_json,
+                            tile_data,
+                            map.layers,
+                            map.tile_format);
+      })
       .transform([&] { return std::move(map); });
 }
 
+}  // namespace
+
+auto parse_tmj_map(const IRuntime& runtime,
+                   const JSON& map_json,
+                   const SaveFormatReadOptions& options) -> std::expected<ir::Map, ErrorCode>
+{
+  TmjTileData tile_data {};
+  return _read_map(runtime, map_json, tile_data, options);
+}
+
+auto parse_tmj_map(const IRuntime& runtime,
+                   TmjDocument document,
+                   const SaveFormatReadOptions& options) -> std::expected<ir::Map, ErrorCode>
+{
+  return _read_map(runtime, document.json, document.tile_data, options);
+}
+
 }  // namespace tactile::tiled_tmj
@@ -0,0 +1,196 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/tiled_tmj/tmj_json_writer.hpp"
+
+#include <cstddef>  // size_t
+
+#include "tactile/base/io/base64.hpp"
+
+namespace tactile::tiled_tmj {
+namespace {
+
+[[nodiscard]]
+constexpr auto _needs_escaping(const char ch) noexcept -> bool
+{
+  return ch == '"' || ch == '\\' || static_cast<unsigned char>(ch) < 0x20;
+}
+
+}  // namespace
+
+TmjJsonWriter::TmjJsonWriter(std::ostream& stream, const int indentation)
+  : m_stream {&stream},
+    m_indentation {indentation}
+{
+  m_buffer.reserve(kFlushThreshold);
+}
+
+void TmjJsonWriter::begin_object()
+{
+  _begin_value();
+  m_buffer += '{';
+  m_scopes.push_back(Scope {.is_empty = true});
+}
+
+void TmjJsonWriter::end_object()
+{
+  const auto scope = m_scopes.back();
+  m_scopes.pop_back();
+
+  if (!scope.is_empty) {
+    _append_newline();
+  }
+
+  m_buffer += '}';
+  _flush_if_needed();
+}
+
+void TmjJsonWriter::begin_array()
+{
+  _begin_value();
+  m_buffer += '[';
+  m_scopes.push_back(Scope {.is_empty = true});
+}
+
+void TmjJsonWriter::end_array()
+{
+  const auto scope = m_scopes.back();
+  m_scopes.pop_back();
+
+  if (!scope.is_empty) {
+    _append_newline();
+  }
+
+  m_buffer += ']';
+  _flush_if_needed();
+}
+
+void TmjJsonWriter::key(const std::string_view key)
+{
+  _begin_value();
+  _append_string(key);
+
+  m_buffer += ':';
+  if (m_indentation > 0) {
+    m_buffer += ' ';
+  }
+
+  m_after_key = true;
+}
+
+void TmjJsonWriter::value(const std::string_view str)
+{
+  _begin_value();
+  _append_string(str);
+}
+
+void TmjJsonWriter::value(const char* str)
+{
+  value(std::string_view {str});
+}
+
+void TmjJsonWriter::value(const bool boolean)
+{
+  _begin_value();
+  m_buffer += boolean ? "true" : "false";
+}
+
+void TmjJsonWriter::base64_value(const ByteSpan bytes)
+{
+  _begin_value();
+
+  m_buffer += '"';
+  base64_encode(bytes, m_buffer);
+  m_buffer += '"';
+
+  _flush_if_needed();
+}
+
+auto TmjJsonWriter::flush() -> std::expected<void, ErrorCode>
+{
+  m_stream->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+  m_stream->flush();
+  m_buffer.clear();
+
+  if (!m_stream->good()) {
+    return std::unexpected {ErrorCode::kWriteError};
+  }
+
+  return {};
+}
+
+void TmjJsonWriter::_begin_value()
+{
+  if (m_after_key) {
+    m_after_key = false;
+    return;
+  }
+
+  if (m_scopes.empty()) {
+    return;
+  }
+
+  auto& scope = m_scopes.back();
+  if (!scope.is_empty) {
+    m_buffer += ',';
+  }
+
+  scope.is_empty = false;
+  _append_newline();
+}
+
+void TmjJsonWriter::_append_newline()
+{
+  if (m_indentation > 0) {
+    m_buffer += '\n';
+    m_buffer.append(m_scopes.size() * static_cast<std::size_t>(m_indentation), ' ');
+  }
+}
+
+void TmjJsonWriter::_append_string(const std::string_view str)
+{
+  // NOLINTNEXTLINE(*-avoid-c-arrays)
+  constexpr char kHexDigits[] = "0123456789abcdef";
+
+  m_buffer += '"';
+
+  std::size_t run_begin = 0;
+  for (std::size_t index = 0; index < str.size(); ++index) {
+    const auto ch = str[index];
+    if (!_needs_escaping(ch)) {
+      continue;
+    }
+
+    m_buffer.append(str.substr(run_begin, index - run_begin));
+    run_begin = index + 1;
+
+    switch (ch) {
+      case '"':  m_buffer += "\\\""; break;
+      case '\\': m_buffer += "\\\\"; break;
+      case '\b': m_buffer += "\\b"; break;
+      case '\f': m_buffer += "\\f"; break;
+      case '\n': m_buffer += "\\n"; break;
+      case '\r': m_buffer += "\\r"; break;
+      case '\t': m_buffer += "\\t"; break;
+      default: {
+        const auto code = static_cast<unsigned char>(ch);
+        m_buffer += "\\u00";
+        m_buffer += kHexDigits[code >> 4u];
+        m_buffer += kHexDigits[code & 0xFu];
+        break;
+      }
+    }
+  }
+
+  m_buffer.append(str.substr(run_begin));
+  m_buffer += '"';
+}
+
+void TmjJsonWriter::_flush_if_needed()
+{
+  if (m_buffer.size() >= kFlushThreshold) {
+    m_stream->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    m_buffer.clear();
+  }
+}
+
+}  // namespace tactile::tiled_tmj
@@ -2,8 +2,14 @@
 
 #include "tactile/tiled_tmj/tmj_save_format.hpp"
 
+#include <fstream>  // ofstream
+#include <ios>      // ios
+#include <utility>  // move
+
 #include "tactile/base/document/map_view.hpp"
+#include "tactile/base/io/temp_file.hpp"
 #include "tactile/tiled_tmj/logging.hpp"
+#include "tactile/tiled_tmj/tmj_document_reader.hpp"
 #include "tactile/tiled_tmj/tmj_format_parser.hpp"
 #include "tactile/tiled_tmj/tmj_format_save_visitor.hpp"
 
@@ -18,8 +24,8 @@ auto TmjSaveFormat::load_map(const std::filesystem::path& map_path,
     -> std::expected<ir::Map, ErrorCode>
 {
   try {
-    return read_json_document(map_path).and_then([this, &options](const JSON& map_json) {
-      return parse_tmj_map(*m_runtime, map_json, options);
+    return read_tmj_document(map_path).and_then([this, &options](TmjDocument&& document) {
+      return parse_tmj_map(*m_runtime, std::move(document), options);
     });
   }
   catch (const std::exception& error) {
@@ -46,28 +52,24 @@ auto TmjSaveFormat::save_map(const IMapView& map, const SaveFormatWriteOptions&
 
     TACTILE_TILED_TMJ_DEBUG("Saving TMJ map to {}", map_path->string());
 
-    TmjFormatSaveVisitor visitor {m_runtime, options};
+    TempFile map_file {*map_path};
+    std::ofstream map_stream {map_file.path(), std::ios::out | std::ios::trunc};
+    if (!map_stream.good()) {
+      TACTILE_TILED_TMJ_ERROR("Could not open map file: {}", map_path->string());
+      return std::unexpected {ErrorCode::kBadFileStream};
+    }
 
+    TmjFormatSaveVisitor visitor {m_runtime, options, map_stream};
     return map.accept(visitor)
-        .and_then([&] {
-          const auto& map_json = visitor.get_map_json();
-          return save_json_document(*map_path, map_json, options.use_indentation ? 2 : 0);
-        })
+        .and_then([&] { return visitor.finish(); })
         .and_then([&]() -> std::expected<void, ErrorCode> {
-          const auto& external_tilesets = visitor.get_external_tilesets();
-
-          for (const auto& [first_tiled_id, external_tileset] : external_tilesets) {
-            const auto save_tileset_result =
-                save_json_document(external_tileset.path,
-                                   external_tileset.json,
-                                   options.use_indentation ? 2 : 0);
-            if (!save_tileset_result.has_value()) {
-              TACTILE_TILED_TMJ_ERROR("Could not save external tileset");
-              return std::unexpected {save_tileset_result.error()};
-            }
+          map_stream.close();
+          if (map_stream.fail()) {
+            TACTILE_TILED_TMJ_ERROR("Could not write map file: {}", map_path->string());
+            return std::unexpected {ErrorCode::kWriteError};
           }
 
-          return {};
+          return map_file.commit();
         });
   }
   catch (const std::exception& error) {
@@ -0,0 +1,134 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/tiled_tmj/tmj_document_reader.hpp"
+
+#include <sstream>      // istringstream
+#include <string>       // string
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include <gtest/gtest.h>
+
+namespace tactile::tiled_tmj {
+namespace {
+
+[[nodiscard]]
+auto _read_tmj_string(const std::string_view json) -> std::expected<TmjDocument, ErrorCode>
+{
+  std::istringstream stream {std::string {json}};
+  return read_tmj_document(stream);
+}
+
+// tactile::tiled_tmj::read_tmj_document
+TEST(TmjDocumentReader, ExtractPlainTextTileData)
+{
+  const auto document = _read_tmj_string(R"({
+    "height": 2,
+    "layers": [
+      {"data": [1, 2, 3, 0], "height": 2, "id": 1, "type": "tilelayer", "width": 2},
+      {
+        "id": 2,
+        "layers": [
+          {
+            "data": [0, 0, 7, 3221225473],
+            "height": 2,
+            "id": 3,
+            "type": "tilelayer",
+            "width": 2
+          }
+        ],
+        "type": "group"
+      }
+    ],
+    "width": 2
+  })");
+  ASSERT_TRUE(document.has_value());
+
+  const auto& layers_json = document->json.at("layers");
+  ASSERT_EQ(layers_json.size(), 2);
+  EXPECT_FALSE(layers_json.at(0).contains("data"));
+  EXPECT_EQ(layers_json.at(0).at("width"), 2);
+  EXPECT_EQ(layers_json.at(0).at("type"), "tilelayer");
+  EXPECT_FALSE(layers_json.at(1).at("layers").at(0).contains("data"));
+  EXPECT_EQ(document->json.at("height"), 2);
+
+  ASSERT_EQ(document->tile_data.size(), 2);
+  EXPECT_EQ(document->tile_data.at(1), (std::vector<TileID> {1, 2, 3, 0}));
+  EXPECT_EQ(document->tile_data.at(3),
+            (std::vector<TileID> {0, 0, 7, static_cast<TileID>(3221225473u)}));
+}
+
+// tactile::tiled_tmj::read_tmj_document
+TEST(TmjDocumentReader, KeepBase64TileData)
+{
+  const auto document = _read_tmj_string(R"({
+    "layers": [{"data": "AQAAAA==", "encoding": "base64", "id": 1, "type": "tilelayer"}]
+  })");
+  ASSERT_TRUE(document.has_value());
+
+  EXPECT_TRUE(document->tile_data.empty());
+  EXPECT_EQ(document->json.at("layers").at(0).at("data"), "AQAAAA==");
+}
+
+// tactile::tiled_tmj::read_tmj_document
+TEST(TmjDocumentReader, KeepPropertiesAfterTileData)
+{
+  const auto document = _read_tmj_string(R"({
+    "layers": [
+      {
+        "data": [4],
+        "id": 5,
+        "properties": [{"name": "foo", "type": "int", "value": 42}],
+        "type": "tilelayer"
+      }
+    ]
+  })");
+  ASSERT_TRUE(document.has_value());
+
+  const auto& layer_json = document->json.at("layers").at(0);
+  EXPECT_EQ(layer_json.at("properties").at(0).at("value"), 42);
+  EXPECT_EQ(document->tile_data.at(5), (std::vector<TileID> {4}));
+}
+
+// tactile::tiled_tmj::read_tmj_document
+TEST(TmjDocumentReader, RejectInvalidTileData)
+{
+  EXPECT_EQ(_read_tmj_string(R"({"layers": [{"data": [1, "2"], "id": 1}]})"),
+            std::unexpected {ErrorCode::kParseError});
+  EXPECT_EQ(_read_tmj_string(R"({"layers": [{"data": [1, 2.5], "id": 1}]})"),
+            std::unexpected {ErrorCode::kParseError});
+  EXPECT_EQ(_read_tmj_string(R"({"layers": [{"data": [[1]], "id": 1}]})"),
+            std::unexpected {ErrorCode::kParseError});
+  EXPECT_EQ(_read_tmj_string(R"({"layers": [{"data": [{}], "id": 1}]})"),
+            std::unexpected {ErrorCode::kParseError});
+}
+
+// tactile::tiled_tmj::read_tmj_document
+TEST(TmjDocumentReader, RejectTileDataWithoutValidLayerId)
+{
+  EXPECT_EQ(_read_tmj_string(R"({"layers": [{"data": [1]}]})"),
+            std::unexpected {ErrorCode::kParseError});
+  EXPECT_EQ(_read_tmj_string(R"({"layers": [{"data": [1], "id": "1"}]})"),
+            std::unexpected {ErrorCode::kParseError});
+}
+
+// tactile::tiled_tmj::read_tmj_document
+TEST(TmjDocumentReader, RejectDuplicateLayerIds)
+{
+  const auto document = _read_tmj_string(R"({
+    "layers": [{"data": [1], "id": 1}, {"data": [2], "id": 1}]
+  })");
+  EXPECT_EQ(document, std::unexpected {ErrorCode::kParseError});
+}
+
+// tactile::tiled_tmj::read_tmj_document
+TEST(TmjDocumentReader, RejectMalformedDocument)
+{
+  EXPECT_EQ(_read_tmj_string(""), std::unexpected {ErrorCode::kParseError});
+  EXPECT_EQ(_read_tmj_string(R"({"layers": [{"data": [1, 2)"),
+            std::unexpected {ErrorCode::kParseError});
+  EXPECT_EQ(_read_tmj_string(R"({"width": 10,})"), std::unexpected {ErrorCode::kParseError});
+}
+
+}  // namespace
+}  // namespace tactile::tiled_tmj
@@ -0,0 +1,156 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/tiled_tmj/tmj_json_writer.hpp"
+
+#include <cstddef>      // size_t
+#include <cstdint>      // int32_t, uint8_t
+#include <limits>       // numeric_limits
+#include <span>         // span
+#include <sstream>      // ostringstream
+#include <string>       // string
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include <gtest/gtest.h>
+
+#include "tactile/tiled_tmj/tmj_common.hpp"
+
+namespace tactile::tiled_tmj {
+namespace {
+
+// tactile::tiled_tmj::TmjJsonWriter::begin_object
+// tactile::tiled_tmj::TmjJsonWriter::end_object
+// tactile::tiled_tmj::TmjJsonWriter::begin_array
+// tactile::tiled_tmj::TmjJsonWriter::end_array
+// tactile::tiled_tmj::TmjJsonWriter::member
+TEST(TmjJsonWriter, CompactOutput)
+{
+  std::ostringstream stream {};
+  TmjJsonWriter writer {stream, 0};
+
+  writer.begin_object();
+  writer.member("name", "foo");
+  writer.member("id", 42);
+  writer.member("opacity", 0.5f);
+  writer.member("visible", true);
+  writer.key("empty");
+  writer.begin_array();
+  writer.end_array();
+  writer.key("nested");
+  writer.begin_object();
+  writer.end_object();
+  writer.end_object();
+
+  ASSERT_TRUE(writer.flush().has_value());
+  EXPECT_EQ(stream.str(),
+            R"({"name":"foo","id":42,"opacity":0.5,"visible":true,"empty":[],"nested":{}})");
+}
+
+// tactile::tiled_tmj::TmjJsonWriter::begin_object
+// tactile::tiled_tmj::TmjJsonWriter::end_object
+// tactile::tiled_tmj::TmjJsonWriter::values
+TEST(TmjJsonWriter, IndentedOutput)
+{
+  std::ostringstream stream {};
+  TmjJsonWriter writer {stream, 2};
+
+  const std::vector<std::int32_t> row1 {1, 2, 3};
+  const std::vector<std::int32_t> row2 {4, 5, 6};
+
+  writer.begin_object();
+  writer.member("id", 1);
+  writer.key("data");
+  writer.begin_array();
+  writer.values(std::span<const std::int32_t> {row1});
+  writer.values(std::span<const std::int32_t> {row2});
+  writer.end_array();
+  writer.end_object();
+
+  ASSERT_TRUE(writer.flush().has_value());
+  EXPECT_EQ(stream.str(),
+            "{\n"
+            "  \"id\": 1,\n"
+            "  \"data\": [\n"
+            "    1,2,3,\n"
+            "    4,5,6\n"
+            "  ]\n"
+            "}");
+}
+
+// tactile::tiled_tmj::TmjJsonWriter::value
+TEST(TmjJsonWriter, EscapeStrings)
+{
+  std::ostringstream stream {};
+  TmjJsonWriter writer {stream, 0};
+
+  writer.value(std::string_view {"a\"b\\c\n\t\x01 \xC3\xA5"});
+
+  ASSERT_TRUE(writer.flush().has_value());
+  EXPECT_EQ(stream.str(), "\"a\\\"b\\\\c\\n\\t\\u0001 \xC3\xA5\"");
+}
+
+// tactile::tiled_tmj::TmjJsonWriter::value
+TEST(TmjJsonWriter, FloatingPointNumbers)
+{
+  std::ostringstream stream {};
+  TmjJsonWriter writer {stream, 0};
+
+  writer.begin_array();
+  writer.value(std::numeric_limits<float>::infinity());
+  writer.value(std::numeric_limits<double>::quiet_NaN());
+  writer.value(-1.25);
+  writer.value(2.0f);
+  writer.value(1e30);
+  writer.end_array();
+
+  ASSERT_TRUE(writer.flush().has_value());
+  EXPECT_EQ(stream.str(), "[null,null,-1.25,2.0,1e+30]");
+}
+
+// tactile::tiled_tmj::TmjJsonWriter::base64_value
+TEST(TmjJsonWriter, Base64Value)
+{
+  std::ostringstream stream {};
+  TmjJsonWriter writer {stream, 0};
+
+  const std::vector<std::uint8_t> bytes {'f', 'o', 'o', 'b', 'a', 'r'};
+  writer.base64_value(bytes);
+
+  ASSERT_TRUE(writer.flush().has_value());
+  EXPECT_EQ(stream.str(), R"("Zm9vYmFy")");
+}
+
+// tactile::tiled_tmj::TmjJsonWriter::values
+TEST(TmjJsonWriter, LargeDocumentRoundtrip)
+{
+  std::ostringstream stream {};
+  TmjJsonWriter writer {stream, 2};
+
+  std::vector<std::int32_t> row(1'000);
+  for (std::size_t index = 0; index < row.size(); ++index) {
+    row[index] = static_cast<std::int32_t>(index) - 1;
+  }
+
+  writer.begin_object();
+  writer.key("data");
+  writer.begin_array();
+
+  for (int row_index = 0; row_index < 200; ++row_index) {
+    writer.values(std::span<const std::int32_t> {row});
+  }
+
+  writer.end_array();
+  writer.member("name", "a \"quoted\" name");
+  writer.end_object();
+
+  ASSERT_TRUE(writer.flush().has_value());
+
+  const auto json = JSON::parse(stream.str());
+  ASSERT_EQ(json.at("data").size(), std::size_t {200'000});
+  EXPECT_EQ(json.at("data").at(0), -1);
+  EXPECT_EQ(json.at("data").at(999), 998);
+  EXPECT_EQ(json.at("name"), "a \"quoted\" name");
+}
+
+}  // namespace
+}  // namespace tactile::tiled_tmj
@@ -3,9 +3,13 @@
 #include <expected>    // expected
 #include <filesystem>  // path
 
+#include <pugixml.hpp>
+
 #include "tactile/base/debug/error_code.hpp"
 #include "tactile/base/io/save/save_format.hpp"
+#include "tactile/base/numeric/extent_2d.hpp"
 #include "tactile/base/runtime/runtime.hpp"
+#include "tactile/base/util/tile_matrix.hpp"
 #include "tactile/tiled_tmx/api.hpp"
 
 namespace tactile::tiled_tmx {
@@ -28,4 +32,43 @@ TACTILE_TILED_TMX_API auto parse_map(const IRuntime& runtime,
                                      const SaveFormatReadOptions& options)
     -> std::expected<ir::Map, ErrorCode>;
 
+/**
+ * Reads tile layer data stored as a sequence of tile nodes.
+ *
+ * \details
+ * Tile nodes without a GID attribute represent empty tiles, and nodes with
+ * other names are ignored. Missing tiles at the end of the data are empty.
+ * GIDs are unsigned 32-bit integers, whose bits (including any flip flags) are
+ * stored as is in the tile identifiers.
+ *
+ * \param data_node The tile layer data node.
+ * \param extent    The size of the tile layer.
+ *
+ * \return
+ * The parsed tiles if successful; an error code otherwise.
+ */
+[[nodiscard]]
+TACTILE_TILED_TMX_API auto read_tile_nodes_data(const pugi::xml_node& data_node,
+                                                const Extent2D& extent)
+    -> std::expected<TileMatrix, ErrorCode>;
+
+/**
+ * Reads tile layer data stored as comma-separated values.
+ *
+ * \details
+ * Whitespace between values is ignored, as is a single trailing comma. Missing
+ * tiles at the end of the data are empty. GIDs are read like in
+ * \c read_tile_nodes_data.
+ *
+ * \param data_node The tile layer data node.
+ * \param extent    The size of the tile layer.
+ *
+ * \return
+ * The parsed tiles if successful; an error code otherwise.
+ */
+[[nodiscard]]
+TACTILE_TILED_TMX_API auto read_csv_tile_data(const pugi::xml_node& data_node,
+                                              const Extent2D& extent)
+    -> std::expected<TileMatrix, ErrorCode>;
+
 }  // namespace tactile::tiled_tmx
@@ -1,30 +1,51 @@
 #pragma once
 
-#include <cstddef>        // size_t
-#include <string>         // string
-#include <unordered_map>  // unordered_map
-#include <vector>         // vector
-
-#include <pugixml.hpp>
+#include <cstdint>   // uint32_t
+#include <expected>  // expected
+#include <fstream>   // ofstream
+#include <optional>  // optional
+#include <ostream>   // ostream
+#include <vector>    // vector
 
 #include "tactile/base/document/document_visitor.hpp"
-#include "tactile/base/document/tileset_view.hpp"
+#include "tactile/base/id.hpp"
+#include "tactile/base/io/byte_stream.hpp"
 #include "tactile/base/io/save/save_format.hpp"
+#include "tactile/base/io/temp_file.hpp"
 #include "tactile/base/runtime/runtime.hpp"
 #include "tactile/tiled_tmx/api.hpp"
+#include "tactile/tiled_tmx/tmx_xml_writer.hpp"
 
 namespace tactile::tiled_tmx {
 
-struct TmxTilesetDocument final
-{
-  std::string source;
-  pugi::xml_document document;
-};
-
+/**
+ * A document visitor that emits Tiled TMX format XML while visiting a map.
+ *
+ * \details
+ * The XML is written to the output stream as the map is visited, relying on
+ * the documented visit order, i.e., that children are visited directly after
+ * their parents. Only the path of currently open tileset, tile and layer
+ * elements is tracked, and visits in any other order are reported as errors.
+ * As a result, the peak memory usage is proportional to the largest layer,
+ * not to the whole document.
+ *
+ * External tilesets are written to temporary files in the base directory,
+ * as each tileset is visited. These replace the actual tileset files once the
+ * map has been successfully emitted, and are otherwise removed.
+ */
 class TACTILE_TILED_TMX_API TmxFormatSaveVisitor final : public IDocumentVisitor
 {
  public:
-  TmxFormatSaveVisitor(IRuntime* runtime, SaveFormatWriteOptions options);
+  /**
+   * Creates a visitor.
+   *
+   * \param runtime    The associated runtime, cannot be null.
+   * \param options    The write options to use.
+   * \param map_stream The output stream for the map XML, must outlive the visitor.
+   */
+  TmxFormatSaveVisitor(IRuntime* runtime,
+                       SaveFormatWriteOptions options,
+                       std::ostream& map_stream);
 
   [[nodiscard]]
   auto visit(const IComponentView& component) -> std::expected<void, ErrorCode> override;
@@ -44,23 +65,49 @@ class TACTILE_TILED_TMX_API TmxFormatSaveVisitor final : public IDocumentVisitor
   [[nodiscard]]
   auto visit(const ITileView& tile) -> std::expected<void, ErrorCode> override;
 
+  /**
+   * Closes all open XML elements, flushes the output and saves external tilesets.
+   *
+   * \details
+   * This function should be called once, after the map has been visited.
+   *
+   * \return
+   * Nothing if successful; an error code otherwise.
+   */
   [[nodiscard]]
-  auto get_map_xml_document() const -> const pugi::xml_document&;
-
-  [[nodiscard]]
-  auto get_tileset_xml_documents() const -> const std::vector<TmxTilesetDocument>&;
+  auto finish() -> std::expected<void, ErrorCode>;
 
  private:
   IRuntime* m_runtime;
   SaveFormatWriteOptions m_options;
-  pugi::xml_document m_map_document;
-  pugi::xml_node m_map_node;
-  std::vector<pugi::xml_node> m_layer_nodes;
-  std::vector<TmxTilesetDocument> m_tileset_documents;
-  std::unordered_map<TileID, pugi::xml_node> m_tileset_nodes;
+  TmxXmlWriter m_map_writer;
+  std::optional<TempFile> m_tileset_file {};
+  std::optional<std::ofstream> m_tileset_stream {};
+  std::vector<TempFile> m_written_tileset_files {};
+  std::optional<TmxXmlWriter> m_tileset_writer {};
+  std::optional<TileID> m_open_tileset {};
+  std::optional<TileIndex> m_open_tile {};
+  std::vector<LayerID> m_open_layers {};
+  bool m_visited_layers {false};
+  ByteStream m_tile_byte_cache {};
+  std::vector<std::uint32_t> m_tile_row_cache {};
+
+  [[nodiscard]]
+  auto _get_tileset_writer() -> TmxXmlWriter&;
+
+  void _close_open_tile();
+
+  [[nodiscard]]
+  auto _close_open_tileset() -> std::expected<void, ErrorCode>;
+
+  [[nodiscard]]
+  auto _commit_tileset_files() -> std::expected<void, ErrorCode>;
+
+  [[nodiscard]]
+  auto _close_open_layers(const ILayerView* parent_layer) -> std::expected<void, ErrorCode>;
 
   [[nodiscard]]
-  auto _get_tile_node(const ITilesetView& tileset, TileIndex tile_index) -> pugi::xml_node;
+  auto _emit_tile_data(const ILayerView& layer) -> std::expected<void, ErrorCode>;
 };
 
 }  // namespace tactile::tiled_tmx
@@ -0,0 +1,187 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <charconv>     // to_chars
+#include <concepts>     // integral, floating_point, same_as
+#include <cstddef>      // size_t
+#include <expected>     // expected
+#include <ostream>      // ostream
+#include <span>         // span
+#include <string>       // string
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/tiled_tmx/api.hpp"
+
+namespace tactile::tiled_tmx {
+
+/**
+ * A streaming XML writer, used to emit TMX documents without building a DOM.
+ *
+ * \details
+ * Output is accumulated in a small buffer that is written to the underlying
+ * stream in chunks, so the memory usage of the writer doesn't depend on the
+ * size of the emitted document. Attribute values and text are escaped, and
+ * numbers are formatted with \c std::to_chars. Control characters other than
+ * tabs and line breaks aren't allowed in XML 1.0 documents, so they're dropped.
+ *
+ * \note
+ * Attributes must be added directly after the associated element is started,
+ * before any child elements or text.
+ */
+class TACTILE_TILED_TMX_API TmxXmlWriter final
+{
+ public:
+  TACTILE_DELETE_COPY(TmxXmlWriter);
+  TACTILE_DEFAULT_MOVE(TmxXmlWriter);
+
+  /** The buffer size that triggers a write to the underlying stream. */
+  static constexpr std::size_t kFlushThreshold = 65'536;
+
+  /**
+   * Creates an XML writer.
+   *
+   * \param stream      The output stream, must outlive the writer.
+   * \param indentation The number of spaces per indentation level, zero for compact output.
+   */
+  TmxXmlWriter(std::ostream& stream, int indentation);
+
+  ~TmxXmlWriter() noexcept = default;
+
+  /**
+   * Emits the XML declaration, which should precede the root element.
+   */
+  void declaration();
+
+  /**
+   * Starts a new element, as a child of the current element.
+   *
+   * \param name The element name, which isn't escaped and must outlive the element.
+   */
+  void begin_element(std::string_view name);
+
+  /**
+   * Ends the current element.
+   *
+   * \details
+   * Elements without children or text are emitted as self-closing tags.
+   */
+  void end_element();
+
+  void attribute(std::string_view name, std::string_view value);
+
+  void attribute(std::string_view name, const char* value);
+
+  void attribute(std::string_view name, bool value);
+
+  template <typename T>
+    requires(std::integral<T> || std::floating_point<T>) && (!std::same_as<T, bool>)
+  void attribute(const std::string_view name, const T value)
+  {
+    _begin_attribute(name);
+    _append_number(value);
+    m_buffer += '"';
+  }
+
+  /**
+   * Appends escaped text to the content of the current element.
+   *
+   * \param str The text to append.
+   */
+  void text(std::string_view str);
+
+  /**
+   * Appends a line of comma separated numbers to the content of the current element.
+   *
+   * \details
+   * This is intended for CSV tile data, which is emitted one row at a time.
+   * Consecutive lines are separated by commas. If indentation is enabled, each
+   * line is emitted on a separate line, like in TMX files saved by Tiled.
+   *
+   * \param numbers The numbers to append.
+   */
+  template <std::integral T>
+  void csv_line(const std::span<const T> numbers)
+  {
+    auto& element = _begin_text();
+
+    if (element.has_lines) {
+      m_buffer += ',';
+    }
+
+    if (m_indentation > 0) {
+      m_buffer += '\n';
+    }
+
+    for (std::size_t index = 0; index < numbers.size(); ++index) {
+      if (index != 0) {
+        m_buffer += ',';
+      }
+
+      _append_number(numbers[index]);
+    }
+
+    element.has_lines = true;
+    _flush_if_needed();
+  }
+
+  /**
+   * Appends Base64 encoded bytes to the content of the current element.
+   *
+   * \details
+   * The bytes are encoded directly into the output buffer.
+   *
+   * \param bytes The bytes to encode.
+   */
+  void base64_text(ByteSpan bytes);
+
+  /**
+   * Writes all buffered output to the underlying stream.
+   *
+   * \return
+   * Nothing if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  auto flush() -> std::expected<void, ErrorCode>;
+
+ private:
+  struct Element final
+  {
+    std::string_view name;
+    bool has_children;
+    bool has_text;
+    bool has_lines;
+  };
+
+  std::ostream* m_stream;
+  int m_indentation;
+  std::string m_buffer {};
+  std::vector<Element> m_elements {};
+  bool m_start_tag_is_open {false};
+
+  void _close_start_tag();
+
+  void _begin_attribute(std::string_view name);
+
+  auto _begin_text() -> Element&;
+
+  void _append_newline(std::size_t depth);
+
+  void _append_escaped(std::string_view str, bool is_attribute);
+
+  template <typename T>
+  void _append_number(const T number)
+  {
+    char chars[32];  // NOLINT(*-avoid-c-arrays)
+    const auto [end, error] = std::to_chars(chars, chars + sizeof chars, number);
+    m_buffer.append(chars, end);
+  }
+
+  void _flush_if_needed();
+};
+
+}  // namespace tactile::tiled_tmx
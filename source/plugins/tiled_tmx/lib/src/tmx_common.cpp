@@ -2,7 +2,6 @@
 
 #include "tactile//tiled_tmx/tmx_common.hpp"
 
-#include <fstream>    // ifstream
 #include <stdexcept>  // invalid_argument
 
 #include "tactile/tiled_tmx/logging.hpp"
@@ -29,15 +28,19 @@ auto read_xml_document(const std::filesystem::path& path)
 {
   TACTILE_TILED_TMX_TRACE("Parsing XML document at {}", path.string());
 
-  std::ifstream stream {path, std::ios::in};
-  if (!stream.good()) {
-    return std::unexpected {ErrorCode::kBadFileStream};
-  }
-
-  constexpr auto parse_options = pugi::parse_default | pugi::parse_trim_pcdata;
+  // Escapes and EOL normalization are kept since names and property values depend on
+  // them, but attribute whitespace conversion is skipped. Loading directly from the file
+  // lets pugixml parse its own file buffer in place, instead of copying stream data.
+  constexpr auto parse_options =
+      (pugi::parse_default | pugi::parse_trim_pcdata) & ~pugi::parse_wconv_attribute;
 
   pugi::xml_document xml_document {};
-  const auto load_result = xml_document.load(stream, parse_options);
+  const auto load_result = xml_document.load_file(path.c_str(), parse_options);
+
+  if (load_result.status == pugi::status_file_not_found ||
+      load_result.status == pugi::status_io_error) {
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
 
   if (load_result.status != pugi::status_ok) {
     TACTILE_TILED_TMX_ERROR("XML parse error: {}", load_result.description());
@@ -3,9 +3,10 @@
 #include "tactile/tiled_tmx/tmx_format_parser.hpp"
 
 #include <array>        // array
-#include <charconv>     // from_chars
+#include <bit>          // bit_cast
+#include <charconv>     // from_chars, from_chars_result
 #include <cstddef>      // size_t
-#include <cstdint>      // uint8_t
+#include <cstdint>      // uint8_t, uint32_t
 #include <cstring>      // strcmp
 #include <optional>     // optional
 #include <stdexcept>    // invalid_argument
@@ -13,11 +14,11 @@
 #include <string_view>  // string_view
 #include <utility>      // move
 
-#include <cppcodec/base64_default_rfc4648.hpp>
 #include <pugixml.hpp>
 
-#include "tactile/base/container/string.hpp"
+#include "tactile/base/io/base64.hpp"
 #include "tactile/base/io/compress/compression_format.hpp"
+#include "tactile/base/io/save/external_tileset_cache.hpp"
 #include "tactile/base/io/tile_io.hpp"
 #include "tactile/base/util/tile_matrix.hpp"
 #include "tactile/tiled_tmx/logging.hpp"
@@ -232,7 +233,7 @@ auto _read_embedded_tileset(const pugi::xml_node& tileset_node)
 }
 
 [[nodiscard]]
-auto _read_external_tileset(const std::filesystem::path& path)
+auto _parse_external_tileset(const std::filesystem::path& path)
     -> std::expected<ir::Tileset, ErrorCode>
 {
   ir::Tileset tileset {};
@@ -247,7 +248,19 @@ auto _read_external_tileset(const std::filesystem::path& path)
 }
 
 [[nodiscard]]
-auto _read_tileset_ref(const pugi::xml_node& tileset_ref_node,
+auto _read_external_tileset(const IRuntime& runtime, const std::filesystem::path& path)
+    -> std::expected<ir::Tileset, ErrorCode>
+{
+  if (auto* tileset_cache = runtime.get_external_tileset_cache()) {
+    return tileset_cache->get_tileset(path, &_parse_external_tileset);
+  }
+
+  return _parse_external_tileset(path);
+}
+
+[[nodiscard]]
+auto _read_tileset_ref(const IRuntime& runtime,
+                       const pugi::xml_node& tileset_ref_node,
                        const SaveFormatReadOptions& options)
     -> std::expected<ir::TilesetRef, ErrorCode>
 {
@@ -255,7 +268,7 @@ auto _read_tileset_ref(const pugi::xml_node& tileset_ref_node,
   return read_attr_to(tileset_ref_node, "firstgid", tileset_ref.first_tile_id)
       .and_then([&] {
         const auto source = read_attr<std::string>(tileset_ref_node, "source");
-        return source.has_value() ? _read_external_tileset(options.base_dir / *source)
+        return source.has_value() ? _read_external_tileset(runtime, options.base_dir / *source)
                                   : _read_embedded_tileset(tileset_ref_node);
       })
       .transform([&](ir::Tileset&& tileset) {
@@ -265,12 +278,13 @@ auto _read_tileset_ref(const pugi::xml_node& tileset_ref_node,
 }
 
 [[nodiscard]]
-auto _read_tilesets(const pugi::xml_node& map_node,
+auto _read_tilesets(const IRuntime& runtime,
+                    const pugi::xml_node& map_node,
                     const SaveFormatReadOptions& options,
                     ir::Map& map) -> std::expected<void, ErrorCode>
 {
   const auto tileset_ref_parser = [&](const pugi::xml_node& tileset_ref_node) {
-    return _read_tileset_ref(tileset_ref_node, options);
+    return _read_tileset_ref(runtime, tileset_ref_node, options);
   };
 
   return read_nodes<ir::TilesetRef>(map_node, "tileset", tileset_ref_parser)
@@ -303,65 +317,145 @@ auto _read_tile_layer_data_encoding(const pugi::xml_node& data_node)
 }
 
 [[nodiscard]]
-auto _read_tile_nodes_data(const pugi::xml_node& data_node, const Extent2D& extent)
+constexpr auto _is_csv_whitespace(const char ch) noexcept -> bool
+{
+  return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t';
+}
+
+[[nodiscard]]
+auto _skip_csv_whitespace(const char* pos, const char* end) noexcept -> const char*
+{
+  while (pos != end && _is_csv_whitespace(*pos)) {
+    ++pos;
+  }
+
+  return pos;
+}
+
+// Tiled writes GIDs as unsigned integers, where the highest bits are flip flags.
+[[nodiscard]]
+auto _parse_gid(const char* first, const char* last, TileID& tile_id) noexcept
+    -> std::from_chars_result
+{
+  std::uint32_t gid {};
+
+  const auto result = std::from_chars(first, last, gid);
+  if (result.ec == std::errc {}) {
+    tile_id = std::bit_cast<TileID>(gid);
+  }
+
+  return result;
+}
+
+}  // namespace
+
+// Tile data is written in row-major order directly into the matrix, without
+// intermediate containers or per-tile 2D index computations.
+auto read_tile_nodes_data(const pugi::xml_node& data_node, const Extent2D& extent)
     -> std::expected<TileMatrix, ErrorCode>
 {
   auto tile_matrix = make_tile_matrix(extent);
 
-  std::size_t index {0};
-  for (const auto& tile_node : data_node.children("tile")) {
-    const auto position = Index2D::from_1d(index, extent.cols);
+  const auto tile_count = extent.rows * extent.cols;
+  std::size_t tile_index {0};
+  std::size_t row {0};
+  std::size_t col {0};
 
-    const auto read_result =
-        read_attr_to(tile_node, "gid", tile_matrix[position.y][position.x]);
-    if (!read_result.has_value()) {
-      return std::unexpected {read_result.error()};
+  for (auto tile_node = data_node.first_child(); tile_node;
+       tile_node = tile_node.next_sibling()) {
+    if (std::strcmp(tile_node.name(), "tile") != 0) {
+      continue;
     }
 
-    ++index;
+    if (tile_index >= tile_count) {
+      TACTILE_TILED_TMX_ERROR("Too many tile nodes in tile layer data");
+      return std::unexpected {ErrorCode::kParseError};
+    }
+
+    // Empty tiles are written as tile nodes without a GID attribute.
+    if (const auto gid_attribute = tile_node.attribute("gid")) {
+      const std::string_view gid {gid_attribute.value()};
+
+      auto& tile_id = tile_matrix[row][col];
+      const auto [ptr, ec] = _parse_gid(gid.data(), gid.data() + gid.size(), tile_id);
+
+      if (ec != std::errc {} || ptr != gid.data() + gid.size()) {
+        TACTILE_TILED_TMX_ERROR("Invalid tile GID '{}'", gid);
+        return std::unexpected {ErrorCode::kParseError};
+      }
+    }
+
+    ++tile_index;
+    if (++col == extent.cols) {
+      col = 0;
+      ++row;
+    }
   }
 
   return tile_matrix;
 }
 
-[[nodiscard]]
-auto _read_csv_tile_data(const pugi::xml_node& data_node, const Extent2D& extent)
+// A single pass over the text, rows are just treated as whitespace.
+auto read_csv_tile_data(const pugi::xml_node& data_node, const Extent2D& extent)
     -> std::expected<TileMatrix, ErrorCode>
 {
-  const auto data_node_text = data_node.text();
+  const std::string_view csv {data_node.text().get()};
 
   auto tile_matrix = make_tile_matrix(extent);
-  std::size_t tile_index {};
 
-  const auto split_ok =
-      visit_tokens(data_node_text.get(), '\n', [&](const std::string_view csv_row) {
-        return visit_tokens(csv_row, ',', [&](const std::string_view token) {
-          TileID tile_id {};
+  const auto tile_count = extent.rows * extent.cols;
+  std::size_t tile_index {0};
+  std::size_t row {0};
+  std::size_t col {0};
 
-          const auto parse_tile_id_result =
-              std::from_chars(token.data(), token.data() + token.size(), tile_id);
-          if (parse_tile_id_result.ec != std::errc {}) {
-            return false;
-          }
+  const auto* pos = csv.data();
+  const auto* end = csv.data() + csv.size();
 
-          const auto position = Index2D::from_1d(tile_index, extent.cols);
-          tile_matrix[position.y][position.x] = tile_id;
+  while (true) {
+    pos = _skip_csv_whitespace(pos, end);
+    if (pos == end) {
+      break;
+    }
 
-          ++tile_index;
-          return true;
-        });
-      });
+    if (tile_index >= tile_count) {
+      TACTILE_TILED_TMX_ERROR("Too many tiles in CSV tile data");
+      return std::unexpected {ErrorCode::kParseError};
+    }
 
-  if (!split_ok) {
-    TACTILE_TILED_TMX_ERROR("Could not parse CSV tile data");
-    return std::unexpected {ErrorCode::kParseError};
+    const auto [ptr, ec] = _parse_gid(pos, end, tile_matrix[row][col]);
+    if (ec != std::errc {}) {
+      TACTILE_TILED_TMX_ERROR("Could not parse CSV tile data");
+      return std::unexpected {ErrorCode::kParseError};
+    }
+
+    ++tile_index;
+    if (++col == extent.cols) {
+      col = 0;
+      ++row;
+    }
+
+    // Rows usually end with a trailing comma, except for the last one.
+    pos = _skip_csv_whitespace(ptr, end);
+    if (pos == end) {
+      break;
+    }
+
+    if (*pos != ',') {
+      TACTILE_TILED_TMX_ERROR("Could not parse CSV tile data");
+      return std::unexpected {ErrorCode::kParseError};
+    }
+
+    ++pos;
   }
 
   return tile_matrix;
 }
 
+namespace {
+
 [[nodiscard]]
 auto _read_base64_tile_data(const IRuntime& runtime,
+                            const SaveFormatReadOptions& options,
                             const pugi::xml_node& data_node,
                             const Extent2D& extent,
                             ir::TileFormat& tile_format)
@@ -380,7 +474,11 @@ auto _read_base64_tile_data(const IRuntime& runtime,
   const auto data_node_text = data_node.text();
   const std::string_view encoded_tile_data {data_node_text.get()};
 
-  auto decoded_tile_data = base64::decode(encoded_tile_data);
+  auto decoded_tile_data = base64_decode(encoded_tile_data);
+  if (!decoded_tile_data.has_value()) {
+    TACTILE_TILED_TMX_ERROR("Could not decode Base64 tile data");
+    return std::unexpected {ErrorCode::kParseError};
+  }
 
   ByteStream raw_tile_matrix {};
   if (tile_format.compression.has_value()) {
@@ -391,7 +489,12 @@ auto _read_base64_tile_data(const IRuntime& runtime,
       return std::unexpected {ErrorCode::kNotSupported};
     }
 
-    const auto decompressed_tile_data = compression_format->decompress(decoded_tile_data);
+    const DecompressionOptions decompression_options {
+      .dictionary = options.compression_dictionary,
+    };
+
+    const auto decompressed_tile_data =
+        compression_format->decompress(*decoded_tile_data, decompression_options);
     if (!decompressed_tile_data.has_value()) {
       return std::unexpected {decompressed_tile_data.error()};
     }
@@ -399,7 +502,7 @@ auto _read_base64_tile_data(const IRuntime& runtime,
     raw_tile_matrix = std::move(*decompressed_tile_data);
   }
   else {
-    raw_tile_matrix = std::move(decoded_tile_data);
+    raw_tile_matrix = std::move(*decoded_tile_data);
   }
 
   auto tile_matrix = parse_raw_tile_matrix(raw_tile_matrix, extent, TileIdFormat::kTiled);
@@ -412,6 +515,7 @@ auto _read_base64_tile_data(const IRuntime& runtime,
 
 [[nodiscard]]
 auto _read_tile_layer_data(const IRuntime& runtime,
+                           const SaveFormatReadOptions& options,
                            const pugi::xml_node& data_node,
                            ir::Layer& layer,
                            ir::TileFormat& tile_format) -> std::expected<void, ErrorCode>
@@ -423,13 +527,17 @@ auto _read_tile_layer_data(const IRuntime& runtime,
       .and_then([&](const TmxTileEncoding encoding) {
         switch (encoding) {
           case TmxTileEncoding::kTileNodes: {
-            return _read_tile_nodes_data(data_node, layer.extent);
+            return read_tile_nodes_data(data_node, layer.extent);
           }
           case TmxTileEncoding::kCsv: {
-            return _read_csv_tile_data(data_node, layer.extent);
+            return read_csv_tile_data(data_node, layer.extent);
           }
           case TmxTileEncoding::kBase64: {
-            return _read_base64_tile_data(runtime, data_node, layer.extent, tile_format);
+            return _read_base64_tile_data(runtime,
+                                          options,
+                                          data_node,
+                                          layer.extent,
+                                          tile_format);
           }
           default: throw std::invalid_argument {"bad tile encoding"};
         }
@@ -442,6 +550,7 @@ auto _read_tile_layer_data(const IRuntime& runtime,
 
 [[nodiscard]]
 auto _read_tile_layer(const IRuntime& runtime,
+                      const SaveFormatReadOptions& options,
                       const pugi::xml_node& layer_node,
                       ir::Layer& layer,
                       ir::TileFormat& tile_format) -> std::expected<void, ErrorCode>
@@ -450,7 +559,7 @@ auto _read_tile_layer(const IRuntime& runtime,
       .and_then([&] { return read_attr_to(layer_node, "height", layer.extent.rows); })
       .and_then([&] {
         const auto data_node = layer_node.child("data");
-        return _read_tile_layer_data(runtime, data_node, layer, tile_format);
+        return _read_tile_layer_data(runtime, options, data_node, layer, tile_format);
       });
 }
 
@@ -495,21 +604,24 @@ auto _read_object_layer(const pugi::xml_node& layer_node, std::vector<ir::Object
 
 [[nodiscard]]
 auto _read_layers(const IRuntime& runtime,
+                  const SaveFormatReadOptions& options,
                   const pugi::xml_node& root_node,
                   std::vector<ir::Layer>& layers,
                   ir::TileFormat& tile_format) -> std::expected<void, ErrorCode>;
 
 [[nodiscard]]
 auto _read_group_layer(const IRuntime& runtime,
+                       const SaveFormatReadOptions& options,
                        const pugi::xml_node& layer_node,
                        ir::Layer& layer,
                        ir::TileFormat& tile_format) -> std::expected<void, ErrorCode>
 {
-  return _read_layers(runtime, layer_node, layer.layers, tile_format);
+  return _read_layers(runtime, options, layer_node, layer.layers, tile_format);
 }
 
 [[nodiscard]]
 auto _read_layer(const IRuntime& runtime,
+                 const SaveFormatReadOptions& options,
                  const pugi::xml_node& layer_node,
                  ir::TileFormat& tile_format) -> std::expected<ir::Layer, ErrorCode>
 {
@@ -530,13 +642,13 @@ auto _read_layer(const IRuntime& runtime,
         layer.type = type;
         switch (type) {
           case LayerType::kTileLayer: {
-            return _read_tile_layer(runtime, layer_node, layer, tile_format);
+            return _read_tile_layer(runtime, options, layer_node, layer, tile_format);
           }
           case LayerType::kObjectLayer: {
             return _read_object_layer(layer_node, layer.objects);
           }
           case LayerType::kGroupLayer: {
-            return _read_group_layer(runtime, layer_node, layer, tile_format);
+            return _read_group_layer(runtime, options, layer_node, layer, tile_format);
           }
           default: throw std::invalid_argument {"bad layer type"};
         }
@@ -547,6 +659,7 @@ auto _read_layer(const IRuntime& runtime,
 
 [[nodiscard]]
 auto _read_layers(const IRuntime& runtime,
+                  const SaveFormatReadOptions& options,
                   const pugi::xml_node& root_node,
                   std::vector<ir::Layer>& layers,
                   ir::TileFormat& tile_format) -> std::expected<void, ErrorCode>
@@ -556,7 +669,7 @@ auto _read_layers(const IRuntime& runtime,
 
   const auto layer_parser =
       [&](const pugi::xml_node& layer_node) -> std::expected<ir::Layer, ErrorCode> {
-    return _read_layer(runtime, layer_node, tile_format);
+    return _read_layer(runtime, options, layer_node, tile_format);
   };
 
   return read_nodes<ir::Layer>(root_node, layer_node_names, layer_parser)
@@ -591,8 +704,10 @@ auto _read_map(std::string map_name,
       .and_then([&] { return read_attr_to(map_node, "height", map.extent.rows); })
       .and_then([&] { return read_attr_to(map_node, "nextlayerid", map.next_layer_id); })
       .and_then([&] { return read_attr_to(map_node, "nextobjectid", map.next_object_id); })
-      .and_then([&] { return _read_tilesets(map_node, options, map); })
-      .and_then([&] { return _read_layers(runtime, map_node, map.layers, map.tile_format); })
+      .and_then([&] { return _read_tilesets(runtime, map_node, options, map); })
+      .and_then([&] {
+        return _read_layers(runtime, options, map_node, map.layers, map.tile_format);
+      })
       .and_then([&] { return _read_metadata(map_node, map.meta); })
       .transform([&] { return std::move(map); });
 }
@@ -2,14 +2,16 @@
 
 #include "tactile/tiled_tmx/tmx_format_save_visitor.hpp"
 
+#include <bit>         // bit_cast
+#include <cstdint>     // uint32_t
 #include <filesystem>  // relative
 #include <format>      // format
-#include <sstream>     // stringstream
+#include <ios>         // ios
+#include <span>        // span
 #include <stdexcept>   // invalid_argument
+#include <thread>      // thread
 #include <utility>     // move
 
-#include <cppcodec/base64_default_rfc4648.hpp>
-
 #include "tactile/base/document/layer_view.hpp"
 #include "tactile/base/document/map_view.hpp"
 #include "tactile/base/document/meta_view.hpp"
@@ -24,198 +26,119 @@
 namespace tactile::tiled_tmx {
 namespace {
 
-void _append_property_attr(pugi::xml_node node, const Attribute& property)
+void _append_property_attr(TmxXmlWriter& writer, const Attribute& property)
 {
-  auto value_attribute = node.append_attribute("value");
-
   switch (property.get_type()) {
     case AttributeType::kStr: {
-      value_attribute.set_value(property.as_string().c_str());
+      writer.attribute("value", property.as_string());
       break;
     }
     case AttributeType::kInt: {
-      value_attribute.set_value(property.as_int());
+      writer.attribute("value", property.as_int());
       break;
     }
     case AttributeType::kInt2: {
       const auto& i2 = property.as_int2();
-
-      const auto str = std::format("{};{}", i2.x(), i2.y());
-      value_attribute.set_value(str.c_str());
-
+      writer.attribute("value", std::format("{};{}", i2.x(), i2.y()));
       break;
     }
     case AttributeType::kInt3: {
       const auto& i3 = property.as_int3();
-
-      const auto str = std::format("{};{};{}", i3.x(), i3.y(), i3.z());
-      value_attribute.set_value(str.c_str());
-
+      writer.attribute("value", std::format("{};{};{}", i3.x(), i3.y(), i3.z()));
       break;
     }
     case AttributeType::kInt4: {
       const auto& i4 = property.as_int4();
-
-      const auto str = std::format("{};{};{};{}", i4.x(), i4.y(), i4.z(), i4.w());
-      value_attribute.set_value(str.c_str());
-
+      writer.attribute("value",
+                       std::format("{};{};{};{}", i4.x(), i4.y(), i4.z(), i4.w()));
       break;
     }
     case AttributeType::kFloat: {
-      value_attribute.set_value(property.as_float());
+      writer.attribute("value", property.as_float());
       break;
     }
     case AttributeType::kFloat2: {
       const auto& f2 = property.as_float2();
-
-      const auto str = std::format("{};{}", f2.x(), f2.y());
-      value_attribute.set_value(str.c_str());
-
+      writer.attribute("value", std::format("{};{}", f2.x(), f2.y()));
       break;
     }
     case AttributeType::kFloat3: {
       const auto& f3 = property.as_float3();
-
-      const auto str = std::format("{};{};{}", f3.x(), f3.y(), f3.z());
-      value_attribute.set_value(str.c_str());
-
+      writer.attribute("value", std::format("{};{};{}", f3.x(), f3.y(), f3.z()));
       break;
     }
     case AttributeType::kFloat4: {
       const auto& f4 = property.as_float4();
-
-      const auto str = std::format("{};{};{};{}", f4.x(), f4.y(), f4.z(), f4.w());
-      value_attribute.set_value(str.c_str());
-
+      writer.attribute("value",
+                       std::format("{};{};{};{}", f4.x(), f4.y(), f4.z(), f4.w()));
       break;
     }
     case AttributeType::kBool: {
-      value_attribute.set_value(property.as_bool());
+      writer.attribute("value", property.as_bool());
       break;
     }
     case AttributeType::kPath: {
-      const auto path_str = property.as_path().string();
-      value_attribute.set_value(path_str.c_str());
+      writer.attribute("value", property.as_path().string());
       break;
     }
     case AttributeType::kColor: {
-      const auto argb_str = to_string(property.as_color(), ColorFormat::kArgb);
-      value_attribute.set_value(argb_str.c_str());
+      writer.attribute("value", to_string(property.as_color(), ColorFormat::kArgb));
       break;
     }
     case AttributeType::kObject: {
-      value_attribute.set_value(property.as_object().value);
+      writer.attribute("value", property.as_object().value);
       break;
     }
     default: throw std::invalid_argument {"bad attribute type"};
   }
 }
 
-void _append_properties_node(pugi::xml_node node, const IMetaView& meta)
+void _append_properties_node(TmxXmlWriter& writer, const IMetaView& meta)
 {
   const auto count = meta.property_count();
   if (count < 1) {
     return;
   }
 
-  auto properties_node = node.append_child("properties");
+  writer.begin_element("properties");
 
   for (auto index = 0_uz; index < count; ++index) {
     const auto& [name, value] = meta.get_property(index);
 
-    auto property_node = properties_node.append_child("property");
-    property_node.append_attribute("name").set_value(name.c_str());
+    writer.begin_element("property");
+    writer.attribute("name", name);
 
     // Properties with no type attribute are assumed to be string properties
     const auto type = value.get_type();
     if (type != AttributeType::kStr && !value.is_vector()) {
-      const auto* prop_type_name = get_property_type_name(type);
-      property_node.append_attribute("type").set_value(prop_type_name);
-    }
-
-    _append_property_attr(property_node, value);
-  }
-}
-
-void _add_csv_tile_data(pugi::xml_node node, const ILayerView& layer)
-{
-  node.append_attribute("encoding").set_value("csv");
-
-  std::stringstream stream {};
-
-  const auto extent = layer.get_extent().value();
-  for (auto row = 0_uz; row < extent.rows; ++row) {
-    for (auto col = 0_uz; col < extent.cols; ++col) {
-      const Index2D index {col, row};
-      const auto tile_id = layer.get_tile(index).value();
-
-      if (row != 0_uz || col != 0_uz) {
-        stream << ',';
-      }
-
-      stream << tile_id;
-    }
-  }
-
-  const auto csv_str = stream.str();
-  node.text().set(csv_str.c_str());
-}
-
-[[nodiscard]]
-auto _add_base64_tile_data(pugi::xml_node data_node,
-                           const IRuntime& runtime,
-                           const ILayerView& layer) -> std::expected<void, ErrorCode>
-{
-  data_node.append_attribute("encoding").set_value("base64");
-
-  ByteStream tile_bytes {};
-
-  const auto extent = layer.get_extent().value();
-  tile_bytes.reserve(sizeof(TileID) * extent.rows * extent.cols);
-
-  layer.write_tile_bytes(tile_bytes);
-
-  if (const auto compress_format_id = layer.get_tile_compression()) {
-    auto* compression_format = runtime.get_compression_format(*compress_format_id);
-
-    if (!compression_format) {
-      TACTILE_TILED_TMX_ERROR("No suitable compression plugin available");
-      return std::unexpected {ErrorCode::kNotSupported};
+      writer.attribute("type", get_property_type_name(type));
     }
 
-    if (auto compressed_tile_bytes = compression_format->compress(tile_bytes)) {
-      tile_bytes = std::move(*compressed_tile_bytes);
-    }
-    else {
-      TACTILE_TILED_TMX_ERROR("Could not compress tile data");
-      return std::unexpected {compressed_tile_bytes.error()};
-    }
-
-    const char* compress_format_name = get_compression_format_name(*compress_format_id);
-    data_node.append_attribute("compression").set_value(compress_format_name);
+    _append_property_attr(writer, value);
+    writer.end_element();
   }
 
-  const auto encoded_tile_bytes = base64::encode(tile_bytes);
-  data_node.text().set(encoded_tile_bytes.c_str());
-
-  return {};
+  writer.end_element();
 }
 
-void _append_animation_node(pugi::xml_node tile_node, const ITileView& tile)
+void _append_animation_node(TmxXmlWriter& writer, const ITileView& tile)
 {
-  auto animation_node = tile_node.append_child("animation");
+  writer.begin_element("animation");
 
   const auto frame_count = tile.animation_frame_count();
   for (auto frame_index = 0_uz; frame_index < frame_count; ++frame_index) {
     const auto& [frame_tile_index, frame_duration] = tile.get_animation_frame(frame_index);
 
-    auto frame_node = animation_node.append_child("frame");
-    frame_node.append_attribute("tileid").set_value(frame_tile_index);
-    frame_node.append_attribute("duration").set_value(frame_duration.count());
+    writer.begin_element("frame");
+    writer.attribute("tileid", frame_tile_index);
+    writer.attribute("duration", frame_duration.count());
+    writer.end_element();
   }
+
+  writer.end_element();
 }
 
-void _append_tileset_image_node(pugi::xml_node tileset_node,
+void _append_tileset_image_node(TmxXmlWriter& writer,
                                 const ITilesetView& tileset,
                                 const SaveFormatWriteOptions& options)
 {
@@ -224,38 +147,39 @@ void _append_tileset_image_node(pugi::xml_node tileset_node,
 
   const auto source = std::filesystem::relative(image_path, options.base_dir).string();
 
-  auto image_node = tileset_node.append_child("image");
-  image_node.append_attribute("source").set_value(source.c_str());
-  image_node.append_attribute("width").set_value(image_size.x());
-  image_node.append_attribute("height").set_value(image_size.y());
+  writer.begin_element("image");
+  writer.attribute("source", source);
+  writer.attribute("width", image_size.x());
+  writer.attribute("height", image_size.y());
+  writer.end_element();
 }
 
-void _add_common_tileset_data(pugi::xml_node tileset_node,
+// Note, the tileset element is left open, since tile definitions are visited later.
+void _add_common_tileset_data(TmxXmlWriter& writer,
                               const ITilesetView& tileset,
                               const SaveFormatWriteOptions& options)
 {
   const auto& meta = tileset.get_meta();
   const auto tile_size = tileset.get_tile_size();
 
-  tileset_node.append_attribute("name").set_value(meta.get_name().data());  // FIXME c_str
-  tileset_node.append_attribute("tilewidth").set_value(tile_size.x());
-  tileset_node.append_attribute("tileheight").set_value(tile_size.y());
-  tileset_node.append_attribute("tilecount").set_value(tileset.tile_count());
-  tileset_node.append_attribute("columns").set_value(tileset.column_count());
+  writer.attribute("name", meta.get_name());
+  writer.attribute("tilewidth", tile_size.x());
+  writer.attribute("tileheight", tile_size.y());
+  writer.attribute("tilecount", tileset.tile_count());
+  writer.attribute("columns", tileset.column_count());
 
-  _append_tileset_image_node(tileset_node, tileset, options);
-  _append_properties_node(tileset_node, meta);
+  _append_tileset_image_node(writer, tileset, options);
+  _append_properties_node(writer, meta);
 }
 
 }  // namespace
 
-TmxFormatSaveVisitor::TmxFormatSaveVisitor(IRuntime* runtime, SaveFormatWriteOptions options)
+TmxFormatSaveVisitor::TmxFormatSaveVisitor(IRuntime* runtime,
+                                           SaveFormatWriteOptions options,
+                                           std::ostream& map_stream)
   : m_runtime {runtime},
     m_options {std::move(options)},
-    m_map_document {},
-    m_map_node {},
-    m_layer_nodes {},
-    m_tileset_documents {}
+    m_map_writer {map_stream, m_options.use_indentation ? 2 : 0}
 {}
 
 auto TmxFormatSaveVisitor::visit(const IComponentView& component)
@@ -266,113 +190,110 @@ auto TmxFormatSaveVisitor::visit(const IComponentView& component)
 
 auto TmxFormatSaveVisitor::visit(const IMapView& map) -> std::expected<void, ErrorCode>
 {
-  const auto layer_count = map.layer_count();
-  m_layer_nodes.resize(layer_count);
-
-  if (m_options.use_external_tilesets) {
-    const auto tileset_count = map.tileset_count();
-    m_tileset_documents.reserve(tileset_count);
-  }
-
-  m_map_node = m_map_document.append_child("map");
-
   const auto extent = map.get_extent();
   const auto tile_size = map.get_tile_size();
-  m_map_node.append_attribute("version").set_value("1.7");
-  m_map_node.append_attribute("tiledversion").set_value("1.9.0");
-  m_map_node.append_attribute("orientation").set_value("orthogonal");
-  m_map_node.append_attribute("renderorder").set_value("right-down");
-  m_map_node.append_attribute("infinite").set_value(false);
-  m_map_node.append_attribute("tilewidth").set_value(tile_size.x());
-  m_map_node.append_attribute("tileheight").set_value(tile_size.y());
-  m_map_node.append_attribute("width").set_value(extent.cols);
-  m_map_node.append_attribute("height").set_value(extent.rows);
-  m_map_node.append_attribute("nextlayerid").set_value(map.get_next_layer_id());
-  m_map_node.append_attribute("nextobjectid").set_value(map.get_next_object_id());
-
-  _append_properties_node(m_map_node, map.get_meta());
+
+  m_map_writer.declaration();
+  m_map_writer.begin_element("map");
+  m_map_writer.attribute("version", "1.7");
+  m_map_writer.attribute("tiledversion", "1.9.0");
+  m_map_writer.attribute("orientation", "orthogonal");
+  m_map_writer.attribute("renderorder", "right-down");
+  m_map_writer.attribute("infinite", false);
+  m_map_writer.attribute("tilewidth", tile_size.x());
+  m_map_writer.attribute("tileheight", tile_size.y());
+  m_map_writer.attribute("width", extent.cols);
+  m_map_writer.attribute("height", extent.rows);
+  m_map_writer.attribute("nextlayerid", map.get_next_layer_id());
+  m_map_writer.attribute("nextobjectid", map.get_next_object_id());
+
+  _append_properties_node(m_map_writer, map.get_meta());
 
   return {};
 }
 
 auto TmxFormatSaveVisitor::visit(const ILayerView& layer) -> std::expected<void, ErrorCode>
 {
-  const auto layer_type = layer.get_type();
-  const char* node_name = get_layer_type_name(layer_type);
+  if (!m_visited_layers) {
+    if (const auto close_result = _close_open_tileset(); !close_result.has_value()) {
+      return close_result;
+    }
 
-  pugi::xml_node layer_node {};
-  if (const auto* parent_layer = layer.get_parent_layer()) {
-    auto parent_node = m_layer_nodes.at(parent_layer->get_global_index());
-    layer_node = parent_node.append_child(node_name);
+    m_visited_layers = true;
   }
-  else {
-    layer_node = m_map_node.append_child(node_name);
+
+  if (const auto close_result = _close_open_layers(layer.get_parent_layer());
+      !close_result.has_value()) {
+    return close_result;
   }
 
+  const auto layer_type = layer.get_type();
   const auto& meta = layer.get_meta();
-  layer_node.append_attribute("id").set_value(layer.get_id());
-  layer_node.append_attribute("name").set_value(meta.get_name().data());
+
+  m_map_writer.begin_element(get_layer_type_name(layer_type));
+  m_map_writer.attribute("id", layer.get_id());
+  m_map_writer.attribute("name", meta.get_name());
 
   if (const auto opacity = layer.get_opacity(); opacity != 1.0f) {
-    layer_node.append_attribute("opacity").set_value(opacity);
+    m_map_writer.attribute("opacity", opacity);
   }
 
   if (!layer.is_visible()) {
-    layer_node.append_attribute("visible").set_value(false);
+    m_map_writer.attribute("visible", false);
   }
 
   switch (layer_type) {
     case LayerType::kTileLayer: {
       const auto extent = layer.get_extent().value();
-      const auto tile_encoding = layer.get_tile_encoding();
 
-      layer_node.append_attribute("width").set_value(extent.cols);
-      layer_node.append_attribute("height").set_value(extent.rows);
+      m_map_writer.attribute("width", extent.cols);
+      m_map_writer.attribute("height", extent.rows);
 
-      const auto data_node = layer_node.append_child("data");
-      switch (tile_encoding) {
-        case TileEncoding::kPlainText: {
-          _add_csv_tile_data(data_node, layer);
-          break;
-        }
-        case TileEncoding::kBase64: {
-          const auto add_base64_tile_data_result =
-              _add_base64_tile_data(data_node, *m_runtime, layer);
-
-          if (!add_base64_tile_data_result.has_value()) {
-            return std::unexpected {add_base64_tile_data_result.error()};
-          }
+      _append_properties_node(m_map_writer, meta);
 
-          break;
-        }
-        default: throw std::invalid_argument {"bad tile encoding"};
+      const auto emit_tile_data_result = _emit_tile_data(layer);
+      if (!emit_tile_data_result.has_value()) {
+        return std::unexpected {emit_tile_data_result.error()};
       }
 
+      m_map_writer.end_element();
+      break;
+    }
+    case LayerType::kObjectLayer:
+    case LayerType::kGroupLayer: {
+      // The element is closed once the objects or sublayers have been visited.
+      _append_properties_node(m_map_writer, meta);
+      m_open_layers.push_back(layer.get_id());
       break;
     }
-    case LayerType::kObjectLayer: /* Do nothing */ break;
-    case LayerType::kGroupLayer:  /* Do nothing */ break;
-    default:                      throw std::invalid_argument {"bad layer type"};
+    default: throw std::invalid_argument {"bad layer type"};
   }
 
-  _append_properties_node(layer_node, layer.get_meta());
-
-  const auto layer_index = layer.get_global_index();
-  m_layer_nodes.at(layer_index) = std::move(layer_node);
-
   return {};
 }
 
 auto TmxFormatSaveVisitor::visit(const IObjectView& object) -> std::expected<void, ErrorCode>
 {
-  pugi::xml_node parent_node {};
+  TmxXmlWriter* writer {};
+
   if (const auto* parent_layer = object.get_parent_layer()) {
-    parent_node = m_layer_nodes.at(parent_layer->get_global_index());
+    if (m_open_layers.empty() || m_open_layers.back() != parent_layer->get_id()) {
+      TACTILE_TILED_TMX_ERROR("Object {} visited outside of its layer", object.get_id());
+      return std::unexpected {ErrorCode::kBadState};
+    }
+
+    writer = &m_map_writer;
   }
   else if (const auto* parent_tile = object.get_parent_tile()) {
-    const auto tile_node =
-        _get_tile_node(parent_tile->get_parent_tileset(), parent_tile->get_index());
-    parent_node = tile_node.child("objectgroup");
+    const auto& parent_tileset = parent_tile->get_parent_tileset();
+
+    if (m_open_tileset != parent_tileset.get_first_tile_id() ||
+        m_open_tile != parent_tile->get_index()) {
+      TACTILE_TILED_TMX_ERROR("Object {} visited outside of its tile", object.get_id());
+      return std::unexpected {ErrorCode::kBadState};
+    }
+
+    writer = &_get_tileset_writer();
   }
   else {
     return std::unexpected {ErrorCode::kBadState};
@@ -384,127 +305,292 @@ auto TmxFormatSaveVisitor::visit(const IObjectView& object) -> std::expected<voi
   const auto size = object.get_size();
   const auto type = object.get_type();
 
-  auto object_node = parent_node.append_child("object");
-  object_node.append_attribute("id").set_value(object.get_id());
+  writer->begin_element("object");
+  writer->attribute("id", object.get_id());
 
   if (const auto name = meta.get_name(); !name.empty()) {
-    object_node.append_attribute("name").set_value(name.data());  // FIXME c_str
+    writer->attribute("name", name);
   }
 
   if (const auto tag = object.get_tag(); !tag.empty()) {
-    object_node.append_attribute("type").set_value(tag.data());  // FIXME c_str
+    writer->attribute("type", tag);
   }
 
   if (position.x() != 0.0f) {
-    object_node.append_attribute("x").set_value(position.x());
+    writer->attribute("x", position.x());
   }
 
   if (position.y() != 0.0f) {
-    object_node.append_attribute("y").set_value(position.y());
+    writer->attribute("y", position.y());
   }
 
   if (size.x() != 0.0f) {
-    object_node.append_attribute("width").set_value(size.x());
+    writer->attribute("width", size.x());
   }
 
   if (size.y() != 0.0f) {
-    object_node.append_attribute("height").set_value(size.y());
+    writer->attribute("height", size.y());
   }
 
   if (!object.is_visible()) {
-    object_node.append_attribute("visible").set_value(false);
+    writer->attribute("visible", false);
   }
 
+  _append_properties_node(*writer, meta);
+
   // Objects are rectangles if no type tag is present
   if (type == ObjectType::kPoint) {
-    object_node.append_child("point");
+    writer->begin_element("point");
+    writer->end_element();
   }
   else if (type == ObjectType::kEllipse) {
-    object_node.append_child("ellipse");
+    writer->begin_element("ellipse");
+    writer->end_element();
   }
 
-  _append_properties_node(object_node, meta);
+  writer->end_element();
 
   return {};
 }
 
 auto TmxFormatSaveVisitor::visit(const ITilesetView& tileset) -> std::expected<void, ErrorCode>
 {
+  if (m_visited_layers) {
+    TACTILE_TILED_TMX_ERROR("Tileset visited after layers");
+    return std::unexpected {ErrorCode::kBadState};
+  }
+
+  if (const auto close_result = _close_open_tileset(); !close_result.has_value()) {
+    return close_result;
+  }
+
   const auto first_tile_id = tileset.get_first_tile_id();
 
-  auto embedded_tileset_node = m_map_node.append_child("tileset");
-  embedded_tileset_node.append_attribute("firstgid").set_value(first_tile_id);
+  m_map_writer.begin_element("tileset");
+  m_map_writer.attribute("firstgid", first_tile_id);
 
   if (m_options.use_external_tilesets) {
-    auto source = std::format("{}.tsx", tileset.get_filename());
-    embedded_tileset_node.append_attribute("source").set_value(source.c_str());
+    const auto source = std::format("{}.tsx", tileset.get_filename());
+    const auto tileset_path = m_options.base_dir / source;
+
+    m_map_writer.attribute("source", source);
+    m_map_writer.end_element();
+
+    m_tileset_file.emplace(tileset_path);
+    m_tileset_stream.emplace(m_tileset_file->path(), std::ios::out | std::ios::trunc);
+    if (!m_tileset_stream->good()) {
+      TACTILE_TILED_TMX_ERROR("Could not open external tileset file: {}",
+                              tileset_path.string());
+      m_tileset_stream.reset();
+      m_tileset_file.reset();
+      return std::unexpected {ErrorCode::kBadFileStream};
+    }
 
-    auto& external_tileset_document = m_tileset_documents.emplace_back();
-    external_tileset_document.source = std::move(source);
+    m_tileset_writer.emplace(*m_tileset_stream, m_options.use_indentation ? 2 : 0);
+    m_tileset_writer->declaration();
+    m_tileset_writer->begin_element("tileset");
+  }
 
-    const auto external_tileset_node =
-        external_tileset_document.document.append_child("tileset");
-    _add_common_tileset_data(external_tileset_node, tileset, m_options);
+  _add_common_tileset_data(_get_tileset_writer(), tileset, m_options);
+  m_open_tileset = first_tile_id;
+
+  return {};
+}
 
-    m_tileset_nodes[first_tile_id] = external_tileset_node;
+auto TmxFormatSaveVisitor::visit(const ITileView& tile) -> std::expected<void, ErrorCode>
+{
+  if (m_open_tileset != tile.get_parent_tileset().get_first_tile_id()) {
+    TACTILE_TILED_TMX_ERROR("Tile {} visited outside of its tileset", tile.get_index());
+    return std::unexpected {ErrorCode::kBadState};
+  }
+
+  _close_open_tile();
+
+  auto& writer = _get_tileset_writer();
+
+  writer.begin_element("tile");
+  writer.attribute("id", tile.get_index());
+
+  _append_properties_node(writer, tile.get_meta());
+
+  if (tile.animation_frame_count() > 0) {
+    _append_animation_node(writer, tile);
+  }
+
+  if (tile.object_count() > 0) {
+    // The object group is closed once the tile objects have been visited.
+    writer.begin_element("objectgroup");
+    m_open_tile = tile.get_index();
   }
   else {
-    _add_common_tileset_data(embedded_tileset_node, tileset, m_options);
-    m_tileset_nodes[first_tile_id] = embedded_tileset_node;
+    writer.end_element();
   }
 
   return {};
 }
 
-auto TmxFormatSaveVisitor::visit(const ITileView& tile) -> std::expected<void, ErrorCode>
+auto TmxFormatSaveVisitor::finish() -> std::expected<void, ErrorCode>
 {
-  const auto& tileset = tile.get_parent_tileset();
-  auto tileset_node = m_tileset_nodes.at(tileset.get_first_tile_id());
+  return _close_open_tileset()
+      .and_then([this] { return _close_open_layers(nullptr); })
+      .and_then([this] {
+        m_map_writer.end_element();
+        return m_map_writer.flush();
+      })
+      .and_then([this] { return _commit_tileset_files(); });
+}
 
-  auto tile_node = tileset_node.append_child("tile");
-  tile_node.append_attribute("id").set_value(tile.get_index());
+auto TmxFormatSaveVisitor::_get_tileset_writer() -> TmxXmlWriter&
+{
+  return m_tileset_writer.has_value() ? *m_tileset_writer : m_map_writer;
+}
 
-  if (tile.animation_frame_count() > 0) {
-    _append_animation_node(tile_node, tile);
+void TmxFormatSaveVisitor::_close_open_tile()
+{
+  if (!m_open_tile.has_value()) {
+    return;
   }
 
-  if (tile.object_count() > 0) {
-    tile_node.append_child("objectgroup");
+  auto& writer = _get_tileset_writer();
+  writer.end_element();  // objectgroup
+  writer.end_element();  // tile
+
+  m_open_tile.reset();
+}
+
+auto TmxFormatSaveVisitor::_close_open_tileset() -> std::expected<void, ErrorCode>
+{
+  if (!m_open_tileset.has_value()) {
+    return {};
   }
 
-  _append_properties_node(tile_node, tile.get_meta());
+  _close_open_tile();
+
+  _get_tileset_writer().end_element();
+  m_open_tileset.reset();
+
+  if (m_tileset_writer.has_value()) {
+    const auto flush_result = m_tileset_writer->flush();
+
+    m_tileset_writer.reset();
+    m_tileset_stream.reset();
+
+    if (!flush_result.has_value()) {
+      TACTILE_TILED_TMX_ERROR("Could not save external tileset");
+      m_tileset_file.reset();
+      return flush_result;
+    }
+
+    m_written_tileset_files.push_back(std::move(*m_tileset_file));
+    m_tileset_file.reset();
+  }
 
   return {};
 }
 
-auto TmxFormatSaveVisitor::get_map_xml_document() const -> const pugi::xml_document&
+auto TmxFormatSaveVisitor::_commit_tileset_files() -> std::expected<void, ErrorCode>
 {
-  return m_map_document;
+  for (auto& tileset_file : m_written_tileset_files) {
+    if (const auto commit_result = tileset_file.commit(); !commit_result.has_value()) {
+      TACTILE_TILED_TMX_ERROR("Could not replace external tileset file: {}",
+                              tileset_file.target_path().string());
+      return commit_result;
+    }
+  }
+
+  m_written_tileset_files.clear();
+  return {};
 }
 
-auto TmxFormatSaveVisitor::get_tileset_xml_documents() const
-    -> const std::vector<TmxTilesetDocument>&
+auto TmxFormatSaveVisitor::_close_open_layers(const ILayerView* parent_layer)
+    -> std::expected<void, ErrorCode>
 {
-  return m_tileset_documents;
+  while (!m_open_layers.empty() &&
+         (parent_layer == nullptr || m_open_layers.back() != parent_layer->get_id())) {
+    m_map_writer.end_element();
+    m_open_layers.pop_back();
+  }
+
+  if (parent_layer != nullptr && m_open_layers.empty()) {
+    TACTILE_TILED_TMX_ERROR("Layer visited outside of its parent layer");
+    return std::unexpected {ErrorCode::kBadState};
+  }
+
+  return {};
 }
 
-auto TmxFormatSaveVisitor::_get_tile_node(const ITilesetView& tileset,
-                                          const TileIndex tile_index) -> pugi::xml_node
+auto TmxFormatSaveVisitor::_emit_tile_data(const ILayerView& layer)
+    -> std::expected<void, ErrorCode>
 {
-  const auto tileset_iter = m_tileset_nodes.find(tileset.get_first_tile_id());
+  const auto extent = layer.get_extent().value();
+
+  m_map_writer.begin_element("data");
+
+  switch (layer.get_tile_encoding()) {
+    case TileEncoding::kPlainText: {
+      m_map_writer.attribute("encoding", "csv");
+
+      // CSV tile data is emitted one row at a time, straight into the output buffer.
+      // Tiled GIDs are unsigned, the highest bits are flip flags.
+      m_tile_row_cache.resize(extent.cols);
+
+      for (auto row = 0_uz; row < extent.rows; ++row) {
+        for (auto col = 0_uz; col < extent.cols; ++col) {
+          const Index2D index {col, row};
+          m_tile_row_cache[col] = std::bit_cast<std::uint32_t>(layer.get_tile(index).value());
+        }
+
+        m_map_writer.csv_line(std::span<const std::uint32_t> {m_tile_row_cache});
+      }
+
+      break;
+    }
+    case TileEncoding::kBase64: {
+      m_map_writer.attribute("encoding", "base64");
+
+      m_tile_byte_cache.clear();
+      m_tile_byte_cache.reserve(sizeof(TileID) * extent.rows * extent.cols);
+      layer.write_tile_bytes(m_tile_byte_cache);
+
+      if (const auto compress_format_id = layer.get_tile_compression()) {
+        auto* compression_format = m_runtime->get_compression_format(*compress_format_id);
+
+        if (!compression_format) {
+          TACTILE_TILED_TMX_ERROR("No suitable compression plugin available");
+          return std::unexpected {ErrorCode::kNotSupported};
+        }
+
+        const auto compression_level =
+            m_options.compression_level.or_else([&] { return layer.get_compression_level(); });
+
+        const CompressionOptions compression_options {
+          .level = compression_level,
+          .thread_count = std::thread::hardware_concurrency(),
+          .dictionary = m_options.compression_dictionary,
+        };
+
+        auto compressed_tile_bytes =
+            compression_format->compress(m_tile_byte_cache, compression_options);
+        if (!compressed_tile_bytes.has_value()) {
+          TACTILE_TILED_TMX_ERROR("Could not compress tile data");
+          return std::unexpected {compressed_tile_bytes.error()};
+        }
 
-  if (tileset_iter != m_tileset_nodes.end()) {
-    const auto& tileset_node = tileset_iter->second;
+        m_tile_byte_cache = std::move(*compressed_tile_bytes);
 
-    for (const auto& tile_node : tileset_node.children("tile")) {
-      const auto id = tile_node.attribute("id").as_int(-1);
-      if (id == tile_index) {
-        return tile_node;
+        m_map_writer.attribute("compression",
+                               get_compression_format_name(*compress_format_id));
       }
+
+      m_map_writer.base64_text(m_tile_byte_cache);
+      break;
     }
+    default: throw std::invalid_argument {"bad tile encoding"};
   }
 
-  throw std::invalid_argument {"no such tile node"};
+  m_map_writer.end_element();
+
+  return {};
 }
 
 }  // namespace tactile::tiled_tmx
@@ -3,9 +3,12 @@
 #include "tactile/tiled_tmx/tmx_save_format.hpp"
 
 #include <exception>  // exception
+#include <fstream>    // ofstream
+#include <ios>        // ios
 
 #include "tactile/base/document/map_view.hpp"
 #include "tactile/base/document/meta_view.hpp"
+#include "tactile/base/io/temp_file.hpp"
 #include "tactile/tiled_tmx/logging.hpp"
 #include "tactile/tiled_tmx/tmx_common.hpp"
 #include "tactile/tiled_tmx/tmx_format_parser.hpp"
@@ -46,28 +49,25 @@ auto TmxSaveFormat::save_map(const IMapView& map, const SaveFormatWriteOptions&
       return std::unexpected {ErrorCode::kBadState};
     }
 
-    TmxFormatSaveVisitor saver {m_runtime, options};
-
-    return map.accept(saver).and_then([&]() -> std::expected<void, ErrorCode> {
-      const auto& map_document = saver.get_map_xml_document();
-      const auto& external_tileset_documents = saver.get_tileset_xml_documents();
-
-      auto write_result = save_xml_document(map_document, *map_path);
-      if (!write_result.has_value()) {
-        return write_result;
-      }
-
-      for (const auto& [relative_path, tileset_document] : external_tileset_documents) {
-        const auto tileset_path = options.base_dir / relative_path;
-        write_result = save_xml_document(tileset_document, tileset_path);
-
-        if (!write_result.has_value()) {
-          return write_result;
-        }
-      }
+    TempFile map_file {*map_path};
+    std::ofstream map_stream {map_file.path(), std::ios::out | std::ios::trunc};
+    if (!map_stream.good()) {
+      TACTILE_TILED_TMX_ERROR("Could not open map file: {}", map_path->string());
+      return std::unexpected {ErrorCode::kBadFileStream};
+    }
 
-      return {};
-    });
+    TmxFormatSaveVisitor saver {m_runtime, options, map_stream};
+    return map.accept(saver)
+        .and_then([&] { return saver.finish(); })
+        .and_then([&]() -> std::expected<void, ErrorCode> {
+          map_stream.close();
+          if (map_stream.fail()) {
+            TACTILE_TILED_TMX_ERROR("Could not write map file: {}", map_path->string());
+            return std::unexpected {ErrorCode::kWriteError};
+          }
+
+          return map_file.commit();
+        });
   }
   catch (const std::exception& error) {
     TACTILE_TILED_TMX_ERROR("An unexpected error occurred during TMX map emission: {}",
@@ -0,0 +1,206 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/tiled_tmx/tmx_xml_writer.hpp"
+
+#include "tactile/base/io/base64.hpp"
+
+namespace tactile::tiled_tmx {
+namespace {
+
+[[nodiscard]]
+constexpr auto _needs_escaping(const char ch, const bool is_attribute) noexcept -> bool
+{
+  switch (ch) {
+    case '&':
+    case '<':
+    case '>':  return true;
+    case '"':
+    case '\t':
+    case '\n':
+    case '\r': return is_attribute;
+    default:   return static_cast<unsigned char>(ch) < 0x20;
+  }
+}
+
+}  // namespace
+
+TmxXmlWriter::TmxXmlWriter(std::ostream& stream, const int indentation)
+  : m_stream {&stream},
+    m_indentation {indentation}
+{
+  m_buffer.reserve(kFlushThreshold);
+}
+
+void TmxXmlWriter::declaration()
+{
+  m_buffer += R"(<?xml version="1.0" encoding="UTF-8"?>)";
+}
+
+void TmxXmlWriter::begin_element(const std::string_view name)
+{
+  _close_start_tag();
+
+  if (!m_elements.empty()) {
+    m_elements.back().has_children = true;
+  }
+
+  if (!m_elements.empty() || !m_buffer.empty()) {
+    _append_newline(m_elements.size());
+  }
+
+  m_buffer += '<';
+  m_buffer += name;
+
+  m_elements.push_back(Element {
+    .name = name,
+    .has_children = false,
+    .has_text = false,
+    .has_lines = false,
+  });
+  m_start_tag_is_open = true;
+}
+
+void TmxXmlWriter::end_element()
+{
+  const auto element = m_elements.back();
+  m_elements.pop_back();
+
+  if (m_start_tag_is_open) {
+    m_buffer += "/>";
+    m_start_tag_is_open = false;
+  }
+  else {
+    if (element.has_lines && m_indentation > 0) {
+      m_buffer += '\n';
+    }
+    else if (element.has_children && !element.has_text) {
+      _append_newline(m_elements.size());
+    }
+
+    m_buffer += "</";
+    m_buffer += element.name;
+    m_buffer += '>';
+  }
+
+  if (m_elements.empty() && m_indentation > 0) {
+    m_buffer += '\n';
+  }
+
+  _flush_if_needed();
+}
+
+void TmxXmlWriter::attribute(const std::string_view name, const std::string_view value)
+{
+  _begin_attribute(name);
+  _append_escaped(value, true);
+  m_buffer += '"';
+}
+
+void TmxXmlWriter::attribute(const std::string_view name, const char* value)
+{
+  attribute(name, std::string_view {value});
+}
+
+void TmxXmlWriter::attribute(const std::string_view name, const bool value)
+{
+  attribute(name, std::string_view {value ? "true" : "false"});
+}
+
+void TmxXmlWriter::text(const std::string_view str)
+{
+  _begin_text();
+  _append_escaped(str, false);
+  _flush_if_needed();
+}
+
+void TmxXmlWriter::base64_text(const ByteSpan bytes)
+{
+  _begin_text();
+  base64_encode(bytes, m_buffer);
+  _flush_if_needed();
+}
+
+auto TmxXmlWriter::flush() -> std::expected<void, ErrorCode>
+{
+  m_stream->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+  m_stream->flush();
+  m_buffer.clear();
+
+  if (!m_stream->good()) {
+    return std::unexpected {ErrorCode::kWriteError};
+  }
+
+  return {};
+}
+
+void TmxXmlWriter::_close_start_tag()
+{
+  if (m_start_tag_is_open) {
+    m_buffer += '>';
+    m_start_tag_is_open = false;
+  }
+}
+
+void TmxXmlWriter::_begin_attribute(const std::string_view name)
+{
+  m_buffer += ' ';
+  m_buffer += name;
+  m_buffer += "=\"";
+}
+
+auto TmxXmlWriter::_begin_text() -> Element&
+{
+  _close_start_tag();
+
+  auto& element = m_elements.back();
+  element.has_text = true;
+
+  return element;
+}
+
+void TmxXmlWriter::_append_newline(const std::size_t depth)
+{
+  if (m_indentation > 0) {
+    m_buffer += '\n';
+    m_buffer.append(depth * static_cast<std::size_t>(m_indentation), ' ');
+  }
+}
+
+void TmxXmlWriter::_append_escaped(const std::string_view str, const bool is_attribute)
+{
+  std::size_t run_begin = 0;
+  for (std::size_t index = 0; index < str.size(); ++index) {
+    const auto ch = str[index];
+    if (!_needs_escaping(ch, is_attribute)) {
+      continue;
+    }
+
+    m_buffer.append(str.substr(run_begin, index - run_begin));
+    run_begin = index + 1;
+
+    switch (ch) {
+      case '&': m_buffer += "&amp;"; break;
+      case '<': m_buffer += "&lt;"; break;
+      case '>': m_buffer += "&gt;"; break;
+      case '"': m_buffer += "&quot;"; break;
+      case '\t': m_buffer += "&#9;"; break;
+      case '\n': m_buffer += "&#10;"; break;
+      case '\r': m_buffer += "&#13;"; break;
+
+      // Other control characters can't be represented in XML 1.0, so they're dropped.
+      default: break;
+    }
+  }
+
+  m_buffer.append(str.substr(run_begin));
+}
+
+void TmxXmlWriter::_flush_if_needed()
+{
+  if (m_buffer.size() >= kFlushThreshold) {
+    m_stream->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    m_buffer.clear();
+  }
+}
+
+}  // namespace tactile::tiled_tmx
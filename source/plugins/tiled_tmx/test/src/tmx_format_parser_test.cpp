@@ -0,0 +1,175 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/tiled_tmx/tmx_format_parser.hpp"
+
+#include <expected>     // expected
+#include <string_view>  // string_view
+
+#include <gtest/gtest.h>
+#include <pugixml.hpp>
+
+namespace tactile::tiled_tmx {
+namespace {
+
+inline constexpr Extent2D kExtent {.rows = 2, .cols = 3};
+
+[[nodiscard]]
+auto _parse_data_node(pugi::xml_document& document, const std::string_view xml)
+    -> pugi::xml_node
+{
+  const auto result = document.load_buffer(xml.data(), xml.size());
+  EXPECT_TRUE(result);
+  return document.child("data");
+}
+
+// tactile::tiled_tmx::read_csv_tile_data
+TEST(TmxFormatParser, ReadCsvTileData)
+{
+  pugi::xml_document document {};
+  const auto data_node = _parse_data_node(document, R"(<data encoding="csv">
+1,2,3,
+4,0,4294967295
+</data>)");
+
+  const auto tiles = read_csv_tile_data(data_node, kExtent);
+  ASSERT_TRUE(tiles.has_value());
+
+  EXPECT_EQ(*tiles, (TileMatrix {{1, 2, 3}, {4, 0, static_cast<TileID>(4294967295u)}}));
+}
+
+// tactile::tiled_tmx::read_csv_tile_data
+TEST(TmxFormatParser, ReadCsvTileDataWithTrailingComma)
+{
+  pugi::xml_document document {};
+  const auto data_node =
+      _parse_data_node(document, R"(<data encoding="csv">1,2,3,4,5,6,</data>)");
+
+  const auto tiles = read_csv_tile_data(data_node, kExtent);
+  ASSERT_TRUE(tiles.has_value());
+
+  EXPECT_EQ(*tiles, (TileMatrix {{1, 2, 3}, {4, 5, 6}}));
+}
+
+// tactile::tiled_tmx::read_csv_tile_data
+TEST(TmxFormatParser, ReadCsvTileDataWithMissingTiles)
+{
+  pugi::xml_document document {};
+  const auto data_node = _parse_data_node(document, R"(<data encoding="csv">1,2</data>)");
+
+  const auto tiles = read_csv_tile_data(data_node, kExtent);
+  ASSERT_TRUE(tiles.has_value());
+
+  EXPECT_EQ(*tiles, (TileMatrix {{1, 2, 0}, {0, 0, 0}}));
+}
+
+// tactile::tiled_tmx::read_csv_tile_data
+TEST(TmxFormatParser, ReadCsvTileDataWithTooManyTiles)
+{
+  pugi::xml_document document {};
+  const auto data_node =
+      _parse_data_node(document, R"(<data encoding="csv">1,2,3,4,5,6,7</data>)");
+
+  EXPECT_EQ(read_csv_tile_data(data_node, kExtent), std::unexpected {ErrorCode::kParseError});
+}
+
+// tactile::tiled_tmx::read_csv_tile_data
+TEST(TmxFormatParser, ReadInvalidCsvTileData)
+{
+  pugi::xml_document document {};
+
+  for (const auto* xml : {R"(<data encoding="csv">1,a,3</data>)",
+                          R"(<data encoding="csv">1 2,3</data>)",
+                          R"(<data encoding="csv">1,,2</data>)",
+                          R"(<data encoding="csv">-1</data>)"}) {
+    const auto data_node = _parse_data_node(document, xml);
+    EXPECT_EQ(read_csv_tile_data(data_node, kExtent),
+              std::unexpected {ErrorCode::kParseError})
+        << xml;
+  }
+}
+
+// tactile::tiled_tmx::read_tile_nodes_data
+TEST(TmxFormatParser, ReadTileNodesData)
+{
+  pugi::xml_document document {};
+  const auto data_node = _parse_data_node(document, R"(<data>
+  <tile gid="1"/>
+  <tile gid="2"/>
+  <tile gid="3"/>
+  <tile gid="4"/>
+  <tile gid="5"/>
+  <tile gid="6"/>
+</data>)");
+
+  const auto tiles = read_tile_nodes_data(data_node, kExtent);
+  ASSERT_TRUE(tiles.has_value());
+
+  EXPECT_EQ(*tiles, (TileMatrix {{1, 2, 3}, {4, 5, 6}}));
+}
+
+// tactile::tiled_tmx::read_tile_nodes_data
+TEST(TmxFormatParser, ReadTileNodesWithFlipFlags)
+{
+  pugi::xml_document document {};
+  const auto data_node = _parse_data_node(document, R"(<data>
+  <tile gid="2147483649"/>
+  <tile gid="1073741826"/>
+  <tile gid="4294967295"/>
+</data>)");
+
+  const auto tiles = read_tile_nodes_data(data_node, kExtent);
+  ASSERT_TRUE(tiles.has_value());
+
+  EXPECT_EQ(*tiles,
+            (TileMatrix {{static_cast<TileID>(0x8000'0001u), 0x4000'0002, -1}, {0, 0, 0}}));
+}
+
+// tactile::tiled_tmx::read_tile_nodes_data
+TEST(TmxFormatParser, ReadTileNodesWithoutGid)
+{
+  pugi::xml_document document {};
+  const auto data_node = _parse_data_node(document, R"(<data>
+  <tile/>
+  <tile gid="2"/>
+  <tile/>
+  <tile gid="4"/>
+</data>)");
+
+  const auto tiles = read_tile_nodes_data(data_node, kExtent);
+  ASSERT_TRUE(tiles.has_value());
+
+  // The last two tiles are missing, so they're also empty.
+  EXPECT_EQ(*tiles, (TileMatrix {{0, 2, 0}, {4, 0, 0}}));
+}
+
+// tactile::tiled_tmx::read_tile_nodes_data
+TEST(TmxFormatParser, ReadTileNodesWithTooManyTiles)
+{
+  pugi::xml_document document {};
+  const auto data_node = _parse_data_node(document, R"(<data>
+  <tile gid="1"/><tile gid="2"/><tile gid="3"/>
+  <tile gid="4"/><tile gid="5"/><tile gid="6"/>
+  <tile gid="7"/>
+</data>)");
+
+  EXPECT_EQ(read_tile_nodes_data(data_node, kExtent),
+            std::unexpected {ErrorCode::kParseError});
+}
+
+// tactile::tiled_tmx::read_tile_nodes_data
+TEST(TmxFormatParser, ReadTileNodesWithInvalidGid)
+{
+  pugi::xml_document document {};
+
+  for (const auto* xml : {R"(<data><tile gid="1x"/></data>)",
+                          R"(<data><tile gid="-1"/></data>)",
+                          R"(<data><tile gid="4294967296"/></data>)"}) {
+    const auto data_node = _parse_data_node(document, xml);
+    EXPECT_EQ(read_tile_nodes_data(data_node, kExtent),
+              std::unexpected {ErrorCode::kParseError})
+        << xml;
+  }
+}
+
+}  // namespace
+}  // namespace tactile::tiled_tmx
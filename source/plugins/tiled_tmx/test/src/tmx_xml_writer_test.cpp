@@ -0,0 +1,208 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/tiled_tmx/tmx_xml_writer.hpp"
+
+#include <array>        // array
+#include <cstddef>      // size_t
+#include <expected>     // unexpected
+#include <ios>          // ios
+#include <span>         // span
+#include <sstream>      // ostringstream
+#include <string>       // string
+#include <string_view>  // string_view
+
+#include <gtest/gtest.h>
+
+namespace tactile::tiled_tmx {
+namespace {
+
+// tactile::tiled_tmx::TmxXmlWriter::attribute
+TEST(TmxXmlWriter, EscapeAttributeValues)
+{
+  std::ostringstream stream {};
+  TmxXmlWriter writer {stream, 0};
+
+  writer.begin_element("a");
+  writer.attribute("b", "&<>\"\t\n\r'");
+  writer.end_element();
+
+  ASSERT_TRUE(writer.flush().has_value());
+  EXPECT_EQ(stream.str(), R"(<a b="&amp;&lt;&gt;&quot;&#9;&#10;&#13;'"/>)");
+}
+
+// tactile::tiled_tmx::TmxXmlWriter::text
+TEST(TmxXmlWriter, EscapeText)
+{
+  std::ostringstream stream {};
+  TmxXmlWriter writer {stream, 0};
+
+  writer.begin_element("a");
+  writer.text("&<>\"\t\n\r'");
+  writer.end_element();
+
+  ASSERT_TRUE(writer.flush().has_value());
+  EXPECT_EQ(stream.str(), "<a>&amp;&lt;&gt;\"\t\n\r'</a>");
+}
+
+// tactile::tiled_tmx::TmxXmlWriter::attribute
+// tactile::tiled_tmx::TmxXmlWriter::text
+TEST(TmxXmlWriter, DropForbiddenControlCharacters)
+{
+  std::ostringstream stream {};
+  TmxXmlWriter writer {stream, 0};
+
+  writer.begin_element("a");
+  writer.attribute("b", "\x01x\x1Fy\x7F");
+  writer.text(std::string_view {"\x00z\x08\x0B\x0Cw", 6});
+  writer.end_element();
+
+  ASSERT_TRUE(writer.flush().has_value());
+  EXPECT_EQ(stream.str(), "<a b=\"xy\x7F\">zw</a>");
+}
+
+// tactile::tiled_tmx::TmxXmlWriter::begin_element
+// tactile::tiled_tmx::TmxXmlWriter::end_element
+TEST(TmxXmlWriter, EmptyElements)
+{
+  std::ostringstream stream {};
+  TmxXmlWriter writer {stream, 0};
+
+  writer.begin_element("a");
+  writer.begin_element("b");
+  writer.end_element();
+  writer.begin_element("c");
+  writer.attribute("d", 42);
+  writer.attribute("e", true);
+  writer.end_element();
+  writer.begin_element("f");
+  writer.text("");
+  writer.end_element();
+  writer.end_element();
+
+  ASSERT_TRUE(writer.flush().has_value());
+  EXPECT_EQ(stream.str(), R"(<a><b/><c d="42" e="true"/><f></f></a>)");
+}
+
+// tactile::tiled_tmx::TmxXmlWriter::TmxXmlWriter
+TEST(TmxXmlWriter, CompactOutput)
+{
+  std::ostringstream stream {};
+  TmxXmlWriter writer {stream, 0};
+
+  writer.declaration();
+  writer.begin_element("map");
+  writer.attribute("version", "1.10");
+  writer.begin_element("layer");
+  writer.begin_element("data");
+  writer.text("x");
+  writer.end_element();
+  writer.end_element();
+  writer.begin_element("group");
+  writer.end_element();
+  writer.end_element();
+
+  ASSERT_TRUE(writer.flush().has_value());
+  EXPECT_EQ(stream.str(),
+            R"(<?xml version="1.0" encoding="UTF-8"?>)"
+            R"(<map version="1.10"><layer><data>x</data></layer><group/></map>)");
+}
+
+// tactile::tiled_tmx::TmxXmlWriter::TmxXmlWriter
+TEST(TmxXmlWriter, IndentedOutput)
+{
+  std::ostringstream stream {};
+  TmxXmlWriter writer {stream, 2};
+
+  writer.declaration();
+  writer.begin_element("map");
+  writer.attribute("version", "1.10");
+  writer.begin_element("layer");
+  writer.begin_element("data");
+  writer.text("x");
+  writer.end_element();
+  writer.end_element();
+  writer.begin_element("group");
+  writer.end_element();
+  writer.end_element();
+
+  ASSERT_TRUE(writer.flush().has_value());
+  EXPECT_EQ(stream.str(),
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<map version=\"1.10\">\n"
+            "  <layer>\n"
+            "    <data>x</data>\n"
+            "  </layer>\n"
+            "  <group/>\n"
+            "</map>\n");
+}
+
+// tactile::tiled_tmx::TmxXmlWriter::csv_line
+TEST(TmxXmlWriter, CsvLines)
+{
+  constexpr std::array<int, 2> kFirstLine {1, 2};
+  constexpr std::array<int, 2> kSecondLine {3, 4};
+
+  for (const auto indentation : {0, 1}) {
+    std::ostringstream stream {};
+    TmxXmlWriter writer {stream, indentation};
+
+    writer.begin_element("data");
+    writer.csv_line(std::span<const int> {kFirstLine});
+    writer.csv_line(std::span<const int> {kSecondLine});
+    writer.end_element();
+
+    ASSERT_TRUE(writer.flush().has_value());
+    EXPECT_EQ(stream.str(),
+              indentation > 0 ? "<data>\n1,2,\n3,4\n</data>\n" : "<data>1,2,3,4</data>");
+  }
+}
+
+// tactile::tiled_tmx::TmxXmlWriter::text
+// tactile::tiled_tmx::TmxXmlWriter::flush
+TEST(TmxXmlWriter, ChunkedFlushing)
+{
+  constexpr std::size_t kChunkSize = 1'000;
+  constexpr std::size_t kChunkCount = 2 * TmxXmlWriter::kFlushThreshold / kChunkSize;
+  const std::string chunk(kChunkSize, 'a');
+
+  std::ostringstream stream {};
+  TmxXmlWriter writer {stream, 0};
+
+  writer.begin_element("a");
+
+  for (std::size_t index = 0; index < kChunkCount; ++index) {
+    writer.text(chunk);
+  }
+
+  // Large outputs are written in chunks, before the writer is explicitly flushed.
+  const auto flushed_size = stream.str().size();
+  EXPECT_GE(flushed_size, TmxXmlWriter::kFlushThreshold);
+  EXPECT_LT(flushed_size, kChunkCount * kChunkSize);
+
+  writer.end_element();
+  ASSERT_TRUE(writer.flush().has_value());
+
+  std::string expected {"<a>"};
+  for (std::size_t index = 0; index < kChunkCount; ++index) {
+    expected += chunk;
+  }
+  expected += "</a>";
+
+  EXPECT_EQ(stream.str(), expected);
+}
+
+// tactile::tiled_tmx::TmxXmlWriter::flush
+TEST(TmxXmlWriter, FlushToBadStream)
+{
+  std::ostringstream stream {};
+  stream.setstate(std::ios::badbit);
+
+  TmxXmlWriter writer {stream, 0};
+  writer.begin_element("a");
+  writer.end_element();
+
+  EXPECT_EQ(writer.flush(), std::unexpected {ErrorCode::kWriteError});
+}
+
+}  // namespace
+}  // namespace tactile::tiled_tmx
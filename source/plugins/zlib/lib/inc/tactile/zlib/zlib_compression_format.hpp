@@ -10,16 +10,30 @@ namespace tactile::zlib {
 /**
  * Provides compression using the Zlib library.
  *
+ * \details
+ * Large inputs are split into blocks that are compressed concurrently, if
+ * multiple threads are allowed. The blocks are joined into a single standard
+ * Zlib stream, so the output is readable by any Zlib decoder.
+ *
+ * Dictionaries are not supported, so any provided dictionaries are ignored.
+ *
  * \see https://github.com/madler/zlib
  */
 class TACTILE_ZLIB_API ZlibCompressionFormat final : public ICompressionFormat
 {
  public:
   [[nodiscard]]
-  auto compress(ByteSpan input_data) const -> std::expected<ByteStream, ErrorCode> override;
+  auto compress(ByteSpan input_data, const CompressionOptions& options) const
+      -> std::expected<ByteStream, ErrorCode> override;
+
+  [[nodiscard]]
+  auto decompress(ByteSpan input_data, const DecompressionOptions& options) const
+      -> std::expected<ByteStream, ErrorCode> override;
 
   [[nodiscard]]
-  auto decompress(ByteSpan input_data) const -> std::expected<ByteStream, ErrorCode> override;
+  auto train_dictionary(std::span<const ByteSpan> samples,
+                        std::size_t max_dictionary_size) const
+      -> std::expected<ByteStream, ErrorCode> override;
 };
 
 }  // namespace tactile::zlib
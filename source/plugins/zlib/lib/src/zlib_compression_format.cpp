@@ -2,10 +2,17 @@
 
 #include "tactile/zlib/zlib_compression_format.hpp"
 
-#include <array>     // array
-#include <cstddef>   // size_t
-#include <expected>  // expected
-#include <utility>   // move
+#include <algorithm>   // clamp, min
+#include <array>       // array
+#include <atomic>      // atomic, memory_order
+#include <cstddef>     // size_t
+#include <cstdint>     // uint8_t
+#include <expected>    // expected
+#include <functional>  // function
+#include <new>         // bad_alloc
+#include <thread>      // jthread
+#include <utility>     // move
+#include <vector>      // vector
 
 #define Z_PREFIX_SET
 #include <zlib.h>
@@ -27,12 +34,33 @@ using z_ulong = ::uLong;
  */
 using StagingBuffer = std::array<z_byte, 16'384>;
 
+// Smaller inputs are always compressed on the calling thread, since the cost of
+// distributing the work would outweigh the benefits.
+inline constexpr std::size_t kMinMultithreadedInputSize = std::size_t {1} << 20U;
+
+// The size of the blocks that are compressed concurrently, the same as pigz.
+inline constexpr std::size_t kParallelBlockSize = std::size_t {128} << 10U;
+
+// Each block is primed with this much of the preceding input, i.e., the size of
+// the deflate window, which makes the compression ratio close to that of a
+// single stream.
+inline constexpr std::size_t kDeflateWindowSize = std::size_t {32} << 10U;
+
+/**
+ * A block of a deflate stream that was compressed independently.
+ */
+struct DeflateBlock final
+{
+  ByteStream data;
+  z_ulong checksum;
+};
+
 /**
  * Provides callbacks that controls the behavior of stream processing functions.
  */
 struct ZlibCallbacks final
 {
-  using init_stream_func = int (*)(z_stream*);
+  using init_stream_func = std::function<int(z_stream*)>;
   using process_func = int (*)(z_stream*, int);
   using end_func = int (*)(z_stream*);
 
@@ -145,15 +173,201 @@ auto _end_stream(const ZlibCallbacks& callbacks, z_stream& stream)
   return {};
 }
 
+// Mirrors the compression level hint that Zlib stores in stream headers.
+[[nodiscard]]
+auto _get_level_hint(const int level) -> int
+{
+  if (level == Z_DEFAULT_COMPRESSION || level == 6) {
+    return 2;
+  }
+
+  if (level < 2) {
+    return 0;
+  }
+
+  return (level < 6) ? 1 : 3;
+}
+
+/**
+ * Compresses a block of a larger input as a raw deflate stream.
+ *
+ * \details
+ * All blocks but the last one end with a sync flush instead of a final block,
+ * so that the blocks can be concatenated into a single deflate stream.
+ *
+ * \param input_data The input data of the entire stream.
+ * \param offset     The offset of the block in the input data.
+ * \param size       The size of the block.
+ * \param level      The compression level.
+ *
+ * \return
+ * The compressed block if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto _deflate_block(const ByteSpan input_data,
+                    const std::size_t offset,
+                    const std::size_t size,
+                    const int level) -> std::expected<DeflateBlock, ErrorCode>
+{
+  const auto block_data = input_data.subspan(offset, size);
+  const auto is_last_block = offset + size == input_data.size();
+
+  z_stream stream {};
+
+  // A negative window size selects raw deflate streams, i.e., without headers.
+  if (z_deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    return std::unexpected {ErrorCode::kBadInit};
+  }
+
+  DeflateBlock block {};
+  block.checksum = adler32(adler32(0, nullptr, 0),
+                           block_data.data(),
+                           saturate_cast<z_uint>(block_data.size()));
+
+  auto status = Z_OK;
+
+  if (offset > 0) {
+    const auto dictionary_size = std::min(offset, kDeflateWindowSize);
+    const auto dictionary = input_data.subspan(offset - dictionary_size, dictionary_size);
+    status = deflateSetDictionary(&stream,
+                                  dictionary.data(),
+                                  saturate_cast<z_uint>(dictionary.size()));
+  }
+
+  // The sync flush marker isn't accounted for by the bound.
+  block.data.resize(deflateBound(&stream, saturate_cast<z_ulong>(block_data.size())) + 16);
+
+  stream.next_in = const_cast<z_byte*>(block_data.data());  // NOLINT
+  stream.avail_in = saturate_cast<z_uint>(block_data.size());
+  stream.next_out = block.data.data();
+  stream.avail_out = saturate_cast<z_uint>(block.data.size());
+
+  if (status == Z_OK) {
+    status = deflate(&stream, is_last_block ? Z_FINISH : Z_SYNC_FLUSH);
+  }
+
+  const auto is_done = is_last_block ? status == Z_STREAM_END
+                                     : status == Z_OK && stream.avail_out != 0;
+  const auto written_byte_count = block.data.size() - stream.avail_out;
+
+  deflateEnd(&stream);
+
+  if (!is_done || stream.avail_in != 0) {
+    return std::unexpected {ErrorCode::kCouldNotCompress};
+  }
+
+  block.data.resize(written_byte_count);
+  return block;
+}
+
+/**
+ * Compresses data by concurrently compressing blocks of it, like pigz does.
+ *
+ * \details
+ * The result is a single standard Zlib stream, which any Zlib decoder can read.
+ * Note, this function must not use the logger in worker threads, since it isn't
+ * thread-safe.
+ *
+ * \param input_data   The data that will be compressed.
+ * \param level        The compression level.
+ * \param thread_count The maximum number of threads to use.
+ *
+ * \return
+ * The compressed data if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto _compress_parallel(const ByteSpan input_data,
+                        const int level,
+                        const std::size_t thread_count) -> std::expected<ByteStream, ErrorCode>
+{
+  const auto block_count = (input_data.size() + kParallelBlockSize - 1) / kParallelBlockSize;
+
+  std::vector<std::expected<DeflateBlock, ErrorCode>> blocks(
+      block_count,
+      std::unexpected {ErrorCode::kUnknown});
+  std::atomic<std::size_t> next_block_index {0};
+
+  const auto worker = [&] {
+    while (true) {
+      const auto block_index = next_block_index.fetch_add(1, std::memory_order_relaxed);
+      if (block_index >= block_count) {
+        return;
+      }
+
+      const auto offset = block_index * kParallelBlockSize;
+      const auto size = std::min(kParallelBlockSize, input_data.size() - offset);
+
+      try {
+        blocks[block_index] = _deflate_block(input_data, offset, size, level);
+      }
+      catch (const std::bad_alloc&) {
+        blocks[block_index] = std::unexpected {ErrorCode::kOutOfMemory};
+      }
+    }
+  };
+
+  {
+    std::vector<std::jthread> threads {};
+    threads.reserve(std::min(thread_count, block_count) - 1);
+
+    for (std::size_t index = 1; index < std::min(thread_count, block_count); ++index) {
+      threads.emplace_back(worker);
+    }
+
+    worker();
+  }
+
+  // The header uses the default compression method and window size.
+  constexpr std::uint8_t cmf = 0x78;
+  auto flg = static_cast<std::uint8_t>(_get_level_hint(level) << 6U);
+  flg += static_cast<std::uint8_t>(31 - ((cmf << 8U) + flg) % 31);
+
+  ByteStream output_buffer {};
+  output_buffer.push_back(cmf);
+  output_buffer.push_back(flg);
+
+  auto checksum = adler32(0, nullptr, 0);
+
+  for (std::size_t block_index = 0; block_index < block_count; ++block_index) {
+    const auto& block = blocks[block_index];
+    if (!block.has_value()) {
+      TACTILE_ZLIB_ERROR("Could not compress block {}", block_index);
+      return std::unexpected {block.error()};
+    }
+
+    const auto block_size = std::min(kParallelBlockSize,
+                                     input_data.size() - block_index * kParallelBlockSize);
+    checksum = adler32_combine(checksum, block->checksum, saturate_cast<z_off_t>(block_size));
+
+    output_buffer.insert(output_buffer.end(), block->data.begin(), block->data.end());
+  }
+
+  // The trailer is the Adler-32 checksum of the uncompressed data, in big endian order.
+  output_buffer.push_back(static_cast<std::uint8_t>(checksum >> 24U));
+  output_buffer.push_back(static_cast<std::uint8_t>(checksum >> 16U));
+  output_buffer.push_back(static_cast<std::uint8_t>(checksum >> 8U));
+  output_buffer.push_back(static_cast<std::uint8_t>(checksum));
+
+  return output_buffer;
+}
+
 }  // namespace
 
-auto ZlibCompressionFormat::compress(const ByteSpan input_data) const
+auto ZlibCompressionFormat::compress(const ByteSpan input_data,
+                                     const CompressionOptions& options) const
     -> std::expected<ByteStream, ErrorCode>
 {
+  // Note, Z_DEFAULT_COMPRESSION is -1, so any negative level selects the default level.
+  const auto level = std::clamp(options.level.value_or(Z_DEFAULT_COMPRESSION),
+                                Z_DEFAULT_COMPRESSION,
+                                Z_BEST_COMPRESSION);
+
+  if (options.thread_count > 1 && input_data.size_bytes() >= kMinMultithreadedInputSize) {
+    return _compress_parallel(input_data, level, options.thread_count);
+  }
+
   ZlibCallbacks callbacks {};
-  callbacks.init_stream = [](z_stream* stream) {
-    return z_deflateInit(stream, Z_DEFAULT_COMPRESSION);
-  };
+  callbacks.init_stream = [level](z_stream* stream) { return z_deflateInit(stream, level); };
   callbacks.process_stream = &deflate;
   callbacks.end_stream = &deflateEnd;
 
@@ -173,7 +387,8 @@ auto ZlibCompressionFormat::compress(const ByteSpan input_data) const
       .transform([&] { return std::move(output_buffer); });
 }
 
-auto ZlibCompressionFormat::decompress(const ByteSpan input_data) const
+auto ZlibCompressionFormat::decompress(const ByteSpan input_data,
+                                       const DecompressionOptions&) const
     -> std::expected<ByteStream, ErrorCode>
 {
   ZlibCallbacks callbacks {};
@@ -195,4 +410,12 @@ auto ZlibCompressionFormat::decompress(const ByteSpan input_data) const
       .transform([&] { return std::move(output_buffer); });
 }
 
+auto ZlibCompressionFormat::train_dictionary(const std::span<const ByteSpan>,
+                                             const std::size_t) const
+    -> std::expected<ByteStream, ErrorCode>
+{
+  TACTILE_ZLIB_ERROR("Zlib dictionaries are not supported");
+  return std::unexpected {ErrorCode::kNotSupported};
+}
+
 }  // namespace tactile::zlib
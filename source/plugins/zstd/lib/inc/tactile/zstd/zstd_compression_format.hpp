@@ -10,16 +10,34 @@ namespace tactile::zstd {
 /**
  * Provides compression and decompression using the Zstandard algorithm.
  *
+ * \details
+ * Compression and decompression contexts are reused by calls on the same thread,
+ * so this class may be used by several threads concurrently. Large inputs are
+ * compressed using multiple threads, if requested and supported by the library.
+ *
+ * \details
+ * Dictionaries are digested once per thread and reused for as long as the same
+ * dictionary is requested. Frames record the ID of the dictionary they were
+ * compressed with, so frames compressed without one are decompressed as usual
+ * even if a dictionary is provided.
+ *
  * \see https://github.com/facebook/zstd
  */
 class TACTILE_ZSTD_API ZstdCompressionFormat final : public ICompressionFormat
 {
  public:
   [[nodiscard]]
-  auto compress(ByteSpan input_data) const -> std::expected<ByteStream, ErrorCode> override;
+  auto compress(ByteSpan input_data, const CompressionOptions& options) const
+      -> std::expected<ByteStream, ErrorCode> override;
+
+  [[nodiscard]]
+  auto decompress(ByteSpan input_data, const DecompressionOptions& options) const
+      -> std::expected<ByteStream, ErrorCode> override;
 
   [[nodiscard]]
-  auto decompress(ByteSpan input_data) const -> std::expected<ByteStream, ErrorCode> override;
+  auto train_dictionary(std::span<const ByteSpan> samples,
+                        std::size_t max_dictionary_size) const
+      -> std::expected<ByteStream, ErrorCode> override;
 };
 
 }  // namespace tactile::zstd
@@ -2,43 +2,279 @@
 
 #include "tactile/zstd/zstd_compression_format.hpp"
 
-#include <algorithm>  // copy_n
+#include <algorithm>  // clamp, min, copy_n, equal
 #include <cstddef>    // size_t
 #include <iterator>   // back_inserter
 #include <memory>     // unique_ptr
+#include <vector>     // vector
 
+#include <zdict.h>
 #include <zstd.h>
 
+#include "tactile/base/numeric/saturate_cast.hpp"
 #include "tactile/zstd/logging.hpp"
 
 namespace tactile::zstd {
 namespace {
 
-struct DStreamDeleter final
+// Smaller inputs are always compressed on the calling thread, since the cost of
+// distributing the work would outweigh the benefits.
+inline constexpr std::size_t kMinMultithreadedInputSize = std::size_t {1} << 20U;
+
+// Frames that claim to be larger than this are decompressed incrementally, so
+// that corrupt frame headers can't trigger huge allocations up front.
+inline constexpr unsigned long long kMaxSinglePassContentSize = 1ULL << 28U;
+
+struct CCtxDeleter final
+{
+  void operator()(ZSTD_CCtx* context) noexcept
+  {
+    ZSTD_freeCCtx(context);
+  }
+};
+
+struct DCtxDeleter final
 {
-  void operator()(ZSTD_DStream* stream) noexcept
+  void operator()(ZSTD_DCtx* context) noexcept
   {
-    ZSTD_freeDStream(stream);
+    ZSTD_freeDCtx(context);
   }
 };
 
-using UniqueDStream = std::unique_ptr<ZSTD_DStream, DStreamDeleter>;
+struct CDictDeleter final
+{
+  void operator()(ZSTD_CDict* dictionary) noexcept
+  {
+    ZSTD_freeCDict(dictionary);
+  }
+};
+
+struct DDictDeleter final
+{
+  void operator()(ZSTD_DDict* dictionary) noexcept
+  {
+    ZSTD_freeDDict(dictionary);
+  }
+};
+
+using UniqueCCtx = std::unique_ptr<ZSTD_CCtx, CCtxDeleter>;
+using UniqueDCtx = std::unique_ptr<ZSTD_DCtx, DCtxDeleter>;
+using UniqueCDict = std::unique_ptr<ZSTD_CDict, CDictDeleter>;
+using UniqueDDict = std::unique_ptr<ZSTD_DDict, DDictDeleter>;
+
+struct CachedCDict final
+{
+  ByteStream dictionary;
+  int level;
+  UniqueCDict digested_dictionary;
+};
+
+struct CachedDDict final
+{
+  ByteStream dictionary;
+  UniqueDDict digested_dictionary;
+};
+
+// Contexts are relatively expensive to create, so each thread reuses its own
+// contexts. This also makes it safe to use the format from multiple threads.
+
+[[nodiscard]]
+auto _get_compression_context() -> ZSTD_CCtx*
+{
+  thread_local UniqueCCtx context {};
+
+  if (!context) {
+    context.reset(ZSTD_createCCtx());
+  }
+
+  return context.get();
+}
+
+[[nodiscard]]
+auto _get_decompression_context() -> ZSTD_DCtx*
+{
+  thread_local UniqueDCtx context {};
+
+  if (!context) {
+    context.reset(ZSTD_createDCtx());
+  }
+
+  return context.get();
+}
+
+// Digesting a dictionary is about as expensive as compressing a small input, so
+// each thread keeps the most recently used dictionaries in digested form.
+
+[[nodiscard]]
+auto _get_compression_dictionary(const ByteSpan dictionary, const int level)
+    -> const ZSTD_CDict*
+{
+  thread_local CachedCDict cache {};
+
+  if (!cache.digested_dictionary || cache.level != level ||
+      !std::ranges::equal(cache.dictionary, dictionary)) {
+    cache.digested_dictionary.reset(
+        ZSTD_createCDict(dictionary.data(), dictionary.size_bytes(), level));
+    cache.dictionary.assign(dictionary.begin(), dictionary.end());
+    cache.level = level;
+  }
+
+  return cache.digested_dictionary.get();
+}
+
+[[nodiscard]]
+auto _get_decompression_dictionary(const ByteSpan dictionary) -> const ZSTD_DDict*
+{
+  thread_local CachedDDict cache {};
+
+  if (!cache.digested_dictionary || !std::ranges::equal(cache.dictionary, dictionary)) {
+    cache.digested_dictionary.reset(
+        ZSTD_createDDict(dictionary.data(), dictionary.size_bytes()));
+    cache.dictionary.assign(dictionary.begin(), dictionary.end());
+  }
+
+  return cache.digested_dictionary.get();
+}
+
+[[nodiscard]]
+auto _get_compression_level(const CompressionOptions& options) -> int
+{
+  return std::clamp(options.level.value_or(ZSTD_CLEVEL_DEFAULT),
+                    ZSTD_minCLevel(),
+                    ZSTD_maxCLevel());
+}
+
+[[nodiscard]]
+auto _set_compression_parameters(ZSTD_CCtx* context,
+                                 const std::size_t input_size,
+                                 const CompressionOptions& options) -> bool
+{
+  // Parameters are sticky, so any parameters and dictionaries set by previous
+  // calls are discarded.
+  ZSTD_CCtx_reset(context, ZSTD_reset_session_and_parameters);
+
+  const auto level = _get_compression_level(options);
+
+  const auto set_level_result =
+      ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, level);
+  if (ZSTD_isError(set_level_result)) {
+    TACTILE_ZSTD_ERROR("Could not set compression level: {}",
+                       ZSTD_getErrorName(set_level_result));
+    return false;
+  }
+
+  if (options.thread_count > 1 && input_size >= kMinMultithreadedInputSize) {
+    // The upper bound is zero if Zstd was built without multithreading support.
+    const auto worker_bounds = ZSTD_cParam_getBounds(ZSTD_c_nbWorkers);
+    if (!ZSTD_isError(worker_bounds.error) && worker_bounds.upperBound > 0) {
+      const auto worker_count =
+          std::min(saturate_cast<int>(options.thread_count), worker_bounds.upperBound);
+      ZSTD_CCtx_setParameter(context, ZSTD_c_nbWorkers, worker_count);
+    }
+  }
+
+  return true;
+}
+
+[[nodiscard]]
+auto _set_compression_dictionary(ZSTD_CCtx* context, const CompressionOptions& options)
+    -> bool
+{
+  const auto* dictionary =
+      _get_compression_dictionary(options.dictionary, _get_compression_level(options));
+  if (!dictionary) {
+    TACTILE_ZSTD_ERROR("Could not load compression dictionary");
+    return false;
+  }
+
+  const auto ref_result = ZSTD_CCtx_refCDict(context, dictionary);
+  if (ZSTD_isError(ref_result)) {
+    TACTILE_ZSTD_ERROR("Could not use compression dictionary: {}",
+                       ZSTD_getErrorName(ref_result));
+    return false;
+  }
+
+  return true;
+}
+
+[[nodiscard]]
+auto _set_decompression_dictionary(ZSTD_DCtx* context,
+                                   const ByteSpan input_data,
+                                   const DecompressionOptions& options) -> bool
+{
+  const auto frame_dictionary_id =
+      ZSTD_getDictID_fromFrame(input_data.data(), input_data.size_bytes());
+
+  if (options.dictionary.empty()) {
+    if (frame_dictionary_id != 0) {
+      TACTILE_ZSTD_ERROR("Data requires dictionary {}, but no dictionary was provided",
+                         frame_dictionary_id);
+      return false;
+    }
+
+    return true;
+  }
+
+  const auto* dictionary = _get_decompression_dictionary(options.dictionary);
+  if (!dictionary) {
+    TACTILE_ZSTD_ERROR("Could not load decompression dictionary");
+    return false;
+  }
+
+  // Frames compressed without a dictionary are decoded without one. Note, raw
+  // content dictionaries and frames compressed with them both have the ID zero.
+  const auto dictionary_id = ZSTD_getDictID_fromDDict(dictionary);
+  if (frame_dictionary_id == 0 && dictionary_id != 0) {
+    return true;
+  }
+
+  if (frame_dictionary_id != dictionary_id) {
+    TACTILE_ZSTD_ERROR("Data requires dictionary {}, but dictionary {} was provided",
+                       frame_dictionary_id,
+                       dictionary_id);
+    return false;
+  }
+
+  const auto ref_result = ZSTD_DCtx_refDDict(context, dictionary);
+  if (ZSTD_isError(ref_result)) {
+    TACTILE_ZSTD_ERROR("Could not use decompression dictionary: {}",
+                       ZSTD_getErrorName(ref_result));
+    return false;
+  }
+
+  return true;
+}
 
 }  // namespace
 
-auto ZstdCompressionFormat::compress(const ByteSpan input_data) const
+auto ZstdCompressionFormat::compress(const ByteSpan input_data,
+                                     const CompressionOptions& options) const
     -> std::expected<ByteStream, ErrorCode>
 {
+  auto* context = _get_compression_context();
+  if (!context) {
+    TACTILE_ZSTD_ERROR("Could not create compression context");
+    return std::unexpected {ErrorCode::kOutOfMemory};
+  }
+
+  if (!_set_compression_parameters(context, input_data.size_bytes(), options)) {
+    return std::unexpected {ErrorCode::kBadParam};
+  }
+
+  if (!options.dictionary.empty() && !_set_compression_dictionary(context, options)) {
+    return std::unexpected {ErrorCode::kBadParam};
+  }
+
   const auto compression_bound = ZSTD_compressBound(input_data.size_bytes());
 
   ByteStream compressed_data {};
   compressed_data.resize(compression_bound);
 
-  const auto written_byte_count = ZSTD_compress(compressed_data.data(),
-                                                compressed_data.size(),
-                                                input_data.data(),
-                                                input_data.size_bytes(),
-                                                ZSTD_CLEVEL_DEFAULT);
+  const auto written_byte_count = ZSTD_compress2(context,
+                                                 compressed_data.data(),
+                                                 compressed_data.size(),
+                                                 input_data.data(),
+                                                 input_data.size_bytes());
 
   if (ZSTD_isError(written_byte_count)) {
     TACTILE_ZSTD_ERROR("Compression failed: {}", ZSTD_getErrorName(written_byte_count));
@@ -51,20 +287,45 @@ auto ZstdCompressionFormat::compress(const ByteSpan input_data) const
   return compressed_data;
 }
 
-auto ZstdCompressionFormat::decompress(const ByteSpan input_data) const
+auto ZstdCompressionFormat::decompress(const ByteSpan input_data,
+                                       const DecompressionOptions& options) const
     -> std::expected<ByteStream, ErrorCode>
 {
-  const UniqueDStream stream {ZSTD_createDStream()};
-  if (!stream) {
-    TACTILE_ZSTD_ERROR("Could not create stream");
+  auto* context = _get_decompression_context();
+  if (!context) {
+    TACTILE_ZSTD_ERROR("Could not create decompression context");
     return std::unexpected {ErrorCode::kOutOfMemory};
   }
 
-  const auto init_stream_result = ZSTD_initDStream(stream.get());
-  if (ZSTD_isError(init_stream_result)) {
-    TACTILE_ZSTD_ERROR("Could not initialize stream: {}",
-                       ZSTD_getErrorName(init_stream_result));
-    return std::unexpected {ErrorCode::kBadInit};
+  // Dictionaries referenced by previous calls are discarded as well.
+  ZSTD_DCtx_reset(context, ZSTD_reset_session_and_parameters);
+
+  if (!_set_decompression_dictionary(context, input_data, options)) {
+    return std::unexpected {ErrorCode::kCouldNotDecompress};
+  }
+
+  // Frames written by Zstd usually store the decompressed size, which lets us
+  // decompress the data in a single pass. Note that the unknown and error
+  // values are larger than the threshold.
+  const auto content_size =
+      ZSTD_getFrameContentSize(input_data.data(), input_data.size_bytes());
+  if (content_size <= kMaxSinglePassContentSize) {
+    ByteStream decompressed_data {};
+    decompressed_data.resize(static_cast<std::size_t>(content_size));
+
+    const auto decompressed_size = ZSTD_decompressDCtx(context,
+                                                       decompressed_data.data(),
+                                                       decompressed_data.size(),
+                                                       input_data.data(),
+                                                       input_data.size_bytes());
+
+    if (!ZSTD_isError(decompressed_size) && decompressed_size == decompressed_data.size()) {
+      return decompressed_data;
+    }
+
+    // The input may consist of several frames, which the streaming approach handles.
+    TACTILE_ZSTD_TRACE("Falling back to streaming decompression");
+    ZSTD_DCtx_reset(context, ZSTD_reset_session_only);
   }
 
   const auto staging_buffer_size = ZSTD_DStreamOutSize();
@@ -95,8 +356,7 @@ auto ZstdCompressionFormat::decompress(const ByteSpan input_data) const
       output_view.pos = 0;
     }
 
-    const auto decompress_result =
-        ZSTD_decompressStream(stream.get(), &output_view, &input_view);
+    const auto decompress_result = ZSTD_decompressStream(context, &output_view, &input_view);
 
     if (ZSTD_isError(decompress_result)) {
       TACTILE_ZSTD_ERROR("Decompression failed: {}", ZSTD_getErrorName(decompress_result));
@@ -114,4 +374,49 @@ auto ZstdCompressionFormat::decompress(const ByteSpan input_data) const
   return decompressed_data;
 }
 
+auto ZstdCompressionFormat::train_dictionary(const std::span<const ByteSpan> samples,
+                                             const std::size_t max_dictionary_size) const
+    -> std::expected<ByteStream, ErrorCode>
+{
+  if (samples.empty() || max_dictionary_size == 0) {
+    TACTILE_ZSTD_ERROR("Cannot train dictionary without samples");
+    return std::unexpected {ErrorCode::kBadParam};
+  }
+
+  // The samples must be stored contiguously.
+  ByteStream sample_data {};
+  std::vector<std::size_t> sample_sizes {};
+  sample_sizes.reserve(samples.size());
+
+  for (const auto sample : samples) {
+    sample_data.insert(sample_data.end(), sample.begin(), sample.end());
+    sample_sizes.push_back(sample.size_bytes());
+  }
+
+  ByteStream dictionary {};
+  dictionary.resize(max_dictionary_size);
+
+  const auto dictionary_size =
+      ZDICT_trainFromBuffer(dictionary.data(),
+                            dictionary.size(),
+                            sample_data.data(),
+                            sample_sizes.data(),
+                            saturate_cast<unsigned>(sample_sizes.size()));
+
+  if (ZDICT_isError(dictionary_size)) {
+    TACTILE_ZSTD_ERROR("Could not train dictionary: {}", ZDICT_getErrorName(dictionary_size));
+    return std::unexpected {ErrorCode::kCouldNotCompress};
+  }
+
+  dictionary.resize(dictionary_size);
+  dictionary.shrink_to_fit();
+
+  TACTILE_ZSTD_DEBUG("Trained dictionary {} ({} bytes) from {} samples",
+                     ZDICT_getDictID(dictionary.data(), dictionary.size()),
+                     dictionary.size(),
+                     sample_sizes.size());
+
+  return dictionary;
+}
+
 }  // namespace tactile::zstd
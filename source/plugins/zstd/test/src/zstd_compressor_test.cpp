@@ -1,7 +1,13 @@
 // Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
 
-#include <numeric>  // iota
-#include <string>   // string
+#include <algorithm>  // min
+#include <cstddef>    // size_t
+#include <cstdint>    // uint8_t, uint32_t
+#include <expected>   // unexpected
+#include <numeric>    // iota
+#include <optional>   // nullopt
+#include <string>     // string
+#include <vector>     // vector
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -11,6 +17,36 @@
 namespace tactile::zstd {
 namespace {
 
+inline constexpr CompressionOptions kDefaultOptions {
+  .level = std::nullopt,
+  .thread_count = 1,
+  .dictionary = ByteSpan {},
+};
+
+inline constexpr DecompressionOptions kDefaultDecompressionOptions {
+  .dictionary = ByteSpan {},
+};
+
+// Produces compressible data that isn't trivially repetitive.
+[[nodiscard]]
+auto _make_test_bytes(const std::size_t byte_count) -> ByteStream
+{
+  ByteStream bytes {};
+  bytes.reserve(byte_count);
+
+  // Repeats short runs of pseudo-random bytes, which is roughly what tile data looks like.
+  std::uint32_t state = 42;
+  while (bytes.size() < byte_count) {
+    state = state * 1'664'525u + 1'013'904'223u;
+    const auto value = static_cast<std::uint8_t>(state >> 24u);
+    const auto run_length =
+        std::min<std::size_t>((state >> 8u) % 8u + 1u, byte_count - bytes.size());
+    bytes.insert(bytes.end(), run_length, value);
+  }
+
+  return bytes;
+}
+
 // tactile::zstd::ZstdCompressionFormat::compress
 // tactile::zstd::ZstdCompressionFormat::decompress
 TEST(ZstdCompressionFormat, CompressAndDecompressBytes)
@@ -21,10 +57,11 @@ TEST(ZstdCompressionFormat, CompressAndDecompressBytes)
   bytes.resize(64'000);
   std::iota(bytes.begin(), bytes.end(), 0);
 
-  const auto compressed_bytes = compressor.compress(bytes);
+  const auto compressed_bytes = compressor.compress(bytes, kDefaultOptions);
   ASSERT_TRUE(compressed_bytes.has_value());
 
-  const auto decompressed_bytes = compressor.decompress(*compressed_bytes);
+  const auto decompressed_bytes =
+      compressor.decompress(*compressed_bytes, kDefaultDecompressionOptions);
   ASSERT_TRUE(decompressed_bytes.has_value());
   EXPECT_THAT(*decompressed_bytes, testing::ContainerEq(bytes));
 }
@@ -38,15 +75,149 @@ TEST(ZstdCompressionFormat, CompressAndDecompressString)
   constexpr std::string_view original_string =
       "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. Mi bibendum neque egestas congue quisque egestas diam in arcu. Varius duis at consectetur lorem. Ultricies tristique nulla aliquet enim tortor at auctor. Nibh nisl condimentum id venenatis a condimentum vitae sapien pellentesque. Venenatis urna cursus eget nunc scelerisque. Mattis molestie a iaculis at erat pellentesque adipiscing commodo elit. Commodo ullamcorper a lacus vestibulum sed arcu non odio euismod. Vivamus arcu felis bibendum ut. Libero enim sed faucibus turpis in eu mi bibendum neque. Blandit volutpat maecenas volutpat blandit aliquam etiam.";
 
-  const auto compressed_bytes = compressor.compress(make_byte_span(original_string));
+  const auto compressed_bytes =
+      compressor.compress(make_byte_span(original_string), kDefaultOptions);
   ASSERT_TRUE(compressed_bytes.has_value());
 
-  const auto decompressed_bytes = compressor.decompress(*compressed_bytes);
+  const auto decompressed_bytes =
+      compressor.decompress(*compressed_bytes, kDefaultDecompressionOptions);
   ASSERT_TRUE(decompressed_bytes.has_value());
 
   const std::string restored_string {decompressed_bytes->begin(), decompressed_bytes->end()};
   EXPECT_EQ(restored_string, original_string);
 }
 
+// tactile::zstd::ZstdCompressionFormat::compress
+TEST(ZstdCompressionFormat, CompressWithDifferentLevels)
+{
+  const ZstdCompressionFormat compressor {};
+  const auto bytes = _make_test_bytes(256'000);
+
+  const auto fast_bytes = compressor.compress(bytes, CompressionOptions {
+    .level = 1,
+    .thread_count = 1,
+    .dictionary = ByteSpan {},
+  });
+  const auto small_bytes = compressor.compress(bytes, CompressionOptions {
+    .level = 9,
+    .thread_count = 1,
+    .dictionary = ByteSpan {},
+  });
+  ASSERT_TRUE(fast_bytes.has_value());
+  ASSERT_TRUE(small_bytes.has_value());
+  EXPECT_LE(small_bytes->size(), fast_bytes->size());
+
+  EXPECT_EQ(compressor.decompress(*fast_bytes, kDefaultDecompressionOptions), bytes);
+  EXPECT_EQ(compressor.decompress(*small_bytes, kDefaultDecompressionOptions), bytes);
+}
+
+// tactile::zstd::ZstdCompressionFormat::compress
+TEST(ZstdCompressionFormat, CompressWithInvalidLevel)
+{
+  const ZstdCompressionFormat compressor {};
+  const auto bytes = _make_test_bytes(1'000);
+
+  for (const auto level : {-1'000, 1'000}) {
+    const auto compressed_bytes = compressor.compress(bytes, CompressionOptions {
+      .level = level,
+      .thread_count = 1,
+      .dictionary = ByteSpan {},
+    });
+    ASSERT_TRUE(compressed_bytes.has_value());
+    EXPECT_EQ(compressor.decompress(*compressed_bytes, kDefaultDecompressionOptions), bytes);
+  }
+}
+
+// tactile::zstd::ZstdCompressionFormat::compress
+// tactile::zstd::ZstdCompressionFormat::decompress
+TEST(ZstdCompressionFormat, CompressLargeInputWithMultipleThreads)
+{
+  const ZstdCompressionFormat compressor {};
+  const auto bytes = _make_test_bytes(std::size_t {4} << 20U);
+
+  const auto compressed_bytes = compressor.compress(bytes, CompressionOptions {
+    .level = std::nullopt,
+    .thread_count = 4,
+    .dictionary = ByteSpan {},
+  });
+  ASSERT_TRUE(compressed_bytes.has_value());
+
+  const auto decompressed_bytes =
+      compressor.decompress(*compressed_bytes, kDefaultDecompressionOptions);
+  ASSERT_TRUE(decompressed_bytes.has_value());
+  EXPECT_EQ(decompressed_bytes->size(), bytes.size());
+  EXPECT_EQ(*decompressed_bytes, bytes);
+}
+
+// tactile::zstd::ZstdCompressionFormat::train_dictionary
+// tactile::zstd::ZstdCompressionFormat::compress
+// tactile::zstd::ZstdCompressionFormat::decompress
+TEST(ZstdCompressionFormat, CompressAndDecompressWithDictionary)
+{
+  const ZstdCompressionFormat compressor {};
+
+  const auto sample_data = _make_test_bytes(256'000);
+  std::vector<ByteSpan> samples {};
+  for (std::size_t offset = 0; offset < sample_data.size(); offset += 1'000) {
+    samples.push_back(ByteSpan {sample_data}.subspan(offset, 1'000));
+  }
+
+  const auto dictionary = compressor.train_dictionary(samples, 4'096);
+  ASSERT_TRUE(dictionary.has_value());
+  EXPECT_FALSE(dictionary->empty());
+  EXPECT_LE(dictionary->size(), 4'096);
+
+  const auto bytes = _make_test_bytes(1'000);
+  const auto compressed_bytes = compressor.compress(bytes, CompressionOptions {
+    .level = std::nullopt,
+    .thread_count = 1,
+    .dictionary = *dictionary,
+  });
+  ASSERT_TRUE(compressed_bytes.has_value());
+
+  const auto decompressed_bytes = compressor.decompress(*compressed_bytes,
+                                                        DecompressionOptions {
+                                                          .dictionary = *dictionary,
+                                                        });
+  ASSERT_TRUE(decompressed_bytes.has_value());
+  EXPECT_EQ(*decompressed_bytes, bytes);
+
+  EXPECT_FALSE(compressor.decompress(*compressed_bytes, kDefaultDecompressionOptions));
+}
+
+// tactile::zstd::ZstdCompressionFormat::decompress
+TEST(ZstdCompressionFormat, DecompressWithUnusedDictionary)
+{
+  const ZstdCompressionFormat compressor {};
+
+  const auto bytes = _make_test_bytes(1'000);
+  const auto compressed_bytes = compressor.compress(bytes, kDefaultOptions);
+  ASSERT_TRUE(compressed_bytes.has_value());
+
+  const auto sample_data = _make_test_bytes(64'000);
+  std::vector<ByteSpan> samples {};
+  for (std::size_t offset = 0; offset < sample_data.size(); offset += 500) {
+    samples.push_back(ByteSpan {sample_data}.subspan(offset, 500));
+  }
+
+  const auto dictionary = compressor.train_dictionary(samples, 2'048);
+  ASSERT_TRUE(dictionary.has_value());
+
+  const auto decompressed_bytes = compressor.decompress(*compressed_bytes,
+                                                        DecompressionOptions {
+                                                          .dictionary = *dictionary,
+                                                        });
+  ASSERT_TRUE(decompressed_bytes.has_value());
+  EXPECT_EQ(*decompressed_bytes, bytes);
+}
+
+// tactile::zstd::ZstdCompressionFormat::train_dictionary
+TEST(ZstdCompressionFormat, TrainDictionaryWithoutSamples)
+{
+  const ZstdCompressionFormat compressor {};
+
+  EXPECT_EQ(compressor.train_dictionary({}, 4'096), std::unexpected {ErrorCode::kBadParam});
+}
+
 }  // namespace
 }  // namespace tactile::zstd
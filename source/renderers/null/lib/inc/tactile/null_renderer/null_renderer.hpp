@@ -38,6 +38,19 @@ class TACTILE_NULL_RENDERER_API NullRenderer final : public IRenderer
   [[nodiscard]]
   auto find_texture(TextureID id) const -> const ITexture* override;
 
+  [[nodiscard]]
+  auto create_render_target(const TextureSize& size)
+      -> std::expected<TextureID, ErrorCode> override;
+
+  [[nodiscard]]
+  auto render_to_target(TextureID target_id, const ImDrawData& draw_data) -> bool override;
+
+  [[nodiscard]]
+  auto is_render_target_flipped() const -> bool override;
+
+  [[nodiscard]]
+  auto add_premultiplied_alpha_callback(ImDrawList& draw_list) -> bool override;
+
   void try_reload_fonts() override;
 
   [[nodiscard]]
@@ -54,6 +54,27 @@ auto NullRenderer::find_texture(const TextureID id) const -> const ITexture*
   return nullptr;
 }
 
+auto NullRenderer::create_render_target(const TextureSize&)
+    -> std::expected<TextureID, ErrorCode>
+{
+  return std::unexpected {ErrorCode::kNotSupported};
+}
+
+auto NullRenderer::render_to_target(const TextureID, const ImDrawData&) -> bool
+{
+  return false;
+}
+
+auto NullRenderer::is_render_target_flipped() const -> bool
+{
+  return false;
+}
+
+auto NullRenderer::add_premultiplied_alpha_callback(ImDrawList&) -> bool
+{
+  return false;
+}
+
 void NullRenderer::try_reload_fonts()
 {}
 
@@ -0,0 +1,76 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <expected>  // expected
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/base/render/renderer_options.hpp"
+#include "tactile/base/render/texture.hpp"
+#include "tactile/opengl/api.hpp"
+
+namespace tactile::gl {
+
+/**
+ * Represents an offscreen OpenGL render target, i.e., a texture attached to a
+ * framebuffer object.
+ */
+class TACTILE_OPENGL_API OpenGLRenderTarget final : public ITexture
+{
+ public:
+  using id_type = unsigned;
+
+  /**
+   * Creates a render target.
+   *
+   * \param size    The size of the render target, in pixels.
+   * \param options The renderer options to use.
+   *
+   * \return
+   * A render target if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  static auto make(const TextureSize& size, const RendererOptions& options)
+      -> std::expected<OpenGLRenderTarget, ErrorCode>;
+
+  OpenGLRenderTarget() = delete;
+
+  ~OpenGLRenderTarget() noexcept override;
+
+  OpenGLRenderTarget(OpenGLRenderTarget&& other) noexcept;
+
+  auto operator=(OpenGLRenderTarget&& other) noexcept -> OpenGLRenderTarget&;
+
+  TACTILE_DELETE_COPY(OpenGLRenderTarget);
+
+  /**
+   * Returns the identifier of the associated framebuffer object.
+   *
+   * \return
+   * An OpenGL framebuffer identifier.
+   */
+  [[nodiscard]]
+  auto get_framebuffer_id() const -> id_type;
+
+  [[nodiscard]]
+  auto get_handle() const -> void* override;
+
+  [[nodiscard]]
+  auto get_size() const -> TextureSize override;
+
+  [[nodiscard]]
+  auto get_path() const -> const std::filesystem::path& override;
+
+ private:
+  id_type m_framebuffer_id;
+  id_type m_texture_id;
+  TextureSize m_size;
+  std::filesystem::path m_path;
+
+  OpenGLRenderTarget(id_type framebuffer_id, id_type texture_id, TextureSize size);
+
+  void _dispose() noexcept;
+};
+
+}  // namespace tactile::gl
@@ -0,0 +1,148 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/opengl/opengl_render_target.hpp"
+
+#include <bit>      // bit_cast
+#include <cstdint>  // uintptr_t
+#include <utility>  // exchange
+
+#include <glad/glad.h>
+
+#include "tactile/opengl/logging.hpp"
+#include "tactile/opengl/opengl_error.hpp"
+
+namespace tactile::gl {
+
+auto OpenGLRenderTarget::make(const TextureSize& size, const RendererOptions& options)
+    -> std::expected<OpenGLRenderTarget, ErrorCode>
+{
+  if (size.width <= 0 || size.height <= 0) {
+    return std::unexpected {ErrorCode::kBadParam};
+  }
+
+  GLint previous_texture_id {};
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous_texture_id);
+
+  GLint previous_framebuffer_id {};
+  glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer_id);
+
+  unsigned texture_id {};
+  glGenTextures(1, &texture_id);
+  glBindTexture(GL_TEXTURE_2D, texture_id);
+
+  const auto filter_mode =
+      options.texture_filter_mode == TextureFilterMode::kNearest ? GL_NEAREST : GL_LINEAR;
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter_mode);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter_mode);
+
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+  glTexImage2D(GL_TEXTURE_2D,
+               0,                 // LOD index
+               GL_RGBA,           // Internal image format
+               size.width,        // Width
+               size.height,       // Height
+               0,                 // Border (must be 0)
+               GL_RGBA,           // Pixel data format
+               GL_UNSIGNED_BYTE,  // Data type of pixels
+               nullptr);
+
+  unsigned framebuffer_id {};
+  glGenFramebuffers(1, &framebuffer_id);
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_id);
+  glFramebufferTexture2D(GL_FRAMEBUFFER,
+                         GL_COLOR_ATTACHMENT0,
+                         GL_TEXTURE_2D,
+                         texture_id,
+                         0);
+
+  const auto framebuffer_status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+  glBindFramebuffer(GL_FRAMEBUFFER, static_cast<unsigned>(previous_framebuffer_id));
+  glBindTexture(GL_TEXTURE_2D, static_cast<unsigned>(previous_texture_id));
+
+  // Ensures that the resources are released if something went wrong.
+  OpenGLRenderTarget render_target {framebuffer_id, texture_id, size};
+
+  if (const auto err = glGetError(); err != GL_NONE) {
+    return std::unexpected {map_opengl_error_code(err)};
+  }
+
+  if (framebuffer_status != GL_FRAMEBUFFER_COMPLETE) {
+    TACTILE_OPENGL_ERROR("Framebuffer is incomplete: {}", framebuffer_status);
+    return std::unexpected {ErrorCode::kBadInit};
+  }
+
+  return render_target;
+}
+
+OpenGLRenderTarget::OpenGLRenderTarget(const id_type framebuffer_id,
+                                       const id_type texture_id,
+                                       const TextureSize size)
+  : m_framebuffer_id {framebuffer_id},
+    m_texture_id {texture_id},
+    m_size {size},
+    m_path {}
+{}
+
+OpenGLRenderTarget::OpenGLRenderTarget(OpenGLRenderTarget&& other) noexcept
+  : m_framebuffer_id {std::exchange(other.m_framebuffer_id, 0)},
+    m_texture_id {std::exchange(other.m_texture_id, 0)},
+    m_size {std::exchange(other.m_size, TextureSize {})},
+    m_path {}
+{}
+
+auto OpenGLRenderTarget::operator=(OpenGLRenderTarget&& other) noexcept
+    -> OpenGLRenderTarget&
+{
+  if (this != &other) {
+    _dispose();
+
+    m_framebuffer_id = std::exchange(other.m_framebuffer_id, 0);
+    m_texture_id = std::exchange(other.m_texture_id, 0);
+    m_size = std::exchange(other.m_size, TextureSize {});
+  }
+
+  return *this;
+}
+
+OpenGLRenderTarget::~OpenGLRenderTarget() noexcept
+{
+  _dispose();
+}
+
+void OpenGLRenderTarget::_dispose() noexcept
+{
+  if (m_framebuffer_id != 0) {
+    glDeleteFramebuffers(1, &m_framebuffer_id);
+    m_framebuffer_id = 0;
+  }
+
+  if (m_texture_id != 0) {
+    glDeleteTextures(1, &m_texture_id);
+    m_texture_id = 0;
+  }
+}
+
+auto OpenGLRenderTarget::get_framebuffer_id() const -> id_type
+{
+  return m_framebuffer_id;
+}
+
+auto OpenGLRenderTarget::get_handle() const -> void*
+{
+  return std::bit_cast<void*>(static_cast<std::uintptr_t>(m_texture_id));
+}
+
+auto OpenGLRenderTarget::get_size() const -> TextureSize
+{
+  return m_size;
+}
+
+auto OpenGLRenderTarget::get_path() const -> const std::filesystem::path&
+{
+  return m_path;
+}
+
+}  // namespace tactile::gl
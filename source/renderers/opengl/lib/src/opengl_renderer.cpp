@@ -19,9 +19,18 @@
 #include "tactile/base/util/scope_exit.hpp"
 #include "tactile/opengl/logging.hpp"
 #include "tactile/opengl/opengl_error.hpp"
+#include "tactile/opengl/opengl_render_target.hpp"
 #include "tactile/opengl/opengl_texture.hpp"
 
 namespace tactile::gl {
+namespace {
+
+void _enable_premultiplied_alpha(const ImDrawList*, const ImDrawCmd*)
+{
+  glBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+}  // namespace
 
 struct GLContextDeleter final
 {
@@ -41,6 +50,7 @@ struct OpenGLRenderer::Data final  // NOLINT(*-member-init)
   ScopeExit imgui_backend_impl_deleter {};
   ScopeExit imgui_renderer_impl_deleter {};
   std::unordered_map<TextureID, OpenGLTexture> textures;
+  std::unordered_map<TextureID, OpenGLRenderTarget> render_targets;
   TextureID next_texture_id;
 };
 
@@ -163,6 +173,7 @@ auto OpenGLRenderer::load_texture(const std::filesystem::path& image_path)
 void OpenGLRenderer::unload_texture(const TextureID id)
 {
   m_data->textures.erase(id);
+  m_data->render_targets.erase(id);
 }
 
 auto OpenGLRenderer::find_texture(const TextureID id) const -> const ITexture*
@@ -171,9 +182,84 @@ auto OpenGLRenderer::find_texture(const TextureID id) const -> const ITexture*
     return &iter->second;
   }
 
+  if (const auto iter = m_data->render_targets.find(id);
+      iter != m_data->render_targets.end()) {
+    return &iter->second;
+  }
+
   return nullptr;
 }
 
+auto OpenGLRenderer::create_render_target(const TextureSize& size)
+    -> std::expected<TextureID, ErrorCode>
+{
+  auto render_target = OpenGLRenderTarget::make(size, m_data->options);
+  if (!render_target.has_value()) {
+    return std::unexpected {render_target.error()};
+  }
+
+  auto& data = *m_data;
+
+  const auto texture_id = data.next_texture_id;
+  ++data.next_texture_id.value;
+
+  data.render_targets.try_emplace(texture_id, std::move(*render_target));
+  return texture_id;
+}
+
+auto OpenGLRenderer::render_to_target(const TextureID target_id, const ImDrawData& draw_data)
+    -> bool
+{
+  const auto iter = m_data->render_targets.find(target_id);
+  if (iter == m_data->render_targets.end()) {
+    return false;
+  }
+
+  GLint previous_framebuffer_id {};
+  glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer_id);
+
+  GLfloat previous_clear_color[4] {};
+  glGetFloatv(GL_COLOR_CLEAR_VALUE, previous_clear_color);
+
+  const auto was_scissor_test_enabled = glIsEnabled(GL_SCISSOR_TEST) == GL_TRUE;
+
+  glBindFramebuffer(GL_FRAMEBUFFER, iter->second.get_framebuffer_id());
+
+  // Scissor tests also affect clears, so make sure that the entire target is cleared.
+  glDisable(GL_SCISSOR_TEST);
+  glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+  glClear(GL_COLOR_BUFFER_BIT);
+
+  // The backend sets up (and restores) the viewport based on the draw data. Note that it
+  // doesn't modify the draw data, despite the non-const signature.
+  ImGui_ImplOpenGL3_RenderDrawData(const_cast<ImDrawData*>(&draw_data));
+
+  glBindFramebuffer(GL_FRAMEBUFFER, static_cast<unsigned>(previous_framebuffer_id));
+  glClearColor(previous_clear_color[0],
+               previous_clear_color[1],
+               previous_clear_color[2],
+               previous_clear_color[3]);
+
+  if (was_scissor_test_enabled) {
+    glEnable(GL_SCISSOR_TEST);
+  }
+
+  return glGetError() == GL_NONE;
+}
+
+auto OpenGLRenderer::is_render_target_flipped() const -> bool
+{
+  // OpenGL framebuffers use a bottom-left origin.
+  return true;
+}
+
+auto OpenGLRenderer::add_premultiplied_alpha_callback(ImDrawList& draw_list) -> bool
+{
+  // The backend restores its blending mode when the render state is reset.
+  draw_list.AddCallback(&_enable_premultiplied_alpha, nullptr);
+  return true;
+}
+
 void OpenGLRenderer::try_reload_fonts()
 {
   ImGui_ImplOpenGL3_DestroyFontsTexture();
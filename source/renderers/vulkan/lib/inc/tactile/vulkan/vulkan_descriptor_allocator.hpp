@@ -0,0 +1,112 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <algorithm>  // min
+#include <cstddef>    // size_t
+#include <cstdint>    // uint32_t
+#include <expected>   // expected
+#include <vector>     // vector
+
+#include <vulkan/vulkan.h>
+
+#include "tactile/base/prelude.hpp"
+#include "tactile/vulkan/api.hpp"
+#include "tactile/vulkan/vulkan_descriptor_pool.hpp"
+#include "tactile/vulkan/vulkan_descriptor_set.hpp"
+#include "tactile/vulkan/vulkan_descriptor_set_layout.hpp"
+
+namespace tactile::vk {
+
+/** The number of descriptor sets in the first pool of an allocator. */
+inline constexpr std::uint32_t kMinVulkanDescriptorPoolSize = 64;
+
+/** The maximum number of descriptor sets in any pool of an allocator. */
+inline constexpr std::uint32_t kMaxVulkanDescriptorPoolSize = 4'096;
+
+/**
+ * Returns the size of the next descriptor pool in a chain of pools.
+ *
+ * \details
+ * Each new pool is twice as large as the previous one, up to a limit.
+ *
+ * \param pool_count The number of existing pools.
+ *
+ * \return
+ * The maximum number of descriptor sets in the next pool.
+ */
+[[nodiscard]]
+constexpr auto get_next_vulkan_descriptor_pool_size(const std::size_t pool_count) noexcept
+    -> std::uint32_t
+{
+  auto pool_size = kMinVulkanDescriptorPoolSize;
+
+  for (std::size_t index = 0; index < pool_count && pool_size < kMaxVulkanDescriptorPoolSize;
+       ++index) {
+    pool_size *= 2;
+  }
+
+  return std::min(pool_size, kMaxVulkanDescriptorPoolSize);
+}
+
+/**
+ * Allocates texture descriptor sets from a growable chain of descriptor pools.
+ *
+ * \details
+ * A new, larger, pool is created whenever all existing pools are exhausted, so
+ * there is no fixed limit on the number of textures. Descriptor sets are
+ * returned to their pools when destroyed, and freed slots in older pools are
+ * reused by later allocations.
+ */
+class TACTILE_VULKAN_API VulkanDescriptorAllocator final
+{
+ public:
+  TACTILE_DELETE_COPY(VulkanDescriptorAllocator);
+  TACTILE_DEFAULT_MOVE(VulkanDescriptorAllocator);
+
+  VulkanDescriptorAllocator() = default;
+
+  ~VulkanDescriptorAllocator() noexcept = default;
+
+  /**
+   * Allocates a descriptor set for a sampled image.
+   *
+   * \param sampler      The sampler to use.
+   * \param image_view   The image view to sample.
+   * \param image_layout The layout of the image when sampled.
+   *
+   * \return
+   * A descriptor set if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  auto allocate_texture_set(VkSampler sampler,
+                            VkImageView image_view,
+                            VkImageLayout image_layout)
+      -> std::expected<VulkanDescriptorSet, VkResult>;
+
+  VkDevice device {VK_NULL_HANDLE};
+  VulkanDescriptorSetLayout layout {};
+  std::vector<VulkanDescriptorPool> pools {};
+
+ private:
+  [[nodiscard]]
+  auto _allocate_set() -> std::expected<VulkanDescriptorSet, VkResult>;
+
+  [[nodiscard]]
+  auto _try_allocate_set(VkDescriptorPool pool, VkDescriptorSet& descriptor_set) const
+      -> VkResult;
+};
+
+/**
+ * Creates a descriptor allocator for textures sampled by Dear ImGui.
+ *
+ * \param device The associated Vulkan device.
+ *
+ * \return
+ * A descriptor allocator if successful; an error code otherwise.
+ */
+[[nodiscard]]
+TACTILE_VULKAN_API auto create_vulkan_descriptor_allocator(VkDevice device)
+    -> std::expected<VulkanDescriptorAllocator, VkResult>;
+
+}  // namespace tactile::vk
@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include <cstdint>   // uint32_t
 #include <expected>  // expected
+#include <span>      // span
 
 #include <vulkan/vulkan.h>
 
@@ -28,6 +30,35 @@ class TACTILE_VULKAN_API VulkanDescriptorPool final
   void _destroy() noexcept;
 };
 
+/**
+ * Creates a descriptor pool that supports freeing individual descriptor sets.
+ *
+ * \param device     The associated Vulkan device.
+ * \param max_sets   The maximum number of descriptor sets in the pool.
+ * \param pool_sizes The number of descriptors of each type in the pool.
+ *
+ * \return
+ * A descriptor pool if successful; an error code otherwise.
+ */
+[[nodiscard]]
+TACTILE_VULKAN_API auto create_vulkan_descriptor_pool(
+    VkDevice device,
+    std::uint32_t max_sets,
+    std::span<const VkDescriptorPoolSize> pool_sizes)
+    -> std::expected<VulkanDescriptorPool, VkResult>;
+
+/**
+ * Creates the descriptor pool used by the Dear ImGui backend.
+ *
+ * \details
+ * The backend only allocates the font texture descriptor set from this pool,
+ * other textures use a \c VulkanDescriptorAllocator.
+ *
+ * \param device The associated Vulkan device.
+ *
+ * \return
+ * A descriptor pool if successful; an error code otherwise.
+ */
 [[nodiscard]]
 TACTILE_VULKAN_API auto create_vulkan_imgui_descriptor_pool(VkDevice device)
     -> std::expected<VulkanDescriptorPool, VkResult>;
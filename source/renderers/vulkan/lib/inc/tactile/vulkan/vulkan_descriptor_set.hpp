@@ -0,0 +1,37 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "tactile/base/prelude.hpp"
+#include "tactile/vulkan/api.hpp"
+
+namespace tactile::vk {
+
+/**
+ * Represents a descriptor set that is returned to its pool when destroyed.
+ *
+ * \details
+ * Descriptor sets must be destroyed before the descriptor pool they were
+ * allocated from.
+ */
+class TACTILE_VULKAN_API VulkanDescriptorSet final
+{
+ public:
+  TACTILE_DELETE_COPY(VulkanDescriptorSet);
+  TACTILE_DECLARE_MOVE(VulkanDescriptorSet);
+
+  VulkanDescriptorSet() noexcept = default;
+
+  ~VulkanDescriptorSet() noexcept;
+
+  VkDevice device {VK_NULL_HANDLE};
+  VkDescriptorPool pool {VK_NULL_HANDLE};
+  VkDescriptorSet handle {VK_NULL_HANDLE};
+
+ private:
+  void _destroy() noexcept;
+};
+
+}  // namespace tactile::vk
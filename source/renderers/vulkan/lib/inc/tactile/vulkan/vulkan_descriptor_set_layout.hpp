@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <expected>  // expected
+
 #include <vulkan/vulkan.h>
 
 #include "tactile/base/prelude.hpp"
@@ -26,4 +28,21 @@ class TACTILE_VULKAN_API VulkanDescriptorSetLayout final
   void _destroy() noexcept;
 };
 
+/**
+ * Creates a descriptor set layout for a single combined image sampler.
+ *
+ * \details
+ * The layout is identical to the one used by the Dear ImGui backend for
+ * textures, so descriptor sets with this layout can be used as ImGui texture
+ * identifiers.
+ *
+ * \param device The associated Vulkan device.
+ *
+ * \return
+ * A descriptor set layout if successful; an error code otherwise.
+ */
+[[nodiscard]]
+TACTILE_VULKAN_API auto create_vulkan_texture_descriptor_set_layout(VkDevice device)
+    -> std::expected<VulkanDescriptorSetLayout, VkResult>;
+
 }  // namespace tactile::vk
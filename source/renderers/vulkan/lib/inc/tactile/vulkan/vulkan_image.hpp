@@ -40,6 +40,40 @@ class TACTILE_VULKAN_API VulkanImage final
   VmaAllocation allocation {VK_NULL_HANDLE};
   VulkanImageParams params {};
 
+  /**
+   * Records a transition of all mip levels to a new layout.
+   *
+   * \param command_buffer The command buffer to record to.
+   * \param new_layout     The new image layout.
+   */
+  void record_change_layout(VkCommandBuffer command_buffer, VkImageLayout new_layout);
+
+  /**
+   * Records a copy of buffer data to the first mip level.
+   *
+   * \details
+   * The image must be in the transfer destination layout when the commands
+   * are executed.
+   *
+   * \param command_buffer The command buffer to record to.
+   * \param buffer         The source buffer.
+   * \param buffer_offset  The offset of the image data in the source buffer.
+   */
+  void record_copy_buffer(VkCommandBuffer command_buffer,
+                          VkBuffer buffer,
+                          VkDeviceSize buffer_offset) const;
+
+  /**
+   * Records the generation of all mip levels from the first mip level.
+   *
+   * \details
+   * The image must be in the transfer destination layout when the commands
+   * are executed. All mip levels are left in the shader read-only layout.
+   *
+   * \param command_buffer The command buffer to record to.
+   */
+  void record_generate_mipmaps(VkCommandBuffer command_buffer);
+
   [[nodiscard]]
   auto change_layout(VkDevice device,
                      VkQueue queue,
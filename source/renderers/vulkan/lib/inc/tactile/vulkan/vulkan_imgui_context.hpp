@@ -35,6 +35,9 @@ class TACTILE_VULKAN_API VulkanImGuiContext final
   [[nodiscard]]
   auto get_pipeline() const -> VkPipeline;
 
+  [[nodiscard]]
+  auto get_premultiplied_alpha_pipeline() const -> VkPipeline;
+
  private:
   ImGuiContext* m_ctx {};
   ScopeExit m_context_deleter {};
@@ -43,6 +46,7 @@ class TACTILE_VULKAN_API VulkanImGuiContext final
   VulkanDescriptorSetLayout m_descriptor_set_layout {};
   VulkanPipelineLayout m_pipeline_layout {};
   VulkanPipeline m_pipeline {};
+  VulkanPipeline m_premultiplied_alpha_pipeline {};
 };
 
 }  // namespace tactile::vk
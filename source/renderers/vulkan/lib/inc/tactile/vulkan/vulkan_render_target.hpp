@@ -0,0 +1,68 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <expected>    // expected
+#include <filesystem>  // path
+
+#include <vk_mem_alloc.h>
+#include <vulkan/vulkan.h>
+
+#include "tactile/base/prelude.hpp"
+#include "tactile/base/render/texture.hpp"
+#include "tactile/vulkan/api.hpp"
+#include "tactile/vulkan/vulkan_descriptor_allocator.hpp"
+#include "tactile/vulkan/vulkan_descriptor_set.hpp"
+#include "tactile/vulkan/vulkan_image.hpp"
+#include "tactile/vulkan/vulkan_image_view.hpp"
+
+namespace tactile::vk {
+
+/**
+ * Represents an offscreen render target that can be sampled as a texture.
+ *
+ * \details
+ * The color image is kept in the shader read-only layout between uses. A depth
+ * image is included since the Dear ImGui pipeline is created with a depth
+ * attachment format.
+ */
+class TACTILE_VULKAN_API VulkanRenderTarget final : public ITexture
+{
+ public:
+  TACTILE_DELETE_COPY(VulkanRenderTarget);
+  TACTILE_DECLARE_MOVE(VulkanRenderTarget);
+
+  VulkanRenderTarget() = default;
+
+  ~VulkanRenderTarget() noexcept override = default;
+
+  [[nodiscard]]
+  auto get_handle() const -> void* override;
+
+  [[nodiscard]]
+  auto get_size() const -> TextureSize override;
+
+  [[nodiscard]]
+  auto get_path() const -> const std::filesystem::path& override;
+
+  VulkanImage color_image {};
+  VulkanImageView color_view {};
+  VulkanImage depth_image {};
+  VulkanImageView depth_view {};
+  std::filesystem::path path {};
+  VulkanDescriptorSet descriptor_set {};
+};
+
+[[nodiscard]]
+TACTILE_VULKAN_API auto create_vulkan_render_target(VkDevice device,
+                                                    VkQueue queue,
+                                                    VkCommandPool command_pool,
+                                                    VmaAllocator allocator,
+                                                    VulkanDescriptorAllocator& descriptor_allocator,
+                                                    VkSampler sampler,
+                                                    VkExtent2D extent,
+                                                    VkFormat color_format,
+                                                    VkFormat depth_format)
+    -> std::expected<VulkanRenderTarget, VkResult>;
+
+}  // namespace tactile::vk
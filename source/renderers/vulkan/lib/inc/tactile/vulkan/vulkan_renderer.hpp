@@ -16,16 +16,21 @@
 #include "tactile/vulkan/vulkan_allocator.hpp"
 #include "tactile/vulkan/vulkan_command_buffer.hpp"
 #include "tactile/vulkan/vulkan_command_pool.hpp"
+#include "tactile/vulkan/vulkan_descriptor_allocator.hpp"
 #include "tactile/vulkan/vulkan_descriptor_pool.hpp"
 #include "tactile/vulkan/vulkan_device.hpp"
 #include "tactile/vulkan/vulkan_fence.hpp"
 #include "tactile/vulkan/vulkan_imgui_context.hpp"
 #include "tactile/vulkan/vulkan_instance.hpp"
+#include "tactile/vulkan/vulkan_render_target.hpp"
 #include "tactile/vulkan/vulkan_sampler.hpp"
 #include "tactile/vulkan/vulkan_semaphore.hpp"
 #include "tactile/vulkan/vulkan_surface.hpp"
 #include "tactile/vulkan/vulkan_swapchain.hpp"
 #include "tactile/vulkan/vulkan_texture.hpp"
+#include "tactile/vulkan/vulkan_texture_uploader.hpp"
+
+struct ImDrawCmd;
 
 namespace tactile::vk {
 
@@ -61,6 +66,19 @@ class TACTILE_VULKAN_API VulkanRenderer final : public IRenderer
   [[nodiscard]]
   auto find_texture(TextureID id) const -> const ITexture* override;
 
+  [[nodiscard]]
+  auto create_render_target(const TextureSize& size)
+      -> std::expected<TextureID, ErrorCode> override;
+
+  [[nodiscard]]
+  auto render_to_target(TextureID target_id, const ImDrawData& draw_data) -> bool override;
+
+  [[nodiscard]]
+  auto is_render_target_flipped() const -> bool override;
+
+  [[nodiscard]]
+  auto add_premultiplied_alpha_callback(ImDrawList& draw_list) -> bool override;
+
   void try_reload_fonts() override;
 
   [[nodiscard]]
@@ -94,16 +112,26 @@ class TACTILE_VULKAN_API VulkanRenderer final : public IRenderer
   VkQueue m_graphics_queue {VK_NULL_HANDLE};
   VkQueue m_present_queue {VK_NULL_HANDLE};
   VulkanDescriptorPool m_imgui_descriptor_pool {};
+  VulkanDescriptorAllocator m_descriptor_allocator {};
+  VulkanTextureUploader m_texture_uploader {};
   PFN_vkCmdBeginRenderingKHR m_vkCmdBeginRendering {};
   PFN_vkCmdEndRenderingKHR m_vkCmdEndRendering {};
   std::vector<VulkanFrame> m_frames {};
   std::size_t m_frame_index {0};
   VulkanImGuiContext m_imgui_context {};
   std::unordered_map<TextureID, VulkanTexture> m_textures {};
+  std::unordered_map<TextureID, VulkanRenderTarget> m_render_targets {};
   TextureID m_next_texture_id {1};
+  VkCommandBuffer m_imgui_command_buffer {VK_NULL_HANDLE};
+
+  static void _enable_premultiplied_alpha(const ImDrawList* draw_list, const ImDrawCmd* cmd);
 
   void _record_commands() const;
 
+  void _record_render_target_commands(VkCommandBuffer command_buffer,
+                                      const VulkanRenderTarget& render_target,
+                                      const ImDrawData& draw_data) const;
+
   [[nodiscard]]
   static auto _reset_and_begin_command_buffer(const VulkanFrame& frame) -> VkResult;
 
@@ -125,6 +153,8 @@ class TACTILE_VULKAN_API VulkanRenderer final : public IRenderer
 
   [[nodiscard]]
   auto _recreate_swapchain() -> VkResult;
+
+  void _flush_texture_uploads();
 };
 
 }  // namespace tactile::vk
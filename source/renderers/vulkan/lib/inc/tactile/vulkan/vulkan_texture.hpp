@@ -12,8 +12,11 @@
 #include "tactile/base/render/renderer_options.hpp"
 #include "tactile/base/render/texture.hpp"
 #include "tactile/vulkan/api.hpp"
+#include "tactile/vulkan/vulkan_descriptor_allocator.hpp"
+#include "tactile/vulkan/vulkan_descriptor_set.hpp"
 #include "tactile/vulkan/vulkan_image.hpp"
-#include "vulkan_image_view.hpp"
+#include "tactile/vulkan/vulkan_image_view.hpp"
+#include "tactile/vulkan/vulkan_texture_uploader.hpp"
 
 namespace tactile::vk {
 
@@ -32,13 +35,31 @@ class TACTILE_VULKAN_API VulkanTexture final : public ITexture
   VulkanImage image {};
   VulkanImageView view {};
   std::filesystem::path path {};
-  void* imgui_handle {};
+  VulkanDescriptorSet descriptor_set {};
 };
 
+/**
+ * Loads a texture from an image file.
+ *
+ * \details
+ * The pixel data is only recorded for upload, the texture must not be sampled
+ * before the pending uploads of the uploader have been flushed.
+ *
+ * \param device               The associated Vulkan device.
+ * \param uploader             The uploader used to transfer the pixel data.
+ * \param descriptor_allocator The allocator used for the texture descriptor set.
+ * \param allocator            The associated memory allocator.
+ * \param sampler              The sampler used by the texture descriptor set.
+ * \param image_path           The path to the image file.
+ * \param options              The renderer options.
+ *
+ * \return
+ * A texture if successful; an error code otherwise.
+ */
 [[nodiscard]]
 TACTILE_VULKAN_API auto load_vulkan_texture(VkDevice device,
-                                            VkQueue queue,
-                                            VkCommandPool command_pool,
+                                            VulkanTextureUploader& uploader,
+                                            VulkanDescriptorAllocator& descriptor_allocator,
                                             VmaAllocator allocator,
                                             VkSampler sampler,
                                             const std::filesystem::path& image_path,
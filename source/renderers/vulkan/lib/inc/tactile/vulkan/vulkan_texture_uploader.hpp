@@ -0,0 +1,173 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>   // size_t
+#include <cstdint>   // uint32_t, uint64_t
+#include <expected>  // expected
+#include <optional>  // optional, nullopt
+#include <vector>    // vector
+
+#include <vk_mem_alloc.h>
+#include <vulkan/vulkan.h>
+
+#include "tactile/base/prelude.hpp"
+#include "tactile/vulkan/api.hpp"
+#include "tactile/vulkan/vulkan_buffer.hpp"
+#include "tactile/vulkan/vulkan_command_buffer.hpp"
+#include "tactile/vulkan/vulkan_fence.hpp"
+#include "tactile/vulkan/vulkan_image.hpp"
+
+namespace tactile::vk {
+
+/** The size of the shared staging buffer used for texture uploads. */
+inline constexpr std::uint64_t kVulkanStagingBufferSize = std::uint64_t {32} << 20u;
+
+/**
+ * Tracks the used part of a linearly sub-allocated staging buffer.
+ */
+struct VulkanStagingArena final
+{
+  /** The total size of the staging buffer, in bytes. */
+  std::uint64_t capacity;
+
+  /** The offset of the first unused byte. */
+  std::uint64_t offset;
+};
+
+/**
+ * Reserves a range of a staging arena.
+ *
+ * \details
+ * The alignment doesn't need to be a power of two, since buffer to image copy
+ * offsets must be multiples of the texel size, which is three for RGB images.
+ *
+ * \param arena     The staging arena to allocate from.
+ * \param size      The number of bytes to reserve.
+ * \param alignment The required alignment of the range offset.
+ *
+ * \return
+ * The offset of the reserved range if successful; an empty optional otherwise.
+ */
+[[nodiscard]]
+constexpr auto allocate_vulkan_staging_range(VulkanStagingArena& arena,
+                                             const std::uint64_t size,
+                                             const std::uint64_t alignment) noexcept
+    -> std::optional<std::uint64_t>
+{
+  const auto aligned_offset = (arena.offset + alignment - 1) / alignment * alignment;
+
+  if (aligned_offset > arena.capacity || size > arena.capacity - aligned_offset) {
+    return std::nullopt;
+  }
+
+  arena.offset = aligned_offset + size;
+  return aligned_offset;
+}
+
+/**
+ * Records texture uploads into a single command buffer that is submitted once.
+ *
+ * \details
+ * Pixel data is copied into sub-ranges of a shared staging buffer, and the
+ * layout transitions, copies, and mipmap generation of all pending uploads are
+ * recorded into the same command buffer. Pending uploads are submitted using a
+ * single queue submission when flushed, which happens at most once per frame
+ * when loading many textures at once.
+ *
+ * Images that don't fit in the shared staging buffer get a dedicated staging
+ * buffer, which is kept alive until the next flush.
+ */
+class TACTILE_VULKAN_API VulkanTextureUploader final
+{
+ public:
+  TACTILE_DELETE_COPY(VulkanTextureUploader);
+  TACTILE_DEFAULT_MOVE(VulkanTextureUploader);
+
+  VulkanTextureUploader() = default;
+
+  ~VulkanTextureUploader() noexcept = default;
+
+  /**
+   * Records the upload of pixel data to an image.
+   *
+   * \details
+   * The image is left in the shader read-only layout once the upload has been
+   * flushed. This function might flush pending uploads if the staging buffer
+   * is full.
+   *
+   * \param image            The target image, in the undefined layout.
+   * \param pixels           The pixel data.
+   * \param pixel_bytes      The size of the pixel data, in bytes.
+   * \param texel_size       The size of a single texel, in bytes.
+   * \param generate_mipmaps Whether to generate all mip levels of the image.
+   *
+   * \return
+   * \c VK_SUCCESS on success; an error code otherwise.
+   */
+  [[nodiscard]]
+  auto upload(VulkanImage& image,
+              const void* pixels,
+              std::uint64_t pixel_bytes,
+              std::uint32_t texel_size,
+              bool generate_mipmaps) -> VkResult;
+
+  /**
+   * Submits all pending uploads and waits for them to finish.
+   *
+   * \return
+   * \c VK_SUCCESS on success; an error code otherwise.
+   */
+  [[nodiscard]]
+  auto flush() -> VkResult;
+
+  /**
+   * Indicates whether there are uploads that haven't been submitted.
+   *
+   * \return
+   * True if there are pending uploads; false otherwise.
+   */
+  [[nodiscard]]
+  auto has_pending_uploads() const noexcept -> bool;
+
+  VkDevice device {VK_NULL_HANDLE};
+  VkQueue queue {VK_NULL_HANDLE};
+  VmaAllocator allocator {VK_NULL_HANDLE};
+  VulkanCommandBuffer command_buffer {};
+  VulkanFence fence {};
+  VulkanBuffer staging_buffer {};
+  VulkanStagingArena staging_arena {};
+  std::vector<VulkanBuffer> dedicated_staging_buffers {};
+  std::size_t pending_upload_count {0};
+  bool is_recording {false};
+
+ private:
+  [[nodiscard]]
+  auto _begin_recording() -> VkResult;
+
+  [[nodiscard]]
+  auto _write_staging_data(const void* pixels, std::uint64_t pixel_bytes, std::uint64_t offset)
+      -> VkResult;
+
+  void _reset() noexcept;
+};
+
+/**
+ * Creates a texture uploader.
+ *
+ * \param device       The associated Vulkan device.
+ * \param queue        The queue used to submit uploads.
+ * \param command_pool The command pool to allocate the upload command buffer from.
+ * \param allocator    The associated allocator.
+ *
+ * \return
+ * A texture uploader if successful; an error code otherwise.
+ */
+[[nodiscard]]
+TACTILE_VULKAN_API auto create_vulkan_texture_uploader(VkDevice device,
+                                                       VkQueue queue,
+                                                       VkCommandPool command_pool,
+                                                       VmaAllocator allocator)
+    -> std::expected<VulkanTextureUploader, VkResult>;
+
+}  // namespace tactile::vk
@@ -0,0 +1,134 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/vulkan/vulkan_descriptor_allocator.hpp"
+
+#include <ranges>   // views::reverse
+#include <utility>  // move
+
+#include "tactile/vulkan/logging.hpp"
+#include "tactile/vulkan/vulkan_util.hpp"
+
+namespace tactile::vk {
+namespace {
+
+// Indicates whether an allocation failed because the pool was full.
+[[nodiscard]]
+constexpr auto _is_pool_exhausted(const VkResult result) noexcept -> bool
+{
+  return result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL;
+}
+
+}  // namespace
+
+auto VulkanDescriptorAllocator::allocate_texture_set(VkSampler sampler,
+                                                     VkImageView image_view,
+                                                     const VkImageLayout image_layout)
+    -> std::expected<VulkanDescriptorSet, VkResult>
+{
+  auto descriptor_set = _allocate_set();
+  if (!descriptor_set.has_value()) {
+    return std::unexpected {descriptor_set.error()};
+  }
+
+  const VkDescriptorImageInfo image_info {
+    .sampler = sampler,
+    .imageView = image_view,
+    .imageLayout = image_layout,
+  };
+
+  const VkWriteDescriptorSet descriptor_write {
+    .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+    .pNext = nullptr,
+    .dstSet = descriptor_set->handle,
+    .dstBinding = 0,
+    .dstArrayElement = 0,
+    .descriptorCount = 1,
+    .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    .pImageInfo = &image_info,
+    .pBufferInfo = nullptr,
+    .pTexelBufferView = nullptr,
+  };
+
+  vkUpdateDescriptorSets(device, 1, &descriptor_write, 0, nullptr);
+
+  return descriptor_set;
+}
+
+auto VulkanDescriptorAllocator::_allocate_set() -> std::expected<VulkanDescriptorSet, VkResult>
+{
+  VulkanDescriptorSet descriptor_set {};
+  descriptor_set.device = device;
+
+  // Newer pools are larger and more likely to have free slots, so they are tried first.
+  for (const auto& pool : pools | std::views::reverse) {
+    const auto result = _try_allocate_set(pool.handle, descriptor_set.handle);
+
+    if (result == VK_SUCCESS) {
+      descriptor_set.pool = pool.handle;
+      return descriptor_set;
+    }
+
+    if (!_is_pool_exhausted(result)) {
+      TACTILE_VULKAN_ERROR("Could not allocate Vulkan descriptor set: {}", to_string(result));
+      return std::unexpected {result};
+    }
+  }
+
+  const auto pool_size = get_next_vulkan_descriptor_pool_size(pools.size());
+  const VkDescriptorPoolSize pool_sizes[] = {
+    VkDescriptorPoolSize {
+      .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+      .descriptorCount = pool_size,
+    },
+  };
+
+  auto pool = create_vulkan_descriptor_pool(device, pool_size, pool_sizes);
+  if (!pool.has_value()) {
+    return std::unexpected {pool.error()};
+  }
+
+  TACTILE_VULKAN_DEBUG("Created Vulkan descriptor pool with {} sets", pool_size);
+
+  const auto result = _try_allocate_set(pool->handle, descriptor_set.handle);
+  if (result != VK_SUCCESS) {
+    TACTILE_VULKAN_ERROR("Could not allocate Vulkan descriptor set: {}", to_string(result));
+    return std::unexpected {result};
+  }
+
+  descriptor_set.pool = pool->handle;
+  pools.push_back(std::move(*pool));
+
+  return descriptor_set;
+}
+
+auto VulkanDescriptorAllocator::_try_allocate_set(VkDescriptorPool pool,
+                                                  VkDescriptorSet& descriptor_set) const
+    -> VkResult
+{
+  const VkDescriptorSetAllocateInfo allocate_info {
+    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+    .pNext = nullptr,
+    .descriptorPool = pool,
+    .descriptorSetCount = 1,
+    .pSetLayouts = &layout.handle,
+  };
+
+  return vkAllocateDescriptorSets(device, &allocate_info, &descriptor_set);
+}
+
+auto create_vulkan_descriptor_allocator(VkDevice device)
+    -> std::expected<VulkanDescriptorAllocator, VkResult>
+{
+  auto layout = create_vulkan_texture_descriptor_set_layout(device);
+  if (!layout.has_value()) {
+    return std::unexpected {layout.error()};
+  }
+
+  VulkanDescriptorAllocator allocator {};
+  allocator.device = device;
+  allocator.layout = std::move(*layout);
+
+  return allocator;
+}
+
+}  // namespace tactile::vk
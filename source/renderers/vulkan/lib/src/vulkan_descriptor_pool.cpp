@@ -40,23 +40,18 @@ void VulkanDescriptorPool::_destroy() noexcept
   }
 }
 
-auto create_vulkan_imgui_descriptor_pool(VkDevice device)
+auto create_vulkan_descriptor_pool(VkDevice device,
+                                   const std::uint32_t max_sets,
+                                   const std::span<const VkDescriptorPoolSize> pool_sizes)
     -> std::expected<VulkanDescriptorPool, VkResult>
 {
-  constexpr VkDescriptorPoolSize pool_sizes[] = {
-    VkDescriptorPoolSize {
-      .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-      .descriptorCount = 8,
-    },
-  };
-
   const VkDescriptorPoolCreateInfo descriptor_pool_info {
     .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
     .pNext = nullptr,
     .flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
-    .maxSets = 64,
-    .poolSizeCount = 1,
-    .pPoolSizes = pool_sizes,
+    .maxSets = max_sets,
+    .poolSizeCount = static_cast<std::uint32_t>(pool_sizes.size()),
+    .pPoolSizes = pool_sizes.data(),
   };
 
   VulkanDescriptorPool descriptor_pool {};
@@ -66,12 +61,24 @@ auto create_vulkan_imgui_descriptor_pool(VkDevice device)
       vkCreateDescriptorPool(device, &descriptor_pool_info, nullptr, &descriptor_pool.handle);
 
   if (result != VK_SUCCESS) {
-    TACTILE_VULKAN_ERROR("Could not create Vulkan ImGui descriptor pool: {}",
-                         to_string(result));
+    TACTILE_VULKAN_ERROR("Could not create Vulkan descriptor pool: {}", to_string(result));
     return std::unexpected {result};
   }
 
   return descriptor_pool;
 }
 
+auto create_vulkan_imgui_descriptor_pool(VkDevice device)
+    -> std::expected<VulkanDescriptorPool, VkResult>
+{
+  constexpr VkDescriptorPoolSize pool_sizes[] = {
+    VkDescriptorPoolSize {
+      .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+      .descriptorCount = 8,
+    },
+  };
+
+  return create_vulkan_descriptor_pool(device, 8, pool_sizes);
+}
+
 }  // namespace tactile::vk
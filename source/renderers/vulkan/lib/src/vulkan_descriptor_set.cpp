@@ -0,0 +1,43 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/vulkan/vulkan_descriptor_set.hpp"
+
+#include <tuple>    // ignore
+#include <utility>  // exchange
+
+namespace tactile::vk {
+
+VulkanDescriptorSet::VulkanDescriptorSet(VulkanDescriptorSet&& other) noexcept
+  : device {std::exchange(other.device, VK_NULL_HANDLE)},
+    pool {std::exchange(other.pool, VK_NULL_HANDLE)},
+    handle {std::exchange(other.handle, VK_NULL_HANDLE)}
+{}
+
+VulkanDescriptorSet::~VulkanDescriptorSet() noexcept
+{
+  _destroy();
+}
+
+auto VulkanDescriptorSet::operator=(VulkanDescriptorSet&& other) noexcept
+    -> VulkanDescriptorSet&
+{
+  if (this != &other) {
+    _destroy();
+
+    device = std::exchange(other.device, VK_NULL_HANDLE);
+    pool = std::exchange(other.pool, VK_NULL_HANDLE);
+    handle = std::exchange(other.handle, VK_NULL_HANDLE);
+  }
+
+  return *this;
+}
+
+void VulkanDescriptorSet::_destroy() noexcept
+{
+  if (handle != VK_NULL_HANDLE) {
+    std::ignore = vkFreeDescriptorSets(device, pool, 1, &handle);
+    handle = VK_NULL_HANDLE;
+  }
+}
+
+}  // namespace tactile::vk
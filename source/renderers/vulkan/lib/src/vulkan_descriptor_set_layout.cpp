@@ -4,6 +4,9 @@
 
 #include <utility>  // exchange
 
+#include "tactile/vulkan/logging.hpp"
+#include "tactile/vulkan/vulkan_util.hpp"
+
 namespace tactile::vk {
 
 VulkanDescriptorSetLayout::VulkanDescriptorSetLayout(
@@ -38,4 +41,37 @@ void VulkanDescriptorSetLayout::_destroy() noexcept
   }
 }
 
+auto create_vulkan_texture_descriptor_set_layout(VkDevice device)
+    -> std::expected<VulkanDescriptorSetLayout, VkResult>
+{
+  constexpr VkDescriptorSetLayoutBinding binding {
+    .binding = 0,
+    .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    .descriptorCount = 1,
+    .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
+    .pImmutableSamplers = nullptr,
+  };
+
+  const VkDescriptorSetLayoutCreateInfo layout_info {
+    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+    .pNext = nullptr,
+    .flags = 0,
+    .bindingCount = 1,
+    .pBindings = &binding,
+  };
+
+  VulkanDescriptorSetLayout layout {};
+  layout.device = device;
+
+  const auto result = vkCreateDescriptorSetLayout(device, &layout_info, nullptr, &layout.handle);
+
+  if (result != VK_SUCCESS) {
+    TACTILE_VULKAN_ERROR("Could not create Vulkan descriptor set layout: {}",
+                         to_string(result));
+    return std::unexpected {result};
+  }
+
+  return layout;
+}
+
 }  // namespace tactile::vk
@@ -114,6 +114,123 @@ void VulkanImage::_destroy() noexcept
   }
 }
 
+void VulkanImage::record_change_layout(VkCommandBuffer command_buffer,
+                                       const VkImageLayout new_layout)
+{
+  if (params.layout == new_layout) {
+    return;
+  }
+
+  _do_change_layout(command_buffer, handle, params.layout, new_layout, 0, params.mip_levels);
+  params.layout = new_layout;
+}
+
+void VulkanImage::record_copy_buffer(VkCommandBuffer command_buffer,
+                                     VkBuffer buffer,
+                                     const VkDeviceSize buffer_offset) const
+{
+  const VkBufferImageCopy region = {
+    .bufferOffset = buffer_offset,
+    .bufferRowLength = 0,
+    .bufferImageHeight = 0,
+    .imageSubresource =
+        VkImageSubresourceLayers {
+          .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+          .mipLevel = 0,
+          .baseArrayLayer = 0,
+          .layerCount = 1,
+        },
+    .imageOffset = VkOffset3D {0, 0, 0},
+    .imageExtent = VkExtent3D {params.extent.width, params.extent.height, 1},
+  };
+
+  vkCmdCopyBufferToImage(command_buffer, buffer, handle, params.layout, 1, &region);
+}
+
+void VulkanImage::record_generate_mipmaps(VkCommandBuffer command_buffer)
+{
+  assert(params.mip_levels > 0);
+
+  auto mip_width = params.extent.width;
+  auto mip_height = params.extent.height;
+
+  for (std::uint32_t mip_level = 1u; mip_level < params.mip_levels; ++mip_level) {
+    const std::uint32_t base_mip_level = mip_level - 1u;
+
+    _do_change_layout(command_buffer,
+                      handle,
+                      params.layout,
+                      VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                      base_mip_level,
+                      1);
+
+    const VkImageBlit image_blit {
+      .srcSubresource =
+          VkImageSubresourceLayers {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .mipLevel = base_mip_level,
+            .baseArrayLayer = 0,
+            .layerCount = 1,
+          },
+      .srcOffsets =
+          {
+            VkOffset3D {0, 0, 0},
+            VkOffset3D {static_cast<std::int32_t>(mip_width),
+                        static_cast<std::int32_t>(mip_height),
+                        1},
+          },
+      .dstSubresource =
+          VkImageSubresourceLayers {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .mipLevel = mip_level,
+            .baseArrayLayer = 0,
+            .layerCount = 1,
+          },
+      .dstOffsets =
+          {
+            VkOffset3D {0, 0, 0},
+            VkOffset3D {static_cast<std::int32_t>(mip_width > 1 ? (mip_width / 2) : 1),
+                        static_cast<std::int32_t>(mip_height > 1 ? (mip_height / 2) : 1),
+                        1},
+          },
+    };
+
+    vkCmdBlitImage(command_buffer,
+                   handle,
+                   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                   handle,
+                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                   1,
+                   &image_blit,
+                   VK_FILTER_NEAREST);
+
+    _do_change_layout(command_buffer,
+                      handle,
+                      VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                      base_mip_level,
+                      1);
+
+    if (mip_width > 1) {
+      mip_width /= 2;
+    }
+
+    if (mip_height > 1) {
+      mip_height /= 2;
+    }
+  }
+
+  // Transition the last mipmap image to the optimal shader read layout
+  _do_change_layout(command_buffer,
+                    handle,
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                    params.mip_levels - 1,
+                    1);
+
+  params.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+}
+
 auto VulkanImage::change_layout(VkDevice device,
                                 VkQueue queue,
                                 VkCommandPool command_pool,
@@ -124,8 +241,7 @@ auto VulkanImage::change_layout(VkDevice device,
   }
 
   const auto work = [this, new_layout](VkCommandBuffer command_buffer) {
-    _do_change_layout(command_buffer, handle, params.layout, new_layout, 0, params.mip_levels);
-    params.layout = new_layout;
+    record_change_layout(command_buffer, new_layout);
   };
 
   return record_and_submit_commands(device, queue, command_pool, work);
@@ -171,23 +287,8 @@ auto VulkanImage::copy_buffer(VkDevice device,
                               VkCommandPool command_pool,
                               VkBuffer buffer) -> VkResult
 {
-  auto work = [&](VkCommandBuffer command_buffer) {
-    const VkBufferImageCopy region = {
-      .bufferOffset = 0,
-      .bufferRowLength = 0,
-      .bufferImageHeight = 0,
-      .imageSubresource =
-          VkImageSubresourceLayers {
-            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-            .mipLevel = 0,
-            .baseArrayLayer = 0,
-            .layerCount = 1,
-          },
-      .imageOffset = VkOffset3D {0, 0, 0},
-      .imageExtent = VkExtent3D {params.extent.width, params.extent.height, 1},
-    };
-
-    vkCmdCopyBufferToImage(command_buffer, buffer, handle, params.layout, 1, &region);
+  const auto work = [this, buffer](VkCommandBuffer command_buffer) {
+    record_copy_buffer(command_buffer, buffer, 0);
   };
 
   return record_and_submit_commands(device, queue, command_pool, work);
@@ -196,87 +297,8 @@ auto VulkanImage::copy_buffer(VkDevice device,
 auto VulkanImage::generate_mipmaps(VkDevice device, VkQueue queue, VkCommandPool command_pool)
     -> VkResult
 {
-  assert(params.mip_levels > 0);
-
   const auto work = [this](VkCommandBuffer command_buffer) {
-    auto mip_width = params.extent.width;
-    auto mip_height = params.extent.height;
-
-    for (std::uint32_t mip_level = 1u; mip_level < params.mip_levels; ++mip_level) {
-      const std::uint32_t base_mip_level = mip_level - 1u;
-
-      _do_change_layout(command_buffer,
-                        handle,
-                        params.layout,
-                        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                        base_mip_level,
-                        1);
-
-      const VkImageBlit image_blit {
-        .srcSubresource =
-            VkImageSubresourceLayers {
-              .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-              .mipLevel = base_mip_level,
-              .baseArrayLayer = 0,
-              .layerCount = 1,
-            },
-        .srcOffsets =
-            {
-              VkOffset3D {0, 0, 0},
-              VkOffset3D {static_cast<std::int32_t>(mip_width),
-                          static_cast<std::int32_t>(mip_height),
-                          1},
-            },
-        .dstSubresource =
-            VkImageSubresourceLayers {
-              .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-              .mipLevel = mip_level,
-              .baseArrayLayer = 0,
-              .layerCount = 1,
-            },
-        .dstOffsets =
-            {
-              VkOffset3D {0, 0, 0},
-              VkOffset3D {static_cast<std::int32_t>(mip_width > 1 ? (mip_width / 2) : 1),
-                          static_cast<std::int32_t>(mip_height > 1 ? (mip_height / 2) : 1),
-                          1},
-            },
-      };
-
-      vkCmdBlitImage(command_buffer,
-                     handle,
-                     VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                     handle,
-                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                     1,
-                     &image_blit,
-                     VK_FILTER_NEAREST);
-
-      _do_change_layout(command_buffer,
-                        handle,
-                        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                        base_mip_level,
-                        1);
-
-      if (mip_width > 1) {
-        mip_width /= 2;
-      }
-
-      if (mip_height > 1) {
-        mip_height /= 2;
-      }
-    }
-
-    // Transition the last mipmap image to the optimal shader read layout
-    _do_change_layout(command_buffer,
-                      handle,
-                      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                      params.mip_levels - 1,
-                      1);
-
-    params.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    record_generate_mipmaps(command_buffer);
   };
 
   return record_and_submit_commands(device, queue, command_pool, work);
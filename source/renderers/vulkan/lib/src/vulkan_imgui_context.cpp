@@ -89,7 +89,8 @@ auto _create_imgui_pipeline_layout(VkDevice device,
 
 auto _create_imgui_graphics_pipeline(VkDevice device,
                                      VkPipelineLayout pipeline_layout,
-                                     const VkPipelineRenderingCreateInfoKHR& rendering_info)
+                                     const VkPipelineRenderingCreateInfoKHR& rendering_info,
+                                     const bool premultiplied_alpha)
     -> std::expected<VulkanPipeline, VkResult>
 {
   VulkanPipeline pipeline {};
@@ -209,9 +210,11 @@ auto _create_imgui_graphics_pipeline(VkDevice device,
     .alphaToOneEnable = VK_FALSE,
   };
 
-  constexpr VkPipelineColorBlendAttachmentState color_blend_attachment {
+  // Premultiplied colors have already been scaled by their alpha.
+  const VkPipelineColorBlendAttachmentState color_blend_attachment {
     .blendEnable = VK_TRUE,
-    .srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA,
+    .srcColorBlendFactor =
+        premultiplied_alpha ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_SRC_ALPHA,
     .dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
     .colorBlendOp = VK_BLEND_OP_ADD,
     .srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
@@ -350,13 +353,25 @@ auto VulkanImGuiContext::init(IWindow& window, ImGui_ImplVulkan_InitInfo& vulkan
   if (auto pipeline =
           _create_imgui_graphics_pipeline(vulkan_info.Device,
                                           context.m_pipeline_layout.handle,
-                                          vulkan_info.PipelineRenderingCreateInfo)) {
+                                          vulkan_info.PipelineRenderingCreateInfo,
+                                          false)) {
     context.m_pipeline = std::move(*pipeline);
   }
   else {
     return std::nullopt;
   }
 
+  if (auto pipeline =
+          _create_imgui_graphics_pipeline(vulkan_info.Device,
+                                          context.m_pipeline_layout.handle,
+                                          vulkan_info.PipelineRenderingCreateInfo,
+                                          true)) {
+    context.m_premultiplied_alpha_pipeline = std::move(*pipeline);
+  }
+  else {
+    return std::nullopt;
+  }
+
   return context;
 }
 
@@ -370,4 +385,9 @@ auto VulkanImGuiContext::get_pipeline() const -> VkPipeline
   return m_pipeline.handle;
 }
 
+auto VulkanImGuiContext::get_premultiplied_alpha_pipeline() const -> VkPipeline
+{
+  return m_premultiplied_alpha_pipeline.handle;
+}
+
 }  // namespace tactile::vk
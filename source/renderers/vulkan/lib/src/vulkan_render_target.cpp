@@ -0,0 +1,155 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/vulkan/vulkan_render_target.hpp"
+
+#include <utility>  // move
+
+#include "tactile/base/numeric/saturate_cast.hpp"
+#include "tactile/vulkan/logging.hpp"
+#include "tactile/vulkan/vulkan_util.hpp"
+
+namespace tactile::vk {
+
+VulkanRenderTarget::VulkanRenderTarget(VulkanRenderTarget&& other) noexcept
+  : color_image {std::move(other.color_image)},
+    color_view {std::move(other.color_view)},
+    depth_image {std::move(other.depth_image)},
+    depth_view {std::move(other.depth_view)},
+    path {std::move(other.path)},
+    descriptor_set {std::move(other.descriptor_set)}
+{}
+
+auto VulkanRenderTarget::operator=(VulkanRenderTarget&& other) noexcept
+    -> VulkanRenderTarget&
+{
+  if (this != &other) {
+    // The descriptor set and image views are replaced first, so that they never outlive
+    // the resources they refer to.
+    descriptor_set = std::move(other.descriptor_set);
+    color_view = std::move(other.color_view);
+    depth_view = std::move(other.depth_view);
+    color_image = std::move(other.color_image);
+    depth_image = std::move(other.depth_image);
+    path = std::move(other.path);
+  }
+
+  return *this;
+}
+
+auto VulkanRenderTarget::get_handle() const -> void*
+{
+  return descriptor_set.handle;
+}
+
+auto VulkanRenderTarget::get_size() const -> TextureSize
+{
+  return TextureSize {saturate_cast<int>(color_image.params.extent.width),
+                      saturate_cast<int>(color_image.params.extent.height)};
+}
+
+auto VulkanRenderTarget::get_path() const -> const std::filesystem::path&
+{
+  return path;
+}
+
+auto create_vulkan_render_target(VkDevice device,
+                                 VkQueue queue,
+                                 VkCommandPool command_pool,
+                                 VmaAllocator allocator,
+                                 VulkanDescriptorAllocator& descriptor_allocator,
+                                 VkSampler sampler,
+                                 const VkExtent2D extent,
+                                 const VkFormat color_format,
+                                 const VkFormat depth_format)
+    -> std::expected<VulkanRenderTarget, VkResult>
+{
+  if (extent.width == 0 || extent.height == 0) {
+    return std::unexpected {VK_ERROR_INITIALIZATION_FAILED};
+  }
+
+  auto color_image = create_vulkan_image(
+      allocator,
+      VulkanImageParams {
+        .type = VK_IMAGE_TYPE_2D,
+        .format = color_format,
+        .layout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .extent = extent,
+        .usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+        .mip_levels = 1,
+      });
+  if (!color_image.has_value()) {
+    TACTILE_VULKAN_ERROR("Could not create render target color image: {}",
+                         to_string(color_image.error()));
+    return std::unexpected {color_image.error()};
+  }
+
+  // Render targets are expected to be sampleable right away, even if nothing has been
+  // rendered to them yet.
+  const auto result = color_image->change_layout(device,
+                                                 queue,
+                                                 command_pool,
+                                                 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  if (result != VK_SUCCESS) {
+    return std::unexpected {result};
+  }
+
+  auto color_view = create_vulkan_image_view(device,
+                                             color_image->handle,
+                                             color_format,
+                                             VK_IMAGE_VIEW_TYPE_2D,
+                                             VK_IMAGE_ASPECT_COLOR_BIT,
+                                             1);
+  if (!color_view.has_value()) {
+    return std::unexpected {color_view.error()};
+  }
+
+  auto depth_image = create_vulkan_image(
+      allocator,
+      VulkanImageParams {
+        .type = VK_IMAGE_TYPE_2D,
+        .format = depth_format,
+        .layout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .extent = extent,
+        .usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+        .mip_levels = 1,
+      });
+  if (!depth_image.has_value()) {
+    TACTILE_VULKAN_ERROR("Could not create render target depth image: {}",
+                         to_string(depth_image.error()));
+    return std::unexpected {depth_image.error()};
+  }
+
+  auto depth_view = create_vulkan_image_view(device,
+                                             depth_image->handle,
+                                             depth_format,
+                                             VK_IMAGE_VIEW_TYPE_2D,
+                                             VK_IMAGE_ASPECT_DEPTH_BIT,
+                                             1);
+  if (!depth_view.has_value()) {
+    return std::unexpected {depth_view.error()};
+  }
+
+  VulkanRenderTarget render_target {};
+  render_target.color_image = std::move(*color_image);
+  render_target.color_view = std::move(*color_view);
+  render_target.depth_image = std::move(*depth_image);
+  render_target.depth_view = std::move(*depth_view);
+
+  // Render targets are recreated frequently, so their descriptor sets are returned to the
+  // allocator when destroyed.
+  auto descriptor_set =
+      descriptor_allocator.allocate_texture_set(sampler,
+                                                render_target.color_view.handle,
+                                                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  if (!descriptor_set.has_value()) {
+    TACTILE_VULKAN_ERROR("Could not allocate render target descriptor set: {}",
+                         to_string(descriptor_set.error()));
+    return std::unexpected {descriptor_set.error()};
+  }
+
+  render_target.descriptor_set = std::move(*descriptor_set);
+
+  return render_target;
+}
+
+}  // namespace tactile::vk
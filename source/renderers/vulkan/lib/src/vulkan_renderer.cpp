@@ -17,6 +17,7 @@
 #include "tactile/base/render/window.hpp"
 #include "tactile/vulkan/logging.hpp"
 #include "tactile/vulkan/vulkan_buffer.hpp"
+#include "tactile/vulkan/vulkan_command_pool.hpp"
 #include "tactile/vulkan/vulkan_physical_device.hpp"
 #include "tactile/vulkan/vulkan_util.hpp"
 
@@ -66,6 +67,7 @@ VulkanRenderer::VulkanRenderer(const RendererOptions& options, IWindow* window)
           .value()},
     m_sampler {create_vulkan_sampler(m_device.handle, m_options).value()},
     m_imgui_descriptor_pool {create_vulkan_imgui_descriptor_pool(m_device.handle).value()},
+    m_descriptor_allocator {create_vulkan_descriptor_allocator(m_device.handle).value()},
     m_vkCmdBeginRendering {reinterpret_cast<PFN_vkCmdBeginRenderingKHR>(
         vkGetInstanceProcAddr(m_instance.get(), "vkCmdBeginRenderingKHR"))},
     m_vkCmdEndRendering {reinterpret_cast<PFN_vkCmdEndRenderingKHR>(
@@ -79,6 +81,12 @@ VulkanRenderer::VulkanRenderer(const RendererOptions& options, IWindow* window)
     throw std::runtime_error {"Could not get Vulkan device queues"};
   }
 
+  m_texture_uploader = create_vulkan_texture_uploader(m_device.handle,
+                                                      m_graphics_queue,
+                                                      m_graphics_command_pool.handle,
+                                                      m_allocator.handle)
+                           .value();
+
   _init_frames(m_frames, m_device.handle, m_graphics_command_pool.handle);
 
   const VkPipelineRenderingCreateInfoKHR pipeline_rendering_info {
@@ -122,6 +130,9 @@ VulkanRenderer::~VulkanRenderer() noexcept
 
 auto VulkanRenderer::begin_frame() -> bool
 {
+  // Textures loaded since the last frame are uploaded using a single submission.
+  _flush_texture_uploads();
+
   const auto& frame = m_frames.at(m_frame_index);
 
   int width {};
@@ -180,6 +191,10 @@ auto VulkanRenderer::begin_frame() -> bool
 
 void VulkanRenderer::end_frame()
 {
+  // Textures loaded during the frame might be sampled by it.
+  _flush_texture_uploads();
+
+  m_imgui_command_buffer = m_frames.at(m_frame_index).command_buffer.handle;
   _record_commands();
   _submit_commands();
   _present_swapchain_image();
@@ -191,15 +206,15 @@ auto VulkanRenderer::load_texture(const std::filesystem::path& image_path)
     -> std::expected<TextureID, ErrorCode>
 {
   auto texture = load_vulkan_texture(m_device.handle,
-                                     m_graphics_queue,
-                                     m_graphics_command_pool.handle,
+                                     m_texture_uploader,
+                                     m_descriptor_allocator,
                                      m_allocator.handle,
                                      m_sampler.handle,
                                      image_path,
                                      m_options);
 
   if (!texture.has_value()) {
-    // TODO log error
+    TACTILE_VULKAN_ERROR("Could not load Vulkan texture: {}", to_string(texture.error()));
     return std::unexpected {ErrorCode::kBadImage};
   }
 
@@ -213,20 +228,113 @@ auto VulkanRenderer::load_texture(const std::filesystem::path& image_path)
 
 void VulkanRenderer::unload_texture(const TextureID id)
 {
-  m_textures.erase(id);
+  if (const auto iter = m_textures.find(id); iter != m_textures.end()) {
+    // The texture might have a pending upload, or be used by a frame in flight.
+    _flush_texture_uploads();
+    std::ignore = vkQueueWaitIdle(m_graphics_queue);
+    m_textures.erase(iter);
+  }
+
+  if (const auto iter = m_render_targets.find(id); iter != m_render_targets.end()) {
+    // Render targets are typically used in the previous frame, which might still be in
+    // flight.
+    std::ignore = vkQueueWaitIdle(m_graphics_queue);
+    m_render_targets.erase(iter);
+  }
 }
 
 auto VulkanRenderer::find_texture(const TextureID id) const -> const ITexture*
 {
-  const auto iter = m_textures.find(id);
+  if (const auto iter = m_textures.find(id); iter != m_textures.end()) {
+    return &iter->second;
+  }
 
-  if (iter != m_textures.end()) {
+  if (const auto iter = m_render_targets.find(id); iter != m_render_targets.end()) {
     return &iter->second;
   }
 
   return nullptr;
 }
 
+auto VulkanRenderer::create_render_target(const TextureSize& size)
+    -> std::expected<TextureID, ErrorCode>
+{
+  if (size.width <= 0 || size.height <= 0) {
+    return std::unexpected {ErrorCode::kBadParam};
+  }
+
+  auto render_target = create_vulkan_render_target(
+      m_device.handle,
+      m_graphics_queue,
+      m_graphics_command_pool.handle,
+      m_allocator.handle,
+      m_descriptor_allocator,
+      m_sampler.handle,
+      VkExtent2D {static_cast<std::uint32_t>(size.width),
+                  static_cast<std::uint32_t>(size.height)},
+      m_swapchain.params.image_format,
+      m_swapchain.params.depth_format);
+
+  if (!render_target.has_value()) {
+    TACTILE_VULKAN_ERROR("Could not create Vulkan render target: {}",
+                         to_string(render_target.error()));
+    return std::unexpected {ErrorCode::kBadInit};
+  }
+
+  const auto id = m_next_texture_id;
+  ++m_next_texture_id.value;
+
+  m_render_targets.insert_or_assign(id, std::move(*render_target));
+
+  return id;
+}
+
+auto VulkanRenderer::render_to_target(const TextureID target_id, const ImDrawData& draw_data)
+    -> bool
+{
+  const auto iter = m_render_targets.find(target_id);
+  if (iter == m_render_targets.end()) {
+    return false;
+  }
+
+  // The draw data might refer to textures with pending uploads.
+  _flush_texture_uploads();
+
+  // The Dear ImGui backend reuses its vertex buffers between calls, and the target might
+  // be sampled by a frame in flight, so make sure that the GPU is done with both.
+  if (vkQueueWaitIdle(m_graphics_queue) != VK_SUCCESS) {
+    return false;
+  }
+
+  const auto result = record_and_submit_commands(
+      m_device.handle,
+      m_graphics_queue,
+      m_graphics_command_pool.handle,
+      [&](VkCommandBuffer command_buffer) {
+        m_imgui_command_buffer = command_buffer;
+        _record_render_target_commands(command_buffer, iter->second, draw_data);
+      });
+
+  if (result != VK_SUCCESS) {
+    TACTILE_VULKAN_ERROR("Could not render to Vulkan render target: {}", to_string(result));
+    return false;
+  }
+
+  return true;
+}
+
+auto VulkanRenderer::is_render_target_flipped() const -> bool
+{
+  return false;
+}
+
+auto VulkanRenderer::add_premultiplied_alpha_callback(ImDrawList& draw_list) -> bool
+{
+  // The backend binds its default pipeline again when the render state is reset.
+  draw_list.AddCallback(&VulkanRenderer::_enable_premultiplied_alpha, this);
+  return true;
+}
+
 void VulkanRenderer::try_reload_fonts()
 {
   ImGui_ImplVulkan_CreateFontsTexture();
@@ -262,6 +370,16 @@ auto VulkanRenderer::get_options() -> const RendererOptions&
   return m_options;
 }
 
+void VulkanRenderer::_enable_premultiplied_alpha(const ImDrawList*, const ImDrawCmd* cmd)
+{
+  const auto* self = static_cast<const VulkanRenderer*>(cmd->UserCallbackData);
+
+  // The pipelines share a layout, so bound descriptor sets and push constants remain valid.
+  vkCmdBindPipeline(self->m_imgui_command_buffer,
+                    VK_PIPELINE_BIND_POINT_GRAPHICS,
+                    self->m_imgui_context.get_premultiplied_alpha_pipeline());
+}
+
 void VulkanRenderer::_record_commands() const
 {
   const auto& frame = m_frames.at(m_frame_index);
@@ -278,6 +396,145 @@ void VulkanRenderer::_record_commands() const
   _end_command_buffer(frame);
 }
 
+void VulkanRenderer::_record_render_target_commands(VkCommandBuffer command_buffer,
+                                                    const VulkanRenderTarget& render_target,
+                                                    const ImDrawData& draw_data) const
+{
+  constexpr VkImageSubresourceRange color_subresource_range {
+    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+    .baseMipLevel = 0,
+    .levelCount = 1,
+    .baseArrayLayer = 0,
+    .layerCount = 1,
+  };
+
+  constexpr VkImageSubresourceRange depth_subresource_range {
+    .aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT,
+    .baseMipLevel = 0,
+    .levelCount = 1,
+    .baseArrayLayer = 0,
+    .layerCount = 1,
+  };
+
+  const VkImageMemoryBarrier attachment_barriers[2] = {
+    VkImageMemoryBarrier {
+      .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+      .pNext = nullptr,
+      .srcAccessMask = VK_ACCESS_SHADER_READ_BIT,
+      .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+      .oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+      .newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+      .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .image = render_target.color_image.handle,
+      .subresourceRange = color_subresource_range,
+    },
+    VkImageMemoryBarrier {
+      .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+      .pNext = nullptr,
+      .srcAccessMask = 0,
+      .dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+      .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+      .newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+      .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .image = render_target.depth_image.handle,
+      .subresourceRange = depth_subresource_range,
+    },
+  };
+
+  vkCmdPipelineBarrier(command_buffer,
+                       VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                       VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                           VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                           VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                       0,
+                       0,
+                       nullptr,
+                       0,
+                       nullptr,
+                       2,
+                       attachment_barriers);
+
+  VkClearValue clear_values[2] = {};
+  clear_values[0].color = VkClearColorValue {.float32 = {0, 0, 0, 0}};
+  clear_values[1].depthStencil = VkClearDepthStencilValue {.depth = 1, .stencil = 0};
+
+  const VkRenderingAttachmentInfoKHR color_attachment_info {
+    .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR,
+    .pNext = nullptr,
+    .imageView = render_target.color_view.handle,
+    .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+    .resolveMode = VK_RESOLVE_MODE_NONE,
+    .resolveImageView = VK_NULL_HANDLE,
+    .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+    .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+    .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+    .clearValue = clear_values[0],
+  };
+
+  const VkRenderingAttachmentInfoKHR depth_attachment_info {
+    .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR,
+    .pNext = nullptr,
+    .imageView = render_target.depth_view.handle,
+    .imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+    .resolveMode = VK_RESOLVE_MODE_NONE,
+    .resolveImageView = VK_NULL_HANDLE,
+    .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+    .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+    .storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+    .clearValue = clear_values[1],
+  };
+
+  const auto& image_extent = render_target.color_image.params.extent;
+
+  const VkRenderingInfoKHR rendering_info {
+    .sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR,
+    .pNext = nullptr,
+    .flags = 0,
+    .renderArea = VkRect2D {VkOffset2D {0, 0}, image_extent},
+    .layerCount = 1,
+    .viewMask = 0,
+    .colorAttachmentCount = 1,
+    .pColorAttachments = &color_attachment_info,
+    .pDepthAttachment = &depth_attachment_info,
+    .pStencilAttachment = nullptr,
+  };
+
+  m_vkCmdBeginRendering(command_buffer, &rendering_info);
+
+  // The backend doesn't modify the draw data, despite the non-const signature.
+  ImGui_ImplVulkan_RenderDrawData(const_cast<ImDrawData*>(&draw_data),
+                                  command_buffer,
+                                  m_imgui_context.get_pipeline());
+
+  m_vkCmdEndRendering(command_buffer);
+
+  const VkImageMemoryBarrier sampling_barrier {
+    .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+    .pNext = nullptr,
+    .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+    .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+    .oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+    .newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .image = render_target.color_image.handle,
+    .subresourceRange = color_subresource_range,
+  };
+
+  vkCmdPipelineBarrier(command_buffer,
+                       VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                       VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                       0,
+                       0,
+                       nullptr,
+                       0,
+                       nullptr,
+                       1,
+                       &sampling_barrier);
+}
+
 auto VulkanRenderer::_reset_and_begin_command_buffer(const VulkanFrame& frame) -> VkResult
 {
   auto result = vkResetCommandBuffer(frame.command_buffer.handle, 0);
@@ -578,4 +835,16 @@ auto VulkanRenderer::_recreate_swapchain() -> VkResult
   return VK_SUCCESS;
 }
 
+void VulkanRenderer::_flush_texture_uploads()
+{
+  if (!m_texture_uploader.has_pending_uploads()) {
+    return;
+  }
+
+  const auto result = m_texture_uploader.flush();
+  if (result != VK_SUCCESS) {
+    TACTILE_VULKAN_ERROR("Could not flush texture uploads: {}", to_string(result));
+  }
+}
+
 }  // namespace tactile::vk
@@ -2,21 +2,23 @@
 
 #include "tactile/vulkan/vulkan_texture.hpp"
 
+#include <cstdint>  // uint32_t, uint64_t
+#include <tuple>    // ignore
+#include <utility>  // move
+
 #define STB_IMAGE_IMPLEMENTATION
-#include <imgui_impl_vulkan.h>
 #include <stb_image.h>
 
 #include "tactile/base/io/file_io.hpp"
 #include "tactile/base/numeric/saturate_cast.hpp"
 #include "tactile/base/render/renderer_options.hpp"
 #include "tactile/base/util/scope_exit.hpp"
-#include "tactile/vulkan/vulkan_buffer.hpp"
 
 namespace tactile::vk {
 
 auto VulkanTexture::get_handle() const -> void*
 {
-  return imgui_handle;
+  return descriptor_set.handle;
 }
 
 auto VulkanTexture::get_size() const -> TextureSize
@@ -31,8 +33,8 @@ auto VulkanTexture::get_path() const -> const std::filesystem::path&
 }
 
 auto load_vulkan_texture(VkDevice device,
-                         VkQueue queue,
-                         VkCommandPool command_pool,
+                         VulkanTextureUploader& uploader,
+                         VulkanDescriptorAllocator& descriptor_allocator,
                          VmaAllocator allocator,
                          VkSampler sampler,
                          const std::filesystem::path& image_path,
@@ -49,14 +51,11 @@ auto load_vulkan_texture(VkDevice device,
     return std::unexpected {VK_ERROR_UNKNOWN};
   }
 
-  const auto pixel_bytes = width * height * channels;
+  const auto pixel_bytes = static_cast<std::uint64_t>(width) *
+                           static_cast<std::uint64_t>(height) *
+                           static_cast<std::uint64_t>(channels);
   const ScopeExit pixels_deleter {[pixels] { stbi_image_free(pixels); }};
 
-  auto staging_buffer = create_vulkan_staging_buffer(allocator, pixel_bytes, 0);
-  if (!staging_buffer.has_value()) {
-    return std::unexpected {staging_buffer.error()};
-  }
-
   VkFormat format {VK_FORMAT_UNDEFINED};
   switch (channels) {
     case STBI_rgb:        format = VK_FORMAT_R8G8B8_UNORM; break;
@@ -84,33 +83,13 @@ auto load_vulkan_texture(VkDevice device,
     return std::unexpected {image.error()};
   }
 
-  auto result = set_buffer_data(*staging_buffer, pixels, pixel_bytes);
-  if (result != VK_SUCCESS) {
-    return std::unexpected {result};
-  }
-
-  result =
-      image->change_layout(device, queue, command_pool, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-  if (result != VK_SUCCESS) {
-    return std::unexpected {result};
-  }
-
-  result = image->copy_buffer(device, queue, command_pool, staging_buffer->handle);
-  if (result != VK_SUCCESS) {
-    return std::unexpected {result};
-  }
-
-  if (options.use_mipmaps) {
-    result = image->generate_mipmaps(device, queue, command_pool);
-    if (result != VK_SUCCESS) {
-      return std::unexpected {result};
-    }
-  }
-
-  result = image->change_layout(device,
-                                queue,
-                                command_pool,
-                                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  // The staging buffer is reused after the upload is flushed, so the pixel data may be
+  // freed once the upload has been recorded.
+  const auto result = uploader.upload(*image,
+                                      pixels,
+                                      pixel_bytes,
+                                      static_cast<std::uint32_t>(channels),
+                                      options.use_mipmaps);
   if (result != VK_SUCCESS) {
     return std::unexpected {result};
   }
@@ -122,6 +101,8 @@ auto load_vulkan_texture(VkDevice device,
                                              VK_IMAGE_ASPECT_COLOR_BIT,
                                              1);
   if (!image_view.has_value()) {
+    // The image must not be destroyed while there's a pending upload to it.
+    std::ignore = uploader.flush();
     return std::unexpected {image_view.error()};
   }
 
@@ -130,12 +111,16 @@ auto load_vulkan_texture(VkDevice device,
   texture.image = std::move(*image);
   texture.view = std::move(*image_view);
 
-  texture.imgui_handle =
-      ImGui_ImplVulkan_AddTexture(sampler, texture.view.handle, texture.image.params.layout);
-  if (texture.imgui_handle == VK_NULL_HANDLE) {
-    return std::unexpected {VK_ERROR_INITIALIZATION_FAILED};
+  auto descriptor_set = descriptor_allocator.allocate_texture_set(sampler,
+                                                                  texture.view.handle,
+                                                                  texture.image.params.layout);
+  if (!descriptor_set.has_value()) {
+    std::ignore = uploader.flush();
+    return std::unexpected {descriptor_set.error()};
   }
 
+  texture.descriptor_set = std::move(*descriptor_set);
+
   return texture;
 }
 
@@ -0,0 +1,225 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/vulkan/vulkan_texture_uploader.hpp"
+
+#include <cstring>  // memcpy
+#include <limits>   // numeric_limits
+#include <numeric>  // lcm
+#include <tuple>    // ignore
+#include <utility>  // move
+
+#include "tactile/base/util/scope_exit.hpp"
+#include "tactile/vulkan/logging.hpp"
+#include "tactile/vulkan/vulkan_util.hpp"
+
+namespace tactile::vk {
+
+auto VulkanTextureUploader::upload(VulkanImage& image,
+                                   const void* pixels,
+                                   const std::uint64_t pixel_bytes,
+                                   const std::uint32_t texel_size,
+                                   const bool generate_mipmaps) -> VkResult
+{
+  // Buffer offsets used in buffer to image copies must be multiples of both four and the
+  // texel size.
+  const auto alignment = std::lcm(std::uint64_t {4}, std::uint64_t {texel_size});
+
+  auto staging_offset = allocate_vulkan_staging_range(staging_arena, pixel_bytes, alignment);
+
+  // Make room in the shared staging buffer by submitting the pending uploads.
+  if (!staging_offset.has_value() && pending_upload_count > 0) {
+    if (const auto result = flush(); result != VK_SUCCESS) {
+      return result;
+    }
+
+    staging_offset = allocate_vulkan_staging_range(staging_arena, pixel_bytes, alignment);
+  }
+
+  if (!is_recording) {
+    if (const auto result = _begin_recording(); result != VK_SUCCESS) {
+      return result;
+    }
+  }
+
+  VkBuffer source_buffer {VK_NULL_HANDLE};
+
+  if (staging_offset.has_value()) {
+    const auto result = _write_staging_data(pixels, pixel_bytes, *staging_offset);
+    if (result != VK_SUCCESS) {
+      return result;
+    }
+
+    source_buffer = staging_buffer.handle;
+  }
+  else {
+    auto dedicated_buffer = create_vulkan_staging_buffer(allocator, pixel_bytes, 0);
+    if (!dedicated_buffer.has_value()) {
+      return dedicated_buffer.error();
+    }
+
+    const auto result = set_buffer_data(*dedicated_buffer, pixels, pixel_bytes);
+    if (result != VK_SUCCESS) {
+      return result;
+    }
+
+    staging_offset = 0;
+    source_buffer = dedicated_buffer->handle;
+
+    dedicated_staging_buffers.push_back(std::move(*dedicated_buffer));
+  }
+
+  image.record_change_layout(command_buffer.handle, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+  image.record_copy_buffer(command_buffer.handle, source_buffer, *staging_offset);
+
+  if (generate_mipmaps) {
+    image.record_generate_mipmaps(command_buffer.handle);
+  }
+  else {
+    image.record_change_layout(command_buffer.handle, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  }
+
+  ++pending_upload_count;
+  return VK_SUCCESS;
+}
+
+auto VulkanTextureUploader::flush() -> VkResult
+{
+  if (!is_recording) {
+    return VK_SUCCESS;
+  }
+
+  // The pending uploads are either submitted or lost, either way the staging memory can
+  // be reused afterwards.
+  const ScopeExit reset_guard {[this] { _reset(); }};
+
+  auto result = vkEndCommandBuffer(command_buffer.handle);
+  if (result != VK_SUCCESS) {
+    TACTILE_VULKAN_ERROR("Could not end texture upload command buffer: {}", to_string(result));
+    return result;
+  }
+
+  if (pending_upload_count == 0) {
+    return VK_SUCCESS;
+  }
+
+  result = vkResetFences(device, 1, &fence.handle);
+  if (result != VK_SUCCESS) {
+    return result;
+  }
+
+  const VkSubmitInfo submit_info {
+    .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+    .pNext = nullptr,
+    .waitSemaphoreCount = 0,
+    .pWaitSemaphores = nullptr,
+    .pWaitDstStageMask = nullptr,
+    .commandBufferCount = 1,
+    .pCommandBuffers = &command_buffer.handle,
+    .signalSemaphoreCount = 0,
+    .pSignalSemaphores = nullptr,
+  };
+
+  result = vkQueueSubmit(queue, 1, &submit_info, fence.handle);
+  if (result != VK_SUCCESS) {
+    TACTILE_VULKAN_ERROR("Could not submit texture uploads: {}", to_string(result));
+    return result;
+  }
+
+  TACTILE_VULKAN_DEBUG("Submitted {} texture upload(s)", pending_upload_count);
+
+  return vkWaitForFences(device,
+                         1,
+                         &fence.handle,
+                         VK_TRUE,
+                         std::numeric_limits<std::uint64_t>::max());
+}
+
+auto VulkanTextureUploader::has_pending_uploads() const noexcept -> bool
+{
+  return pending_upload_count > 0;
+}
+
+auto VulkanTextureUploader::_begin_recording() -> VkResult
+{
+  auto result = vkResetCommandBuffer(command_buffer.handle, 0);
+  if (result != VK_SUCCESS) {
+    return result;
+  }
+
+  constexpr VkCommandBufferBeginInfo begin_info {
+    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+    .pNext = nullptr,
+    .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    .pInheritanceInfo = nullptr,
+  };
+
+  result = vkBeginCommandBuffer(command_buffer.handle, &begin_info);
+  if (result != VK_SUCCESS) {
+    return result;
+  }
+
+  is_recording = true;
+  return VK_SUCCESS;
+}
+
+auto VulkanTextureUploader::_write_staging_data(const void* pixels,
+                                                const std::uint64_t pixel_bytes,
+                                                const std::uint64_t offset) -> VkResult
+{
+  void* mapped_data = nullptr;
+
+  const auto result = vmaMapMemory(allocator, staging_buffer.allocation, &mapped_data);
+  if (result != VK_SUCCESS) {
+    return result;
+  }
+
+  std::memcpy(static_cast<unsigned char*>(mapped_data) + offset, pixels, pixel_bytes);
+  vmaUnmapMemory(allocator, staging_buffer.allocation);
+
+  return VK_SUCCESS;
+}
+
+void VulkanTextureUploader::_reset() noexcept
+{
+  staging_arena.offset = 0;
+  dedicated_staging_buffers.clear();
+  pending_upload_count = 0;
+  is_recording = false;
+}
+
+auto create_vulkan_texture_uploader(VkDevice device,
+                                    VkQueue queue,
+                                    VkCommandPool command_pool,
+                                    VmaAllocator allocator)
+    -> std::expected<VulkanTextureUploader, VkResult>
+{
+  auto command_buffer = create_vulkan_command_buffer(device, command_pool);
+  if (!command_buffer.has_value()) {
+    return std::unexpected {command_buffer.error()};
+  }
+
+  auto fence = create_vulkan_fence(device, VK_FENCE_CREATE_SIGNALED_BIT);
+  if (!fence.has_value()) {
+    return std::unexpected {fence.error()};
+  }
+
+  auto staging_buffer = create_vulkan_staging_buffer(allocator, kVulkanStagingBufferSize, 0);
+  if (!staging_buffer.has_value()) {
+    TACTILE_VULKAN_ERROR("Could not create texture staging buffer: {}",
+                         to_string(staging_buffer.error()));
+    return std::unexpected {staging_buffer.error()};
+  }
+
+  VulkanTextureUploader uploader {};
+  uploader.device = device;
+  uploader.queue = queue;
+  uploader.allocator = allocator;
+  uploader.command_buffer = std::move(*command_buffer);
+  uploader.fence = std::move(*fence);
+  uploader.staging_buffer = std::move(*staging_buffer);
+  uploader.staging_arena = VulkanStagingArena {.capacity = kVulkanStagingBufferSize, .offset = 0};
+
+  return uploader;
+}
+
+}  // namespace tactile::vk
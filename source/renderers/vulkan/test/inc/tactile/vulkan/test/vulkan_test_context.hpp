@@ -0,0 +1,76 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <expected>  // expected
+#include <vector>    // vector
+
+#include <vulkan/vulkan.h>
+
+#include "tactile/vulkan/vulkan_allocator.hpp"
+#include "tactile/vulkan/vulkan_command_pool.hpp"
+#include "tactile/vulkan/vulkan_device.hpp"
+#include "tactile/vulkan/vulkan_image.hpp"
+#include "tactile/vulkan/vulkan_instance.hpp"
+
+namespace tactile::vk::test {
+
+/**
+ * Provides a headless Vulkan device for device-level tests.
+ */
+struct VulkanTestContext final
+{
+  VulkanInstance instance;
+  VkPhysicalDevice physical_device;
+  VulkanDevice device;
+  VkQueue queue;
+  VulkanAllocator allocator;
+  VulkanCommandPool command_pool;
+};
+
+/**
+ * Creates a headless Vulkan device, without any window or surface.
+ *
+ * \details
+ * Tests that use this function should be skipped if it fails, since there
+ * might not be any Vulkan implementation installed. A software implementation,
+ * such as lavapipe, is sufficient.
+ *
+ * \return
+ * A test context if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto create_vulkan_test_context() -> std::expected<VulkanTestContext, VkResult>;
+
+/**
+ * Creates a sampled RGBA image that can be used as a texture upload target.
+ *
+ * \param context          The associated test context.
+ * \param extent           The size of the image.
+ * \param generate_mipmaps Whether the image should feature all mip levels.
+ *
+ * \return
+ * An image if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto create_test_image(const VulkanTestContext& context,
+                       VkExtent2D extent,
+                       bool generate_mipmaps) -> std::expected<VulkanImage, VkResult>;
+
+/**
+ * Reads back the first mip level of an RGBA image.
+ *
+ * \details
+ * The image is left in the transfer source layout.
+ *
+ * \param context The associated test context.
+ * \param image   The image to read.
+ *
+ * \return
+ * The pixel data if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto read_test_image(const VulkanTestContext& context, VulkanImage& image)
+    -> std::expected<std::vector<unsigned char>, VkResult>;
+
+}  // namespace tactile::vk::test
@@ -0,0 +1,9 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include <gtest/gtest.h>
+
+auto main(int argc, char* argv[]) -> int
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,131 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/vulkan/vulkan_descriptor_allocator.hpp"
+
+#include <cstdint>   // uint32_t
+#include <optional>  // optional
+#include <utility>   // move
+#include <vector>    // vector
+
+#include <gtest/gtest.h>
+
+#include "tactile/base/render/renderer_options.hpp"
+#include "tactile/vulkan/test/vulkan_test_context.hpp"
+#include "tactile/vulkan/vulkan_image_view.hpp"
+#include "tactile/vulkan/vulkan_sampler.hpp"
+
+namespace tactile::vk {
+namespace {
+
+class VulkanDescriptorAllocatorDeviceTest : public testing::Test
+{
+ public:
+  void SetUp() override
+  {
+    auto context = test::create_vulkan_test_context();
+    if (!context.has_value()) {
+      GTEST_SKIP() << "No Vulkan implementation available";
+    }
+
+    mContext.emplace(std::move(*context));
+    const auto device = mContext->device.handle;
+
+    auto sampler = create_vulkan_sampler(device, RendererOptions {});
+    ASSERT_TRUE(sampler.has_value());
+    mSampler = std::move(*sampler);
+
+    auto image = test::create_test_image(*mContext, VkExtent2D {4, 4}, false);
+    ASSERT_TRUE(image.has_value());
+    mImage = std::move(*image);
+
+    auto image_view = create_vulkan_image_view(device,
+                                               mImage.handle,
+                                               mImage.params.format,
+                                               VK_IMAGE_VIEW_TYPE_2D,
+                                               VK_IMAGE_ASPECT_COLOR_BIT,
+                                               mImage.params.mip_levels);
+    ASSERT_TRUE(image_view.has_value());
+    mImageView = std::move(*image_view);
+
+    auto allocator = create_vulkan_descriptor_allocator(device);
+    ASSERT_TRUE(allocator.has_value());
+    mAllocator.emplace(std::move(*allocator));
+  }
+
+ protected:
+  std::optional<test::VulkanTestContext> mContext {};
+  VulkanSampler mSampler {};
+  VulkanImage mImage {};
+  VulkanImageView mImageView {};
+  std::optional<VulkanDescriptorAllocator> mAllocator {};
+
+  // Allocates descriptor sets, which must be destroyed before the allocator.
+  void allocate_sets(std::vector<VulkanDescriptorSet>& sets, const std::uint32_t count)
+  {
+    for (std::uint32_t index = 0; index < count; ++index) {
+      auto descriptor_set =
+          mAllocator->allocate_texture_set(mSampler.handle,
+                                           mImageView.handle,
+                                           VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+      ASSERT_TRUE(descriptor_set.has_value());
+      EXPECT_NE(descriptor_set->handle, VK_NULL_HANDLE);
+      EXPECT_NE(descriptor_set->pool, VK_NULL_HANDLE);
+
+      sets.push_back(std::move(*descriptor_set));
+    }
+  }
+};
+
+// tactile::vk::get_next_vulkan_descriptor_pool_size
+TEST(VulkanDescriptorAllocator, GetNextVulkanDescriptorPoolSize)
+{
+  EXPECT_EQ(get_next_vulkan_descriptor_pool_size(0), kMinVulkanDescriptorPoolSize);
+  EXPECT_EQ(get_next_vulkan_descriptor_pool_size(1), kMinVulkanDescriptorPoolSize * 2);
+  EXPECT_EQ(get_next_vulkan_descriptor_pool_size(2), kMinVulkanDescriptorPoolSize * 4);
+  EXPECT_EQ(get_next_vulkan_descriptor_pool_size(6), kMaxVulkanDescriptorPoolSize);
+  EXPECT_EQ(get_next_vulkan_descriptor_pool_size(7), kMaxVulkanDescriptorPoolSize);
+  EXPECT_EQ(get_next_vulkan_descriptor_pool_size(1'000), kMaxVulkanDescriptorPoolSize);
+}
+
+// tactile::vk::VulkanDescriptorAllocator::allocate_texture_set
+TEST_F(VulkanDescriptorAllocatorDeviceTest, GrowPoolsOnDemand)
+{
+  std::vector<VulkanDescriptorSet> sets {};
+
+  EXPECT_TRUE(mAllocator->pools.empty());
+
+  allocate_sets(sets, kMinVulkanDescriptorPoolSize);
+  EXPECT_EQ(mAllocator->pools.size(), 1);
+
+  allocate_sets(sets, 1);
+  EXPECT_EQ(mAllocator->pools.size(), 2);
+
+  // The second pool is twice as large as the first pool.
+  allocate_sets(sets, kMinVulkanDescriptorPoolSize * 2 - 1);
+  EXPECT_EQ(mAllocator->pools.size(), 2);
+
+  allocate_sets(sets, 1);
+  EXPECT_EQ(mAllocator->pools.size(), 3);
+
+  EXPECT_EQ(sets.size(), kMinVulkanDescriptorPoolSize * 3 + 1);
+  EXPECT_EQ(sets.front().pool, mAllocator->pools.front().handle);
+  EXPECT_EQ(sets.back().pool, mAllocator->pools.back().handle);
+}
+
+// tactile::vk::VulkanDescriptorAllocator::allocate_texture_set
+TEST_F(VulkanDescriptorAllocatorDeviceTest, ReuseFreedSets)
+{
+  std::vector<VulkanDescriptorSet> sets {};
+
+  allocate_sets(sets, kMinVulkanDescriptorPoolSize);
+  ASSERT_EQ(mAllocator->pools.size(), 1);
+
+  // Destroyed descriptor sets are returned to their pool.
+  sets.clear();
+
+  allocate_sets(sets, kMinVulkanDescriptorPoolSize);
+  EXPECT_EQ(mAllocator->pools.size(), 1);
+}
+
+}  // namespace
+}  // namespace tactile::vk
@@ -0,0 +1,257 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/vulkan/test/vulkan_test_context.hpp"
+
+#include <cstdint>   // uint32_t, uint64_t
+#include <cstring>   // memcpy
+#include <optional>  // optional
+#include <utility>   // move
+
+#include "tactile/vulkan/vulkan_buffer.hpp"
+#include "tactile/vulkan/vulkan_physical_device.hpp"
+
+namespace tactile::vk::test {
+namespace {
+
+[[nodiscard]]
+auto _create_headless_instance() -> std::expected<VulkanInstance, VkResult>
+{
+  constexpr VkApplicationInfo app_info {
+    .sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
+    .pNext = nullptr,
+    .pApplicationName = "tactile-vulkan-renderer-test",
+    .applicationVersion = 0,
+    .pEngineName = nullptr,
+    .engineVersion = 0,
+    .apiVersion = VK_API_VERSION_1_2,
+  };
+
+  const VkInstanceCreateInfo instance_info {
+    .sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+    .pNext = nullptr,
+    .flags = 0,
+    .pApplicationInfo = &app_info,
+    .enabledLayerCount = 0,
+    .ppEnabledLayerNames = nullptr,
+    .enabledExtensionCount = 0,
+    .ppEnabledExtensionNames = nullptr,
+  };
+
+  VkInstance instance {VK_NULL_HANDLE};
+  const auto result = vkCreateInstance(&instance_info, nullptr, &instance);
+
+  if (result != VK_SUCCESS) {
+    return std::unexpected {result};
+  }
+
+  return VulkanInstance {instance};
+}
+
+[[nodiscard]]
+auto _find_graphics_queue_family(VkPhysicalDevice physical_device)
+    -> std::optional<std::uint32_t>
+{
+  const auto queue_families = get_queue_families(physical_device);
+
+  for (std::uint32_t index = 0; index < queue_families.size(); ++index) {
+    if (queue_families[index].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+      return index;
+    }
+  }
+
+  return std::nullopt;
+}
+
+[[nodiscard]]
+auto _create_headless_device(VkPhysicalDevice physical_device,
+                             const std::uint32_t queue_family)
+    -> std::expected<VulkanDevice, VkResult>
+{
+  constexpr float queue_priority = 1.0f;
+
+  const VkDeviceQueueCreateInfo queue_info {
+    .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+    .pNext = nullptr,
+    .flags = 0,
+    .queueFamilyIndex = queue_family,
+    .queueCount = 1,
+    .pQueuePriorities = &queue_priority,
+  };
+
+  constexpr VkPhysicalDeviceFeatures enabled_features {};
+
+  const VkDeviceCreateInfo device_info {
+    .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+    .pNext = nullptr,
+    .flags = 0,
+    .queueCreateInfoCount = 1,
+    .pQueueCreateInfos = &queue_info,
+    .enabledLayerCount = 0,
+    .ppEnabledLayerNames = nullptr,
+    .enabledExtensionCount = 0,
+    .ppEnabledExtensionNames = nullptr,
+    .pEnabledFeatures = &enabled_features,
+  };
+
+  VulkanDevice device {};
+  device.graphics_queue_family = queue_family;
+  device.presentation_queue_family = queue_family;
+
+  const auto result = vkCreateDevice(physical_device, &device_info, nullptr, &device.handle);
+  if (result != VK_SUCCESS) {
+    return std::unexpected {result};
+  }
+
+  return device;
+}
+
+}  // namespace
+
+auto create_vulkan_test_context() -> std::expected<VulkanTestContext, VkResult>
+{
+  auto instance = _create_headless_instance();
+  if (!instance.has_value()) {
+    return std::unexpected {instance.error()};
+  }
+
+  for (auto* physical_device : get_physical_devices(instance->get())) {
+    const auto queue_family = _find_graphics_queue_family(physical_device);
+    if (!queue_family.has_value()) {
+      continue;
+    }
+
+    auto device = _create_headless_device(physical_device, *queue_family);
+    if (!device.has_value()) {
+      return std::unexpected {device.error()};
+    }
+
+    VkQueue queue {VK_NULL_HANDLE};
+    vkGetDeviceQueue(device->handle, *queue_family, 0, &queue);
+
+    auto allocator =
+        create_vulkan_allocator(instance->get(), physical_device, device->handle);
+    if (!allocator.has_value()) {
+      return std::unexpected {allocator.error()};
+    }
+
+    auto command_pool =
+        create_vulkan_command_pool(device->handle,
+                                   *queue_family,
+                                   VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+    if (!command_pool.has_value()) {
+      return std::unexpected {command_pool.error()};
+    }
+
+    return VulkanTestContext {
+      .instance = std::move(*instance),
+      .physical_device = physical_device,
+      .device = std::move(*device),
+      .queue = queue,
+      .allocator = std::move(*allocator),
+      .command_pool = std::move(*command_pool),
+    };
+  }
+
+  return std::unexpected {VK_ERROR_INITIALIZATION_FAILED};
+}
+
+auto create_test_image(const VulkanTestContext& context,
+                       const VkExtent2D extent,
+                       const bool generate_mipmaps) -> std::expected<VulkanImage, VkResult>
+{
+  return create_vulkan_image(
+      context.allocator.handle,
+      VulkanImageParams {
+        .type = VK_IMAGE_TYPE_2D,
+        .format = VK_FORMAT_R8G8B8A8_UNORM,
+        .layout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .extent = extent,
+        .usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                 VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+        .mip_levels = generate_mipmaps ? calculate_vulkan_mip_levels(extent) : 1u,
+      });
+}
+
+auto read_test_image(const VulkanTestContext& context, VulkanImage& image)
+    -> std::expected<std::vector<unsigned char>, VkResult>
+{
+  const auto& extent = image.params.extent;
+  const auto byte_count = std::uint64_t {extent.width} * std::uint64_t {extent.height} * 4u;
+
+  const VkBufferCreateInfo buffer_info {
+    .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+    .pNext = nullptr,
+    .flags = 0,
+    .size = byte_count,
+    .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+    .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+    .queueFamilyIndexCount = 0,
+    .pQueueFamilyIndices = nullptr,
+  };
+
+  constexpr VmaAllocationCreateInfo allocation_info {
+    .flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+    .usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+    .requiredFlags =
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+    .preferredFlags = 0,
+    .memoryTypeBits = 0,
+    .pool = nullptr,
+    .pUserData = nullptr,
+    .priority = 0,
+  };
+
+  auto buffer = create_vulkan_buffer(context.allocator.handle, buffer_info, allocation_info);
+  if (!buffer.has_value()) {
+    return std::unexpected {buffer.error()};
+  }
+
+  auto result = record_and_submit_commands(
+      context.device.handle,
+      context.queue,
+      context.command_pool.handle,
+      [&](VkCommandBuffer command_buffer) {
+        image.record_change_layout(command_buffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+
+        const VkBufferImageCopy region {
+          .bufferOffset = 0,
+          .bufferRowLength = 0,
+          .bufferImageHeight = 0,
+          .imageSubresource =
+              VkImageSubresourceLayers {
+                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                .mipLevel = 0,
+                .baseArrayLayer = 0,
+                .layerCount = 1,
+              },
+          .imageOffset = VkOffset3D {0, 0, 0},
+          .imageExtent = VkExtent3D {extent.width, extent.height, 1},
+        };
+
+        vkCmdCopyImageToBuffer(command_buffer,
+                               image.handle,
+                               VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                               buffer->handle,
+                               1,
+                               &region);
+      });
+
+  if (result != VK_SUCCESS) {
+    return std::unexpected {result};
+  }
+
+  void* mapped_data = nullptr;
+  result = vmaMapMemory(buffer->allocator, buffer->allocation, &mapped_data);
+  if (result != VK_SUCCESS) {
+    return std::unexpected {result};
+  }
+
+  std::vector<unsigned char> pixels(byte_count);
+  std::memcpy(pixels.data(), mapped_data, byte_count);
+
+  vmaUnmapMemory(buffer->allocator, buffer->allocation);
+
+  return pixels;
+}
+
+}  // namespace tactile::vk::test
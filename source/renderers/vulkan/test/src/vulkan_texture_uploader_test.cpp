@@ -0,0 +1,219 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/vulkan/vulkan_texture_uploader.hpp"
+
+#include <cstddef>   // size_t
+#include <cstdint>   // uint32_t, uint64_t
+#include <optional>  // optional
+#include <utility>   // move
+#include <vector>    // vector
+
+#include <gtest/gtest.h>
+
+#include "tactile/vulkan/test/vulkan_test_context.hpp"
+
+namespace tactile::vk {
+namespace {
+
+class VulkanTextureUploaderDeviceTest : public testing::Test
+{
+ public:
+  void SetUp() override
+  {
+    auto context = test::create_vulkan_test_context();
+    if (!context.has_value()) {
+      GTEST_SKIP() << "No Vulkan implementation available";
+    }
+
+    mContext.emplace(std::move(*context));
+
+    auto uploader = create_vulkan_texture_uploader(mContext->device.handle,
+                                                   mContext->queue,
+                                                   mContext->command_pool.handle,
+                                                   mContext->allocator.handle);
+    ASSERT_TRUE(uploader.has_value());
+
+    mUploader.emplace(std::move(*uploader));
+  }
+
+ protected:
+  std::optional<test::VulkanTestContext> mContext {};
+  std::optional<VulkanTextureUploader> mUploader {};
+
+  [[nodiscard]]
+  auto make_image(const std::uint32_t size, const bool generate_mipmaps = false) -> VulkanImage
+  {
+    auto image = test::create_test_image(*mContext, VkExtent2D {size, size}, generate_mipmaps);
+    return std::move(image.value());
+  }
+
+  [[nodiscard]]
+  static auto make_pixels(const std::uint32_t size, const unsigned char seed)
+      -> std::vector<unsigned char>
+  {
+    std::vector<unsigned char> pixels(std::size_t {size} * size * 4u);
+
+    for (std::size_t index = 0; index < pixels.size(); ++index) {
+      pixels[index] = static_cast<unsigned char>(index + seed);
+    }
+
+    return pixels;
+  }
+
+  auto upload(VulkanImage& image,
+              const std::vector<unsigned char>& pixels,
+              const bool generate_mipmaps = false) -> VkResult
+  {
+    return mUploader->upload(image, pixels.data(), pixels.size(), 4, generate_mipmaps);
+  }
+
+  void expect_pixels(VulkanImage& image, const std::vector<unsigned char>& pixels)
+  {
+    EXPECT_EQ(image.params.layout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    const auto actual_pixels = test::read_test_image(*mContext, image);
+    ASSERT_TRUE(actual_pixels.has_value());
+    EXPECT_EQ(*actual_pixels, pixels);
+  }
+};
+
+// tactile::vk::allocate_vulkan_staging_range
+TEST(VulkanTextureUploader, AllocateVulkanStagingRange)
+{
+  VulkanStagingArena arena {.capacity = 100, .offset = 0};
+
+  EXPECT_EQ(allocate_vulkan_staging_range(arena, 10, 4), 0);
+  EXPECT_EQ(arena.offset, 10);
+
+  EXPECT_EQ(allocate_vulkan_staging_range(arena, 10, 4), 12);
+  EXPECT_EQ(arena.offset, 22);
+
+  // RGB images require offsets that are multiples of 12.
+  EXPECT_EQ(allocate_vulkan_staging_range(arena, 30, 12), 24);
+  EXPECT_EQ(arena.offset, 54);
+
+  EXPECT_EQ(allocate_vulkan_staging_range(arena, 40, 4), 56);
+  EXPECT_EQ(arena.offset, 96);
+}
+
+// tactile::vk::allocate_vulkan_staging_range
+TEST(VulkanTextureUploader, AllocateVulkanStagingRangeWhenFull)
+{
+  VulkanStagingArena arena {.capacity = 64, .offset = 60};
+
+  EXPECT_EQ(allocate_vulkan_staging_range(arena, 8, 4), std::nullopt);
+  EXPECT_EQ(allocate_vulkan_staging_range(arena, 4, 8), std::nullopt);
+  EXPECT_EQ(arena.offset, 60);
+
+  EXPECT_EQ(allocate_vulkan_staging_range(arena, 4, 4), 60);
+  EXPECT_EQ(arena.offset, 64);
+
+  arena.offset = 0;
+  EXPECT_EQ(allocate_vulkan_staging_range(arena, 65, 4), std::nullopt);
+  EXPECT_EQ(allocate_vulkan_staging_range(arena, 64, 4), 0);
+}
+
+// tactile::vk::VulkanTextureUploader::upload
+// tactile::vk::VulkanTextureUploader::flush
+TEST_F(VulkanTextureUploaderDeviceTest, UploadImage)
+{
+  auto image = make_image(4);
+  const auto pixels = make_pixels(4, 0);
+
+  EXPECT_FALSE(mUploader->has_pending_uploads());
+
+  ASSERT_EQ(upload(image, pixels), VK_SUCCESS);
+  EXPECT_TRUE(mUploader->has_pending_uploads());
+
+  ASSERT_EQ(mUploader->flush(), VK_SUCCESS);
+  EXPECT_FALSE(mUploader->has_pending_uploads());
+  EXPECT_EQ(mUploader->staging_arena.offset, 0);
+
+  expect_pixels(image, pixels);
+}
+
+// tactile::vk::VulkanTextureUploader::upload
+TEST_F(VulkanTextureUploaderDeviceTest, UploadImageWithMipmaps)
+{
+  auto image = make_image(16, true);
+  const auto pixels = make_pixels(16, 42);
+
+  ASSERT_EQ(upload(image, pixels, true), VK_SUCCESS);
+  ASSERT_EQ(mUploader->flush(), VK_SUCCESS);
+
+  expect_pixels(image, pixels);
+}
+
+// tactile::vk::VulkanTextureUploader::upload
+TEST_F(VulkanTextureUploaderDeviceTest, BatchUploads)
+{
+  auto image1 = make_image(4);
+  auto image2 = make_image(8);
+  auto image3 = make_image(2);
+
+  const auto pixels1 = make_pixels(4, 1);
+  const auto pixels2 = make_pixels(8, 2);
+  const auto pixels3 = make_pixels(2, 3);
+
+  ASSERT_EQ(upload(image1, pixels1), VK_SUCCESS);
+  ASSERT_EQ(upload(image2, pixels2), VK_SUCCESS);
+  ASSERT_EQ(upload(image3, pixels3), VK_SUCCESS);
+
+  // All uploads share the staging buffer and are submitted together.
+  EXPECT_EQ(mUploader->pending_upload_count, 3);
+  EXPECT_EQ(mUploader->staging_arena.offset, pixels1.size() + pixels2.size() + pixels3.size());
+  EXPECT_TRUE(mUploader->dedicated_staging_buffers.empty());
+
+  ASSERT_EQ(mUploader->flush(), VK_SUCCESS);
+
+  expect_pixels(image1, pixels1);
+  expect_pixels(image2, pixels2);
+  expect_pixels(image3, pixels3);
+}
+
+// tactile::vk::VulkanTextureUploader::upload
+TEST_F(VulkanTextureUploaderDeviceTest, FlushWhenStagingBufferIsFull)
+{
+  auto image1 = make_image(4);
+  auto image2 = make_image(4);
+
+  const auto pixels1 = make_pixels(4, 10);
+  const auto pixels2 = make_pixels(4, 20);
+
+  // Only make room for a single image in the staging buffer.
+  mUploader->staging_arena.capacity = pixels1.size();
+
+  ASSERT_EQ(upload(image1, pixels1), VK_SUCCESS);
+  EXPECT_EQ(mUploader->pending_upload_count, 1);
+
+  ASSERT_EQ(upload(image2, pixels2), VK_SUCCESS);
+  EXPECT_EQ(mUploader->pending_upload_count, 1);
+  EXPECT_TRUE(mUploader->dedicated_staging_buffers.empty());
+
+  ASSERT_EQ(mUploader->flush(), VK_SUCCESS);
+
+  expect_pixels(image1, pixels1);
+  expect_pixels(image2, pixels2);
+}
+
+// tactile::vk::VulkanTextureUploader::upload
+TEST_F(VulkanTextureUploaderDeviceTest, UploadWithDedicatedStagingBuffer)
+{
+  auto image = make_image(8);
+  const auto pixels = make_pixels(8, 7);
+
+  // Images larger than the staging buffer use dedicated staging buffers.
+  mUploader->staging_arena.capacity = pixels.size() / 2;
+
+  ASSERT_EQ(upload(image, pixels), VK_SUCCESS);
+  EXPECT_EQ(mUploader->dedicated_staging_buffers.size(), 1);
+  EXPECT_EQ(mUploader->staging_arena.offset, 0);
+
+  ASSERT_EQ(mUploader->flush(), VK_SUCCESS);
+  EXPECT_TRUE(mUploader->dedicated_staging_buffers.empty());
+
+  expect_pixels(image, pixels);
+}
+
+}  // namespace
+}  // namespace tactile::vk
@@ -30,6 +30,8 @@ struct CommandLineOptions final
   bool load_tiled_tmj_format;
   bool load_tiled_tmx_format;
   bool load_godot_tscn_format;
+  bool load_binary_format;
+  bool enable_profiler;
 };
 
 [[nodiscard]]
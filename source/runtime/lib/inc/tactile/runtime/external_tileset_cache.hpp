@@ -0,0 +1,67 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>        // size_t
+#include <cstdint>        // uintmax_t
+#include <expected>       // expected
+#include <filesystem>     // path, file_time_type
+#include <mutex>          // mutex
+#include <unordered_map>  // unordered_map
+
+#include "tactile/base/io/save/external_tileset_cache.hpp"
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/runtime/api.hpp"
+
+namespace tactile::runtime {
+
+/**
+ * An external tileset cache keyed by canonical tileset file paths.
+ *
+ * \details
+ * Cached tilesets are validated against the last write time and size of their
+ * files on every lookup, so tileset files modified after being cached are parsed
+ * again. This class is thread-safe, but parsers aren't invoked with the cache
+ * locked, so the same tileset may be parsed concurrently by several threads.
+ */
+class TACTILE_RUNTIME_API ExternalTilesetCache final : public IExternalTilesetCache
+{
+ public:
+  TACTILE_DELETE_COPY(ExternalTilesetCache);
+  TACTILE_DELETE_MOVE(ExternalTilesetCache);
+
+  ExternalTilesetCache() = default;
+
+  ~ExternalTilesetCache() noexcept override = default;
+
+  [[nodiscard]]
+  auto get_tileset(const std::filesystem::path& path, const parser_type& parser)
+      -> std::expected<ir::Tileset, ErrorCode> override;
+
+  void invalidate(const std::filesystem::path& path) override;
+
+  void clear() override;
+
+  /**
+   * Returns the number of cached tilesets.
+   *
+   * \return
+   * A tileset count.
+   */
+  [[nodiscard]]
+  auto size() const -> std::size_t;
+
+ private:
+  struct CachedTileset final
+  {
+    std::filesystem::file_time_type last_write_time;
+    std::uintmax_t file_size;
+    ir::Tileset tileset;
+  };
+
+  mutable std::mutex m_mutex {};
+  std::unordered_map<std::filesystem::path::string_type, CachedTileset> m_tilesets {};
+};
+
+}  // namespace tactile::runtime
@@ -0,0 +1,33 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <string>  // string
+#include <vector>  // vector
+
+#include "tactile/base/io/compress/compression_format_id.hpp"
+#include "tactile/base/io/save/save_format_id.hpp"
+#include "tactile/base/prelude.hpp"
+
+namespace tactile::runtime {
+
+/**
+ * Describes the formats provided by a plugin, without having to load it.
+ *
+ * \details
+ * Plugins that are registered using manifests are only loaded once one of the
+ * formats they provide is requested from the runtime.
+ */
+struct PluginManifest final
+{
+  /** The file name of the plugin module. */
+  std::string library_name;
+
+  /** The save formats registered by the plugin. */
+  std::vector<SaveFormatId> save_formats;
+
+  /** The compression formats registered by the plugin. */
+  std::vector<CompressionFormatId> compression_formats;
+};
+
+}  // namespace tactile::runtime
@@ -16,6 +16,7 @@ struct ImGuiContext;
 namespace tactile::runtime {
 
 struct CommandLineOptions;
+struct PluginManifest;
 
 /**
  * Implements the runtime interface.
@@ -44,8 +45,27 @@ class TACTILE_RUNTIME_API RuntimeImpl final : public IRuntime
    */
   explicit RuntimeImpl(const CommandLineOptions& options);
 
+  /**
+   * Unloads any plugins that were loaded on demand, and then shuts down the
+   * runtime.
+   */
   ~RuntimeImpl() noexcept override;
 
+  /**
+   * Registers a plugin that is loaded once any of its formats are requested.
+   *
+   * \details
+   * The plugin library isn't touched by this function. Instead, the plugin is
+   * loaded by \c get_save_format or \c get_compression_format, the first time a
+   * format listed in the manifest is requested and no implementation has been
+   * registered for it. A plugin is only loaded once, even if loading it fails.
+   * Formats may be requested from any thread, in which case the plugin is
+   * loaded on the requesting thread while other requests wait for it.
+   *
+   * \param manifest The plugin manifest.
+   */
+  void register_plugin(PluginManifest manifest);
+
   void init_window(std::uint32_t flags) override;
 
   void set_renderer(IRenderer* renderer) override;
@@ -67,6 +87,9 @@ class TACTILE_RUNTIME_API RuntimeImpl final : public IRuntime
   [[nodiscard]]
   auto get_save_format(SaveFormatId id) const -> const ISaveFormat* override;
 
+  [[nodiscard]]
+  auto get_external_tileset_cache() const -> IExternalTilesetCache* override;
+
   void get_imgui_allocator_functions(imgui_malloc_fn** malloc_fn,
                                      imgui_free_fn** free_fn,
                                      void** user_data) override;
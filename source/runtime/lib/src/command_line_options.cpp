@@ -18,7 +18,9 @@ constexpr const char* kUsageHelpMessage =
                [--limit-fps <on|off>] [--zlib <on|off>] [--zstd <on|off>]
                [--yaml-format <on|off>] [--tiled-tmj-format <on|off>]
                [--tiled-tmx-format <on|off>] [--godot-tscn-format <on|off>]
-               [--vulkan-validation <on|off>] [--log-level <trc|dbg|inf|wrn|err>]
+               [--binary-format <on|off>] [--vulkan-validation <on|off>]
+               [--profiler <on|off>]
+               [--log-level <trc|dbg|inf|wrn|err>]
 
 Options:
   -h, --help           Prints this help message
@@ -35,7 +37,9 @@ Options:
   --tiled-tmj-format   Load Tiled TMJ save format plugin (default: "on")
   --tiled-tmx-format   Load Tiled TMX save format plugin (default: "on")
   --godot-tscn-format  Load Godot TSCN save format plugin (default: "on")
+  --binary-format      Load binary save format plugin (default: "on")
   --vulkan-validation  Load Vulkan validation layers (default: "off")
+  --profiler           Record profiler zones from startup (default: "on" in debug builds, "off" otherwise)
   --log-level          The verbosity of log output (default: "inf"))";
 
 void _add_bool_argument(argparse::ArgumentParser& parser,
@@ -69,6 +73,8 @@ auto get_default_command_line_options() -> CommandLineOptions
     .load_tiled_tmj_format = true,
     .load_tiled_tmx_format = true,
     .load_godot_tscn_format = true,
+    .load_binary_format = true,
+    .enable_profiler = TACTILE_DEBUG == 1,
   };
 }
 
@@ -155,9 +161,11 @@ auto parse_command_line_options(const int argc, char* argv[])
   _add_bool_argument(parser, "--tiled-tmj-format", options.load_tiled_tmj_format);
   _add_bool_argument(parser, "--tiled-tmx-format", options.load_tiled_tmx_format);
   _add_bool_argument(parser, "--godot-tscn-format", options.load_godot_tscn_format);
+  _add_bool_argument(parser, "--binary-format", options.load_binary_format);
   _add_bool_argument(parser,
                      "--vulkan-validation",
                      options.renderer_options.vulkan_validation);
+  _add_bool_argument(parser, "--profiler", options.enable_profiler);
 
   try {
     parser.parse_args(argc, argv);
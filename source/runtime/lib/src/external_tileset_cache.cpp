@@ -0,0 +1,88 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/runtime/external_tileset_cache.hpp"
+
+#include <system_error>  // error_code
+#include <utility>       // move
+
+namespace tactile::runtime {
+namespace {
+
+// Different paths to the same file, e.g., "../a/b.tsx" and "b.tsx", should share entries.
+[[nodiscard]]
+auto _get_cache_key(const std::filesystem::path& path) -> std::filesystem::path::string_type
+{
+  std::error_code error_code {};
+  auto canonical_path = std::filesystem::weakly_canonical(path, error_code);
+
+  if (error_code) {
+    return std::filesystem::absolute(path, error_code).lexically_normal().native();
+  }
+
+  return std::move(canonical_path).native();
+}
+
+}  // namespace
+
+auto ExternalTilesetCache::get_tileset(const std::filesystem::path& path,
+                                       const parser_type& parser)
+    -> std::expected<ir::Tileset, ErrorCode>
+{
+  auto key = _get_cache_key(path);
+
+  std::error_code error_code {};
+  const auto last_write_time = std::filesystem::last_write_time(path, error_code);
+  const auto file_size = error_code ? 0 : std::filesystem::file_size(path, error_code);
+
+  if (error_code) {
+    // Let the parser report missing or unreadable files.
+    invalidate(path);
+    return parser(path);
+  }
+
+  {
+    const std::scoped_lock lock {m_mutex};
+
+    const auto iter = m_tilesets.find(key);
+    if (iter != m_tilesets.end() && iter->second.last_write_time == last_write_time &&
+        iter->second.file_size == file_size) {
+      return iter->second.tileset;
+    }
+  }
+
+  auto tileset = parser(path);
+
+  if (tileset.has_value()) {
+    const std::scoped_lock lock {m_mutex};
+    m_tilesets.insert_or_assign(std::move(key),
+                                CachedTileset {
+                                  .last_write_time = last_write_time,
+                                  .file_size = file_size,
+                                  .tileset = *tileset,
+                                });
+  }
+
+  return tileset;
+}
+
+void ExternalTilesetCache::invalidate(const std::filesystem::path& path)
+{
+  const auto key = _get_cache_key(path);
+
+  const std::scoped_lock lock {m_mutex};
+  m_tilesets.erase(key);
+}
+
+void ExternalTilesetCache::clear()
+{
+  const std::scoped_lock lock {m_mutex};
+  m_tilesets.clear();
+}
+
+auto ExternalTilesetCache::size() const -> std::size_t
+{
+  const std::scoped_lock lock {m_mutex};
+  return m_tilesets.size();
+}
+
+}  // namespace tactile::runtime
@@ -2,86 +2,123 @@
 
 #include "tactile/runtime/launcher.hpp"
 
-#include <exception>  // exception
-#include <utility>    // move
-#include <vector>     // vector
+#include <exception>    // exception
+#include <optional>     // optional
+#include <string_view>  // string_view
+#include <utility>      // move
+#include <vector>       // vector
 
 #include <imgui.h>
 
+#include "tactile/base/io/compress/compression_format_id.hpp"
+#include "tactile/base/io/save/save_format_id.hpp"
 #include "tactile/base/render/renderer.hpp"
+#include "tactile/core/debug/profiler.hpp"
 #include "tactile/core/engine/engine.hpp"
 #include "tactile/core/tactile_app.hpp"
 #include "tactile/runtime/command_line_options.hpp"
 #include "tactile/runtime/dynamic_library.hpp"
 #include "tactile/runtime/logging.hpp"
 #include "tactile/runtime/plugin_instance.hpp"
+#include "tactile/runtime/plugin_manifest.hpp"
 #include "tactile/runtime/runtime_impl.hpp"
 
 namespace tactile::runtime {
 namespace {
 
 [[nodiscard]]
-auto _get_plugin_names(const CommandLineOptions& options) -> std::vector<std::string_view>
+auto _get_plugin_manifests(const CommandLineOptions& options) -> std::vector<PluginManifest>
 {
-  std::vector<std::string_view> plugin_names {};
+  std::vector<PluginManifest> manifests {};
 
   if (options.load_zlib) {
-    plugin_names.emplace_back("tactile-zlib-compression" TACTILE_DLL_EXT);
+    manifests.push_back(PluginManifest {
+      .library_name = "tactile-zlib-compression" TACTILE_DLL_EXT,
+      .save_formats = {},
+      .compression_formats = {CompressionFormatId::kZlib},
+    });
   }
 
   if (options.load_zstd) {
-    plugin_names.emplace_back("tactile-zstd-compression" TACTILE_DLL_EXT);
+    manifests.push_back(PluginManifest {
+      .library_name = "tactile-zstd-compression" TACTILE_DLL_EXT,
+      .save_formats = {},
+      .compression_formats = {CompressionFormatId::kZstd},
+    });
   }
 
   if (options.load_yaml_format) {
-    plugin_names.emplace_back("tactile-yaml-format" TACTILE_DLL_EXT);
+    manifests.push_back(PluginManifest {
+      .library_name = "tactile-yaml-format" TACTILE_DLL_EXT,
+      .save_formats = {SaveFormatId::kTactileYaml},
+      .compression_formats = {},
+    });
   }
 
   if (options.load_tiled_tmj_format) {
-    plugin_names.emplace_back("tactile-tiled-tmj" TACTILE_DLL_EXT);
+    manifests.push_back(PluginManifest {
+      .library_name = "tactile-tiled-tmj" TACTILE_DLL_EXT,
+      .save_formats = {SaveFormatId::kTiledTmj},
+      .compression_formats = {},
+    });
   }
 
   if (options.load_tiled_tmx_format) {
-    plugin_names.emplace_back("tactile-tiled-tmx" TACTILE_DLL_EXT);
+    manifests.push_back(PluginManifest {
+      .library_name = "tactile-tiled-tmx" TACTILE_DLL_EXT,
+      .save_formats = {SaveFormatId::kTiledTmx},
+      .compression_formats = {},
+    });
   }
 
   if (options.load_godot_tscn_format) {
-    plugin_names.emplace_back("tactile-godot-tscn" TACTILE_DLL_EXT);
+    manifests.push_back(PluginManifest {
+      .library_name = "tactile-godot-tscn" TACTILE_DLL_EXT,
+      .save_formats = {SaveFormatId::kGodotTscn},
+      .compression_formats = {},
+    });
   }
 
-  switch (options.renderer_backend) {
-    case RendererBackendId::kOpenGL:
-      plugin_names.emplace_back("tactile-opengl-renderer" TACTILE_DLL_EXT);
-      break;
-
-    case RendererBackendId::kVulkan:
-      plugin_names.emplace_back("tactile-vulkan-renderer" TACTILE_DLL_EXT);
-      break;
+  if (options.load_binary_format) {
+    manifests.push_back(PluginManifest {
+      .library_name = "tactile-binary-format" TACTILE_DLL_EXT,
+      .save_formats = {SaveFormatId::kTactileBinary},
+      .compression_formats = {},
+    });
   }
 
-  return plugin_names;
+  return manifests;
 }
 
 [[nodiscard]]
-auto _load_plugins(IRuntime& runtime, const CommandLineOptions& options)
-    -> std::vector<PluginInstance>
+auto _get_renderer_plugin_name(const CommandLineOptions& options) -> std::string_view
 {
-  const auto plugin_names = _get_plugin_names(options);
+  switch (options.renderer_backend) {
+    case RendererBackendId::kOpenGL: return "tactile-opengl-renderer" TACTILE_DLL_EXT;
+    case RendererBackendId::kVulkan: return "tactile-vulkan-renderer" TACTILE_DLL_EXT;
+  }
 
-  std::vector<PluginInstance> plugins {};
+  return "";
+}
 
-  for (const auto plugin_name : plugin_names) {
-    auto plugin = PluginInstance::load(&runtime, plugin_name);
+// Format plugins are only registered here, they are loaded on demand by the
+// runtime. However, the renderer is needed right away, so it's loaded eagerly.
+[[nodiscard]]
+auto _load_plugins(RuntimeImpl& runtime, const CommandLineOptions& options)
+    -> std::optional<PluginInstance>
+{
+  for (auto& manifest : _get_plugin_manifests(options)) {
+    runtime.register_plugin(std::move(manifest));
+  }
 
-    if (!plugin) {
-      TACTILE_RUNTIME_ERROR("Could not load plugin '{}'", plugin_name);
-      continue;
-    }
+  const auto renderer_plugin_name = _get_renderer_plugin_name(options);
+  auto renderer_plugin = PluginInstance::load(&runtime, renderer_plugin_name);
 
-    plugins.push_back(std::move(*plugin));
+  if (!renderer_plugin) {
+    TACTILE_RUNTIME_ERROR("Could not load plugin '{}'", renderer_plugin_name);
   }
 
-  return plugins;
+  return renderer_plugin;
 }
 
 }  // namespace
@@ -94,9 +131,11 @@ auto launch(const int argc, char* argv[]) -> int
       return EXIT_FAILURE;
     }
 
+    core::set_profiler_enabled(options->enable_profiler);
+
     RuntimeImpl runtime {*options};
 
-    const auto plugins [[maybe_unused]] = _load_plugins(runtime, *options);
+    const auto renderer_plugin [[maybe_unused]] = _load_plugins(runtime, *options);
 
     const auto* window = runtime.get_window();
     auto* renderer = runtime.get_renderer();
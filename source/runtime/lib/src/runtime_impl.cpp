@@ -2,12 +2,16 @@
 
 #include "tactile/runtime/runtime_impl.hpp"
 
+#include <algorithm>      // find
 #include <chrono>         // steady_clock
-#include <cstdlib>        // malloc, free, abort, EXIT_SUCCESS, EXIT_FAILURE
+#include <cstdlib>        // abort, EXIT_SUCCESS, EXIT_FAILURE
 #include <exception>      // exception, set_terminate
+#include <mutex>          // recursive_mutex, scoped_lock
 #include <optional>       // optional
+#include <ranges>         // views::reverse
 #include <unordered_map>  // unordered_map
 #include <utility>        // move
+#include <vector>         // vector
 
 #include <imgui.h>
 
@@ -17,10 +21,14 @@
 #include "tactile/core/numeric/random.hpp"
 #include "tactile/core/platform/win32.hpp"
 #include "tactile/core/ui/common/style.hpp"
+#include "tactile/core/ui/imgui_allocator.hpp"
 #include "tactile/log/file_log_sink.hpp"
 #include "tactile/log/terminal_log_sink.hpp"
 #include "tactile/runtime/command_line_options.hpp"
+#include "tactile/runtime/external_tileset_cache.hpp"
 #include "tactile/runtime/logging.hpp"
+#include "tactile/runtime/plugin_instance.hpp"
+#include "tactile/runtime/plugin_manifest.hpp"
 #include "tactile/runtime/protobuf_context.hpp"
 #include "tactile/runtime/sdl_context.hpp"
 #include "tactile/runtime/window_impl.hpp"
@@ -42,17 +50,6 @@ void _on_terminate() noexcept
   std::abort();
 }
 
-[[nodiscard]]
-auto _imgui_malloc(const std::size_t bytes, void*) -> void*
-{
-  return std::malloc(bytes);
-}
-
-void _imgui_free(void* memory, void*)
-{
-  std::free(memory);
-}
-
 [[nodiscard]]
 auto _make_logger(const log::LogLevel log_level) -> log::Logger
 {
@@ -82,12 +79,48 @@ void _log_command_line_options(const CommandLineOptions& options)
   TACTILE_RUNTIME_TRACE("load_tiled_tmj_format: {}", options.load_tiled_tmj_format);
   TACTILE_RUNTIME_TRACE("load_tiled_tmx_format: {}", options.load_tiled_tmx_format);
   TACTILE_RUNTIME_TRACE("load_godot_tscn_format: {}", options.load_godot_tscn_format);
+  TACTILE_RUNTIME_TRACE("load_binary_format: {}", options.load_binary_format);
   TACTILE_RUNTIME_TRACE("texture_filter_mode: {}",
                         options.renderer_options.texture_filter_mode);
   TACTILE_RUNTIME_TRACE("use_mipmaps: {}", options.renderer_options.use_mipmaps);
   TACTILE_RUNTIME_TRACE("use_vsync: {}", options.renderer_options.use_vsync);
   TACTILE_RUNTIME_TRACE("limit_fps: {}", options.renderer_options.limit_fps);
   TACTILE_RUNTIME_TRACE("vulkan_validation: {}", options.renderer_options.vulkan_validation);
+  TACTILE_RUNTIME_TRACE("enable_profiler: {}", options.enable_profiler);
+}
+
+// A plugin that is loaded on demand.
+struct LazyPlugin final
+{
+  PluginManifest manifest;
+  std::optional<PluginInstance> instance;
+  bool attempted_load;
+};
+
+template <typename T, typename Id>
+[[nodiscard]]
+auto _find_format(const std::unordered_map<Id, T*>& formats, const Id id) -> T*
+{
+  const auto iter = formats.find(id);
+
+  if (iter != formats.end()) {
+    return iter->second;
+  }
+
+  return nullptr;
+}
+
+[[nodiscard]]
+auto _provides_format(const PluginManifest& manifest, const SaveFormatId id) -> bool
+{
+  return std::ranges::find(manifest.save_formats, id) != manifest.save_formats.end();
+}
+
+[[nodiscard]]
+auto _provides_format(const PluginManifest& manifest, const CompressionFormatId id) -> bool
+{
+  return std::ranges::find(manifest.compression_formats, id) !=
+         manifest.compression_formats.end();
 }
 
 }  // namespace
@@ -102,10 +135,18 @@ struct RuntimeImpl::Data final
   IRenderer* renderer {};
   std::unordered_map<CompressionFormatId, ICompressionFormat*> compression_formats {};
   std::unordered_map<SaveFormatId, ISaveFormat*> save_formats {};
+  std::vector<LazyPlugin> lazy_plugins {};
 
-  explicit Data(const CommandLineOptions& options)
+  // Guards the formats and lazy plugins, since formats may be requested from any
+  // thread. This is recursive because plugins register their formats while loaded.
+  std::recursive_mutex format_mutex {};
+  ExternalTilesetCache external_tileset_cache {};
+  IRuntime* runtime;
+
+  Data(IRuntime* runtime, const CommandLineOptions& options)
     : renderer_options {options.renderer_options},
-      logger {_make_logger(options.log_level)}
+      logger {_make_logger(options.log_level)},
+      runtime {runtime}
   {
     set_logger(&logger);
     core::set_logger(&logger);
@@ -122,17 +163,68 @@ struct RuntimeImpl::Data final
 
   TACTILE_DELETE_COPY(Data);
   TACTILE_DELETE_MOVE(Data);
+
+  // Loads the first available plugin that provides the specified format.
+  template <typename Id>
+  void load_lazy_plugin(const Id id)
+  {
+    for (auto& lazy_plugin : lazy_plugins) {
+      if (lazy_plugin.attempted_load || !_provides_format(lazy_plugin.manifest, id)) {
+        continue;
+      }
+
+      // Plugins are never reloaded, to avoid repeated attempts to load missing
+      // or broken plugins.
+      lazy_plugin.attempted_load = true;
+
+      TACTILE_RUNTIME_DEBUG("Loading plugin '{}' on demand",
+                            lazy_plugin.manifest.library_name);
+
+      if (auto instance = PluginInstance::load(runtime, lazy_plugin.manifest.library_name)) {
+        lazy_plugin.instance.emplace(std::move(*instance));
+        return;
+      }
+    }
+  }
+
+  void unload_lazy_plugins() noexcept
+  {
+    const std::scoped_lock lock {format_mutex};
+
+    // Plugins are unloaded in the reverse order of registration, since plugins
+    // loaded later may depend on plugins loaded earlier.
+    for (auto& lazy_plugin : lazy_plugins | std::views::reverse) {
+      lazy_plugin.instance.reset();
+    }
+
+    lazy_plugins.clear();
+  }
 };
 
 RuntimeImpl::RuntimeImpl(const CommandLineOptions& options)
 {
   std::set_terminate(&_on_terminate);
-  m_data = std::make_unique<Data>(options);
+  m_data = std::make_unique<Data>(this, options);
 
   core::init_random_number_generator();
 }
 
-RuntimeImpl::~RuntimeImpl() noexcept = default;
+RuntimeImpl::~RuntimeImpl() noexcept
+{
+  m_data->unload_lazy_plugins();
+}
+
+void RuntimeImpl::register_plugin(PluginManifest manifest)
+{
+  TACTILE_RUNTIME_DEBUG("Registered plugin '{}'", manifest.library_name);
+
+  const std::scoped_lock lock {m_data->format_mutex};
+  m_data->lazy_plugins.push_back(LazyPlugin {
+    .manifest = std::move(manifest),
+    .instance = std::nullopt,
+    .attempted_load = false,
+  });
+}
 
 void RuntimeImpl::init_window(const std::uint32_t flags)
 {
@@ -150,6 +242,8 @@ void RuntimeImpl::set_renderer(IRenderer* renderer)
 void RuntimeImpl::set_compression_format(const CompressionFormatId id,
                                          ICompressionFormat* format)
 {
+  const std::scoped_lock lock {m_data->format_mutex};
+
   if (format != nullptr) {
     m_data->compression_formats.insert_or_assign(id, format);
   }
@@ -160,6 +254,8 @@ void RuntimeImpl::set_compression_format(const CompressionFormatId id,
 
 void RuntimeImpl::set_save_format(const SaveFormatId id, ISaveFormat* format)
 {
+  const std::scoped_lock lock {m_data->format_mutex};
+
   if (format != nullptr) {
     m_data->save_formats.insert_or_assign(id, format);
   }
@@ -181,24 +277,31 @@ auto RuntimeImpl::get_renderer() -> IRenderer*
 auto RuntimeImpl::get_compression_format(const CompressionFormatId id) const
     -> const ICompressionFormat*
 {
-  const auto iter = m_data->compression_formats.find(id);
+  const std::scoped_lock lock {m_data->format_mutex};
 
-  if (iter != m_data->compression_formats.end()) {
-    return iter->second;
+  if (const auto* format = _find_format(m_data->compression_formats, id)) {
+    return format;
   }
 
-  return nullptr;
+  m_data->load_lazy_plugin(id);
+  return _find_format(m_data->compression_formats, id);
 }
 
 auto RuntimeImpl::get_save_format(const SaveFormatId id) const -> const ISaveFormat*
 {
-  const auto iter = m_data->save_formats.find(id);
+  const std::scoped_lock lock {m_data->format_mutex};
 
-  if (iter != m_data->save_formats.end()) {
-    return iter->second;
+  if (const auto* format = _find_format(m_data->save_formats, id)) {
+    return format;
   }
 
-  return nullptr;
+  m_data->load_lazy_plugin(id);
+  return _find_format(m_data->save_formats, id);
+}
+
+auto RuntimeImpl::get_external_tileset_cache() const -> IExternalTilesetCache*
+{
+  return &m_data->external_tileset_cache;
 }
 
 void RuntimeImpl::get_imgui_allocator_functions(imgui_malloc_fn** malloc_fn,
@@ -206,11 +309,11 @@ void RuntimeImpl::get_imgui_allocator_functions(imgui_malloc_fn** malloc_fn,
                                                 void** user_data)
 {
   if (malloc_fn) {
-    *malloc_fn = &_imgui_malloc;
+    *malloc_fn = &core::ui::imgui_malloc;
   }
 
   if (free_fn) {
-    *free_fn = &_imgui_free;
+    *free_fn = &core::ui::imgui_free;
   }
 
   if (user_data) {
@@ -0,0 +1,135 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/runtime/external_tileset_cache.hpp"
+
+#include <cstddef>     // size_t
+#include <expected>    // expected, unexpected
+#include <filesystem>  // path, temp_directory_path, create_directories, remove_all
+#include <fstream>     // ofstream
+#include <string>      // string
+
+#include <gtest/gtest.h>
+
+namespace tactile::runtime {
+namespace {
+
+class ExternalTilesetCacheTest : public testing::Test
+{
+ public:
+  void SetUp() override
+  {
+    std::filesystem::remove_all(mDir);
+    std::filesystem::create_directories(mDir / "maps");
+    write_tileset_file("foo");
+  }
+
+  void TearDown() override
+  {
+    std::filesystem::remove_all(mDir);
+  }
+
+ protected:
+  std::filesystem::path mDir {std::filesystem::temp_directory_path() /
+                              "tactile-external-tileset-cache-test"};
+  std::filesystem::path mTilesetPath {mDir / "tileset.tsj"};
+  ExternalTilesetCache mCache {};
+  std::size_t mParseCount {0};
+
+  IExternalTilesetCache::parser_type mParser =
+      [this](const std::filesystem::path&) -> std::expected<ir::Tileset, ErrorCode> {
+    ++mParseCount;
+
+    ir::Tileset tileset {};
+    tileset.meta.name = "tileset";
+    tileset.tile_count = static_cast<std::ptrdiff_t>(mParseCount);
+
+    return tileset;
+  };
+
+  void write_tileset_file(const std::string& content) const
+  {
+    std::ofstream stream {mTilesetPath, std::ios::out | std::ios::trunc};
+    stream << content;
+  }
+};
+
+// tactile::runtime::ExternalTilesetCache::get_tileset
+TEST_F(ExternalTilesetCacheTest, TilesetIsOnlyParsedOnce)
+{
+  const auto tileset1 = mCache.get_tileset(mTilesetPath, mParser);
+  const auto tileset2 = mCache.get_tileset(mTilesetPath, mParser);
+
+  ASSERT_TRUE(tileset1.has_value());
+  EXPECT_EQ(tileset1, tileset2);
+  EXPECT_EQ(mParseCount, 1);
+  EXPECT_EQ(mCache.size(), 1);
+}
+
+// tactile::runtime::ExternalTilesetCache::get_tileset
+TEST_F(ExternalTilesetCacheTest, EquivalentPathsShareEntries)
+{
+  ASSERT_TRUE(mCache.get_tileset(mTilesetPath, mParser).has_value());
+  ASSERT_TRUE(mCache.get_tileset(mDir / "maps" / ".." / "tileset.tsj", mParser).has_value());
+
+  EXPECT_EQ(mParseCount, 1);
+  EXPECT_EQ(mCache.size(), 1);
+}
+
+// tactile::runtime::ExternalTilesetCache::get_tileset
+TEST_F(ExternalTilesetCacheTest, ModifiedTilesetIsParsedAgain)
+{
+  ASSERT_TRUE(mCache.get_tileset(mTilesetPath, mParser).has_value());
+
+  write_tileset_file("foobar");
+
+  const auto tileset = mCache.get_tileset(mTilesetPath, mParser);
+  ASSERT_TRUE(tileset.has_value());
+  EXPECT_EQ(tileset->tile_count, 2);
+  EXPECT_EQ(mParseCount, 2);
+  EXPECT_EQ(mCache.size(), 1);
+}
+
+// tactile::runtime::ExternalTilesetCache::get_tileset
+TEST_F(ExternalTilesetCacheTest, ParseErrorsAreNotCached)
+{
+  const auto failing_parser = [](const std::filesystem::path&)
+      -> std::expected<ir::Tileset, ErrorCode> {
+    return std::unexpected {ErrorCode::kParseError};
+  };
+
+  EXPECT_EQ(mCache.get_tileset(mTilesetPath, failing_parser),
+            std::unexpected {ErrorCode::kParseError});
+  EXPECT_EQ(mCache.size(), 0);
+
+  EXPECT_TRUE(mCache.get_tileset(mTilesetPath, mParser).has_value());
+  EXPECT_EQ(mCache.size(), 1);
+}
+
+// tactile::runtime::ExternalTilesetCache::get_tileset
+TEST_F(ExternalTilesetCacheTest, MissingTilesetFileIsNotCached)
+{
+  ASSERT_TRUE(mCache.get_tileset(mDir / "missing.tsj", mParser).has_value());
+  ASSERT_TRUE(mCache.get_tileset(mDir / "missing.tsj", mParser).has_value());
+
+  EXPECT_EQ(mParseCount, 2);
+  EXPECT_EQ(mCache.size(), 0);
+}
+
+// tactile::runtime::ExternalTilesetCache::invalidate
+// tactile::runtime::ExternalTilesetCache::clear
+TEST_F(ExternalTilesetCacheTest, InvalidateAndClear)
+{
+  ASSERT_TRUE(mCache.get_tileset(mTilesetPath, mParser).has_value());
+
+  mCache.invalidate(mTilesetPath);
+  EXPECT_EQ(mCache.size(), 0);
+
+  ASSERT_TRUE(mCache.get_tileset(mTilesetPath, mParser).has_value());
+  EXPECT_EQ(mParseCount, 2);
+
+  mCache.clear();
+  EXPECT_EQ(mCache.size(), 0);
+}
+
+}  // namespace
+}  // namespace tactile::runtime
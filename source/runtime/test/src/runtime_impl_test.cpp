@@ -0,0 +1,114 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/runtime/runtime_impl.hpp"
+
+#include <thread>  // thread
+#include <tuple>   // ignore
+#include <vector>  // vector
+
+#include <gtest/gtest.h>
+
+#include "tactile/base/io/compress/compression_format.hpp"
+#include "tactile/runtime/command_line_options.hpp"
+#include "tactile/runtime/dynamic_library.hpp"
+#include "tactile/runtime/plugin_manifest.hpp"
+
+namespace tactile::runtime {
+namespace {
+
+class StubCompressionFormat final : public ICompressionFormat
+{
+ public:
+  [[nodiscard]]
+  auto compress(const ByteSpan input_data, const CompressionOptions&) const
+      -> std::expected<ByteStream, ErrorCode> override
+  {
+    return ByteStream {input_data.begin(), input_data.end()};
+  }
+
+  [[nodiscard]]
+  auto decompress(const ByteSpan input_data, const DecompressionOptions&) const
+      -> std::expected<ByteStream, ErrorCode> override
+  {
+    return ByteStream {input_data.begin(), input_data.end()};
+  }
+
+  [[nodiscard]]
+  auto train_dictionary(std::span<const ByteSpan>, std::size_t) const
+      -> std::expected<ByteStream, ErrorCode> override
+  {
+    return std::unexpected {ErrorCode::kNotSupported};
+  }
+};
+
+[[nodiscard]]
+auto _make_missing_plugin_manifest() -> PluginManifest
+{
+  return PluginManifest {
+    .library_name = "tactile-missing-plugin" TACTILE_DLL_EXT,
+    .save_formats = {SaveFormatId::kTiledTmj},
+    .compression_formats = {CompressionFormatId::kZstd},
+  };
+}
+
+}  // namespace
+
+// tactile::runtime::RuntimeImpl::register_plugin
+TEST(RuntimeImpl, RegisterPluginWithMissingLibrary)
+{
+  RuntimeImpl runtime {get_default_command_line_options()};
+  runtime.register_plugin(_make_missing_plugin_manifest());
+
+  EXPECT_EQ(runtime.get_save_format(SaveFormatId::kTiledTmj), nullptr);
+  EXPECT_EQ(runtime.get_compression_format(CompressionFormatId::kZstd), nullptr);
+
+  // The plugin should only be loaded once, but lookups should still work.
+  EXPECT_EQ(runtime.get_save_format(SaveFormatId::kTiledTmj), nullptr);
+  EXPECT_EQ(runtime.get_compression_format(CompressionFormatId::kZstd), nullptr);
+}
+
+// tactile::runtime::RuntimeImpl::get_compression_format
+TEST(RuntimeImpl, GetCompressionFormatPrefersInstalledFormats)
+{
+  RuntimeImpl runtime {get_default_command_line_options()};
+  runtime.register_plugin(_make_missing_plugin_manifest());
+
+  StubCompressionFormat compression_format {};
+  runtime.set_compression_format(CompressionFormatId::kZstd, &compression_format);
+
+  EXPECT_EQ(runtime.get_compression_format(CompressionFormatId::kZstd), &compression_format);
+  EXPECT_EQ(runtime.get_compression_format(CompressionFormatId::kZlib), nullptr);
+
+  runtime.set_compression_format(CompressionFormatId::kZstd, nullptr);
+  EXPECT_EQ(runtime.get_compression_format(CompressionFormatId::kZstd), nullptr);
+}
+
+// tactile::runtime::RuntimeImpl::get_save_format
+// tactile::runtime::RuntimeImpl::get_compression_format
+TEST(RuntimeImpl, GetFormatsFromMultipleThreads)
+{
+  RuntimeImpl runtime {get_default_command_line_options()};
+  runtime.register_plugin(_make_missing_plugin_manifest());
+
+  StubCompressionFormat compression_format {};
+
+  std::vector<std::thread> threads {};
+  for (int index = 0; index < 8; ++index) {
+    threads.emplace_back([&] {
+      for (int iteration = 0; iteration < 100; ++iteration) {
+        EXPECT_EQ(runtime.get_save_format(SaveFormatId::kTiledTmj), nullptr);
+        std::ignore = runtime.get_compression_format(CompressionFormatId::kZstd);
+      }
+    });
+  }
+
+  runtime.set_compression_format(CompressionFormatId::kZstd, &compression_format);
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(runtime.get_compression_format(CompressionFormatId::kZstd), &compression_format);
+}
+
+}  // namespace tactile::runtime
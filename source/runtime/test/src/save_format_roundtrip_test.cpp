@@ -1,8 +1,8 @@
 // Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
 
 #include <array>        // array
-#include <filesystem>   // current_path, create_directories
-#include <optional>     // optional
+#include <filesystem>   // current_path, create_directories, directory_iterator
+#include <optional>     // optional, nullopt
 #include <ostream>      // ostream
 #include <string_view>  // string_view
 
@@ -27,6 +27,10 @@
   #include "tactile/tiled_tmj/tmj_format_plugin.hpp"
 #endif
 
+#ifdef TACTILE_HAS_BINARY_FORMAT
+  #include "tactile/binary/binary_format_plugin.hpp"
+#endif
+
 #ifdef TACTILE_HAS_ZLIB
   #include "tactile/zlib/zlib_compression_plugin.hpp"
 #endif
@@ -92,12 +96,20 @@ class SaveFormatRoundtripTest : public testing::TestWithParam<SaveFormatRoundtri
     m_tmj_format_plugin.load(&m_runtime);
 #endif
 
+#ifdef TACTILE_HAS_BINARY_FORMAT
+    m_binary_format_plugin.load(&m_runtime);
+#endif
+
     m_renderer = m_runtime.get_renderer();
     ASSERT_NE(m_renderer, nullptr);
   }
 
   void TearDown() override
   {
+#ifdef TACTILE_HAS_BINARY_FORMAT
+    m_binary_format_plugin.unload();
+#endif
+
 #ifdef TACTILE_HAS_TILED_TMX
     m_tmx_format_plugin.unload();
 #endif
@@ -138,6 +150,10 @@ class SaveFormatRoundtripTest : public testing::TestWithParam<SaveFormatRoundtri
   tiled_tmj::TmjFormatPlugin m_tmj_format_plugin {};
 #endif
 
+#ifdef TACTILE_HAS_BINARY_FORMAT
+  binary_format::BinaryFormatPlugin m_binary_format_plugin {};
+#endif
+
   IRenderer* m_renderer {};
 
   [[nodiscard]]
@@ -241,6 +257,38 @@ INSTANTIATE_TEST_SUITE_P(TiledTMX,
 
 #endif
 
+#if TACTILE_HAS_BINARY_FORMAT
+
+inline constexpr std::array kBinaryRoundtripTests = {
+  SaveFormatRoundtripCfg {
+    .format_id = SaveFormatId::kTactileBinary,
+    .map_filename = "map_with_embedded_tilesets.tactile",
+    .encoding = TileEncoding::kPlainText,
+    .compression = std::nullopt,
+    .use_external_tilesets = false,
+  },
+  SaveFormatRoundtripCfg {
+    .format_id = SaveFormatId::kTactileBinary,
+    .map_filename = "map_with_external_tilesets.tactile",
+    .encoding = TileEncoding::kPlainText,
+    .compression = std::nullopt,
+    .use_external_tilesets = true,
+  },
+  SaveFormatRoundtripCfg {
+    .format_id = SaveFormatId::kTactileBinary,
+    .map_filename = "map_with_base64_zstd_tiles.tactile",
+    .encoding = TileEncoding::kBase64,
+    .compression = CompressionFormatId::kZstd,
+    .use_external_tilesets = false,
+  },
+};
+
+INSTANTIATE_TEST_SUITE_P(Binary,
+                         SaveFormatRoundtripTest,
+                         testing::ValuesIn(kBinaryRoundtripTests));
+
+#endif
+
 TEST_P(SaveFormatRoundtripTest, SaveAndLoadMap)
 {
   const auto& config = GetParam();
@@ -275,14 +323,21 @@ TEST_P(SaveFormatRoundtripTest, SaveAndLoadMap)
     .use_external_tilesets = config.use_external_tilesets,
     .use_indentation = true,
     .fold_tile_layer_data = false,
+    .compression_level = std::nullopt,
+    .compression_dictionary = ByteSpan {},
   };
 
   const auto save_result = save_format->save_map(*map_view, write_options);
   ASSERT_TRUE(save_result.has_value()) << "Error: " << to_string(save_result.error());
 
+  for (const auto& entry : std::filesystem::directory_iterator {map_dir}) {
+    EXPECT_NE(entry.path().extension(), ".tmp") << entry.path().string();
+  }
+
   const SaveFormatReadOptions read_options {
     .base_dir = write_options.base_dir,
     .strict_mode = false,
+    .compression_dictionary = ByteSpan {},
   };
 
   const auto parsed_map = save_format->load_map(map_path, read_options);